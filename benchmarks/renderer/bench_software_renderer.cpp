@@ -0,0 +1,132 @@
+/**
+ * @file bench_software_renderer.cpp
+ * @brief Frame time of SoftwareRenderer on a typical 1080p VN frame
+ *
+ * The frame is a full-screen background, two scaled character sprites, a
+ * translucent dialogue box with a few hundred glyph quads and a fade, drawn
+ * with every raster engine from 1..N threads.
+ *
+ * Usage: software_renderer_benchmarks [frames] [width] [height]
+ */
+
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/renderer/texture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+void makeTexture(Texture &texture, i32 width, i32 height, u32 seed) {
+  std::vector<u8> pixels(static_cast<usize>(width) *
+                         static_cast<usize>(height) * 4);
+  u32 state = seed;
+  for (usize i = 0; i < pixels.size(); i += 4) {
+    state = state * 1664525u + 1013904223u;
+    pixels[i] = static_cast<u8>(state >> 24);
+    pixels[i + 1] = static_cast<u8>(state >> 16);
+    pixels[i + 2] = static_cast<u8>(state >> 8);
+    pixels[i + 3] = static_cast<u8>(128 + (state >> 25));
+  }
+  (void)texture.loadFromRGBA(pixels.data(), width, height);
+}
+
+struct Scene {
+  Texture background;
+  Texture character;
+  Texture glyphs;
+};
+
+void drawFrame(SoftwareRenderer &renderer, const Scene &scene) {
+  const auto width = static_cast<f32>(renderer.getWidth());
+  const auto height = static_cast<f32>(renderer.getHeight());
+  renderer.beginFrame();
+  renderer.setBlendMode(BlendMode::None);
+  renderer.drawSprite(scene.background, Transform2D{});
+  renderer.setBlendMode(BlendMode::Alpha);
+  for (int i = 0; i < 2; ++i) {
+    Transform2D transform;
+    transform.x = width * (0.2f + 0.45f * static_cast<f32>(i));
+    transform.y = height * 0.1f;
+    transform.setScale(0.9f);
+    renderer.drawSprite(scene.character, transform);
+  }
+  renderer.fillRect(Rect{width * 0.05f, height * 0.7f, width * 0.9f,
+                         height * 0.25f},
+                    Color(0, 0, 0, 160));
+  for (int i = 0; i < 400; ++i) {
+    Transform2D transform;
+    transform.x = width * 0.07f + static_cast<f32>(i % 80) * 20.0f;
+    transform.y = height * 0.72f + static_cast<f32>(i / 80) * 40.0f;
+    renderer.drawSprite(
+        scene.glyphs,
+        Rect{static_cast<f32>((i * 16) % 256),
+             static_cast<f32>(((i * 16) / 256) * 24 % 240), 16, 24},
+        transform, Color::White);
+  }
+  renderer.setFade(0.1f);
+  renderer.endFrame();
+}
+
+int parseArg(int argc, char **argv, int index, int fallback) {
+  if (argc <= index) {
+    return fallback;
+  }
+  const int value = std::atoi(argv[index]);
+  return value > 0 ? value : fallback;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  core::Logger::instance().setLevel(core::LogLevel::Warning);
+
+  const int frames = parseArg(argc, argv, 1, 60);
+  const i32 width = parseArg(argc, argv, 2, 1920);
+  const i32 height = parseArg(argc, argv, 3, 1080);
+  const u32 maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+
+  Texture::setGpuUploadEnabled(false);
+  Scene scene;
+  makeTexture(scene.background, width, height, 1);
+  makeTexture(scene.character, 800, 1000, 2);
+  makeTexture(scene.glyphs, 256, 256, 3);
+
+  std::printf("frame: %dx%d, %d frames\n", width, height, frames);
+  for (auto engine :
+       {RasterEngine::Scalar, RasterEngine::Sse2, RasterEngine::Avx2}) {
+    if (!SoftwareRenderer::isEngineSupported(engine)) {
+      continue;
+    }
+    const char *name = engine == RasterEngine::Scalar ? "scalar"
+                       : engine == RasterEngine::Sse2 ? "sse2"
+                                                      : "avx2";
+    for (u32 threads = 1; threads <= maxThreads; threads *= 2) {
+      SoftwareRenderer renderer(width, height);
+      renderer.setEngine(engine);
+      renderer.setThreadCount(threads);
+      drawFrame(renderer, scene);
+
+      const auto begin = std::chrono::steady_clock::now();
+      for (int i = 0; i < frames; ++i) {
+        drawFrame(renderer, scene);
+      }
+      const double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - begin)
+                            .count() /
+                        frames;
+      std::printf("%-6s threads=%-3u %8.2f ms/frame %8.1f fps\n", name,
+                  threads, ms, 1000.0 / ms);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file bench_checksums.cpp
+ * @brief Throughput of every CRC32 engine and of ContentHasher
+ *
+ * Mount-time integrity checks and pack builds hash every byte of a pack, so
+ * these run at memory speed or not at all. Each engine is also checked
+ * against the bytewise reference on odd sizes and offsets before timing.
+ *
+ * Usage: checksum_benchmarks [buffer_mib] [passes]
+ */
+
+#include "NovelMind/vfs/content_hash.hpp"
+#include "NovelMind/vfs/crc32.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::VFS;
+
+namespace {
+
+constexpr Crc32Engine kEngines[] = {Crc32Engine::Bytewise,
+                                    Crc32Engine::Slicing8,
+                                    Crc32Engine::Slicing16,
+                                    Crc32Engine::Pclmul, Crc32Engine::ArmCrc};
+
+bool engineMatchesReference(Crc32Engine engine, const std::vector<u8> &data) {
+  std::mt19937 rng(7);
+  for (int i = 0; i < 2000; ++i) {
+    const usize offset = rng() % 64;
+    const usize size = rng() % 4096;
+    const u32 expected =
+        Crc32::update(Crc32Engine::Bytewise, 0, data.data() + offset, size);
+    if (Crc32::update(engine, 0, data.data() + offset, size) != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Fn> double gigabytesPerSecond(usize bytes, usize passes,
+                                                 Fn &&fn) {
+  const auto begin = std::chrono::steady_clock::now();
+  for (usize pass = 0; pass < passes; ++pass) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - begin).count();
+  return static_cast<double>(bytes * passes) / seconds / 1.0e9;
+}
+
+usize parseArg(int argc, char **argv, int index, usize fallback) {
+  if (argc <= index) {
+    return fallback;
+  }
+  const long long value = std::atoll(argv[index]);
+  return value > 0 ? static_cast<usize>(value) : fallback;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const usize size = parseArg(argc, argv, 1, 64) * 1024 * 1024;
+  const usize passes = parseArg(argc, argv, 2, 8);
+
+  std::vector<u8> data(size);
+  std::mt19937_64 rng(42);
+  for (usize i = 0; i + 8 <= data.size(); i += 8) {
+    const u64 value = rng();
+    for (usize b = 0; b < 8; ++b) {
+      data[i + b] = static_cast<u8>(value >> (b * 8));
+    }
+  }
+
+  std::printf("buffer: %zu MiB, %zu passes, active crc32 engine: %s\n",
+              size / (1024 * 1024), passes,
+              Crc32::engineName(Crc32::activeEngine()));
+
+  int status = 0;
+  for (Crc32Engine engine : kEngines) {
+    if (!Crc32::isSupported(engine)) {
+      std::printf("crc32 %-14s unsupported on this CPU\n",
+                  Crc32::engineName(engine));
+      continue;
+    }
+    if (!engineMatchesReference(engine, data)) {
+      std::fprintf(stderr, "crc32 %s disagrees with the reference\n",
+                   Crc32::engineName(engine));
+      status = 1;
+      continue;
+    }
+    // The bytewise loop is slow enough that one pass tells the story
+    const usize enginePasses = engine == Crc32Engine::Bytewise ? 1 : passes;
+    volatile u32 sink = 0;
+    const double rate = gigabytesPerSecond(size, enginePasses, [&]() {
+      sink = Crc32::update(engine, 0, data.data(), data.size());
+    });
+    std::printf("crc32 %-14s %8.2f GB/s\n", Crc32::engineName(engine), rate);
+  }
+
+  volatile u64 sink = 0;
+  const double hashRate = gigabytesPerSecond(size, passes, [&]() {
+    sink = ContentHasher::hash(data).low;
+  });
+  std::printf("content hash         %8.2f GB/s\n", hashRate);
+
+  // Short inputs dominate id lookups in the perfect-hash index
+  const usize shortCount = 1 << 20;
+  const double shortRate = gigabytesPerSecond(shortCount * 24, 1, [&]() {
+    for (usize i = 0; i < shortCount; ++i) {
+      sink = ContentHasher::hash({data.data() + (i & 4095), 24}).low;
+    }
+  });
+  std::printf("content hash (24 B)  %8.2f GB/s\n", shortRate);
+  return status;
+}
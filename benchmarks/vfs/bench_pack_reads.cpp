@@ -0,0 +1,190 @@
+/**
+ * @file bench_pack_reads.cpp
+ * @brief Multi-threaded PackReader read throughput
+ *
+ * Builds a synthetic pack in the temp directory and reads random resources
+ * from 1..N threads in both access modes. With lock-free lookups and
+ * positional reads, throughput should scale close to linearly with thread
+ * count until the storage device or memory bandwidth saturates.
+ *
+ * Usage: vfs_benchmarks [resource_count] [resource_size] [reads_per_thread]
+ */
+
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/pack_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::vfs;
+
+namespace {
+
+template <typename T> void appendPod(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+std::string resourceName(usize index) {
+  return "bench/resource_" + std::to_string(index);
+}
+
+std::string writeSyntheticPack(usize count, usize resourceSize) {
+  const u64 tableOffset = sizeof(PackHeader);
+  const u64 stringOffset = tableOffset + count * sizeof(PackResourceEntry);
+
+  std::vector<u8> strings;
+  std::vector<u32> stringOffsets;
+  for (usize i = 0; i < count; ++i) {
+    const std::string name = resourceName(i);
+    stringOffsets.push_back(static_cast<u32>(strings.size()));
+    strings.insert(strings.end(), name.begin(), name.end());
+    strings.push_back(0);
+  }
+
+  PackHeader header{};
+  header.magic = PACK_MAGIC;
+  header.versionMajor = PACK_VERSION_MAJOR;
+  header.resourceCount = static_cast<u32>(count);
+  header.resourceTableOffset = tableOffset;
+  header.stringTableOffset = stringOffset;
+  header.dataOffset = stringOffset + sizeof(u32) +
+                      stringOffsets.size() * sizeof(u32) + strings.size();
+
+  std::vector<u8> tables;
+  appendPod(tables, header);
+  for (usize i = 0; i < count; ++i) {
+    PackResourceEntry entry{};
+    entry.idStringOffset = static_cast<u32>(i);
+    entry.type = static_cast<u32>(ResourceType::Data);
+    entry.dataOffset = static_cast<u64>(i) * resourceSize;
+    entry.compressedSize = resourceSize;
+    entry.uncompressedSize = resourceSize;
+    appendPod(tables, entry);
+  }
+  appendPod(tables, static_cast<u32>(stringOffsets.size()));
+  for (u32 offset : stringOffsets) {
+    appendPod(tables, offset);
+  }
+  tables.insert(tables.end(), strings.begin(), strings.end());
+
+  const auto path =
+      (std::filesystem::temp_directory_path() / "nm_bench_reads.nmres")
+          .string();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(tables.data()),
+            static_cast<std::streamsize>(tables.size()));
+
+  std::vector<u8> payload(resourceSize);
+  for (usize i = 0; i < count; ++i) {
+    std::fill(payload.begin(), payload.end(), static_cast<u8>(i));
+    out.write(reinterpret_cast<const char *>(payload.data()),
+              static_cast<std::streamsize>(payload.size()));
+  }
+  return path;
+}
+
+double runReaders(const PackReader &reader, usize threadCount, usize count,
+                  usize readsPerThread) {
+  std::atomic<bool> start{false};
+  std::atomic<usize> failures{0};
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+
+  for (usize t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(static_cast<u32>(t + 1));
+      std::uniform_int_distribution<usize> pick(0, count - 1);
+      std::vector<std::string> names;
+      names.reserve(readsPerThread);
+      for (usize i = 0; i < readsPerThread; ++i) {
+        names.push_back(resourceName(pick(rng)));
+      }
+
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      for (const auto &name : names) {
+        if (reader.readFile(name).isError()) {
+          failures.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  if (failures.load() != 0) {
+    std::fprintf(stderr, "%zu reads failed\n", failures.load());
+  }
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+usize parseArg(int argc, char **argv, int index, usize fallback) {
+  if (argc <= index) {
+    return fallback;
+  }
+  const long long value = std::atoll(argv[index]);
+  return value > 0 ? static_cast<usize>(value) : fallback;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  core::Logger::instance().setLevel(core::LogLevel::Warning);
+
+  const usize count = parseArg(argc, argv, 1, 4096);
+  const usize resourceSize = parseArg(argc, argv, 2, 16 * 1024);
+  const usize readsPerThread = parseArg(argc, argv, 3, 20000);
+  const usize maxThreads =
+      std::max<usize>(1, std::thread::hardware_concurrency());
+
+  const std::string path = writeSyntheticPack(count, resourceSize);
+  std::printf("pack: %zu resources x %zu bytes, %zu reads/thread\n", count,
+              resourceSize, readsPerThread);
+
+  for (PackAccessMode mode :
+       {PackAccessMode::MemoryMapped, PackAccessMode::Stream}) {
+    PackReader reader(mode);
+    if (reader.mount(path).isError()) {
+      std::fprintf(stderr, "failed to mount %s\n", path.c_str());
+      return 1;
+    }
+
+    const char *modeName =
+        mode == PackAccessMode::MemoryMapped ? "mmap" : "pread";
+    double baseline = 0.0;
+    for (usize threads = 1; threads <= maxThreads; threads *= 2) {
+      const double seconds =
+          runReaders(reader, threads, count, readsPerThread);
+      const double readsPerSec =
+          static_cast<double>(threads * readsPerThread) / seconds;
+      if (threads == 1) {
+        baseline = readsPerSec;
+      }
+      std::printf("%-5s threads=%-3zu %12.0f reads/s %9.1f MB/s  x%.2f\n",
+                  modeName, threads, readsPerSec,
+                  readsPerSec * static_cast<double>(resourceSize) / 1.0e6,
+                  readsPerSec / baseline);
+    }
+  }
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,639 @@
+/**
+ * @file bench_vfs_suite.cpp
+ * @brief VFS throughput and latency suite with JSON output
+ *
+ * Generates synthetic packs of each kind (plain, compressed, encrypted,
+ * signed) and measures, per kind and access mode:
+ * - mount time, with the pack evicted from the page cache and warm
+ * - random and sequential read latency percentiles and throughput
+ * - read throughput from 1..N threads
+ * and, once per run, the ResourceCache hit path and MultiPackManager
+ * override resolution across a base pack and several mod packs.
+ *
+ * Results go to stdout (or out=<file>) as one JSON document, so runs before
+ * and after a change to the pack format or the readers can be diffed.
+ *
+ * Usage: vfs_suite_benchmarks [key=value...]
+ *   entries=4096 min-size=1024 max-size=262144 reads=20000 threads=<cores>
+ *   mods=4 kinds=plain,compressed,encrypted,signed out=<file> dir=<tmp>
+ */
+
+#include "synthetic_pack.hpp"
+
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/multi_pack_manager.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace NovelMind;
+using namespace NovelMind::bench;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  usize entries = 4096;
+  usize minSize = 1024;
+  usize maxSize = 256 * 1024;
+  usize reads = 20000;
+  usize threads = std::max<usize>(1, std::thread::hardware_concurrency());
+  usize mods = 4;
+  std::vector<SyntheticPackKind> kinds = {
+      SyntheticPackKind::Plain, SyntheticPackKind::Compressed,
+      SyntheticPackKind::Encrypted, SyntheticPackKind::Signed};
+  std::string out;
+  std::string dir = std::filesystem::temp_directory_path().string();
+};
+
+usize parseSize(const std::string &text, usize fallback) {
+  const long long value = std::atoll(text.c_str());
+  return value > 0 ? static_cast<usize>(value) : fallback;
+}
+
+bool parseArgs(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto equals = arg.find('=');
+    if (equals == std::string::npos) {
+      std::fprintf(stderr, "expected key=value, got '%s'\n", arg.c_str());
+      return false;
+    }
+    const std::string key = arg.substr(0, equals);
+    const std::string value = arg.substr(equals + 1);
+    if (key == "entries") {
+      options.entries = parseSize(value, options.entries);
+    } else if (key == "min-size") {
+      options.minSize = parseSize(value, options.minSize);
+    } else if (key == "max-size") {
+      options.maxSize = parseSize(value, options.maxSize);
+    } else if (key == "reads") {
+      options.reads = parseSize(value, options.reads);
+    } else if (key == "threads") {
+      options.threads = parseSize(value, options.threads);
+    } else if (key == "mods") {
+      options.mods = static_cast<usize>(std::max(0, std::atoi(value.c_str())));
+    } else if (key == "out") {
+      options.out = value;
+    } else if (key == "dir") {
+      options.dir = value;
+    } else if (key == "kinds") {
+      options.kinds.clear();
+      std::stringstream list(value);
+      std::string name;
+      while (std::getline(list, name, ',')) {
+        bool known = false;
+        for (auto kind :
+             {SyntheticPackKind::Plain, SyntheticPackKind::Compressed,
+              SyntheticPackKind::Encrypted, SyntheticPackKind::Signed}) {
+          if (name == kindName(kind)) {
+            options.kinds.push_back(kind);
+            known = true;
+          }
+        }
+        if (!known) {
+          std::fprintf(stderr, "unknown pack kind '%s'\n", name.c_str());
+          return false;
+        }
+      }
+    } else {
+      std::fprintf(stderr, "unknown option '%s'\n", key.c_str());
+      return false;
+    }
+  }
+  options.maxSize = std::max(options.maxSize, options.minSize);
+  return true;
+}
+
+// Just enough JSON for flat objects and arrays of them
+class JsonWriter {
+public:
+  JsonWriter &beginObject(const char *key = nullptr) {
+    return open(key, '{');
+  }
+  JsonWriter &endObject() { return close('}'); }
+  JsonWriter &beginArray(const char *key = nullptr) {
+    return open(key, '[');
+  }
+  JsonWriter &endArray() { return close(']'); }
+
+  JsonWriter &field(const char *key, double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    prefix(key);
+    m_out += buffer;
+    return *this;
+  }
+  JsonWriter &field(const char *key, u64 value) {
+    prefix(key);
+    m_out += std::to_string(value);
+    return *this;
+  }
+  JsonWriter &field(const char *key, const std::string &value) {
+    prefix(key);
+    m_out += '"';
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        m_out += '\\';
+      }
+      if (static_cast<unsigned char>(c) >= 0x20) {
+        m_out += c;
+      }
+    }
+    m_out += '"';
+    return *this;
+  }
+
+  [[nodiscard]] const std::string &str() const { return m_out; }
+
+private:
+  JsonWriter &open(const char *key, char bracket) {
+    prefix(key);
+    m_out += bracket;
+    m_first = true;
+    ++m_depth;
+    return *this;
+  }
+  JsonWriter &close(char bracket) {
+    --m_depth;
+    newline();
+    m_out += bracket;
+    m_first = false;
+    return *this;
+  }
+  void prefix(const char *key) {
+    if (!m_first) {
+      m_out += ',';
+    }
+    if (m_depth > 0) {
+      newline();
+    }
+    m_first = false;
+    if (key) {
+      m_out += '"';
+      m_out += key;
+      m_out += "\": ";
+    }
+  }
+  void newline() {
+    m_out += '\n';
+    m_out.append(m_depth * 2, ' ');
+  }
+
+  std::string m_out;
+  bool m_first = true;
+  usize m_depth = 0;
+};
+
+double elapsedMs(Clock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - begin)
+      .count();
+}
+
+void writeLatency(JsonWriter &json, const char *key,
+                  std::vector<double> samplesUs, u64 bytes) {
+  std::sort(samplesUs.begin(), samplesUs.end());
+  const auto percentile = [&](double p) {
+    const auto index = static_cast<usize>(
+        p * static_cast<double>(samplesUs.size() - 1) + 0.5);
+    return samplesUs[index];
+  };
+  const double totalUs =
+      std::accumulate(samplesUs.begin(), samplesUs.end(), 0.0);
+  json.beginObject(key)
+      .field("reads", static_cast<u64>(samplesUs.size()))
+      .field("mean_us", totalUs / static_cast<double>(samplesUs.size()))
+      .field("p50_us", percentile(0.50))
+      .field("p90_us", percentile(0.90))
+      .field("p99_us", percentile(0.99))
+      .field("max_us", samplesUs.back())
+      .field("mb_per_s", static_cast<double>(bytes) / totalUs)
+      .endObject();
+}
+
+// Drop the pack from the page cache so the next mount reads from the device;
+// a no-op where the OS gives no such control
+void evictFromPageCache(const std::string &path) {
+#if defined(__linux__)
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+#else
+  (void)path;
+#endif
+}
+
+struct KindContext {
+  std::vector<u8> key;
+  std::string publicKeyPem;
+};
+
+std::unique_ptr<VFS::SecurePackReader>
+makeReader(SyntheticPackKind kind, bool mapped, const KindContext &context) {
+  auto reader = std::make_unique<VFS::SecurePackReader>();
+  reader->setUseMemoryMapping(mapped);
+  if (kind == SyntheticPackKind::Encrypted) {
+    auto decryptor = std::make_unique<VFS::PackDecryptor>();
+    decryptor->setKey(context.key);
+    reader->setDecryptor(std::move(decryptor));
+  }
+  if (kind == SyntheticPackKind::Signed) {
+    (void)reader->setPublicKeyPem(context.publicKeyPem);
+  }
+  return reader;
+}
+
+void benchmarkReads(JsonWriter &json, VFS::SecurePackReader &reader,
+                    const SyntheticPack &pack, const Options &options) {
+  std::vector<double> samples;
+  samples.reserve(options.reads);
+  std::mt19937_64 rng(7);
+  std::uniform_int_distribution<usize> pick(0, pack.ids.size() - 1);
+  u64 bytes = 0;
+  usize failures = 0;
+  for (usize i = 0; i < options.reads; ++i) {
+    const std::string &id = pack.ids[pick(rng)];
+    const auto begin = Clock::now();
+    auto data = reader.readResource(id);
+    samples.push_back(elapsedMs(begin) * 1000.0);
+    if (data.isOk()) {
+      bytes += data.value().size();
+    } else {
+      ++failures;
+    }
+  }
+  writeLatency(json, "random", samples, bytes);
+
+  // Whole pack front to back, in data order
+  samples.clear();
+  bytes = 0;
+  for (const auto &id : pack.ids) {
+    const auto begin = Clock::now();
+    auto data = reader.readResource(id);
+    samples.push_back(elapsedMs(begin) * 1000.0);
+    if (data.isOk()) {
+      bytes += data.value().size();
+    } else {
+      ++failures;
+    }
+  }
+  writeLatency(json, "sequential", samples, bytes);
+  json.field("failures", static_cast<u64>(failures));
+}
+
+void benchmarkScaling(JsonWriter &json, VFS::SecurePackReader &reader,
+                      const SyntheticPack &pack, const Options &options) {
+  json.beginArray("scaling");
+  double baseline = 0.0;
+  for (usize threadCount = 1; threadCount <= options.threads;
+       threadCount *= 2) {
+    const usize readsPerThread = std::max<usize>(1, options.reads / 4);
+    std::atomic<bool> start{false};
+    std::atomic<u64> bytes{0};
+    std::vector<std::thread> threads;
+    for (usize t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&, t]() {
+        std::mt19937_64 rng(t + 1);
+        std::uniform_int_distribution<usize> pick(0, pack.ids.size() - 1);
+        u64 local = 0;
+        while (!start.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        for (usize i = 0; i < readsPerThread; ++i) {
+          auto data = reader.readResource(pack.ids[pick(rng)]);
+          if (data.isOk()) {
+            local += data.value().size();
+          }
+        }
+        bytes.fetch_add(local, std::memory_order_relaxed);
+      });
+    }
+    const auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    const double seconds = elapsedMs(begin) / 1000.0;
+    const double readsPerSec =
+        static_cast<double>(threadCount * readsPerThread) / seconds;
+    if (threadCount == 1) {
+      baseline = readsPerSec;
+    }
+    json.beginObject()
+        .field("threads", static_cast<u64>(threadCount))
+        .field("reads_per_s", readsPerSec)
+        .field("mb_per_s", static_cast<double>(bytes.load()) / seconds / 1e6)
+        .field("speedup", readsPerSec / baseline)
+        .endObject();
+  }
+  json.endArray();
+}
+
+bool benchmarkKind(JsonWriter &json, SyntheticPackKind kind,
+                   const Options &options) {
+  KindContext context;
+  SyntheticPackSpec spec;
+  spec.kind = kind;
+  spec.entryCount = options.entries;
+  spec.minSize = options.minSize;
+  spec.maxSize = options.maxSize;
+  if (kind == SyntheticPackKind::Encrypted) {
+    spec.key.resize(32);
+    std::iota(spec.key.begin(), spec.key.end(), u8{1});
+    context.key = spec.key;
+  }
+  if (kind == SyntheticPackKind::Signed) {
+    auto keys = generateSigningKeys();
+    if (keys.isError()) {
+      std::fprintf(stderr, "%s\n", keys.error().c_str());
+      return false;
+    }
+    spec.signingKeyPem = keys.value().first;
+    context.publicKeyPem = keys.value().second;
+  }
+
+  const std::string path =
+      (std::filesystem::path(options.dir) /
+       (std::string("nm_bench_suite_") + kindName(kind) + ".nmres"))
+          .string();
+  const auto writeBegin = Clock::now();
+  auto written = writeSyntheticPack(path, spec);
+  if (written.isError()) {
+    std::fprintf(stderr, "%s\n", written.error().c_str());
+    return false;
+  }
+  const SyntheticPack &pack = written.value();
+  const double writeMs = elapsedMs(writeBegin);
+
+  json.beginObject()
+      .field("kind", std::string(kindName(kind)))
+      .field("entries", static_cast<u64>(pack.ids.size()))
+      .field("payload_bytes", pack.payloadBytes)
+      .field("file_bytes", pack.fileBytes)
+      .field("generate_ms", writeMs);
+
+  bool ok = true;
+  json.beginArray("modes");
+  for (bool mapped : {true, false}) {
+    evictFromPageCache(path);
+    auto reader = makeReader(kind, mapped, context);
+    auto begin = Clock::now();
+    if (reader->openPack(path).isError()) {
+      std::fprintf(stderr, "failed to open %s\n", path.c_str());
+      ok = false;
+      break;
+    }
+    const double coldMs = elapsedMs(begin);
+    reader->closePack();
+    begin = Clock::now();
+    (void)reader->openPack(path);
+    const double warmMs = elapsedMs(begin);
+
+    json.beginObject()
+        .field("mode", std::string(mapped ? "mmap" : "pread"))
+        .field("mapped", static_cast<u64>(reader->isMemoryMapped()))
+        .field("mount_cold_ms", coldMs)
+        .field("mount_warm_ms", warmMs);
+    benchmarkReads(json, *reader, pack, options);
+    benchmarkScaling(json, *reader, pack, options);
+    json.endObject();
+  }
+  json.endArray().endObject();
+
+  std::filesystem::remove(path);
+  return ok;
+}
+
+void benchmarkCache(JsonWriter &json, const Options &options) {
+  constexpr usize kEntries = 1024;
+  constexpr usize kEntrySize = 4096;
+  VFS::ResourceCache cache(kEntries * kEntrySize * 2);
+  std::vector<VFS::ResourceId> ids;
+  for (usize i = 0; i < kEntries; ++i) {
+    ids.emplace_back(resourceName(i));
+    cache.put(ids.back(), std::vector<u8>(kEntrySize, static_cast<u8>(i)));
+  }
+  // Promote everything out of the admission window first
+  for (int pass = 0; pass < 4; ++pass) {
+    for (const auto &id : ids) {
+      (void)cache.get(id);
+    }
+  }
+
+  json.beginArray("resource_cache_hit");
+  for (usize threadCount = 1; threadCount <= options.threads;
+       threadCount *= 2) {
+    const usize lookups = std::max<usize>(options.reads * 10, 1);
+    std::atomic<bool> start{false};
+    std::atomic<u64> misses{0};
+    std::vector<std::thread> threads;
+    for (usize t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&, t]() {
+        usize index = t * 131;
+        u64 localMisses = 0;
+        while (!start.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        for (usize i = 0; i < lookups; ++i) {
+          index = (index + 97) % kEntries;
+          if (!cache.get(ids[index])) {
+            ++localMisses;
+          }
+        }
+        misses.fetch_add(localMisses, std::memory_order_relaxed);
+      });
+    }
+    const auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    const double ns = elapsedMs(begin) * 1e6;
+    json.beginObject()
+        .field("threads", static_cast<u64>(threadCount))
+        .field("ns_per_get", ns / static_cast<double>(lookups))
+        .field("gets_per_s",
+               static_cast<double>(lookups * threadCount) / ns * 1e9)
+        .field("misses", misses.load())
+        .endObject();
+  }
+  json.endArray();
+}
+
+// Base pack of every id plus `mods` mod packs; mod m overrides ids
+// m + 1, m + 1 + (mods + 1), ..., so every (mods + 1)-th id stays in the base
+bool benchmarkOverrides(JsonWriter &json, const Options &options) {
+  std::vector<std::string> paths;
+  vfs::MultiPackManager manager;
+  if (manager.initialize().isError()) {
+    return false;
+  }
+
+  const auto write = [&](const std::string &name,
+                         const SyntheticPackSpec &spec) {
+    const auto path =
+        (std::filesystem::path(options.dir) / name).string();
+    paths.push_back(path);
+    return writeSyntheticPack(path, spec);
+  };
+
+  SyntheticPackSpec baseSpec;
+  baseSpec.entryCount = options.entries;
+  baseSpec.minSize = options.minSize;
+  baseSpec.maxSize = std::min<usize>(options.maxSize, 16 * 1024);
+  auto base = write("nm_bench_base.nmres", baseSpec);
+  if (base.isError() || !manager.loadBasePack(paths.back()).success) {
+    return false;
+  }
+
+  std::map<std::string, usize> overriddenBy;
+  for (usize m = 0; m < options.mods; ++m) {
+    SyntheticPackSpec modSpec = baseSpec;
+    modSpec.firstIndex = m + 1;
+    modSpec.indexStride = options.mods + 1;
+    modSpec.seed = m + 2;
+    modSpec.entryCount =
+        options.entries > modSpec.firstIndex
+            ? (options.entries - modSpec.firstIndex + options.mods) /
+                  modSpec.indexStride
+            : 0;
+    auto mod = write("nm_bench_mod_" + std::to_string(m) + ".nmres", modSpec);
+    if (mod.isError() ||
+        !manager
+             .loadPack(paths.back(), vfs::PackType::Mod, static_cast<i32>(m))
+             .success) {
+      return false;
+    }
+    for (const auto &id : mod.value().ids) {
+      overriddenBy[id] = m;
+    }
+  }
+
+  std::vector<std::string> baseIds;
+  std::vector<std::string> modIds;
+  for (const auto &id : base.value().ids) {
+    (overriddenBy.count(id) ? modIds : baseIds).push_back(id);
+  }
+
+  const auto measure = [&](const char *key,
+                           const std::vector<std::string> &ids) {
+    if (ids.empty()) {
+      return;
+    }
+    const usize lookups = std::max<usize>(options.reads, 1);
+    usize hits = 0;
+    auto begin = Clock::now();
+    for (usize i = 0; i < lookups; ++i) {
+      if (manager.exists(ids[(i * 7919) % ids.size()])) {
+        ++hits;
+      }
+    }
+    const double existsNs = elapsedMs(begin) * 1e6;
+    begin = Clock::now();
+    for (usize i = 0; i < lookups; ++i) {
+      if (!manager.getResourcePack(ids[(i * 7919) % ids.size()]).empty()) {
+        ++hits;
+      }
+    }
+    const double resolveNs = elapsedMs(begin) * 1e6;
+    std::vector<double> samples;
+    u64 bytes = 0;
+    for (usize i = 0; i < std::min<usize>(lookups, 5000); ++i) {
+      const auto readBegin = Clock::now();
+      auto data = manager.readResource(ids[(i * 7919) % ids.size()]);
+      samples.push_back(elapsedMs(readBegin) * 1000.0);
+      bytes += data.isOk() ? data.value().size() : 0;
+    }
+    json.beginObject(key)
+        .field("ids", static_cast<u64>(ids.size()))
+        .field("exists_ns", existsNs / static_cast<double>(lookups))
+        .field("resolve_ns", resolveNs / static_cast<double>(lookups))
+        .field("found", static_cast<u64>(hits))
+        .field("lookups", static_cast<u64>(lookups * 2));
+    writeLatency(json, "read", samples, bytes);
+    json.endObject();
+  };
+
+  json.beginObject("multi_pack_overrides")
+      .field("mod_packs", static_cast<u64>(options.mods))
+      .field("overridden_count", static_cast<u64>(modIds.size()));
+  measure("base_ids", baseIds);
+  measure("overridden_ids", modIds);
+  json.endObject();
+
+  manager.shutdown();
+  for (const auto &path : paths) {
+    std::filesystem::remove(path);
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  core::Logger::instance().setLevel(core::LogLevel::Warning);
+
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    return 2;
+  }
+
+  JsonWriter json;
+  json.beginObject()
+      .field("entries", static_cast<u64>(options.entries))
+      .field("min_size", static_cast<u64>(options.minSize))
+      .field("max_size", static_cast<u64>(options.maxSize))
+      .field("reads", static_cast<u64>(options.reads))
+      .field("max_threads", static_cast<u64>(options.threads));
+
+  bool ok = true;
+  json.beginArray("packs");
+  for (auto kind : options.kinds) {
+    if (!isKindSupported(kind)) {
+      std::fprintf(stderr, "skipping %s packs: not supported in this build\n",
+                   kindName(kind));
+      continue;
+    }
+    ok = benchmarkKind(json, kind, options) && ok;
+  }
+  json.endArray();
+
+  benchmarkCache(json, options);
+  if (!benchmarkOverrides(json, options)) {
+    std::fprintf(stderr, "MultiPackManager benchmark failed\n");
+    ok = false;
+  }
+  json.endObject();
+
+  if (options.out.empty()) {
+    std::printf("%s\n", json.str().c_str());
+  } else {
+    std::ofstream out(options.out, std::ios::trunc);
+    out << json.str() << '\n';
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+#include "synthetic_pack.hpp"
+
+#include "NovelMind/vfs/pack_compression.hpp"
+#include "NovelMind/vfs/pack_hash_tree.hpp"
+#include "NovelMind/vfs/pack_index.hpp"
+#include "NovelMind/vfs/pack_reader.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string_view>
+
+#ifdef NOVELMIND_HAS_OPENSSL
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#endif
+
+namespace NovelMind::bench {
+
+namespace {
+
+using vfs::PackFlags;
+using vfs::PackHeader;
+using vfs::PackResourceEntry;
+
+constexpr u32 kFooterMagic = 0x46524D4E; // "NMRF"
+constexpr usize kFooterSize = 32;
+constexpr usize kTagSize = VFS::PackDecryptor::kTagSize;
+
+template <typename T> void appendPod(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+u64 nextRandom(u64 &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// Half the 64-byte blocks repeat a phrase and half are noise, so codecs
+// land near the ratios they reach on scripts and uncompressed images
+void fillPayload(std::vector<u8> &out, usize size, u64 seed) {
+  static constexpr std::string_view kPhrase =
+      "The rain had not stopped since morning. She looked up and said: ";
+  out.resize(size);
+  u64 state = seed * 0x9E3779B97F4A7C15ULL + 1;
+  for (usize offset = 0; offset < size; offset += 64) {
+    const usize length = std::min<usize>(64, size - offset);
+    if (nextRandom(state) & 1) {
+      for (usize i = 0; i < length; i += 8) {
+        const u64 value = nextRandom(state);
+        std::memcpy(out.data() + offset + i, &value,
+                    std::min<usize>(8, length - i));
+      }
+    } else {
+      std::memcpy(out.data() + offset, kPhrase.data(), length);
+    }
+  }
+}
+
+VFS::PackCompression bestCodec() {
+  return VFS::PackCompressor::isAvailable(VFS::PackCompression::Zstd)
+             ? VFS::PackCompression::Zstd
+             : VFS::PackCompression::Zlib;
+}
+
+#ifdef NOVELMIND_HAS_OPENSSL
+Result<std::vector<u8>> encryptGcm(const std::vector<u8> &key, const u8 *iv,
+                                   usize ivSize, std::span<const u8> aad,
+                                   std::span<const u8> plain) {
+  std::vector<u8> out(plain.size() + kTagSize);
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  int length = 0;
+  const bool ok =
+      ctx &&
+      EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) ==
+          1 &&
+      EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN,
+                          static_cast<int>(ivSize), nullptr) == 1 &&
+      EVP_EncryptInit_ex(ctx, nullptr, nullptr, key.data(), iv) == 1 &&
+      EVP_EncryptUpdate(ctx, nullptr, &length, aad.data(),
+                        static_cast<int>(aad.size())) == 1 &&
+      EVP_EncryptUpdate(ctx, out.data(), &length, plain.data(),
+                        static_cast<int>(plain.size())) == 1 &&
+      EVP_EncryptFinal_ex(ctx, out.data() + length, &length) == 1 &&
+      EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG,
+                          static_cast<int>(kTagSize),
+                          out.data() + plain.size()) == 1;
+  EVP_CIPHER_CTX_free(ctx);
+  if (!ok) {
+    return Result<std::vector<u8>>::error("AES-GCM encryption failed");
+  }
+  return Result<std::vector<u8>>::ok(std::move(out));
+}
+#endif
+
+// Hashes data section chunks as they are written, so signed packs do not
+// need the whole section in memory
+class ChunkHasher {
+public:
+  explicit ChunkHasher(u32 chunkSize) : m_chunkSize(chunkSize) {}
+
+  void update(std::span<const u8> data) {
+    m_pending.insert(m_pending.end(), data.begin(), data.end());
+    const usize whole = m_pending.size() - m_pending.size() % m_chunkSize;
+    if (whole > 0) {
+      auto digests = VFS::PackHashTree::hashChunks(
+          std::span<const u8>(m_pending.data(), whole), m_chunkSize);
+      m_leaves.insert(m_leaves.end(), digests.begin(), digests.end());
+      m_pending.erase(m_pending.begin(),
+                      m_pending.begin() + static_cast<std::ptrdiff_t>(whole));
+    }
+  }
+
+  std::vector<VFS::Sha256Digest> finish() {
+    if (!m_pending.empty()) {
+      auto digests = VFS::PackHashTree::hashChunks(m_pending, m_chunkSize);
+      m_leaves.insert(m_leaves.end(), digests.begin(), digests.end());
+      m_pending.clear();
+    }
+    return std::move(m_leaves);
+  }
+
+private:
+  u32 m_chunkSize;
+  std::vector<u8> m_pending;
+  std::vector<VFS::Sha256Digest> m_leaves;
+};
+
+} // namespace
+
+const char *kindName(SyntheticPackKind kind) {
+  switch (kind) {
+  case SyntheticPackKind::Plain:
+    return "plain";
+  case SyntheticPackKind::Compressed:
+    return "compressed";
+  case SyntheticPackKind::Encrypted:
+    return "encrypted";
+  case SyntheticPackKind::Signed:
+    return "signed";
+  }
+  return "unknown";
+}
+
+std::string resourceName(usize index) {
+  return "bench/resource_" + std::to_string(index);
+}
+
+bool isKindSupported(SyntheticPackKind kind) {
+  switch (kind) {
+  case SyntheticPackKind::Plain:
+    return true;
+  case SyntheticPackKind::Compressed:
+    return VFS::PackCompressor::isAvailable(bestCodec());
+  case SyntheticPackKind::Encrypted:
+  case SyntheticPackKind::Signed:
+#ifdef NOVELMIND_HAS_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+Result<std::pair<std::string, std::string>> generateSigningKeys() {
+  using ResultType = Result<std::pair<std::string, std::string>>;
+#ifdef NOVELMIND_HAS_OPENSSL
+  EVP_PKEY *key = nullptr;
+  EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+  const bool generated = ctx && EVP_PKEY_keygen_init(ctx) == 1 &&
+                         EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, 2048) == 1 &&
+                         EVP_PKEY_keygen(ctx, &key) == 1;
+  EVP_PKEY_CTX_free(ctx);
+  if (!generated) {
+    return ResultType::error("RSA key generation failed");
+  }
+
+  const auto toPem = [key](bool isPrivate) {
+    std::string pem;
+    BIO *bio = BIO_new(BIO_s_mem());
+    if (!bio) {
+      return pem;
+    }
+    const int written =
+        isPrivate ? PEM_write_bio_PrivateKey(bio, key, nullptr, nullptr, 0,
+                                             nullptr, nullptr)
+                  : PEM_write_bio_PUBKEY(bio, key);
+    char *data = nullptr;
+    const long size = BIO_get_mem_data(bio, &data);
+    if (written == 1 && size > 0) {
+      pem.assign(data, static_cast<usize>(size));
+    }
+    BIO_free(bio);
+    return pem;
+  };
+  auto keys = std::make_pair(toPem(true), toPem(false));
+  EVP_PKEY_free(key);
+  if (keys.first.empty() || keys.second.empty()) {
+    return ResultType::error("Failed to export RSA key");
+  }
+  return ResultType::ok(std::move(keys));
+#else
+  return ResultType::error("Signing keys need OpenSSL");
+#endif
+}
+
+Result<SyntheticPack> writeSyntheticPack(const std::string &path,
+                                         const SyntheticPackSpec &spec) {
+  using ResultType = Result<SyntheticPack>;
+  if (!isKindSupported(spec.kind)) {
+    return ResultType::error(std::string("Pack kind not supported: ") +
+                             kindName(spec.kind));
+  }
+  const bool encrypted = spec.kind == SyntheticPackKind::Encrypted;
+  const bool signedPack = spec.kind == SyntheticPackKind::Signed;
+  if (encrypted && spec.key.size() != 32) {
+    return ResultType::error("Encrypted packs need a 32-byte key");
+  }
+  const VFS::PackCompression codec = spec.kind == SyntheticPackKind::Compressed
+                                    ? bestCodec()
+                                    : VFS::PackCompression::None;
+
+  SyntheticPack pack;
+  pack.path = path;
+  pack.ids.reserve(spec.entryCount);
+  for (usize i = 0; i < spec.entryCount; ++i) {
+    pack.ids.push_back(resourceName(spec.firstIndex + i * spec.indexStride));
+  }
+
+  // Tables first: their size does not depend on the payloads, so a
+  // placeholder is written now and the real tables once sizes are known
+  std::vector<u8> strings;
+  std::vector<u32> stringOffsets;
+  std::vector<std::string_view> idViews;
+  for (const auto &id : pack.ids) {
+    stringOffsets.push_back(static_cast<u32>(strings.size()));
+    strings.insert(strings.end(), id.begin(), id.end());
+    strings.push_back(0);
+    idViews.push_back(id);
+  }
+  auto index = VFS::PackHashIndex::build(idViews);
+  if (index.isError()) {
+    return ResultType::error(index.error());
+  }
+
+  const u64 tableOffset = sizeof(PackHeader);
+  const u64 stringOffset =
+      tableOffset + spec.entryCount * sizeof(PackResourceEntry);
+  const u64 dataOffset = stringOffset + sizeof(u32) +
+                         stringOffsets.size() * sizeof(u32) + strings.size() +
+                         index.value().size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    return ResultType::error("Cannot create " + path);
+  }
+  out.write(std::vector<char>(static_cast<usize>(dataOffset)).data(),
+            static_cast<std::streamsize>(dataOffset));
+
+  std::mt19937_64 sizeRng(spec.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const double sizeRange = static_cast<double>(std::max(
+                               spec.maxSize, spec.minSize)) /
+                           static_cast<double>(std::max<usize>(
+                               spec.minSize, 1));
+
+  ChunkHasher hasher(VFS::PackHashTree::kDefaultChunkSize);
+  std::vector<PackResourceEntry> entries(spec.entryCount);
+  std::vector<u8> payload;
+  u64 relativeOffset = 0;
+  for (usize i = 0; i < spec.entryCount; ++i) {
+    const usize size = static_cast<usize>(
+        static_cast<double>(spec.minSize) * std::pow(sizeRange, unit(sizeRng)));
+    fillPayload(payload, size, spec.seed ^ (i + 1));
+    pack.payloadBytes += size;
+
+    PackResourceEntry &entry = entries[i];
+    entry.idStringOffset = static_cast<u32>(i);
+    entry.type = static_cast<u32>(vfs::ResourceType::Data);
+    entry.dataOffset = relativeOffset;
+    entry.uncompressedSize = size;
+    entry.flags = VFS::PackCompressor::entryFlags(codec);
+    entry.checksum =
+        VFS::PackIntegrityChecker::calculateCrc32(payload.data(), size);
+    for (usize b = 0; b < sizeof(entry.iv); ++b) {
+      entry.iv[b] = static_cast<u8>((i >> (b * 8)) ^ (0x5A + b));
+    }
+
+    std::vector<u8> stored;
+    if (codec != VFS::PackCompression::None) {
+      auto compressed = VFS::PackCompressor::compress(codec, payload);
+      if (compressed.isError()) {
+        return ResultType::error(compressed.error());
+      }
+      stored = std::move(compressed).value();
+    } else {
+      stored = payload;
+    }
+#ifdef NOVELMIND_HAS_OPENSSL
+    if (encrypted) {
+      const auto aad = VFS::PackDecryptor::resourceAad(pack.ids[i],
+                                                       entry.type, size);
+      auto sealed = encryptGcm(spec.key, entry.iv, sizeof(entry.iv), aad,
+                               stored);
+      if (sealed.isError()) {
+        return ResultType::error(sealed.error());
+      }
+      stored = std::move(sealed).value();
+    }
+#endif
+
+    entry.compressedSize = stored.size();
+    relativeOffset += stored.size();
+    if (signedPack) {
+      hasher.update(stored);
+    }
+    out.write(reinterpret_cast<const char *>(stored.data()),
+              static_cast<std::streamsize>(stored.size()));
+  }
+
+  std::vector<VFS::Sha256Digest> leaves;
+  usize sectionSize = 0;
+  if (signedPack) {
+    leaves = hasher.finish();
+    // Signature length is only known by signing something
+    std::vector<u8> probe(VFS::PackHashTree::kHeaderSize, 0);
+    auto probed = VFS::PackHashTree::sign(probe, spec.signingKeyPem);
+    if (probed.isError()) {
+      return ResultType::error(probed.error());
+    }
+    sectionSize = probe.size() + leaves.size() * sizeof(VFS::Sha256Digest);
+  }
+
+  PackHeader header{};
+  header.magic = vfs::PACK_MAGIC;
+  header.versionMajor = vfs::PACK_VERSION_MAJOR;
+  header.flags = static_cast<u32>(PackFlags::HashIndex);
+  if (codec != VFS::PackCompression::None) {
+    header.flags |= static_cast<u32>(PackFlags::ResourceCodecs);
+  }
+  if (encrypted) {
+    header.flags |= static_cast<u32>(PackFlags::Encrypted);
+  }
+  if (signedPack) {
+    header.flags |= static_cast<u32>(PackFlags::MerkleSigned);
+  }
+  header.resourceCount = static_cast<u32>(spec.entryCount);
+  header.resourceTableOffset = tableOffset;
+  header.stringTableOffset = stringOffset;
+  header.dataOffset = dataOffset;
+  header.totalSize = dataOffset + relativeOffset + sectionSize + kFooterSize;
+
+  std::vector<u8> tables;
+  tables.reserve(static_cast<usize>(dataOffset));
+  appendPod(tables, header);
+  for (const auto &entry : entries) {
+    appendPod(tables, entry);
+  }
+  appendPod(tables, static_cast<u32>(stringOffsets.size()));
+  for (u32 offset : stringOffsets) {
+    appendPod(tables, offset);
+  }
+  tables.insert(tables.end(), strings.begin(), strings.end());
+  tables.insert(tables.end(), index.value().begin(), index.value().end());
+
+  u64 hashTreeOffset = 0;
+  if (signedPack) {
+    hashTreeOffset = dataOffset + relativeOffset;
+    auto section = VFS::PackHashTree::buildSection(
+        dataOffset, relativeOffset, VFS::PackHashTree::kDefaultChunkSize,
+        VFS::PackIntegrityChecker::calculateSha256(tables.data(),
+                                                   tables.size()),
+        leaves);
+    auto signResult = VFS::PackHashTree::sign(section, spec.signingKeyPem);
+    if (signResult.isError()) {
+      return ResultType::error(signResult.error());
+    }
+    out.write(reinterpret_cast<const char *>(section.data()),
+              static_cast<std::streamsize>(section.size()));
+  }
+
+  std::vector<u8> footer;
+  appendPod(footer, kFooterMagic);
+  appendPod(footer, VFS::PackIntegrityChecker::calculateCrc32(tables.data(),
+                                                              tables.size()));
+  footer.resize(footer.size() + 12, 0); // Timestamp and build number
+  appendPod(footer, hashTreeOffset);
+  footer.resize(kFooterSize, 0);
+  out.write(reinterpret_cast<const char *>(footer.data()),
+            static_cast<std::streamsize>(footer.size()));
+
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(tables.data()),
+            static_cast<std::streamsize>(tables.size()));
+  out.close();
+  if (!out) {
+    return ResultType::error("Failed to write " + path);
+  }
+  pack.fileBytes = header.totalSize;
+  return ResultType::ok(std::move(pack));
+}
+
+} // namespace NovelMind::bench
@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * @file synthetic_pack.hpp
+ * @brief Generator of benchmark packs in the current pack format
+ *
+ * Writes packs the way PackBuilder lays them out (hash index, per-entry
+ * codecs, AES-256-GCM with per-resource AAD, Merkle signature) without
+ * depending on the editor. Payloads are streamed to disk, so packs of any
+ * size can be generated in bounded memory.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace NovelMind::bench {
+
+enum class SyntheticPackKind { Plain, Compressed, Encrypted, Signed };
+
+[[nodiscard]] const char *kindName(SyntheticPackKind kind);
+
+struct SyntheticPackSpec {
+  SyntheticPackKind kind = SyntheticPackKind::Plain;
+  usize entryCount = 4096;
+  // Sizes are log-uniform in [minSize, maxSize], so most resources are small
+  // and a few are large, as in real asset sets
+  usize minSize = 1024;
+  usize maxSize = 64 * 1024;
+  u64 seed = 1;
+  // Resource i is named resourceName(firstIndex + i * indexStride); layered
+  // packs use this to override some of the base pack's ids
+  usize firstIndex = 0;
+  usize indexStride = 1;
+  std::vector<u8> key;       // 32 bytes, Encrypted packs
+  std::string signingKeyPem; // Signed packs
+};
+
+struct SyntheticPack {
+  std::string path;
+  std::vector<std::string> ids; // In data order
+  u64 payloadBytes = 0;         // Sum of uncompressed sizes
+  u64 fileBytes = 0;
+};
+
+[[nodiscard]] std::string resourceName(usize index);
+
+[[nodiscard]] Result<SyntheticPack>
+writeSyntheticPack(const std::string &path, const SyntheticPackSpec &spec);
+
+/// True if packs of @p kind can be written and read in this build
+[[nodiscard]] bool isKindSupported(SyntheticPackKind kind);
+
+/// Throwaway RSA-2048 key pair as {private PEM, public PEM}
+[[nodiscard]] Result<std::pair<std::string, std::string>>
+generateSigningKeys();
+
+} // namespace NovelMind::bench
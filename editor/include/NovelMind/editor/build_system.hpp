@@ -14,6 +14,11 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/vfs/chunked_resource.hpp"
+#include "NovelMind/vfs/content_hash.hpp"
+#include "NovelMind/vfs/pack_compression.hpp"
+#include "NovelMind/vfs/pack_hash_tree.hpp"
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -67,6 +72,17 @@ struct BuildConfig {
   bool encryptAssets = false;
   std::string encryptionKey;
   CompressionLevel compression = CompressionLevel::Balanced;
+  // PEM private key; when set, packs carry a signed hash tree
+  std::string packSigningKeyPath;
+  // Recorded playthroughs (VFS::AccessTrace files); pack data is stored in
+  // first-access order, clustered by scene
+  std::vector<std::string> accessTracePaths;
+  // Pack small images that share a folder (a character's sprites, one UI
+  // screen) into texture atlases of at most this size; 0 disables atlasing
+  i32 textureAtlasSize = 2048;
+  // Downscale images larger than this on either side, keeping their aspect
+  // ratio; 0 ships them at their original size
+  i32 maxTextureSize = 0;
 
   // Features
   bool includeDebugConsole = false;
@@ -233,6 +249,8 @@ public:
       std::function<void(const std::string &, bool isError)> callback);
 
 private:
+  void runBuildPipeline();
+
   // Build steps
   Result<void> prepareOutputDirectory();
   Result<void> compileScripts();
@@ -264,8 +282,10 @@ private:
 
   // Pack building
   Result<void> buildPack(const std::string &outputPath,
-                         const std::vector<std::string> &files, bool encrypt,
+                         const std::vector<std::string> &files,
+                         const std::string &rootPath, bool encrypt,
                          bool compress);
+  [[nodiscard]] bool isLocaleSpecific(const std::string &vfsPath) const;
 
   // Platform-specific
   Result<void> buildWindowsExecutable(const std::string &outputPath);
@@ -290,6 +310,8 @@ private:
   std::vector<std::string> m_scriptFiles;
   std::vector<std::string> m_assetFiles;
   std::unordered_map<std::string, std::string> m_assetMapping;
+  // Staged files produced by the build itself (atlas pages and index)
+  std::vector<std::string> m_generatedAssets;
 };
 
 /**
@@ -300,6 +322,12 @@ public:
   AssetProcessor();
   ~AssetProcessor();
 
+  /**
+   * @brief Largest width or height optimized images keep; larger ones are
+   * downscaled and written as TGA. 0 (the default) disables resizing.
+   */
+  void setMaxImageSize(i32 size) { m_maxImageSize = size; }
+
   /**
    * @brief Process an image file
    */
@@ -321,17 +349,38 @@ public:
                                          const std::string &outputPath);
 
   /**
-   * @brief Generate texture atlas from multiple images
+   * @brief Generate texture atlases from multiple images
+   *
+   * Images are grouped by getAtlasGroup() and each group is packed into
+   * its own pages. Pages and the atlas index are written to the outputPath
+   * directory and the index path is returned, or an empty string if no
+   * image was atlased. Image ids are paths relative to assetRoot (file
+   * names when empty); images missing from getAtlasIndex() stay standalone.
    */
   Result<std::string>
   generateTextureAtlas(const std::vector<std::string> &images,
-                       const std::string &outputPath, i32 maxSize = 4096);
+                       const std::string &outputPath, i32 maxSize = 4096,
+                       const std::string &assetRoot = "");
+
+  /// Index written by the last generateTextureAtlas() call
+  [[nodiscard]] const renderer::TextureAtlasIndex &getAtlasIndex() const {
+    return m_atlasIndex;
+  }
 
   /**
    * @brief Get asset type from file extension
    */
   [[nodiscard]] static std::string getAssetType(const std::string &path);
 
+  /**
+   * @brief Atlas group of an asset path relative to the assets folder
+   *
+   * Images are grouped by the folder they live in ("characters/alice",
+   * "ui/main_menu"). Top-level images and backgrounds, which are drawn
+   * full screen, are not atlased and get an empty group.
+   */
+  [[nodiscard]] static std::string getAtlasGroup(const std::string &path);
+
   /**
    * @brief Check if asset needs processing
    */
@@ -354,10 +403,18 @@ private:
                                   const std::string &format);
   Result<void> normalizeAudio(const std::string &input,
                               const std::string &output);
+
+  renderer::TextureAtlasIndex m_atlasIndex;
+  i32 m_maxImageSize = 0;
 };
 
 /**
  * @brief Pack Builder - Creates encrypted/compressed resource packs
+ *
+ * Files are only read when the pack is finalized. Entries are compressed on a
+ * pool of worker threads and streamed to the output in the order they were
+ * added, so memory use is bounded by the in-flight window rather than by the
+ * size of the pack. The codec is chosen per entry from its asset type.
  */
 class PackBuilder {
 public:
@@ -381,6 +438,30 @@ public:
   Result<void> addData(const std::string &packPath,
                        const std::vector<u8> &data);
 
+  /**
+   * @brief Counts from addPatch()
+   */
+  struct PatchStats {
+    i32 unchangedCount = 0; // Identical in both packs; left out
+    i32 addedCount = 0;     // Only in the updated pack; stored whole
+    i32 replacedCount = 0;  // Changed, but a delta would not be smaller
+    i32 deltaCount = 0;     // Changed and stored as a delta
+    i32 removedCount = 0;   // Only in the base pack; a patch cannot remove
+    i64 deltaSourceSize = 0; // Size of the resources stored as deltas
+    i64 deltaSize = 0;       // Size of their deltas
+  };
+
+  /**
+   * @brief Add what changed between two built packs, for a patch pack
+   *
+   * Resources that differ from @p basePackPath are stored as binary deltas
+   * against the base version when that is clearly smaller than the new
+   * file (see VFS::PackDelta), and whole otherwise. Both packs must be
+   * readable without keys (unencrypted, unsigned or with a valid .sig).
+   */
+  Result<PatchStats> addPatch(const std::string &basePackPath,
+                              const std::string &updatedPackPath);
+
   /**
    * @brief Finalize and write the pack
    */
@@ -396,31 +477,132 @@ public:
    */
   void setCompressionLevel(CompressionLevel level);
 
+  /**
+   * @brief Set the number of compression threads (0 = hardware concurrency)
+   */
+  void setWorkerCount(u32 count);
+
+  /**
+   * @brief Limit on source bytes being compressed or waiting to be written
+   *
+   * A single entry larger than the limit is still processed, on its own.
+   */
+  void setMaxInFlightBytes(u64 bytes);
+
+  /**
+   * @brief Store resources of at least @p threshold bytes as seekable frames
+   *
+   * Chunked resources can be streamed and seeked at runtime, decoding only
+   * the frames that are read. A threshold of 0 disables chunking.
+   */
+  void setChunking(u64 threshold,
+                   u32 frameSize = VFS::ChunkedResource::kDefaultFrameSize);
+
+  /**
+   * @brief Store byte-identical resources once
+   *
+   * Duplicates get their own resource entries pointing at the first copy's
+   * data. Ignored when encrypting, since each entry's ciphertext is bound to
+   * its own id.
+   */
+  void setDeduplication(bool enabled);
+
+  /**
+   * @brief Sign the pack with a Merkle tree over @p chunkSize data chunks
+   *
+   * The runtime then checks only the tables and the signed root at mount
+   * and verifies each chunk when it is first read (see
+   * VFS::PackHashTree). Fails if the key cannot sign.
+   */
+  Result<void>
+  setSigningKey(const std::string &privateKeyPem,
+                u32 chunkSize = VFS::PackHashTree::kDefaultChunkSize);
+
+  /**
+   * @brief Store the listed pack paths first, in this order
+   *
+   * Usually VFS::AccessTrace::layoutOrder() of recorded playthroughs, so a
+   * scene's resources sit next to each other and load as sequential reads.
+   * Entries not listed follow in the order they were added.
+   */
+  void setLayoutOrder(std::vector<std::string> packPaths);
+
+  /**
+   * @brief Codec used for an entry of the given pack path and size
+   *
+   * Already-compressed media is stored raw, text/scripts/PCM use zstd, and
+   * other small assets use LZ4 for fast decode. Falls back to zlib (or raw)
+   * when a codec was not compiled in.
+   */
+  [[nodiscard]] VFS::PackCompression selectCodec(const std::string &packPath,
+                                                 u64 size) const;
+
   /**
    * @brief Get pack statistics
+   *
+   * Compressed size is known only after finalizePack().
    */
   struct PackStats {
     i32 fileCount;
     i64 uncompressedSize;
     i64 compressedSize;
     f32 compressionRatio;
+    i32 deduplicatedCount; // Entries sharing an earlier entry's data
+    i64 deduplicatedSize;  // Source bytes not written because of that
   };
   [[nodiscard]] PackStats getStats() const;
 
 private:
-  Result<std::vector<u8>> compressData(const std::vector<u8> &data);
-  Result<std::vector<u8>> encryptData(const std::vector<u8> &data);
+  struct PackEntry {
+    std::string path;
+    std::string sourcePath; // Read at finalize time; empty for addData()
+    std::vector<u8> data;   // Payload of addData() entries
+    i64 originalSize;
+    u32 type;
+    // data is a VFS::PackDelta against a lower-priority pack
+    bool delta = false;
+  };
+
+  struct EncodedEntry {
+    std::vector<u8> data;
+    VFS::PackCompression codec = VFS::PackCompression::None;
+    bool chunked = false;
+    u32 checksum = 0;
+    u64 uncompressedSize = 0;
+    VFS::ContentHash contentHash;
+    // An earlier entry has the same content; data was left empty
+    bool duplicate = false;
+  };
+
+  // Called with the content hash before encoding; returning true skips it
+  using DuplicateCheck = std::function<bool(const VFS::ContentHash &)>;
+
+  Result<EncodedEntry> encodeEntry(const PackEntry &entry,
+                                   const DuplicateCheck &isDuplicate) const;
+  Result<std::vector<u8>> compressData(const std::vector<u8> &data,
+                                       VFS::PackCompression codec) const;
+  Result<std::vector<u8>> encryptData(const std::vector<u8> &data) const;
+  [[nodiscard]] i32 codecLevel(VFS::PackCompression codec) const;
+  [[nodiscard]] static u32 resourceTypeFor(const std::string &path);
+  void applyLayoutOrder();
 
   std::string m_outputPath;
   std::string m_encryptionKey;
   CompressionLevel m_compressionLevel = CompressionLevel::Balanced;
+  u32 m_workerCount = 0;
+  u64 m_maxInFlightBytes = 256ULL * 1024 * 1024;
+  u64 m_chunkThreshold = 1024 * 1024;
+  u32 m_chunkFrameSize = VFS::ChunkedResource::kDefaultFrameSize;
+  bool m_deduplicate = true;
+  std::string m_signingKeyPem;
+  usize m_signatureBlockSize = 0; // u32 size plus the signature itself
+  u32 m_hashChunkSize = VFS::PackHashTree::kDefaultChunkSize;
+  std::vector<std::string> m_layoutOrder;
 
-  struct PackEntry {
-    std::string path;
-    std::vector<u8> data;
-    i64 originalSize;
-  };
   std::vector<PackEntry> m_entries;
+  i64 m_writtenDataSize = 0;
+  i32 m_deduplicatedCount = 0;
+  i64 m_deduplicatedSize = 0;
 };
 
 /**
@@ -524,6 +706,16 @@ Result<void> deleteDirectory(const std::string &path);
  * @brief Create directory structure
  */
 Result<void> createDirectories(const std::string &path);
+
+/**
+ * @brief Resource id a packed file is stored under
+ *
+ * The path of @p filePath relative to @p rootPath with '/' separators, the
+ * same ids the resource manifest and the texture atlas index use. Files
+ * outside the root keep their file name.
+ */
+std::string packResourceId(const std::string &filePath,
+                           const std::string &rootPath);
 } // namespace BuildUtils
 
 } // namespace NovelMind::editor
@@ -11,6 +11,7 @@
  */
 
 #include "NovelMind/editor/build_size_analyzer.hpp"
+#include "NovelMind/vfs/content_hash.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -868,41 +869,21 @@ void BuildSizeAnalyzer::reportProgress(const std::string &task, f32 progress) {
 }
 
 std::string BuildSizeAnalyzer::computeFileHash(const std::string &path) {
-  // Simple hash based on file size and first/last bytes
-  // In production, would use SHA-256 or similar
+  // Same content hash PackBuilder uses, so reported duplicate groups are
+  // exactly what a pack build stores once
   try {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
       return "";
     }
 
-    auto size = file.tellg();
-    file.seekg(0);
-
-    u64 hash = static_cast<u64>(size);
-
-    // Read first 1KB
-    char buffer[1024];
-    file.read(buffer, std::min(static_cast<std::streamsize>(1024),
-                               static_cast<std::streamsize>(size)));
-
-    for (i32 i = 0; i < file.gcount(); i++) {
-      hash = hash * 31 + static_cast<u8>(buffer[i]);
-    }
-
-    // Read last 1KB if file is larger
-    if (size > 2048) {
-      file.seekg(-1024, std::ios::end);
-      file.read(buffer, 1024);
-
-      for (i32 i = 0; i < file.gcount(); i++) {
-        hash = hash * 31 + static_cast<u8>(buffer[i]);
-      }
+    VFS::ContentHasher hasher;
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+      file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      hasher.update(buffer.data(), static_cast<usize>(file.gcount()));
     }
-
-    std::ostringstream oss;
-    oss << std::hex << hash;
-    return oss.str();
+    return hasher.finish().toHex();
 
   } catch (const std::exception &) {
     return "";
@@ -12,14 +12,27 @@
  */
 
 #include "NovelMind/editor/build_system.hpp"
+#include "NovelMind/renderer/image_processing.hpp"
+#include "NovelMind/vfs/access_trace.hpp"
+#include "NovelMind/vfs/chunked_resource.hpp"
+#include "NovelMind/vfs/pack_delta.hpp"
+#include "NovelMind/vfs/pack_index.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace fs = std::filesystem;
 
@@ -160,6 +173,16 @@ Result<void> createDirectories(const std::string &path) {
   }
 }
 
+std::string packResourceId(const std::string &filePath,
+                           const std::string &rootPath) {
+  const fs::path relative =
+      fs::path(filePath).lexically_relative(fs::path(rootPath));
+  if (rootPath.empty() || relative.empty() || *relative.begin() == "..") {
+    return fs::path(filePath).filename().string();
+  }
+  return relative.generic_string();
+}
+
 } // namespace BuildUtils
 
 // ============================================================================
@@ -611,6 +634,49 @@ Result<void> BuildSystem::processAssets() {
 
   i32 processed = 0;
   m_assetMapping.clear();
+  m_generatedAssets.clear();
+
+  // Atlas pages replace the images packed into them
+  std::unordered_set<std::string> atlased;
+  if (m_config.textureAtlasSize > 0) {
+    const fs::path assetsRoot = fs::path(m_config.projectPath) / "assets";
+    std::vector<std::string> candidates;
+    for (const auto &assetPath : m_assetFiles) {
+      if (AssetProcessor::getAssetType(assetPath) == "image" &&
+          !isLocaleSpecific(
+              fs::relative(assetPath, assetsRoot).generic_string())) {
+        candidates.push_back(assetPath);
+      }
+    }
+
+    if (!candidates.empty()) {
+      updateProgress(0.0f, "Packing texture atlases...");
+      AssetProcessor processor;
+      auto atlasResult = processor.generateTextureAtlas(
+          candidates, assetsDir.string(), m_config.textureAtlasSize,
+          assetsRoot.string());
+      if (atlasResult.isError()) {
+        m_progress.warnings.push_back("Texture atlas generation failed: " +
+                                      atlasResult.error());
+      } else if (!atlasResult.value().empty()) {
+        const auto &index = processor.getAtlasIndex();
+        for (const auto &assetPath : candidates) {
+          if (index.find(
+                  fs::relative(assetPath, assetsRoot).generic_string())) {
+            atlased.insert(assetPath);
+          }
+        }
+        for (const auto &page : index.pages()) {
+          m_generatedAssets.push_back((assetsDir / page.id).string());
+        }
+        m_generatedAssets.push_back(atlasResult.value());
+        logMessage("Packed " + std::to_string(index.spriteCount()) +
+                       " images into " + std::to_string(index.pages().size()) +
+                       " texture atlas pages",
+                   false);
+      }
+    }
+  }
 
   for (const auto &assetPath : m_assetFiles) {
     if (m_cancelRequested) {
@@ -622,6 +688,12 @@ Result<void> BuildSystem::processAssets() {
                    static_cast<f32>(m_assetFiles.size());
     updateProgress(progress, "Processing: " + fs::path(assetPath).filename().string());
 
+    if (atlased.count(assetPath) > 0) {
+      processed++;
+      m_progress.filesProcessed++;
+      continue;
+    }
+
     // Determine asset type and process accordingly
     std::string ext = fs::path(assetPath).extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
@@ -666,7 +738,8 @@ Result<void> BuildSystem::processAssets() {
   if (manifestFile.is_open()) {
     manifestFile << "{\n";
     manifestFile << "  \"version\": \"1.0\",\n";
-    manifestFile << "  \"resource_count\": " << m_assetMapping.size() << ",\n";
+    manifestFile << "  \"resource_count\": "
+                 << m_assetMapping.size() + m_generatedAssets.size() << ",\n";
     manifestFile << "  \"resources\": [\n";
 
     bool first = true;
@@ -677,6 +750,13 @@ Result<void> BuildSystem::processAssets() {
       manifestFile << "    {\"source\": \"" << sourcePath
                    << "\", \"vfs_path\": \"" << vfsPath << "\"}";
     }
+    for (const auto &generatedPath : m_generatedAssets) {
+      if (!first)
+        manifestFile << ",\n";
+      first = false;
+      manifestFile << "    {\"generated\": true, \"vfs_path\": \""
+                   << fs::path(generatedPath).filename().string() << "\"}";
+    }
 
     manifestFile << "\n  ]\n";
     manifestFile << "}\n";
@@ -707,17 +787,7 @@ Result<void> BuildSystem::packResources() {
   // Build base pack
   std::vector<std::string> baseFiles;
   for (const auto &[sourcePath, vfsPath] : m_assetMapping) {
-    // Check if this is a locale-specific file
-    bool isLocaleSpecific = false;
-    for (const auto &lang : m_config.includedLanguages) {
-      if (vfsPath.find("/" + lang + "/") != std::string::npos ||
-          vfsPath.find(lang + "/") == 0) {
-        isLocaleSpecific = true;
-        break;
-      }
-    }
-
-    if (!isLocaleSpecific) {
+    if (!isLocaleSpecific(vfsPath)) {
       fs::path processedPath =
           stagingDir / "assets" /
           fs::relative(sourcePath, fs::path(m_config.projectPath) / "assets");
@@ -726,10 +796,15 @@ Result<void> BuildSystem::packResources() {
       }
     }
   }
+  for (const auto &generatedPath : m_generatedAssets) {
+    if (fs::exists(generatedPath)) {
+      baseFiles.push_back(generatedPath);
+    }
+  }
 
   auto baseResult =
       buildPack((packsDir / "Base.nmres").string(), baseFiles,
-                m_config.encryptAssets,
+                (stagingDir / "assets").string(), m_config.encryptAssets,
                 m_config.compression != CompressionLevel::None);
   if (baseResult.isError()) {
     endStep(false, baseResult.error());
@@ -765,7 +840,7 @@ Result<void> BuildSystem::packResources() {
       std::string packName = "Lang_" + lang + ".nmres";
       auto langResult =
           buildPack((packsDir / packName).string(), langFiles,
-                    m_config.encryptAssets,
+                    (stagingDir / "assets").string(), m_config.encryptAssets,
                     m_config.compression != CompressionLevel::None);
       if (langResult.isError()) {
         m_progress.warnings.push_back("Failed to create language pack for " +
@@ -1173,8 +1248,19 @@ AssetProcessResult BuildSystem::processImage(const std::string &sourcePath,
   result.outputPath = outputPath;
   result.success = true;
 
+  if (m_config.maxTextureSize > 0) {
+    AssetProcessor processor;
+    processor.setMaxImageSize(m_config.maxTextureSize);
+    auto processed = processor.processImage(sourcePath, outputPath);
+    if (processed.isOk()) {
+      return processed.value();
+    }
+    result.success = false;
+    result.errorMessage = processed.error();
+    return result;
+  }
+
   try {
-    // For now, just copy the file (in production, would apply optimization)
     fs::copy(sourcePath, outputPath, fs::copy_options::overwrite_existing);
 
     result.originalSize = static_cast<i64>(fs::file_size(sourcePath));
@@ -1256,153 +1342,87 @@ AssetProcessResult BuildSystem::processData(const std::string &sourcePath,
 
 Result<void> BuildSystem::buildPack(const std::string &outputPath,
                                     const std::vector<std::string> &files,
-                                    bool encrypt, bool compress) {
-  try {
-    std::ofstream output(outputPath, std::ios::binary);
-    if (!output.is_open()) {
-      return Result<void>::error("Cannot create pack file: " + outputPath);
+                                    const std::string &rootPath, bool encrypt,
+                                    bool compress) {
+  PackBuilder builder;
+  builder.setCompressionLevel(compress ? m_config.compression
+                                       : CompressionLevel::None);
+  if (encrypt) {
+    builder.setEncryptionKey(m_config.encryptionKey);
+  }
+  if (!m_config.packSigningKeyPath.empty()) {
+    std::ifstream keyFile(m_config.packSigningKeyPath);
+    if (!keyFile) {
+      return Result<void>::error("Failed to read pack signing key: " +
+                                 m_config.packSigningKeyPath);
     }
-
-    // Write pack header
-    const char magic[] = "NMRS"; // NovelMind Resource Pack
-    output.write(magic, 4);
-
-    u16 versionMajor = 1;
-    u16 versionMinor = 0;
-    output.write(reinterpret_cast<const char *>(&versionMajor), sizeof(versionMajor));
-    output.write(reinterpret_cast<const char *>(&versionMinor), sizeof(versionMinor));
-
-    u32 flags = 0;
-    if (encrypt)
-      flags |= 0x01; // ENCRYPTED flag
-    if (compress)
-      flags |= 0x02; // COMPRESSED flag
-    output.write(reinterpret_cast<const char *>(&flags), sizeof(flags));
-
-    u32 resourceCount = static_cast<u32>(files.size());
-    output.write(reinterpret_cast<const char *>(&resourceCount), sizeof(resourceCount));
-
-    // Reserve space for table offsets (will be filled later)
-    u64 resourceTableOffset = 0;
-    u64 stringTableOffset = 0;
-    u64 dataOffset = 0;
-    auto headerPos = output.tellp();
-    output.write(reinterpret_cast<const char *>(&resourceTableOffset), sizeof(resourceTableOffset));
-    output.write(reinterpret_cast<const char *>(&stringTableOffset), sizeof(stringTableOffset));
-    output.write(reinterpret_cast<const char *>(&dataOffset), sizeof(dataOffset));
-
-    // Pad header to 64 bytes
-    u64 totalFileSize = 0;
-    output.write(reinterpret_cast<const char *>(&totalFileSize), sizeof(totalFileSize));
-    char padding[16] = {0};
-    output.write(padding, 16);
-
-    // Record resource table start
-    resourceTableOffset = static_cast<u64>(output.tellp());
-
-    // Build string table
-    std::vector<std::string> resourceIds;
-    std::vector<u32> stringOffsets;
-    u32 currentStringOffset = 0;
-
-    for (const auto &file : files) {
-      fs::path p(file);
-      std::string resourceId = p.filename().string();
-      resourceIds.push_back(resourceId);
-      stringOffsets.push_back(currentStringOffset);
-      currentStringOffset += static_cast<u32>(resourceId.size()) + 1; // +1 for null terminator
+    std::ostringstream pem;
+    pem << keyFile.rdbuf();
+    auto keyResult = builder.setSigningKey(pem.str());
+    if (keyResult.isError()) {
+      return keyResult;
     }
+  }
 
-    // Write resource table entries (48 bytes each)
-    u64 currentDataOffset = 0;
-    std::vector<std::pair<u64, u64>> resourceDataInfo; // offset, size pairs
-
-    for (size_t i = 0; i < files.size(); i++) {
-      u32 stringIdOffset = stringOffsets[i];
-      output.write(reinterpret_cast<const char *>(&stringIdOffset), sizeof(stringIdOffset));
-
-      u32 resourceType = 0x08; // Data type
-      output.write(reinterpret_cast<const char *>(&resourceType), sizeof(resourceType));
-
-      u64 dataOffsetEntry = currentDataOffset;
-      output.write(reinterpret_cast<const char *>(&dataOffsetEntry), sizeof(dataOffsetEntry));
-
-      u64 fileSize = fs::file_size(files[i]);
-      u64 compressedSize = fileSize; // No actual compression for now
-      u64 uncompressedSize = fileSize;
-
-      output.write(reinterpret_cast<const char *>(&compressedSize), sizeof(compressedSize));
-      output.write(reinterpret_cast<const char *>(&uncompressedSize), sizeof(uncompressedSize));
-
-      u32 resourceFlags = 0;
-      output.write(reinterpret_cast<const char *>(&resourceFlags), sizeof(resourceFlags));
-
-      u32 crc32 = 0; // Placeholder
-      output.write(reinterpret_cast<const char *>(&crc32), sizeof(crc32));
-
-      u8 iv[8] = {0}; // Placeholder IV
-      output.write(reinterpret_cast<const char *>(iv), 8);
-
-      resourceDataInfo.emplace_back(currentDataOffset, fileSize);
-      currentDataOffset += fileSize;
-    }
-
-    // Write string table
-    stringTableOffset = static_cast<u64>(output.tellp());
-
-    u32 stringCount = static_cast<u32>(resourceIds.size());
-    output.write(reinterpret_cast<const char *>(&stringCount), sizeof(stringCount));
-
-    for (u32 offset : stringOffsets) {
-      output.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
-    }
+  auto beginResult = builder.beginPack(outputPath);
+  if (beginResult.isError()) {
+    return beginResult;
+  }
 
-    for (const auto &id : resourceIds) {
-      output.write(id.c_str(), id.size() + 1); // Include null terminator
+  for (const auto &file : files) {
+    auto addResult =
+        builder.addFile(file, BuildUtils::packResourceId(file, rootPath));
+    if (addResult.isError()) {
+      return addResult;
     }
+  }
 
-    // Write resource data
-    dataOffset = static_cast<u64>(output.tellp());
-
-    for (const auto &file : files) {
-      std::ifstream input(file, std::ios::binary);
-      if (input.is_open()) {
-        output << input.rdbuf();
-        input.close();
+  if (!m_config.accessTracePaths.empty()) {
+    std::vector<VFS::AccessTrace> traces;
+    for (const auto &tracePath : m_config.accessTracePaths) {
+      auto trace = VFS::AccessTrace::load(tracePath);
+      if (trace.isError()) {
+        return Result<void>::error(trace.error());
       }
+      traces.push_back(std::move(trace).value());
     }
+    auto order = VFS::AccessTrace::layoutOrder(traces);
+    logMessage("Laying out pack from " + std::to_string(traces.size()) +
+                   " access traces (" + std::to_string(order.size()) +
+                   " resources traced)",
+               false);
+    builder.setLayoutOrder(std::move(order));
+  }
 
-    // Write footer
-    const char footerMagic[] = "NMRF";
-    output.write(footerMagic, 4);
-
-    u32 tableCrc = 0; // Placeholder
-    output.write(reinterpret_cast<const char *>(&tableCrc), sizeof(tableCrc));
-
-    u64 timestamp =
-        static_cast<u64>(std::chrono::system_clock::now().time_since_epoch().count());
-    output.write(reinterpret_cast<const char *>(&timestamp), sizeof(timestamp));
-
-    u32 buildNumber = 1;
-    output.write(reinterpret_cast<const char *>(&buildNumber), sizeof(buildNumber));
-
-    char footerPadding[12] = {0};
-    output.write(footerPadding, 12);
-
-    // Update header with correct offsets
-    totalFileSize = static_cast<u64>(output.tellp());
-    output.seekp(headerPos);
-    output.write(reinterpret_cast<const char *>(&resourceTableOffset), sizeof(resourceTableOffset));
-    output.write(reinterpret_cast<const char *>(&stringTableOffset), sizeof(stringTableOffset));
-    output.write(reinterpret_cast<const char *>(&dataOffset), sizeof(dataOffset));
-    output.write(reinterpret_cast<const char *>(&totalFileSize), sizeof(totalFileSize));
+  auto finalizeResult = builder.finalizePack();
+  if (finalizeResult.isError()) {
+    return Result<void>::error("Pack creation failed: " +
+                               finalizeResult.error());
+  }
 
-    output.close();
-    return Result<void>::ok();
+  const auto stats = builder.getStats();
+  logMessage("Packed " + std::to_string(stats.fileCount) + " files into " +
+                 fs::path(outputPath).filename().string() + " (" +
+                 BuildUtils::formatFileSize(stats.compressedSize) + " of " +
+                 BuildUtils::formatFileSize(stats.uncompressedSize) + ")",
+             false);
+  if (stats.deduplicatedCount > 0) {
+    logMessage("Stored " + std::to_string(stats.deduplicatedCount) +
+                   " duplicate files once, saving " +
+                   BuildUtils::formatFileSize(stats.deduplicatedSize),
+               false);
+  }
+  return Result<void>::ok();
+}
 
-  } catch (const std::exception &e) {
-    return Result<void>::error(std::string("Pack creation failed: ") + e.what());
+bool BuildSystem::isLocaleSpecific(const std::string &vfsPath) const {
+  for (const auto &lang : m_config.includedLanguages) {
+    if (vfsPath.find("/" + lang + "/") != std::string::npos ||
+        vfsPath.find(lang + "/") == 0) {
+      return true;
+    }
   }
+  return false;
 }
 
 Result<void> BuildSystem::buildWindowsExecutable(const std::string &outputPath) {
@@ -1540,11 +1560,17 @@ AssetProcessor::processImage(const std::string &sourcePath,
   result.success = true;
 
   try {
-    if (optimize) {
-      // In production, apply image optimization
-      // For now, just copy
+    if (optimize && m_maxImageSize > 0) {
+      auto resized =
+          resizeImage(sourcePath, outputPath, m_maxImageSize, m_maxImageSize);
+      if (resized.isError()) {
+        result.success = false;
+        result.errorMessage = resized.error();
+        return Result<AssetProcessResult>::error(resized.error());
+      }
+    } else {
+      fs::copy(sourcePath, outputPath, fs::copy_options::overwrite_existing);
     }
-    fs::copy(sourcePath, outputPath, fs::copy_options::overwrite_existing);
     result.originalSize = static_cast<i64>(fs::file_size(sourcePath));
     result.processedSize = static_cast<i64>(fs::file_size(outputPath));
   } catch (const std::exception &e) {
@@ -1604,12 +1630,65 @@ AssetProcessor::processFont(const std::string &sourcePath,
 Result<std::string>
 AssetProcessor::generateTextureAtlas(const std::vector<std::string> &images,
                                      const std::string &outputPath,
-                                     i32 maxSize) {
-  // Placeholder for texture atlas generation
-  // In production, this would use a proper atlas packing algorithm
-  (void)images;
-  (void)maxSize;
-  return Result<std::string>::error("Texture atlas generation not yet implemented");
+                                     i32 maxSize,
+                                     const std::string &assetRoot) {
+  m_atlasIndex = renderer::TextureAtlasIndex{};
+  renderer::TextureAtlasBuilder builder(maxSize);
+
+  for (const auto &image : images) {
+    const std::string id =
+        assetRoot.empty() ? fs::path(image).filename().string()
+                          : fs::relative(image, assetRoot).generic_string();
+    const std::string group = getAtlasGroup(id);
+    if (group.empty()) {
+      continue;
+    }
+
+    std::ifstream file(image, std::ios::binary);
+    if (!file) {
+      return Result<std::string>::error("Failed to read image: " + image);
+    }
+    std::vector<u8> data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+    // Images the decoder can't read stay standalone
+    (void)builder.addImage(group, id, data);
+  }
+
+  auto buildResult = builder.build();
+  if (buildResult.isError()) {
+    return Result<std::string>::error(buildResult.error());
+  }
+  if (builder.index().empty()) {
+    return Result<std::string>::ok(std::string{});
+  }
+
+  try {
+    fs::create_directories(outputPath);
+    for (const auto &page : builder.pages()) {
+      const auto tga = renderer::TextureAtlasBuilder::encodeTga(
+          page.rgba.data(), page.width, page.height);
+      std::ofstream out(fs::path(outputPath) / page.id, std::ios::binary);
+      out.write(reinterpret_cast<const char *>(tga.data()),
+                static_cast<std::streamsize>(tga.size()));
+      if (!out) {
+        return Result<std::string>::error("Failed to write atlas page: " +
+                                          page.id);
+      }
+    }
+
+    const fs::path indexPath =
+        fs::path(outputPath) / renderer::TextureAtlasIndex::kResourceId;
+    std::ofstream indexFile(indexPath, std::ios::binary);
+    indexFile << builder.index().serialize();
+    if (!indexFile) {
+      return Result<std::string>::error("Failed to write atlas index");
+    }
+
+    m_atlasIndex = builder.index();
+    return Result<std::string>::ok(indexPath.string());
+  } catch (const std::exception &e) {
+    return Result<std::string>::error(e.what());
+  }
 }
 
 std::string AssetProcessor::getAssetType(const std::string &path) {
@@ -1635,6 +1714,21 @@ std::string AssetProcessor::getAssetType(const std::string &path) {
   return "other";
 }
 
+std::string AssetProcessor::getAtlasGroup(const std::string &path) {
+  const fs::path relative(path);
+  const std::string folder = relative.parent_path().generic_string();
+  if (folder.empty()) {
+    return {};
+  }
+
+  std::string top = relative.begin()->string();
+  std::transform(top.begin(), top.end(), top.begin(), ::tolower);
+  if (top == "backgrounds" || top == "background" || top == "bg") {
+    return {};
+  }
+  return folder;
+}
+
 bool AssetProcessor::needsProcessing(const std::string &sourcePath,
                                      const std::string &outputPath) const {
   if (!fs::exists(outputPath)) {
@@ -1650,11 +1744,46 @@ bool AssetProcessor::needsProcessing(const std::string &sourcePath,
 Result<void> AssetProcessor::resizeImage(const std::string &input,
                                          const std::string &output,
                                          i32 maxWidth, i32 maxHeight) {
-  (void)input;
-  (void)output;
-  (void)maxWidth;
-  (void)maxHeight;
-  return Result<void>::error("Image resizing not yet implemented");
+  std::ifstream file(input, std::ios::binary);
+  if (!file) {
+    return Result<void>::error("Failed to read image: " + input);
+  }
+  std::vector<u8> data((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+  file.close();
+
+  auto decoded = renderer::decodeImage(data);
+  if (decoded.isError()) {
+    return Result<void>::error(input + ": " + decoded.error());
+  }
+  const auto &image = decoded.value();
+  if (image.width <= maxWidth && image.height <= maxHeight) {
+    // Already small enough; keep the original encoding
+    std::ofstream out(output, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    return out ? Result<void>::ok()
+               : Result<void>::error("Failed to write image: " + output);
+  }
+
+  auto resized = renderer::resampleToFit(image.pixels.data(), image.width,
+                                         image.height, maxWidth, maxHeight);
+  if (resized.isError()) {
+    return Result<void>::error(input + ": " + resized.error());
+  }
+
+  // The runtime decoder detects the format from the data, so the output
+  // keeps its name and with it every script reference
+  const auto &small = resized.value();
+  const auto tga = renderer::TextureAtlasBuilder::encodeTga(
+      small.pixels.data(), small.width, small.height);
+  std::ofstream out(output, std::ios::binary);
+  out.write(reinterpret_cast<const char *>(tga.data()),
+            static_cast<std::streamsize>(tga.size()));
+  if (!out) {
+    return Result<void>::error("Failed to write image: " + output);
+  }
+  return Result<void>::ok();
 }
 
 Result<void> AssetProcessor::compressImage(const std::string &input,
@@ -1698,35 +1827,65 @@ Result<void> AssetProcessor::normalizeAudio(const std::string &input,
 PackBuilder::PackBuilder() = default;
 PackBuilder::~PackBuilder() = default;
 
+namespace {
+
+// Layout constants of the .nmres format read by PackReader/SecurePackReader
+constexpr u32 kPackMagic = 0x53524D4E;   // "NMRS"
+constexpr u32 kFooterMagic = 0x46524D4E; // "NMRF"
+constexpr u32 kPackFlagResourceCodecs = 1u << 3;
+constexpr u32 kPackFlagHashIndex = 1u << 4;
+constexpr u32 kPackFlagMerkleSigned = 1u << 5;
+constexpr u64 kPackHeaderSize = 64;
+constexpr u64 kPackEntrySize = 48;
+constexpr u64 kPackFooterSize = 32;
+
+// Assets at or below this size that are not text use LZ4 for fast decode
+constexpr u64 kHotAssetMaxSize = 64 * 1024;
+
+// Keep compressed output only if it saves at least 1/32 of the input
+bool worthCompressing(usize original, usize compressed) {
+  return compressed + original / 32 < original;
+}
+
+template <typename T> void appendBytes(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+std::string lowerExtension(const std::string &path) {
+  std::string ext = fs::path(path).extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return ext;
+}
+
+} // namespace
+
 Result<void> PackBuilder::beginPack(const std::string &outputPath) {
   m_outputPath = outputPath;
   m_entries.clear();
+  m_writtenDataSize = 0;
+  m_deduplicatedCount = 0;
+  m_deduplicatedSize = 0;
   return Result<void>::ok();
 }
 
 Result<void> PackBuilder::addFile(const std::string &sourcePath,
                                   const std::string &packPath) {
-  try {
-    std::ifstream file(sourcePath, std::ios::binary);
-    if (!file.is_open()) {
-      return Result<void>::error("Cannot open file: " + sourcePath);
-    }
-
-    std::vector<u8> data((std::istreambuf_iterator<char>(file)),
-                         std::istreambuf_iterator<char>());
-    file.close();
-
-    PackEntry entry;
-    entry.path = packPath;
-    entry.data = std::move(data);
-    entry.originalSize = static_cast<i64>(entry.data.size());
+  std::error_code ec;
+  const auto size = fs::file_size(sourcePath, ec);
+  if (ec) {
+    return Result<void>::error("Cannot open file: " + sourcePath);
+  }
 
-    m_entries.push_back(std::move(entry));
-    return Result<void>::ok();
+  PackEntry entry;
+  entry.path = packPath;
+  entry.sourcePath = sourcePath;
+  entry.originalSize = static_cast<i64>(size);
+  entry.type = resourceTypeFor(packPath);
 
-  } catch (const std::exception &e) {
-    return Result<void>::error(std::string("Failed to add file: ") + e.what());
-  }
+  m_entries.push_back(std::move(entry));
+  return Result<void>::ok();
 }
 
 Result<void> PackBuilder::addData(const std::string &packPath,
@@ -1735,61 +1894,413 @@ Result<void> PackBuilder::addData(const std::string &packPath,
   entry.path = packPath;
   entry.data = data;
   entry.originalSize = static_cast<i64>(data.size());
+  entry.type = resourceTypeFor(packPath);
 
   m_entries.push_back(std::move(entry));
   return Result<void>::ok();
 }
 
+Result<PackBuilder::PatchStats>
+PackBuilder::addPatch(const std::string &basePackPath,
+                      const std::string &updatedPackPath) {
+  using ResultType = Result<PatchStats>;
+
+  VFS::SecurePackReader base;
+  VFS::SecurePackReader updated;
+  auto openResult = base.openPack(basePackPath);
+  if (openResult.isError()) {
+    return ResultType::error("Cannot open base pack: " + openResult.error());
+  }
+  openResult = updated.openPack(updatedPackPath);
+  if (openResult.isError()) {
+    return ResultType::error("Cannot open updated pack: " +
+                             openResult.error());
+  }
+
+  PatchStats stats;
+  auto ids = updated.listResources();
+  std::sort(ids.begin(), ids.end());
+
+  for (const auto &id : ids) {
+    auto target = updated.readResource(id);
+    if (target.isError()) {
+      return ResultType::error(id + ": " + target.error());
+    }
+
+    if (!base.exists(id)) {
+      addData(id, target.value());
+      ++stats.addedCount;
+      continue;
+    }
+
+    auto previous = base.readResource(id);
+    if (previous.isError()) {
+      return ResultType::error(id + ": " + previous.error());
+    }
+    if (previous.value() == target.value()) {
+      ++stats.unchangedCount;
+      continue;
+    }
+
+    // A delta has to save at least a quarter of the file to be worth the
+    // extra work of rebuilding it at load time
+    auto delta = VFS::PackDelta::create(previous.value(), target.value());
+    if (delta.size() * 4 > target.value().size() * 3) {
+      addData(id, target.value());
+      ++stats.replacedCount;
+      continue;
+    }
+
+    stats.deltaSourceSize += static_cast<i64>(target.value().size());
+    stats.deltaSize += static_cast<i64>(delta.size());
+    ++stats.deltaCount;
+    addData(id, delta);
+    m_entries.back().delta = true;
+  }
+
+  for (const auto &id : base.listResources()) {
+    if (!updated.exists(id)) {
+      ++stats.removedCount;
+    }
+  }
+
+  return ResultType::ok(stats);
+}
+
+void PackBuilder::setLayoutOrder(std::vector<std::string> packPaths) {
+  m_layoutOrder = std::move(packPaths);
+}
+
+void PackBuilder::applyLayoutOrder() {
+  if (m_layoutOrder.empty()) {
+    return;
+  }
+  std::unordered_map<std::string_view, usize> rank;
+  rank.reserve(m_layoutOrder.size());
+  for (const auto &path : m_layoutOrder) {
+    rank.try_emplace(path, rank.size());
+  }
+  const auto rankOf = [&](const PackEntry &entry) {
+    auto it = rank.find(entry.path);
+    return it != rank.end() ? it->second : rank.size();
+  };
+  // Data is written in entry order, so this is the on-disk order
+  std::stable_sort(m_entries.begin(), m_entries.end(),
+                   [&](const PackEntry &a, const PackEntry &b) {
+                     return rankOf(a) < rankOf(b);
+                   });
+}
+
 Result<void> PackBuilder::finalizePack() {
   if (m_outputPath.empty()) {
     return Result<void>::error("Pack not initialized - call beginPack first");
   }
 
+  applyLayoutOrder();
+
   try {
-    std::ofstream output(m_outputPath, std::ios::binary);
+    std::ofstream output(m_outputPath, std::ios::binary | std::ios::trunc);
     if (!output.is_open()) {
       return Result<void>::error("Cannot create pack file: " + m_outputPath);
     }
 
-    // Write pack header (simplified)
-    const char magic[] = "NMRS";
-    output.write(magic, 4);
+    const usize count = m_entries.size();
 
-    u32 entryCount = static_cast<u32>(m_entries.size());
-    output.write(reinterpret_cast<const char *>(&entryCount), sizeof(entryCount));
+    // String table: ids are referenced by index from the resource table
+    std::vector<u8> stringTable;
+    std::vector<u32> stringOffsets;
+    stringOffsets.reserve(count);
+    for (const auto &entry : m_entries) {
+      stringOffsets.push_back(static_cast<u32>(stringTable.size()));
+      stringTable.insert(stringTable.end(), entry.path.begin(),
+                         entry.path.end());
+      stringTable.push_back(0);
+    }
 
-    // Write entries
+    // Perfect hash index over the ids, so readers mount without hashing them
+    std::vector<std::string_view> ids;
+    ids.reserve(count);
     for (const auto &entry : m_entries) {
-      // Write path length and path
-      u32 pathLen = static_cast<u32>(entry.path.size());
-      output.write(reinterpret_cast<const char *>(&pathLen), sizeof(pathLen));
-      output.write(entry.path.c_str(), pathLen);
-
-      // Write data
-      std::vector<u8> processedData = entry.data;
-
-      // Apply compression if enabled
-      if (m_compressionLevel != CompressionLevel::None) {
-        auto compressResult = compressData(entry.data);
-        if (compressResult.isOk()) {
-          processedData = compressResult.value();
+      ids.push_back(entry.path);
+    }
+    auto indexResult = VFS::PackHashIndex::build(ids);
+    if (indexResult.isError()) {
+      return Result<void>::error("Cannot index pack: " + indexResult.error());
+    }
+    const std::vector<u8> hashIndex = std::move(indexResult).value();
+
+    const u64 resourceTableOffset = kPackHeaderSize;
+    const u64 stringTableOffset = resourceTableOffset + count * kPackEntrySize;
+    const u64 dataOffset = stringTableOffset + sizeof(u32) +
+                           count * sizeof(u32) + stringTable.size() +
+                           hashIndex.size();
+
+    // Tables are written once data sizes are known; reserve their space
+    output.seekp(static_cast<std::streamoff>(dataOffset));
+
+    const u32 workerCount =
+        m_workerCount > 0
+            ? m_workerCount
+            : std::max(1u, std::thread::hardware_concurrency());
+    const usize window = static_cast<usize>(workerCount) * 2;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    usize nextToEncode = 0;
+    usize nextToWrite = 0;
+    u64 inFlightBytes = 0;
+    bool aborted = false;
+    std::vector<std::optional<Result<EncodedEntry>>> slots(window);
+
+    // Encrypted entries are bound to their own id, so they cannot share data
+    const bool deduplicate = m_deduplicate && m_encryptionKey.empty();
+    // Lowest entry index seen per content hash; later copies skip encoding
+    std::unordered_map<VFS::ContentHash, usize> firstByHash;
+
+    auto worker = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        cv.wait(lock, [&]() {
+          if (aborted || nextToEncode >= count) {
+            return true;
+          }
+          const u64 size = static_cast<u64>(m_entries[nextToEncode].originalSize);
+          return nextToEncode < nextToWrite + window &&
+                 (inFlightBytes == 0 ||
+                  inFlightBytes + size <= m_maxInFlightBytes);
+        });
+        if (aborted || nextToEncode >= count) {
+          return;
         }
+
+        const usize index = nextToEncode++;
+        inFlightBytes += static_cast<u64>(m_entries[index].originalSize);
+
+        lock.unlock();
+        auto encoded = encodeEntry(
+            m_entries[index], [&](const VFS::ContentHash &hash) {
+              if (!deduplicate) {
+                return false;
+              }
+              std::lock_guard<std::mutex> hashLock(mutex);
+              auto [it, inserted] = firstByHash.try_emplace(hash, index);
+              if (!inserted && it->second < index) {
+                return true;
+              }
+              it->second = index;
+              return false;
+            });
+        lock.lock();
+
+        slots[index % window].emplace(std::move(encoded));
+        cv.notify_all();
       }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (u32 i = 0; i < workerCount; ++i) {
+      workers.emplace_back(worker);
+    }
 
-      // Apply encryption if key is set
-      if (!m_encryptionKey.empty()) {
-        auto encryptResult = encryptData(processedData);
-        if (encryptResult.isOk()) {
-          processedData = encryptResult.value();
+    auto stopWorkers = [&]() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        aborted = true;
+      }
+      cv.notify_all();
+      for (auto &thread : workers) {
+        thread.join();
+      }
+      workers.clear();
+    };
+
+    // Signed packs hash the data section in fixed chunks as it is written
+    const bool sign = !m_signingKeyPem.empty();
+    std::vector<VFS::Sha256Digest> leaves;
+    std::vector<u8> pendingChunk;
+    auto hashWritten = [&](std::span<const u8> bytes) {
+      while (!bytes.empty()) {
+        if (pendingChunk.empty() && bytes.size() >= m_hashChunkSize) {
+          leaves.push_back(VFS::PackIntegrityChecker::calculateSha256(
+              bytes.data(), m_hashChunkSize));
+          bytes = bytes.subspan(m_hashChunkSize);
+          continue;
+        }
+        const usize take = std::min<usize>(
+            bytes.size(), m_hashChunkSize - pendingChunk.size());
+        pendingChunk.insert(pendingChunk.end(), bytes.begin(),
+                            bytes.begin() + static_cast<std::ptrdiff_t>(take));
+        bytes = bytes.subspan(take);
+        if (pendingChunk.size() == m_hashChunkSize) {
+          leaves.push_back(VFS::PackIntegrityChecker::calculateSha256(
+              pendingChunk.data(), pendingChunk.size()));
+          pendingChunk.clear();
         }
       }
+    };
+
+    std::vector<u8> resourceTable;
+    resourceTable.reserve(count * kPackEntrySize);
+    u64 relativeOffset = 0;
+
+    struct StoredPayload {
+      u64 offset;
+      u64 size;
+      u64 uncompressedSize;
+      u32 flags;
+      u32 checksum;
+    };
+    std::unordered_map<VFS::ContentHash, StoredPayload> written;
+
+    for (usize i = 0; i < count; ++i) {
+      std::optional<Result<EncodedEntry>> slot;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return slots[i % window].has_value(); });
+        slot = std::move(slots[i % window]);
+        slots[i % window].reset();
+      }
+
+      if (slot->isError()) {
+        stopWorkers();
+        return Result<void>::error(m_entries[i].path + ": " + slot->error());
+      }
 
-      u64 dataSize = processedData.size();
-      output.write(reinterpret_cast<const char *>(&dataSize), sizeof(dataSize));
-      output.write(reinterpret_cast<const char *>(processedData.data()), dataSize);
+      const EncodedEntry &encoded = slot->value();
+      StoredPayload payload{
+          relativeOffset, encoded.data.size(), encoded.uncompressedSize,
+          VFS::PackCompressor::entryFlags(encoded.codec) |
+              (encoded.chunked ? VFS::ChunkedResource::kEntryFlagChunked : 0u),
+          encoded.checksum};
+
+      // Identical content points at the copy already written
+      const auto existing =
+          deduplicate ? written.find(encoded.contentHash) : written.end();
+      if (existing != written.end() &&
+          existing->second.uncompressedSize == encoded.uncompressedSize &&
+          existing->second.checksum == encoded.checksum) {
+        payload = existing->second;
+        ++m_deduplicatedCount;
+        m_deduplicatedSize += m_entries[i].originalSize;
+      } else if (encoded.duplicate) {
+        stopWorkers();
+        return Result<void>::error(m_entries[i].path +
+                                   ": content hash collision");
+      } else {
+        output.write(reinterpret_cast<const char *>(encoded.data.data()),
+                     static_cast<std::streamsize>(encoded.data.size()));
+        if (!output) {
+          stopWorkers();
+          return Result<void>::error("Failed to write pack data: " +
+                                     m_outputPath);
+        }
+        if (sign) {
+          hashWritten(encoded.data);
+        }
+        if (deduplicate) {
+          written.try_emplace(encoded.contentHash, payload);
+        }
+        relativeOffset += encoded.data.size();
+      }
+
+      appendBytes(resourceTable, static_cast<u32>(i));
+      appendBytes(resourceTable, m_entries[i].type);
+      appendBytes(resourceTable, payload.offset);
+      appendBytes(resourceTable, payload.size);
+      appendBytes(resourceTable, payload.uncompressedSize);
+      appendBytes(resourceTable,
+                  payload.flags |
+                      (m_entries[i].delta ? VFS::PackDelta::kEntryFlagDelta
+                                          : 0u));
+      appendBytes(resourceTable, payload.checksum);
+      const u8 iv[8] = {0};
+      resourceTable.insert(resourceTable.end(), iv, iv + sizeof(iv));
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++nextToWrite;
+        inFlightBytes -= static_cast<u64>(m_entries[i].originalSize);
+      }
+      cv.notify_all();
     }
 
+    stopWorkers();
+    m_writtenDataSize = static_cast<i64>(relativeOffset);
+
+    if (!pendingChunk.empty()) {
+      leaves.push_back(VFS::PackIntegrityChecker::calculateSha256(
+          pendingChunk.data(), pendingChunk.size()));
+    }
+    const u64 hashTreeOffset = sign ? dataOffset + relativeOffset : 0;
+    const u64 hashTreeSize =
+        sign ? VFS::PackHashTree::kHeaderSize +
+                   leaves.size() * sizeof(VFS::Sha256Digest) +
+                   m_signatureBlockSize
+             : 0;
+    const u64 totalFileSize =
+        dataOffset + relativeOffset + hashTreeSize + kPackFooterSize;
+
+    std::vector<u8> tables;
+    tables.reserve(static_cast<usize>(dataOffset));
+    appendBytes(tables, kPackMagic);
+    appendBytes(tables, static_cast<u16>(1)); // versionMajor
+    appendBytes(tables, static_cast<u16>(1)); // versionMinor
+    // Entry flags always carry the codec and chunked layout
+    appendBytes(tables, kPackFlagResourceCodecs | kPackFlagHashIndex |
+                            (sign ? kPackFlagMerkleSigned : 0u));
+    appendBytes(tables, static_cast<u32>(count));
+    appendBytes(tables, resourceTableOffset);
+    appendBytes(tables, stringTableOffset);
+    appendBytes(tables, dataOffset);
+    appendBytes(tables, totalFileSize);
+    tables.resize(static_cast<usize>(kPackHeaderSize), 0); // content hash
+    tables.insert(tables.end(), resourceTable.begin(), resourceTable.end());
+    appendBytes(tables, static_cast<u32>(count));
+    for (u32 offset : stringOffsets) {
+      appendBytes(tables, offset);
+    }
+    tables.insert(tables.end(), stringTable.begin(), stringTable.end());
+    tables.insert(tables.end(), hashIndex.begin(), hashIndex.end());
+
+    if (sign) {
+      auto section = VFS::PackHashTree::buildSection(
+          dataOffset, relativeOffset, m_hashChunkSize,
+          VFS::PackIntegrityChecker::calculateSha256(tables.data(),
+                                                     tables.size()),
+          leaves);
+      auto signResult = VFS::PackHashTree::sign(section, m_signingKeyPem);
+      if (signResult.isError()) {
+        return signResult;
+      }
+      if (section.size() != hashTreeSize) {
+        return Result<void>::error("Unexpected pack signature size");
+      }
+      output.write(reinterpret_cast<const char *>(section.data()),
+                   static_cast<std::streamsize>(section.size()));
+    }
+
+    std::vector<u8> footer;
+    appendBytes(footer, kFooterMagic);
+    appendBytes(footer, VFS::PackIntegrityChecker::calculateCrc32(
+                            tables.data(), tables.size()));
+    appendBytes(footer, static_cast<u64>(std::chrono::system_clock::now()
+                                             .time_since_epoch()
+                                             .count()));
+    appendBytes(footer, static_cast<u32>(1)); // buildNumber
+    appendBytes(footer, hashTreeOffset);
+    footer.resize(static_cast<usize>(kPackFooterSize), 0);
+
+    output.write(reinterpret_cast<const char *>(footer.data()),
+                 static_cast<std::streamsize>(footer.size()));
+    output.seekp(0);
+    output.write(reinterpret_cast<const char *>(tables.data()),
+                 static_cast<std::streamsize>(tables.size()));
+
     output.close();
+    if (!output) {
+      return Result<void>::error("Failed to write pack file: " + m_outputPath);
+    }
     return Result<void>::ok();
 
   } catch (const std::exception &e) {
@@ -1805,15 +2316,47 @@ void PackBuilder::setCompressionLevel(CompressionLevel level) {
   m_compressionLevel = level;
 }
 
+void PackBuilder::setWorkerCount(u32 count) { m_workerCount = count; }
+
+void PackBuilder::setMaxInFlightBytes(u64 bytes) {
+  m_maxInFlightBytes = std::max<u64>(bytes, 1);
+}
+
+void PackBuilder::setDeduplication(bool enabled) { m_deduplicate = enabled; }
+
+Result<void> PackBuilder::setSigningKey(const std::string &privateKeyPem,
+                                        u32 chunkSize) {
+  // Signing a blank header checks the key and gives the signature size,
+  // which the pack header's total size depends on
+  std::vector<u8> probe(VFS::PackHashTree::kHeaderSize, 0);
+  auto signResult = VFS::PackHashTree::sign(probe, privateKeyPem);
+  if (signResult.isError()) {
+    return signResult;
+  }
+
+  m_signingKeyPem = privateKeyPem;
+  m_signatureBlockSize = probe.size() - VFS::PackHashTree::kHeaderSize;
+  m_hashChunkSize = std::clamp(chunkSize, VFS::PackHashTree::kMinChunkSize,
+                               VFS::PackHashTree::kMaxChunkSize);
+  return Result<void>::ok();
+}
+
+void PackBuilder::setChunking(u64 threshold, u32 frameSize) {
+  m_chunkThreshold = threshold;
+  m_chunkFrameSize = std::clamp(frameSize, VFS::ChunkedResource::kMinFrameSize,
+                                VFS::ChunkedResource::kMaxFrameSize);
+}
+
 PackBuilder::PackStats PackBuilder::getStats() const {
   PackStats stats;
   stats.fileCount = static_cast<i32>(m_entries.size());
   stats.uncompressedSize = 0;
-  stats.compressedSize = 0;
+  stats.compressedSize = m_writtenDataSize;
+  stats.deduplicatedCount = m_deduplicatedCount;
+  stats.deduplicatedSize = m_deduplicatedSize;
 
   for (const auto &entry : m_entries) {
     stats.uncompressedSize += entry.originalSize;
-    stats.compressedSize += static_cast<i64>(entry.data.size());
   }
 
   if (stats.uncompressedSize > 0) {
@@ -1827,12 +2370,183 @@ PackBuilder::PackStats PackBuilder::getStats() const {
   return stats;
 }
 
-Result<std::vector<u8>> PackBuilder::compressData(const std::vector<u8> &data) {
-  // Placeholder - in production would use zlib
-  return Result<std::vector<u8>>::ok(data);
+VFS::PackCompression PackBuilder::selectCodec(const std::string &packPath,
+                                              u64 size) const {
+  using VFS::PackCompression;
+
+  if (m_compressionLevel == CompressionLevel::None || size == 0) {
+    return PackCompression::None;
+  }
+
+  const std::string ext = lowerExtension(packPath);
+
+  // Formats that are already entropy-coded gain nothing from a second pass
+  static const char *const kPrecompressed[] = {
+      ".png", ".jpg", ".jpeg", ".webp", ".gif", ".ogg", ".opus", ".mp3",
+      ".m4a", ".flac", ".woff2", ".zip", ".mp4", ".webm"};
+  for (const char *candidate : kPrecompressed) {
+    if (ext == candidate) {
+      return PackCompression::None;
+    }
+  }
+
+  static const char *const kTextual[] = {
+      ".nms", ".nmscript", ".nmbc", ".json", ".xml", ".yaml", ".yml",
+      ".txt", ".csv",      ".po",   ".wav",  ".pcm", ".raw"};
+  bool textual = false;
+  for (const char *candidate : kTextual) {
+    if (ext == candidate) {
+      textual = true;
+      break;
+    }
+  }
+
+  PackCompression preferred = PackCompression::Zstd;
+  if (!textual && size <= kHotAssetMaxSize) {
+    preferred = PackCompression::Lz4;
+  }
+
+  if (VFS::PackCompressor::isAvailable(preferred)) {
+    return preferred;
+  }
+  if (VFS::PackCompressor::isAvailable(PackCompression::Zlib)) {
+    return PackCompression::Zlib;
+  }
+  return PackCompression::None;
+}
+
+Result<PackBuilder::EncodedEntry>
+PackBuilder::encodeEntry(const PackEntry &entry,
+                         const DuplicateCheck &isDuplicate) const {
+  std::vector<u8> data;
+  if (!entry.sourcePath.empty()) {
+    std::ifstream file(entry.sourcePath, std::ios::binary);
+    if (!file.is_open()) {
+      return Result<EncodedEntry>::error("Cannot open file: " +
+                                         entry.sourcePath);
+    }
+    data.resize(static_cast<usize>(entry.originalSize));
+    file.read(reinterpret_cast<char *>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    if (file.gcount() != static_cast<std::streamsize>(data.size())) {
+      return Result<EncodedEntry>::error("File changed while packing: " +
+                                         entry.sourcePath);
+    }
+  } else {
+    data = entry.data;
+  }
+
+  EncodedEntry encoded;
+  encoded.uncompressedSize = data.size();
+  encoded.checksum =
+      VFS::PackIntegrityChecker::calculateCrc32(data.data(), data.size());
+  encoded.contentHash = VFS::ContentHasher::hash(data);
+  if (isDuplicate && isDuplicate(encoded.contentHash)) {
+    encoded.duplicate = true;
+    return Result<EncodedEntry>::ok(std::move(encoded));
+  }
+
+  const auto codec = selectCodec(entry.path, data.size());
+
+  // Large resources are split into independently decodable frames so they
+  // can be streamed and seeked without inflating them whole. Deltas are
+  // always applied whole, so they stay in one piece.
+  if (m_chunkThreshold > 0 && data.size() >= m_chunkThreshold &&
+      !entry.delta) {
+    VFS::ChunkedResource::FrameSealer seal;
+    if (!m_encryptionKey.empty()) {
+      seal = [this](u32, std::vector<u8> frame) { return encryptData(frame); };
+    }
+
+    auto chunkResult = VFS::ChunkedResource::encode(
+        data, codec, codecLevel(codec), m_chunkFrameSize, seal);
+    if (chunkResult.isOk() && codec != VFS::PackCompression::None &&
+        !worthCompressing(data.size(), chunkResult.value().size())) {
+      chunkResult = VFS::ChunkedResource::encode(
+          data, VFS::PackCompression::None, 0, m_chunkFrameSize, seal);
+    } else if (chunkResult.isOk()) {
+      encoded.codec = codec;
+    }
+    if (chunkResult.isError()) {
+      return Result<EncodedEntry>::error(chunkResult.error());
+    }
+
+    encoded.chunked = true;
+    encoded.data = std::move(chunkResult).value();
+    return Result<EncodedEntry>::ok(std::move(encoded));
+  }
+
+  if (codec != VFS::PackCompression::None) {
+    auto compressResult = compressData(data, codec);
+    if (compressResult.isError()) {
+      return Result<EncodedEntry>::error(compressResult.error());
+    }
+    if (worthCompressing(data.size(), compressResult.value().size())) {
+      data = std::move(compressResult).value();
+      encoded.codec = codec;
+    }
+  }
+
+  // Apply encryption if key is set
+  if (!m_encryptionKey.empty()) {
+    auto encryptResult = encryptData(data);
+    if (encryptResult.isError()) {
+      return Result<EncodedEntry>::error(encryptResult.error());
+    }
+    data = std::move(encryptResult).value();
+  }
+
+  encoded.data = std::move(data);
+  return Result<EncodedEntry>::ok(std::move(encoded));
+}
+
+i32 PackBuilder::codecLevel(VFS::PackCompression codec) const {
+  switch (codec) {
+  case VFS::PackCompression::Zstd:
+    return m_compressionLevel == CompressionLevel::Fast      ? 1
+           : m_compressionLevel == CompressionLevel::Maximum ? 19
+                                                             : 6;
+  case VFS::PackCompression::Zlib:
+    return m_compressionLevel == CompressionLevel::Fast      ? 1
+           : m_compressionLevel == CompressionLevel::Maximum ? 9
+                                                             : 6;
+  case VFS::PackCompression::Lz4:
+    // The HC encoder only pays off when build time does not matter
+    return m_compressionLevel == CompressionLevel::Maximum ? 9 : 0;
+  case VFS::PackCompression::None:
+    break;
+  }
+  return 0;
+}
+
+u32 PackBuilder::resourceTypeFor(const std::string &path) {
+  using VFS::ResourceType;
+  const std::string type = AssetProcessor::getAssetType(path);
+  ResourceType resourceType = ResourceType::Data;
+  if (type == "image") {
+    resourceType = ResourceType::Texture;
+  } else if (type == "audio") {
+    resourceType = path.find("music/") != std::string::npos
+                       ? ResourceType::Music
+                       : ResourceType::Audio;
+  } else if (type == "font") {
+    resourceType = ResourceType::Font;
+  } else if (type == "script") {
+    resourceType = ResourceType::Script;
+  } else if (path.find("localization/") != std::string::npos) {
+    resourceType = ResourceType::Localization;
+  }
+  return static_cast<u32>(resourceType);
+}
+
+Result<std::vector<u8>>
+PackBuilder::compressData(const std::vector<u8> &data,
+                          VFS::PackCompression codec) const {
+  return VFS::PackCompressor::compress(codec, data, codecLevel(codec));
 }
 
-Result<std::vector<u8>> PackBuilder::encryptData(const std::vector<u8> &data) {
+Result<std::vector<u8>>
+PackBuilder::encryptData(const std::vector<u8> &data) const {
   // Placeholder - in production would use AES-256-GCM
   return Result<std::vector<u8>>::ok(data);
 }
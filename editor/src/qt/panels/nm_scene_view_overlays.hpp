@@ -613,41 +613,34 @@ private:
 
     f32 penY = originY;
     for (const auto &line : layout.lines) {
-      f32 penX = originX;
       const f32 baseline = penY + line.height * 0.8f;
-      for (const auto &segment : line.segments) {
-        if (segment.isCommand()) {
+      for (u32 g = line.firstGlyph; g < line.firstGlyph + line.glyphCount;
+           ++g) {
+        const auto &placed = layout.glyphs[g];
+        const auto *glyph = m_fontAtlas->getGlyph(placed.codepoint);
+        if (!glyph) {
           continue;
         }
-        for (char c : segment.text) {
-          const auto *glyph =
-              m_fontAtlas->getGlyph(static_cast<unsigned char>(c));
-          if (!glyph) {
-            continue;
-          }
-
-          f32 x0 = penX + glyph->bearingX;
-          f32 y0 = baseline - glyph->bearingY;
-          f32 x1 = x0 + glyph->width;
-          f32 y1 = y0 + glyph->height;
 
-          glBegin(GL_QUADS);
-          glTexCoord2f(glyph->uv.x, glyph->uv.y);
-          glVertex2f(x0, y0);
+        f32 x0 = originX + placed.x + glyph->bearingX;
+        f32 y0 = baseline - glyph->bearingY;
+        f32 x1 = x0 + glyph->width;
+        f32 y1 = y0 + glyph->height;
 
-          glTexCoord2f(glyph->uv.x + glyph->uv.width, glyph->uv.y);
-          glVertex2f(x1, y0);
+        glBegin(GL_QUADS);
+        glTexCoord2f(glyph->uv.x, glyph->uv.y);
+        glVertex2f(x0, y0);
 
-          glTexCoord2f(glyph->uv.x + glyph->uv.width,
-                       glyph->uv.y + glyph->uv.height);
-          glVertex2f(x1, y1);
+        glTexCoord2f(glyph->uv.x + glyph->uv.width, glyph->uv.y);
+        glVertex2f(x1, y0);
 
-          glTexCoord2f(glyph->uv.x, glyph->uv.y + glyph->uv.height);
-          glVertex2f(x0, y1);
-          glEnd();
+        glTexCoord2f(glyph->uv.x + glyph->uv.width,
+                     glyph->uv.y + glyph->uv.height);
+        glVertex2f(x1, y1);
 
-          penX += glyph->advanceX;
-        }
+        glTexCoord2f(glyph->uv.x, glyph->uv.y + glyph->uv.height);
+        glVertex2f(x0, y1);
+        glEnd();
       }
       penY += line.height;
     }
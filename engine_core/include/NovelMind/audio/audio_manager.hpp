@@ -16,6 +16,7 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/file_handle.hpp"
 #include <functional>
 #include <memory>
 #include <queue>
@@ -187,6 +188,8 @@ private:
   std::unique_ptr<ma_sound> m_sound;
   bool m_soundReady = false;
   std::vector<u8> m_memoryData;
+  /// Streamed sources decode from here instead of m_memoryData
+  std::unique_ptr<VFS::IFileHandle> m_stream;
   std::unique_ptr<ma_decoder> m_decoder;
   bool m_decoderReady = false;
 };
@@ -198,6 +201,9 @@ class AudioManager {
 public:
   using DataProvider =
       std::function<Result<std::vector<u8>>(const std::string &id)>;
+  using StreamProvider =
+      std::function<Result<std::unique_ptr<VFS::IFileHandle>>(
+          const std::string &id)>;
   AudioManager();
   ~AudioManager();
 
@@ -417,6 +423,13 @@ public:
   void setEventCallback(AudioCallback callback);
 
   void setDataProvider(DataProvider provider);
+  /**
+   * @brief Source of seekable streams for music, voice and ambient tracks
+   *
+   * Streamed tracks are decoded as they play instead of being read whole;
+   * without a provider, or when it fails, the data provider is used.
+   */
+  void setStreamProvider(StreamProvider provider);
 
   // =========================================================================
   // Configuration
@@ -485,6 +498,7 @@ private:
   // Callback
   AudioCallback m_eventCallback;
   DataProvider m_dataProvider;
+  StreamProvider m_streamProvider;
 };
 
 } // namespace NovelMind::audio
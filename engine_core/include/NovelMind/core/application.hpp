@@ -7,6 +7,7 @@
 #include "NovelMind/localization/localization_manager.hpp"
 #include "NovelMind/platform/window.hpp"
 #include "NovelMind/platform/file_system.hpp"
+#include "NovelMind/renderer/render_target.hpp"
 #include "NovelMind/renderer/renderer.hpp"
 #include "NovelMind/resource/resource_manager.hpp"
 #include "NovelMind/save/save_manager.hpp"
@@ -16,6 +17,10 @@
 #include <memory>
 #include <string>
 
+namespace NovelMind::scripting {
+class ScriptRuntime;
+} // namespace NovelMind::scripting
+
 namespace NovelMind::core {
 
 struct EngineConfig {
@@ -23,6 +28,28 @@ struct EngineConfig {
   std::string packFile;
   std::string startScene;
   bool debug = false;
+  /// Skip drawing frames in which the scene graph did not change. Apps that
+  /// opt in and draw in onRender() or onRenderOverlay() on their own
+  /// schedule call requestRedraw(); script transitions redraw themselves.
+  bool skipIdleFrames = false;
+  /// Sleep after a skipped frame so an idle loop does not spin
+  u32 idleSleepMs = 4;
+  /// Record every resource read and scene change, and save the trace here
+  /// on shutdown for the build's pack layout (see access_trace.hpp). Empty
+  /// records nothing.
+  std::string accessTracePath;
+};
+
+/**
+ * @brief How frames were drawn since the application started
+ */
+struct FrameStats {
+  /// Whole frames drawn
+  u64 renderedFrames = 0;
+  /// Frames that redrew only the area that changed
+  u64 partialFrames = 0;
+  /// Frames not drawn because nothing changed
+  u64 skippedFrames = 0;
 };
 
 class Application {
@@ -39,6 +66,30 @@ public:
   void run();
   void quit();
 
+  /// Draw the whole next frame even if the scene did not change
+  void requestRedraw();
+
+  /**
+   * @brief Drive a script runtime from the main loop
+   *
+   * The runtime is updated after onUpdate() and its transitions are drawn
+   * over the scene graph, starting from getLastFrame(). The application
+   * does not own it; pass nullptr to detach.
+   */
+  void setScriptRuntime(scripting::ScriptRuntime *runtime);
+
+  /**
+   * @brief The frame on screen, as the scene graph drew it
+   *
+   * Kept only while a script runtime is attached, and empty for backends
+   * that cannot read their frame. A holder keeps that frame: later frames
+   * are captured into a new target.
+   */
+  [[nodiscard]] std::shared_ptr<const renderer::RenderTarget> getLastFrame();
+  [[nodiscard]] const FrameStats &getFrameStats() const {
+    return m_frameStats;
+  }
+
   [[nodiscard]] bool isRunning() const;
   [[nodiscard]] f64 getDeltaTime() const;
   [[nodiscard]] f64 getElapsedTime() const;
@@ -59,9 +110,12 @@ protected:
   virtual void onShutdown();
   virtual void onUpdate(f64 deltaTime);
   virtual void onRender();
+  /// Called after the scene graph is drawn, e.g. for transitions
+  virtual void onRenderOverlay();
 
 private:
   void mainLoop();
+  void renderFrame();
 
   bool m_running;
   EngineConfig m_config;
@@ -76,7 +130,14 @@ private:
   std::unique_ptr<audio::AudioManager> m_audio;
   std::unique_ptr<save::SaveManager> m_saveManager;
   std::unique_ptr<localization::LocalizationManager> m_localization;
+  std::shared_ptr<VFS::AccessTraceRecorder> m_traceRecorder;
   Timer m_timer;
+  FrameStats m_frameStats;
+  bool m_redrawRequested = true;
+  scripting::ScriptRuntime *m_scriptRuntime = nullptr;
+  std::shared_ptr<renderer::RenderTarget> m_lastFrame;
+  i32 m_lastFrameWidth = 0;
+  i32 m_lastFrameHeight = 0;
 };
 
 } // namespace NovelMind::core
@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * @file cpu_features.hpp
+ * @brief Instruction set extensions available on the running CPU
+ *
+ * Hot loops with hand-written SIMD paths pick one at runtime from these
+ * flags, so a single binary runs everywhere and still uses what the CPU has.
+ */
+
+#include "NovelMind/core/types.hpp"
+
+namespace NovelMind::core {
+
+struct CpuFeatures {
+  // x86
+  bool sse41 = false;
+  bool pclmul = false;
+  bool avx2 = false;
+  // ARMv8
+  bool neon = false;
+  bool armCrc32 = false;
+
+  /// Detected once on first use
+  [[nodiscard]] static const CpuFeatures &get();
+};
+
+} // namespace NovelMind::core
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file batching_renderer.hpp
+ * @brief IRenderer base that records draw calls and submits them in batches
+ *
+ * Every draw call between beginFrame() and endFrame() becomes a quad in a
+ * RenderCommandBuffer; endFrame() batches them (see render_batch.hpp) and
+ * hands the result to the backend's submit(). Textures and fonts passed to
+ * draw calls must stay alive until the frame is flushed. Text is drawn from a
+ * GlyphCache shared by all fonts; glyphs rasterized during the frame are
+ * uploaded together when it is flushed.
+ *
+ * RecordingRenderer keeps each submitted frame instead of drawing it, so
+ * batching can be inspected without a window or GPU.
+ */
+
+#include "NovelMind/renderer/glyph_cache.hpp"
+#include "NovelMind/renderer/render_batch.hpp"
+#include "NovelMind/renderer/renderer.hpp"
+#include <optional>
+
+namespace NovelMind::renderer {
+
+class BatchingRenderer : public IRenderer {
+public:
+  void beginFrame() override;
+  void endFrame() override;
+
+  /// Drops what has been recorded this frame; the clear goes to submit()
+  void clear(const Color &color) override;
+  void setBlendMode(BlendMode mode) override;
+  void setLayer(i32 layer) override;
+
+  void drawSprite(const Texture &texture, const Transform2D &transform,
+                  const Color &tint = Color::White) override;
+  void drawSprite(const Texture &texture, const Rect &sourceRect,
+                  const Transform2D &transform,
+                  const Color &tint = Color::White) override;
+  void drawRect(const Rect &rect, const Color &color) override;
+  void fillRect(const Rect &rect, const Color &color) override;
+  void drawText(const Font &font, const std::string &text, f32 x, f32 y,
+                const Color &color = Color::White) override;
+  void setFade(f32 alpha, const Color &color = Color::Black) override;
+
+  [[nodiscard]] i32 getWidth() const override { return m_width; }
+  [[nodiscard]] i32 getHeight() const override { return m_height; }
+
+  /// Submits pending draws, then lets the backend copy its frame
+  bool captureFrame(RenderTarget &target) override;
+
+  /// Batch and submit what has been recorded so far
+  void flush();
+
+  [[nodiscard]] const RenderCommandBuffer &commandBuffer() const {
+    return m_commands;
+  }
+
+protected:
+  /**
+   * @brief Draw one batched frame segment
+   * @param clearColor Set if the target should be cleared before drawing
+   */
+  virtual void submit(const RenderBatchList &batches,
+                      const std::optional<Color> &clearColor) = 0;
+  /// Called by endFrame() after the last submit()
+  virtual void present() {}
+  /// Copy the frame drawn so far into target; false if unsupported
+  virtual bool copyFrame(RenderTarget & /*target*/) { return false; }
+
+  [[nodiscard]] GlyphCache &glyphCache() { return m_glyphs; }
+  void releaseFontAtlases() { m_glyphs.clear(); }
+
+  i32 m_width = 0;
+  i32 m_height = 0;
+
+private:
+  RenderCommandBuffer m_commands;
+  RenderBatchList m_batches;
+  std::optional<Color> m_pendingClear;
+  GlyphCache m_glyphs;
+};
+
+class RecordingRenderer : public BatchingRenderer {
+public:
+  RecordingRenderer() = default;
+  RecordingRenderer(i32 width, i32 height) {
+    m_width = width;
+    m_height = height;
+  }
+
+  Result<void> initialize(platform::IWindow &window) override;
+  void shutdown() override { releaseFontAtlases(); }
+
+  /// Commands and batches of the last flushed frame segment
+  [[nodiscard]] const std::vector<RenderCommand> &lastCommands() const {
+    return m_lastCommands;
+  }
+  [[nodiscard]] const RenderBatchList &lastBatches() const {
+    return m_lastBatches;
+  }
+  [[nodiscard]] const std::optional<Color> &lastClearColor() const {
+    return m_lastClear;
+  }
+  [[nodiscard]] u32 submitCount() const { return m_submitCount; }
+
+protected:
+  void submit(const RenderBatchList &batches,
+              const std::optional<Color> &clearColor) override;
+
+private:
+  std::vector<RenderCommand> m_lastCommands;
+  RenderBatchList m_lastBatches;
+  std::optional<Color> m_lastClear;
+  u32 m_submitCount = 0;
+};
+
+} // namespace NovelMind::renderer
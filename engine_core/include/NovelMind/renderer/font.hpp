@@ -26,11 +26,17 @@ public:
   [[nodiscard]] bool isValid() const;
   [[nodiscard]] i32 getSize() const;
   [[nodiscard]] void *getNativeHandle() const;
+  /// Unique per successful load and never reused, 0 when nothing is loaded;
+  /// caches key glyphs by it rather than by address
+  [[nodiscard]] u64 getId() const { return m_id; }
 
 private:
   void *m_handle;
   void *m_library = nullptr;
   i32 m_size;
+  u64 m_id = 0;
+  /// FreeType reads memory faces in place, for as long as glyphs are loaded
+  std::vector<u8> m_data;
 };
 
 struct GlyphInfo {
@@ -53,8 +59,8 @@ public:
 
   FontAtlas(const FontAtlas &) = delete;
   FontAtlas &operator=(const FontAtlas &) = delete;
-  FontAtlas(FontAtlas &&) = default;
-  FontAtlas &operator=(FontAtlas &&) = default;
+  FontAtlas(FontAtlas &&other) noexcept;
+  FontAtlas &operator=(FontAtlas &&other) noexcept;
 
   Result<void> build(const Font &font, const std::string &charset,
                      i32 padding = 1);
@@ -63,6 +69,8 @@ public:
   [[nodiscard]] const Texture &getAtlasTexture() const { return m_texture; }
   [[nodiscard]] bool isValid() const { return m_valid; }
   [[nodiscard]] i32 getLineHeight() const { return m_lineHeight; }
+  /// Unique per successful build and never reused, 0 when nothing is built
+  [[nodiscard]] u64 getId() const { return m_id; }
 
 private:
   GlyphInfo buildGlyph(const Font &font, char32_t codepoint, i32 padding,
@@ -74,6 +82,7 @@ private:
   std::unordered_map<char32_t, GlyphInfo> m_glyphs;
   i32 m_lineHeight = 0;
   bool m_valid = false;
+  u64 m_id = 0;
 };
 
 } // namespace NovelMind::renderer
@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file glyph_cache.hpp
+ * @brief On-demand glyph rasterization into shared atlas pages
+ *
+ * FontAtlas bakes a fixed charset up front, which cannot cover CJK scripts
+ * or player-entered names. GlyphCache rasterizes each (font, codepoint)
+ * the first time it is drawn and shelf-packs it into one of a few atlas
+ * pages that are created as they fill up. Pixels are written to a CPU copy
+ * of the page; flushUploads() sends the rows touched since the last flush
+ * to the texture in one call per page, so new glyphs cost one upload per
+ * frame rather than one per glyph.
+ *
+ * When every page is full, the least recently used shelf (a row of glyphs
+ * of similar height) not drawn in the current frame is emptied and reused.
+ * Glyphs drawn this frame are never evicted, so recorded draw calls stay
+ * valid until the frame is submitted.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/font.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+class GlyphCache {
+public:
+  struct Glyph {
+    f32 advanceX = 0.0f;
+    f32 bearingX = 0.0f;
+    f32 bearingY = 0.0f;
+    /// Page texture, nullptr for glyphs without pixels such as spaces
+    const Texture *texture = nullptr;
+    /// Region of the page in pixels
+    Rect sourceRect;
+  };
+
+  /**
+   * @param pageSize Width and height of each atlas page
+   * @param maxPages Pages created before glyphs start being evicted
+   * @param padding Empty pixels kept around each glyph
+   */
+  explicit GlyphCache(i32 pageSize = 1024, u32 maxPages = 4, i32 padding = 1);
+  ~GlyphCache();
+
+  GlyphCache(const GlyphCache &) = delete;
+  GlyphCache &operator=(const GlyphCache &) = delete;
+
+  /// Start a new frame; glyphs used from now on are protected from eviction
+  void beginFrame() { ++m_frame; }
+
+  /**
+   * @brief Look up a glyph, rasterizing it on a miss
+   * @return nullptr if the font cannot render it or no space can be freed;
+   *         the pointer is valid until the next getGlyph() call
+   */
+  const Glyph *getGlyph(const Font &font, char32_t codepoint);
+
+  /// Distance between baselines of font
+  [[nodiscard]] f32 getLineHeight(const Font &font);
+
+  /**
+   * @brief Upload page rows written since the last call
+   * @return Bytes uploaded
+   */
+  usize flushUploads();
+
+  /**
+   * @brief Forget every glyph of font to free its page space early
+   *
+   * Glyphs are keyed by Font::getId(), so a destroyed or reloaded font
+   * never shares glyphs with a new one; without this call its glyphs are
+   * simply evicted once unused.
+   */
+  void releaseFont(const Font &font);
+  /// Drop all glyphs and pages
+  void clear();
+
+  [[nodiscard]] usize getGlyphCount() const { return m_glyphs.size(); }
+  [[nodiscard]] usize getPageCount() const { return m_pages.size(); }
+  [[nodiscard]] u64 getEvictedCount() const { return m_evicted; }
+
+private:
+  struct Key {
+    u64 font;
+    char32_t codepoint;
+    bool operator==(const Key &other) const {
+      return font == other.font && codepoint == other.codepoint;
+    }
+  };
+  struct KeyHash {
+    usize operator()(const Key &key) const;
+  };
+  struct Entry {
+    Glyph glyph;
+    u32 page = 0;
+    u32 shelf = 0;
+  };
+  struct Shelf {
+    i32 y = 0;
+    i32 height = 0;
+    i32 cursorX = 0;
+    u64 lastUsed = 0;
+    std::vector<Key> glyphs;
+  };
+  struct Page;
+  struct Slot {
+    u32 page;
+    u32 shelf;
+    i32 x;
+    i32 y;
+  };
+
+  bool findSlot(i32 width, i32 height, Slot &slot);
+  bool evictSlot(i32 width, i32 height, Slot &slot);
+  void emptyShelf(Page &page, Shelf &shelf);
+  Page &addPage();
+
+  i32 m_pageSize;
+  u32 m_maxPages;
+  i32 m_padding;
+  u64 m_frame = 1;
+  u64 m_evicted = 0;
+  std::vector<std::unique_ptr<Page>> m_pages;
+  std::unordered_map<Key, Entry, KeyHash> m_glyphs;
+  std::unordered_map<u64, f32> m_lineHeights;
+  Glyph m_uncached;
+};
+
+} // namespace NovelMind::renderer
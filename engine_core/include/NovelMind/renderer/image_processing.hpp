@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file image_processing.hpp
+ * @brief Resampling and alpha conversion of RGBA8 images on the CPU
+ *
+ * Save thumbnails and build-time texture downscaling work on the same
+ * RGBA8 buffers stb_image decodes and Texture keeps. Resampling is
+ * separable: each source row is filtered horizontally, then the results
+ * are combined vertically. Filtering happens on premultiplied colour in
+ * linear light, so dark/bright edges and transparent borders do not pick
+ * up halos, and the inner loops have SSE2, AVX2 and NEON versions chosen
+ * at runtime. Large images are split across worker threads.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <vector>
+
+namespace NovelMind::renderer {
+
+enum class ResampleFilter : u8 {
+  Box,     ///< Area average; cheap and soft
+  Lanczos3 ///< Sharper, with slight ringing at hard edges
+};
+
+struct ResampleOptions {
+  ResampleFilter filter = ResampleFilter::Lanczos3;
+  /// Channels are sRGB encoded; off filters them as they are
+  bool srgb = true;
+  /// Input and output colour is premultiplied by alpha
+  bool premultiplied = false;
+  /// Worker threads for large images, 0 for the core count
+  u32 threads = 0;
+  /// Use the SSE2/AVX2/NEON kernels where the CPU has them
+  bool simd = true;
+};
+
+struct RgbaImage {
+  i32 width = 0;
+  i32 height = 0;
+  /// Row-major, width * 4 bytes per row
+  std::vector<u8> pixels;
+};
+
+/// Decode any format the texture loader reads into RGBA8
+[[nodiscard]] Result<RgbaImage> decodeImage(const std::vector<u8> &encoded);
+
+/**
+ * @brief Resample an RGBA8 image to an exact size
+ * @param rgba width * height pixels, row-major
+ */
+[[nodiscard]] Result<RgbaImage>
+resampleImage(const u8 *rgba, i32 width, i32 height, i32 targetWidth,
+              i32 targetHeight, const ResampleOptions &options = {});
+
+/**
+ * @brief Shrink an image to fit maxWidth x maxHeight, keeping its aspect
+ * ratio; images that already fit are copied unchanged
+ */
+[[nodiscard]] Result<RgbaImage>
+resampleToFit(const u8 *rgba, i32 width, i32 height, i32 maxWidth,
+              i32 maxHeight, const ResampleOptions &options = {});
+
+/// Multiply colour by alpha in place
+void premultiplyAlpha(u8 *rgba, usize pixelCount);
+/// Divide colour by alpha in place; fully transparent pixels become zero
+void unpremultiplyAlpha(u8 *rgba, usize pixelCount);
+
+/// Name of the kernels resampling would use: scalar, sse2, avx2 or neon
+[[nodiscard]] const char *resampleKernelName(bool simd = true);
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file render_batch.hpp
+ * @brief Render command recording and batching
+ *
+ * Draw calls are recorded as POD quad commands and turned into one vertex
+ * and index array plus a short list of batches at the end of the frame.
+ * Commands are ordered by layer first. Within a layer, a quad joins an
+ * earlier batch with the same blend mode and texture as long as it does not
+ * overlap anything drawn after that batch, so text, UI and sprite sheets
+ * collapse into a few draw calls while overlapping sprites keep their
+ * painter's order.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/transform.hpp"
+#include <vector>
+
+namespace NovelMind::renderer {
+
+class Texture;
+
+enum class BlendMode { None, Alpha, Additive, Multiply };
+
+struct RenderVertex {
+  f32 x;
+  f32 y;
+  f32 u;
+  f32 v;
+  u8 r;
+  u8 g;
+  u8 b;
+  u8 a;
+};
+
+/**
+ * @brief One recorded quad
+ *
+ * Corners are in screen space, clockwise from the top left of the source
+ * rectangle. An untextured quad has a null texture and zero UVs.
+ */
+struct RenderCommand {
+  i32 layer;
+  BlendMode blendMode;
+  const Texture *texture;
+  void *nativeTexture; // Captured at record time for the backend
+  Vec2 corners[4];
+  f32 u0;
+  f32 v0;
+  f32 u1;
+  f32 v1;
+  Color color;
+};
+
+/// A run of indices drawn with one texture and blend state
+struct RenderBatch {
+  i32 layer = 0;
+  BlendMode blendMode = BlendMode::Alpha;
+  const Texture *texture = nullptr;
+  void *nativeTexture = nullptr;
+  u32 firstIndex = 0;
+  u32 indexCount = 0;
+};
+
+/// Geometry for one frame, ready to upload
+struct RenderBatchList {
+  std::vector<RenderVertex> vertices;
+  std::vector<u32> indices;
+  std::vector<RenderBatch> batches;
+
+  void clear() {
+    vertices.clear();
+    indices.clear();
+    batches.clear();
+  }
+};
+
+class RenderCommandBuffer {
+public:
+  /// Batches searched backwards for a match before a new one is opened
+  static constexpr usize kMaxBatchLookback = 32;
+
+  void setLayer(i32 layer) { m_layer = layer; }
+  [[nodiscard]] i32 layer() const { return m_layer; }
+  void setBlendMode(BlendMode mode) { m_blendMode = mode; }
+  [[nodiscard]] BlendMode blendMode() const { return m_blendMode; }
+
+  /// Record @p sourceRect of @p texture placed by @p transform
+  void pushSprite(const Texture &texture, const Rect &sourceRect,
+                  const Transform2D &transform, const Color &tint);
+  /// Record an untextured, axis-aligned rectangle
+  void pushRect(const Rect &rect, const Color &color);
+  void push(const RenderCommand &command) { m_commands.push_back(command); }
+
+  [[nodiscard]] const std::vector<RenderCommand> &commands() const {
+    return m_commands;
+  }
+  [[nodiscard]] bool empty() const { return m_commands.empty(); }
+
+  /// Drop recorded commands; layer and blend mode are kept
+  void clear() { m_commands.clear(); }
+
+  /**
+   * @brief Sort and batch the recorded commands into @p out
+   *
+   * @p out is cleared first; its capacity is reused across frames.
+   */
+  void build(RenderBatchList &out) const;
+
+private:
+  std::vector<RenderCommand> m_commands;
+  i32 m_layer = 0;
+  BlendMode m_blendMode = BlendMode::Alpha;
+};
+
+} // namespace NovelMind::renderer
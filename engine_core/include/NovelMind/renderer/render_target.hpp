@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file render_target.hpp
+ * @brief Offscreen copy of a rendered frame
+ *
+ * IRenderer::captureFrame() copies what has been drawn so far into a
+ * RenderTarget, which can then be drawn like a sprite in later frames.
+ * Transitions use this to keep the outgoing scene as one cached texture
+ * instead of rendering it again every frame next to the incoming one.
+ *
+ * Backends store the frame however suits them: the software renderer
+ * keeps a top-down copy in memory, the GL backend copies the back buffer
+ * into a texture with bottom-up rows. draw() hides the difference.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/transform.hpp"
+
+namespace NovelMind::renderer {
+
+class IRenderer;
+
+class RenderTarget {
+public:
+  RenderTarget() = default;
+
+  RenderTarget(const RenderTarget &) = delete;
+  RenderTarget &operator=(const RenderTarget &) = delete;
+
+  /// True once a frame has been captured
+  [[nodiscard]] bool isValid() const { return m_captured; }
+  [[nodiscard]] i32 getWidth() const { return m_width; }
+  [[nodiscard]] i32 getHeight() const { return m_height; }
+  [[nodiscard]] const Texture &getTexture() const { return m_texture; }
+
+  /**
+   * @brief Draw the whole capture
+   * @param transform Placement; the capture's top-left corner is the
+   *        origin for anchors, as for sprites
+   */
+  void draw(IRenderer &renderer, const Transform2D &transform,
+            const Color &tint = Color::White) const;
+
+  /// Draw region of the capture where it was on screen
+  void drawRegion(IRenderer &renderer, const Rect &region,
+                  const Color &tint = Color::White) const;
+
+  /// Free the capture
+  void release();
+
+  // Used by renderer backends to fill the target
+
+  /// Keep a top-down RGBA8 copy of a width x height frame in memory
+  void storePixels(const u8 *rgba, i32 width, i32 height);
+  /**
+   * @brief Texture storage for a width x height frame with bottom-up rows,
+   * reused while the size does not change; the caller copies into it
+   */
+  Texture &allocateTexture(i32 width, i32 height);
+  /// Record a capture without pixels, for backends that draw nothing
+  void storeEmpty(i32 width, i32 height);
+
+private:
+  void drawPart(IRenderer &renderer, const Rect &region,
+                Transform2D transform, const Color &tint) const;
+
+  Texture m_texture;
+  i32 m_width = 0;
+  i32 m_height = 0;
+  bool m_bottomUp = false;
+  bool m_captured = false;
+};
+
+} // namespace NovelMind::renderer
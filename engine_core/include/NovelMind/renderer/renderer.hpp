@@ -5,6 +5,8 @@
 #include "NovelMind/platform/window.hpp"
 #include "NovelMind/renderer/color.hpp"
 #include "NovelMind/renderer/font.hpp"
+#include "NovelMind/renderer/render_batch.hpp"
+#include "NovelMind/renderer/render_target.hpp"
 #include "NovelMind/renderer/texture.hpp"
 #include "NovelMind/renderer/transform.hpp"
 #include <memory>
@@ -12,8 +14,6 @@
 
 namespace NovelMind::renderer {
 
-enum class BlendMode { None, Alpha, Additive, Multiply };
-
 class IRenderer {
 public:
   virtual ~IRenderer() = default;
@@ -24,10 +24,38 @@ public:
   virtual void beginFrame() = 0;
   virtual void endFrame() = 0;
 
+  /**
+   * @brief Begin a frame that only redraws region, keeping the rest of the
+   * previous frame
+   *
+   * Draw calls are still made for the whole scene; pixels outside region
+   * are left alone.
+   * @return false if the backend does not keep its last frame (e.g. a
+   *         swapped GL back buffer); call beginFrame() and redraw instead
+   */
+  virtual bool beginPartialFrame(const Rect & /*region*/) { return false; }
+
+  /**
+   * @brief Copy what has been drawn so far this frame into target
+   *
+   * Pending draws are submitted first. The capture can be drawn in later
+   * frames (see RenderTarget::draw()), e.g. so a transition composites the
+   * outgoing scene from one texture instead of rendering it every frame.
+   * @return false if the backend cannot read its frame back
+   */
+  virtual bool captureFrame(RenderTarget & /*target*/) { return false; }
+
   virtual void clear(const Color &color) = 0;
 
   virtual void setBlendMode(BlendMode mode) = 0;
 
+  /**
+   * @brief Draw order key for the following calls; lower layers are drawn
+   * first, and batching backends may reorder within a layer where draws do
+   * not overlap
+   */
+  virtual void setLayer(i32 /*layer*/) {}
+
   // Sprite rendering
   virtual void drawSprite(const Texture &texture, const Transform2D &transform,
                           const Color &tint = Color::White) = 0;
@@ -51,6 +79,21 @@ public:
   [[nodiscard]] virtual i32 getHeight() const = 0;
 };
 
-std::unique_ptr<IRenderer> createRenderer();
+enum class RendererBackend {
+  Default, // NOVELMIND_RENDERER if set, else OpenGL where built in, else Null
+  OpenGL,
+  Software,
+  Null
+};
+
+/**
+ * @brief Create a renderer for @p backend
+ *
+ * With Default, the NOVELMIND_RENDERER environment variable ("opengl",
+ * "software" or "null") picks the backend, e.g. for headless CI runs.
+ * Backends that are not built in fall back to the null renderer.
+ */
+std::unique_ptr<IRenderer>
+createRenderer(RendererBackend backend = RendererBackend::Default);
 
 } // namespace NovelMind::renderer
@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file software_renderer.hpp
+ * @brief CPU rasterizer for headless rendering, thumbnails and screenshots
+ *
+ * Draws the batched quads of a frame (see batching_renderer.hpp) into an
+ * RGBA8 framebuffer. Quads may be scaled and rotated; textures are sampled
+ * bilinearly with clamp-to-edge and tinted, and every BlendMode uses the
+ * same equation as the GL backend. The framebuffer is split into row bands
+ * that worker threads rasterize in parallel, each band drawing every quad
+ * in frame order, so results do not depend on the thread count.
+ *
+ * Sampling and blending have SSE2 and AVX2 paths chosen at runtime from
+ * core::CpuFeatures. All paths use the same fixed-point arithmetic and
+ * produce identical pixels.
+ *
+ * The framebuffer persists between frames, so beginPartialFrame() can limit
+ * clearing and rasterization to the area that changed.
+ *
+ * Textures must be loaded with GPU upload disabled to keep their pixels in
+ * memory; initialize() turns it off. Quads with GPU-only textures are
+ * skipped.
+ */
+
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+enum class RasterEngine : u8 { Scalar, Sse2, Avx2 };
+
+class SoftwareRenderer : public BatchingRenderer {
+public:
+  /// Rows per unit of work handed to a thread
+  static constexpr i32 kBandHeight = 32;
+
+  SoftwareRenderer();
+  /// Headless renderer with its own framebuffer size
+  SoftwareRenderer(i32 width, i32 height);
+  ~SoftwareRenderer() override;
+
+  SoftwareRenderer(const SoftwareRenderer &) = delete;
+  SoftwareRenderer &operator=(const SoftwareRenderer &) = delete;
+
+  /// Keeps textures loaded from now on in memory (see
+  /// Texture::setGpuUploadEnabled) until shutdown() restores the setting
+  Result<void> initialize(platform::IWindow &window) override;
+  void shutdown() override;
+  void beginFrame() override;
+  bool beginPartialFrame(const Rect &region) override;
+
+  /// Resize the framebuffer; its contents are cleared
+  void resize(i32 width, i32 height);
+
+  /**
+   * @brief Worker threads used for rasterization (0 selects one per core)
+   *
+   * The calling thread always takes part, so 1 means no workers.
+   */
+  void setThreadCount(u32 threads);
+  [[nodiscard]] u32 threadCount() const;
+
+  /// Force a code path, e.g. to compare them; unsupported ones fall back
+  void setEngine(RasterEngine engine);
+  [[nodiscard]] RasterEngine engine() const { return m_engine; }
+  [[nodiscard]] static bool isEngineSupported(RasterEngine engine);
+  /// Fastest engine this CPU supports
+  [[nodiscard]] static RasterEngine bestEngine();
+
+  /// RGBA8 pixels of the last frame, row-major, width * 4 bytes per row
+  [[nodiscard]] std::span<const u8> pixels() const;
+  [[nodiscard]] std::vector<u8> readPixels() const;
+
+protected:
+  void submit(const RenderBatchList &batches,
+              const std::optional<Color> &clearColor) override;
+  bool copyFrame(RenderTarget &target) override;
+
+private:
+  struct Workers;
+  /// Pixels the current frame may write, [left, right) x [top, bottom)
+  struct Clip {
+    i32 left = 0;
+    i32 top = 0;
+    i32 right = 0;
+    i32 bottom = 0;
+  };
+
+  void clearClip(const Color &color);
+  void rasterizeBand(const RenderBatchList &batches, i32 rowBegin,
+                     i32 rowEnd);
+
+  std::vector<u32> m_framebuffer;
+  Clip m_clip;
+  Color m_frameClear{13, 13, 15, 255}; // Matches the GL backend
+  RasterEngine m_engine;
+  std::unique_ptr<Workers> m_workers;
+  /// GPU upload setting before initialize(), restored by shutdown()
+  std::optional<bool> m_previousGpuUpload;
+};
+
+} // namespace NovelMind::renderer
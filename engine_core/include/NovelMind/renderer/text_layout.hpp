@@ -11,12 +11,18 @@
  * - Inline commands ({w=0.2}, {color=#ff0000}, {speed=50})
  * - Text measurement and bounds calculation
  * - Typewriter effect support with pause markers
+ *
+ * Text is UTF-8. Lines break at spaces and, for scripts written without
+ * them (CJK), between any two characters except where kinsoku rules forbid
+ * it: closing punctuation and small kana never start a line, opening
+ * brackets never end one.
  */
 
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/renderer/color.hpp"
 #include "NovelMind/renderer/font.hpp"
 #include <functional>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <string>
@@ -98,6 +104,21 @@ struct TextSegment {
   TextStyle style;
   std::optional<InlineCommand> command;
   bool isCommand() const { return command.has_value(); }
+
+  // Filled in by TextLayoutEngine::layout()
+  f32 width = 0.0f;
+  u32 firstGlyph = 0; ///< Index into TextLayout::glyphs
+  u32 glyphCount = 0; ///< Codepoints in text
+};
+
+/**
+ * @brief One laid-out codepoint
+ */
+struct LayoutGlyph {
+  char32_t codepoint = 0;
+  f32 x = 0.0f; ///< Offset from the start of the line in reading order
+  f32 advance = 0.0f;
+  u32 line = 0;
 };
 
 /**
@@ -108,6 +129,8 @@ struct TextLine {
   f32 width = 0.0f;
   f32 height = 0.0f;
   f32 baseline = 0.0f;
+  u32 firstGlyph = 0; ///< Index into TextLayout::glyphs
+  u32 glyphCount = 0;
 };
 
 /**
@@ -121,6 +144,8 @@ struct TextLayout {
   bool rightToLeft = false;
   std::vector<size_t>
       commandIndices; // Indices where commands occur in character stream
+  std::vector<InlineCommand> commands; // Parallel to commandIndices
+  std::vector<LayoutGlyph> glyphs;     // totalCharacters entries
 };
 
 /**
@@ -235,7 +260,25 @@ public:
   [[nodiscard]] TextLayout layout(const std::string &text) const;
 
   /**
-   * @brief Measure text bounds without full layout
+   * @brief Layout text, reusing an earlier result for the same text, font,
+   * width and style
+   *
+   * Dialogue boxes lay out the same line every frame while it is revealed;
+   * a hit costs a hash of the text and no allocation.
+   */
+  [[nodiscard]] std::shared_ptr<const TextLayout>
+  layoutCached(const std::string &text) const;
+
+  /// Layouts kept by layoutCached(), least recently used dropped first
+  void setLayoutCacheCapacity(usize capacity);
+  /// Forget cached layouts and advances, e.g. after fonts were reloaded
+  void clearLayoutCache();
+  [[nodiscard]] usize getLayoutCacheSize() const {
+    return m_layoutCache.size();
+  }
+
+  /**
+   * @brief Measure text bounds (cached, see layoutCached())
    */
   [[nodiscard]] std::pair<f32, f32> measureText(const std::string &text) const;
 
@@ -259,22 +302,42 @@ public:
   getCharacterPosition(const TextLayout &layout, i32 charIndex) const;
 
 private:
-  /**
-   * @brief Break text into words for wrapping
-   */
-  [[nodiscard]] std::vector<std::string>
-  breakIntoWords(const std::string &text) const;
-
-  /**
-   * @brief Measure a single character
-   */
-  [[nodiscard]] f32 measureChar(char c, const TextStyle &style) const;
-
-  /**
-   * @brief Measure a word
-   */
-  [[nodiscard]] f32 measureWord(const std::string &word,
+  /// Keyed by load ids so a font freed and reallocated at the same address
+  /// never hits stale advances; atlasId is 0 when the font is measured
+  struct AdvanceKey {
+    u64 fontId;
+    u64 atlasId;
+    char32_t codepoint;
+    f32 size;
+    bool operator==(const AdvanceKey &other) const {
+      return fontId == other.fontId && atlasId == other.atlasId &&
+             codepoint == other.codepoint && size == other.size;
+    }
+  };
+  struct AdvanceKeyHash {
+    usize operator()(const AdvanceKey &key) const;
+  };
+  struct CachedLayout {
+    u64 hash = 0;
+    std::string text;
+    u64 fontId = 0;
+    u64 atlasId = 0;
+    f32 maxWidth = 0.0f;
+    f32 lineHeight = 0.0f;
+    TextAlign alignment = TextAlign::Left;
+    bool rightToLeft = false;
+    TextStyle style;
+    std::shared_ptr<const TextLayout> layout;
+    u64 lastUsed = 0;
+  };
+
+  /**
+   * @brief Advance of a codepoint, from the atlas, the font or an estimate
+   */
+  [[nodiscard]] f32 measureChar(char32_t codepoint,
                                 const TextStyle &style) const;
+  [[nodiscard]] bool matches(const CachedLayout &entry, u64 hash,
+                             const std::string &text) const;
 
   std::shared_ptr<FontAtlas> m_fontAtlas;
   std::shared_ptr<Font> m_font;
@@ -284,6 +347,11 @@ private:
   bool m_rightToLeft = false;
   TextStyle m_defaultStyle;
   RichTextParser m_parser;
+
+  mutable std::unordered_map<AdvanceKey, f32, AdvanceKeyHash> m_advances;
+  mutable std::vector<CachedLayout> m_layoutCache;
+  mutable u64 m_layoutUses = 0;
+  usize m_layoutCacheCapacity = 32;
 };
 
 /**
@@ -309,10 +377,15 @@ public:
   TypewriterAnimator();
 
   /**
-   * @brief Set the text layout to animate
+   * @brief Set the text layout to animate; it must outlive the animator
    */
   void setLayout(const TextLayout &layout);
 
+  /**
+   * @brief Animate a shared layout, e.g. from TextLayoutEngine::layoutCached
+   */
+  void setLayout(std::shared_ptr<const TextLayout> layout);
+
   /**
    * @brief Set typing speed (characters per second)
    */
@@ -383,9 +456,12 @@ private:
   /**
    * @brief Get pause duration for punctuation
    */
-  [[nodiscard]] f32 getPunctuationPause(char c) const;
+  [[nodiscard]] f32 getPunctuationPause(char32_t c) const;
 
   const TextLayout *m_layout = nullptr;
+  std::shared_ptr<const TextLayout> m_sharedLayout;
+  /// Characters whose punctuation pause has been applied
+  i32 m_pausedThrough = 0;
   TypewriterState m_state;
   TextStyle m_currentStyle;
   f32 m_punctuationPause = 3.0f; // Multiplier for pause at punctuation
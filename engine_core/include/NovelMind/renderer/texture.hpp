@@ -6,6 +6,10 @@
 
 namespace NovelMind::renderer {
 
+class AsyncTextureLoader;
+
+enum class TextureState : u8 { Empty, Loading, Ready, Failed };
+
 class Texture {
 public:
   Texture();
@@ -20,15 +24,52 @@ public:
   Result<void> loadFromRGBA(const u8 *pixels, i32 width, i32 height);
   void destroy();
 
+  /// True once the texture is loaded and can be drawn
   [[nodiscard]] bool isValid() const;
+  /// Textures queued on an AsyncTextureLoader stay Loading until uploaded
+  [[nodiscard]] TextureState getState() const { return m_state; }
+  [[nodiscard]] bool isLoading() const {
+    return m_state == TextureState::Loading;
+  }
   [[nodiscard]] i32 getWidth() const;
   [[nodiscard]] i32 getHeight() const;
   [[nodiscard]] void *getNativeHandle() const;
 
+  /**
+   * @brief RGBA8 pixels, row-major, for textures that are not on the GPU
+   *
+   * Textures are kept in memory instead of uploaded when GPU upload is
+   * disabled or no GPU backend is built in, so CPU renderers can sample
+   * them. Empty for uploaded textures.
+   */
+  [[nodiscard]] const std::vector<u8> &getPixels() const { return m_pixels; }
+
+  /// Upload textures loaded from now on to the GPU (default on where a GPU
+  /// backend is built in); CPU renderers turn this off
+  static void setGpuUploadEnabled(bool enabled);
+  [[nodiscard]] static bool isGpuUploadEnabled();
+
 private:
+  friend class AsyncTextureLoader;
+  friend class GlyphCache;
+  friend class RenderTarget;
+
+  // Staged loading used by AsyncTextureLoader on the render thread;
+  // GlyphCache and RenderTarget update their pixels with uploadRows()
+  void markLoading();
+  void markFailed();
+  void adoptPixels(std::vector<u8> &&pixels, i32 width, i32 height);
+  void beginUpload(i32 width, i32 height);
+  /// With a pixel unpack buffer bound, rows is an offset into it. Textures
+  /// kept in memory copy the rows instead.
+  void uploadRows(const void *rows, i32 firstRow, i32 rowCount);
+  void finishUpload();
+
   void *m_handle;
   i32 m_width;
   i32 m_height;
+  std::vector<u8> m_pixels;
+  TextureState m_state = TextureState::Empty;
 };
 
 } // namespace NovelMind::renderer
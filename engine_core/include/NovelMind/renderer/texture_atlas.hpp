@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * @file texture_atlas.hpp
+ * @brief Build-time texture atlases and their runtime index
+ *
+ * The build packs small images that are used together (a character's
+ * expressions, the widgets of one UI screen) into shared atlas pages with
+ * a MaxRects packer, and stores an index mapping each original image id to
+ * its page and pixel rectangle. At runtime ResourceManager consults the
+ * index, so loading an atlased image yields the page texture plus a source
+ * rect, and sprites drawn from one page batch into a single draw call.
+ *
+ * Sprites are placed unrotated with a border of extruded edge pixels so
+ * bilinear filtering never samples a neighbour. Pages are written as
+ * uncompressed 32-bit TGA; packs compress them like any other resource.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+struct AtlasRect {
+  i32 x = 0;
+  i32 y = 0;
+  i32 width = 0;
+  i32 height = 0;
+};
+
+/**
+ * @brief MaxRects bin packer (best short side fit, no rotation)
+ *
+ * Tracks the maximal free rectangles of one bin; every placement splits
+ * the free rectangles it intersects and drops those contained in others.
+ */
+class MaxRectsPacker {
+public:
+  MaxRectsPacker(i32 width, i32 height);
+
+  void reset(i32 width, i32 height);
+
+  /// Place a width x height rectangle, or nullopt if it does not fit
+  [[nodiscard]] std::optional<AtlasRect> insert(i32 width, i32 height);
+
+  [[nodiscard]] const std::vector<AtlasRect> &usedRects() const {
+    return m_used;
+  }
+  /// Fraction of the bin covered by placed rectangles
+  [[nodiscard]] f32 occupancy() const;
+
+private:
+  void splitFreeRects(const AtlasRect &placed);
+  void pruneFreeRects();
+
+  i32 m_width = 0;
+  i32 m_height = 0;
+  std::vector<AtlasRect> m_free;
+  std::vector<AtlasRect> m_used;
+};
+
+struct TextureAtlasPage {
+  std::string id; ///< Resource id of the page image
+  i32 width = 0;
+  i32 height = 0;
+};
+
+struct TextureAtlasSprite {
+  u32 page = 0;
+  AtlasRect rect; ///< Pixel rectangle of the image on its page
+};
+
+/**
+ * @brief Maps original image ids to atlas pages and rectangles
+ *
+ * Serialized as a line-based text resource:
+ * @code
+ * atlas 1
+ * page <id> <width> <height>
+ * sprite <page> <x> <y> <width> <height> <id>
+ * @endcode
+ */
+class TextureAtlasIndex {
+public:
+  /// Resource id the build stores the index under
+  static constexpr const char *kResourceId = "texture_atlas.nmatlas";
+
+  u32 addPage(const std::string &id, i32 width, i32 height);
+  void addSprite(const std::string &id, u32 page, const AtlasRect &rect);
+
+  [[nodiscard]] const TextureAtlasSprite *find(const std::string &id) const;
+  [[nodiscard]] const std::vector<TextureAtlasPage> &pages() const {
+    return m_pages;
+  }
+  [[nodiscard]] size_t spriteCount() const { return m_sprites.size(); }
+  [[nodiscard]] bool empty() const { return m_sprites.empty(); }
+
+  [[nodiscard]] std::string serialize() const;
+  [[nodiscard]] static Result<TextureAtlasIndex>
+  parse(const std::string &text);
+
+private:
+  std::vector<TextureAtlasPage> m_pages;
+  std::unordered_map<std::string, TextureAtlasSprite> m_sprites;
+};
+
+/**
+ * @brief Packs groups of images into atlas pages
+ *
+ * Each group gets its own pages so that images used together share a
+ * texture. Images larger than half a page, and groups with a single image,
+ * gain nothing from atlasing and are reported by rejected() instead.
+ */
+class TextureAtlasBuilder {
+public:
+  struct Page {
+    std::string id;
+    i32 width = 0;
+    i32 height = 0;
+    std::vector<u8> rgba;
+  };
+
+  explicit TextureAtlasBuilder(i32 maxPageSize = 2048, i32 padding = 2);
+
+  /// Add an encoded image (any format the texture loader decodes)
+  Result<void> addImage(const std::string &group, const std::string &id,
+                        const std::vector<u8> &encoded);
+  Result<void> addImage(const std::string &group, const std::string &id,
+                        const u8 *rgba, i32 width, i32 height);
+
+  /**
+   * @brief Pack every group and compose the page images
+   *
+   * Pages are named "<prefix><group>_<n>.tga" with the group sanitized to
+   * [A-Za-z0-9_]. Pages shrink to the smallest power of two holding their
+   * sprites.
+   */
+  Result<void> build(const std::string &pagePrefix = "atlas_");
+
+  [[nodiscard]] const std::vector<Page> &pages() const { return m_pages; }
+  [[nodiscard]] const TextureAtlasIndex &index() const { return m_index; }
+  /// Ids left out of the atlas; they should ship as standalone images
+  [[nodiscard]] const std::vector<std::string> &rejected() const {
+    return m_rejected;
+  }
+
+  /// Encode RGBA8 pixels as an uncompressed, top-left origin TGA
+  [[nodiscard]] static std::vector<u8> encodeTga(const u8 *rgba, i32 width,
+                                                 i32 height);
+
+private:
+  struct Image {
+    std::string group;
+    std::string id;
+    i32 width = 0;
+    i32 height = 0;
+    std::vector<u8> rgba;
+  };
+
+  void blit(Page &page, const Image &image, i32 x, i32 y) const;
+
+  i32 m_maxPageSize;
+  i32 m_padding;
+  std::vector<Image> m_images;
+  std::vector<Page> m_pages;
+  TextureAtlasIndex m_index;
+  std::vector<std::string> m_rejected;
+};
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file texture_loader.hpp
+ * @brief Asynchronous texture decoding with budgeted uploads
+ *
+ * Decoding a large PNG and uploading it in one glTexImage2D call stalls the
+ * frame for tens of milliseconds. AsyncTextureLoader decodes images on
+ * worker threads into pooled pixel buffers. pump(), called once per frame
+ * on the render thread, then uploads finished images a chunk of rows at a
+ * time until the per-frame byte or time budget is spent. Where the GL
+ * context has pixel buffer objects, rows are staged through a small ring of
+ * PBOs so the driver can copy them asynchronously.
+ *
+ * Textures are Loading (and not drawable) until their last row is
+ * uploaded, so callers keep drawing what they showed before. Without GPU
+ * upload the decoded pixels are handed to the texture as they are.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+struct TextureUploadBudget {
+  usize bytesPerFrame = usize{16} << 20;
+  f64 millisecondsPerFrame = 4.0;
+};
+
+class AsyncTextureLoader {
+public:
+  /// Rows are uploaded in chunks of at most this many bytes
+  static constexpr usize kChunkBytes = usize{4} << 20;
+
+  /// @param threadCount decoder threads, 0 for one less than the core count
+  explicit AsyncTextureLoader(u32 threadCount = 0);
+  ~AsyncTextureLoader();
+
+  AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+  AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+
+  /**
+   * @brief Queue encoded image data for texture
+   *
+   * The texture turns Loading immediately and Ready (or Failed) in a later
+   * pump(). Textures released before then are skipped.
+   */
+  void load(const std::shared_ptr<Texture> &texture, std::vector<u8> encoded);
+  /// As above, for data shared with its reader, e.g. a VFS cache buffer
+  void load(const std::shared_ptr<Texture> &texture,
+            std::shared_ptr<const std::vector<u8>> encoded);
+
+  /**
+   * @brief Mark texture Loading while its encoded data is still being read
+   *
+   * Follow with load(), or with fail() if the data cannot be read.
+   */
+  void reserve(const std::shared_ptr<Texture> &texture);
+  void fail(const std::shared_ptr<Texture> &texture);
+
+  /**
+   * @brief Upload decoded textures within the budget (render thread only)
+   * @return Bytes uploaded
+   */
+  usize pump();
+
+  /// Wait for every queued texture and upload it regardless of budget
+  void finish();
+
+  void setBudget(const TextureUploadBudget &budget) { m_budget = budget; }
+  [[nodiscard]] const TextureUploadBudget &getBudget() const {
+    return m_budget;
+  }
+
+  /// Textures queued, decoding or partially uploaded
+  [[nodiscard]] usize getPendingCount() const;
+  [[nodiscard]] u32 getThreadCount() const;
+
+private:
+  struct Job;
+  struct Workers;
+  struct PixelUnpackBuffers;
+
+  usize pumpWithBudget(usize byteBudget, f64 timeBudgetMs);
+  usize uploadChunk(Job &job, Texture &texture, usize byteBudget);
+
+  std::unique_ptr<Workers> m_workers;
+  std::unique_ptr<PixelUnpackBuffers> m_unpackBuffers;
+  std::deque<std::unique_ptr<Job>> m_uploads;
+  TextureUploadBudget m_budget;
+};
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file utf8.hpp
+ * @brief Minimal UTF-8 decoding for text rendering and layout
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <string_view>
+
+namespace NovelMind::renderer {
+
+/// Substituted for malformed, overlong or surrogate sequences
+inline constexpr char32_t kReplacementCharacter = U'\uFFFD';
+
+/**
+ * @brief Decode the codepoint starting at offset and advance past it
+ *
+ * Invalid input decodes to kReplacementCharacter and consumes one byte, so
+ * decoding always makes progress.
+ */
+inline char32_t decodeUtf8(std::string_view text, usize &offset) {
+  const auto lead = static_cast<u8>(text[offset++]);
+  if (lead < 0x80) {
+    return lead;
+  }
+
+  usize length = 0;
+  char32_t codepoint = 0;
+  char32_t minimum = 0;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 1;
+    codepoint = lead & 0x1Fu;
+    minimum = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 2;
+    codepoint = lead & 0x0Fu;
+    minimum = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 3;
+    codepoint = lead & 0x07u;
+    minimum = 0x10000;
+  } else {
+    return kReplacementCharacter;
+  }
+
+  if (text.size() - offset < length) {
+    return kReplacementCharacter;
+  }
+  for (usize i = 0; i < length; ++i) {
+    const auto next = static_cast<u8>(text[offset + i]);
+    if ((next & 0xC0) != 0x80) {
+      return kReplacementCharacter;
+    }
+    codepoint = (codepoint << 6) | (next & 0x3Fu);
+  }
+  if (codepoint < minimum || codepoint > 0x10FFFF ||
+      (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+    return kReplacementCharacter;
+  }
+  offset += length;
+  return codepoint;
+}
+
+/// Bytes taken by the first count codepoints of text
+inline usize utf8PrefixLength(std::string_view text, usize count) {
+  usize offset = 0;
+  for (; count > 0 && offset < text.size(); --count) {
+    decodeUtf8(text, offset);
+  }
+  return offset;
+}
+
+} // namespace NovelMind::renderer
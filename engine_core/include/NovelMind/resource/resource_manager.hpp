@@ -4,6 +4,9 @@
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/renderer/font.hpp"
 #include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/renderer/texture_loader.hpp"
+#include "NovelMind/renderer/transform.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
 #include <memory>
 #include <string>
@@ -16,6 +19,26 @@ using TextureHandle = std::shared_ptr<renderer::Texture>;
 using FontHandle = std::shared_ptr<renderer::Font>;
 using FontAtlasHandle = std::shared_ptr<renderer::FontAtlas>;
 
+/**
+ * @brief A texture, or the region of an atlas page holding an image
+ *
+ * Draw with sourceRect (see Sprite::setSourceRect and the IRenderer
+ * drawSprite overload taking a source rect) and size things by width()
+ * and height() rather than by the texture dimensions.
+ */
+struct TextureView {
+  TextureHandle texture;
+  renderer::Rect sourceRect;
+
+  [[nodiscard]] bool isValid() const { return texture && texture->isValid(); }
+  /// Still decoding or uploading; draw what was shown before meanwhile
+  [[nodiscard]] bool isLoading() const {
+    return texture && texture->isLoading();
+  }
+  [[nodiscard]] f32 width() const { return sourceRect.width; }
+  [[nodiscard]] f32 height() const { return sourceRect.height; }
+};
+
 class ResourceManager {
 public:
   explicit ResourceManager(vfs::IVirtualFileSystem *vfs = nullptr);
@@ -27,9 +50,42 @@ public:
   void setVfs(vfs::IVirtualFileSystem *vfs);
   void setBasePath(const std::string &path);
 
-  [[nodiscard]] Result<TextureHandle> loadTexture(const std::string &id);
+  /**
+   * @brief Load an image by id
+   *
+   * Images the build packed into an atlas (see texture_atlas.hpp) resolve
+   * to their atlas page and rectangle; the page is loaded once and shared.
+   * The atlas index is read from the VFS or base path on first use.
+   *
+   * With async loading on, a texture seen for the first time is returned
+   * while still loading and becomes valid during a later update(). Images
+   * that are not loose files are read on the VFS I/O threads, so the VFS
+   * owner must call processCompletions() each frame as well.
+   */
+  [[nodiscard]] Result<TextureView> loadTexture(const std::string &id);
   void unloadTexture(const std::string &id);
 
+  /**
+   * @brief Decode textures on worker threads (see texture_loader.hpp)
+   * @param threadCount decoder threads, 0 for one less than the core count
+   */
+  void setAsyncTextureLoading(bool enabled, u32 threadCount = 0);
+  [[nodiscard]] bool isAsyncTextureLoading() const {
+    return m_textureLoader != nullptr;
+  }
+  void setTextureUploadBudget(const renderer::TextureUploadBudget &budget);
+
+  /// Upload decoded textures; call once per frame on the render thread
+  usize update();
+  /// Block until every texture being loaded is ready, e.g. behind a
+  /// loading screen
+  void finishTextureLoads();
+  [[nodiscard]] usize getPendingTextureCount() const;
+
+  /// Replace the atlas index instead of loading it on first use
+  void setTextureAtlasIndex(renderer::TextureAtlasIndex index);
+  [[nodiscard]] const renderer::TextureAtlasIndex &getTextureAtlasIndex();
+
   [[nodiscard]] Result<FontHandle> loadFont(const std::string &id, i32 size);
   void unloadFont(const std::string &id, i32 size);
 
@@ -49,11 +105,21 @@ public:
 private:
   Result<std::vector<u8>> readResource(const std::string &id) const;
   std::string resolvePath(const std::string &id) const;
+  Result<TextureHandle> loadTextureFile(const std::string &id);
+  const renderer::TextureAtlasSprite *findAtlasSprite(const std::string &id);
+  bool readTextureAsync(const std::string &id, const TextureHandle &texture);
+  void cancelTextureRead(const std::string &id);
 
   vfs::IVirtualFileSystem *m_vfs = nullptr;
   std::string m_basePath;
 
   std::unordered_map<std::string, TextureHandle> m_textures;
+  std::unique_ptr<renderer::AsyncTextureLoader> m_textureLoader;
+  // Textures whose encoded bytes the VFS is still reading
+  std::unordered_map<std::string, VFS::AsyncReadHandle> m_textureReads;
+  renderer::TextureUploadBudget m_uploadBudget;
+  renderer::TextureAtlasIndex m_atlasIndex;
+  bool m_atlasIndexLoaded = false;
   std::unordered_map<std::string,
                      std::unordered_map<i32, FontHandle>>
       m_fonts;
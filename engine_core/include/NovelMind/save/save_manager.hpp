@@ -16,6 +16,7 @@ struct SaveData {
   std::map<std::string, f32> floatVariables;
   std::map<std::string, bool> flags;
   std::map<std::string, std::string> stringVariables;
+  /// RGBA8, thumbnailWidth * 4 bytes per row
   std::vector<u8> thumbnailData;
   i32 thumbnailWidth = 0;
   i32 thumbnailHeight = 0;
@@ -39,6 +40,9 @@ struct SaveConfig {
 
 class SaveManager {
 public:
+  static constexpr i32 kThumbnailWidth = 320;
+  static constexpr i32 kThumbnailHeight = 180;
+
   SaveManager();
   ~SaveManager();
 
@@ -58,6 +62,18 @@ public:
   void setConfig(const SaveConfig &config);
   [[nodiscard]] const SaveConfig &getConfig() const;
 
+  /**
+   * @brief Store a downscaled copy of a frame as the save's thumbnail
+   *
+   * The frame (RGBA8, e.g. SoftwareRenderer::pixels() or a decoded
+   * screenshot) is shrunk to fit maxWidth x maxHeight with its aspect ratio
+   * kept, filtered in linear light on worker threads.
+   */
+  static Result<void> setThumbnail(SaveData &data, const u8 *rgba, i32 width,
+                                   i32 height,
+                                   i32 maxWidth = kThumbnailWidth,
+                                   i32 maxHeight = kThumbnailHeight);
+
   Result<void> saveAuto(const SaveData &data);
   Result<SaveData> loadAuto();
   [[nodiscard]] bool autoSaveExists() const;
@@ -9,6 +9,7 @@
  * - Layer hierarchy: Background -> Characters -> UI -> Effects
  * - Full serialization support for Save/Load and Editor
  * - Inspector API for Editor integration
+ * - Change tracking, so idle frames can be skipped or redrawn in part
  */
 
 #include "NovelMind/core/result.hpp"
@@ -37,6 +38,10 @@ namespace NovelMind::localization {
 class LocalizationManager;
 }
 
+namespace NovelMind::renderer {
+class TextLayoutEngine;
+}
+
 namespace NovelMind::scene {
 
 /**
@@ -107,6 +112,8 @@ public:
  * - Z-ordering within layer
  * - Property system for serialization
  * - Animation support
+ * - Change tracking: anything that alters what render() draws marks the
+ *   object dirty until the SceneGraph next renders it
  */
 class SceneObjectBase {
 public:
@@ -197,6 +204,20 @@ public:
   void animateScale(f32 toScaleX, f32 toScaleY, f32 duration,
                     EaseType easing = EaseType::Linear);
 
+  // Change tracking
+  /// Request a redraw; setters and running animations do this themselves
+  void markDirty() { m_dirty = true; }
+  [[nodiscard]] bool isDirty() const { return m_dirty; }
+
+  /**
+   * @brief Screen area render() draws into
+   * @return nullopt if it cannot be bounded (e.g. full-screen objects), in
+   *         which case a change to the object redraws the whole frame
+   */
+  [[nodiscard]] virtual std::optional<renderer::Rect> getBounds() const {
+    return std::nullopt;
+  }
+
 protected:
   // Notify observers of property changes
   void notifyPropertyChanged(const std::string &property,
@@ -220,6 +241,11 @@ protected:
   // Active animations
   std::vector<std::unique_ptr<Tween>> m_animations;
 
+  // Change tracking, read and reset by SceneGraph
+  bool m_dirty = true;
+  bool m_drawn = false;
+  std::optional<renderer::Rect> m_drawnBounds;
+
   // Observer for change notifications (set by SceneGraph)
   ISceneObserver *m_observer = nullptr;
   resource::ResourceManager *m_resources = nullptr;
@@ -247,6 +273,7 @@ public:
 private:
   std::string m_textureId;
   renderer::Color m_tint{255, 255, 255, 255};
+  resource::TextureView m_shownTexture;
 };
 
 /**
@@ -292,6 +319,7 @@ public:
   [[nodiscard]] bool isHighlighted() const { return m_highlighted; }
 
   void render(renderer::IRenderer &renderer) override;
+  [[nodiscard]] std::optional<renderer::Rect> getBounds() const override;
   [[nodiscard]] SceneObjectState saveState() const override;
   void loadState(const SceneObjectState &state) override;
 
@@ -300,6 +328,9 @@ public:
                      EaseType easing = EaseType::EaseOutQuad);
 
 private:
+  [[nodiscard]] renderer::Transform2D
+  spriteTransform(const resource::TextureView &view) const;
+
   std::string m_characterId;
   std::string m_displayName;
   std::string m_expression = "default";
@@ -307,6 +338,9 @@ private:
   Position m_slotPosition = Position::Center;
   renderer::Color m_nameColor{255, 255, 255, 255};
   bool m_highlighted = false;
+  resource::TextureView m_shownTexture;
+  /// Texture id m_shownTexture was resolved from
+  std::string m_shownTextureId;
 };
 
 /**
@@ -315,6 +349,7 @@ private:
 class DialogueUIObject : public SceneObjectBase {
 public:
   explicit DialogueUIObject(const std::string &id);
+  ~DialogueUIObject() override;
 
   void setSpeaker(const std::string &speaker);
   [[nodiscard]] const std::string &getSpeaker() const { return m_speaker; }
@@ -346,19 +381,30 @@ public:
 
   void update(f64 deltaTime) override;
   void render(renderer::IRenderer &renderer) override;
+  /// The text box; text is expected to fit inside it
+  [[nodiscard]] std::optional<renderer::Rect> getBounds() const override;
   [[nodiscard]] SceneObjectState saveState() const override;
   void loadState(const SceneObjectState &state) override;
 
 private:
+  [[nodiscard]] renderer::Rect boxRect() const;
+
   std::string m_speaker;
   std::string m_text;
   renderer::Color m_speakerColor{255, 255, 255, 255};
   std::string m_backgroundTextureId;
+  resource::TextureView m_shownBackground;
+
+  // Laid out once per text and reused while it is revealed
+  std::unique_ptr<renderer::TextLayoutEngine> m_textLayout;
+  std::string m_revealBuffer;
 
   // Typewriter state
   bool m_typewriterEnabled = true;
   f32 m_typewriterSpeed = 30.0f;
   f32 m_typewriterProgress = 0.0f;
+  /// Characters to reveal, refined from the layout once it is rendered
+  f32 m_typewriterLength = 0.0f;
   bool m_typewriterComplete = true;
 };
 
@@ -376,6 +422,7 @@ public:
   };
 
   explicit ChoiceUIObject(const std::string &id);
+  ~ChoiceUIObject() override;
 
   void setChoices(const std::vector<ChoiceOption> &choices);
   [[nodiscard]] const std::vector<ChoiceOption> &getChoices() const {
@@ -400,6 +447,7 @@ private:
   std::vector<ChoiceOption> m_choices;
   i32 m_selectedIndex = 0;
   std::function<void(i32, const std::string &)> m_onSelect;
+  std::unique_ptr<renderer::TextLayoutEngine> m_textLayout;
 };
 
 /**
@@ -475,12 +523,18 @@ public:
   void update(f64 deltaTime);
   void render(renderer::IRenderer &renderer);
 
+  /// Objects were added, removed or reordered, or the layer's visibility
+  /// changed, since the SceneGraph last rendered it
+  [[nodiscard]] bool isDirty() const { return m_dirty; }
+
 private:
   std::string m_name;
   LayerType m_type;
   std::vector<std::unique_ptr<SceneObjectBase>> m_objects;
   bool m_visible = true;
   f32 m_alpha = 1.0f;
+  bool m_dirty = true;
+  friend class SceneGraph;
 };
 
 /**
@@ -493,6 +547,19 @@ struct SceneState {
   std::vector<std::string> visibleCharacters;
 };
 
+/**
+ * @brief What changed in a SceneGraph since it was last rendered
+ */
+struct SceneDamage {
+  bool changed = false;
+  /// The change cannot be bounded and the whole frame must be redrawn
+  bool full = false;
+  /// Screen area to redraw when changed and not full
+  renderer::Rect rect;
+
+  [[nodiscard]] bool isPartial() const { return changed && !full; }
+};
+
 /**
  * @brief SceneGraph - main scene management class
  *
@@ -501,6 +568,9 @@ struct SceneState {
  * - Object lifecycle (add, remove, find)
  * - Full serialization for Save/Load
  * - Observer pattern for Editor integration
+ * - Change tracking: getDamage() reports what render() would draw
+ *   differently from the last frame, covering both where changed objects
+ *   are now and where they were drawn before
  */
 class SceneGraph : public ISceneObserver {
 public:
@@ -512,6 +582,12 @@ public:
   [[nodiscard]] const std::string &getSceneId() const { return m_sceneId; }
   void clear();
 
+  /// Mark scene changes in @p recorder so pack layout can cluster by scene
+  void setAccessTraceRecorder(
+      std::shared_ptr<VFS::AccessTraceRecorder> recorder) {
+    m_traceRecorder = std::move(recorder);
+  }
+
   // Layer access
   [[nodiscard]] Layer &getBackgroundLayer() { return m_backgroundLayer; }
   [[nodiscard]] Layer &getCharacterLayer() { return m_characterLayer; }
@@ -544,8 +620,14 @@ public:
 
   // Update and render
   void update(f64 deltaTime);
+  /// Draw every visible object and mark the scene clean
   void render(renderer::IRenderer &renderer);
 
+  // Change tracking
+  [[nodiscard]] SceneDamage getDamage() const;
+  /// Redraw everything next frame, e.g. after the window was resized
+  void markAllDirty() { m_allDirty = true; }
+
   void setResourceManager(resource::ResourceManager *resources);
   [[nodiscard]] resource::ResourceManager *getResourceManager() const {
     return m_resources;
@@ -585,6 +667,8 @@ private:
   std::vector<ISceneObserver *> m_observers;
   resource::ResourceManager *m_resources = nullptr;
   localization::LocalizationManager *m_localization = nullptr;
+  std::shared_ptr<VFS::AccessTraceRecorder> m_traceRecorder;
+  bool m_allDirty = true;
 };
 
 } // namespace NovelMind::scene
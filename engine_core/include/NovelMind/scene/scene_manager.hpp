@@ -7,6 +7,10 @@
 #include <string>
 #include <vector>
 
+namespace NovelMind::VFS {
+class AccessTraceRecorder;
+}
+
 namespace NovelMind::scene {
 
 enum class LayerType { Background, Characters, UI, Effects };
@@ -30,6 +34,12 @@ public:
 
   [[nodiscard]] const std::string &getCurrentSceneId() const;
 
+  /// Mark scene changes in @p recorder so pack layout can cluster by scene
+  void setAccessTraceRecorder(
+      std::shared_ptr<VFS::AccessTraceRecorder> recorder) {
+    m_traceRecorder = std::move(recorder);
+  }
+
 private:
   std::vector<std::unique_ptr<SceneObject>> &getLayer(LayerType layer);
 
@@ -38,6 +48,7 @@ private:
   std::vector<std::unique_ptr<SceneObject>> m_charactersLayer;
   std::vector<std::unique_ptr<SceneObject>> m_uiLayer;
   std::vector<std::unique_ptr<SceneObject>> m_effectsLayer;
+  std::shared_ptr<VFS::AccessTraceRecorder> m_traceRecorder;
 };
 
 } // namespace NovelMind::scene
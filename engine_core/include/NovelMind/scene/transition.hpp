@@ -6,10 +6,15 @@
  *
  * This module provides various transition effects for
  * scene changes in visual novels.
+ *
+ * Transitions that show the outgoing scene draw it from a snapshot
+ * captured once with IRenderer::captureFrame(), so while they run only the
+ * incoming scene is rendered, plus one fullscreen quad.
  */
 
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/render_target.hpp"
 #include "NovelMind/renderer/renderer.hpp"
 #include <functional>
 #include <memory>
@@ -81,6 +86,25 @@ public:
    * @brief Get the transition type
    */
   [[nodiscard]] virtual TransitionType getType() const = 0;
+
+  /**
+   * @brief Outgoing frame to composite over the incoming scene
+   *
+   * Capture it before switching scenes. Without one, transitions cover the
+   * incoming scene with their mask colour instead.
+   */
+  void setSnapshot(std::shared_ptr<const renderer::RenderTarget> snapshot) {
+    m_snapshot = std::move(snapshot);
+  }
+
+protected:
+  /// The snapshot if one was captured, else nullptr
+  [[nodiscard]] const renderer::RenderTarget *snapshot() const {
+    return m_snapshot && m_snapshot->isValid() ? m_snapshot.get() : nullptr;
+  }
+
+private:
+  std::shared_ptr<const renderer::RenderTarget> m_snapshot;
 };
 
 /**
@@ -145,6 +145,9 @@ struct RuntimeSaveState {
 class ScriptRuntime {
 public:
   using EventCallback = std::function<void(const ScriptEvent &)>;
+  /// Returns the frame currently on screen
+  using FrameCaptureCallback =
+      std::function<std::shared_ptr<const renderer::RenderTarget>()>;
 
   ScriptRuntime();
   ~ScriptRuntime();
@@ -249,6 +252,13 @@ public:
    */
   [[nodiscard]] bool isComplete() const;
 
+  /**
+   * @brief Check if a transition is still animating
+   *
+   * Every frame needs redrawing while it runs, even if the scene is idle.
+   */
+  [[nodiscard]] bool isTransitionActive() const;
+
   /**
    * @brief Set a script variable
    */
@@ -304,6 +314,22 @@ public:
    */
   void setEventCallback(EventCallback callback);
 
+  /**
+   * @brief Set where transitions get their outgoing frame
+   *
+   * The frame on screen is taken before the first background or character
+   * change since the player last waited, so `show background` followed by
+   * `transition` dissolves from the old scene. Typically
+   * core::Application::getLastFrame(), which setScriptRuntime() installs.
+   * Without it, transitions cover the scene with their mask colour.
+   */
+  void setFrameCapture(FrameCaptureCallback capture);
+
+  /**
+   * @brief Draw the running transition, if any, over the rendered scene
+   */
+  void renderTransition(renderer::IRenderer &renderer);
+
   /**
    * @brief Get the underlying VM (for debugging)
    */
@@ -332,6 +358,7 @@ private:
   void updateTransition(f64 deltaTime);
   void updateAnimation(f64 deltaTime);
   void updateDialogue(f64 deltaTime);
+  void holdOutgoingFrame();
 
   Scene::CharacterPosition parsePosition(i32 posCode);
   std::unique_ptr<Scene::ITransition> createTransition(const std::string &type,
@@ -373,6 +400,9 @@ private:
 
   // Event callback
   EventCallback m_eventCallback;
+  FrameCaptureCallback m_frameCapture;
+  // Screen before the pending scene changes, for the next transition
+  std::shared_ptr<const renderer::RenderTarget> m_outgoingFrame;
 };
 
 /**
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file access_trace.hpp
+ * @brief Resource access traces for profile-guided pack layout
+ *
+ * A recorder attached to the VFS logs every resource read during a
+ * playthrough, with scene changes as markers. The build consumes the saved
+ * traces and writes pack data in first-access order, clustered by the scene
+ * that first needs it, so a scene load turns into a few sequential reads
+ * instead of seeks across the whole pack.
+ *
+ * Traces are text, one event per line after an "NMTRACE 1" header:
+ *
+ *   R <tab> microseconds <tab> bytes <tab> resource id
+ *   S <tab> microseconds <tab> scene id
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+struct AccessTraceEvent {
+  enum class Kind : u8 { Read, Scene };
+
+  Kind kind = Kind::Read;
+  u64 timeUs = 0; // Since the recording started
+  u64 bytes = 0;  // Read events only
+  std::string id; // Resource id, or scene id for Scene events
+};
+
+class AccessTrace {
+public:
+  AccessTrace() = default;
+  explicit AccessTrace(std::vector<AccessTraceEvent> events)
+      : m_events(std::move(events)) {}
+
+  [[nodiscard]] static Result<AccessTrace> parse(std::string_view text);
+  [[nodiscard]] static Result<AccessTrace> load(const std::string &path);
+  [[nodiscard]] std::string serialize() const;
+  [[nodiscard]] Result<void> save(const std::string &path) const;
+
+  [[nodiscard]] const std::vector<AccessTraceEvent> &events() const {
+    return m_events;
+  }
+
+  /**
+   * @brief Order in which to store resources, from one or more traces
+   *
+   * Each resource joins the cluster of the first scene that reads it, and
+   * clusters follow the order scenes were first entered; within a cluster
+   * resources keep their first-access order. Later traces only place what
+   * earlier ones did not, so list the most representative playthrough
+   * first. Resources never read are not listed.
+   */
+  [[nodiscard]] static std::vector<std::string>
+  layoutOrder(std::span<const AccessTrace> traces);
+
+private:
+  std::vector<AccessTraceEvent> m_events;
+};
+
+/**
+ * @brief Thread-safe recorder the VFS and scene manager report to
+ *
+ * Recording is off until start(). Ids containing tabs or line breaks cannot
+ * be represented in a trace and are skipped.
+ */
+class AccessTraceRecorder {
+public:
+  void start();
+  void stop();
+  [[nodiscard]] bool isRecording() const;
+
+  void recordRead(std::string_view resourceId, u64 bytes);
+  void markScene(std::string_view sceneId);
+
+  /// Copy of the events recorded so far
+  [[nodiscard]] AccessTrace snapshot() const;
+  void clear();
+
+private:
+  void record(AccessTraceEvent::Kind kind, std::string_view id, u64 bytes);
+
+  mutable std::mutex m_mutex;
+  bool m_recording = false;
+  std::chrono::steady_clock::time_point m_start;
+  std::vector<AccessTraceEvent> m_events;
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * @file async_reader.hpp
+ * @brief Prioritised background reads for the virtual file system
+ *
+ * A small pool of I/O threads serves read requests in priority order
+ * (streaming audio before visible textures before prefetch). Concurrent
+ * requests for the same ResourceId share one read. Completion callbacks are
+ * queued and run on whichever thread calls dispatchCompletions(), normally
+ * the main thread once per frame.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+enum class ReadPriority : u8 {
+  Prefetch = 0,
+  Normal = 1,
+  Visible = 2,  // Textures needed for the current frame
+  Streaming = 3 // Audio streams that must not starve
+};
+
+using AsyncReadCallback =
+    std::function<void(const ResourceId &, const Result<SharedBuffer> &)>;
+
+namespace detail {
+struct AsyncReadRequest;
+struct AsyncReadSubscriber;
+} // namespace detail
+
+/**
+ * @brief One caller's interest in an asynchronous read
+ *
+ * Copies refer to the same interest. Dropping a handle does not cancel the
+ * read; call cancel() for that.
+ */
+class AsyncReadHandle {
+public:
+  AsyncReadHandle() = default;
+
+  [[nodiscard]] bool isValid() const { return m_subscriber != nullptr; }
+  [[nodiscard]] const ResourceId &id() const;
+
+  [[nodiscard]] bool isReady() const;
+  [[nodiscard]] bool isCancelled() const;
+
+  /**
+   * @brief Block until the read finishes or is cancelled
+   */
+  void wait() const;
+
+  /**
+   * @brief Wait, then return the bytes or the error
+   */
+  [[nodiscard]] Result<SharedBuffer> result() const;
+
+  /**
+   * @brief Withdraw this caller's interest
+   *
+   * The callback will not run. The read itself is dropped once every caller
+   * sharing it has cancelled and no I/O thread has started it.
+   */
+  void cancel();
+
+private:
+  friend class AsyncReader;
+  explicit AsyncReadHandle(
+      std::shared_ptr<detail::AsyncReadSubscriber> subscriber);
+
+  std::shared_ptr<detail::AsyncReadSubscriber> m_subscriber;
+};
+
+struct AsyncReaderStats {
+  u64 submitted = 0;
+  u64 deduplicated = 0;
+  u64 completed = 0;
+  u64 cancelled = 0;
+  usize inFlight = 0;
+};
+
+class AsyncReader {
+public:
+  using ReadFunction = std::function<Result<SharedBuffer>(const ResourceId &)>;
+
+  static constexpr usize kDefaultThreadCount = 2;
+
+  explicit AsyncReader(ReadFunction read,
+                       usize threadCount = kDefaultThreadCount);
+  /// Cancels queued reads and joins the I/O threads
+  ~AsyncReader();
+
+  AsyncReader(const AsyncReader &) = delete;
+  AsyncReader &operator=(const AsyncReader &) = delete;
+
+  [[nodiscard]] AsyncReadHandle submit(const ResourceId &id,
+                                       ReadPriority priority,
+                                       AsyncReadCallback callback = {});
+
+  /**
+   * @brief Run queued completion callbacks on the calling thread
+   * @return Number of callbacks run
+   */
+  usize dispatchCompletions(
+      usize maxCount = std::numeric_limits<usize>::max());
+
+  [[nodiscard]] usize threadCount() const { return m_threads.size(); }
+  [[nodiscard]] AsyncReaderStats stats() const;
+
+private:
+  struct QueueEntry {
+    u8 priority;
+    u64 sequence;
+    std::shared_ptr<detail::AsyncReadRequest> request;
+
+    bool operator<(const QueueEntry &other) const {
+      // Highest priority first, then oldest first
+      if (priority != other.priority) {
+        return priority < other.priority;
+      }
+      return sequence > other.sequence;
+    }
+  };
+
+  struct Completion {
+    std::shared_ptr<detail::AsyncReadSubscriber> subscriber;
+  };
+
+  void workerLoop();
+  void complete(const std::shared_ptr<detail::AsyncReadRequest> &request,
+                Result<SharedBuffer> result);
+
+  ReadFunction m_read;
+  std::vector<std::thread> m_threads;
+
+  mutable std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  std::priority_queue<QueueEntry> m_queue;
+  std::unordered_map<ResourceId, std::shared_ptr<detail::AsyncReadRequest>>
+      m_inFlight;
+  u64 m_nextSequence = 0;
+  bool m_stopping = false;
+
+  std::mutex m_completionMutex;
+  std::deque<Completion> m_completions;
+
+  std::atomic<u64> m_submitted{0};
+  std::atomic<u64> m_deduplicated{0};
+  std::atomic<u64> m_completed{0};
+  std::atomic<u64> m_cancelled{0};
+};
+
+} // namespace NovelMind::VFS
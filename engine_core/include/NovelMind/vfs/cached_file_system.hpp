@@ -1,17 +1,31 @@
 #pragma once
 
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/access_trace.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
-#include <list>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 
 namespace NovelMind::vfs {
 
+/**
+ * @brief Caching decorator over another file system
+ *
+ * Decoded resources are kept in a VFS::ResourceCache; readFileView() hands
+ * out the cached buffer without copying. Views that alias a memory-mapped
+ * pack are passed through uncached, since the mapping already serves them
+ * without a copy.
+ *
+ * readAsync() reads through the same cache on a small pool of I/O threads,
+ * started on first use. mount() and unmount() wait for reads in progress.
+ */
 class CachedFileSystem final : public IVirtualFileSystem {
 public:
   explicit CachedFileSystem(std::unique_ptr<IVirtualFileSystem> inner,
                             usize maxBytes = 64 * 1024 * 1024);
+  ~CachedFileSystem() override;
 
   Result<void> mount(const std::string &packPath) override;
   void unmount(const std::string &packPath) override;
@@ -20,6 +34,18 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  [[nodiscard]] Result<VFS::ResourceView>
+  readFileView(const std::string &resourceId) const override;
+
+  [[nodiscard]] Result<std::unique_ptr<VFS::IFileHandle>>
+  openStream(const std::string &resourceId) const override;
+
+  [[nodiscard]] VFS::AsyncReadHandle
+  readAsync(const std::string &resourceId, VFS::ReadPriority priority,
+            VFS::AsyncReadCallback callback) const override;
+  usize processCompletions(
+      usize maxCount = std::numeric_limits<usize>::max()) override;
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
   [[nodiscard]] std::optional<ResourceInfo>
   getInfo(const std::string &resourceId) const override;
@@ -27,27 +53,35 @@ public:
   [[nodiscard]] std::vector<std::string>
   listResources(ResourceType type = ResourceType::Unknown) const override;
 
+  /**
+   * @brief Report every resource read, cached or not, to @p recorder
+   * (nullptr detaches)
+   *
+   * Saved traces drive the pack layout of the next build; see
+   * access_trace.hpp.
+   */
+  void setTraceRecorder(std::shared_ptr<VFS::AccessTraceRecorder> recorder);
+
   void setMaxBytes(usize maxBytes);
+  void setCachePolicy(VFS::ResourceType type,
+                      const VFS::CacheTypePolicy &policy);
   void clearCache();
 
+  [[nodiscard]] VFS::CacheStats cacheStats() const { return m_cache.stats(); }
+
 private:
-  struct CacheEntry {
-    std::vector<u8> data;
-    usize size = 0;
-  };
-
-  void touch(const std::string &resourceId) const;
-  void evictIfNeeded() const;
-
-  mutable std::unordered_map<std::string,
-                             std::pair<CacheEntry,
-                                       std::list<std::string>::iterator>>
-      m_cache;
-  mutable std::list<std::string> m_lru;
-  mutable usize m_currentBytes = 0;
-  usize m_maxBytes = 0;
+  Result<VFS::SharedBuffer> readShared(const VFS::ResourceId &id) const;
+  void recordRead(const std::string &resourceId, usize bytes) const;
 
+  mutable VFS::ResourceCache m_cache;
   std::unique_ptr<IVirtualFileSystem> m_inner;
+  // I/O threads hold this shared while they read from m_inner
+  mutable std::shared_mutex m_innerMutex;
+  // Started on the first readAsync(); destroyed before m_inner
+  mutable std::mutex m_asyncMutex;
+  mutable std::unique_ptr<VFS::AsyncReader> m_asyncReader;
+  mutable std::mutex m_traceMutex;
+  std::shared_ptr<VFS::AccessTraceRecorder> m_traceRecorder;
 };
 
 } // namespace NovelMind::vfs
@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * @file chunked_resource.hpp
+ * @brief Seekable frame-compressed pack resources
+ *
+ * Large resources (music, video, big data blobs) are split into independent
+ * frames of a fixed decoded size. Every frame is compressed with the entry's
+ * codec and, in encrypted packs, sealed with its own AES-GCM tag, so a stream
+ * can seek anywhere and decode only the frames it touches.
+ *
+ * Stored layout of a chunked entry (little-endian):
+ *
+ *   ChunkTableHeader                 16 bytes
+ *   u64 frameEnd[frameCount]         end of each frame, relative to frame data
+ *   u32 frameCrc[frameCount]         CRC32 of each decoded frame
+ *   frame data
+ *
+ * Encrypted frames use the 8-byte entry IV followed by the little-endian
+ * frame index as their 12-byte GCM nonce, and append the frame index to the
+ * resource AAD.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/file_handle.hpp"
+#include "NovelMind/vfs/mapped_file.hpp"
+#include "NovelMind/vfs/pack_compression.hpp"
+#include "NovelMind/vfs/pack_hash_tree.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+#include "NovelMind/vfs/positional_file.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+struct ChunkTableHeader {
+  u32 magic;
+  u32 frameSize;
+  u32 frameCount;
+  u32 reserved;
+};
+
+class ChunkedResource {
+public:
+  static constexpr u32 kMagic = 0x4B434D4E; // "NMCK"
+  // Entry flag bit; only meaningful in packs flagged ResourceCodecs
+  static constexpr u32 kEntryFlagChunked = 1u << 2;
+  static constexpr u32 kDefaultFrameSize = 128 * 1024;
+  static constexpr u32 kMinFrameSize = 4 * 1024;
+  static constexpr u32 kMaxFrameSize = 1024 * 1024;
+
+  /**
+   * @brief Seals one encoded frame (e.g. AES-GCM); receives the frame index
+   */
+  using FrameSealer =
+      std::function<Result<std::vector<u8>>(u32, std::vector<u8>)>;
+
+  /**
+   * @brief Split @p data into frames and encode them with @p codec
+   */
+  [[nodiscard]] static Result<std::vector<u8>>
+  encode(std::span<const u8> data, PackCompression codec, i32 level = 0,
+         u32 frameSize = kDefaultFrameSize, const FrameSealer &seal = {});
+
+  [[nodiscard]] static std::array<u8, 12> frameIv(const u8 *entryIv,
+                                                  u32 frameIndex);
+  [[nodiscard]] static std::vector<u8>
+  frameAad(const std::vector<u8> &resourceAad, u32 frameIndex);
+};
+
+/**
+ * @brief Location and decoding parameters of one chunked entry
+ */
+struct ChunkedResourceSource {
+  // Exactly one of mapping/file is set
+  std::shared_ptr<const MappedFile> mapping;
+  std::shared_ptr<const PositionalFile> file;
+  u64 offset = 0; // Absolute offset of the stored entry
+  u64 storedSize = 0;
+  u64 uncompressedSize = 0;
+  PackCompression codec = PackCompression::None;
+  // Set for encrypted packs
+  std::optional<PackDecryptor> decryptor;
+  std::array<u8, 8> iv{};
+  std::vector<u8> aad;
+  // Set for MerkleSigned packs; stored bytes are verified before use
+  std::shared_ptr<PackChunkVerifier> verifier;
+};
+
+/**
+ * @brief Random-access stream over a chunked entry
+ *
+ * Keeps the most recently decoded frame, so sequential reads decode each
+ * frame once and seeks cost nothing until the next read. Holds a reference to
+ * the pack's mapping or descriptor and stays valid after the pack closes.
+ */
+class ChunkedFileHandle : public IFileHandle {
+public:
+  [[nodiscard]] static Result<std::unique_ptr<ChunkedFileHandle>>
+  open(ChunkedResourceSource source);
+
+  [[nodiscard]] bool isValid() const override { return true; }
+  [[nodiscard]] usize size() const override;
+  [[nodiscard]] usize position() const override { return m_position; }
+  [[nodiscard]] bool isEof() const override;
+
+  Result<usize> read(u8 *buffer, usize count) override;
+  Result<void> seek(i64 offset, SeekOrigin origin) override;
+
+  [[nodiscard]] u32 frameCount() const {
+    return static_cast<u32>(m_frameEnds.size());
+  }
+  [[nodiscard]] u32 frameSize() const { return m_frameSize; }
+  /// Frames decoded so far, including repeats after eviction
+  [[nodiscard]] u64 framesDecoded() const { return m_framesDecoded; }
+
+private:
+  explicit ChunkedFileHandle(ChunkedResourceSource source);
+
+  Result<void> readTable();
+  Result<std::span<const u8>> storedBytes(u64 offset, u64 size);
+  Result<void> loadFrame(u32 index);
+
+  ChunkedResourceSource m_source;
+  u32 m_frameSize = 0;
+  u64 m_dataStart = 0;
+  std::vector<u64> m_frameEnds;
+  std::vector<u32> m_frameCrcs;
+
+  usize m_position = 0;
+  u32 m_loadedFrame = 0;
+  bool m_hasFrame = false;
+  std::vector<u8> m_frame;
+  std::vector<u8> m_scratch;
+  u64 m_framesDecoded = 0;
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file content_hash.hpp
+ * @brief Fast 128-bit content hash for deduplicating resource payloads
+ *
+ * Not cryptographic: it identifies identical data produced by trusted build
+ * tools (duplicate assets, unchanged resources between packs). Signatures and
+ * integrity checks keep using SHA-256 and CRC32.
+ *
+ * The layout follows XXH3: inputs up to 128 bytes are mixed directly, longer
+ * ones are folded 64 bytes at a time into eight 64-bit lanes with 32x32-bit
+ * multiplies, which map onto SSE2 and NEON.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <array>
+#include <functional>
+#include <span>
+#include <string>
+
+namespace NovelMind::VFS {
+
+struct ContentHash {
+  u64 low = 0;
+  u64 high = 0;
+
+  bool operator==(const ContentHash &other) const {
+    return low == other.low && high == other.high;
+  }
+  bool operator!=(const ContentHash &other) const { return !(*this == other); }
+
+  [[nodiscard]] std::string toHex() const;
+};
+
+/**
+ * @brief Incremental hasher; feeding data in pieces gives the same result as
+ * hashing it at once
+ */
+class ContentHasher {
+public:
+  explicit ContentHasher(u64 seed = 0);
+
+  void update(const void *data, usize size);
+  void update(std::span<const u8> data) { update(data.data(), data.size()); }
+  [[nodiscard]] ContentHash finish() const;
+
+  [[nodiscard]] static ContentHash hash(std::span<const u8> data,
+                                       u64 seed = 0);
+
+  static constexpr usize kStripeSize = 64;
+  static constexpr usize kSecretSize = 192;
+
+private:
+  static constexpr usize kBufferSize = 2 * kStripeSize;
+
+  static void accumulate(std::array<u64, 8> &lanes, const u8 *stripe,
+                         const u8 *secret);
+  void consumeStripe(const u8 *stripe);
+
+  std::array<u64, 8> m_lanes{};
+  std::array<u8, kSecretSize> m_secret{};
+  std::array<u8, kBufferSize> m_buffer{};
+  usize m_buffered = 0;
+  usize m_blockStripe = 0;
+  u64 m_totalSize = 0;
+  u64 m_seed = 0;
+};
+
+} // namespace NovelMind::VFS
+
+namespace std {
+
+template <> struct hash<NovelMind::VFS::ContentHash> {
+  size_t operator()(const NovelMind::VFS::ContentHash &value) const noexcept {
+    return static_cast<size_t>(value.low ^
+                               (value.high * 0x9E3779B97F4A7C15ULL));
+  }
+};
+
+} // namespace std
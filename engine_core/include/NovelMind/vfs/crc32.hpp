@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file crc32.hpp
+ * @brief CRC-32 (IEEE 802.3, as in zlib) with runtime CPU dispatch
+ *
+ * Pack tables, resources and chunk frames are all checked with this CRC on
+ * every read, so it picks the fastest implementation the CPU supports once
+ * at startup: carry-less multiply folding (PCLMULQDQ) on x86, the CRC32
+ * instructions on ARMv8, and slicing-by-16 tables everywhere else. Every
+ * engine produces exactly the same values.
+ */
+
+#include "NovelMind/core/types.hpp"
+
+namespace NovelMind::VFS {
+
+enum class Crc32Engine : u8 {
+  Bytewise,  // One table lookup per byte; the reference
+  Slicing8,  // Eight tables, 8 bytes per step
+  Slicing16, // Sixteen tables, 16 bytes per step
+  Pclmul,    // x86 PCLMULQDQ + SSE4.1 folding, 64 bytes per step
+  ArmCrc     // ARMv8 CRC32 instructions
+};
+
+class Crc32 {
+public:
+  /**
+   * @brief Continue a CRC over @p data
+   *
+   * Same convention as zlib's crc32(): start from 0, and pass the previous
+   * result to extend it.
+   */
+  [[nodiscard]] static u32 update(u32 crc, const void *data, usize size);
+  [[nodiscard]] static u32 compute(const void *data, usize size) {
+    return update(0, data, size);
+  }
+
+  /// update() with a specific engine; unsupported engines use Slicing16
+  [[nodiscard]] static u32 update(Crc32Engine engine, u32 crc,
+                                  const void *data, usize size);
+
+  [[nodiscard]] static bool isSupported(Crc32Engine engine);
+  /// Engine update() uses on this CPU
+  [[nodiscard]] static Crc32Engine activeEngine();
+  [[nodiscard]] static const char *engineName(Crc32Engine engine);
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file directory_backend.hpp
+ * @brief Loose-file backend for development builds
+ *
+ * Serves an asset directory to VirtualFileSystem without going to the OS for
+ * every query: the tree is scanned once (top-level subdirectories in
+ * parallel) and exists()/getInfo()/list() are answered from memory. On Linux
+ * an inotify watcher keeps the tree current as files are edited; elsewhere
+ * call refresh() after changes. Files are opened as positional handles, so
+ * concurrent reads of one file need no locking.
+ *
+ * Resource ids are paths relative to the root with '/' separators, e.g.
+ * "textures/bg.png".
+ */
+
+#include "NovelMind/vfs/file_system_backend.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+class DirectoryBackend : public IFileSystemBackend {
+public:
+  explicit DirectoryBackend(std::string rootPath, u32 priority = 10);
+  ~DirectoryBackend() override;
+
+  DirectoryBackend(const DirectoryBackend &) = delete;
+  DirectoryBackend &operator=(const DirectoryBackend &) = delete;
+
+  [[nodiscard]] std::string name() const override { return "directory"; }
+  [[nodiscard]] u32 priority() const override { return m_priority; }
+
+  [[nodiscard]] std::unique_ptr<IFileHandle>
+  open(const ResourceId &id) override;
+  [[nodiscard]] bool exists(const ResourceId &id) const override;
+  [[nodiscard]] std::optional<ResourceInfo>
+  getInfo(const ResourceId &id) const override;
+  [[nodiscard]] std::vector<ResourceId> list(ResourceType type) const override;
+
+  /// Scans the tree and starts watching it
+  Result<void> initialize() override;
+  void shutdown() override;
+
+  /// Rescan the whole tree, e.g. where no change watcher is available
+  Result<void> refresh();
+
+  /**
+   * @brief Called with each resource the watcher sees added, changed or
+   * removed
+   *
+   * Runs on the watcher thread after the tree has been updated, and from
+   * refresh() for every file. VirtualFileSystem::registerBackend()
+   * installs one that drops the resource from its cache and then calls
+   * VirtualFileSystem::setChangeCallback(); hook hot reloads there.
+   */
+  using ChangeCallback = std::function<void(const ResourceId &)>;
+  void setChangeCallback(ChangeCallback callback);
+
+  /// True while a watcher keeps the tree in sync with the disk
+  [[nodiscard]] bool isWatching() const;
+  /// Incremented on every change applied to the tree
+  [[nodiscard]] u64 changeCount() const {
+    return m_changeCount.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] const std::string &rootPath() const { return m_rootPath; }
+
+private:
+  struct Watcher;
+  using FileMap = std::unordered_map<ResourceId, ResourceInfo>;
+
+  /// Every file below @p relativeDir ("" for the root) and the directories
+  /// visited, relative to the root
+  [[nodiscard]] FileMap scan(const std::string &relativeDir,
+                             std::vector<std::string> *directories) const;
+  [[nodiscard]] std::optional<ResourceInfo>
+  statFile(const std::string &relativePath) const;
+  [[nodiscard]] std::string absolutePath(const std::string &id) const;
+
+  // Applied by the watcher; each returns the ids that changed
+  std::vector<ResourceId> updateFile(const std::string &relativePath);
+  std::vector<ResourceId> removeFile(const std::string &relativePath);
+  std::vector<ResourceId> addDirectory(const std::string &relativeDir);
+  std::vector<ResourceId> removeDirectory(const std::string &relativeDir);
+  void watchLoop();
+  void notifyChanged(const std::vector<ResourceId> &ids);
+
+  std::string m_rootPath;
+  u32 m_priority;
+
+  mutable std::mutex m_mutex;
+  FileMap m_files;
+  ChangeCallback m_changeCallback;
+  std::atomic<u64> m_changeCount{0};
+  std::unique_ptr<Watcher> m_watcher;
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory mapping of pack files
+ *
+ * A MappedFile maps an entire file into the address space once; pack readers
+ * then parse headers and tables in place and hand out zero-copy views of
+ * resource payloads instead of reading them through a stream per request.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <memory>
+#include <span>
+#include <string>
+
+namespace NovelMind::VFS {
+
+class MappedFile {
+public:
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief Map a file read-only
+   *
+   * Shared ownership lets resource views keep the mapping alive after the
+   * pack that created it has been unmounted.
+   */
+  [[nodiscard]] static Result<std::shared_ptr<const MappedFile>>
+  open(const std::string &path);
+
+  [[nodiscard]] const u8 *data() const { return m_data; }
+  [[nodiscard]] usize size() const { return m_size; }
+  [[nodiscard]] const std::string &path() const { return m_path; }
+
+  /**
+   * @brief Bounds-checked sub-range of the mapping
+   * @return Empty span if [offset, offset + length) is outside the file
+   */
+  [[nodiscard]] std::span<const u8> bytes(u64 offset, u64 length) const;
+
+  /**
+   * @brief Hint that a range will be read soon
+   *
+   * The kernel starts paging it in without blocking the caller. The range
+   * is clamped to the file; hints are best-effort and never fail.
+   */
+  void prefetch(u64 offset, u64 length) const;
+
+private:
+  MappedFile() = default;
+
+  std::string m_path;
+  const u8 *m_data = nullptr;
+  usize m_size = 0;
+#if defined(_WIN32)
+  void *m_fileHandle = nullptr;
+  void *m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace NovelMind::VFS
@@ -17,9 +17,11 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/access_trace.hpp"
 #include "NovelMind/vfs/secure_pack_reader.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
 #include <functional>
+#include <list>
 #include <memory>
 #include <set>
 #include <string>
@@ -327,9 +329,36 @@ public:
    * @brief Read a resource (respecting priority)
    * @param resourceId Resource identifier
    * @return Resource data or error
+   *
+   * Delta entries of patch packs are applied to the version in the packs
+   * below them; the rebuilt data is kept in a small cache.
    */
   Result<std::vector<u8>> readResource(const std::string &resourceId);
 
+  /**
+   * @brief Hint that resources are about to be read, e.g. by a scene load
+   *
+   * Each resource's providing pack is asked to fetch it in the background;
+   * see SecurePackReader::prefetch().
+   */
+  void prefetch(const std::vector<std::string> &resourceIds) const;
+
+  /**
+   * @brief Report every resource read to @p recorder (nullptr detaches)
+   *
+   * Saved traces drive the pack layout of the next build; see
+   * access_trace.hpp.
+   */
+  void setTraceRecorder(
+      std::shared_ptr<NovelMind::VFS::AccessTraceRecorder> recorder) {
+    m_traceRecorder = std::move(recorder);
+  }
+
+  /**
+   * @brief Limit on bytes of rebuilt delta resources kept in memory
+   */
+  void setPatchCacheBudget(usize bytes);
+
   /**
    * @brief Check if a resource exists in any loaded pack
    */
@@ -360,6 +389,8 @@ public:
 
   /**
    * @brief Read resource from a specific pack (bypassing priority)
+   *
+   * Delta entries are returned as stored, without applying them.
    */
   Result<std::vector<u8>> readResourceFromPack(const std::string &packId,
                                                const std::string &resourceId);
@@ -430,7 +461,7 @@ private:
   PackLoadResult loadPackInternal(const std::string &path, PackType type,
                                   i32 priority);
   PackInfo readPackManifest(const std::string &path);
-  void rebuildResourceIndex();
+  void rebuildLookupOrder();
   i32 calculateEffectivePriority(PackType type, i32 basePriority) const;
   void firePackLoaded(const PackInfo &info);
   void firePackUnloaded(const std::string &packId);
@@ -441,19 +472,48 @@ private:
   std::string m_packDirectory;
   std::string m_modsDirectory;
 
-  // Loaded packs (ordered by effective priority)
+  // Loaded packs (in load order)
   struct LoadedPack {
     PackInfo info;
-    std::unique_ptr<IVirtualFileSystem> reader;
+    std::unique_ptr<SecurePackFileSystem> reader;
     i32 effectivePriority = 0;
-    std::set<std::string> providedResources;
   };
 
+  /// Highest-priority enabled pack that contains the resource
+  [[nodiscard]] const LoadedPack *
+  findProvider(const std::string &resourceId) const;
+  /// Position in m_lookupOrder of the first pack at or after @p from that
+  /// contains the resource
+  [[nodiscard]] std::optional<size_t>
+  findProviderPosition(const std::string &resourceId, size_t from) const;
+  /// readResource() without trace recording
+  Result<std::vector<u8>> readResolved(const std::string &resourceId);
+  /// Read the resource from the pack at @p position, applying deltas
+  Result<std::vector<u8>> resolveResource(size_t position,
+                                          const std::string &resourceId) const;
+  void clearPatchCache();
+
   std::vector<std::unique_ptr<LoadedPack>> m_packs;
   std::unordered_map<std::string, size_t> m_packIdToIndex;
 
-  // Resource index: resource ID -> pack index
-  std::unordered_map<std::string, size_t> m_resourceIndex;
+  // Enabled packs, highest effective priority first. Lookups probe each
+  // pack's own index in turn, so loading or reordering packs never rebuilds
+  // a merged resource index.
+  std::vector<size_t> m_lookupOrder;
+  // Counted when the lookup order changes, for getResourceCount() and
+  // getOverrideCount()
+  usize m_resourceCount = 0;
+  usize m_overrideCount = 0;
+
+  // Rebuilt delta resources, least recently used at the back
+  struct CachedPatch {
+    std::vector<u8> data;
+    std::list<std::string>::iterator lruPosition;
+  };
+  std::unordered_map<std::string, CachedPatch> m_patchCache;
+  std::list<std::string> m_patchLru;
+  usize m_patchCacheBytes = 0;
+  usize m_patchCacheBudget = 32 * 1024 * 1024;
 
   // Mod load order
   std::vector<std::string> m_modLoadOrder;
@@ -462,6 +522,8 @@ private:
   std::string m_publicKeyPem;
   std::string m_publicKeyPath;
 
+  std::shared_ptr<NovelMind::VFS::AccessTraceRecorder> m_traceRecorder;
+
   // Callbacks
   OnPackLoaded m_onPackLoaded;
   OnPackUnloaded m_onPackUnloaded;
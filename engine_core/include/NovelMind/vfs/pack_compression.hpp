@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file pack_compression.hpp
+ * @brief Per-resource compression codecs for resource packs
+ *
+ * Packs flagged with PackFlags::ResourceCodecs store the codec of every
+ * resource in bits 8-15 of PackResourceEntry::flags, so already-compressed
+ * media can be stored raw while scripts and PCM use zstd and small hot assets
+ * use LZ4 for fast decode. Codecs that were not available at build time
+ * report an error instead of producing garbage.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+enum class PackCompression : u8 { None = 0, Zlib = 1, Zstd = 2, Lz4 = 3 };
+
+class PackCompressor {
+public:
+  static constexpr u32 kEntryCodecShift = 8;
+  static constexpr u32 kEntryCodecMask = 0xFFu << kEntryCodecShift;
+
+  [[nodiscard]] static PackCompression entryCodec(u32 entryFlags) {
+    return static_cast<PackCompression>((entryFlags & kEntryCodecMask) >>
+                                        kEntryCodecShift);
+  }
+  [[nodiscard]] static u32 entryFlags(PackCompression codec) {
+    return static_cast<u32>(codec) << kEntryCodecShift;
+  }
+
+  [[nodiscard]] static bool isAvailable(PackCompression codec);
+  [[nodiscard]] static const char *name(PackCompression codec);
+
+  /**
+   * @brief Compress with a codec-native level (0 selects the codec default)
+   *
+   * For LZ4, levels of 3 and above select the high-compression encoder.
+   */
+  [[nodiscard]] static Result<std::vector<u8>>
+  compress(PackCompression codec, std::span<const u8> data, i32 level = 0);
+
+  /**
+   * @brief Decompress into a buffer of exactly @p uncompressedSize bytes
+   */
+  [[nodiscard]] static Result<std::vector<u8>>
+  decompress(PackCompression codec, std::span<const u8> data,
+             u64 uncompressedSize);
+
+  /**
+   * @brief Decompress into caller memory, which must be filled exactly
+   */
+  [[nodiscard]] static Result<void> decompressInto(PackCompression codec,
+                                                   std::span<const u8> data,
+                                                   std::span<u8> out);
+};
+
+/**
+ * @brief Incremental decoder writing into a caller-owned buffer
+ *
+ * Lets the pack readers hand decrypted blocks straight to the codec instead
+ * of collecting the whole plaintext first. Only codecs with a streaming
+ * format qualify (none, zlib, zstd); LZ4 blocks must be decoded at once.
+ */
+class PackDecompressStream {
+public:
+  [[nodiscard]] static bool supportsStreaming(PackCompression codec);
+
+  /// Start decoding a resource whose uncompressed size is @p out.size()
+  [[nodiscard]] static Result<PackDecompressStream>
+  create(PackCompression codec, std::span<u8> out);
+
+  PackDecompressStream(PackDecompressStream &&other) noexcept;
+  PackDecompressStream &operator=(PackDecompressStream &&other) noexcept;
+  ~PackDecompressStream();
+
+  /// Feed the next piece of compressed input
+  [[nodiscard]] Result<void> write(std::span<const u8> input);
+
+  /// Check that the stream ended exactly at the end of the output
+  [[nodiscard]] Result<void> finish();
+
+  /// Bytes of output written so far, always a prefix of the buffer
+  [[nodiscard]] usize produced() const;
+
+private:
+  struct State;
+
+  explicit PackDecompressStream(std::unique_ptr<State> state);
+
+  std::unique_ptr<State> m_state;
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file pack_delta.hpp
+ * @brief Binary deltas for patch packs
+ *
+ * A patch pack can store a changed resource as a delta against the version in
+ * a lower-priority pack instead of the whole new file. The delta names the
+ * exact base it was made from (content hash and size), so it is only ever
+ * applied to that data:
+ *
+ *   u32 magic "NMDP", u32 version
+ *   ContentHash base, ContentHash target (16 bytes each)
+ *   u64 baseSize, u64 targetSize
+ *   ops until the end of the payload:
+ *     0, zigzag varint offset, varint length   copy from base; the offset is
+ *                                              relative to the end of the
+ *                                              previous copy
+ *     1, varint length, bytes                  insert literal bytes
+ *
+ * Delta entries carry kEntryFlagDelta in PackResourceEntry::flags (packs with
+ * the ResourceCodecs flag only). Pack readers return the delta payload as
+ * stored; MultiPackManager resolves it against the layered packs below.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/content_hash.hpp"
+#include <span>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+struct PackDeltaHeader {
+  ContentHash baseHash;
+  ContentHash targetHash;
+  u64 baseSize = 0;
+  u64 targetSize = 0;
+};
+
+class PackDelta {
+public:
+  static constexpr u32 kMagic = 0x50444D4E; // "NMDP"
+  static constexpr u32 kVersion = 2;
+  static constexpr usize kHeaderSize = 56;
+  static constexpr u32 kEntryFlagDelta = 1u << 3;
+
+  /// Encode @p target as copies from @p base plus inserted bytes
+  [[nodiscard]] static std::vector<u8> create(std::span<const u8> base,
+                                              std::span<const u8> target);
+
+  [[nodiscard]] static Result<PackDeltaHeader>
+  readHeader(std::span<const u8> delta);
+
+  /**
+   * @brief Rebuild the target from its base
+   *
+   * Fails unless @p base is the data the delta was made from and the result
+   * matches the recorded target hash.
+   */
+  [[nodiscard]] static Result<std::vector<u8>>
+  apply(std::span<const u8> base, std::span<const u8> delta);
+};
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file pack_hash_tree.hpp
+ * @brief Signed Merkle tree over a pack's data section
+ *
+ * Hashing a whole pack before it can be used makes mount time grow with the
+ * pack size. Packs flagged MerkleSigned instead carry the SHA-256 of every
+ * fixed-size chunk of the data section plus a signature over the root of the
+ * tree built from them. Mounting checks the tables, the leaves against the
+ * root and the signature; each chunk is hashed the first time a read touches
+ * it. The section sits between the data section and the footer, whose
+ * reserved bytes hold its offset:
+ *
+ *   u32 magic "NMHT", u32 version, u32 chunkSize, u32 reserved
+ *   u64 dataOffset, u64 dataSize     data section the leaves cover
+ *   u8 tablesHash[32]                SHA-256 of pack bytes [0, dataOffset)
+ *   u8 root[32]                      Merkle root of the leaves
+ *   u8 leaves[chunkCount][32]        SHA-256 of each chunk
+ *   u32 signatureSize, signature     RSA/SHA-256 over the 96 header bytes
+ *
+ * Inner nodes are SHA-256(0x01 || left || right); an odd node at the end of
+ * a level moves up unchanged.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/mapped_file.hpp"
+#include "NovelMind/vfs/positional_file.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+using Sha256Digest = std::array<u8, 32>;
+
+class PackHashTree {
+public:
+  static constexpr u32 kMagic = 0x54484D4E; // "NMHT"
+  static constexpr u32 kVersion = 1;
+  static constexpr usize kHeaderSize = 96;
+  static constexpr u32 kDefaultChunkSize = 256 * 1024;
+  static constexpr u32 kMinChunkSize = 4 * 1024;
+  static constexpr u32 kMaxChunkSize = 16 * 1024 * 1024;
+  // Offset within the pack footer of the u64 section offset
+  static constexpr usize kFooterOffsetField = 20;
+
+  PackHashTree() = default;
+
+  /// Digest of every @p chunkSize piece of @p data; the last may be shorter
+  [[nodiscard]] static std::vector<Sha256Digest>
+  hashChunks(std::span<const u8> data, u32 chunkSize);
+
+  [[nodiscard]] static Sha256Digest
+  computeRoot(std::span<const Sha256Digest> leaves);
+
+  /**
+   * @brief Header and leaves of a section, ready for sign()
+   * @param tablesHash SHA-256 of the finished pack bytes [0, dataOffset)
+   */
+  [[nodiscard]] static std::vector<u8>
+  buildSection(u64 dataOffset, u64 dataSize, u32 chunkSize,
+               const Sha256Digest &tablesHash,
+               std::span<const Sha256Digest> leaves);
+
+  /// Sign the section header and append the signature (needs OpenSSL)
+  [[nodiscard]] static Result<void> sign(std::vector<u8> &section,
+                                         const std::string &privateKeyPem);
+
+  /**
+   * @brief Parse a section and check its leaves against the root
+   *
+   * The signature is not checked here; it covers headerBytes().
+   */
+  [[nodiscard]] static Result<PackHashTree>
+  parse(std::span<const u8> section);
+
+  [[nodiscard]] u64 dataOffset() const { return m_dataOffset; }
+  [[nodiscard]] u64 dataSize() const { return m_dataSize; }
+  [[nodiscard]] u32 chunkSize() const { return m_chunkSize; }
+  [[nodiscard]] u32 chunkCount() const {
+    return static_cast<u32>(m_leaves.size());
+  }
+  [[nodiscard]] const Sha256Digest &tablesHash() const { return m_tablesHash; }
+  [[nodiscard]] const Sha256Digest &root() const { return m_root; }
+  [[nodiscard]] const Sha256Digest &leaf(u32 index) const {
+    return m_leaves[index];
+  }
+  [[nodiscard]] std::span<const u8> headerBytes() const { return m_header; }
+  [[nodiscard]] std::span<const u8> signature() const { return m_signature; }
+
+private:
+  std::array<u8, kHeaderSize> m_header{};
+  u64 m_dataOffset = 0;
+  u64 m_dataSize = 0;
+  u32 m_chunkSize = 0;
+  Sha256Digest m_tablesHash{};
+  Sha256Digest m_root{};
+  std::vector<Sha256Digest> m_leaves;
+  std::vector<u8> m_signature;
+};
+
+/**
+ * @brief Verifies data chunks of a MerkleSigned pack on first use
+ *
+ * Shared between the pack reader and the streams it opens. Chunk states are
+ * atomic, so any number of threads may verify at once; a chunk hashed twice
+ * by racing readers is merely wasted work. A chunk that fails stays failed.
+ */
+class PackChunkVerifier {
+public:
+  PackChunkVerifier(PackHashTree tree,
+                    std::shared_ptr<const MappedFile> mapping,
+                    std::shared_ptr<const PositionalFile> file);
+
+  /// Verify every chunk overlapping [offset, offset + size) of the pack file
+  [[nodiscard]] Result<void> verifyRange(u64 offset, u64 size);
+
+  /**
+   * @brief Verify all chunks not yet verified, in file order
+   * @param stop Checked between chunks; set it to abandon the pass
+   */
+  [[nodiscard]] Result<void>
+  verifyAll(const std::atomic<bool> *stop = nullptr);
+
+  [[nodiscard]] u32 chunkCount() const { return m_tree.chunkCount(); }
+  [[nodiscard]] u32 verifiedCount() const {
+    return m_verified.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool hasFailed() const {
+    return m_failed.load(std::memory_order_relaxed);
+  }
+
+private:
+  enum : u8 { kUnverified = 0, kVerified = 1, kFailed = 2 };
+
+  [[nodiscard]] Result<void> verifyChunk(u32 index);
+
+  PackHashTree m_tree;
+  std::shared_ptr<const MappedFile> m_mapping;
+  std::shared_ptr<const PositionalFile> m_file;
+  std::unique_ptr<std::atomic<u8>[]> m_states;
+  std::atomic<u32> m_verified{0};
+  std::atomic<bool> m_failed{false};
+};
+
+} // namespace NovelMind::VFS
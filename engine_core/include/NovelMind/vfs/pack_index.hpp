@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file pack_index.hpp
+ * @brief On-disk minimal perfect hash index over a pack's resource ids
+ *
+ * The index lets a reader resolve an id to its resource table slot straight
+ * from the mapped (or loaded) table bytes, so mounting a pack no longer builds
+ * a hash map over every id. The section sits between the string table and the
+ * data section, so the footer CRC and signatures cover it:
+ *
+ *   u32 magic "NMIX", u32 version, u32 entryCount, u32 bucketCount, u64 seed
+ *   u32 pilots[bucketCount]       per-bucket displacement
+ *   u32 slots[entryCount]         hash slot -> resource table index
+ *   u32 sectionSize, u32 magic    trailer ending exactly at dataOffset
+ *
+ * A lookup hashes the id once, picks its bucket's pilot to get a slot and
+ * returns the entry stored there. Ids that are not in the pack still land on
+ * some slot, so callers must compare the entry's id before using it.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+class PackHashIndex {
+public:
+  static constexpr u32 kMagic = 0x58494D4E; // "NMIX"
+  static constexpr u32 kVersion = 2;
+  static constexpr usize kHeaderSize = 24;
+  static constexpr usize kTrailerSize = 8;
+
+  PackHashIndex() = default;
+
+  /**
+   * @brief Build the index section for ids in resource table order
+   *
+   * Fails if an id appears twice, since it could never be told apart.
+   */
+  [[nodiscard]] static Result<std::vector<u8>>
+  build(std::span<const std::string_view> ids);
+
+  /**
+   * @brief View the index stored at the end of a pack's table bytes
+   * @param tables Pack bytes from offset 0 up to the data section
+   * @param entryCount Resource count from the pack header
+   *
+   * The returned index aliases @p tables, which must outlive it.
+   */
+  [[nodiscard]] static Result<PackHashIndex> open(std::span<const u8> tables,
+                                                  u32 entryCount);
+
+  /// Resource table index the id would occupy, if the id is in the pack
+  [[nodiscard]] std::optional<u32> find(std::string_view id) const;
+
+  [[nodiscard]] u32 entryCount() const { return m_entryCount; }
+  [[nodiscard]] usize sectionSize() const { return m_sectionSize; }
+
+private:
+  [[nodiscard]] u32 slotFor(u64 hash, u32 pilot) const;
+  [[nodiscard]] u32 bucketFor(u64 hash) const;
+
+  const u8 *m_pilots = nullptr;
+  const u8 *m_slots = nullptr;
+  u64 m_seed = 0;
+  u32 m_entryCount = 0;
+  u32 m_bucketCount = 0;
+  usize m_sectionSize = 0;
+};
+
+} // namespace NovelMind::VFS
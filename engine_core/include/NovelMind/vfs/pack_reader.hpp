@@ -1,9 +1,18 @@
 #pragma once
 
+#include "NovelMind/vfs/chunked_resource.hpp"
+#include "NovelMind/vfs/mapped_file.hpp"
+#include "NovelMind/vfs/pack_compression.hpp"
+#include "NovelMind/vfs/pack_index.hpp"
+#include "NovelMind/vfs/positional_file.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
-#include <fstream>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <span>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace NovelMind::vfs {
 
@@ -39,14 +48,33 @@ enum class PackFlags : u32 {
   None = 0,
   Encrypted = 1 << 0,
   Compressed = 1 << 1,
-  Signed = 1 << 2
+  Signed = 1 << 2,
+  // Per-resource codec and chunked layout in PackResourceEntry::flags
+  // (see pack_compression.hpp and chunked_resource.hpp)
+  ResourceCodecs = 1 << 3,
+  // A PackHashIndex section ends the tables (see pack_index.hpp)
+  HashIndex = 1 << 4,
+  // Signed Merkle tree over the data section (see pack_hash_tree.hpp)
+  MerkleSigned = 1 << 5
 };
 
+/**
+ * @brief How mounted packs are accessed
+ *
+ * MemoryMapped maps the whole pack once and parses tables in place; it falls
+ * back to Stream if the platform refuses the mapping. Stream keeps one file
+ * descriptor per pack open and serves reads with positional I/O.
+ */
+enum class PackAccessMode : u8 { Stream, MemoryMapped };
+
 class PackReader : public IVirtualFileSystem {
 public:
-  PackReader() = default;
+  explicit PackReader(PackAccessMode mode = PackAccessMode::MemoryMapped);
   ~PackReader() override;
 
+  void setAccessMode(PackAccessMode mode) { m_accessMode = mode; }
+  [[nodiscard]] PackAccessMode accessMode() const { return m_accessMode; }
+
   Result<void> mount(const std::string &packPath) override;
   void unmount(const std::string &packPath) override;
   void unmountAll() override;
@@ -54,6 +82,23 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  /**
+   * @brief Zero-copy read for memory-mapped packs
+   *
+   * The returned view shares ownership of the mapping, so it stays valid
+   * after the pack is unmounted.
+   */
+  [[nodiscard]] Result<VFS::ResourceView>
+  readFileView(const std::string &resourceId) const override;
+
+  /**
+   * @brief Seekable stream; chunked resources decode only the frames read
+   */
+  [[nodiscard]] Result<std::unique_ptr<VFS::IFileHandle>>
+  openStream(const std::string &resourceId) const override;
+
+  [[nodiscard]] bool isMemoryMapped(const std::string &packPath) const;
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
 
   [[nodiscard]] std::optional<ResourceInfo>
@@ -66,20 +111,63 @@ private:
   struct MountedPack {
     std::string path;
     PackHeader header;
-    std::unordered_map<std::string, PackResourceEntry> entries;
-    std::vector<std::string> stringTable;
+    u64 fileSize = 0;
+    // Set when the pack is memory-mapped; entries and ids then alias it
+    std::shared_ptr<const VFS::MappedFile> mapping;
+    // Set for streamed packs; shared by all concurrent readers
+    std::shared_ptr<const VFS::PositionalFile> file;
+    // Header and tables of a streamed pack, parsed in place like a mapping
+    std::vector<u8> tableStorage;
+    // Copy of the resource table when it is misaligned in the source bytes
+    std::vector<PackResourceEntry> entryStorage;
+    const PackResourceEntry *table = nullptr;
+    // In-place string table: offsets of ids and the bytes they point into
+    std::span<const u8> stringOffsets;
+    std::span<const u8> stringData;
+    // Packs built with a hash index are looked up through it; older packs
+    // get an id map built at mount
+    std::optional<VFS::PackHashIndex> index;
+    std::unordered_map<std::string_view, const PackResourceEntry *> entries;
   };
 
-  Result<void> readPackHeader(std::ifstream &file, PackHeader &header);
-  Result<void> readResourceTable(std::ifstream &file, MountedPack &pack);
-  Result<void> readStringTable(std::ifstream &file, MountedPack &pack);
-
-  [[nodiscard]] Result<std::vector<u8>>
-  readResourceData(const std::string &packPath,
-                   const PackResourceEntry &entry) const;
-
-  mutable std::mutex m_mutex;
-  std::unordered_map<std::string, MountedPack> m_packs;
+  /**
+   * Mounted packs in mount order. The list is immutable once published:
+   * mount/unmount build a new list under m_writeMutex and swap it in, so
+   * lookups and reads never take a lock and keep the packs they found alive
+   * until they finish.
+   */
+  using PackList = std::vector<std::shared_ptr<const MountedPack>>;
+
+  Result<void> openStreamedPack(MountedPack &pack);
+  static Result<void> parsePackTables(MountedPack &pack,
+                                      std::span<const u8> bytes);
+  static Result<void> validateHeader(const PackHeader &header);
+  [[nodiscard]] static const PackResourceEntry *
+  findEntry(const MountedPack &pack, std::string_view resourceId);
+  [[nodiscard]] static std::optional<std::string_view>
+  entryId(const MountedPack &pack, const PackResourceEntry &entry);
+
+  [[nodiscard]] static Result<std::vector<u8>>
+  readEntry(const std::shared_ptr<const MountedPack> &pack,
+            const PackResourceEntry &entry);
+  [[nodiscard]] static Result<std::vector<u8>>
+  readResourceData(const MountedPack &pack, const PackResourceEntry &entry);
+  [[nodiscard]] static Result<std::span<const u8>>
+  mappedResourceBytes(const MountedPack &pack, const PackResourceEntry &entry);
+  [[nodiscard]] static VFS::PackCompression
+  resourceCodec(const MountedPack &pack, const PackResourceEntry &entry);
+  [[nodiscard]] static bool isChunked(const MountedPack &pack,
+                                      const PackResourceEntry &entry);
+  [[nodiscard]] static Result<std::unique_ptr<VFS::ChunkedFileHandle>>
+  openChunkedStream(const std::shared_ptr<const MountedPack> &pack,
+                    const PackResourceEntry &entry);
+  [[nodiscard]] static Result<std::vector<u8>>
+  decodeResourceData(const MountedPack &pack, const PackResourceEntry &entry,
+                     std::span<const u8> stored);
+
+  PackAccessMode m_accessMode;
+  std::mutex m_writeMutex;
+  std::atomic<std::shared_ptr<const PackList>> m_packs;
 };
 
 } // namespace NovelMind::vfs
@@ -2,11 +2,22 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/file_handle.hpp"
+#include "NovelMind/vfs/mapped_file.hpp"
+#include "NovelMind/vfs/pack_compression.hpp"
+#include "NovelMind/vfs/pack_hash_tree.hpp"
+#include "NovelMind/vfs/pack_index.hpp"
+#include "NovelMind/vfs/positional_file.hpp"
+#include "NovelMind/vfs/resource_view.hpp"
 #include <array>
+#include <atomic>
 #include <iosfwd>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +50,8 @@ struct PackResourceMeta {
   u32 type = 0;
   u64 uncompressedSize = 0;
   u32 checksum = 0;
+  // Stored as a PackDelta against a lower-priority pack
+  bool delta = false;
 };
 
 class PackIntegrityChecker {
@@ -92,7 +105,53 @@ public:
   [[nodiscard]] Result<std::vector<u8>> decrypt(const u8 *data, usize size,
                                                 const u8 *iv, usize ivSize,
                                                 const u8 *aad,
-                                                usize aadSize);
+                                                usize aadSize) const;
+
+  /**
+   * @brief Decrypt ciphertext followed by its tag into @p out
+   *
+   * @p out needs room for size - 16 bytes and may be @p data itself, which
+   * decrypts in place. On failure its contents are unspecified.
+   * @return Plaintext size
+   */
+  [[nodiscard]] Result<usize> decryptInto(const u8 *data, usize size,
+                                          const u8 *iv, usize ivSize,
+                                          const u8 *aad, usize aadSize,
+                                          u8 *out) const;
+
+  /**
+   * @brief AES-GCM decryption fed in blocks of any size
+   *
+   * Plaintext is not authenticated until finish() accepts the tag; whatever
+   * was written from it must be discarded if that fails.
+   */
+  class Stream {
+  public:
+    Stream(Stream &&other) noexcept;
+    Stream &operator=(Stream &&other) noexcept;
+    ~Stream();
+
+    /// Decrypt @p size bytes; @p out may be @p in
+    [[nodiscard]] Result<void> update(const u8 *in, u8 *out, usize size);
+    /// Check the 16-byte tag that ends the ciphertext
+    [[nodiscard]] Result<void> finish(const u8 *tag);
+
+  private:
+    friend class PackDecryptor;
+    struct State;
+
+    Stream();
+
+    // Opaque so the layout does not depend on how OpenSSL was found
+    std::unique_ptr<State> m_state;
+  };
+
+  [[nodiscard]] Result<Stream> beginStream(const u8 *iv, usize ivSize,
+                                           const u8 *aad,
+                                           usize aadSize) const;
+
+  /// Size of the authentication tag that ends every ciphertext
+  static constexpr usize kTagSize = 16;
 
   [[nodiscard]] static Result<std::vector<u8>>
   deriveKey(const std::string &password, const u8 *salt, usize saltSize);
@@ -100,6 +159,12 @@ public:
   [[nodiscard]] static Result<std::vector<u8>>
   generateRandomIV(usize size = 16);
 
+  /**
+   * @brief AAD binding a resource's ciphertext to its id, type and size
+   */
+  [[nodiscard]] static std::vector<u8>
+  resourceAad(std::string_view resourceId, u32 type, u64 uncompressedSize);
+
 private:
   std::vector<u8> m_key;
 };
@@ -107,29 +172,127 @@ private:
 class SecurePackReader {
 public:
   SecurePackReader() = default;
-  ~SecurePackReader() = default;
+  ~SecurePackReader();
 
   void setDecryptor(std::unique_ptr<PackDecryptor> decryptor);
   void setIntegrityChecker(std::unique_ptr<PackIntegrityChecker> checker);
   Result<void> setPublicKeyPem(const std::string &pem);
   Result<void> setPublicKeyFromFile(const std::string &path);
 
+  /**
+   * @brief Map packs into memory instead of streaming them (default on)
+   *
+   * Takes effect on the next openPack(). Falls back to streaming if the
+   * mapping cannot be created.
+   */
+  void setUseMemoryMapping(bool enabled) { m_useMemoryMapping = enabled; }
+  [[nodiscard]] bool isMemoryMapped() const { return m_mapping != nullptr; }
+
   [[nodiscard]] Result<void> openPack(const std::string &path);
   void closePack();
 
+  /**
+   * @brief Bytes to read ahead when reads move forward through the pack
+   *
+   * A read that starts at or just past where the previous one ended (as
+   * scene loads do in packs laid out from access traces) asks the OS to
+   * fetch this much of what follows in the background. 0 disables it.
+   */
+  void setReadAhead(u64 bytes) { m_readAhead = bytes; }
+
+  /**
+   * @brief Hint that these resources are about to be read
+   *
+   * Their stored ranges are sorted and nearby ones merged, so the OS sees a
+   * few sequential requests. Returns immediately; unknown ids are ignored.
+   */
+  void prefetch(std::span<const std::string> resourceIds) const;
+
+  static constexpr u64 kDefaultReadAhead = 1024 * 1024;
+  /// Ranges this close together are read as one
+  static constexpr u64 kPrefetchMergeGap = 64 * 1024;
+
   [[nodiscard]] Result<std::vector<u8>>
   readResource(const std::string &resourceId);
 
+  /**
+   * @brief Decode a resource into caller memory, such as a staging buffer
+   *
+   * Encrypted and compressed data is decrypted block by block and fed to the
+   * decompressor, which writes straight into @p destination, so no buffer
+   * the size of the resource is allocated. Sizes come from
+   * getResourceMeta(). On error the contents of @p destination are
+   * unspecified and may hold unauthenticated data.
+   * @return Bytes written, the resource's uncompressed size
+   */
+  [[nodiscard]] Result<usize> readResourceInto(const std::string &resourceId,
+                                               std::span<u8> destination);
+
+  /**
+   * @brief Decode only the start of a resource, e.g. a format header
+   *
+   * Stored data is read and decoded a small block at a time until
+   * @p destination is full. In signed packs every chunk read is verified
+   * against the hash tree first; the resource checksum, which covers the
+   * whole resource, is not checked. Encrypted resources are authenticated
+   * only as a whole, and LZ4 resources decode in one piece, so both are
+   * read whole.
+   * @return Bytes written, less than requested for shorter resources
+   */
+  [[nodiscard]] Result<usize> readResourcePrefix(const std::string &resourceId,
+                                                 std::span<u8> destination);
+
+  /**
+   * @brief Read a resource as a ref-counted view
+   *
+   * Plain (unencrypted, uncompressed) resources of a mapped pack are returned
+   * without copying; everything else is decoded into an owned buffer.
+   */
+  [[nodiscard]] Result<ResourceView>
+  readResourceView(const std::string &resourceId);
+
+  /**
+   * @brief Open a resource as a seekable stream
+   *
+   * Chunked resources decode only the frames that are read; other resources
+   * are decoded up front into a memory handle.
+   */
+  [[nodiscard]] Result<std::unique_ptr<IFileHandle>>
+  openResourceStream(const std::string &resourceId);
+
   [[nodiscard]] bool isOpen() const { return m_isOpen; }
   [[nodiscard]] PackVerificationResult lastVerificationResult() const {
     return m_lastResult;
   }
   [[nodiscard]] bool exists(const std::string &resourceId) const;
   [[nodiscard]] std::vector<std::string> listResources() const;
+  [[nodiscard]] usize resourceCount() const;
+  /// True when the open pack carries a hash index and skipped the id map
+  [[nodiscard]] bool hasHashIndex() const { return m_index.has_value(); }
   [[nodiscard]] std::optional<PackResourceMeta>
   getResourceMeta(const std::string &resourceId) const;
   [[nodiscard]] u32 packFlags() const { return m_header.flags; }
 
+  /// True when the open pack is MerkleSigned and reads verify chunks lazily
+  [[nodiscard]] bool hasHashTree() const { return m_verifier != nullptr; }
+
+  struct VerificationProgress {
+    u32 verifiedChunks = 0;
+    u32 totalChunks = 0;
+    bool failed = false;
+    bool running = false;
+  };
+
+  /**
+   * @brief Verify every chunk of a MerkleSigned pack on a background thread
+   *
+   * The thread runs at idle I/O and CPU priority where the platform allows
+   * it. Reads meanwhile keep verifying what they touch, and chunks either
+   * side verifies are not hashed again. closePack() stops the thread.
+   */
+  [[nodiscard]] Result<void> startBackgroundVerification();
+  [[nodiscard]] VerificationProgress verificationProgress() const;
+
 private:
   struct PackHeader {
     u32 magic;
@@ -163,14 +326,60 @@ private:
     u8 reserved[12];
   };
 
+  [[nodiscard]] const PackResourceEntry *
+  findEntry(std::string_view resourceId) const;
+  [[nodiscard]] std::optional<std::string_view>
+  entryId(const PackResourceEntry &entry) const;
+  [[nodiscard]] Result<std::vector<u8>>
+  readStoredBytes(const PackResourceEntry &entry) const;
+  [[nodiscard]] Result<void> decodeInto(const std::string &resourceId,
+                                        const PackResourceEntry &entry,
+                                        std::span<u8> out) const;
+  [[nodiscard]] PackCompression
+  resourceCodec(const PackResourceEntry &entry) const;
+  [[nodiscard]] bool isChunked(const PackResourceEntry &entry) const;
+  [[nodiscard]] Result<std::unique_ptr<IFileHandle>>
+  openChunkedStream(const std::string &resourceId,
+                    const PackResourceEntry &entry) const;
+  [[nodiscard]] static Result<void>
+  verifyDecoded(const PackResourceEntry &entry, std::span<const u8> data);
+  [[nodiscard]] Result<void> verifyStored(const PackResourceEntry &entry) const;
+  void prefetchRange(u64 offset, u64 length) const;
+  void noteRead(const PackResourceEntry &entry) const;
+  [[nodiscard]] Result<PackHashTree>
+  openHashTree(std::ifstream &file, const u8 *tables, u64 dataEnd);
+  void stopBackgroundVerification();
+
   std::unique_ptr<PackDecryptor> m_decryptor;
   std::unique_ptr<PackIntegrityChecker> m_integrityChecker;
   std::string m_packPath;
   PackHeader m_header{};
   PackFooter m_footer{};
   u64 m_fileSize = 0;
-  std::unordered_map<std::string, PackResourceEntry> m_entries;
-  std::vector<std::string> m_stringTable;
+  bool m_useMemoryMapping = true;
+  std::shared_ptr<const MappedFile> m_mapping;
+  // Open for the lifetime of a streamed pack; serves positional reads
+  std::shared_ptr<const PositionalFile> m_file;
+  // Header and tables of a streamed pack; mapped packs are parsed in place
+  std::vector<u8> m_tableStorage;
+  // Copy of the resource table when it is not aligned for in-place access
+  std::vector<PackResourceEntry> m_entryStorage;
+  // Tables viewed in place, for id lookups through the hash index
+  const PackResourceEntry *m_table = nullptr;
+  const u8 *m_stringOffsets = nullptr;
+  u32 m_stringCount = 0;
+  std::span<const u8> m_stringData;
+  std::optional<PackHashIndex> m_index;
+  // Id map of packs without a hash index
+  std::unordered_map<std::string_view, const PackResourceEntry *> m_entries;
+  // Chunk verification of MerkleSigned packs, shared with chunked streams
+  std::shared_ptr<PackChunkVerifier> m_verifier;
+  std::thread m_verifyThread;
+  std::atomic<bool> m_stopVerification{false};
+  std::atomic<bool> m_verifying{false};
+  u64 m_readAhead = kDefaultReadAhead;
+  // End of the last read's stored range, for spotting forward runs
+  mutable std::atomic<u64> m_lastReadEnd{0};
   bool m_isOpen = false;
   PackVerificationResult m_lastResult = PackVerificationResult::Valid;
 };
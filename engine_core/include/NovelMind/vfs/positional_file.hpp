@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file positional_file.hpp
+ * @brief Long-lived read-only file descriptor with positional reads
+ *
+ * Streamed packs keep one PositionalFile open for as long as they are
+ * mounted. readAt() does not touch a shared file offset, so any number of
+ * threads can read from the same descriptor without locking.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/file_handle.hpp"
+#include <memory>
+#include <string>
+
+namespace NovelMind::VFS {
+
+class PositionalFile {
+public:
+  ~PositionalFile();
+
+  PositionalFile(const PositionalFile &) = delete;
+  PositionalFile &operator=(const PositionalFile &) = delete;
+
+  [[nodiscard]] static Result<std::shared_ptr<const PositionalFile>>
+  open(const std::string &path);
+
+  [[nodiscard]] u64 size() const { return m_size; }
+  [[nodiscard]] const std::string &path() const { return m_path; }
+
+  /**
+   * @brief Read exactly @p size bytes starting at @p offset
+   *
+   * Thread-safe; short reads caused by EOF are reported as errors.
+   */
+  Result<void> readAt(u64 offset, u8 *dest, usize size) const;
+
+  /**
+   * @brief Hint that a range will be read soon
+   *
+   * Starts asynchronous read-ahead into the page cache where the platform
+   * offers it (posix_fadvise); a no-op elsewhere. Never fails.
+   */
+  void prefetch(u64 offset, u64 length) const;
+
+private:
+  PositionalFile() = default;
+
+  std::string m_path;
+  u64 m_size = 0;
+#if defined(_WIN32)
+  void *m_handle = nullptr;
+#else
+  int m_fd = -1;
+#endif
+};
+
+/**
+ * @brief Stream over a whole PositionalFile
+ *
+ * Each handle keeps its own position and reads with readAt(), so handles
+ * sharing one file never contend on a file offset.
+ */
+class PositionalFileHandle : public IFileHandle {
+public:
+  explicit PositionalFileHandle(std::shared_ptr<const PositionalFile> file);
+
+  [[nodiscard]] bool isValid() const override { return m_file != nullptr; }
+  [[nodiscard]] usize size() const override { return m_size; }
+  [[nodiscard]] usize position() const override { return m_position; }
+  [[nodiscard]] bool isEof() const override { return m_position >= m_size; }
+
+  Result<usize> read(u8 *buffer, usize count) override;
+  Result<void> seek(i64 offset, SeekOrigin origin) override;
+
+private:
+  std::shared_ptr<const PositionalFile> m_file;
+  usize m_size = 0;
+  usize m_position = 0;
+};
+
+} // namespace NovelMind::VFS
@@ -1,20 +1,57 @@
 #pragma once
 
+/**
+ * @file resource_cache.hpp
+ * @brief Sharded, byte-bounded cache of immutable resource buffers
+ *
+ * Cached bytes are held as shared immutable buffers, so a hit hands out a
+ * reference instead of copying. Entries are spread over independently locked
+ * shards by ResourceId::hash().
+ *
+ * Admission follows W-TinyLFU: new entries land in a small window region and,
+ * once they age out of it, only enter the main region if a frequency sketch
+ * says they are requested more often than the entries they would displace.
+ * Larger entries must beat more victims, so one-off bulky assets (a gallery
+ * pass, skipped CGs) cannot flush hot UI textures and SFX. Both regions use
+ * the CLOCK (second-chance) approximation of LRU, so a hit only sets a
+ * reference bit.
+ */
+
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/vfs/resource_id.hpp"
-#include <chrono>
-#include <list>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace NovelMind::VFS {
 
-struct CacheEntry {
-  std::vector<u8> data;
-  std::chrono::steady_clock::time_point lastAccess;
-  usize accessCount = 0;
+using SharedBuffer = std::shared_ptr<const std::vector<u8>>;
+
+inline constexpr usize kResourceTypeCount =
+    static_cast<usize>(ResourceType::Config) + 1;
+
+struct CacheTypeStats {
+  usize hitCount = 0;
+  usize missCount = 0;
+  u64 hitBytes = 0;
+  // Bytes of entries that had to be put() because they were not cached
+  u64 missBytes = 0;
+  usize rejectedCount = 0;
+
+  [[nodiscard]] f64 hitRate() const {
+    const auto total = hitCount + missCount;
+    return total > 0 ? static_cast<f64>(hitCount) / static_cast<f64>(total)
+                     : 0.0;
+  }
+  [[nodiscard]] f64 byteHitRate() const {
+    const auto total = hitBytes + missBytes;
+    return total > 0 ? static_cast<f64>(hitBytes) / static_cast<f64>(total)
+                     : 0.0;
+  }
 };
 
 struct CacheStats {
@@ -23,51 +60,170 @@ struct CacheStats {
   usize hitCount = 0;
   usize missCount = 0;
   usize evictionCount = 0;
+  // Window entries that lost the frequency comparison against main entries
+  usize rejectedCount = 0;
+  u64 hitBytes = 0;
+  u64 missBytes = 0;
+  std::array<CacheTypeStats, kResourceTypeCount> byType{};
 
   [[nodiscard]] f64 hitRate() const {
     const auto total = hitCount + missCount;
     return total > 0 ? static_cast<f64>(hitCount) / static_cast<f64>(total)
                      : 0.0;
   }
+  [[nodiscard]] f64 byteHitRate() const {
+    const auto total = hitBytes + missBytes;
+    return total > 0 ? static_cast<f64>(hitBytes) / static_cast<f64>(total)
+                     : 0.0;
+  }
+  [[nodiscard]] const CacheTypeStats &forType(ResourceType type) const {
+    return byType[static_cast<usize>(type) % kResourceTypeCount];
+  }
+};
+
+/**
+ * @brief Per-ResourceType admission settings
+ */
+struct CacheTypePolicy {
+  // Never cache resources of this type
+  bool cacheable = true;
+  // Skip the window and the frequency filter (e.g. tiny, always-hot data)
+  bool bypassAdmission = false;
+  // Larger entries are not cached; 0 means only the cache size applies
+  usize maxEntrySize = 0;
+  // Scales sketch frequency when competing for space; > 1 favours the type
+  f32 frequencyWeight = 1.0f;
+};
+
+/**
+ * @brief Count-min sketch of recent access frequency
+ *
+ * Four rows of saturating 4-bit counters. All counters are halved after a
+ * sample of accesses, so the estimate tracks recent popularity.
+ */
+class CacheFrequencySketch {
+public:
+  explicit CacheFrequencySketch(usize width = 1024);
+
+  void increment(u64 hash);
+  [[nodiscard]] u32 frequency(u64 hash) const;
+  void clear();
+
+private:
+  static constexpr usize kDepth = 4;
+  static constexpr u8 kMaxCount = 15;
+
+  [[nodiscard]] usize indexOf(u64 hash, usize row) const;
+  void age();
+
+  std::vector<u8> m_counters;
+  usize m_mask = 0;
+  usize m_additions = 0;
+  usize m_sampleSize = 0;
 };
 
 class ResourceCache {
 public:
-  explicit ResourceCache(usize maxSize = 64 * 1024 * 1024);
-  ~ResourceCache() = default;
+  static constexpr usize kDefaultShardCount = 16;
+  static constexpr f32 kDefaultWindowFraction = 0.01f;
+
+  explicit ResourceCache(usize maxSize = 64 * 1024 * 1024,
+                         usize shardCount = kDefaultShardCount);
+  ~ResourceCache();
 
   ResourceCache(const ResourceCache &) = delete;
   ResourceCache &operator=(const ResourceCache &) = delete;
 
   void setMaxSize(usize maxSize);
-  [[nodiscard]] usize maxSize() const { return m_maxSize; }
+  [[nodiscard]] usize maxSize() const {
+    return m_maxSize.load(std::memory_order_relaxed);
+  }
 
-  [[nodiscard]] std::optional<std::vector<u8>> get(const ResourceId &id);
-  void put(const ResourceId &id, std::vector<u8> data);
+  /**
+   * @brief Share of the budget given to the admission window (0..0.5)
+   */
+  void setWindowFraction(f32 fraction);
+  void setTypePolicy(ResourceType type, const CacheTypePolicy &policy);
+  [[nodiscard]] CacheTypePolicy typePolicy(ResourceType type) const;
+
+  /**
+   * @brief Shared handle to the cached bytes, or nullptr on a miss
+   */
+  [[nodiscard]] SharedBuffer get(const ResourceId &id);
+
+  /**
+   * @brief Offer @p data to the cache and return the shared handle to it
+   *
+   * The handle is returned even when the buffer is not admitted.
+   */
+  SharedBuffer put(const ResourceId &id, std::vector<u8> data);
+  void put(const ResourceId &id, SharedBuffer data);
   void remove(const ResourceId &id);
   void clear();
 
   [[nodiscard]] bool contains(const ResourceId &id) const;
-  [[nodiscard]] usize currentSize() const { return m_currentSize; }
-  [[nodiscard]] usize entryCount() const { return m_cache.size(); }
+  [[nodiscard]] usize currentSize() const {
+    return m_windowSize.load(std::memory_order_relaxed) +
+           m_mainSize.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] usize entryCount() const {
+    return m_entryCount.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] usize shardCount() const { return m_shardCount; }
 
   [[nodiscard]] CacheStats stats() const;
   void resetStats();
 
 private:
-  void evictIfNeeded(usize requiredSpace);
-  void updateAccessOrder(const ResourceId &id);
-
-  mutable std::mutex m_mutex;
-  usize m_maxSize;
-  usize m_currentSize = 0;
-
-  std::unordered_map<ResourceId, CacheEntry> m_cache;
-  std::list<ResourceId> m_accessOrder;
-  std::unordered_map<ResourceId, std::list<ResourceId>::iterator>
-      m_orderIterators;
-
-  mutable CacheStats m_stats;
+  struct Slot {
+    ResourceId id;
+    SharedBuffer data;
+    bool referenced = false;
+    bool inWindow = false;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<ResourceId, usize> index;
+    std::vector<Slot> slots;
+    std::vector<usize> freeSlots;
+    // Window entries in insertion order; main entries are swept by hand
+    std::deque<usize> window;
+    usize hand = 0;
+    CacheFrequencySketch sketch;
+    std::array<CacheTypeStats, kResourceTypeCount> typeStats{};
+    usize evictionCount = 0;
+  };
+
+  struct Victim {
+    Shard *shard;
+    usize slot;
+  };
+
+  [[nodiscard]] usize shardIndexFor(const ResourceId &id) const;
+  [[nodiscard]] usize windowBudget() const;
+  [[nodiscard]] f64 weightedFrequency(const Shard &shard,
+                                      const ResourceId &id) const;
+
+  void releaseSlot(Shard &shard, usize slotIndex);
+  bool evictMainOne(Shard &shard);
+  bool evictWindowOne(Shard &shard);
+  /// Unreferenced main entries of a locked shard covering needed bytes
+  usize collectVictims(Shard &shard, usize needed,
+                       std::vector<Victim> &victims);
+  bool admitFromWindow(Shard &shard);
+  void maintain(usize startShard);
+
+  std::unique_ptr<Shard[]> m_shards;
+  usize m_shardCount;
+  std::atomic<usize> m_maxSize;
+  std::atomic<f32> m_windowFraction{kDefaultWindowFraction};
+  std::atomic<usize> m_windowSize{0};
+  std::atomic<usize> m_mainSize{0};
+  std::atomic<usize> m_entryCount{0};
+
+  mutable std::mutex m_policyMutex;
+  std::array<CacheTypePolicy, kResourceTypeCount> m_policies{};
 };
 
 } // namespace NovelMind::VFS
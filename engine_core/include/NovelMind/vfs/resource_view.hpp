@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * @file resource_view.hpp
+ * @brief Ref-counted, read-only view of resource bytes
+ *
+ * A ResourceView either points into a memory-mapped pack (zero-copy) or owns
+ * a decoded buffer. In both cases the bytes stay valid for as long as any
+ * copy of the view exists, independent of pack mount state.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+class ResourceView {
+public:
+  ResourceView() = default;
+
+  /**
+   * @brief View into memory owned by @p owner
+   */
+  ResourceView(std::shared_ptr<const void> owner, std::span<const u8> bytes);
+
+  /**
+   * @brief Take ownership of a decoded buffer
+   */
+  [[nodiscard]] static ResourceView fromBuffer(std::vector<u8> buffer);
+
+  /**
+   * @brief Share an immutable buffer without copying it
+   */
+  [[nodiscard]] static ResourceView
+  fromShared(std::shared_ptr<const std::vector<u8>> buffer);
+
+  [[nodiscard]] const u8 *data() const { return m_bytes.data(); }
+  [[nodiscard]] usize size() const { return m_bytes.size(); }
+  [[nodiscard]] bool empty() const { return m_bytes.empty(); }
+  [[nodiscard]] std::span<const u8> bytes() const { return m_bytes; }
+
+  /**
+   * @brief Whether the bytes alias a file mapping rather than a heap buffer
+   */
+  [[nodiscard]] bool isMapped() const { return m_mapped; }
+
+  /**
+   * @brief The heap buffer backing an unmapped view, nullptr otherwise
+   */
+  [[nodiscard]] std::shared_ptr<const std::vector<u8>> buffer() const;
+
+  [[nodiscard]] std::vector<u8> toVector() const;
+
+private:
+  std::shared_ptr<const void> m_owner;
+  std::span<const u8> m_bytes;
+  bool m_mapped = false;
+};
+
+} // namespace NovelMind::VFS
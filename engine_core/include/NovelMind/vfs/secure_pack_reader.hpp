@@ -8,6 +8,7 @@
 #include "NovelMind/vfs/pack_security.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,12 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  [[nodiscard]] Result<NovelMind::VFS::ResourceView>
+  readFileView(const std::string &resourceId) const override;
+
+  [[nodiscard]] Result<std::unique_ptr<NovelMind::VFS::IFileHandle>>
+  openStream(const std::string &resourceId) const override;
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
 
   [[nodiscard]] std::optional<ResourceInfo>
@@ -37,6 +44,19 @@ public:
   [[nodiscard]] std::vector<std::string>
   listResources(ResourceType type = ResourceType::Unknown) const override;
 
+  /// See SecurePackReader::readResourcePrefix()
+  [[nodiscard]] Result<usize> readFilePrefix(const std::string &resourceId,
+                                             std::span<u8> destination) const;
+
+  /// Number of resources in the mounted pack, without listing them
+  [[nodiscard]] usize resourceCount() const;
+
+  /// True if the resource is stored as a PackDelta (see pack_delta.hpp)
+  [[nodiscard]] bool isDelta(const std::string &resourceId) const;
+
+  /// See SecurePackReader::prefetch()
+  void prefetch(std::span<const std::string> resourceIds) const;
+
 private:
   Result<void> configureReader();
 
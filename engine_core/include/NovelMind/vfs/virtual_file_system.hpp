@@ -1,5 +1,7 @@
 #pragma once
 
+#include "NovelMind/vfs/access_trace.hpp"
+#include "NovelMind/vfs/async_reader.hpp"
 #include "NovelMind/vfs/file_handle.hpp"
 #include "NovelMind/vfs/file_system_backend.hpp"
 #include "NovelMind/vfs/resource_cache.hpp"
@@ -13,6 +15,7 @@ struct VFSConfig {
   usize cacheMaxSize = 64 * 1024 * 1024;
   bool enableCaching = true;
   bool enableLogging = false;
+  usize ioThreadCount = AsyncReader::kDefaultThreadCount;
 };
 
 struct VFSStats {
@@ -41,6 +44,24 @@ public:
   [[nodiscard]] Result<std::vector<u8>> readAll(const ResourceId &id);
   [[nodiscard]] Result<std::vector<u8>> readAll(const std::string &id);
 
+  /**
+   * @brief Read through the cache without copying cached bytes
+   */
+  [[nodiscard]] Result<SharedBuffer> readShared(const ResourceId &id);
+
+  /**
+   * @brief Read on the I/O thread pool
+   *
+   * Concurrent requests for the same resource share one read. @p callback
+   * runs from processCompletions(), which the owner calls once per frame on
+   * the main thread.
+   */
+  [[nodiscard]] AsyncReadHandle
+  readAsync(const ResourceId &id, ReadPriority priority = ReadPriority::Normal,
+            AsyncReadCallback callback = {});
+  usize processCompletions(
+      usize maxCount = std::numeric_limits<usize>::max());
+
   [[nodiscard]] bool exists(const ResourceId &id) const;
   [[nodiscard]] bool exists(const std::string &id) const;
   [[nodiscard]] std::optional<ResourceInfo> getInfo(const ResourceId &id) const;
@@ -48,7 +69,10 @@ public:
   listResources(ResourceType type = ResourceType::Unknown) const;
 
   void clearCache();
+  /// Drop one resource from the cache, e.g. after its file changed
+  void invalidate(const ResourceId &id);
   void setCacheMaxSize(usize maxSize);
+  void setCachePolicy(ResourceType type, const CacheTypePolicy &policy);
   [[nodiscard]] VFSStats stats() const;
 
   using ResourceLoadCallback =
@@ -57,16 +81,43 @@ public:
     m_loadCallback = std::move(callback);
   }
 
+  /**
+   * @brief Called when a DirectoryBackend sees a resource change
+   *
+   * The cache has already dropped the resource, so reading it again gets
+   * the new contents. Runs on the backend's watcher thread.
+   */
+  using ResourceChangeCallback = std::function<void(const ResourceId &)>;
+  void setChangeCallback(ResourceChangeCallback callback);
+
+  /**
+   * @brief Report every opened resource to @p recorder
+   *
+   * Cache hits are not reported; the first open of a resource is what pack
+   * layout cares about. Pass nullptr to detach.
+   */
+  void setTraceRecorder(std::shared_ptr<AccessTraceRecorder> recorder);
+
 private:
   [[nodiscard]] IFileSystemBackend *findBackend(const ResourceId &id) const;
   void sortBackendsByPriority();
+  void onResourceChanged(const ResourceId &id);
 
   VFSConfig m_config;
   std::vector<std::unique_ptr<IFileSystemBackend>> m_backends;
   std::unique_ptr<ResourceCache> m_cache;
   ResourceLoadCallback m_loadCallback;
+  std::shared_ptr<AccessTraceRecorder> m_traceRecorder;
+  // Separate from m_mutex: watcher threads report changes while
+  // unregisterBackend() holds it and joins them
+  std::mutex m_changeMutex;
+  ResourceChangeCallback m_changeCallback;
   bool m_initialized = false;
   mutable std::mutex m_mutex;
+
+  // Started on the first readAsync(); its threads call readShared()
+  std::mutex m_asyncMutex;
+  std::unique_ptr<AsyncReader> m_asyncReader;
 };
 
 VirtualFileSystem &getGlobalVFS();
@@ -2,6 +2,11 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/async_reader.hpp"
+#include "NovelMind/vfs/file_handle.hpp"
+#include "NovelMind/vfs/resource_view.hpp"
+#include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -38,6 +43,59 @@ public:
   [[nodiscard]] virtual Result<std::vector<u8>>
   readFile(const std::string &resourceId) const = 0;
 
+  /**
+   * @brief Read a resource without copying where the backend allows it
+   *
+   * Memory-mapped packs return views aliasing the mapping; the default
+   * implementation wraps readFile().
+   */
+  [[nodiscard]] virtual Result<VFS::ResourceView>
+  readFileView(const std::string &resourceId) const {
+    auto result = readFile(resourceId);
+    if (result.isError()) {
+      return Result<VFS::ResourceView>::error(result.error());
+    }
+    return Result<VFS::ResourceView>::ok(
+        VFS::ResourceView::fromBuffer(std::move(result).value()));
+  }
+
+  /**
+   * @brief Open a resource as a seekable stream
+   *
+   * Packs decode chunked resources frame by frame as they are read; the
+   * default implementation wraps readFile().
+   */
+  [[nodiscard]] virtual Result<std::unique_ptr<VFS::IFileHandle>>
+  openStream(const std::string &resourceId) const {
+    auto result = readFile(resourceId);
+    if (result.isError()) {
+      return Result<std::unique_ptr<VFS::IFileHandle>>::error(result.error());
+    }
+    return Result<std::unique_ptr<VFS::IFileHandle>>::ok(
+        std::make_unique<VFS::MemoryFileHandle>(std::move(result).value()));
+  }
+
+  /**
+   * @brief Read a resource on a background I/O thread
+   *
+   * The callback runs from processCompletions(), which the owner calls
+   * once per frame on the main thread. File systems without I/O threads
+   * return an invalid handle and never run the callback; read
+   * synchronously instead.
+   */
+  [[nodiscard]] virtual VFS::AsyncReadHandle
+  readAsync(const std::string & /*resourceId*/,
+            VFS::ReadPriority /*priority*/,
+            VFS::AsyncReadCallback /*callback*/) const {
+    return {};
+  }
+
+  /// Run completed readAsync() callbacks; returns how many ran
+  virtual usize processCompletions(
+      usize /*maxCount*/ = std::numeric_limits<usize>::max()) {
+    return 0;
+  }
+
   [[nodiscard]] virtual bool exists(const std::string &resourceId) const = 0;
 
   [[nodiscard]] virtual std::optional<ResourceInfo>
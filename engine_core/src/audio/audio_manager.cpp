@@ -5,6 +5,36 @@
 
 namespace NovelMind::audio {
 
+namespace {
+
+// miniaudio decoder callbacks over a VFS stream held in pUserData
+
+ma_result readStream(ma_decoder *decoder, void *buffer, size_t bytesToRead,
+                     size_t *bytesRead) {
+  auto *stream = static_cast<VFS::IFileHandle *>(decoder->pUserData);
+  auto result = stream->read(static_cast<u8 *>(buffer), bytesToRead);
+  if (result.isError()) {
+    *bytesRead = 0;
+    return MA_IO_ERROR;
+  }
+  *bytesRead = result.value();
+  return *bytesRead == 0 && bytesToRead > 0 ? MA_AT_END : MA_SUCCESS;
+}
+
+ma_result seekStream(ma_decoder *decoder, ma_int64 offset,
+                     ma_seek_origin origin) {
+  auto *stream = static_cast<VFS::IFileHandle *>(decoder->pUserData);
+  VFS::SeekOrigin from = VFS::SeekOrigin::Begin;
+  if (origin == ma_seek_origin_current) {
+    from = VFS::SeekOrigin::Current;
+  } else if (origin == ma_seek_origin_end) {
+    from = VFS::SeekOrigin::End;
+  }
+  return stream->seek(offset, from).isOk() ? MA_SUCCESS : MA_BAD_SEEK;
+}
+
+} // namespace
+
 // ============================================================================
 // AudioSource Implementation
 // ============================================================================
@@ -675,6 +705,10 @@ void AudioManager::setDataProvider(DataProvider provider) {
   m_dataProvider = std::move(provider);
 }
 
+void AudioManager::setStreamProvider(StreamProvider provider) {
+  m_streamProvider = std::move(provider);
+}
+
 void AudioManager::setMaxSounds(size_t max) { m_maxSounds = max; }
 
 void AudioManager::setAutoDuckingEnabled(bool enabled) {
@@ -712,7 +746,33 @@ AudioHandle AudioManager::createSource(const std::string &trackId,
   }
 
   bool loaded = false;
-  if (m_dataProvider) {
+  if ((flags & MA_SOUND_FLAG_STREAM) && m_streamProvider) {
+    auto streamResult = m_streamProvider(trackId);
+    if (streamResult.isOk() && streamResult.value()) {
+      source->m_stream = std::move(streamResult).value();
+      source->m_decoder = std::make_unique<ma_decoder>();
+      ma_decoder_config config = ma_decoder_config_init(
+          ma_format_f32, ma_engine_get_channels(m_engine),
+          ma_engine_get_sample_rate(m_engine));
+      if (ma_decoder_init(readStream, seekStream, source->m_stream.get(),
+                          &config, source->m_decoder.get()) == MA_SUCCESS) {
+        if (ma_sound_init_from_data_source(
+                m_engine, source->m_decoder.get(), flags, nullptr,
+                sound.get()) == MA_SUCCESS) {
+          loaded = true;
+          source->m_decoderReady = true;
+        } else {
+          ma_decoder_uninit(source->m_decoder.get());
+        }
+      }
+      if (!loaded) {
+        source->m_decoder.reset();
+        source->m_stream.reset();
+      }
+    }
+  }
+
+  if (!loaded && m_dataProvider) {
     auto dataResult = m_dataProvider(trackId);
     if (dataResult.isOk() && !dataResult.value().empty()) {
       source->m_memoryData = std::move(dataResult.value());
@@ -1,8 +1,11 @@
 #include "NovelMind/core/application.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/scripting/script_runtime.hpp"
 #include "NovelMind/vfs/cached_file_system.hpp"
 #include "NovelMind/vfs/memory_fs.hpp"
 #include "NovelMind/vfs/secure_pack_reader.hpp"
+#include <chrono>
+#include <thread>
 
 namespace NovelMind::core {
 
@@ -39,7 +42,13 @@ Result<void> Application::initialize(const EngineConfig &config) {
   } else {
     baseFs = std::make_unique<vfs::MemoryFileSystem>();
   }
-  m_vfs = std::make_unique<vfs::CachedFileSystem>(std::move(baseFs));
+  auto cachedFs = std::make_unique<vfs::CachedFileSystem>(std::move(baseFs));
+  if (!m_config.accessTracePath.empty()) {
+    m_traceRecorder = std::make_shared<VFS::AccessTraceRecorder>();
+    m_traceRecorder->start();
+    cachedFs->setTraceRecorder(m_traceRecorder);
+  }
+  m_vfs = std::move(cachedFs);
 
   m_renderer = renderer::createRenderer();
   auto renderResult = m_renderer->initialize(*m_window);
@@ -48,8 +57,11 @@ Result<void> Application::initialize(const EngineConfig &config) {
   }
 
   m_resources = std::make_unique<resource::ResourceManager>(m_vfs.get());
+  // Decode off the main thread so new backgrounds don't stall a frame
+  m_resources->setAsyncTextureLoading(true);
   m_sceneGraph = std::make_unique<scene::SceneGraph>();
   m_sceneGraph->setResourceManager(m_resources.get());
+  m_sceneGraph->setAccessTraceRecorder(m_traceRecorder);
 
   m_input = std::make_unique<input::InputManager>();
 
@@ -60,6 +72,10 @@ Result<void> Application::initialize(const EngineConfig &config) {
     }
     return m_resources->readData(id);
   });
+  // Long tracks decode pack frames as they play instead of loading whole
+  m_audio->setStreamProvider([this](const std::string &id) {
+    return m_vfs->openStream(id);
+  });
   m_audio->initialize();
 
   m_saveManager = std::make_unique<save::SaveManager>();
@@ -92,11 +108,22 @@ void Application::shutdown() {
   m_audio.reset();
   m_sceneGraph.reset();
   m_resources.reset();
+  setScriptRuntime(nullptr);
   if (m_renderer) {
     m_renderer->shutdown();
   }
   m_renderer.reset();
   m_vfs.reset();
+  if (m_traceRecorder) {
+    m_traceRecorder->stop();
+    auto saveResult =
+        m_traceRecorder->snapshot().save(m_config.accessTracePath);
+    if (saveResult.isError()) {
+      NOVELMIND_LOG_ERROR("Failed to save access trace: " +
+                          saveResult.error());
+    }
+    m_traceRecorder.reset();
+  }
   m_saveManager.reset();
   m_localization.reset();
   m_input.reset();
@@ -124,6 +151,26 @@ void Application::run() {
 
 void Application::quit() { m_running = false; }
 
+void Application::requestRedraw() { m_redrawRequested = true; }
+
+void Application::setScriptRuntime(scripting::ScriptRuntime *runtime) {
+  if (m_scriptRuntime) {
+    m_scriptRuntime->setFrameCapture(nullptr);
+  }
+  m_scriptRuntime = runtime;
+  if (!m_scriptRuntime) {
+    m_lastFrame.reset();
+    return;
+  }
+  m_scriptRuntime->setFrameCapture([this]() { return getLastFrame(); });
+  // The first frame drawn from now on is captured whole
+  m_redrawRequested = true;
+}
+
+std::shared_ptr<const renderer::RenderTarget> Application::getLastFrame() {
+  return m_lastFrame;
+}
+
 bool Application::isRunning() const { return m_running; }
 
 f64 Application::getDeltaTime() const { return m_timer.getDeltaTime(); }
@@ -176,6 +223,10 @@ void Application::onRender() {
   // Override in derived class
 }
 
+void Application::onRenderOverlay() {
+  // Override in derived class
+}
+
 void Application::mainLoop() {
   while (m_running && !m_window->shouldClose()) {
     m_timer.tick();
@@ -184,6 +235,15 @@ void Application::mainLoop() {
     m_window->pollEvents();
 
     onUpdate(deltaTime);
+    if (m_scriptRuntime) {
+      // The scene graph does not see transitions, so redraw while one runs
+      // and once more to clear it
+      const bool transitioning = m_scriptRuntime->isTransitionActive();
+      m_scriptRuntime->update(deltaTime);
+      if (transitioning || m_scriptRuntime->isTransitionActive()) {
+        m_redrawRequested = true;
+      }
+    }
     if (m_input) {
       m_input->update();
     }
@@ -195,23 +255,79 @@ void Application::mainLoop() {
       m_audio->update(deltaTime);
     }
 
-    if (m_renderer) {
-      m_renderer->beginFrame();
+    if (m_vfs) {
+      // Hand finished background reads to their loaders
+      m_vfs->processCompletions();
+    }
+    if (m_resources) {
+      // Objects keep showing the previous texture while one streams in, so
+      // redraw whenever a load may have finished
+      if (m_resources->getPendingTextureCount() > 0) {
+        m_redrawRequested = true;
+      }
+      m_resources->update();
     }
 
+    renderFrame();
+  }
+}
+
+void Application::renderFrame() {
+  if (!m_renderer) {
     onRender();
-    if (m_renderer && m_sceneGraph) {
-      m_sceneGraph->render(*m_renderer);
-    }
+    onRenderOverlay();
+    m_window->swapBuffers();
+    return;
+  }
+
+  const i32 width = m_renderer->getWidth();
+  const i32 height = m_renderer->getHeight();
+  if (width != m_lastFrameWidth || height != m_lastFrameHeight) {
+    m_lastFrameWidth = width;
+    m_lastFrameHeight = height;
+    m_redrawRequested = true;
+  }
 
-    if (m_renderer) {
-      m_renderer->endFrame();
+  scene::SceneDamage damage;
+  damage.changed = damage.full = true;
+  if (m_config.skipIdleFrames && !m_redrawRequested && m_sceneGraph) {
+    damage = m_sceneGraph->getDamage();
+  }
+  m_redrawRequested = false;
+
+  if (!damage.changed) {
+    // The last frame is still on screen
+    ++m_frameStats.skippedFrames;
+    if (m_config.idleSleepMs > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(m_config.idleSleepMs));
     }
+    return;
+  }
+
+  if (damage.isPartial() && m_renderer->beginPartialFrame(damage.rect)) {
+    ++m_frameStats.partialFrames;
+  } else {
+    m_renderer->beginFrame();
+    ++m_frameStats.renderedFrames;
+  }
 
-    if (!m_renderer) {
-      m_window->swapBuffers();
+  onRender();
+  if (m_sceneGraph) {
+    m_sceneGraph->render(*m_renderer);
+  }
+  if (m_scriptRuntime) {
+    // A transition may still hold the previous capture
+    if (!m_lastFrame || m_lastFrame.use_count() > 1) {
+      m_lastFrame = std::make_shared<renderer::RenderTarget>();
+    }
+    if (!m_renderer->captureFrame(*m_lastFrame)) {
+      m_lastFrame.reset();
     }
+    m_scriptRuntime->renderTransition(*m_renderer);
   }
+  onRenderOverlay();
+  m_renderer->endFrame();
 }
 
 } // namespace NovelMind::core
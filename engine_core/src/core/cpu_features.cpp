@@ -0,0 +1,82 @@
+#include "NovelMind/core/cpu_features.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#elif defined(_M_ARM64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
+
+namespace NovelMind::core {
+
+namespace {
+
+CpuFeatures detect() {
+  CpuFeatures features;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int regs[4] = {};
+  __cpuid(regs, 0);
+  const int maxLeaf = regs[0];
+  __cpuid(regs, 1);
+  features.sse41 = (regs[2] & (1 << 19)) != 0;
+  features.pclmul = (regs[2] & (1 << 1)) != 0;
+  const bool osAvx = (regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0 &&
+                     (_xgetbv(0) & 0x6) == 0x6;
+  if (maxLeaf >= 7) {
+    __cpuidex(regs, 7, 0);
+    features.avx2 = osAvx && (regs[1] & (1 << 5)) != 0;
+  }
+#elif defined(__x86_64__) || defined(__i386__)
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    features.sse41 = (ecx & bit_SSE4_1) != 0;
+    features.pclmul = (ecx & bit_PCLMUL) != 0;
+    // AVX state must also be enabled by the OS (OSXSAVE + XCR0)
+    bool osAvx = false;
+    if ((ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0) {
+      unsigned int xcrLow = 0, xcrHigh = 0;
+      __asm__("xgetbv" : "=a"(xcrLow), "=d"(xcrHigh) : "c"(0));
+      osAvx = (xcrLow & 0x6) == 0x6;
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      features.avx2 = osAvx && (ebx & bit_AVX2) != 0;
+    }
+  }
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+  // Advanced SIMD is mandatory on ARMv8-A
+  features.neon = true;
+#if defined(__linux__)
+  features.armCrc32 = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#elif defined(__APPLE__)
+  features.armCrc32 = true;
+#elif defined(_M_ARM64)
+  features.armCrc32 =
+      IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__ARM_FEATURE_CRC32)
+  features.armCrc32 = true;
+#endif
+#endif
+
+  return features;
+}
+
+} // namespace
+
+const CpuFeatures &CpuFeatures::get() {
+  static const CpuFeatures features = detect();
+  return features;
+}
+
+} // namespace NovelMind::core
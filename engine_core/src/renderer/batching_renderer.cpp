@@ -0,0 +1,142 @@
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include "NovelMind/renderer/utf8.hpp"
+#include "NovelMind/platform/window.hpp"
+
+namespace NovelMind::renderer {
+
+void BatchingRenderer::beginFrame() {
+  m_commands.clear();
+  m_commands.setLayer(0);
+  m_pendingClear.reset();
+  m_glyphs.beginFrame();
+}
+
+void BatchingRenderer::endFrame() {
+  flush();
+  present();
+}
+
+void BatchingRenderer::flush() {
+  if (m_commands.empty() && !m_pendingClear) {
+    return;
+  }
+  // Glyphs rasterized since the last flush go up in one upload per page
+  m_glyphs.flushUploads();
+  m_commands.build(m_batches);
+  submit(m_batches, m_pendingClear);
+  m_commands.clear();
+  m_pendingClear.reset();
+}
+
+bool BatchingRenderer::captureFrame(RenderTarget &target) {
+  flush();
+  return copyFrame(target);
+}
+
+void BatchingRenderer::clear(const Color &color) {
+  // Anything recorded so far would be cleared away
+  m_commands.clear();
+  m_pendingClear = color;
+}
+
+void BatchingRenderer::setBlendMode(BlendMode mode) {
+  m_commands.setBlendMode(mode);
+}
+
+void BatchingRenderer::setLayer(i32 layer) { m_commands.setLayer(layer); }
+
+void BatchingRenderer::drawSprite(const Texture &texture,
+                                  const Transform2D &transform,
+                                  const Color &tint) {
+  m_commands.pushSprite(texture,
+                        Rect{0, 0, static_cast<f32>(texture.getWidth()),
+                             static_cast<f32>(texture.getHeight())},
+                        transform, tint);
+}
+
+void BatchingRenderer::drawSprite(const Texture &texture,
+                                  const Rect &sourceRect,
+                                  const Transform2D &transform,
+                                  const Color &tint) {
+  m_commands.pushSprite(texture, sourceRect, transform, tint);
+}
+
+void BatchingRenderer::drawRect(const Rect &rect, const Color &color) {
+  if (rect.width <= 2.0f || rect.height <= 2.0f) {
+    m_commands.pushRect(rect, color);
+    return;
+  }
+  // One-pixel edges, so outlines batch with everything else
+  m_commands.pushRect(Rect{rect.x, rect.y, rect.width, 1.0f}, color);
+  m_commands.pushRect(
+      Rect{rect.x, rect.y + rect.height - 1.0f, rect.width, 1.0f}, color);
+  m_commands.pushRect(
+      Rect{rect.x, rect.y + 1.0f, 1.0f, rect.height - 2.0f}, color);
+  m_commands.pushRect(Rect{rect.x + rect.width - 1.0f, rect.y + 1.0f, 1.0f,
+                           rect.height - 2.0f},
+                      color);
+}
+
+void BatchingRenderer::fillRect(const Rect &rect, const Color &color) {
+  m_commands.pushRect(rect, color);
+}
+
+void BatchingRenderer::drawText(const Font &font, const std::string &text,
+                                f32 x, f32 y, const Color &color) {
+  if (text.empty() || !font.isValid()) {
+    return;
+  }
+
+  const f32 lineHeight = m_glyphs.getLineHeight(font);
+  f32 penX = x;
+  f32 baseline = y + lineHeight;
+
+  usize offset = 0;
+  while (offset < text.size()) {
+    const char32_t codepoint = decodeUtf8(text, offset);
+    if (codepoint == U'\n') {
+      penX = x;
+      baseline += lineHeight;
+      continue;
+    }
+
+    const auto *glyph = m_glyphs.getGlyph(font, codepoint);
+    if (!glyph) {
+      penX += static_cast<f32>(font.getSize()) * 0.5f;
+      continue;
+    }
+
+    if (glyph->texture) {
+      Transform2D transform;
+      transform.x = penX + glyph->bearingX;
+      transform.y = baseline - glyph->bearingY;
+      m_commands.pushSprite(*glyph->texture, glyph->sourceRect, transform,
+                            color);
+    }
+    penX += glyph->advanceX;
+  }
+}
+
+void BatchingRenderer::setFade(f32 alpha, const Color &color) {
+  const f32 clamped = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+  m_commands.pushRect(Rect{0, 0, static_cast<f32>(m_width),
+                           static_cast<f32>(m_height)},
+                      Color(color.r, color.g, color.b,
+                            static_cast<u8>(clamped * 255.0f + 0.5f)));
+}
+
+Result<void> RecordingRenderer::initialize(platform::IWindow &window) {
+  m_width = window.getWidth();
+  m_height = window.getHeight();
+  return Result<void>::ok();
+}
+
+void RecordingRenderer::submit(const RenderBatchList &batches,
+                               const std::optional<Color> &clearColor) {
+  m_lastCommands = commandBuffer().commands();
+  m_lastBatches = batches;
+  m_lastClear = clearColor;
+  ++m_submitCount;
+}
+
+} // namespace NovelMind::renderer
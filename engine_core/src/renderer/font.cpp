@@ -1,6 +1,7 @@
 #include "NovelMind/renderer/font.hpp"
 #include "NovelMind/core/logger.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 
 #if defined(NOVELMIND_HAS_FREETYPE)
@@ -10,23 +11,36 @@
 
 namespace NovelMind::renderer {
 
+namespace {
+std::atomic<u64> g_nextFontId{1};
+} // namespace
+
 Font::Font() : m_handle(nullptr), m_size(0) {}
 
 Font::~Font() { destroy(); }
 
 Font::Font(Font &&other) noexcept
-    : m_handle(other.m_handle), m_size(other.m_size) {
+    : m_handle(other.m_handle), m_library(other.m_library),
+      m_size(other.m_size), m_id(other.m_id),
+      m_data(std::move(other.m_data)) {
   other.m_handle = nullptr;
+  other.m_library = nullptr;
   other.m_size = 0;
+  other.m_id = 0;
 }
 
 Font &Font::operator=(Font &&other) noexcept {
   if (this != &other) {
     destroy();
     m_handle = other.m_handle;
+    m_library = other.m_library;
     m_size = other.m_size;
+    m_id = other.m_id;
+    m_data = std::move(other.m_data);
     other.m_handle = nullptr;
+    other.m_library = nullptr;
     other.m_size = 0;
+    other.m_id = 0;
   }
   return *this;
 }
@@ -37,31 +51,39 @@ Result<void> Font::loadFromMemory(const std::vector<u8> &data, i32 size) {
   }
 
 #if defined(NOVELMIND_HAS_FREETYPE)
+  destroy();
+  m_data = data;
+
   FT_Library ft;
   if (FT_Init_FreeType(&ft)) {
+    m_data.clear();
     return Result<void>::error("Failed to init FreeType");
   }
 
   FT_Face face;
-  if (FT_New_Memory_Face(ft, reinterpret_cast<const FT_Byte *>(data.data()),
-                         static_cast<FT_Long>(data.size()), 0, &face)) {
+  if (FT_New_Memory_Face(ft, m_data.data(),
+                         static_cast<FT_Long>(m_data.size()), 0, &face)) {
     FT_Done_FreeType(ft);
+    m_data.clear();
     return Result<void>::error("Failed to load font from memory");
   }
 
   if (FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(size))) {
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
+    m_data.clear();
     return Result<void>::error("Failed to set font pixel size");
   }
 
   m_handle = face;
   m_size = size;
   m_library = ft;
+  m_id = g_nextFontId.fetch_add(1, std::memory_order_relaxed);
   NOVELMIND_LOG_INFO("Font loaded via FreeType, size " + std::to_string(size));
   return Result<void>::ok();
 #else
   m_size = size;
+  m_id = g_nextFontId.fetch_add(1, std::memory_order_relaxed);
   NOVELMIND_LOG_WARN("FreeType not available, font metrics are placeholders");
   return Result<void>::ok();
 #endif
@@ -84,6 +106,8 @@ void Font::destroy() {
     m_handle = nullptr;
   }
   m_size = 0;
+  m_id = 0;
+  m_data.clear();
 }
 
 bool Font::isValid() const { return m_size > 0; }
@@ -96,12 +120,39 @@ void *Font::getNativeHandle() const { return m_handle; }
 
 namespace NovelMind::renderer {
 
+FontAtlas::FontAtlas(FontAtlas &&other) noexcept
+    : m_texture(std::move(other.m_texture)),
+      m_glyphs(std::move(other.m_glyphs)), m_lineHeight(other.m_lineHeight),
+      m_valid(other.m_valid), m_id(other.m_id) {
+  other.m_glyphs.clear();
+  other.m_lineHeight = 0;
+  other.m_valid = false;
+  other.m_id = 0;
+}
+
+FontAtlas &FontAtlas::operator=(FontAtlas &&other) noexcept {
+  if (this != &other) {
+    m_texture = std::move(other.m_texture);
+    m_glyphs = std::move(other.m_glyphs);
+    m_lineHeight = other.m_lineHeight;
+    m_valid = other.m_valid;
+    m_id = other.m_id;
+
+    other.m_glyphs.clear();
+    other.m_lineHeight = 0;
+    other.m_valid = false;
+    other.m_id = 0;
+  }
+  return *this;
+}
+
 Result<void> FontAtlas::build(const Font &font, const std::string &charset,
                               i32 padding) {
   m_glyphs.clear();
   m_texture.destroy();
   m_lineHeight = 0;
   m_valid = false;
+  m_id = 0;
 
   if (!font.isValid()) {
     return Result<void>::error("FontAtlas::build - font is not loaded");
@@ -230,6 +281,7 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
   if (!m_valid) {
     return Result<void>::error("FontAtlas texture is not valid");
   }
+  m_id = g_nextFontId.fetch_add(1, std::memory_order_relaxed);
   return Result<void>::ok();
 #else
   (void)font;
@@ -0,0 +1,322 @@
+#include "NovelMind/renderer/glyph_cache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#if defined(NOVELMIND_HAS_FREETYPE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace NovelMind::renderer {
+
+struct GlyphCache::Page {
+  Texture texture;
+  /// CPU copy of the page, RGBA
+  std::vector<u8> pixels;
+  std::vector<Shelf> shelves;
+  i32 nextShelfY = 0;
+  /// Rows written since the last flush, empty when top >= bottom
+  i32 dirtyTop = 0;
+  i32 dirtyBottom = 0;
+
+  void markDirty(i32 top, i32 bottom) {
+    if (dirtyTop >= dirtyBottom) {
+      dirtyTop = top;
+      dirtyBottom = bottom;
+      return;
+    }
+    dirtyTop = std::min(dirtyTop, top);
+    dirtyBottom = std::max(dirtyBottom, bottom);
+  }
+
+  [[nodiscard]] u64 lastUsed() const {
+    u64 used = 0;
+    for (const auto &shelf : shelves) {
+      used = std::max(used, shelf.lastUsed);
+    }
+    return used;
+  }
+};
+
+namespace {
+
+/// Shelves are sized in steps so glyphs of similar height share them
+constexpr i32 kShelfStep = 4;
+
+i32 shelfHeightFor(i32 glyphHeight) {
+  return (glyphHeight + kShelfStep - 1) / kShelfStep * kShelfStep;
+}
+
+/// Whether a glyph fits a shelf without wasting too much of its height
+bool shelfSuits(i32 shelfHeight, i32 glyphHeight) {
+  return shelfHeight >= glyphHeight &&
+         shelfHeight <= glyphHeight + glyphHeight / 4 + kShelfStep;
+}
+
+} // namespace
+
+usize GlyphCache::KeyHash::operator()(const Key &key) const {
+  return std::hash<u64>{}(key.font) ^
+         (static_cast<usize>(key.codepoint) * usize{0x9E3779B97F4A7C15});
+}
+
+GlyphCache::GlyphCache(i32 pageSize, u32 maxPages, i32 padding)
+    : m_pageSize(std::max(pageSize, 16)), m_maxPages(std::max(maxPages, 1u)),
+      m_padding(std::max(padding, 0)) {}
+
+GlyphCache::~GlyphCache() = default;
+
+const GlyphCache::Glyph *GlyphCache::getGlyph(const Font &font,
+                                              char32_t codepoint) {
+  const Key key{font.getId(), codepoint};
+  auto it = m_glyphs.find(key);
+  if (it != m_glyphs.end()) {
+    Entry &entry = it->second;
+    if (entry.glyph.texture) {
+      m_pages[entry.page]->shelves[entry.shelf].lastUsed = m_frame;
+    }
+    return &entry.glyph;
+  }
+
+#if defined(NOVELMIND_HAS_FREETYPE)
+  auto *face = static_cast<FT_Face>(font.getNativeHandle());
+  if (!face ||
+      FT_Load_Char(face, static_cast<FT_ULong>(codepoint), FT_LOAD_RENDER)) {
+    return nullptr;
+  }
+
+  const FT_GlyphSlot g = face->glyph;
+  const i32 width = static_cast<i32>(g->bitmap.width);
+  const i32 height = static_cast<i32>(g->bitmap.rows);
+
+  Glyph glyph;
+  glyph.advanceX = static_cast<f32>(g->advance.x) / 64.0f;
+  glyph.bearingX = static_cast<f32>(g->bitmap_left);
+  glyph.bearingY = static_cast<f32>(g->bitmap_top);
+
+  if (width == 0 || height == 0) {
+    return &m_glyphs.emplace(key, Entry{glyph, 0, 0}).first->second.glyph;
+  }
+
+  Slot slot{};
+  if (width + 2 * m_padding > m_pageSize ||
+      height + 2 * m_padding > m_pageSize ||
+      (!findSlot(width, height, slot) && !evictSlot(width, height, slot))) {
+    // Still advance the pen correctly, just without pixels
+    m_uncached = glyph;
+    return &m_uncached;
+  }
+
+  Page &page = *m_pages[slot.page];
+  Shelf &shelf = page.shelves[slot.shelf];
+  const auto stride = static_cast<usize>(m_pageSize) * 4;
+  for (i32 y = 0; y < height; ++y) {
+    const u8 *src = g->bitmap.buffer + y * g->bitmap.pitch;
+    u8 *dst = page.pixels.data() + static_cast<usize>(slot.y + y) * stride +
+              static_cast<usize>(slot.x) * 4;
+    for (i32 x = 0; x < width; ++x) {
+      dst[0] = 255;
+      dst[1] = 255;
+      dst[2] = 255;
+      dst[3] = src[x];
+      dst += 4;
+    }
+  }
+  page.markDirty(slot.y, slot.y + height);
+  shelf.glyphs.push_back(key);
+  shelf.lastUsed = m_frame;
+
+  glyph.texture = &page.texture;
+  glyph.sourceRect =
+      Rect{static_cast<f32>(slot.x), static_cast<f32>(slot.y),
+           static_cast<f32>(width), static_cast<f32>(height)};
+  return &m_glyphs.emplace(key, Entry{glyph, slot.page, slot.shelf})
+              .first->second.glyph;
+#else
+  (void)codepoint;
+  return nullptr;
+#endif
+}
+
+f32 GlyphCache::getLineHeight(const Font &font) {
+  auto it = m_lineHeights.find(font.getId());
+  if (it != m_lineHeights.end()) {
+    return it->second;
+  }
+
+  auto lineHeight = static_cast<f32>(font.getSize());
+#if defined(NOVELMIND_HAS_FREETYPE)
+  auto *face = static_cast<FT_Face>(font.getNativeHandle());
+  if (face && face->size) {
+    // 26.6 fixed point
+    lineHeight = static_cast<f32>(face->size->metrics.height / 64);
+  }
+#endif
+  m_lineHeights.emplace(font.getId(), lineHeight);
+  return lineHeight;
+}
+
+usize GlyphCache::flushUploads() {
+  usize bytes = 0;
+  const auto stride = static_cast<usize>(m_pageSize) * 4;
+  for (auto &page : m_pages) {
+    if (page->dirtyTop >= page->dirtyBottom) {
+      continue;
+    }
+    const i32 rows = page->dirtyBottom - page->dirtyTop;
+    page->texture.uploadRows(page->pixels.data() +
+                                 static_cast<usize>(page->dirtyTop) * stride,
+                             page->dirtyTop, rows);
+    bytes += static_cast<usize>(rows) * stride;
+    page->dirtyTop = page->dirtyBottom = 0;
+  }
+  return bytes;
+}
+
+void GlyphCache::releaseFont(const Font &font) {
+  m_lineHeights.erase(font.getId());
+  for (auto it = m_glyphs.begin(); it != m_glyphs.end();) {
+    if (it->first.font != font.getId()) {
+      ++it;
+      continue;
+    }
+    if (it->second.glyph.texture) {
+      auto &glyphs =
+          m_pages[it->second.page]->shelves[it->second.shelf].glyphs;
+      glyphs.erase(std::remove(glyphs.begin(), glyphs.end(), it->first),
+                   glyphs.end());
+    }
+    it = m_glyphs.erase(it);
+  }
+}
+
+void GlyphCache::clear() {
+  m_glyphs.clear();
+  m_lineHeights.clear();
+  m_pages.clear();
+}
+
+bool GlyphCache::findSlot(i32 width, i32 height, Slot &slot) {
+  const i32 needed = width + m_padding;
+
+  // The tightest existing shelf with room left
+  bool found = false;
+  i32 bestHeight = std::numeric_limits<i32>::max();
+  for (u32 p = 0; p < m_pages.size(); ++p) {
+    auto &shelves = m_pages[p]->shelves;
+    for (u32 s = 0; s < shelves.size(); ++s) {
+      const Shelf &shelf = shelves[s];
+      if (shelfSuits(shelf.height, height) && shelf.height < bestHeight &&
+          shelf.cursorX + needed <= m_pageSize) {
+        slot = Slot{p, s, shelf.cursorX, shelf.y};
+        bestHeight = shelf.height;
+        found = true;
+      }
+    }
+  }
+
+  if (!found) {
+    // Open a shelf below the existing ones, on a new page if need be
+    const i32 shelfHeight =
+        std::min(shelfHeightFor(height), m_pageSize - 2 * m_padding);
+    Page *target = nullptr;
+    u32 pageIndex = 0;
+    for (u32 p = 0; p < m_pages.size() && !target; ++p) {
+      if (m_pages[p]->nextShelfY + shelfHeight + m_padding <= m_pageSize) {
+        target = m_pages[p].get();
+        pageIndex = p;
+      }
+    }
+    if (!target) {
+      if (m_pages.size() >= m_maxPages) {
+        return false;
+      }
+      pageIndex = static_cast<u32>(m_pages.size());
+      target = &addPage();
+    }
+    Shelf shelf;
+    shelf.y = target->nextShelfY;
+    shelf.height = shelfHeight;
+    shelf.cursorX = m_padding;
+    target->nextShelfY += shelfHeight + m_padding;
+    target->shelves.push_back(std::move(shelf));
+    slot = Slot{pageIndex, static_cast<u32>(target->shelves.size() - 1),
+                m_padding, target->shelves.back().y};
+  }
+
+  m_pages[slot.page]->shelves[slot.shelf].cursorX += needed;
+  return true;
+}
+
+bool GlyphCache::evictSlot(i32 width, i32 height, Slot &slot) {
+  // Least recently used shelf that is tall enough
+  bool found = false;
+  u64 oldest = std::numeric_limits<u64>::max();
+  for (u32 p = 0; p < m_pages.size(); ++p) {
+    auto &shelves = m_pages[p]->shelves;
+    for (u32 s = 0; s < shelves.size(); ++s) {
+      const Shelf &shelf = shelves[s];
+      if (shelf.height >= height && shelf.lastUsed < m_frame &&
+          shelf.lastUsed < oldest) {
+        slot = Slot{p, s, m_padding, shelf.y};
+        oldest = shelf.lastUsed;
+        found = true;
+      }
+    }
+  }
+  if (found) {
+    Page &page = *m_pages[slot.page];
+    Shelf &shelf = page.shelves[slot.shelf];
+    emptyShelf(page, shelf);
+    shelf.cursorX += width + m_padding;
+    return true;
+  }
+
+  // Only shorter shelves are idle: start over on the least recently used
+  // page that has nothing on screen
+  Page *victimPage = nullptr;
+  for (auto &page : m_pages) {
+    if (page->lastUsed() < m_frame &&
+        (!victimPage || page->lastUsed() < victimPage->lastUsed())) {
+      victimPage = page.get();
+    }
+  }
+  if (!victimPage) {
+    return false;
+  }
+  for (auto &shelf : victimPage->shelves) {
+    emptyShelf(*victimPage, shelf);
+  }
+  victimPage->shelves.clear();
+  victimPage->nextShelfY = m_padding;
+  return findSlot(width, height, slot);
+}
+
+void GlyphCache::emptyShelf(Page &page, Shelf &shelf) {
+  for (const auto &key : shelf.glyphs) {
+    m_glyphs.erase(key);
+  }
+  m_evicted += shelf.glyphs.size();
+  shelf.glyphs.clear();
+  shelf.cursorX = m_padding;
+
+  const auto stride = static_cast<usize>(m_pageSize) * 4;
+  std::memset(page.pixels.data() + static_cast<usize>(shelf.y) * stride, 0,
+              static_cast<usize>(shelf.height) * stride);
+  page.markDirty(shelf.y, shelf.y + shelf.height);
+}
+
+GlyphCache::Page &GlyphCache::addPage() {
+  auto page = std::make_unique<Page>();
+  const auto size = static_cast<usize>(m_pageSize);
+  page->pixels.assign(size * size * 4, 0);
+  page->nextShelfY = m_padding;
+  (void)page->texture.loadFromRGBA(page->pixels.data(), m_pageSize,
+                                   m_pageSize);
+  m_pages.push_back(std::move(page));
+  return *m_pages.back();
+}
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,546 @@
+#include "NovelMind/renderer/image_processing.hpp"
+#include "NovelMind/core/cpu_features.hpp"
+#include "stb/stb_image.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NOVELMIND_RESAMPLE_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define NOVELMIND_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NOVELMIND_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define NOVELMIND_RESAMPLE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace NovelMind::renderer {
+
+namespace {
+
+// Below this many source pixels threads cost more than they save
+constexpr usize kParallelPixels = 512 * 512;
+constexpr i32 kMinRowsPerThread = 16;
+// Steps of the linear to byte table; fine enough that decoding and
+// encoding again returns every byte unchanged
+constexpr i32 kEncodeSteps = 4096;
+constexpr f64 kPi = 3.14159265358979323846;
+
+enum class Kernel : u8 { Scalar, Sse2, Avx2, Neon };
+
+Kernel kernelFor(bool simd) {
+  if (!simd) {
+    return Kernel::Scalar;
+  }
+#if defined(NOVELMIND_RESAMPLE_X86)
+  return core::CpuFeatures::get().avx2 ? Kernel::Avx2 : Kernel::Sse2;
+#elif defined(NOVELMIND_RESAMPLE_NEON)
+  return Kernel::Neon;
+#else
+  return Kernel::Scalar;
+#endif
+}
+
+struct ColorTables {
+  /// Byte to linear [0, 1]
+  std::array<f32, 256> decode{};
+  /// Linear * kEncodeSteps to byte
+  std::array<u8, kEncodeSteps + 1> encode{};
+};
+
+f32 srgbToLinear(f32 c) {
+  return c <= 0.04045f ? c / 12.92f
+                       : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+f32 linearToSrgb(f32 c) {
+  return c <= 0.0031308f ? c * 12.92f
+                         : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+ColorTables makeTables(bool srgb) {
+  ColorTables tables;
+  for (usize i = 0; i < tables.decode.size(); ++i) {
+    const f32 c = static_cast<f32>(i) / 255.0f;
+    tables.decode[i] = srgb ? srgbToLinear(c) : c;
+  }
+  for (usize i = 0; i < tables.encode.size(); ++i) {
+    const f32 c = static_cast<f32>(i) / static_cast<f32>(kEncodeSteps);
+    const f32 encoded = srgb ? linearToSrgb(c) : c;
+    tables.encode[i] = static_cast<u8>(encoded * 255.0f + 0.5f);
+  }
+  return tables;
+}
+
+const ColorTables &tablesFor(bool srgb) {
+  static const ColorTables srgbTables = makeTables(true);
+  static const ColorTables linearTables = makeTables(false);
+  return srgb ? srgbTables : linearTables;
+}
+
+u8 encodeChannel(const ColorTables &tables, f32 value) {
+  const f32 scaled =
+      std::clamp(value, 0.0f, 1.0f) * static_cast<f32>(kEncodeSteps);
+  return tables.encode[static_cast<usize>(scaled + 0.5f)];
+}
+
+u8 mulDiv255(u32 x, u32 y) {
+  const u32 t = x * y + 128;
+  return static_cast<u8>((t + (t >> 8)) >> 8);
+}
+
+u8 unpremultiplyChannel(u8 c, u8 alpha) {
+  if (alpha == 0) {
+    return 0;
+  }
+  const u32 straight = (static_cast<u32>(c) * 255 + alpha / 2u) / alpha;
+  return static_cast<u8>(std::min(straight, 255u));
+}
+
+/// RGBA8 to premultiplied linear floats
+void decodeRow(const ColorTables &tables, const u8 *src, f32 *dst,
+               i32 width, bool premultiplied) {
+  for (i32 x = 0; x < width; ++x, src += 4, dst += 4) {
+    const f32 alpha = static_cast<f32>(src[3]) / 255.0f;
+    for (usize c = 0; c < 3; ++c) {
+      // Premultiplied input is undone in encoded space, then redone on
+      // linear colour
+      const u8 straight =
+          premultiplied ? unpremultiplyChannel(src[c], src[3]) : src[c];
+      dst[c] = tables.decode[straight] * alpha;
+    }
+    dst[3] = alpha;
+  }
+}
+
+/// Premultiplied linear floats back to RGBA8
+void encodeRow(const ColorTables &tables, const f32 *src, u8 *dst,
+               i32 width, bool premultiplied) {
+  for (i32 x = 0; x < width; ++x, src += 4, dst += 4) {
+    const f32 alpha = std::clamp(src[3], 0.0f, 1.0f);
+    const auto alphaByte = static_cast<u8>(alpha * 255.0f + 0.5f);
+    if (alphaByte == 0) {
+      std::memset(dst, 0, 4);
+      continue;
+    }
+    const f32 inverse = 1.0f / alpha;
+    for (usize c = 0; c < 3; ++c) {
+      const u8 value = encodeChannel(tables, src[c] * inverse);
+      dst[c] = premultiplied ? mulDiv255(value, alphaByte) : value;
+    }
+    dst[3] = alphaByte;
+  }
+}
+
+/// Source taps of every output pixel along one axis
+struct Contributions {
+  std::vector<i32> first;
+  std::vector<i32> count;
+  /// stride weights per output pixel, summing to one
+  std::vector<f32> weights;
+  usize stride = 0;
+};
+
+f64 lanczos3(f64 x) {
+  x = std::abs(x);
+  if (x < 1e-8) {
+    return 1.0;
+  }
+  if (x >= 3.0) {
+    return 0.0;
+  }
+  const f64 px = kPi * x;
+  return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+}
+
+Contributions computeContributions(i32 srcSize, i32 dstSize,
+                                   ResampleFilter filter) {
+  const f64 scale = static_cast<f64>(srcSize) / static_cast<f64>(dstSize);
+  // Downscaling stretches the kernel so every source pixel contributes
+  const f64 filterScale = std::max(scale, 1.0);
+  const f64 support =
+      (filter == ResampleFilter::Box ? 0.5 : 3.0) * filterScale;
+
+  Contributions result;
+  result.stride = static_cast<usize>(std::ceil(support * 2.0)) + 2;
+  const auto outputs = static_cast<usize>(dstSize);
+  result.first.resize(outputs);
+  result.count.resize(outputs);
+  result.weights.assign(outputs * result.stride, 0.0f);
+
+  std::vector<f64> taps(result.stride);
+  for (i32 i = 0; i < dstSize; ++i) {
+    const f64 center = (static_cast<f64>(i) + 0.5) * scale;
+    const i32 lo =
+        std::max(0, static_cast<i32>(std::floor(center - support)));
+    const i32 hi = std::min(
+        {srcSize, static_cast<i32>(std::ceil(center + support)),
+         lo + static_cast<i32>(result.stride)});
+
+    f64 sum = 0.0;
+    i32 first = -1;
+    i32 last = -1;
+    for (i32 j = lo; j < hi; ++j) {
+      f64 weight = 0.0;
+      if (filter == ResampleFilter::Box) {
+        // Overlap of the source pixel with the output pixel's footprint
+        weight = std::min(j + 1.0, center + support) -
+                 std::max(static_cast<f64>(j), center - support);
+        weight = std::max(weight, 0.0);
+      } else {
+        weight = lanczos3((j + 0.5 - center) / filterScale);
+      }
+      taps[static_cast<usize>(j - lo)] = weight;
+      sum += weight;
+      if (weight != 0.0) {
+        first = first < 0 ? j : first;
+        last = j;
+      }
+    }
+
+    const auto out = static_cast<usize>(i);
+    f32 *weights = result.weights.data() + out * result.stride;
+    if (first < 0 || std::abs(sum) < 1e-12) {
+      result.first[out] =
+          std::clamp(static_cast<i32>(center), 0, srcSize - 1);
+      result.count[out] = 1;
+      weights[0] = 1.0f;
+      continue;
+    }
+    result.first[out] = first;
+    result.count[out] = last - first + 1;
+    for (i32 k = 0; k < result.count[out]; ++k) {
+      weights[k] = static_cast<f32>(
+          taps[static_cast<usize>(first - lo + k)] / sum);
+    }
+  }
+  return result;
+}
+
+/// Weighted sum of count consecutive RGBA pixels into one
+using ConvolveFn = void (*)(const f32 *src, const f32 *weights, i32 count,
+                            f32 *dst);
+/// acc[i] += weight * row[i] for count floats, a multiple of four
+using AccumulateFn = void (*)(const f32 *row, f32 weight, f32 *acc,
+                              usize count);
+
+void convolveScalar(const f32 *src, const f32 *weights, i32 count,
+                    f32 *dst) {
+  f32 sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  for (i32 k = 0; k < count; ++k, src += 4) {
+    for (usize c = 0; c < 4; ++c) {
+      sum[c] += weights[k] * src[c];
+    }
+  }
+  std::memcpy(dst, sum, sizeof(sum));
+}
+
+void accumulateScalar(const f32 *row, f32 weight, f32 *acc, usize count) {
+  for (usize i = 0; i < count; ++i) {
+    acc[i] += weight * row[i];
+  }
+}
+
+#if defined(NOVELMIND_RESAMPLE_X86)
+
+// SSE2 is part of x86-64, so these need no target attribute
+
+void convolveSse2(const f32 *src, const f32 *weights, i32 count,
+                  f32 *dst) {
+  __m128 sum = _mm_setzero_ps();
+  for (i32 k = 0; k < count; ++k) {
+    sum = _mm_add_ps(
+        sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(src + k * 4)));
+  }
+  _mm_storeu_ps(dst, sum);
+}
+
+void accumulateSse2(const f32 *row, f32 weight, f32 *acc, usize count) {
+  const __m128 w = _mm_set1_ps(weight);
+  for (usize i = 0; i < count; i += 4) {
+    _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i),
+                                      _mm_mul_ps(w, _mm_loadu_ps(row + i))));
+  }
+}
+
+// Two taps per step: the low lane holds one pixel, the high lane the next
+NOVELMIND_TARGET_AVX2 void convolveAvx2(const f32 *src, const f32 *weights,
+                                        i32 count, f32 *dst) {
+  __m256 sum = _mm256_setzero_ps();
+  i32 k = 0;
+  for (; k + 2 <= count; k += 2) {
+    const __m256 w = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_set1_ps(weights[k])),
+        _mm_set1_ps(weights[k + 1]), 1);
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(w, _mm256_loadu_ps(src + k * 4)));
+  }
+  __m128 folded = _mm_add_ps(_mm256_castps256_ps128(sum),
+                             _mm256_extractf128_ps(sum, 1));
+  if (k < count) {
+    folded = _mm_add_ps(folded, _mm_mul_ps(_mm_set1_ps(weights[k]),
+                                           _mm_loadu_ps(src + k * 4)));
+  }
+  _mm_storeu_ps(dst, folded);
+}
+
+NOVELMIND_TARGET_AVX2 void accumulateAvx2(const f32 *row, f32 weight,
+                                          f32 *acc, usize count) {
+  const __m256 w = _mm256_set1_ps(weight);
+  usize i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(acc + i,
+                     _mm256_add_ps(_mm256_loadu_ps(acc + i),
+                                   _mm256_mul_ps(w, _mm256_loadu_ps(row + i))));
+  }
+  if (i < count) {
+    accumulateSse2(row + i, weight, acc + i, count - i);
+  }
+}
+
+#elif defined(NOVELMIND_RESAMPLE_NEON)
+
+void convolveNeon(const f32 *src, const f32 *weights, i32 count,
+                  f32 *dst) {
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (i32 k = 0; k < count; ++k) {
+    sum = vmlaq_n_f32(sum, vld1q_f32(src + k * 4), weights[k]);
+  }
+  vst1q_f32(dst, sum);
+}
+
+void accumulateNeon(const f32 *row, f32 weight, f32 *acc, usize count) {
+  for (usize i = 0; i < count; i += 4) {
+    vst1q_f32(acc + i,
+              vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(row + i), weight));
+  }
+}
+
+#endif
+
+struct Kernels {
+  ConvolveFn convolve;
+  AccumulateFn accumulate;
+};
+
+Kernels kernelsFor(Kernel kernel) {
+  switch (kernel) {
+#if defined(NOVELMIND_RESAMPLE_X86)
+  case Kernel::Sse2:
+    return Kernels{convolveSse2, accumulateSse2};
+  case Kernel::Avx2:
+    return Kernels{convolveAvx2, accumulateAvx2};
+#elif defined(NOVELMIND_RESAMPLE_NEON)
+  case Kernel::Neon:
+    return Kernels{convolveNeon, accumulateNeon};
+#endif
+  default:
+    return Kernels{convolveScalar, accumulateScalar};
+  }
+}
+
+/// Run work over [0, rows) split into contiguous ranges, one per thread
+void forEachRowRange(i32 rows, u32 threads,
+                     const std::function<void(i32, i32)> &work) {
+  const auto useful = static_cast<u32>(std::max(1, rows / kMinRowsPerThread));
+  threads = std::min(threads, useful);
+  if (threads <= 1) {
+    work(0, rows);
+    return;
+  }
+
+  const i32 perThread = (rows + static_cast<i32>(threads) - 1) /
+                        static_cast<i32>(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (i32 begin = perThread; begin < rows; begin += perThread) {
+    workers.emplace_back(work, begin, std::min(rows, begin + perThread));
+  }
+  work(0, std::min(rows, perThread));
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+} // namespace
+
+Result<RgbaImage> decodeImage(const std::vector<u8> &encoded) {
+  if (encoded.empty()) {
+    return Result<RgbaImage>::error("Empty image data");
+  }
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  stbi_uc *pixels = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(encoded.data()),
+      static_cast<int>(encoded.size()), &width, &height, &channels, 4);
+  if (!pixels) {
+    const char *reason = stbi_failure_reason();
+    return Result<RgbaImage>::error(std::string("Failed to decode image: ") +
+                                    (reason ? reason : "unknown error"));
+  }
+
+  RgbaImage image;
+  image.width = width;
+  image.height = height;
+  image.pixels.assign(pixels, pixels + static_cast<usize>(width) *
+                                           static_cast<usize>(height) * 4);
+  stbi_image_free(pixels);
+  return Result<RgbaImage>::ok(std::move(image));
+}
+
+Result<RgbaImage> resampleImage(const u8 *rgba, i32 width, i32 height,
+                                i32 targetWidth, i32 targetHeight,
+                                const ResampleOptions &options) {
+  if (!rgba || width <= 0 || height <= 0 || targetWidth <= 0 ||
+      targetHeight <= 0) {
+    return Result<RgbaImage>::error("Invalid image size for resampling");
+  }
+
+  RgbaImage image;
+  image.width = targetWidth;
+  image.height = targetHeight;
+  const usize srcStride = static_cast<usize>(width) * 4;
+  if (targetWidth == width && targetHeight == height) {
+    image.pixels.assign(rgba, rgba + srcStride * static_cast<usize>(height));
+    return Result<RgbaImage>::ok(std::move(image));
+  }
+
+  const ColorTables &tables = tablesFor(options.srgb);
+  const Kernels kernels = kernelsFor(kernelFor(options.simd));
+  const Contributions columns =
+      computeContributions(width, targetWidth, options.filter);
+  const Contributions rows =
+      computeContributions(height, targetHeight, options.filter);
+
+  u32 threads = 1;
+  if (static_cast<usize>(width) * static_cast<usize>(height) >=
+      kParallelPixels) {
+    threads = options.threads > 0
+                  ? options.threads
+                  : std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Each source row filtered horizontally to the target width
+  const usize rowFloats = static_cast<usize>(targetWidth) * 4;
+  std::vector<f32> filtered(static_cast<usize>(height) * rowFloats);
+  forEachRowRange(height, threads, [&](i32 begin, i32 end) {
+    std::vector<f32> line(srcStride);
+    for (i32 y = begin; y < end; ++y) {
+      decodeRow(tables, rgba + static_cast<usize>(y) * srcStride,
+                line.data(), width, options.premultiplied);
+      f32 *out = filtered.data() + static_cast<usize>(y) * rowFloats;
+      for (usize x = 0; x < static_cast<usize>(targetWidth); ++x) {
+        kernels.convolve(
+            line.data() + static_cast<usize>(columns.first[x]) * 4,
+            columns.weights.data() + x * columns.stride, columns.count[x],
+            out + x * 4);
+      }
+    }
+  });
+
+  // Then combined vertically into the output rows
+  image.pixels.resize(rowFloats * static_cast<usize>(targetHeight));
+  forEachRowRange(targetHeight, threads, [&](i32 begin, i32 end) {
+    std::vector<f32> sum(rowFloats);
+    for (i32 y = begin; y < end; ++y) {
+      const auto out = static_cast<usize>(y);
+      std::fill(sum.begin(), sum.end(), 0.0f);
+      const f32 *weights = rows.weights.data() + out * rows.stride;
+      for (i32 k = 0; k < rows.count[out]; ++k) {
+        const auto source = static_cast<usize>(rows.first[out] + k);
+        kernels.accumulate(filtered.data() + source * rowFloats, weights[k],
+                           sum.data(), rowFloats);
+      }
+      encodeRow(tables, sum.data(), image.pixels.data() + out * rowFloats,
+                targetWidth, options.premultiplied);
+    }
+  });
+
+  return Result<RgbaImage>::ok(std::move(image));
+}
+
+Result<RgbaImage> resampleToFit(const u8 *rgba, i32 width, i32 height,
+                                i32 maxWidth, i32 maxHeight,
+                                const ResampleOptions &options) {
+  if (maxWidth <= 0 || maxHeight <= 0) {
+    return Result<RgbaImage>::error("Invalid maximum image size");
+  }
+  const f64 scale =
+      std::min({1.0, static_cast<f64>(maxWidth) / std::max(width, 1),
+                static_cast<f64>(maxHeight) / std::max(height, 1)});
+  const auto fit = [scale](i32 size) {
+    return std::max(1, static_cast<i32>(std::lround(size * scale)));
+  };
+  return resampleImage(rgba, width, height, fit(width), fit(height),
+                       options);
+}
+
+void premultiplyAlpha(u8 *rgba, usize pixelCount) {
+  usize i = 0;
+#if defined(NOVELMIND_RESAMPLE_X86)
+  // Alpha is multiplied by 255 so it passes through unchanged
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+  const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+  const auto multiply = [&](__m128i pixels16) {
+    const __m128i alpha = _mm_shufflehi_epi16(
+        _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)),
+        _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i factor =
+        _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaOne);
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels16, factor),
+                                    _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+  };
+  for (; i + 4 <= pixelCount; i += 4) {
+    auto *p = reinterpret_cast<__m128i *>(rgba + i * 4);
+    const __m128i pixels = _mm_loadu_si128(p);
+    _mm_storeu_si128(
+        p, _mm_packus_epi16(multiply(_mm_unpacklo_epi8(pixels, zero)),
+                            multiply(_mm_unpackhi_epi8(pixels, zero))));
+  }
+#endif
+  for (; i < pixelCount; ++i) {
+    u8 *p = rgba + i * 4;
+    for (usize c = 0; c < 3; ++c) {
+      p[c] = mulDiv255(p[c], p[3]);
+    }
+  }
+}
+
+void unpremultiplyAlpha(u8 *rgba, usize pixelCount) {
+  for (usize i = 0; i < pixelCount; ++i) {
+    u8 *p = rgba + i * 4;
+    if (p[3] == 255) {
+      continue;
+    }
+    for (usize c = 0; c < 3; ++c) {
+      p[c] = unpremultiplyChannel(p[c], p[3]);
+    }
+  }
+}
+
+const char *resampleKernelName(bool simd) {
+  switch (kernelFor(simd)) {
+  case Kernel::Sse2:
+    return "sse2";
+  case Kernel::Avx2:
+    return "avx2";
+  case Kernel::Neon:
+    return "neon";
+  case Kernel::Scalar:
+    break;
+  }
+  return "scalar";
+}
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,196 @@
+#include "NovelMind/renderer/render_batch.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace NovelMind::renderer {
+
+namespace {
+
+struct Bounds {
+  f32 minX;
+  f32 minY;
+  f32 maxX;
+  f32 maxY;
+
+  [[nodiscard]] bool overlaps(const Bounds &other) const {
+    return minX < other.maxX && other.minX < maxX && minY < other.maxY &&
+           other.minY < maxY;
+  }
+
+  void merge(const Bounds &other) {
+    minX = std::min(minX, other.minX);
+    minY = std::min(minY, other.minY);
+    maxX = std::max(maxX, other.maxX);
+    maxY = std::max(maxY, other.maxY);
+  }
+};
+
+Bounds commandBounds(const RenderCommand &command) {
+  Bounds bounds{command.corners[0].x, command.corners[0].y,
+                command.corners[0].x, command.corners[0].y};
+  for (const auto &corner : command.corners) {
+    bounds.merge(Bounds{corner.x, corner.y, corner.x, corner.y});
+  }
+  return bounds;
+}
+
+bool sameState(const RenderBatch &batch, const RenderCommand &command) {
+  return batch.blendMode == command.blendMode &&
+         batch.texture == command.texture &&
+         batch.nativeTexture == command.nativeTexture;
+}
+
+} // namespace
+
+void RenderCommandBuffer::pushSprite(const Texture &texture,
+                                     const Rect &sourceRect,
+                                     const Transform2D &transform,
+                                     const Color &tint) {
+  if (!texture.isValid()) {
+    return;
+  }
+
+  // Same order as the fixed-function path: translate, rotate, scale, then
+  // shift by the anchor
+  const f32 radians = transform.rotation * 3.14159265358979f / 180.0f;
+  const f32 cosA = std::cos(radians);
+  const f32 sinA = std::sin(radians);
+  const auto place = [&](f32 localX, f32 localY) {
+    const f32 sx = (localX - transform.anchorX) * transform.scaleX;
+    const f32 sy = (localY - transform.anchorY) * transform.scaleY;
+    return Vec2(transform.x + sx * cosA - sy * sinA,
+                transform.y + sx * sinA + sy * cosA);
+  };
+
+  const auto width = static_cast<f32>(texture.getWidth());
+  const auto height = static_cast<f32>(texture.getHeight());
+  RenderCommand command{};
+  command.layer = m_layer;
+  command.blendMode = m_blendMode;
+  command.texture = &texture;
+  command.nativeTexture = texture.getNativeHandle();
+  command.corners[0] = place(0.0f, 0.0f);
+  command.corners[1] = place(sourceRect.width, 0.0f);
+  command.corners[2] = place(sourceRect.width, sourceRect.height);
+  command.corners[3] = place(0.0f, sourceRect.height);
+  command.u0 = sourceRect.x / width;
+  command.v0 = sourceRect.y / height;
+  command.u1 = (sourceRect.x + sourceRect.width) / width;
+  command.v1 = (sourceRect.y + sourceRect.height) / height;
+  command.color = tint;
+  m_commands.push_back(command);
+}
+
+void RenderCommandBuffer::pushRect(const Rect &rect, const Color &color) {
+  RenderCommand command{};
+  command.layer = m_layer;
+  command.blendMode = m_blendMode;
+  command.corners[0] = Vec2(rect.x, rect.y);
+  command.corners[1] = Vec2(rect.x + rect.width, rect.y);
+  command.corners[2] = Vec2(rect.x + rect.width, rect.y + rect.height);
+  command.corners[3] = Vec2(rect.x, rect.y + rect.height);
+  command.color = color;
+  m_commands.push_back(command);
+}
+
+void RenderCommandBuffer::build(RenderBatchList &out) const {
+  out.clear();
+  if (m_commands.empty()) {
+    return;
+  }
+
+  std::vector<u32> order(m_commands.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [this](u32 a, u32 b) {
+    return m_commands[a].layer < m_commands[b].layer;
+  });
+
+  // Assign each command to a batch, in sorted order
+  std::vector<Bounds> batchBounds;
+  std::vector<u32> batchOf(m_commands.size());
+  usize layerStart = 0;
+  for (usize i = 0; i < order.size(); ++i) {
+    const RenderCommand &command = m_commands[order[i]];
+    if (i > 0 && command.layer != m_commands[order[i - 1]].layer) {
+      layerStart = out.batches.size();
+    }
+    const Bounds bounds = commandBounds(command);
+
+    usize target = out.batches.size();
+    const usize stop =
+        std::max(layerStart, out.batches.size() -
+                                 std::min(out.batches.size(),
+                                          kMaxBatchLookback));
+    for (usize b = out.batches.size(); b > stop; --b) {
+      if (sameState(out.batches[b - 1], command)) {
+        target = b - 1;
+        break;
+      }
+      if (batchBounds[b - 1].overlaps(bounds)) {
+        break;
+      }
+    }
+
+    if (target == out.batches.size()) {
+      RenderBatch batch;
+      batch.layer = command.layer;
+      batch.blendMode = command.blendMode;
+      batch.texture = command.texture;
+      batch.nativeTexture = command.nativeTexture;
+      out.batches.push_back(batch);
+      batchBounds.push_back(bounds);
+    } else {
+      batchBounds[target].merge(bounds);
+    }
+    out.batches[target].indexCount += 6;
+    batchOf[order[i]] = static_cast<u32>(target);
+  }
+
+  u32 firstIndex = 0;
+  for (auto &batch : out.batches) {
+    batch.firstIndex = firstIndex;
+    firstIndex += batch.indexCount;
+  }
+
+  // Emit quads batch by batch, keeping recorded order inside each batch
+  std::vector<u32> cursor(out.batches.size());
+  for (usize b = 0; b < out.batches.size(); ++b) {
+    cursor[b] = out.batches[b].firstIndex / 6;
+  }
+  std::vector<u32> slotOf(m_commands.size());
+  for (u32 index : order) {
+    slotOf[index] = cursor[batchOf[index]]++;
+  }
+
+  out.vertices.resize(m_commands.size() * 4);
+  out.indices.resize(m_commands.size() * 6);
+  for (usize i = 0; i < m_commands.size(); ++i) {
+    const RenderCommand &command = m_commands[i];
+    const u32 slot = slotOf[i];
+    const f32 us[4] = {command.u0, command.u1, command.u1, command.u0};
+    const f32 vs[4] = {command.v0, command.v0, command.v1, command.v1};
+    RenderVertex *vertex = &out.vertices[slot * 4];
+    for (usize c = 0; c < 4; ++c) {
+      vertex[c] = RenderVertex{command.corners[c].x,
+                               command.corners[c].y,
+                               us[c],
+                               vs[c],
+                               command.color.r,
+                               command.color.g,
+                               command.color.b,
+                               command.color.a};
+    }
+    const u32 base = slot * 4;
+    u32 *index = &out.indices[slot * 6];
+    index[0] = base;
+    index[1] = base + 1;
+    index[2] = base + 2;
+    index[3] = base;
+    index[4] = base + 2;
+    index[5] = base + 3;
+  }
+}
+
+} // namespace NovelMind::renderer
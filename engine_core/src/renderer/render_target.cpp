@@ -0,0 +1,82 @@
+#include "NovelMind/renderer/render_target.hpp"
+#include "NovelMind/renderer/renderer.hpp"
+
+namespace NovelMind::renderer {
+
+void RenderTarget::draw(IRenderer &renderer, const Transform2D &transform,
+                        const Color &tint) const {
+  drawPart(renderer,
+           Rect{0.0f, 0.0f, static_cast<f32>(m_width),
+                static_cast<f32>(m_height)},
+           transform, tint);
+}
+
+void RenderTarget::drawRegion(IRenderer &renderer, const Rect &region,
+                              const Color &tint) const {
+  Transform2D transform;
+  transform.x = region.x;
+  transform.y = region.y;
+  drawPart(renderer, region, transform, tint);
+}
+
+void RenderTarget::drawPart(IRenderer &renderer, const Rect &region,
+                            Transform2D transform, const Color &tint) const {
+  if (!m_texture.isValid() || region.width <= 0.0f ||
+      region.height <= 0.0f) {
+    return;
+  }
+  Rect source = region;
+  if (m_bottomUp) {
+    // Sample the mirrored rows and mirror the quad back
+    source.y = static_cast<f32>(m_height) - region.y - region.height;
+    transform.anchorY = region.height - transform.anchorY;
+    transform.scaleY = -transform.scaleY;
+  }
+  renderer.drawSprite(m_texture, source, transform, tint);
+}
+
+void RenderTarget::release() {
+  m_texture.destroy();
+  m_width = 0;
+  m_height = 0;
+  m_bottomUp = false;
+  m_captured = false;
+}
+
+void RenderTarget::storePixels(const u8 *rgba, i32 width, i32 height) {
+  if (m_texture.isValid() && !m_texture.getPixels().empty() &&
+      m_texture.getWidth() == width && m_texture.getHeight() == height) {
+    m_texture.uploadRows(rgba, 0, height);
+  } else {
+    const usize size =
+        static_cast<usize>(width) * static_cast<usize>(height) * 4;
+    m_texture.adoptPixels(std::vector<u8>(rgba, rgba + size), width, height);
+  }
+  m_width = width;
+  m_height = height;
+  m_bottomUp = false;
+  m_captured = true;
+}
+
+Texture &RenderTarget::allocateTexture(i32 width, i32 height) {
+  if (!m_texture.isValid() || !m_texture.getPixels().empty() ||
+      m_texture.getWidth() != width || m_texture.getHeight() != height) {
+    m_texture.beginUpload(width, height);
+    m_texture.finishUpload();
+  }
+  m_width = width;
+  m_height = height;
+  m_bottomUp = true;
+  m_captured = true;
+  return m_texture;
+}
+
+void RenderTarget::storeEmpty(i32 width, i32 height) {
+  m_texture.destroy();
+  m_width = width;
+  m_height = height;
+  m_bottomUp = false;
+  m_captured = true;
+}
+
+} // namespace NovelMind::renderer
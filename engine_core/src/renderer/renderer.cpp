@@ -1,8 +1,10 @@
 #include "NovelMind/renderer/renderer.hpp"
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
 #include "NovelMind/core/logger.hpp"
 #include "NovelMind/platform/window.hpp"
+#include <cstdlib>
 #include <limits>
-#include <unordered_map>
 
 #if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
 #include <SDL.h>
@@ -69,6 +71,12 @@ public:
     // Nothing to do
   }
 
+  bool captureFrame(RenderTarget &target) override {
+    // Nothing is drawn, so there are no pixels to keep
+    target.storeEmpty(m_width, m_height);
+    return true;
+  }
+
   [[nodiscard]] i32 getWidth() const override { return m_width; }
 
   [[nodiscard]] i32 getHeight() const override { return m_height; }
@@ -80,7 +88,7 @@ private:
 
 #if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
 
-class SDLOpenGLRenderer : public IRenderer {
+class SDLOpenGLRenderer : public BatchingRenderer {
 public:
   SDLOpenGLRenderer() = default;
   ~SDLOpenGLRenderer() override { shutdown(); }
@@ -113,14 +121,19 @@ public:
     glLoadIdentity();
 
     glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    applyBlendMode(BlendMode::Alpha);
+
+    // Geometry comes from the batch list as client-side arrays
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
 
     NOVELMIND_LOG_INFO("SDL OpenGL renderer initialized");
     return Result<void>::ok();
   }
 
   void shutdown() override {
+    releaseFontAtlases();
     if (m_glContext && m_window) {
       SDL_GL_DeleteContext(m_glContext);
       m_glContext = nullptr;
@@ -129,24 +142,64 @@ public:
   }
 
   void beginFrame() override {
+    BatchingRenderer::beginFrame();
     glClearColor(0.05f, 0.05f, 0.06f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glLoadIdentity();
   }
 
-  void endFrame() override {
+protected:
+  void submit(const RenderBatchList &batches,
+              const std::optional<Color> &clearColor) override {
+    if (clearColor) {
+      glClearColor(clearColor->r / 255.0f, clearColor->g / 255.0f,
+                   clearColor->b / 255.0f, clearColor->a / 255.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+    if (batches.batches.empty()) {
+      return;
+    }
+
+    const auto stride = static_cast<GLsizei>(sizeof(RenderVertex));
+    const RenderVertex *vertices = batches.vertices.data();
+    glVertexPointer(2, GL_FLOAT, stride, &vertices->x);
+    glTexCoordPointer(2, GL_FLOAT, stride, &vertices->u);
+    glColorPointer(4, GL_UNSIGNED_BYTE, stride, &vertices->r);
+
+    for (const auto &batch : batches.batches) {
+      applyBlendMode(batch.blendMode);
+      bindTexture(batch.nativeTexture, batch.texture != nullptr);
+      glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(batch.indexCount),
+                     GL_UNSIGNED_INT,
+                     batches.indices.data() + batch.firstIndex);
+    }
+  }
+
+  void present() override {
     if (m_window) {
       SDL_GL_SwapWindow(m_window);
     }
   }
 
-  void clear(const Color &color) override {
-    glClearColor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-                 color.a / 255.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  bool copyFrame(RenderTarget &target) override {
+    if (m_width <= 0 || m_height <= 0) {
+      return false;
+    }
+    // GL 1.1 copy from the back buffer; rows arrive bottom-up
+    Texture &texture = target.allocateTexture(m_width, m_height);
+    const auto handle =
+        reinterpret_cast<uintptr_t>(texture.getNativeHandle());
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(handle));
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, m_width, m_height);
+    return true;
   }
 
-  void setBlendMode(BlendMode mode) override {
+private:
+  void applyBlendMode(BlendMode mode) {
+    if (m_blendMode == mode) {
+      return;
+    }
+    m_blendMode = mode;
     switch (mode) {
     case BlendMode::None:
       glDisable(GL_BLEND);
@@ -166,196 +219,64 @@ public:
     }
   }
 
-  void drawSprite(const Texture &texture, const Transform2D &transform,
-                  const Color &tint) override {
-    if (!texture.isValid()) {
-      return;
+  void bindTexture(void *nativeTexture, bool textured) {
+    const auto handle = reinterpret_cast<uintptr_t>(nativeTexture);
+    if (handle > static_cast<uintptr_t>(std::numeric_limits<GLuint>::max())) {
+      textured = false;
     }
-    drawTexturedQuad(texture, Rect{0, 0, static_cast<f32>(texture.getWidth()),
-                                   static_cast<f32>(texture.getHeight())},
-                     transform, tint);
-  }
-
-  void drawSprite(const Texture &texture, const Rect &sourceRect,
-                  const Transform2D &transform,
-                  const Color &tint) override {
-    if (!texture.isValid()) {
-      return;
+    if (textured != m_textured) {
+      textured ? glEnable(GL_TEXTURE_2D) : glDisable(GL_TEXTURE_2D);
+      m_textured = textured;
     }
-    drawTexturedQuad(texture, sourceRect, transform, tint);
-  }
-
-  void drawRect(const Rect &rect, const Color &color) override {
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              color.a / 255.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(rect.x, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y + rect.height);
-    glVertex2f(rect.x, rect.y + rect.height);
-    glEnd();
-  }
-
-  void fillRect(const Rect &rect, const Color &color) override {
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              color.a / 255.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(rect.x, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y + rect.height);
-    glVertex2f(rect.x, rect.y + rect.height);
-    glEnd();
-  }
-
-  void drawText(const Font &font, const std::string &text, f32 x, f32 y,
-                const Color &color) override {
-    if (text.empty()) {
-      return;
+    if (textured) {
+      glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(handle));
     }
+  }
 
-    auto atlas = getOrBuildAtlas(font);
-    if (!atlas || !atlas->isValid()) {
-      return;
-    }
+  SDL_Window *m_window = nullptr;
+  SDL_GLContext m_glContext = nullptr;
+  // Last GL state set, so unchanged state between batches is not resent
+  std::optional<BlendMode> m_blendMode;
+  bool m_textured = true;
+};
+#endif // NOVELMIND_HAS_SDL2 && NOVELMIND_HAS_OPENGL
 
-    const Texture &texture = atlas->getAtlasTexture();
-    if (!texture.isValid()) {
-      return;
-    }
+namespace {
 
-    f32 penX = x;
-    f32 baseline = y + static_cast<f32>(atlas->getLineHeight());
-
-    for (char c : text) {
-      if (c == '\n') {
-        penX = x;
-        baseline += static_cast<f32>(atlas->getLineHeight());
-        continue;
-      }
-
-      const auto *glyph =
-          atlas->getGlyph(static_cast<unsigned char>(c));
-      if (!glyph) {
-        penX += static_cast<f32>(font.getSize()) * 0.5f;
-        continue;
-      }
-
-      Rect src{glyph->uv.x * texture.getWidth(),
-               glyph->uv.y * texture.getHeight(),
-               glyph->uv.width * texture.getWidth(),
-               glyph->uv.height * texture.getHeight()};
-
-      Transform2D transform;
-      transform.x = penX + glyph->bearingX;
-      transform.y = baseline - glyph->bearingY;
-      transform.scaleX = 1.0f;
-      transform.scaleY = 1.0f;
-      transform.rotation = 0.0f;
-      transform.anchorX = 0.0f;
-      transform.anchorY = 0.0f;
-
-      drawTexturedQuad(texture, src, transform, color);
-
-      penX += glyph->advanceX;
-    }
+RendererBackend backendFromEnvironment() {
+  const char *value = std::getenv("NOVELMIND_RENDERER");
+  if (!value) {
+    return RendererBackend::Default;
   }
-
-  void setFade(f32 alpha, const Color &color) override {
-    glDisable(GL_TEXTURE_2D);
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              alpha);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(static_cast<f32>(m_width), 0);
-    glVertex2f(static_cast<f32>(m_width), static_cast<f32>(m_height));
-    glVertex2f(0, static_cast<f32>(m_height));
-    glEnd();
-    glEnable(GL_TEXTURE_2D);
+  const std::string name(value);
+  if (name == "opengl") {
+    return RendererBackend::OpenGL;
   }
-
-  [[nodiscard]] i32 getWidth() const override { return m_width; }
-  [[nodiscard]] i32 getHeight() const override { return m_height; }
-
-private:
-  std::shared_ptr<FontAtlas> getOrBuildAtlas(const Font &font) {
-    const Font *key = &font;
-    auto it = m_fontAtlases.find(key);
-    if (it != m_fontAtlases.end()) {
-      return it->second;
-    }
-
-    auto atlas = std::make_shared<FontAtlas>();
-    static const std::string kDefaultCharset = []() {
-      std::string charset;
-      charset.reserve(95);
-      for (int c = 32; c <= 126; ++c) {
-        charset.push_back(static_cast<char>(c));
-      }
-      return charset;
-    }();
-
-    auto buildResult = atlas->build(font, kDefaultCharset);
-    if (buildResult.isError()) {
-      NOVELMIND_LOG_WARN("Failed to build font atlas: " +
-                         buildResult.error());
-    }
-
-    m_fontAtlases[key] = atlas;
-    return atlas;
+  if (name == "software") {
+    return RendererBackend::Software;
   }
-
-  void drawTexturedQuad(const Texture &texture, const Rect &sourceRect,
-                        const Transform2D &transform, const Color &tint) {
-    const auto handle =
-        reinterpret_cast<uintptr_t>(texture.getNativeHandle());
-    if (handle > static_cast<uintptr_t>(std::numeric_limits<GLuint>::max())) {
-      return;
-    }
-    GLuint texId = static_cast<GLuint>(handle);
-    glBindTexture(GL_TEXTURE_2D, texId);
-
-    glPushMatrix();
-    glTranslatef(transform.x, transform.y, 0.0f);
-    glRotatef(transform.rotation, 0.0f, 0.0f, 1.0f);
-    glScalef(transform.scaleX, transform.scaleY, 1.0f);
-    glTranslatef(-transform.anchorX, -transform.anchorY, 0.0f);
-
-    const f32 u0 = sourceRect.x / static_cast<f32>(texture.getWidth());
-    const f32 v0 = sourceRect.y / static_cast<f32>(texture.getHeight());
-    const f32 u1 =
-        (sourceRect.x + sourceRect.width) / static_cast<f32>(texture.getWidth());
-    const f32 v1 = (sourceRect.y + sourceRect.height) /
-                   static_cast<f32>(texture.getHeight());
-
-    glColor4f(tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f,
-              tint.a / 255.0f);
-
-    glBegin(GL_QUADS);
-    glTexCoord2f(u0, v0);
-    glVertex2f(0.0f, 0.0f);
-
-    glTexCoord2f(u1, v0);
-    glVertex2f(sourceRect.width, 0.0f);
-
-    glTexCoord2f(u1, v1);
-    glVertex2f(sourceRect.width, sourceRect.height);
-
-    glTexCoord2f(u0, v1);
-    glVertex2f(0.0f, sourceRect.height);
-    glEnd();
-
-    glPopMatrix();
+  if (name == "null") {
+    return RendererBackend::Null;
   }
+  NOVELMIND_LOG_WARN("Unknown NOVELMIND_RENDERER value: " + name);
+  return RendererBackend::Default;
+}
 
-  SDL_Window *m_window = nullptr;
-  SDL_GLContext m_glContext = nullptr;
-  i32 m_width = 0;
-  i32 m_height = 0;
-  std::unordered_map<const Font *, std::shared_ptr<FontAtlas>> m_fontAtlases;
-};
-#endif // NOVELMIND_HAS_SDL2 && NOVELMIND_HAS_OPENGL
+} // namespace
 
-std::unique_ptr<IRenderer> createRenderer() {
+std::unique_ptr<IRenderer> createRenderer(RendererBackend backend) {
+  if (backend == RendererBackend::Default) {
+    backend = backendFromEnvironment();
+  }
+  switch (backend) {
+  case RendererBackend::Software:
+    return std::make_unique<SoftwareRenderer>();
+  case RendererBackend::Null:
+    return std::make_unique<NullRenderer>();
+  case RendererBackend::Default:
+  case RendererBackend::OpenGL:
+    break;
+  }
 #if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
   return std::make_unique<SDLOpenGLRenderer>();
 #else
@@ -0,0 +1,731 @@
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/core/cpu_features.hpp"
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/platform/window.hpp"
+#include "NovelMind/renderer/texture.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NOVELMIND_RASTER_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define NOVELMIND_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NOVELMIND_TARGET_AVX2
+#endif
+#endif
+
+namespace NovelMind::renderer {
+
+namespace {
+
+// Pixels are RGBA8 in memory, so R is the low byte of a loaded u32
+
+struct TextureView {
+  const u32 *texels;
+  i32 width;
+  i32 height;
+};
+
+/// Texel-space sampling position (16.16 fixed point) at a span's first
+/// pixel and its step per pixel
+struct SpanCoords {
+  i64 u;
+  i64 v;
+  i64 du;
+  i64 dv;
+};
+
+using SampleFn = void (*)(const TextureView &, SpanCoords, u32 tint, u32 *out,
+                          usize count);
+using BlendFn = void (*)(BlendMode, const u32 *src, u32 *dst, usize count);
+
+constexpr u32 kWhite = 0xFFFFFFFFu;
+
+// x * y / 255, rounded; exact for all 8-bit inputs
+inline u32 mulDiv255(u32 x, u32 y) {
+  const u32 t = x * y + 128;
+  return (t + (t >> 8)) >> 8;
+}
+
+inline u32 channel(u32 pixel, u32 shift) { return (pixel >> shift) & 0xFF; }
+
+inline u32 tintPixel(u32 pixel, u32 tint) {
+  u32 out = 0;
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    out |= mulDiv255(channel(pixel, shift), channel(tint, shift)) << shift;
+  }
+  return out;
+}
+
+inline u32 blendPixel(BlendMode mode, u32 src, u32 dst) {
+  const u32 alpha = src >> 24;
+  u32 out = 0;
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    const u32 s = channel(src, shift);
+    const u32 d = channel(dst, shift);
+    u32 value = s;
+    switch (mode) {
+    case BlendMode::None:
+      break;
+    case BlendMode::Alpha:
+      value = mulDiv255(s, alpha) + mulDiv255(d, 255 - alpha);
+      break;
+    case BlendMode::Additive:
+      value = mulDiv255(s, alpha) + d;
+      break;
+    case BlendMode::Multiply:
+      value = mulDiv255(s, d) + mulDiv255(d, 255 - alpha);
+      break;
+    }
+    out |= std::min<u32>(value, 255) << shift;
+  }
+  return out;
+}
+
+struct Texel {
+  i32 x0;
+  i32 x1;
+  i32 y0;
+  i32 y1;
+  u32 fx; // 0..255 weight of x1
+  u32 fy;
+};
+
+inline Texel locate(const TextureView &texture, i64 u, i64 v) {
+  const i64 ix = u >> 16;
+  const i64 iy = v >> 16;
+  const i64 maxX = texture.width - 1;
+  const i64 maxY = texture.height - 1;
+  return Texel{static_cast<i32>(std::clamp<i64>(ix, 0, maxX)),
+               static_cast<i32>(std::clamp<i64>(ix + 1, 0, maxX)),
+               static_cast<i32>(std::clamp<i64>(iy, 0, maxY)),
+               static_cast<i32>(std::clamp<i64>(iy + 1, 0, maxY)),
+               static_cast<u32>((u >> 8) & 0xFF),
+               static_cast<u32>((v >> 8) & 0xFF)};
+}
+
+inline u32 fetch(const TextureView &texture, i32 x, i32 y) {
+  return texture.texels[static_cast<usize>(y) *
+                            static_cast<usize>(texture.width) +
+                        static_cast<usize>(x)];
+}
+
+// Spans that step one texel per pixel from a texel centre need no
+// filtering: bilinear weights are all zero there
+bool isTexelAligned(const SpanCoords &coords) {
+  return coords.du == 65536 && coords.dv == 0 && (coords.u & 0xFFFF) == 0 &&
+         (coords.v & 0xFFFF) == 0;
+}
+
+void copyAligned(const TextureView &texture, SpanCoords coords, u32 *out,
+                 usize count) {
+  const i32 row =
+      static_cast<i32>(std::clamp<i64>(coords.v >> 16, 0, texture.height - 1));
+  const u32 *texels =
+      texture.texels + static_cast<usize>(row) * static_cast<usize>(
+                                                     texture.width);
+  i64 x = coords.u >> 16;
+  usize i = 0;
+  for (; i < count && x < 0; ++i, ++x) {
+    out[i] = texels[0];
+  }
+  if (i < count && x < texture.width) {
+    const usize run = std::min<usize>(count - i,
+                                      static_cast<usize>(texture.width - x));
+    std::memcpy(out + i, texels + x, run * sizeof(u32));
+    i += run;
+  }
+  for (; i < count; ++i) {
+    out[i] = texels[texture.width - 1];
+  }
+}
+
+void sampleScalar(const TextureView &texture, SpanCoords coords, u32 tint,
+                  u32 *out, usize count) {
+  if (isTexelAligned(coords)) {
+    copyAligned(texture, coords, out, count);
+    if (tint != kWhite) {
+      for (usize i = 0; i < count; ++i) {
+        out[i] = tintPixel(out[i], tint);
+      }
+    }
+    return;
+  }
+
+  for (usize i = 0; i < count; ++i) {
+    const Texel t = locate(texture, coords.u, coords.v);
+    const u32 c00 = fetch(texture, t.x0, t.y0);
+    const u32 c10 = fetch(texture, t.x1, t.y0);
+    const u32 c01 = fetch(texture, t.x0, t.y1);
+    const u32 c11 = fetch(texture, t.x1, t.y1);
+    u32 pixel = 0;
+    for (u32 shift = 0; shift < 32; shift += 8) {
+      const u32 top =
+          (channel(c00, shift) * (256 - t.fx) + channel(c10, shift) * t.fx) >>
+          8;
+      const u32 bottom =
+          (channel(c01, shift) * (256 - t.fx) + channel(c11, shift) * t.fx) >>
+          8;
+      pixel |= ((top * (256 - t.fy) + bottom * t.fy) >> 8) << shift;
+    }
+    out[i] = tint == kWhite ? pixel : tintPixel(pixel, tint);
+    coords.u += coords.du;
+    coords.v += coords.dv;
+  }
+}
+
+void blendScalar(BlendMode mode, const u32 *src, u32 *dst, usize count) {
+  if (mode == BlendMode::None) {
+    std::memcpy(dst, src, count * sizeof(u32));
+    return;
+  }
+  for (usize i = 0; i < count; ++i) {
+    dst[i] = blendPixel(mode, src[i], dst[i]);
+  }
+}
+
+#ifdef NOVELMIND_RASTER_X86
+
+// SSE2 is part of x86-64, so these need no target attribute
+
+inline __m128i mulDiv255(__m128i x, __m128i y) {
+  const __m128i t =
+      _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline __m128i broadcastAlpha(__m128i pixels16) {
+  return _mm_shufflehi_epi16(
+      _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m128i blend16(BlendMode mode, __m128i s, __m128i d) {
+  const __m128i alpha = broadcastAlpha(s);
+  const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+  switch (mode) {
+  case BlendMode::None:
+    return s;
+  case BlendMode::Alpha:
+    return _mm_add_epi16(mulDiv255(s, alpha), mulDiv255(d, inverse));
+  case BlendMode::Additive:
+    return _mm_add_epi16(mulDiv255(s, alpha), d);
+  case BlendMode::Multiply:
+    return _mm_add_epi16(mulDiv255(s, d), mulDiv255(d, inverse));
+  }
+  return s;
+}
+
+void blendSse2(BlendMode mode, const u32 *src, u32 *dst, usize count) {
+  if (mode == BlendMode::None) {
+    std::memcpy(dst, src, count * sizeof(u32));
+    return;
+  }
+  const __m128i zero = _mm_setzero_si128();
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i *>(dst + i));
+    const __m128i low = blend16(mode, _mm_unpacklo_epi8(s, zero),
+                                _mm_unpacklo_epi8(d, zero));
+    const __m128i high = blend16(mode, _mm_unpackhi_epi8(s, zero),
+                                 _mm_unpackhi_epi8(d, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_packus_epi16(low, high));
+  }
+  blendScalar(mode, src + i, dst + i, count - i);
+}
+
+void tintSse2(u32 *pixels, usize count, u32 tint) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i tint16 = _mm_unpacklo_epi8(
+      _mm_set1_epi32(static_cast<int>(tint)), zero);
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto *at = reinterpret_cast<__m128i *>(pixels + i);
+    const __m128i p = _mm_loadu_si128(at);
+    _mm_storeu_si128(
+        at, _mm_packus_epi16(
+                mulDiv255(_mm_unpacklo_epi8(p, zero), tint16),
+                mulDiv255(_mm_unpackhi_epi8(p, zero), tint16)));
+  }
+  for (; i < count; ++i) {
+    pixels[i] = tintPixel(pixels[i], tint);
+  }
+}
+
+void sampleSse2(const TextureView &texture, SpanCoords coords, u32 tint,
+                u32 *out, usize count) {
+  if (isTexelAligned(coords)) {
+    copyAligned(texture, coords, out, count);
+    if (tint != kWhite) {
+      tintSse2(out, count, tint);
+    }
+    return;
+  }
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i tint16 = _mm_unpacklo_epi8(
+      _mm_cvtsi32_si128(static_cast<int>(tint)), zero);
+  for (usize i = 0; i < count; ++i) {
+    const Texel t = locate(texture, coords.u, coords.v);
+    const auto load = [&](i32 x, i32 y) {
+      return _mm_cvtsi32_si128(static_cast<int>(fetch(texture, x, y)));
+    };
+    // Lanes 0-3 hold the left texel's channels, lanes 4-7 the right one's
+    const __m128i top =
+        _mm_unpacklo_epi8(_mm_unpacklo_epi32(load(t.x0, t.y0),
+                                             load(t.x1, t.y0)),
+                          zero);
+    const __m128i bottom =
+        _mm_unpacklo_epi8(_mm_unpacklo_epi32(load(t.x0, t.y1),
+                                             load(t.x1, t.y1)),
+                          zero);
+    const auto fx = static_cast<short>(t.fx);
+    const auto fy = static_cast<short>(t.fy);
+    const auto ifx = static_cast<short>(256 - t.fx);
+    const auto ify = static_cast<short>(256 - t.fy);
+    const __m128i wx = _mm_set_epi16(fx, fx, fx, fx, ifx, ifx, ifx, ifx);
+    const __m128i wy = _mm_set_epi16(fy, fy, fy, fy, ify, ify, ify, ify);
+
+    const __m128i pt = _mm_mullo_epi16(top, wx);
+    const __m128i pb = _mm_mullo_epi16(bottom, wx);
+    const __m128i rowTop =
+        _mm_srli_epi16(_mm_add_epi16(pt, _mm_srli_si128(pt, 8)), 8);
+    const __m128i rowBottom =
+        _mm_srli_epi16(_mm_add_epi16(pb, _mm_srli_si128(pb, 8)), 8);
+    const __m128i pv =
+        _mm_mullo_epi16(_mm_unpacklo_epi64(rowTop, rowBottom), wy);
+    __m128i pixel =
+        _mm_srli_epi16(_mm_add_epi16(pv, _mm_srli_si128(pv, 8)), 8);
+    if (tint != kWhite) {
+      pixel = mulDiv255(pixel, tint16);
+    }
+    out[i] = static_cast<u32>(
+        _mm_cvtsi128_si32(_mm_packus_epi16(pixel, pixel)));
+    coords.u += coords.du;
+    coords.v += coords.dv;
+  }
+}
+
+NOVELMIND_TARGET_AVX2 inline __m256i mulDiv255Avx2(__m256i x, __m256i y) {
+  const __m256i t =
+      _mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+NOVELMIND_TARGET_AVX2 inline __m256i blend16Avx2(BlendMode mode, __m256i s,
+                                                  __m256i d) {
+  const __m256i alpha = _mm256_shufflehi_epi16(
+      _mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(3, 3, 3, 3));
+  const __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+  switch (mode) {
+  case BlendMode::None:
+    return s;
+  case BlendMode::Alpha:
+    return _mm256_add_epi16(mulDiv255Avx2(s, alpha),
+                            mulDiv255Avx2(d, inverse));
+  case BlendMode::Additive:
+    return _mm256_add_epi16(mulDiv255Avx2(s, alpha), d);
+  case BlendMode::Multiply:
+    return _mm256_add_epi16(mulDiv255Avx2(s, d), mulDiv255Avx2(d, inverse));
+  }
+  return s;
+}
+
+// Unpack and pack both work within 128-bit lanes, so pixels come back in
+// their original order
+NOVELMIND_TARGET_AVX2 void blendAvx2(BlendMode mode, const u32 *src, u32 *dst,
+                                     usize count) {
+  if (mode == BlendMode::None) {
+    std::memcpy(dst, src, count * sizeof(u32));
+    return;
+  }
+  const __m256i zero = _mm256_setzero_si256();
+  usize i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    const __m256i d =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    const __m256i low = blend16Avx2(mode, _mm256_unpacklo_epi8(s, zero),
+                                    _mm256_unpacklo_epi8(d, zero));
+    const __m256i high = blend16Avx2(mode, _mm256_unpackhi_epi8(s, zero),
+                                     _mm256_unpackhi_epi8(d, zero));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_packus_epi16(low, high));
+  }
+  blendSse2(mode, src + i, dst + i, count - i);
+}
+
+#endif // NOVELMIND_RASTER_X86
+
+struct Kernels {
+  SampleFn sample;
+  BlendFn blend;
+};
+
+Kernels kernelsFor(RasterEngine engine) {
+  switch (engine) {
+#ifdef NOVELMIND_RASTER_X86
+  case RasterEngine::Sse2:
+    return Kernels{sampleSse2, blendSse2};
+  case RasterEngine::Avx2:
+    // Bilinear fetches are scattered, so sampling stays 128-bit wide
+    return Kernels{sampleSse2, blendAvx2};
+#endif
+  default:
+    return Kernels{sampleScalar, blendScalar};
+  }
+}
+
+u32 packColor(u8 r, u8 g, u8 b, u8 a) {
+  return static_cast<u32>(r) | (static_cast<u32>(g) << 8) |
+         (static_cast<u32>(b) << 16) | (static_cast<u32>(a) << 24);
+}
+
+/// Pixel centres x + 0.5 where a * x + b lies in [0, 1) narrow [lo, hi)
+void clipUnitRange(f64 a, f64 b, f64 &lo, f64 &hi) {
+  if (std::abs(a) < 1e-12) {
+    if (b < 0.0 || b >= 1.0) {
+      hi = lo;
+    }
+    return;
+  }
+  const f64 atZero = -b / a;
+  const f64 atOne = (1.0 - b) / a;
+  lo = std::max(lo, std::min(atZero, atOne));
+  hi = std::min(hi, std::max(atZero, atOne));
+}
+
+} // namespace
+
+struct SoftwareRenderer::Workers {
+  explicit Workers(u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+      threads.emplace_back([this]() { loop(); });
+    }
+  }
+
+  ~Workers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  /// Run @p work on every worker and the calling thread, and wait for all
+  void run(const std::function<void()> &work) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = &work;
+      pending = static_cast<u32>(threads.size());
+      ++generation;
+    }
+    wake.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return pending == 0; });
+    job = nullptr;
+  }
+
+  void loop() {
+    u64 seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wake.wait(lock, [&]() { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      const auto *work = job;
+      lock.unlock();
+      (*work)();
+      lock.lock();
+      if (--pending == 0) {
+        finished.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  const std::function<void()> *job = nullptr;
+  u32 pending = 0;
+  u64 generation = 0;
+  bool stopping = false;
+};
+
+SoftwareRenderer::SoftwareRenderer() : m_engine(bestEngine()) {
+  setThreadCount(0);
+}
+
+SoftwareRenderer::SoftwareRenderer(i32 width, i32 height)
+    : SoftwareRenderer() {
+  resize(width, height);
+}
+
+SoftwareRenderer::~SoftwareRenderer() { shutdown(); }
+
+Result<void> SoftwareRenderer::initialize(platform::IWindow &window) {
+  if (!m_previousGpuUpload) {
+    m_previousGpuUpload = Texture::isGpuUploadEnabled();
+  }
+  Texture::setGpuUploadEnabled(false);
+  resize(window.getWidth(), window.getHeight());
+  NOVELMIND_LOG_INFO("Software renderer initialized (" +
+                     std::to_string(threadCount()) + " threads)");
+  return Result<void>::ok();
+}
+
+void SoftwareRenderer::shutdown() {
+  releaseFontAtlases();
+  if (m_previousGpuUpload) {
+    Texture::setGpuUploadEnabled(*m_previousGpuUpload);
+    m_previousGpuUpload.reset();
+  }
+}
+
+void SoftwareRenderer::beginFrame() {
+  BatchingRenderer::beginFrame();
+  m_clip = Clip{0, 0, m_width, m_height};
+  clearClip(m_frameClear);
+}
+
+bool SoftwareRenderer::beginPartialFrame(const Rect &region) {
+  BatchingRenderer::beginFrame();
+  // Whole pixels touching region
+  const auto edge = [](f32 value, i32 limit) {
+    return static_cast<i32>(
+        std::clamp(static_cast<f64>(value), 0.0, static_cast<f64>(limit)));
+  };
+  m_clip.left = edge(std::floor(region.x), m_width);
+  m_clip.top = edge(std::floor(region.y), m_height);
+  m_clip.right = edge(std::ceil(region.x + region.width), m_width);
+  m_clip.bottom = edge(std::ceil(region.y + region.height), m_height);
+  clearClip(m_frameClear);
+  return true;
+}
+
+void SoftwareRenderer::clearClip(const Color &color) {
+  const u32 packed = packColor(color.r, color.g, color.b, color.a);
+  if (m_clip.left >= m_clip.right) {
+    return;
+  }
+  for (i32 y = m_clip.top; y < m_clip.bottom; ++y) {
+    u32 *row = m_framebuffer.data() +
+               static_cast<usize>(y) * static_cast<usize>(m_width);
+    std::fill(row + m_clip.left, row + m_clip.right, packed);
+  }
+}
+
+void SoftwareRenderer::resize(i32 width, i32 height) {
+  m_width = std::max(width, 0);
+  m_height = std::max(height, 0);
+  m_framebuffer.assign(static_cast<usize>(m_width) *
+                           static_cast<usize>(m_height),
+                       0);
+  m_clip = Clip{0, 0, m_width, m_height};
+}
+
+void SoftwareRenderer::setThreadCount(u32 threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_workers = std::make_unique<Workers>(threads - 1);
+}
+
+u32 SoftwareRenderer::threadCount() const {
+  return static_cast<u32>(m_workers->threads.size()) + 1;
+}
+
+void SoftwareRenderer::setEngine(RasterEngine engine) {
+  m_engine = isEngineSupported(engine) ? engine : bestEngine();
+}
+
+bool SoftwareRenderer::isEngineSupported(RasterEngine engine) {
+  switch (engine) {
+  case RasterEngine::Scalar:
+    return true;
+  case RasterEngine::Sse2:
+#ifdef NOVELMIND_RASTER_X86
+    return true;
+#else
+    return false;
+#endif
+  case RasterEngine::Avx2:
+#ifdef NOVELMIND_RASTER_X86
+    return core::CpuFeatures::get().avx2;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+RasterEngine SoftwareRenderer::bestEngine() {
+  for (auto engine : {RasterEngine::Avx2, RasterEngine::Sse2}) {
+    if (isEngineSupported(engine)) {
+      return engine;
+    }
+  }
+  return RasterEngine::Scalar;
+}
+
+std::span<const u8> SoftwareRenderer::pixels() const {
+  return {reinterpret_cast<const u8 *>(m_framebuffer.data()),
+          m_framebuffer.size() * sizeof(u32)};
+}
+
+std::vector<u8> SoftwareRenderer::readPixels() const {
+  const auto view = pixels();
+  return {view.begin(), view.end()};
+}
+
+void SoftwareRenderer::submit(const RenderBatchList &batches,
+                              const std::optional<Color> &clearColor) {
+  if (clearColor) {
+    clearClip(*clearColor);
+  }
+  if (batches.batches.empty() || m_clip.left >= m_clip.right ||
+      m_clip.top >= m_clip.bottom) {
+    return;
+  }
+
+  // Bands stay aligned to kBandHeight rows and are trimmed to the clip
+  const i32 firstBand = m_clip.top / kBandHeight;
+  const i32 bandCount = (m_clip.bottom + kBandHeight - 1) / kBandHeight;
+  std::atomic<i32> nextBand{firstBand};
+  const std::function<void()> work = [&]() {
+    for (i32 band = nextBand.fetch_add(1); band < bandCount;
+         band = nextBand.fetch_add(1)) {
+      rasterizeBand(batches, std::max(m_clip.top, band * kBandHeight),
+                    std::min(m_clip.bottom, (band + 1) * kBandHeight));
+    }
+  };
+  m_workers->run(work);
+}
+
+bool SoftwareRenderer::copyFrame(RenderTarget &target) {
+  if (m_framebuffer.empty()) {
+    return false;
+  }
+  target.storePixels(pixels().data(), m_width, m_height);
+  return true;
+}
+
+void SoftwareRenderer::rasterizeBand(const RenderBatchList &batches,
+                                     i32 rowBegin, i32 rowEnd) {
+  const Kernels kernels = kernelsFor(m_engine);
+  std::vector<u32> span(static_cast<usize>(m_width));
+
+  for (const auto &batch : batches.batches) {
+    TextureView texture{nullptr, 0, 0};
+    if (batch.texture) {
+      const auto &texels = batch.texture->getPixels();
+      texture.width = batch.texture->getWidth();
+      texture.height = batch.texture->getHeight();
+      if (texels.size() != static_cast<usize>(texture.width) *
+                               static_cast<usize>(texture.height) * 4) {
+        continue; // Only on the GPU
+      }
+      texture.texels = reinterpret_cast<const u32 *>(texels.data());
+    }
+
+    for (u32 i = 0; i < batch.indexCount; i += 6) {
+      const RenderVertex *quad =
+          &batches.vertices[batches.indices[batch.firstIndex + i]];
+      const f64 originX = quad[0].x;
+      const f64 originY = quad[0].y;
+      const f64 e1x = static_cast<f64>(quad[1].x) - originX;
+      const f64 e1y = static_cast<f64>(quad[1].y) - originY;
+      const f64 e2x = static_cast<f64>(quad[3].x) - originX;
+      const f64 e2y = static_cast<f64>(quad[3].y) - originY;
+      const f64 det = e1x * e2y - e1y * e2x;
+      if (std::abs(det) < 1e-9) {
+        continue;
+      }
+
+      f64 minY = originY;
+      f64 maxY = originY;
+      for (int c = 1; c < 4; ++c) {
+        minY = std::min<f64>(minY, quad[c].y);
+        maxY = std::max<f64>(maxY, quad[c].y);
+      }
+      const i32 firstRow =
+          std::max(rowBegin, static_cast<i32>(std::ceil(std::max(
+                                 minY - 0.5, static_cast<f64>(rowBegin)))));
+      const i32 lastRow =
+          std::min(rowEnd, static_cast<i32>(std::ceil(std::min(
+                               maxY - 0.5, static_cast<f64>(rowEnd)))));
+
+      // s runs along edge 0-1 and t along edge 0-3, both in [0, 1)
+      const f64 dsdx = e2y / det;
+      const f64 dtdx = -e1y / det;
+      const u32 color =
+          packColor(quad[0].r, quad[0].g, quad[0].b, quad[0].a);
+      const f64 du = static_cast<f64>(quad[1].u - quad[0].u) * texture.width;
+      const f64 dv = static_cast<f64>(quad[3].v - quad[0].v) * texture.height;
+
+      for (i32 y = firstRow; y < lastRow; ++y) {
+        const f64 py = y + 0.5 - originY;
+        const f64 s0 = (-e2y * originX - e2x * py) / det;
+        const f64 t0 = (e1y * originX + e1x * py) / det;
+        const auto clipLeft = static_cast<f64>(m_clip.left);
+        const auto clipRight = static_cast<f64>(m_clip.right);
+        f64 lo = clipLeft;
+        f64 hi = clipRight;
+        clipUnitRange(dsdx, s0, lo, hi);
+        clipUnitRange(dtdx, t0, lo, hi);
+        const auto xBegin = static_cast<i32>(
+            std::clamp(std::ceil(lo - 0.5), clipLeft, clipRight));
+        const auto xEnd = static_cast<i32>(
+            std::clamp(std::ceil(hi - 0.5), clipLeft, clipRight));
+        if (xBegin >= xEnd) {
+          continue;
+        }
+        const auto count = static_cast<usize>(xEnd - xBegin);
+        u32 *row = m_framebuffer.data() +
+                   static_cast<usize>(y) * static_cast<usize>(m_width) +
+                   static_cast<usize>(xBegin);
+
+        if (texture.texels) {
+          const f64 cx = xBegin + 0.5;
+          const f64 s = dsdx * cx + s0;
+          const f64 t = dtdx * cx + t0;
+          const f64 u =
+              static_cast<f64>(quad[0].u) * texture.width + s * du - 0.5;
+          const f64 v =
+              static_cast<f64>(quad[0].v) * texture.height + t * dv - 0.5;
+          const SpanCoords coords{std::llround(u * 65536.0),
+                                  std::llround(v * 65536.0),
+                                  std::llround(dsdx * du * 65536.0),
+                                  std::llround(dtdx * dv * 65536.0)};
+          kernels.sample(texture, coords, color, span.data(), count);
+        } else {
+          std::fill_n(span.begin(), count, color);
+        }
+        kernels.blend(batch.blendMode, span.data(), row, count);
+      }
+    }
+  }
+}
+
+} // namespace NovelMind::renderer
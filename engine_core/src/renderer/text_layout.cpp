@@ -1,11 +1,122 @@
 #include "NovelMind/renderer/text_layout.hpp"
+#include "NovelMind/renderer/utf8.hpp"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <functional>
+#include <limits>
 #include <sstream>
 
+#if defined(NOVELMIND_HAS_FREETYPE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_ADVANCES_H
+#endif
+
 namespace NovelMind::renderer {
 
+namespace {
+
+/// A codepoint (or inline command) of the text being laid out
+struct LayoutItem {
+  char32_t codepoint;
+  f32 advance;
+  u32 segment;
+  u32 byteOffset; ///< Into the segment's text
+  u32 byteLength;
+  bool command;
+};
+
+constexpr usize kMaxCachedAdvances = 8192;
+
+bool isBreakingSpace(char32_t c) {
+  return c == U' ' || c == U'\t' || c == U'\r' || c == U'\u3000';
+}
+
+/// Scripts written without spaces, which may break between any characters
+bool breaksAnywhere(char32_t c) {
+  return (c >= 0x2E80 && c <= 0x2FFF) ||   // CJK radicals
+         (c >= 0x3000 && c <= 0x30FF) ||   // CJK punctuation, kana
+         (c >= 0x31F0 && c <= 0x31FF) ||   // Katakana extensions
+         (c >= 0x3400 && c <= 0x4DBF) ||   // CJK extension A
+         (c >= 0x4E00 && c <= 0x9FFF) ||   // CJK unified ideographs
+         (c >= 0xF900 && c <= 0xFAFF) ||   // CJK compatibility
+         (c >= 0xFF00 && c <= 0xFFEF) ||   // Fullwidth forms
+         (c >= 0x20000 && c <= 0x3FFFF);   // CJK extensions B and later
+}
+
+/// Kinsoku: characters that must not start a line
+bool noLineStart(char32_t c) {
+  static constexpr std::u32string_view kClosing =
+      U")]},.!?:;%\u00BB\u2019\u201D\u2025\u2026\u3001\u3002\u3005\u3009"
+      U"\u300B\u300D\u300F\u3011\u3015\u3017\u3019\u301C\u301F\u303B"
+      U"\u3041\u3043\u3045\u3047\u3049\u3063\u3083\u3085\u3087\u308E"
+      U"\u3095\u3096\u309B\u309C\u309D\u309E\u30A0\u30A1\u30A3\u30A5"
+      U"\u30A7\u30A9\u30C3\u30E3\u30E5\u30E7\u30EE\u30F5\u30F6\u30FB"
+      U"\u30FC\u30FD\u30FE\u31F0\u31F1\u31F2\u31F3\u31F4\u31F5\u31F6"
+      U"\u31F7\u31F8\u31F9\u31FA\u31FB\u31FC\u31FD\u31FE\u31FF\uFF01"
+      U"\uFF09\uFF0C\uFF0E\uFF1A\uFF1B\uFF1F\uFF3D\uFF5D\uFF60\uFF61"
+      U"\uFF63\uFF64";
+  return kClosing.find(c) != std::u32string_view::npos;
+}
+
+/// Kinsoku: characters that must not end a line
+bool noLineEnd(char32_t c) {
+  static constexpr std::u32string_view kOpening =
+      U"([{\u00AB\u2018\u201C\u3008\u300A\u300C\u300E\u3010\u3014\u3016"
+      U"\u3018\u301D\uFF08\uFF3B\uFF5B\uFF5F\uFF62";
+  return kOpening.find(c) != std::u32string_view::npos;
+}
+
+bool canBreakBetween(char32_t prev, char32_t next) {
+  if (isBreakingSpace(next)) {
+    return false;
+  }
+  if (isBreakingSpace(prev)) {
+    return true;
+  }
+  if (noLineStart(next) || noLineEnd(prev)) {
+    return false;
+  }
+  return breaksAnywhere(prev) || breaksAnywhere(next);
+}
+
+/// Width guess for when no font metrics are available
+f32 estimateAdvance(char32_t c, f32 size) {
+  if (isBreakingSpace(c)) {
+    return c == U'\u3000' ? size : size * 0.25f;
+  }
+  if (breaksAnywhere(c)) {
+    return size;
+  }
+  if (c < 0x80) {
+    // Wide characters
+    static const char *wideChars = "WMQOCD";
+    if (std::strchr(wideChars, std::toupper(static_cast<int>(c)))) {
+      return size * 0.7f;
+    }
+
+    // Narrow characters
+    static const char *narrowChars = "iIlj1!|";
+    if (std::strchr(narrowChars, static_cast<int>(c))) {
+      return size * 0.3f;
+    }
+  }
+  return size * 0.5f;
+}
+
+u64 hashText(const std::string &text) {
+  // FNV-1a
+  u64 hash = 14695981039346656037ull;
+  for (char c : text) {
+    hash ^= static_cast<u8>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+} // namespace
+
 // RichTextParser implementation
 
 std::vector<TextSegment>
@@ -224,10 +335,12 @@ TextLayoutEngine::TextLayoutEngine() = default;
 
 void TextLayoutEngine::setFont(std::shared_ptr<Font> font) {
   m_font = std::move(font);
+  clearLayoutCache();
 }
 
 void TextLayoutEngine::setFontAtlas(std::shared_ptr<FontAtlas> atlas) {
   m_fontAtlas = std::move(atlas);
+  clearLayoutCache();
 }
 
 void TextLayoutEngine::setMaxWidth(f32 width) { m_maxWidth = width; }
@@ -244,188 +357,259 @@ void TextLayoutEngine::setDefaultStyle(const TextStyle &style) {
 
 TextLayout TextLayoutEngine::layout(const std::string &text) const {
   TextLayout result;
+  result.rightToLeft = m_rightToLeft;
 
   // Parse rich text into segments
-  auto segments = m_parser.parse(text, m_defaultStyle);
+  const auto segments = m_parser.parse(text, m_defaultStyle);
 
-  TextLine currentLine;
-  f32 lineWidth = 0.0f;
-  f32 baseLineHeight = m_defaultStyle.size * m_lineHeight;
+  f32 lineHeight = m_defaultStyle.size * m_lineHeight;
   if (m_fontAtlas && m_fontAtlas->isValid()) {
-    baseLineHeight = static_cast<f32>(m_fontAtlas->getLineHeight());
+    lineHeight = static_cast<f32>(m_fontAtlas->getLineHeight());
   }
-  f32 lineHeight = baseLineHeight;
-  i32 charCount = 0;
 
-  for (const auto &segment : segments) {
+  // Flatten the segments into measured codepoints; commands become
+  // zero-width items so they keep their place in the stream
+  std::vector<LayoutItem> items;
+  items.reserve(text.size());
+  for (u32 s = 0; s < segments.size(); ++s) {
+    const auto &segment = segments[s];
     if (segment.isCommand()) {
-      // Add command segment to current line
-      result.commandIndices.push_back(static_cast<size_t>(charCount));
-      currentLine.segments.push_back(segment);
+      items.push_back(LayoutItem{0, 0.0f, s, 0, 0, true});
       continue;
     }
+    usize offset = 0;
+    while (offset < segment.text.size()) {
+      const usize start = offset;
+      const char32_t codepoint = decodeUtf8(segment.text, offset);
+      const f32 advance =
+          codepoint == U'\n' ? 0.0f : measureChar(codepoint, segment.style);
+      items.push_back(LayoutItem{codepoint, advance, s,
+                                 static_cast<u32>(start),
+                                 static_cast<u32>(offset - start), false});
+    }
+  }
 
-    // Process text segment
-    const std::string &segText = segment.text;
-    std::string currentWord;
-
-    for (size_t i = 0; i < segText.length(); ++i) {
-      char c = segText[i];
-
-      if (c == '\n') {
-        // Handle newline
-        if (!currentWord.empty()) {
-          TextSegment wordSeg;
-          wordSeg.text = currentWord;
-          wordSeg.style = segment.style;
-          currentLine.segments.push_back(std::move(wordSeg));
-          charCount += static_cast<i32>(currentWord.length());
-          currentWord.clear();
-        }
-
-        // Finish current line
-        currentLine.width = lineWidth;
-        currentLine.height = lineHeight;
-        result.lines.push_back(std::move(currentLine));
-        result.totalHeight += lineHeight;
-        result.totalWidth = std::max(result.totalWidth, lineWidth);
-
-        // Start new line
-        currentLine = TextLine{};
-        lineWidth = 0.0f;
-      } else if (std::isspace(c)) {
-        // End of word
-        if (!currentWord.empty()) {
-          f32 wordWidth = measureWord(currentWord, segment.style);
-
-          // Check if we need to wrap
-          if (m_maxWidth > 0.0f && lineWidth + wordWidth > m_maxWidth &&
-              lineWidth > 0.0f) {
-            // Wrap to next line
-            currentLine.width = lineWidth;
-            currentLine.height = lineHeight;
-            result.lines.push_back(std::move(currentLine));
-            result.totalHeight += lineHeight;
-            result.totalWidth = std::max(result.totalWidth, lineWidth);
-
-            currentLine = TextLine{};
-            lineWidth = 0.0f;
-          }
+  const auto isSpaceItem = [&](usize i) {
+    return !items[i].command && isBreakingSpace(items[i].codepoint);
+  };
 
-          TextSegment wordSeg;
-          wordSeg.text = currentWord;
-          wordSeg.style = segment.style;
-          currentLine.segments.push_back(std::move(wordSeg));
-          lineWidth += wordWidth;
-          charCount += static_cast<i32>(currentWord.length());
-          currentWord.clear();
-        }
+  // Append items [begin, end) as a line, merging runs of one segment
+  const auto emitLine = [&](usize begin, usize end) {
+    // Trailing spaces hang past the edge and are dropped
+    while (end > begin && isSpaceItem(end - 1)) {
+      --end;
+    }
 
-        // Add space
-        f32 spaceWidth = measureChar(' ', segment.style);
-        if (m_maxWidth <= 0.0f || lineWidth + spaceWidth <= m_maxWidth) {
-          TextSegment spaceSeg;
-          spaceSeg.text = " ";
-          spaceSeg.style = segment.style;
-          currentLine.segments.push_back(std::move(spaceSeg));
-          lineWidth += spaceWidth;
-          ++charCount;
-        }
-      } else {
-        currentWord += c;
+    TextLine line;
+    line.height = lineHeight;
+    line.firstGlyph = static_cast<u32>(result.glyphs.size());
+    const auto lineIndex = static_cast<u32>(result.lines.size());
+
+    constexpr u32 kNoRun = std::numeric_limits<u32>::max();
+    u32 runSegment = kNoRun;
+    usize runBegin = 0;
+    usize runEnd = 0;
+    const auto closeRun = [&]() {
+      if (runSegment != kNoRun) {
+        line.segments.back().text =
+            segments[runSegment].text.substr(runBegin, runEnd - runBegin);
+        runSegment = kNoRun;
       }
+    };
+
+    f32 x = 0.0f;
+    for (usize i = begin; i < end; ++i) {
+      const auto &item = items[i];
+      const auto &source = segments[item.segment];
+      if (item.command) {
+        closeRun();
+        result.commandIndices.push_back(result.glyphs.size());
+        result.commands.push_back(*source.command);
+        TextSegment command;
+        command.style = source.style;
+        command.command = source.command;
+        command.firstGlyph = static_cast<u32>(result.glyphs.size());
+        line.segments.push_back(std::move(command));
+        continue;
+      }
+      if (runSegment != item.segment) {
+        closeRun();
+        TextSegment run;
+        run.style = source.style;
+        run.firstGlyph = static_cast<u32>(result.glyphs.size());
+        line.segments.push_back(std::move(run));
+        runSegment = item.segment;
+        runBegin = item.byteOffset;
+      }
+      runEnd = item.byteOffset + item.byteLength;
+
+      auto &run = line.segments.back();
+      run.width += item.advance;
+      ++run.glyphCount;
+      result.glyphs.push_back(
+          LayoutGlyph{item.codepoint, x, item.advance, lineIndex});
+      x += item.advance;
+    }
+    closeRun();
+
+    line.width = x;
+    line.glyphCount =
+        static_cast<u32>(result.glyphs.size()) - line.firstGlyph;
+    result.totalHeight += lineHeight;
+    result.totalWidth = std::max(result.totalWidth, x);
+    result.lines.push_back(std::move(line));
+  };
+
+  // Greedy line breaking at the last break opportunity that fits
+  const usize count = items.size();
+  usize lineStart = 0;
+  usize breakAt = 0;
+  f32 width = 0.0f;
+  usize i = 0;
+  while (i < count) {
+    const auto &item = items[i];
+    if (item.command) {
+      ++i;
+      continue;
+    }
+    if (item.codepoint == U'\n') {
+      emitLine(lineStart, i);
+      lineStart = ++i;
+      breakAt = 0;
+      width = 0.0f;
+      continue;
     }
 
-    // Handle remaining word
-    if (!currentWord.empty()) {
-      f32 wordWidth = measureWord(currentWord, segment.style);
-
-      // Check if we need to wrap
-      if (m_maxWidth > 0.0f && lineWidth + wordWidth > m_maxWidth &&
-          lineWidth > 0.0f) {
-        currentLine.width = lineWidth;
-        currentLine.height = lineHeight;
-        result.lines.push_back(std::move(currentLine));
-        result.totalHeight += lineHeight;
-        result.totalWidth = std::max(result.totalWidth, lineWidth);
-
-        currentLine = TextLine{};
-        lineWidth = 0.0f;
+    // Previous character on this line, looking past commands
+    usize prev = i;
+    while (prev > lineStart && items[prev - 1].command) {
+      --prev;
+    }
+    if (prev > lineStart &&
+        canBreakBetween(items[prev - 1].codepoint, item.codepoint)) {
+      breakAt = i;
+    }
+
+    if (m_maxWidth > 0.0f && width > 0.0f && !isSpaceItem(i) &&
+        width + item.advance > m_maxWidth) {
+      // Without a break opportunity (one long word) break where it overflows
+      const usize cut = breakAt > lineStart ? breakAt : i;
+      emitLine(lineStart, cut);
+      lineStart = cut;
+      while (lineStart < count && isSpaceItem(lineStart)) {
+        ++lineStart;
       }
+      // Measure what moved to the new line again
+      i = lineStart;
+      breakAt = 0;
+      width = 0.0f;
+      continue;
+    }
 
-      TextSegment wordSeg;
-      wordSeg.text = currentWord;
-      wordSeg.style = segment.style;
-      currentLine.segments.push_back(std::move(wordSeg));
-      lineWidth += wordWidth;
-      charCount += static_cast<i32>(currentWord.length());
+    width += item.advance;
+    ++i;
+  }
+  if (lineStart < count) {
+    emitLine(lineStart, count);
+  }
+
+  result.totalCharacters = static_cast<i32>(result.glyphs.size());
+  return result;
+}
+
+std::shared_ptr<const TextLayout>
+TextLayoutEngine::layoutCached(const std::string &text) const {
+  const u64 hash = hashText(text);
+  ++m_layoutUses;
+  for (auto &entry : m_layoutCache) {
+    if (matches(entry, hash, text)) {
+      entry.lastUsed = m_layoutUses;
+      return entry.layout;
     }
   }
 
-  // Add last line
-  if (!currentLine.segments.empty()) {
-    currentLine.width = lineWidth;
-    currentLine.height = lineHeight;
-    result.lines.push_back(std::move(currentLine));
-    result.totalHeight += lineHeight;
-    result.totalWidth = std::max(result.totalWidth, lineWidth);
+  auto result = std::make_shared<const TextLayout>(layout(text));
+  if (m_layoutCacheCapacity == 0) {
+    return result;
   }
 
-  result.totalCharacters = charCount;
-  result.rightToLeft = m_rightToLeft;
+  CachedLayout entry;
+  entry.hash = hash;
+  entry.text = text;
+  entry.fontId = m_font ? m_font->getId() : 0;
+  entry.atlasId = m_fontAtlas ? m_fontAtlas->getId() : 0;
+  entry.maxWidth = m_maxWidth;
+  entry.lineHeight = m_lineHeight;
+  entry.alignment = m_alignment;
+  entry.rightToLeft = m_rightToLeft;
+  entry.style = m_defaultStyle;
+  entry.layout = result;
+  entry.lastUsed = m_layoutUses;
+
+  if (m_layoutCache.size() < m_layoutCacheCapacity) {
+    m_layoutCache.push_back(std::move(entry));
+  } else {
+    auto oldest = std::min_element(
+        m_layoutCache.begin(), m_layoutCache.end(),
+        [](const CachedLayout &a, const CachedLayout &b) {
+          return a.lastUsed < b.lastUsed;
+        });
+    *oldest = std::move(entry);
+  }
   return result;
 }
 
+void TextLayoutEngine::setLayoutCacheCapacity(usize capacity) {
+  m_layoutCacheCapacity = capacity;
+  if (m_layoutCache.size() > capacity) {
+    std::sort(m_layoutCache.begin(), m_layoutCache.end(),
+              [](const CachedLayout &a, const CachedLayout &b) {
+                return a.lastUsed > b.lastUsed;
+              });
+    m_layoutCache.resize(capacity);
+  }
+}
+
+void TextLayoutEngine::clearLayoutCache() {
+  m_layoutCache.clear();
+  m_advances.clear();
+}
+
+bool TextLayoutEngine::matches(const CachedLayout &entry, u64 hash,
+                               const std::string &text) const {
+  return entry.hash == hash &&
+         entry.fontId == (m_font ? m_font->getId() : 0) &&
+         entry.atlasId == (m_fontAtlas ? m_fontAtlas->getId() : 0) &&
+         entry.maxWidth == m_maxWidth &&
+         entry.lineHeight == m_lineHeight && entry.alignment == m_alignment &&
+         entry.rightToLeft == m_rightToLeft &&
+         entry.style == m_defaultStyle && entry.text == text;
+}
+
 std::pair<f32, f32>
 TextLayoutEngine::measureText(const std::string &text) const {
-  auto layout = this->layout(text);
-  return {layout.totalWidth, layout.totalHeight};
+  const auto layout = layoutCached(text);
+  return {layout->totalWidth, layout->totalHeight};
 }
 
 i32 TextLayoutEngine::getCharacterAtPosition(const TextLayout &layout, f32 x,
                                              f32 y) const {
   f32 currentY = 0.0f;
-  i32 charIndex = 0;
-
   for (const auto &line : layout.lines) {
     if (y >= currentY && y < currentY + line.height) {
-      // Found the line
-      f32 currentX = layout.rightToLeft ? line.width : 0.0f;
-
-      for (const auto &segment : line.segments) {
-        if (segment.isCommand()) {
-          continue;
-        }
-
-        for (char c : segment.text) {
-          f32 charWidth = measureChar(c, segment.style);
-          if (!layout.rightToLeft) {
-            if (x >= currentX && x < currentX + charWidth) {
-              return charIndex;
-            }
-            currentX += charWidth;
-          } else {
-            f32 nextX = currentX - charWidth;
-            if (x >= nextX && x < currentX) {
-              return charIndex;
-            }
-            currentX = nextX;
-          }
-          ++charIndex;
+      const u32 end = line.firstGlyph + line.glyphCount;
+      for (u32 g = line.firstGlyph; g < end; ++g) {
+        const auto &glyph = layout.glyphs[g];
+        const f32 start = layout.rightToLeft
+                              ? line.width - glyph.x - glyph.advance
+                              : glyph.x;
+        if (x >= start && x < start + glyph.advance) {
+          return static_cast<i32>(g);
         }
       }
-
-      return charIndex - 1;
+      return static_cast<i32>(end) - 1;
     }
-
     currentY += line.height;
-
-    // Count characters in line
-    for (const auto &segment : line.segments) {
-      if (!segment.isCommand()) {
-        charIndex += static_cast<i32>(segment.text.length());
-      }
-    }
   }
 
   return -1;
@@ -433,105 +617,66 @@ i32 TextLayoutEngine::getCharacterAtPosition(const TextLayout &layout, f32 x,
 
 std::pair<f32, f32>
 TextLayoutEngine::getCharacterPosition(const TextLayout &layout,
-                                       i32 targetIndex) const {
-  f32 currentY = 0.0f;
-  i32 charIndex = 0;
-
-  for (const auto &line : layout.lines) {
-    f32 currentX = layout.rightToLeft ? line.width : 0.0f;
-
-    for (const auto &segment : line.segments) {
-      if (segment.isCommand()) {
-        continue;
-      }
-
-      for (char c : segment.text) {
-        f32 charWidth = measureChar(c, segment.style);
-        if (charIndex == targetIndex) {
-          f32 charX = layout.rightToLeft ? (currentX - charWidth) : currentX;
-          return {charX, currentY};
-        }
-        if (layout.rightToLeft) {
-          currentX -= charWidth;
-        } else {
-          currentX += charWidth;
-        }
-        ++charIndex;
-      }
-    }
-
-    currentY += line.height;
+                                       i32 charIndex) const {
+  if (charIndex < 0 ||
+      static_cast<usize>(charIndex) >= layout.glyphs.size()) {
+    return {0.0f, layout.totalHeight};
   }
 
-  return {0.0f, currentY};
-}
-
-std::vector<std::string>
-TextLayoutEngine::breakIntoWords(const std::string &text) const {
-  std::vector<std::string> words;
-  std::string current;
-
-  for (char c : text) {
-    if (std::isspace(c)) {
-      if (!current.empty()) {
-        words.push_back(current);
-        current.clear();
-      }
-    } else {
-      current += c;
-    }
-  }
-
-  if (!current.empty()) {
-    words.push_back(current);
+  const auto &glyph = layout.glyphs[static_cast<usize>(charIndex)];
+  f32 y = 0.0f;
+  for (u32 l = 0; l < glyph.line; ++l) {
+    y += layout.lines[l].height;
   }
-
-  return words;
+  const auto &line = layout.lines[glyph.line];
+  const f32 x =
+      layout.rightToLeft ? line.width - glyph.x - glyph.advance : glyph.x;
+  return {x, y};
 }
 
-f32 TextLayoutEngine::measureChar(char c, const TextStyle &style) const {
-  // Use atlas metrics when available for precise width
-  if (m_fontAtlas && m_fontAtlas->isValid()) {
-    if (const auto *glyph =
-            m_fontAtlas->getGlyph(static_cast<unsigned char>(c))) {
-      return glyph->advanceX;
-    }
-  }
-
-  // Character width estimation using monospace approximation.
-  // When font metrics are available, FreeType glyph advances are used.
-  if (m_font) {
-    // Monospace approximation: 0.6 * size
-    return style.size * 0.6f;
-  }
-
-  // Fallback: estimate based on character
-  if (std::isspace(c)) {
-    return style.size * 0.25f;
-  }
-
-  // Wide characters
-  static const char *wideChars = "WMQOCD";
-  if (std::strchr(wideChars, std::toupper(c))) {
-    return style.size * 0.7f;
-  }
-
-  // Narrow characters
-  static const char *narrowChars = "iIlj1!|";
-  if (std::strchr(narrowChars, c)) {
-    return style.size * 0.3f;
-  }
-
-  return style.size * 0.5f;
+usize TextLayoutEngine::AdvanceKeyHash::operator()(
+    const AdvanceKey &key) const {
+  u32 sizeBits = 0;
+  std::memcpy(&sizeBits, &key.size, sizeof(sizeBits));
+  return std::hash<u64>{}(key.fontId) ^
+         (std::hash<u64>{}(key.atlasId) << 1) ^
+         (static_cast<usize>(key.codepoint) * usize{0x9E3779B97F4A7C15}) ^
+         (static_cast<usize>(sizeBits) << 1);
 }
 
-f32 TextLayoutEngine::measureWord(const std::string &word,
+f32 TextLayoutEngine::measureChar(char32_t codepoint,
                                   const TextStyle &style) const {
-  f32 width = 0.0f;
-  for (char c : word) {
-    width += measureChar(c, style);
+  const bool useAtlas = m_fontAtlas && m_fontAtlas->isValid();
+  const AdvanceKey key{useAtlas || !m_font ? 0 : m_font->getId(),
+                       useAtlas ? m_fontAtlas->getId() : 0, codepoint,
+                       style.size};
+  if (auto it = m_advances.find(key); it != m_advances.end()) {
+    return it->second;
+  }
+  if (m_advances.size() >= kMaxCachedAdvances) {
+    m_advances.clear();
+  }
+
+  f32 advance = estimateAdvance(codepoint, style.size);
+  const GlyphInfo *glyph = useAtlas ? m_fontAtlas->getGlyph(codepoint)
+                                    : nullptr;
+  if (glyph) {
+    advance = glyph->advanceX;
+  } else if (m_font) {
+#if defined(NOVELMIND_HAS_FREETYPE)
+    // Advances load without rasterizing the glyph
+    if (auto *face = static_cast<FT_Face>(m_font->getNativeHandle())) {
+      FT_Fixed fixed = 0;
+      if (!FT_Get_Advance(face, FT_Get_Char_Index(face, codepoint),
+                          FT_LOAD_DEFAULT, &fixed)) {
+        advance = static_cast<f32>(fixed) / 65536.0f;
+      }
+    }
+#endif
   }
-  return width;
+
+  m_advances.emplace(key, advance);
+  return advance;
 }
 
 // TypewriterAnimator implementation
@@ -539,10 +684,23 @@ f32 TextLayoutEngine::measureWord(const std::string &word,
 TypewriterAnimator::TypewriterAnimator() = default;
 
 void TypewriterAnimator::setLayout(const TextLayout &layout) {
+  if (m_sharedLayout.get() != &layout) {
+    m_sharedLayout.reset();
+  }
   m_layout = &layout;
   m_state = TypewriterState{};
   m_state.targetCharIndex = static_cast<f32>(layout.totalCharacters);
   m_nextCommandIndex = 0;
+  m_pausedThrough = 0;
+}
+
+void TypewriterAnimator::setLayout(std::shared_ptr<const TextLayout> layout) {
+  m_sharedLayout = std::move(layout);
+  if (m_sharedLayout) {
+    setLayout(*m_sharedLayout);
+  } else {
+    m_layout = nullptr;
+  }
 }
 
 void TypewriterAnimator::setSpeed(f32 charsPerSecond) {
@@ -559,6 +717,7 @@ void TypewriterAnimator::start() {
   m_state.waitingForInput = false;
   m_state.complete = false;
   m_nextCommandIndex = 0;
+  m_pausedThrough = 0;
   m_currentStyle = TextStyle{};
 }
 
@@ -590,28 +749,17 @@ void TypewriterAnimator::update(f64 deltaTime) {
   f32 advance = m_state.charsPerSecond * static_cast<f32>(deltaTime);
   m_state.currentCharIndex += advance;
 
-  // Check for punctuation pause
-  i32 currentChar = static_cast<i32>(m_state.currentCharIndex);
-  if (currentChar > 0 && currentChar < m_layout->totalCharacters) {
-    // Get the character at current position
-    i32 charIndex = 0;
-    for (const auto &line : m_layout->lines) {
-      for (const auto &segment : line.segments) {
-        if (segment.isCommand()) {
-          continue;
-        }
-
-        for (char c : segment.text) {
-          if (charIndex == currentChar - 1) {
-            f32 pause = getPunctuationPause(c);
-            if (pause > 0.0f) {
-              m_state.waitTimer = pause;
-            }
-          }
-          ++charIndex;
-        }
-      }
+  // Pause once after the punctuation mark just revealed
+  const i32 currentChar = static_cast<i32>(m_state.currentCharIndex);
+  if (currentChar > m_pausedThrough &&
+      currentChar < m_layout->totalCharacters &&
+      static_cast<usize>(currentChar) <= m_layout->glyphs.size()) {
+    const f32 pause = getPunctuationPause(
+        m_layout->glyphs[static_cast<usize>(currentChar - 1)].codepoint);
+    if (pause > 0.0f) {
+      m_state.waitTimer = pause;
     }
+    m_pausedThrough = currentChar;
   }
 
   // Check for completion
@@ -668,45 +816,36 @@ void TypewriterAnimator::processCommands() {
       break;
     }
 
-    // Find the command in the layout
-    size_t cmdCount = 0;
-    for (const auto &line : m_layout->lines) {
-      for (const auto &segment : line.segments) {
-        if (segment.isCommand()) {
-          if (cmdCount == m_nextCommandIndex) {
-            const auto &cmd = segment.command.value();
-
-            // Handle command
-            std::visit(
-                [this](const auto &c) {
-                  using T = std::decay_t<decltype(c)>;
-
-                  if constexpr (std::is_same_v<T, WaitCommand>) {
-                    m_state.waitTimer = c.duration;
-                  } else if constexpr (std::is_same_v<T, SpeedCommand>) {
-                    m_state.charsPerSecond = c.charsPerSecond;
-                  } else if constexpr (std::is_same_v<T, PauseCommand>) {
-                    m_state.waitingForInput = true;
-                  } else if constexpr (std::is_same_v<T, ColorCommand>) {
-                    m_currentStyle.color = c.color;
-                  } else if constexpr (std::is_same_v<T, ResetStyleCommand>) {
-                    m_currentStyle = TextStyle{};
-                  } else if constexpr (std::is_same_v<T, ShakeCommand>) {
-                    m_state.shakeIntensity = c.intensity;
-                    m_state.shakeTimer = c.duration;
-                  } else if constexpr (std::is_same_v<T, WaveCommand>) {
-                    m_state.waveAmplitude = c.amplitude;
-                    m_state.waveFrequency = c.frequency;
-                  }
-                },
-                cmd);
-
-            if (m_commandCallback) {
-              m_commandCallback(cmd);
+    if (m_nextCommandIndex < m_layout->commands.size()) {
+      const auto &cmd = m_layout->commands[m_nextCommandIndex];
+
+      // Handle command
+      std::visit(
+          [this](const auto &c) {
+            using T = std::decay_t<decltype(c)>;
+
+            if constexpr (std::is_same_v<T, WaitCommand>) {
+              m_state.waitTimer = c.duration;
+            } else if constexpr (std::is_same_v<T, SpeedCommand>) {
+              m_state.charsPerSecond = c.charsPerSecond;
+            } else if constexpr (std::is_same_v<T, PauseCommand>) {
+              m_state.waitingForInput = true;
+            } else if constexpr (std::is_same_v<T, ColorCommand>) {
+              m_currentStyle.color = c.color;
+            } else if constexpr (std::is_same_v<T, ResetStyleCommand>) {
+              m_currentStyle = TextStyle{};
+            } else if constexpr (std::is_same_v<T, ShakeCommand>) {
+              m_state.shakeIntensity = c.intensity;
+              m_state.shakeTimer = c.duration;
+            } else if constexpr (std::is_same_v<T, WaveCommand>) {
+              m_state.waveAmplitude = c.amplitude;
+              m_state.waveFrequency = c.frequency;
             }
-          }
-          ++cmdCount;
-        }
+          },
+          cmd);
+
+      if (m_commandCallback) {
+        m_commandCallback(cmd);
       }
     }
 
@@ -714,20 +853,27 @@ void TypewriterAnimator::processCommands() {
   }
 }
 
-f32 TypewriterAnimator::getPunctuationPause(char c) const {
+f32 TypewriterAnimator::getPunctuationPause(char32_t c) const {
   // Calculate pause duration based on punctuation
   switch (c) {
-  case '.':
-  case '!':
-  case '?':
+  case U'.':
+  case U'!':
+  case U'?':
+  case U'\u3002': // Ideographic full stop
+  case U'\uFF01': // Fullwidth exclamation mark
+  case U'\uFF1F': // Fullwidth question mark
     return m_punctuationPause / m_state.charsPerSecond;
 
-  case ',':
-  case ';':
-  case ':':
+  case U',':
+  case U';':
+  case U':':
+  case U'\u3001': // Ideographic comma
+  case U'\uFF0C': // Fullwidth comma
+  case U'\u2026': // Ellipsis
     return (m_punctuationPause * 0.5f) / m_state.charsPerSecond;
 
-  case '-':
+  case U'-':
+  case U'\u2014': // Em dash
     return (m_punctuationPause * 0.25f) / m_state.charsPerSecond;
 
   default:
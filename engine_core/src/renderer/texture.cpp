@@ -7,18 +7,41 @@
 #include <SDL_opengl.h>
 #endif
 
+#include <atomic>
+#include <cstring>
+
 namespace NovelMind::renderer {
 
+namespace {
+
+std::atomic<bool> g_gpuUploadEnabled{true};
+
+} // namespace
+
+void Texture::setGpuUploadEnabled(bool enabled) {
+  g_gpuUploadEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Texture::isGpuUploadEnabled() {
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+  return g_gpuUploadEnabled.load(std::memory_order_relaxed);
+#else
+  return false;
+#endif
+}
+
 Texture::Texture() : m_handle(nullptr), m_width(0), m_height(0) {}
 
 Texture::~Texture() { destroy(); }
 
 Texture::Texture(Texture &&other) noexcept
     : m_handle(other.m_handle), m_width(other.m_width),
-      m_height(other.m_height) {
+      m_height(other.m_height), m_pixels(std::move(other.m_pixels)),
+      m_state(other.m_state) {
   other.m_handle = nullptr;
   other.m_width = 0;
   other.m_height = 0;
+  other.m_state = TextureState::Empty;
 }
 
 Texture &Texture::operator=(Texture &&other) noexcept {
@@ -27,9 +50,12 @@ Texture &Texture::operator=(Texture &&other) noexcept {
     m_handle = other.m_handle;
     m_width = other.m_width;
     m_height = other.m_height;
+    m_pixels = std::move(other.m_pixels);
+    m_state = other.m_state;
     other.m_handle = nullptr;
     other.m_width = 0;
     other.m_height = 0;
+    other.m_state = TextureState::Empty;
   }
   return *this;
 }
@@ -63,9 +89,17 @@ Result<void> Texture::loadFromRGBA(const u8 *pixels, i32 width, i32 height) {
     return Result<void>::error("Invalid texture parameters");
   }
 
+  destroy();
   m_width = width;
   m_height = height;
 
+  if (!isGpuUploadEnabled()) {
+    m_pixels.assign(pixels, pixels + static_cast<usize>(width) *
+                                         static_cast<usize>(height) * 4);
+    m_state = TextureState::Ready;
+    return Result<void>::ok();
+  }
+
 #if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
   GLuint tex = 0;
   glGenTextures(1, &tex);
@@ -81,6 +115,7 @@ Result<void> Texture::loadFromRGBA(const u8 *pixels, i32 width, i32 height) {
   m_handle = nullptr;
 #endif
 
+  m_state = TextureState::Ready;
   return Result<void>::ok();
 }
 
@@ -95,11 +130,16 @@ void Texture::destroy() {
     // Texture resource cleanup is handled by platform backend.
     m_handle = nullptr;
   }
+  m_pixels.clear();
+  m_pixels.shrink_to_fit();
   m_width = 0;
   m_height = 0;
+  m_state = TextureState::Empty;
 }
 
-bool Texture::isValid() const { return m_width > 0 && m_height > 0; }
+bool Texture::isValid() const {
+  return m_state == TextureState::Ready && m_width > 0 && m_height > 0;
+}
 
 i32 Texture::getWidth() const { return m_width; }
 
@@ -107,4 +147,66 @@ i32 Texture::getHeight() const { return m_height; }
 
 void *Texture::getNativeHandle() const { return m_handle; }
 
+void Texture::markLoading() {
+  destroy();
+  m_state = TextureState::Loading;
+}
+
+void Texture::markFailed() {
+  destroy();
+  m_state = TextureState::Failed;
+}
+
+void Texture::adoptPixels(std::vector<u8> &&pixels, i32 width, i32 height) {
+  destroy();
+  m_width = width;
+  m_height = height;
+  m_pixels = std::move(pixels);
+  m_state = TextureState::Ready;
+}
+
+void Texture::beginUpload(i32 width, i32 height) {
+  destroy();
+  m_state = TextureState::Loading;
+  m_width = width;
+  m_height = height;
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+  // Allocate storage only; rows arrive over the next frames
+  GLuint tex = 0;
+  glGenTextures(1, &tex);
+  glBindTexture(GL_TEXTURE_2D, tex);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  m_handle = reinterpret_cast<void *>(static_cast<uintptr_t>(tex));
+#endif
+}
+
+void Texture::uploadRows(const void *rows, i32 firstRow, i32 rowCount) {
+  if (!m_pixels.empty()) {
+    const auto stride = static_cast<usize>(m_width) * 4;
+    std::memcpy(m_pixels.data() + static_cast<usize>(firstRow) * stride, rows,
+                static_cast<usize>(rowCount) * stride);
+    return;
+  }
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+  if (!m_handle) {
+    return;
+  }
+  GLuint tex = static_cast<GLuint>(reinterpret_cast<uintptr_t>(m_handle));
+  glBindTexture(GL_TEXTURE_2D, tex);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, m_width, rowCount, GL_RGBA,
+                  GL_UNSIGNED_BYTE, rows);
+#else
+  (void)rows;
+  (void)firstRow;
+  (void)rowCount;
+#endif
+}
+
+void Texture::finishUpload() { m_state = TextureState::Ready; }
+
 } // namespace NovelMind::renderer
@@ -0,0 +1,495 @@
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "stb/stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+namespace NovelMind::renderer {
+
+namespace {
+
+bool intersects(const AtlasRect &a, const AtlasRect &b) {
+  return a.x < b.x + b.width && b.x < a.x + a.width &&
+         a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool contains(const AtlasRect &outer, const AtlasRect &inner) {
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.width <= outer.x + outer.width &&
+         inner.y + inner.height <= outer.y + outer.height;
+}
+
+i32 nextPowerOfTwo(i32 value) {
+  i32 result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+std::string sanitizeGroup(const std::string &group) {
+  std::string name;
+  name.reserve(group.size());
+  for (char c : group) {
+    const bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       (c >= '0' && c <= '9');
+    name.push_back(alnum ? c : '_');
+  }
+  return name.empty() ? std::string("default") : name;
+}
+
+usize pixelOffset(i32 x, i32 y, i32 width) {
+  return (static_cast<usize>(y) * static_cast<usize>(width) +
+          static_cast<usize>(x)) *
+         4;
+}
+
+} // namespace
+
+// ============================================================================
+// MaxRectsPacker
+// ============================================================================
+
+MaxRectsPacker::MaxRectsPacker(i32 width, i32 height) { reset(width, height); }
+
+void MaxRectsPacker::reset(i32 width, i32 height) {
+  m_width = width;
+  m_height = height;
+  m_free.clear();
+  m_used.clear();
+  if (width > 0 && height > 0) {
+    m_free.push_back(AtlasRect{0, 0, width, height});
+  }
+}
+
+std::optional<AtlasRect> MaxRectsPacker::insert(i32 width, i32 height) {
+  if (width <= 0 || height <= 0) {
+    return std::nullopt;
+  }
+
+  const AtlasRect *best = nullptr;
+  i32 bestShort = 0;
+  i32 bestLong = 0;
+  for (const auto &free : m_free) {
+    if (free.width < width || free.height < height) {
+      continue;
+    }
+    const i32 leftoverX = free.width - width;
+    const i32 leftoverY = free.height - height;
+    const i32 shortSide = std::min(leftoverX, leftoverY);
+    const i32 longSide = std::max(leftoverX, leftoverY);
+    if (!best || shortSide < bestShort ||
+        (shortSide == bestShort && longSide < bestLong)) {
+      best = &free;
+      bestShort = shortSide;
+      bestLong = longSide;
+    }
+  }
+  if (!best) {
+    return std::nullopt;
+  }
+
+  const AtlasRect placed{best->x, best->y, width, height};
+  splitFreeRects(placed);
+  pruneFreeRects();
+  m_used.push_back(placed);
+  return placed;
+}
+
+f32 MaxRectsPacker::occupancy() const {
+  if (m_width <= 0 || m_height <= 0) {
+    return 0.0f;
+  }
+  i64 area = 0;
+  for (const auto &rect : m_used) {
+    area += static_cast<i64>(rect.width) * rect.height;
+  }
+  return static_cast<f32>(static_cast<f64>(area) /
+                          (static_cast<f64>(m_width) * m_height));
+}
+
+void MaxRectsPacker::splitFreeRects(const AtlasRect &placed) {
+  std::vector<AtlasRect> next;
+  next.reserve(m_free.size() + 4);
+  const i32 placedRight = placed.x + placed.width;
+  const i32 placedBottom = placed.y + placed.height;
+
+  for (const auto &free : m_free) {
+    if (!intersects(free, placed)) {
+      next.push_back(free);
+      continue;
+    }
+    const i32 freeRight = free.x + free.width;
+    const i32 freeBottom = free.y + free.height;
+    if (placed.x > free.x) {
+      next.push_back(AtlasRect{free.x, free.y, placed.x - free.x, free.height});
+    }
+    if (placedRight < freeRight) {
+      next.push_back(AtlasRect{placedRight, free.y, freeRight - placedRight,
+                               free.height});
+    }
+    if (placed.y > free.y) {
+      next.push_back(AtlasRect{free.x, free.y, free.width, placed.y - free.y});
+    }
+    if (placedBottom < freeBottom) {
+      next.push_back(AtlasRect{free.x, placedBottom, free.width,
+                               freeBottom - placedBottom});
+    }
+  }
+  m_free = std::move(next);
+}
+
+void MaxRectsPacker::pruneFreeRects() {
+  std::vector<bool> removed(m_free.size(), false);
+  for (size_t i = 0; i < m_free.size(); ++i) {
+    if (removed[i]) {
+      continue;
+    }
+    for (size_t j = 0; j < m_free.size(); ++j) {
+      if (i != j && !removed[j] && contains(m_free[i], m_free[j])) {
+        removed[j] = true;
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < m_free.size(); ++i) {
+    if (!removed[i]) {
+      m_free[kept++] = m_free[i];
+    }
+  }
+  m_free.resize(kept);
+}
+
+// ============================================================================
+// TextureAtlasIndex
+// ============================================================================
+
+u32 TextureAtlasIndex::addPage(const std::string &id, i32 width, i32 height) {
+  m_pages.push_back(TextureAtlasPage{id, width, height});
+  return static_cast<u32>(m_pages.size() - 1);
+}
+
+void TextureAtlasIndex::addSprite(const std::string &id, u32 page,
+                                  const AtlasRect &rect) {
+  m_sprites[id] = TextureAtlasSprite{page, rect};
+}
+
+const TextureAtlasSprite *
+TextureAtlasIndex::find(const std::string &id) const {
+  auto it = m_sprites.find(id);
+  return it != m_sprites.end() ? &it->second : nullptr;
+}
+
+std::string TextureAtlasIndex::serialize() const {
+  std::ostringstream out;
+  out << "atlas 1\n";
+  for (const auto &page : m_pages) {
+    out << "page " << page.id << ' ' << page.width << ' ' << page.height
+        << '\n';
+  }
+
+  // Sorted so identical inputs produce identical packs
+  std::vector<const std::pair<const std::string, TextureAtlasSprite> *> sorted;
+  sorted.reserve(m_sprites.size());
+  for (const auto &entry : m_sprites) {
+    sorted.push_back(&entry);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const auto *a, const auto *b) { return a->first < b->first; });
+
+  for (const auto *entry : sorted) {
+    const auto &sprite = entry->second;
+    out << "sprite " << sprite.page << ' ' << sprite.rect.x << ' '
+        << sprite.rect.y << ' ' << sprite.rect.width << ' '
+        << sprite.rect.height << ' ' << entry->first << '\n';
+  }
+  return out.str();
+}
+
+Result<TextureAtlasIndex> TextureAtlasIndex::parse(const std::string &text) {
+  TextureAtlasIndex index;
+  std::istringstream in(text);
+  std::string line;
+  i32 lineNumber = 0;
+  bool sawHeader = false;
+
+  const auto fail = [&lineNumber](const std::string &what) {
+    return Result<TextureAtlasIndex>::error(
+        "Invalid texture atlas index (line " + std::to_string(lineNumber) +
+        "): " + what);
+  };
+
+  while (std::getline(in, line)) {
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    std::string tag;
+    fields >> tag;
+
+    if (!sawHeader) {
+      i32 version = 0;
+      if (tag != "atlas" || !(fields >> version) || version != 1) {
+        return fail("unsupported header");
+      }
+      sawHeader = true;
+      continue;
+    }
+
+    if (tag == "page") {
+      TextureAtlasPage page;
+      if (!(fields >> page.id >> page.width >> page.height) ||
+          page.width <= 0 || page.height <= 0) {
+        return fail("malformed page");
+      }
+      index.m_pages.push_back(std::move(page));
+    } else if (tag == "sprite") {
+      TextureAtlasSprite sprite;
+      if (!(fields >> sprite.page >> sprite.rect.x >> sprite.rect.y >>
+            sprite.rect.width >> sprite.rect.height)) {
+        return fail("malformed sprite");
+      }
+      std::string id;
+      std::getline(fields >> std::ws, id);
+      if (id.empty()) {
+        return fail("sprite without id");
+      }
+      if (sprite.page >= index.m_pages.size()) {
+        return fail("sprite references unknown page");
+      }
+      const auto &page = index.m_pages[sprite.page];
+      if (sprite.rect.x < 0 || sprite.rect.y < 0 || sprite.rect.width <= 0 ||
+          sprite.rect.height <= 0 ||
+          sprite.rect.x + sprite.rect.width > page.width ||
+          sprite.rect.y + sprite.rect.height > page.height) {
+        return fail("sprite outside its page");
+      }
+      index.m_sprites[id] = sprite;
+    } else {
+      return fail("unknown entry '" + tag + "'");
+    }
+  }
+
+  if (!sawHeader) {
+    return Result<TextureAtlasIndex>::error(
+        "Invalid texture atlas index: missing header");
+  }
+  return Result<TextureAtlasIndex>::ok(std::move(index));
+}
+
+// ============================================================================
+// TextureAtlasBuilder
+// ============================================================================
+
+TextureAtlasBuilder::TextureAtlasBuilder(i32 maxPageSize, i32 padding)
+    : m_maxPageSize(std::max(maxPageSize, 1)),
+      m_padding(std::max(padding, 0)) {}
+
+Result<void> TextureAtlasBuilder::addImage(const std::string &group,
+                                           const std::string &id,
+                                           const std::vector<u8> &encoded) {
+  if (encoded.empty()) {
+    return Result<void>::error("Empty image data: " + id);
+  }
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  stbi_uc *pixels = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(encoded.data()),
+      static_cast<int>(encoded.size()), &width, &height, &channels, 4);
+  if (!pixels) {
+    const char *reason = stbi_failure_reason();
+    return Result<void>::error("Failed to decode " + id + ": " +
+                               (reason ? reason : "unknown error"));
+  }
+
+  auto result = addImage(group, id, pixels, width, height);
+  stbi_image_free(pixels);
+  return result;
+}
+
+Result<void> TextureAtlasBuilder::addImage(const std::string &group,
+                                           const std::string &id,
+                                           const u8 *rgba, i32 width,
+                                           i32 height) {
+  if (id.empty() || !rgba || width <= 0 || height <= 0) {
+    return Result<void>::error("Invalid atlas image: " + id);
+  }
+  for (const auto &image : m_images) {
+    if (image.id == id) {
+      return Result<void>::error("Duplicate atlas image: " + id);
+    }
+  }
+
+  Image image;
+  image.group = group;
+  image.id = id;
+  image.width = width;
+  image.height = height;
+  image.rgba.assign(rgba, rgba + pixelOffset(0, height, width));
+  m_images.push_back(std::move(image));
+  return Result<void>::ok();
+}
+
+Result<void> TextureAtlasBuilder::build(const std::string &pagePrefix) {
+  m_pages.clear();
+  m_index = TextureAtlasIndex{};
+  m_rejected.clear();
+
+  std::map<std::string, std::vector<const Image *>> groups;
+  for (const auto &image : m_images) {
+    groups[image.group].push_back(&image);
+  }
+
+  const i32 border = m_padding;
+  const i32 maxSprite = m_maxPageSize / 2;
+
+  for (auto &[group, members] : groups) {
+    std::vector<const Image *> candidates;
+    for (const auto *image : members) {
+      if (image->width + 2 * border > maxSprite ||
+          image->height + 2 * border > maxSprite) {
+        m_rejected.push_back(image->id);
+      } else {
+        candidates.push_back(image);
+      }
+    }
+    if (candidates.size() < 2) {
+      for (const auto *image : candidates) {
+        m_rejected.push_back(image->id);
+      }
+      continue;
+    }
+
+    // Largest first packs tightest; ids break ties for reproducible output
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Image *a, const Image *b) {
+                const i32 sideA = std::max(a->width, a->height);
+                const i32 sideB = std::max(b->width, b->height);
+                if (sideA != sideB) {
+                  return sideA > sideB;
+                }
+                const i64 areaA = static_cast<i64>(a->width) * a->height;
+                const i64 areaB = static_cast<i64>(b->width) * b->height;
+                if (areaA != areaB) {
+                  return areaA > areaB;
+                }
+                return a->id < b->id;
+              });
+
+    struct Placement {
+      const Image *image;
+      usize bin;
+      AtlasRect rect;
+    };
+    std::vector<MaxRectsPacker> bins;
+    std::vector<Placement> placements;
+    for (const auto *image : candidates) {
+      const i32 w = image->width + 2 * border;
+      const i32 h = image->height + 2 * border;
+      std::optional<AtlasRect> rect;
+      usize bin = 0;
+      for (; bin < bins.size(); ++bin) {
+        rect = bins[bin].insert(w, h);
+        if (rect) {
+          break;
+        }
+      }
+      if (!rect) {
+        bins.emplace_back(m_maxPageSize, m_maxPageSize);
+        rect = bins.back().insert(w, h);
+      }
+      if (!rect) {
+        return Result<void>::error("Atlas packing failed for " + image->id);
+      }
+      placements.push_back(Placement{image, bin, *rect});
+    }
+
+    const std::string baseName = pagePrefix + sanitizeGroup(group);
+    for (usize bin = 0; bin < bins.size(); ++bin) {
+      i32 usedWidth = 0;
+      i32 usedHeight = 0;
+      for (const auto &rect : bins[bin].usedRects()) {
+        usedWidth = std::max(usedWidth, rect.x + rect.width);
+        usedHeight = std::max(usedHeight, rect.y + rect.height);
+      }
+
+      Page page;
+      page.id = baseName + "_" + std::to_string(bin) + ".tga";
+      page.width = std::min(nextPowerOfTwo(usedWidth), m_maxPageSize);
+      page.height = std::min(nextPowerOfTwo(usedHeight), m_maxPageSize);
+      page.rgba.assign(pixelOffset(0, page.height, page.width), 0);
+
+      const u32 pageIndex = m_index.addPage(page.id, page.width, page.height);
+      for (const auto &placement : placements) {
+        if (placement.bin != bin) {
+          continue;
+        }
+        const i32 x = placement.rect.x + border;
+        const i32 y = placement.rect.y + border;
+        blit(page, *placement.image, x, y);
+        m_index.addSprite(placement.image->id, pageIndex,
+                          AtlasRect{x, y, placement.image->width,
+                                    placement.image->height});
+      }
+      m_pages.push_back(std::move(page));
+    }
+  }
+
+  return Result<void>::ok();
+}
+
+void TextureAtlasBuilder::blit(Page &page, const Image &image, i32 x,
+                               i32 y) const {
+  // Copy the image and extrude its edge pixels into the border around it
+  const i32 border = m_padding;
+  for (i32 row = -border; row < image.height + border; ++row) {
+    const i32 srcY = std::clamp(row, 0, image.height - 1);
+    const u8 *srcRow = image.rgba.data() + pixelOffset(0, srcY, image.width);
+    u8 *dstRow = page.rgba.data() + pixelOffset(x, y + row, page.width);
+
+    std::memcpy(dstRow, srcRow, static_cast<usize>(image.width) * 4);
+    const u8 *last = srcRow + pixelOffset(image.width - 1, 0, image.width);
+    for (i32 i = 1; i <= border; ++i) {
+      std::memcpy(dstRow - static_cast<std::ptrdiff_t>(i) * 4, srcRow, 4);
+      std::memcpy(dstRow + pixelOffset(image.width - 1 + i, 0, image.width),
+                  last, 4);
+    }
+  }
+}
+
+std::vector<u8> TextureAtlasBuilder::encodeTga(const u8 *rgba, i32 width,
+                                               i32 height) {
+  std::vector<u8> out;
+  if (!rgba || width <= 0 || height <= 0 || width > 0xFFFF ||
+      height > 0xFFFF) {
+    return out;
+  }
+
+  out.reserve(18 + pixelOffset(0, height, width));
+  out.insert(out.end(), {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+  out.push_back(static_cast<u8>(width & 0xFF));
+  out.push_back(static_cast<u8>(width >> 8));
+  out.push_back(static_cast<u8>(height & 0xFF));
+  out.push_back(static_cast<u8>(height >> 8));
+  out.push_back(32);
+  out.push_back(0x28); // 8 alpha bits, top-left origin
+
+  const usize count = static_cast<usize>(width) * static_cast<usize>(height);
+  for (usize i = 0; i < count; ++i) {
+    const u8 *pixel = rgba + i * 4;
+    out.insert(out.end(), {pixel[2], pixel[1], pixel[0], pixel[3]});
+  }
+  return out;
+}
+
+} // namespace NovelMind::renderer
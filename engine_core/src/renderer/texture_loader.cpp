@@ -0,0 +1,397 @@
+#include "NovelMind/renderer/texture_loader.hpp"
+#include "NovelMind/core/logger.hpp"
+#include "stb/stb_image.h"
+
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+#include <SDL.h>
+#include <SDL_opengl.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace NovelMind::renderer {
+
+namespace {
+
+/// Recycled decode buffers are kept up to this much capacity in total
+constexpr usize kPoolBytes = usize{64} << 20;
+
+} // namespace
+
+struct AsyncTextureLoader::Job {
+  std::weak_ptr<Texture> texture;
+  std::shared_ptr<const std::vector<u8>> encoded;
+  std::vector<u8> pixels;
+  i32 width = 0;
+  i32 height = 0;
+  std::string error;
+  i32 uploadedRows = 0;
+  bool started = false;
+};
+
+struct AsyncTextureLoader::Workers {
+  explicit Workers(u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+      threads.emplace_back([this]() { loop(); });
+    }
+  }
+
+  ~Workers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  void submit(std::unique_ptr<Job> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(std::move(job));
+    }
+    wake.notify_one();
+  }
+
+  void takeDone(std::deque<std::unique_ptr<Job>> &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &job : done) {
+      out.push_back(std::move(job));
+    }
+    done.clear();
+  }
+
+  void waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return queue.empty() && decoding == 0; });
+  }
+
+  [[nodiscard]] usize pending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size() + decoding + done.size();
+  }
+
+  std::vector<u8> acquire(usize size) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto best = pool.end();
+      for (auto it = pool.begin(); it != pool.end(); ++it) {
+        if (it->capacity() >= size &&
+            (best == pool.end() || it->capacity() < best->capacity())) {
+          best = it;
+        }
+      }
+      if (best != pool.end()) {
+        std::vector<u8> buffer = std::move(*best);
+        pooledBytes -= buffer.capacity();
+        pool.erase(best);
+        buffer.resize(size);
+        return buffer;
+      }
+    }
+    return std::vector<u8>(size);
+  }
+
+  void release(std::vector<u8> &&buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (buffer.capacity() == 0 ||
+        pooledBytes + buffer.capacity() > kPoolBytes) {
+      return;
+    }
+    pooledBytes += buffer.capacity();
+    pool.push_back(std::move(buffer));
+  }
+
+  void decode(Job &job) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_uc *pixels = stbi_load_from_memory(
+        reinterpret_cast<const stbi_uc *>(job.encoded->data()),
+        static_cast<int>(job.encoded->size()), &width, &height, &channels, 4);
+    job.encoded.reset();
+
+    if (!pixels || width <= 0 || height <= 0) {
+      const char *reason = stbi_failure_reason();
+      job.error = reason ? reason : "Failed to decode texture";
+      stbi_image_free(pixels);
+      return;
+    }
+
+    const usize bytes =
+        static_cast<usize>(width) * static_cast<usize>(height) * 4;
+    job.pixels = acquire(bytes);
+    std::memcpy(job.pixels.data(), pixels, bytes);
+    stbi_image_free(pixels);
+    job.width = width;
+    job.height = height;
+  }
+
+  void loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+      if (stopping) {
+        return;
+      }
+      auto job = std::move(queue.front());
+      queue.pop_front();
+      ++decoding;
+      lock.unlock();
+
+      // Nobody is waiting for textures released while queued
+      const bool wanted = !job->texture.expired();
+      if (wanted) {
+        decode(*job);
+      }
+
+      lock.lock();
+      --decoding;
+      if (wanted) {
+        done.push_back(std::move(job));
+      }
+      if (queue.empty() && decoding == 0) {
+        idle.notify_all();
+      }
+    }
+  }
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  std::deque<std::unique_ptr<Job>> queue;
+  std::vector<std::unique_ptr<Job>> done;
+  std::vector<std::vector<u8>> pool;
+  usize pooledBytes = 0;
+  usize decoding = 0;
+  bool stopping = false;
+};
+
+/**
+ * @brief Ring of pixel unpack buffers for streaming rows to the GPU
+ *
+ * Each chunk orphans the next buffer, so the driver never waits for a
+ * previous transfer before handing out memory to write into.
+ */
+struct AsyncTextureLoader::PixelUnpackBuffers {
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+  static constexpr usize kCount = 3;
+
+  PixelUnpackBuffers() {
+    genBuffers = reinterpret_cast<PFNGLGENBUFFERSPROC>(
+        SDL_GL_GetProcAddress("glGenBuffers"));
+    deleteBuffers = reinterpret_cast<PFNGLDELETEBUFFERSPROC>(
+        SDL_GL_GetProcAddress("glDeleteBuffers"));
+    bindBuffer = reinterpret_cast<PFNGLBINDBUFFERPROC>(
+        SDL_GL_GetProcAddress("glBindBuffer"));
+    bufferData = reinterpret_cast<PFNGLBUFFERDATAPROC>(
+        SDL_GL_GetProcAddress("glBufferData"));
+    mapBuffer = reinterpret_cast<PFNGLMAPBUFFERPROC>(
+        SDL_GL_GetProcAddress("glMapBuffer"));
+    unmapBuffer = reinterpret_cast<PFNGLUNMAPBUFFERPROC>(
+        SDL_GL_GetProcAddress("glUnmapBuffer"));
+    supported = genBuffers && deleteBuffers && bindBuffer && bufferData &&
+                mapBuffer && unmapBuffer;
+    if (supported) {
+      genBuffers(static_cast<GLsizei>(kCount), buffers);
+      NOVELMIND_LOG_INFO("Streaming texture uploads through pixel buffers");
+    }
+  }
+
+  ~PixelUnpackBuffers() {
+    if (supported) {
+      deleteBuffers(static_cast<GLsizei>(kCount), buffers);
+    }
+  }
+
+  /// Copy rows into the next buffer and leave it bound; false on failure
+  bool stage(const u8 *rows, usize bytes) {
+    if (!supported) {
+      return false;
+    }
+    bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers[next]);
+    next = (next + 1) % kCount;
+    bufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes),
+               nullptr, GL_STREAM_DRAW);
+    void *target = mapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    if (!target) {
+      bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+      return false;
+    }
+    std::memcpy(target, rows, bytes);
+    if (unmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_TRUE) {
+      bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+      return false;
+    }
+    return true;
+  }
+
+  void unbind() { bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); }
+
+  PFNGLGENBUFFERSPROC genBuffers = nullptr;
+  PFNGLDELETEBUFFERSPROC deleteBuffers = nullptr;
+  PFNGLBINDBUFFERPROC bindBuffer = nullptr;
+  PFNGLBUFFERDATAPROC bufferData = nullptr;
+  PFNGLMAPBUFFERPROC mapBuffer = nullptr;
+  PFNGLUNMAPBUFFERPROC unmapBuffer = nullptr;
+  GLuint buffers[kCount] = {};
+  usize next = 0;
+  bool supported = false;
+#else
+  bool stage(const u8 *, usize) { return false; }
+  void unbind() {}
+#endif
+};
+
+AsyncTextureLoader::AsyncTextureLoader(u32 threadCount) {
+  if (threadCount == 0) {
+    const u32 cores = std::thread::hardware_concurrency();
+    threadCount = std::clamp<u32>(cores > 1 ? cores - 1 : 1, 1, 4);
+  }
+  m_workers = std::make_unique<Workers>(threadCount);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() = default;
+
+void AsyncTextureLoader::load(const std::shared_ptr<Texture> &texture,
+                              std::vector<u8> encoded) {
+  load(texture,
+       std::make_shared<const std::vector<u8>>(std::move(encoded)));
+}
+
+void AsyncTextureLoader::load(const std::shared_ptr<Texture> &texture,
+                              std::shared_ptr<const std::vector<u8>> encoded) {
+  if (!texture || !encoded) {
+    return;
+  }
+  texture->markLoading();
+
+  auto job = std::make_unique<Job>();
+  job->texture = texture;
+  job->encoded = std::move(encoded);
+  m_workers->submit(std::move(job));
+}
+
+void AsyncTextureLoader::reserve(const std::shared_ptr<Texture> &texture) {
+  if (texture) {
+    texture->markLoading();
+  }
+}
+
+void AsyncTextureLoader::fail(const std::shared_ptr<Texture> &texture) {
+  if (texture) {
+    texture->markFailed();
+  }
+}
+
+usize AsyncTextureLoader::pump() {
+  return pumpWithBudget(m_budget.bytesPerFrame, m_budget.millisecondsPerFrame);
+}
+
+void AsyncTextureLoader::finish() {
+  while (getPendingCount() > 0) {
+    m_workers->waitIdle();
+    pumpWithBudget(std::numeric_limits<usize>::max(),
+                   std::numeric_limits<f64>::infinity());
+  }
+}
+
+usize AsyncTextureLoader::getPendingCount() const {
+  return m_workers->pending() + m_uploads.size();
+}
+
+u32 AsyncTextureLoader::getThreadCount() const {
+  return static_cast<u32>(m_workers->threads.size());
+}
+
+usize AsyncTextureLoader::pumpWithBudget(usize byteBudget,
+                                         f64 timeBudgetMs) {
+  const auto start = std::chrono::steady_clock::now();
+  m_workers->takeDone(m_uploads);
+
+  usize uploaded = 0;
+  while (!m_uploads.empty()) {
+    Job &job = *m_uploads.front();
+    auto texture = job.texture.lock();
+
+    // Released, or reloaded some other way, since it was queued
+    if (!texture || !texture->isLoading()) {
+      m_workers->release(std::move(job.pixels));
+      m_uploads.pop_front();
+      continue;
+    }
+
+    if (!job.error.empty()) {
+      NOVELMIND_LOG_WARN("Failed to decode texture: " + job.error);
+      texture->markFailed();
+      m_uploads.pop_front();
+      continue;
+    }
+
+    if (!Texture::isGpuUploadEnabled()) {
+      texture->adoptPixels(std::move(job.pixels), job.width, job.height);
+      m_uploads.pop_front();
+      continue;
+    }
+
+    // Always make some progress, then stop at whichever budget runs out
+    const std::chrono::duration<f64, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (uploaded > 0 &&
+        (uploaded >= byteBudget || elapsed.count() >= timeBudgetMs)) {
+      break;
+    }
+
+    uploaded += uploadChunk(job, *texture, byteBudget - uploaded);
+    if (job.uploadedRows == job.height) {
+      texture->finishUpload();
+      m_workers->release(std::move(job.pixels));
+      m_uploads.pop_front();
+    }
+  }
+  return uploaded;
+}
+
+usize AsyncTextureLoader::uploadChunk(Job &job, Texture &texture,
+                                      usize byteBudget) {
+  if (!job.started) {
+    texture.beginUpload(job.width, job.height);
+    job.started = true;
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+    if (!m_unpackBuffers) {
+      m_unpackBuffers = std::make_unique<PixelUnpackBuffers>();
+    }
+#endif
+  }
+
+  const usize rowBytes = static_cast<usize>(job.width) * 4;
+  const usize remaining = static_cast<usize>(job.height - job.uploadedRows);
+  const usize rows = std::min(
+      remaining,
+      std::max<usize>(std::min(byteBudget, kChunkBytes) / rowBytes, 1));
+  const usize bytes = rows * rowBytes;
+  const u8 *source =
+      job.pixels.data() + static_cast<usize>(job.uploadedRows) * rowBytes;
+
+  if (m_unpackBuffers && m_unpackBuffers->stage(source, bytes)) {
+    texture.uploadRows(nullptr, job.uploadedRows, static_cast<i32>(rows));
+    m_unpackBuffers->unbind();
+  } else {
+    texture.uploadRows(source, job.uploadedRows, static_cast<i32>(rows));
+  }
+
+  job.uploadedRows += static_cast<i32>(rows);
+  return bytes;
+}
+
+} // namespace NovelMind::renderer
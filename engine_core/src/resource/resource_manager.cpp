@@ -1,7 +1,9 @@
 #include "NovelMind/resource/resource_manager.hpp"
 #include "NovelMind/core/logger.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 
 namespace NovelMind::resource {
 
@@ -40,43 +42,132 @@ ResourceManager::ResourceManager(vfs::IVirtualFileSystem *vfs) : m_vfs(vfs) {}
 
 ResourceManager::~ResourceManager() { clearCache(); }
 
-void ResourceManager::setVfs(vfs::IVirtualFileSystem *vfs) { m_vfs = vfs; }
+void ResourceManager::setVfs(vfs::IVirtualFileSystem *vfs) {
+  m_vfs = vfs;
+  m_atlasIndexLoaded = false;
+}
 
 void ResourceManager::setBasePath(const std::string &path) {
   m_basePath = path;
+  m_atlasIndexLoaded = false;
   if (!m_basePath.empty() &&
       m_basePath.back() != '/' && m_basePath.back() != '\\') {
     m_basePath.push_back(fs::path::preferred_separator);
   }
 }
 
-Result<TextureHandle> ResourceManager::loadTexture(const std::string &id) {
+Result<TextureView> ResourceManager::loadTexture(const std::string &id) {
   if (id.empty()) {
-    return Result<TextureHandle>::error("Texture id is empty");
+    return Result<TextureView>::error("Texture id is empty");
   }
 
-  auto it = m_textures.find(id);
-  if (it != m_textures.end() && it->second && it->second->isValid()) {
-    return Result<TextureHandle>::ok(it->second);
+  if (const auto *sprite = findAtlasSprite(id)) {
+    const auto &page = m_atlasIndex.pages()[sprite->page];
+    auto pageResult = loadTextureFile(page.id);
+    if (pageResult.isError()) {
+      return Result<TextureView>::error(pageResult.error());
+    }
+    const auto &rect = sprite->rect;
+    return Result<TextureView>::ok(TextureView{
+        pageResult.value(),
+        renderer::Rect{static_cast<f32>(rect.x), static_cast<f32>(rect.y),
+                       static_cast<f32>(rect.width),
+                       static_cast<f32>(rect.height)}});
   }
 
-  auto dataResult = readResource(id);
-  if (dataResult.isError()) {
-    return Result<TextureHandle>::error(dataResult.error());
+  auto textureResult = loadTextureFile(id);
+  if (textureResult.isError()) {
+    return Result<TextureView>::error(textureResult.error());
   }
+  const auto &texture = textureResult.value();
+  return Result<TextureView>::ok(TextureView{
+      texture, renderer::Rect{0.0f, 0.0f,
+                              static_cast<f32>(texture->getWidth()),
+                              static_cast<f32>(texture->getHeight())}});
+}
 
-  auto texture = std::make_shared<renderer::Texture>();
-  auto loadResult = texture->loadFromMemory(dataResult.value());
-  if (loadResult.isError()) {
-    return Result<TextureHandle>::error(loadResult.error());
+void ResourceManager::unloadTexture(const std::string &id) {
+  cancelTextureRead(id);
+  m_textures.erase(id);
+}
+
+void ResourceManager::setAsyncTextureLoading(bool enabled, u32 threadCount) {
+  if (!enabled) {
+    finishTextureLoads();
+    m_textureLoader.reset();
+    return;
   }
+  if (m_textureLoader &&
+      (threadCount == 0 || m_textureLoader->getThreadCount() == threadCount)) {
+    return;
+  }
+  finishTextureLoads();
+  m_textureLoader = std::make_unique<renderer::AsyncTextureLoader>(threadCount);
+  m_textureLoader->setBudget(m_uploadBudget);
+}
 
-  m_textures[id] = texture;
-  return Result<TextureHandle>::ok(texture);
+void ResourceManager::setTextureUploadBudget(
+    const renderer::TextureUploadBudget &budget) {
+  m_uploadBudget = budget;
+  if (m_textureLoader) {
+    m_textureLoader->setBudget(budget);
+  }
 }
 
-void ResourceManager::unloadTexture(const std::string &id) {
-  m_textures.erase(id);
+usize ResourceManager::update() {
+  return m_textureLoader ? m_textureLoader->pump() : 0;
+}
+
+void ResourceManager::finishTextureLoads() {
+  if (!m_textureReads.empty() && m_vfs) {
+    // Completions are queued before waiters wake, so one dispatch after
+    // waiting hands every read to the decoder
+    for (const auto &entry : m_textureReads) {
+      entry.second.wait();
+    }
+    m_vfs->processCompletions();
+  }
+
+  // Reads the VFS dropped without completing, e.g. while shutting down
+  for (const auto &entry : m_textureReads) {
+    auto it = m_textures.find(entry.first);
+    if (m_textureLoader && it != m_textures.end()) {
+      m_textureLoader->fail(it->second);
+    }
+  }
+  m_textureReads.clear();
+
+  if (m_textureLoader) {
+    m_textureLoader->finish();
+  }
+}
+
+usize ResourceManager::getPendingTextureCount() const {
+  return m_textureReads.size() +
+         (m_textureLoader ? m_textureLoader->getPendingCount() : 0);
+}
+
+void ResourceManager::setTextureAtlasIndex(renderer::TextureAtlasIndex index) {
+  m_atlasIndex = std::move(index);
+  m_atlasIndexLoaded = true;
+}
+
+const renderer::TextureAtlasIndex &ResourceManager::getTextureAtlasIndex() {
+  if (!m_atlasIndexLoaded) {
+    m_atlasIndexLoaded = true;
+    auto dataResult = readResource(renderer::TextureAtlasIndex::kResourceId);
+    if (dataResult.isOk()) {
+      const auto &data = dataResult.value();
+      auto indexResult = renderer::TextureAtlasIndex::parse(
+          std::string(data.begin(), data.end()));
+      if (indexResult.isOk()) {
+        m_atlasIndex = std::move(indexResult).value();
+      } else {
+        NOVELMIND_LOG_WARN(indexResult.error());
+      }
+    }
+  }
+  return m_atlasIndex;
 }
 
 Result<FontHandle> ResourceManager::loadFont(const std::string &id, i32 size) {
@@ -153,7 +244,13 @@ Result<std::vector<u8>> ResourceManager::readData(const std::string &id) const {
 }
 
 void ResourceManager::clearCache() {
+  for (auto &entry : m_textureReads) {
+    entry.second.cancel();
+  }
+  m_textureReads.clear();
   m_textures.clear();
+  m_atlasIndex = renderer::TextureAtlasIndex{};
+  m_atlasIndexLoaded = false;
   m_fonts.clear();
   m_fontAtlases.clear();
 }
@@ -198,6 +295,108 @@ ResourceManager::readResource(const std::string &id) const {
       "Failed to read resource: " + id);
 }
 
+Result<TextureHandle>
+ResourceManager::loadTextureFile(const std::string &id) {
+  auto it = m_textures.find(id);
+  if (it != m_textures.end() && it->second) {
+    if (it->second->isValid() || it->second->isLoading()) {
+      return Result<TextureHandle>::ok(it->second);
+    }
+    if (it->second->getState() == renderer::TextureState::Failed) {
+      m_textures.erase(it);
+      return Result<TextureHandle>::error("Failed to decode texture: " + id);
+    }
+  }
+
+  auto texture = std::make_shared<renderer::Texture>();
+  if (m_textureLoader && readTextureAsync(id, texture)) {
+    m_textures[id] = texture;
+    return Result<TextureHandle>::ok(texture);
+  }
+
+  auto dataResult = readResource(id);
+  if (dataResult.isError()) {
+    return Result<TextureHandle>::error(dataResult.error());
+  }
+
+  if (m_textureLoader) {
+    m_textureLoader->load(texture, std::move(dataResult).value());
+    m_textures[id] = texture;
+    return Result<TextureHandle>::ok(texture);
+  }
+
+  auto loadResult = texture->loadFromMemory(dataResult.value());
+  if (loadResult.isError()) {
+    return Result<TextureHandle>::error(loadResult.error());
+  }
+
+  m_textures[id] = texture;
+  return Result<TextureHandle>::ok(texture);
+}
+
+bool ResourceManager::readTextureAsync(const std::string &id,
+                                       const TextureHandle &texture) {
+  // Loose files override packed ones and are read directly; ids the VFS
+  // does not have fail now rather than in a later frame
+  if (!m_vfs || !resolvePath(id).empty() || !m_vfs->exists(id)) {
+    return false;
+  }
+
+  cancelTextureRead(id);
+  std::weak_ptr<renderer::Texture> weak = texture;
+  auto handle = m_vfs->readAsync(
+      id, VFS::ReadPriority::Visible,
+      [this, id, weak](const VFS::ResourceId &,
+                       const Result<VFS::SharedBuffer> &result) {
+        m_textureReads.erase(id);
+        auto loading = weak.lock();
+        if (!loading || !loading->isLoading() || !m_textureLoader) {
+          return;
+        }
+        if (result.isError()) {
+          NOVELMIND_LOG_WARN("Failed to read texture: " + result.error());
+          m_textureLoader->fail(loading);
+          return;
+        }
+        m_textureLoader->load(loading, result.value());
+      });
+  if (!handle.isValid()) {
+    return false;
+  }
+
+  m_textureLoader->reserve(texture);
+  m_textureReads[id] = std::move(handle);
+  return true;
+}
+
+void ResourceManager::cancelTextureRead(const std::string &id) {
+  auto it = m_textureReads.find(id);
+  if (it != m_textureReads.end()) {
+    it->second.cancel();
+    m_textureReads.erase(it);
+  }
+}
+
+const renderer::TextureAtlasSprite *
+ResourceManager::findAtlasSprite(const std::string &id) {
+  const auto &index = getTextureAtlasIndex();
+  if (index.empty()) {
+    return nullptr;
+  }
+  if (const auto *sprite = index.find(id)) {
+    return sprite;
+  }
+
+  // The index uses paths relative to the project's assets folder
+  std::string normalized = id;
+  std::replace(normalized.begin(), normalized.end(), '\\', '/');
+  constexpr std::string_view kAssetsPrefix = "assets/";
+  if (normalized.compare(0, kAssetsPrefix.size(), kAssetsPrefix) == 0) {
+    normalized.erase(0, kAssetsPrefix.size());
+  }
+  return normalized != id ? index.find(normalized) : nullptr;
+}
+
 std::string ResourceManager::resolvePath(const std::string &id) const {
   if (id.empty()) {
     return {};
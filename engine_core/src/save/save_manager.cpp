@@ -1,5 +1,6 @@
 #include "NovelMind/save/save_manager.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/renderer/image_processing.hpp"
 #include <algorithm>
 #include <array>
 #include <chrono>
@@ -336,6 +337,23 @@ void SaveManager::setConfig(const SaveConfig &config) { m_config = config; }
 
 const SaveConfig &SaveManager::getConfig() const { return m_config; }
 
+Result<void> SaveManager::setThumbnail(SaveData &data, const u8 *rgba,
+                                       i32 width, i32 height, i32 maxWidth,
+                                       i32 maxHeight) {
+  auto thumbnail =
+      renderer::resampleToFit(rgba, width, height, maxWidth, maxHeight);
+  if (thumbnail.isError()) {
+    return Result<void>::error("Failed to create thumbnail: " +
+                               thumbnail.error());
+  }
+
+  auto &image = thumbnail.value();
+  data.thumbnailData = std::move(image.pixels);
+  data.thumbnailWidth = image.width;
+  data.thumbnailHeight = image.height;
+  return Result<void>::ok();
+}
+
 Result<void> SaveManager::saveAuto(const SaveData &data) {
   return saveToFile(getAutoSaveFilename(), data);
 }
@@ -4,6 +4,7 @@
  */
 
 #include "NovelMind/scene/scene_graph.hpp"
+#include "NovelMind/vfs/access_trace.hpp"
 
 #include <algorithm>
 
@@ -21,7 +22,12 @@ SceneGraph::SceneGraph()
 
 SceneGraph::~SceneGraph() = default;
 
-void SceneGraph::setSceneId(const std::string &id) { m_sceneId = id; }
+void SceneGraph::setSceneId(const std::string &id) {
+  if (m_traceRecorder && id != m_sceneId) {
+    m_traceRecorder->markScene(id);
+  }
+  m_sceneId = id;
+}
 
 void SceneGraph::clear() {
   m_backgroundLayer.clear();
@@ -245,10 +251,90 @@ void SceneGraph::update(f64 deltaTime) {
 }
 
 void SceneGraph::render(renderer::IRenderer &renderer) {
+  // Layer keys let batching renderers group draws within each layer
+  renderer.setLayer(0);
   m_backgroundLayer.render(renderer);
+  renderer.setLayer(1);
   m_characterLayer.render(renderer);
+  renderer.setLayer(2);
   m_uiLayer.render(renderer);
+  renderer.setLayer(3);
   m_effectLayer.render(renderer);
+  renderer.setLayer(0);
+
+  // Remember what was drawn where, so the next change can be bounded
+  for (Layer *layer :
+       {&m_backgroundLayer, &m_characterLayer, &m_uiLayer, &m_effectLayer}) {
+    const bool layerShown = layer->m_visible && layer->m_alpha > 0.0f;
+    for (auto &obj : layer->m_objects) {
+      obj->m_dirty = false;
+      obj->m_drawn = layerShown && obj->isVisible();
+      obj->m_drawnBounds =
+          obj->m_drawn ? obj->getBounds() : std::nullopt;
+    }
+    layer->m_dirty = false;
+  }
+  m_allDirty = false;
+}
+
+SceneDamage SceneGraph::getDamage() const {
+  SceneDamage damage;
+  if (m_allDirty) {
+    damage.changed = damage.full = true;
+    return damage;
+  }
+
+  f32 left = 0.0f;
+  f32 top = 0.0f;
+  f32 right = 0.0f;
+  f32 bottom = 0.0f;
+  const auto add = [&](const renderer::Rect &rect) {
+    if (!damage.changed) {
+      left = rect.x;
+      top = rect.y;
+      right = rect.x + rect.width;
+      bottom = rect.y + rect.height;
+    } else {
+      left = std::min(left, rect.x);
+      top = std::min(top, rect.y);
+      right = std::max(right, rect.x + rect.width);
+      bottom = std::max(bottom, rect.y + rect.height);
+    }
+    damage.changed = true;
+  };
+
+  for (const Layer *layer :
+       {&m_backgroundLayer, &m_characterLayer, &m_uiLayer, &m_effectLayer}) {
+    if (layer->m_dirty) {
+      damage.changed = damage.full = true;
+      return damage;
+    }
+    const bool layerShown = layer->m_visible && layer->m_alpha > 0.0f;
+    for (const auto &obj : layer->m_objects) {
+      const bool shown = layerShown && obj->isVisible();
+      if (!obj->m_dirty || (!shown && !obj->m_drawn)) {
+        continue;
+      }
+      // Both where it was drawn and where it is now
+      std::optional<renderer::Rect> now;
+      if (shown) {
+        now = obj->getBounds();
+      }
+      if ((obj->m_drawn && !obj->m_drawnBounds) || (shown && !now)) {
+        damage.changed = damage.full = true;
+        return damage;
+      }
+      if (obj->m_drawn) {
+        add(*obj->m_drawnBounds);
+      }
+      if (now) {
+        add(*now);
+      }
+    }
+  }
+
+  damage.rect = renderer::Rect{left, top, right - left, bottom - top};
+  return damage;
 }
 
 void SceneGraph::setResourceManager(resource::ResourceManager *resources) {
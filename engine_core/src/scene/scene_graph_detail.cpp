@@ -1,5 +1,8 @@
 #include "scene_graph_detail.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace NovelMind::scene::detail {
@@ -84,4 +87,44 @@ std::string defaultFontPath() {
 #endif
 }
 
+const resource::TextureView *
+resolveTexture(resource::ResourceManager &resources, const std::string &id,
+               resource::TextureView &shown) {
+  auto result = resources.loadTexture(id);
+  if (result.isOk() && result.value().isValid()) {
+    shown = result.value();
+    return &shown;
+  }
+  if (result.isOk() && result.value().isLoading() && shown.isValid()) {
+    return &shown;
+  }
+  return nullptr;
+}
+
+renderer::Rect spriteBounds(const renderer::Transform2D &transform,
+                            f32 width, f32 height) {
+  // Same placement as RenderCommandBuffer::pushSprite
+  const f32 radians = transform.rotation * 3.14159265358979f / 180.0f;
+  const f32 cosA = std::cos(radians);
+  const f32 sinA = std::sin(radians);
+  f32 minX = std::numeric_limits<f32>::max();
+  f32 minY = minX;
+  f32 maxX = std::numeric_limits<f32>::lowest();
+  f32 maxY = maxX;
+  for (const auto &[localX, localY] :
+       {std::pair{0.0f, 0.0f}, std::pair{width, 0.0f},
+        std::pair{width, height}, std::pair{0.0f, height}}) {
+    const f32 sx = (localX - transform.anchorX) * transform.scaleX;
+    const f32 sy = (localY - transform.anchorY) * transform.scaleY;
+    const f32 x = transform.x + sx * cosA - sy * sinA;
+    const f32 y = transform.y + sx * sinA + sy * cosA;
+    minX = std::min(minX, x);
+    minY = std::min(minY, y);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+  }
+  return renderer::Rect{minX - 1.0f, minY - 1.0f, maxX - minX + 2.0f,
+                        maxY - minY + 2.0f};
+}
+
 } // namespace NovelMind::scene::detail
@@ -23,4 +23,16 @@ std::string getTextProperty(const SceneObjectBase &obj,
                             const std::string &fallback);
 std::string defaultFontPath();
 
+/// View to draw for a texture id: the loaded one, or while it is still
+/// loading asynchronously the one shown before; nullptr if there is none
+const resource::TextureView *
+resolveTexture(resource::ResourceManager &resources, const std::string &id,
+               resource::TextureView &shown);
+
+/// Screen-aligned box around a sprite of width x height drawn with
+/// transform, grown by a pixel for filtering at the edges
+NovelMind::renderer::Rect
+spriteBounds(const NovelMind::renderer::Transform2D &transform, f32 width,
+             f32 height);
+
 } // namespace NovelMind::scene::detail
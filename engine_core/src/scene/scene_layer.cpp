@@ -30,12 +30,16 @@ std::unique_ptr<SceneObjectBase> Layer::removeObject(const std::string &id) {
   if (it != m_objects.end()) {
     auto obj = std::move(*it);
     m_objects.erase(it);
+    m_dirty = true;
     return obj;
   }
   return nullptr;
 }
 
-void Layer::clear() { m_objects.clear(); }
+void Layer::clear() {
+  m_objects.clear();
+  m_dirty = true;
+}
 
 SceneObjectBase *Layer::findObject(const std::string &id) {
   auto it = std::find_if(m_objects.begin(), m_objects.end(),
@@ -49,10 +53,14 @@ const SceneObjectBase *Layer::findObject(const std::string &id) const {
   return (it != m_objects.end()) ? it->get() : nullptr;
 }
 
-void Layer::setVisible(bool visible) { m_visible = visible; }
+void Layer::setVisible(bool visible) {
+  m_visible = visible;
+  m_dirty = true;
+}
 
 void Layer::setAlpha(f32 alpha) {
   m_alpha = std::max(0.0f, std::min(1.0f, alpha));
+  m_dirty = true;
 }
 
 void Layer::sortByZOrder() {
@@ -60,6 +68,7 @@ void Layer::sortByZOrder() {
                    [](const auto &a, const auto &b) {
                      return a->getZOrder() < b->getZOrder();
                    });
+  m_dirty = true;
 }
 
 void Layer::update(f64 deltaTime) {
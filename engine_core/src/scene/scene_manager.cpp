@@ -1,5 +1,6 @@
 #include "NovelMind/scene/scene_manager.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/access_trace.hpp"
 #include <algorithm>
 
 namespace NovelMind::scene {
@@ -11,6 +12,9 @@ SceneManager::~SceneManager() { unloadScene(); }
 Result<void> SceneManager::loadScene(const std::string &sceneId) {
   unloadScene();
   m_currentSceneId = sceneId;
+  if (m_traceRecorder) {
+    m_traceRecorder->markScene(sceneId);
+  }
   NOVELMIND_LOG_INFO("Loaded scene: " + sceneId);
   return Result<void>::ok();
 }
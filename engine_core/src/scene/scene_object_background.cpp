@@ -24,7 +24,10 @@ void BackgroundObject::setTextureId(const std::string &textureId) {
   notifyPropertyChanged("textureId", oldValue, textureId);
 }
 
-void BackgroundObject::setTint(const renderer::Color &color) { m_tint = color; }
+void BackgroundObject::setTint(const renderer::Color &color) {
+  m_tint = color;
+  markDirty();
+}
 
 void BackgroundObject::render(renderer::IRenderer &renderer) {
   if (!m_visible || m_alpha <= 0.0f) {
@@ -35,33 +38,28 @@ void BackgroundObject::render(renderer::IRenderer &renderer) {
     return;
   }
 
-  auto texResult = m_resources->loadTexture(m_textureId);
-  if (texResult.isError()) {
-    return;
-  }
-
-  const auto &texture = *texResult.value();
-  if (!texture.isValid()) {
+  const auto *shown =
+      detail::resolveTexture(*m_resources, m_textureId, m_shownTexture);
+  if (!shown) {
     return;
   }
+  const auto &view = *shown;
 
   renderer::Transform2D transform = m_transform;
   const float desiredW = detail::parseFloat(getProperty("width"), -1.0f);
   const float desiredH = detail::parseFloat(getProperty("height"), -1.0f);
   if (desiredW > 0.0f) {
-    transform.scaleX = desiredW / static_cast<float>(texture.getWidth());
+    transform.scaleX = desiredW / view.width();
   }
   if (desiredH > 0.0f) {
-    transform.scaleY = desiredH / static_cast<float>(texture.getHeight());
+    transform.scaleY = desiredH / view.height();
   }
-  transform.anchorX =
-      m_anchorX * static_cast<f32>(texture.getWidth());
-  transform.anchorY =
-      m_anchorY * static_cast<f32>(texture.getHeight());
+  transform.anchorX = m_anchorX * view.width();
+  transform.anchorY = m_anchorY * view.height();
 
   renderer::Color tint = m_tint;
   tint.a = static_cast<u8>(tint.a * m_alpha);
-  renderer.drawSprite(texture, transform, tint);
+  renderer.drawSprite(*view.texture, view.sourceRect, transform, tint);
 }
 
 SceneObjectState BackgroundObject::saveState() const {
@@ -77,6 +77,7 @@ void SceneObjectBase::setRotation(f32 angle) {
 void SceneObjectBase::setAnchor(f32 anchorX, f32 anchorY) {
   m_anchorX = anchorX;
   m_anchorY = anchorY;
+  markDirty();
 }
 
 void SceneObjectBase::setVisible(bool visible) {
@@ -168,7 +169,10 @@ SceneObjectBase::getProperty(const std::string &name) const {
 }
 
 void SceneObjectBase::update(f64 deltaTime) {
-  // Update animations
+  // Update animations; the step that finishes one still needs drawing
+  if (!m_animations.empty()) {
+    markDirty();
+  }
   for (auto it = m_animations.begin(); it != m_animations.end();) {
     if (*it && !(*it)->update(deltaTime)) {
       it = m_animations.erase(it);
@@ -209,6 +213,7 @@ void SceneObjectBase::loadState(const SceneObjectState &state) {
   m_visible = state.visible;
   m_zOrder = state.zOrder;
   m_properties = state.properties;
+  markDirty();
 }
 
 void SceneObjectBase::animatePosition(f32 toX, f32 toY, f32 duration,
@@ -242,6 +247,7 @@ void SceneObjectBase::animateScale(f32 toScaleX, f32 toScaleY, f32 duration,
 void SceneObjectBase::notifyPropertyChanged(const std::string &property,
                                             const std::string &oldValue,
                                             const std::string &newValue) {
+  markDirty();
   if (m_observer) {
     PropertyChange change;
     change.objectId = m_id;
@@ -20,10 +20,12 @@ CharacterObject::CharacterObject(const std::string &id,
 
 void CharacterObject::setCharacterId(const std::string &characterId) {
   m_characterId = characterId;
+  markDirty();
 }
 
 void CharacterObject::setDisplayName(const std::string &name) {
   m_displayName = name;
+  markDirty();
 }
 
 void CharacterObject::setExpression(const std::string &expression) {
@@ -38,14 +40,19 @@ void CharacterObject::setPose(const std::string &pose) {
   notifyPropertyChanged("pose", oldValue, pose);
 }
 
-void CharacterObject::setSlotPosition(Position pos) { m_slotPosition = pos; }
+void CharacterObject::setSlotPosition(Position pos) {
+  m_slotPosition = pos;
+  markDirty();
+}
 
 void CharacterObject::setNameColor(const renderer::Color &color) {
   m_nameColor = color;
+  markDirty();
 }
 
 void CharacterObject::setHighlighted(bool highlighted) {
   m_highlighted = highlighted;
+  markDirty();
 }
 
 void CharacterObject::render(renderer::IRenderer &renderer) {
@@ -63,39 +70,52 @@ void CharacterObject::render(renderer::IRenderer &renderer) {
     return;
   }
 
-  auto texResult = m_resources->loadTexture(textureId);
-  if (texResult.isError()) {
+  const auto *shown =
+      detail::resolveTexture(*m_resources, textureId, m_shownTexture);
+  if (!shown) {
     return;
   }
+  const auto &view = *shown;
+  m_shownTextureId = textureId;
+  const renderer::Transform2D transform = spriteTransform(view);
 
-  const auto &texture = *texResult.value();
-  if (!texture.isValid()) {
-    return;
+  renderer::Color tint = renderer::Color::White;
+  tint.a = static_cast<u8>(255 * m_alpha);
+  if (!m_highlighted) {
+    tint.r = static_cast<u8>(tint.r * 0.75f);
+    tint.g = static_cast<u8>(tint.g * 0.75f);
+    tint.b = static_cast<u8>(tint.b * 0.75f);
+  }
+
+  renderer.drawSprite(*view.texture, view.sourceRect, transform, tint);
+}
+
+std::optional<renderer::Rect> CharacterObject::getBounds() const {
+  // The size of a texture is only known once it has been drawn
+  if (!m_shownTexture.isValid() ||
+      m_shownTextureId !=
+          detail::getTextProperty(*this, "textureId", m_characterId)) {
+    return std::nullopt;
   }
+  return detail::spriteBounds(spriteTransform(m_shownTexture),
+                              m_shownTexture.width(),
+                              m_shownTexture.height());
+}
 
+renderer::Transform2D
+CharacterObject::spriteTransform(const resource::TextureView &view) const {
   renderer::Transform2D transform = m_transform;
   const float desiredW = detail::parseFloat(getProperty("width"), -1.0f);
   const float desiredH = detail::parseFloat(getProperty("height"), -1.0f);
   if (desiredW > 0.0f) {
-    transform.scaleX = desiredW / static_cast<float>(texture.getWidth());
+    transform.scaleX = desiredW / view.width();
   }
   if (desiredH > 0.0f) {
-    transform.scaleY = desiredH / static_cast<float>(texture.getHeight());
+    transform.scaleY = desiredH / view.height();
   }
-  transform.anchorX =
-      m_anchorX * static_cast<f32>(texture.getWidth());
-  transform.anchorY =
-      m_anchorY * static_cast<f32>(texture.getHeight());
-
-  renderer::Color tint = renderer::Color::White;
-  tint.a = static_cast<u8>(255 * m_alpha);
-  if (!m_highlighted) {
-    tint.r = static_cast<u8>(tint.r * 0.75f);
-    tint.g = static_cast<u8>(tint.g * 0.75f);
-    tint.b = static_cast<u8>(tint.b * 0.75f);
-  }
-
-  renderer.drawSprite(texture, transform, tint);
+  transform.anchorX = m_anchorX * view.width();
+  transform.anchorY = m_anchorY * view.height();
+  return transform;
 }
 
 SceneObjectState CharacterObject::saveState() const {
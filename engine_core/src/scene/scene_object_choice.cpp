@@ -19,21 +19,27 @@ namespace NovelMind::scene {
 // ============================================================================
 
 ChoiceUIObject::ChoiceUIObject(const std::string &id)
-    : SceneObjectBase(id, SceneObjectType::ChoiceUI) {}
+    : SceneObjectBase(id, SceneObjectType::ChoiceUI),
+      m_textLayout(std::make_unique<renderer::TextLayoutEngine>()) {}
+
+ChoiceUIObject::~ChoiceUIObject() = default;
 
 void ChoiceUIObject::setChoices(const std::vector<ChoiceOption> &choices) {
   m_choices = choices;
   m_selectedIndex = 0;
+  markDirty();
 }
 
 void ChoiceUIObject::clearChoices() {
   m_choices.clear();
   m_selectedIndex = 0;
+  markDirty();
 }
 
 void ChoiceUIObject::setSelectedIndex(i32 index) {
   if (index >= 0 && index < static_cast<i32>(m_choices.size())) {
     m_selectedIndex = index;
+    markDirty();
   }
 }
 
@@ -48,6 +54,7 @@ void ChoiceUIObject::selectNext() {
         (m_selectedIndex + 1) % static_cast<i32>(m_choices.size());
   } while (!m_choices[static_cast<size_t>(m_selectedIndex)].enabled &&
            m_selectedIndex != start);
+  markDirty();
 }
 
 void ChoiceUIObject::selectPrevious() {
@@ -62,6 +69,7 @@ void ChoiceUIObject::selectPrevious() {
         static_cast<i32>(m_choices.size());
   } while (!m_choices[static_cast<size_t>(m_selectedIndex)].enabled &&
            m_selectedIndex != start);
+  markDirty();
 }
 
 bool ChoiceUIObject::confirm() {
@@ -121,6 +129,13 @@ void ChoiceUIObject::render(renderer::IRenderer &renderer) {
     return;
   }
 
+  if (rtl) {
+    m_textLayout->setFont(fontResult.value());
+    renderer::TextStyle style;
+    style.size = static_cast<f32>(fontSize);
+    m_textLayout->setDefaultStyle(style);
+  }
+
   float y = rect.y + padding;
   for (size_t i = 0; i < m_choices.size(); ++i) {
     const auto &choice = m_choices[i];
@@ -135,12 +150,7 @@ void ChoiceUIObject::render(renderer::IRenderer &renderer) {
     }
     f32 x = rect.x + padding;
     if (rtl) {
-      renderer::TextLayoutEngine layout;
-      layout.setFont(fontResult.value());
-      renderer::TextStyle style;
-      style.size = static_cast<f32>(fontSize);
-      layout.setDefaultStyle(style);
-      f32 textWidth = layout.measureText(choice.text).first;
+      f32 textWidth = m_textLayout->measureText(choice.text).first;
       x = rect.x + rect.width - padding - textWidth;
     }
     renderer.drawText(*fontResult.value(), choice.text, x, y, color);
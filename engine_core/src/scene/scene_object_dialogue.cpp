@@ -9,6 +9,7 @@
 
 #include "NovelMind/localization/localization_manager.hpp"
 #include "NovelMind/renderer/text_layout.hpp"
+#include "NovelMind/renderer/utf8.hpp"
 
 #include "scene_graph_detail.hpp"
 
@@ -18,29 +19,50 @@ namespace NovelMind::scene {
 // DialogueUIObject Implementation
 // ============================================================================
 
+namespace {
+
+f32 countCodepoints(const std::string &text) {
+  usize count = 0;
+  for (usize offset = 0; offset < text.size(); ++count) {
+    renderer::decodeUtf8(text, offset);
+  }
+  return static_cast<f32>(count);
+}
+
+} // namespace
+
 DialogueUIObject::DialogueUIObject(const std::string &id)
-    : SceneObjectBase(id, SceneObjectType::DialogueUI) {}
+    : SceneObjectBase(id, SceneObjectType::DialogueUI),
+      m_textLayout(std::make_unique<renderer::TextLayoutEngine>()) {}
+
+DialogueUIObject::~DialogueUIObject() = default;
 
 void DialogueUIObject::setSpeaker(const std::string &speaker) {
   m_speaker = speaker;
+  markDirty();
 }
 
 void DialogueUIObject::setText(const std::string &text) {
   m_text = text;
+  m_typewriterLength = countCodepoints(m_text);
   m_typewriterProgress = 0.0f;
   m_typewriterComplete = !m_typewriterEnabled;
+  markDirty();
 }
 
 void DialogueUIObject::setSpeakerColor(const renderer::Color &color) {
   m_speakerColor = color;
+  markDirty();
 }
 
 void DialogueUIObject::setBackgroundTextureId(const std::string &textureId) {
   m_backgroundTextureId = textureId;
+  markDirty();
 }
 
 void DialogueUIObject::setTypewriterEnabled(bool enabled) {
   m_typewriterEnabled = enabled;
+  markDirty();
 }
 
 void DialogueUIObject::setTypewriterSpeed(f32 charsPerSecond) {
@@ -50,20 +72,23 @@ void DialogueUIObject::setTypewriterSpeed(f32 charsPerSecond) {
 void DialogueUIObject::startTypewriter() {
   m_typewriterProgress = 0.0f;
   m_typewriterComplete = false;
+  markDirty();
 }
 
 void DialogueUIObject::skipTypewriter() {
-  m_typewriterProgress = static_cast<f32>(m_text.length());
+  m_typewriterProgress = m_typewriterLength;
   m_typewriterComplete = true;
+  markDirty();
 }
 
 void DialogueUIObject::update(f64 deltaTime) {
   SceneObjectBase::update(deltaTime);
 
   if (m_typewriterEnabled && !m_typewriterComplete) {
+    markDirty();
     m_typewriterProgress += static_cast<f32>(deltaTime) * m_typewriterSpeed;
-    if (m_typewriterProgress >= static_cast<f32>(m_text.length())) {
-      m_typewriterProgress = static_cast<f32>(m_text.length());
+    if (m_typewriterProgress >= m_typewriterLength) {
+      m_typewriterProgress = m_typewriterLength;
       m_typewriterComplete = true;
     }
   }
@@ -84,32 +109,25 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
   renderer::TextAlign align =
       rtl ? renderer::TextAlign::Right : renderer::TextAlign::Left;
 
-  const float width =
-      detail::parseFloat(getProperty("width"), detail::kDefaultDialogueWidth);
-  const float height =
-      detail::parseFloat(getProperty("height"), detail::kDefaultDialogueHeight);
   const float padding =
       detail::parseFloat(getProperty("padding"), detail::kDefaultDialoguePadding);
-
-  renderer::Rect rect{m_transform.x - width * m_anchorX,
-                      m_transform.y - height * m_anchorY, width, height};
+  const renderer::Rect rect = boxRect();
 
   if (!m_backgroundTextureId.empty()) {
-    auto texResult = m_resources->loadTexture(m_backgroundTextureId);
-    if (texResult.isOk() && texResult.value()->isValid()) {
-      const auto &texture = *texResult.value();
+    const auto *shown = detail::resolveTexture(
+        *m_resources, m_backgroundTextureId, m_shownBackground);
+    if (shown) {
+      const auto &view = *shown;
       renderer::Transform2D transform{};
       transform.x = rect.x;
       transform.y = rect.y;
-      transform.scaleX =
-          rect.width / static_cast<f32>(texture.getWidth());
-      transform.scaleY =
-          rect.height / static_cast<f32>(texture.getHeight());
+      transform.scaleX = rect.width / view.width();
+      transform.scaleY = rect.height / view.height();
       transform.anchorX = 0.0f;
       transform.anchorY = 0.0f;
       renderer::Color tint = renderer::Color::White;
       tint.a = static_cast<u8>(tint.a * m_alpha);
-      renderer.drawSprite(texture, transform, tint);
+      renderer.drawSprite(*view.texture, view.sourceRect, transform, tint);
     }
   } else {
     renderer::Color bg = renderer::Color(30, 30, 30, 200);
@@ -130,7 +148,7 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
                                      "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_"
                                      "`abcdefghijklmnopqrstuvwxyz{|}~");
       if (atlasResult.isOk()) {
-        renderer::TextLayoutEngine layout;
+        auto &layout = *m_textLayout;
         layout.setFont(fontResult.value());
         layout.setFontAtlas(atlasResult.value());
         layout.setMaxWidth(rect.width - padding * 2.0f);
@@ -141,17 +159,40 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
         style.size = static_cast<f32>(fontSize);
         layout.setDefaultStyle(style);
 
-        std::string visible = m_text;
+        // The whole text is laid out (and cached) once, so revealed lines
+        // do not reflow as the typewriter advances
+        const auto textLayout = layout.layoutCached(m_text);
+        m_typewriterLength = static_cast<f32>(textLayout->totalCharacters);
+        u32 visible = static_cast<u32>(textLayout->totalCharacters);
         if (m_typewriterEnabled) {
-          size_t count =
-              static_cast<size_t>(std::min(m_typewriterProgress,
-                                           static_cast<f32>(m_text.size())));
-          visible = m_text.substr(0, count);
+          visible = static_cast<u32>(
+              std::min(m_typewriterProgress, m_typewriterLength));
         }
 
-        renderer::TextLayout textLayout = layout.layout(visible);
+        // Draws the revealed part of a segment
+        const auto drawSegment = [&](const renderer::TextSegment &segment,
+                                     f32 x, f32 y) {
+          if (segment.firstGlyph >= visible) {
+            return;
+          }
+          const u32 shown = visible - segment.firstGlyph;
+          if (shown >= segment.glyphCount) {
+            renderer.drawText(*fontResult.value(), segment.text, x, y,
+                              segment.style.color);
+            return;
+          }
+          m_revealBuffer.assign(segment.text, 0,
+                                renderer::utf8PrefixLength(segment.text,
+                                                           shown));
+          renderer.drawText(*fontResult.value(), m_revealBuffer, x, y,
+                            segment.style.color);
+        };
+
         f32 y = rect.y + padding + static_cast<f32>(fontSize);
-        for (const auto &line : textLayout.lines) {
+        for (const auto &line : textLayout->lines) {
+          if (line.firstGlyph >= visible && line.glyphCount > 0) {
+            break;
+          }
           f32 x = rect.x + padding;
           if (align == renderer::TextAlign::Center) {
             x = rect.x + (rect.width - line.width) * 0.5f;
@@ -164,9 +205,8 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
               if (segment.isCommand()) {
                 continue;
               }
-              renderer.drawText(*fontResult.value(), segment.text, x, y,
-                                segment.style.color);
-              x += layout.measureText(segment.text).first;
+              drawSegment(segment, x, y);
+              x += segment.width;
             }
           } else {
             for (auto it = line.segments.rbegin(); it != line.segments.rend();
@@ -174,10 +214,8 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
               if (it->isCommand()) {
                 continue;
               }
-              const f32 segWidth = layout.measureText(it->text).first;
-              x -= segWidth;
-              renderer.drawText(*fontResult.value(), it->text, x, y,
-                                it->style.color);
+              x -= it->width;
+              drawSegment(*it, x, y);
             }
           }
           y += line.height;
@@ -197,8 +235,10 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
       if (fontResult.isOk()) {
         f32 speakerX = rect.x + padding;
         if (rtl) {
-          renderer::TextLayoutEngine speakerLayout;
+          auto &speakerLayout = *m_textLayout;
           speakerLayout.setFont(fontResult.value());
+          speakerLayout.setFontAtlas(nullptr);
+          speakerLayout.setMaxWidth(0.0f);
           renderer::TextStyle speakerStyle;
           speakerStyle.size = static_cast<f32>(speakerFontSize);
           speakerLayout.setDefaultStyle(speakerStyle);
@@ -213,6 +253,19 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
   }
 }
 
+std::optional<renderer::Rect> DialogueUIObject::getBounds() const {
+  return boxRect();
+}
+
+renderer::Rect DialogueUIObject::boxRect() const {
+  const float width =
+      detail::parseFloat(getProperty("width"), detail::kDefaultDialogueWidth);
+  const float height =
+      detail::parseFloat(getProperty("height"), detail::kDefaultDialogueHeight);
+  return renderer::Rect{m_transform.x - width * m_anchorX,
+                        m_transform.y - height * m_anchorY, width, height};
+}
+
 SceneObjectState DialogueUIObject::saveState() const {
   auto state = SceneObjectBase::saveState();
   state.properties["speaker"] = m_speaker;
@@ -232,8 +285,10 @@ void DialogueUIObject::loadState(const SceneObjectState &state) {
     m_speaker = it->second;
 
   it = state.properties.find("text");
-  if (it != state.properties.end())
+  if (it != state.properties.end()) {
     m_text = it->second;
+    m_typewriterLength = countCodepoints(m_text);
+  }
 
   it = state.properties.find("backgroundTextureId");
   if (it != state.properties.end())
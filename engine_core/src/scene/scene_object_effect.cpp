@@ -18,30 +18,38 @@ EffectOverlayObject::EffectOverlayObject(const std::string &id)
 
 void EffectOverlayObject::setEffectType(EffectType type) {
   m_effectType = type;
+  markDirty();
 }
 
 void EffectOverlayObject::setColor(const renderer::Color &color) {
   m_color = color;
+  markDirty();
 }
 
 void EffectOverlayObject::setIntensity(f32 intensity) {
   m_intensity = std::max(0.0f, std::min(1.0f, intensity));
+  markDirty();
 }
 
 void EffectOverlayObject::startEffect(f32 duration) {
   m_effectActive = true;
   m_effectTimer = 0.0f;
   m_effectDuration = duration;
+  markDirty();
 }
 
 void EffectOverlayObject::stopEffect() {
   m_effectActive = false;
   m_effectTimer = 0.0f;
+  markDirty();
 }
 
 void EffectOverlayObject::update(f64 deltaTime) {
   SceneObjectBase::update(deltaTime);
 
+  if (m_effectActive) {
+    markDirty();
+  }
   if (m_effectActive && m_effectDuration > 0.0f) {
     m_effectTimer += static_cast<f32>(deltaTime);
     if (m_effectTimer >= m_effectDuration) {
@@ -61,6 +61,10 @@ void FadeTransition::render(renderer::IRenderer &renderer) {
   renderer::Color fadeColorWithAlpha = m_fadeColor;
   fadeColorWithAlpha.a = static_cast<u8>(alpha * 255.0f);
 
+  // Fading out shows the outgoing scene under the fade
+  if (const auto *outgoing = snapshot(); outgoing && m_fadeOut) {
+    outgoing->draw(renderer, renderer::Transform2D{});
+  }
   renderer.setFade(alpha, fadeColorWithAlpha);
 }
 
@@ -153,6 +157,10 @@ void FadeThroughTransition::render(renderer::IRenderer &renderer) {
     alpha = 1.0f - t;
   }
 
+  // Until the midpoint the outgoing scene is the one fading out
+  if (const auto *outgoing = snapshot(); outgoing && progress < 0.5f) {
+    outgoing->draw(renderer, renderer::Transform2D{});
+  }
   renderer.setFade(alpha, m_fadeColor);
 }
 
@@ -255,9 +263,29 @@ void SlideTransition::update(f64 deltaTime) {
 }
 
 void SlideTransition::render(renderer::IRenderer &renderer) {
-  // Slide transitions don't directly render anything
-  // They provide offset values for the scene to use
-  (void)renderer;
+  // The incoming scene is positioned with getOffset(); the outgoing one
+  // can only be drawn from a snapshot, one screen ahead of it
+  const auto *outgoing = snapshot();
+  if (!m_running || !outgoing) {
+    return;
+  }
+
+  renderer::Transform2D transform{};
+  switch (m_direction) {
+  case Direction::Left:
+    transform.x = m_offset - m_screenSize;
+    break;
+  case Direction::Right:
+    transform.x = m_offset + m_screenSize;
+    break;
+  case Direction::Up:
+    transform.y = m_offset - m_screenSize;
+    break;
+  case Direction::Down:
+    transform.y = m_offset + m_screenSize;
+    break;
+  }
+  outgoing->draw(renderer, transform);
 }
 
 bool SlideTransition::isComplete() const { return m_complete; }
@@ -329,10 +357,16 @@ void DissolveTransition::update(f64 deltaTime) {
 }
 
 void DissolveTransition::render(renderer::IRenderer &renderer) {
-  // Dissolve uses alpha blending controlled by getDissolveAlpha()
-  // The actual dissolve pattern would need shader support
-  // For now, we can approximate with a simple crossfade
-  (void)renderer;
+  // A per-pixel dissolve pattern would need shader support; crossfade
+  // the outgoing snapshot over the incoming scene instead
+  const auto *outgoing = snapshot();
+  if (!m_running || !outgoing) {
+    return;
+  }
+
+  renderer::Color tint = renderer::Color::White;
+  tint.a = static_cast<u8>((1.0f - getDissolveAlpha()) * 255.0f + 0.5f);
+  outgoing->draw(renderer, renderer::Transform2D{}, tint);
 }
 
 bool DissolveTransition::isComplete() const { return m_complete; }
@@ -425,6 +459,11 @@ void WipeTransition::render(renderer::IRenderer &renderer) {
     break;
   }
 
+  // The part not yet wiped still shows the outgoing scene
+  if (const auto *outgoing = snapshot()) {
+    outgoing->drawRegion(renderer, rect);
+    return;
+  }
   renderer.fillRect(rect, color);
 }
 
@@ -496,11 +535,21 @@ void ZoomTransition::render(renderer::IRenderer &renderer) {
   const f32 insetX = width * (0.45f * t);
   const f32 insetY = height * (0.45f * t);
 
-  renderer::Color color = m_maskColor;
-  renderer.fillRect(renderer::Rect{0.0f, 0.0f, width, insetY}, color);
-  renderer.fillRect(renderer::Rect{0.0f, height - insetY, width, insetY}, color);
-  renderer.fillRect(renderer::Rect{0.0f, insetY, insetX, height - insetY * 2.0f}, color);
-  renderer.fillRect(renderer::Rect{width - insetX, insetY, insetX, height - insetY * 2.0f}, color);
+  const renderer::Rect border[] = {
+      {0.0f, 0.0f, width, insetY},
+      {0.0f, height - insetY, width, insetY},
+      {0.0f, insetY, insetX, height - insetY * 2.0f},
+      {width - insetX, insetY, insetX, height - insetY * 2.0f}};
+
+  // Outside the opening the outgoing scene is still visible
+  const auto *outgoing = snapshot();
+  for (const auto &rect : border) {
+    if (outgoing) {
+      outgoing->drawRegion(renderer, rect);
+    } else {
+      renderer.fillRect(rect, m_maskColor);
+    }
+  }
 }
 
 bool ZoomTransition::isComplete() const { return m_complete; }
@@ -23,6 +23,7 @@ Result<void> ScriptRuntime::load(const CompiledScript &script) {
   m_currentSpeaker.clear();
   m_currentDialogue.clear();
   m_currentChoices.clear();
+  m_outgoingFrame.reset();
 
   return Result<void>::ok();
 }
@@ -230,6 +231,10 @@ bool ScriptRuntime::isComplete() const {
   return m_state == RuntimeState::Halted;
 }
 
+bool ScriptRuntime::isTransitionActive() const {
+  return m_activeTransition && !m_activeTransition->isComplete();
+}
+
 const std::string &ScriptRuntime::getCurrentScene() const {
   return m_currentScene;
 }
@@ -342,6 +347,17 @@ void ScriptRuntime::setEventCallback(EventCallback callback) {
   m_eventCallback = std::move(callback);
 }
 
+void ScriptRuntime::setFrameCapture(FrameCaptureCallback capture) {
+  m_frameCapture = std::move(capture);
+  m_outgoingFrame.reset();
+}
+
+void ScriptRuntime::renderTransition(renderer::IRenderer &renderer) {
+  if (m_activeTransition) {
+    m_activeTransition->render(renderer);
+  }
+}
+
 VirtualMachine &ScriptRuntime::getVM() { return m_vm; }
 
 // VM callback handlers
@@ -353,6 +369,7 @@ void ScriptRuntime::onShowBackground(const std::vector<Value> &args) {
 
   std::string bgName = asString(args[0]);
   m_currentBackground = bgName;
+  holdOutgoingFrame();
 
   // The scene manager would load and display the background
   if (m_sceneManager) {
@@ -383,6 +400,8 @@ void ScriptRuntime::onShowCharacter(const std::vector<Value> &args) {
     return;
   }
 
+  holdOutgoingFrame();
+
   // Create or get character sprite
   if (m_sceneManager) {
     // m_sceneManager->showCharacter(charId, position);
@@ -400,6 +419,7 @@ void ScriptRuntime::onHideCharacter(const std::vector<Value> &args) {
   m_visibleCharacters.erase(std::remove(m_visibleCharacters.begin(),
                                         m_visibleCharacters.end(), charId),
                             m_visibleCharacters.end());
+  holdOutgoingFrame();
 
   if (m_sceneManager) {
     // m_sceneManager->hideCharacter(charId);
@@ -445,6 +465,7 @@ void ScriptRuntime::onSay(const std::vector<Value> &args) {
     m_dialogueActive = true;
   }
 
+  m_outgoingFrame.reset();
   m_state = RuntimeState::WaitingInput;
   fireEvent(ScriptEventType::DialogueStart, speaker, Value{text});
 }
@@ -470,6 +491,7 @@ void ScriptRuntime::onChoice(const std::vector<Value> &args) {
     m_choiceMenu->setVisible(true);
   }
 
+  m_outgoingFrame.reset();
   m_state = RuntimeState::WaitingChoice;
   fireEvent(ScriptEventType::ChoiceStart);
 }
@@ -510,6 +532,7 @@ void ScriptRuntime::onWait(const std::vector<Value> &args) {
   std::memcpy(&duration, &durBits, sizeof(f32));
 
   m_waitTimer = duration;
+  m_outgoingFrame.reset();
   m_state = RuntimeState::WaitingTimer;
 }
 
@@ -568,6 +591,9 @@ void ScriptRuntime::onTransition(const std::vector<Value> &args) {
 
   m_activeTransition = createTransition(type, duration);
   if (m_activeTransition) {
+    holdOutgoingFrame();
+    m_activeTransition->setSnapshot(std::move(m_outgoingFrame));
+    m_outgoingFrame.reset();
     m_activeTransition->start(duration);
     m_state = RuntimeState::WaitingTransition;
     fireEvent(ScriptEventType::TransitionStart, type);
@@ -621,6 +647,14 @@ void ScriptRuntime::fireEvent(ScriptEventType type, const std::string &name,
   }
 }
 
+void ScriptRuntime::holdOutgoingFrame() {
+  // Scene changes are applied by event handlers and shown in the next
+  // frame, so the frame on screen now is still the old scene
+  if (m_frameCapture && !m_outgoingFrame) {
+    m_outgoingFrame = m_frameCapture();
+  }
+}
+
 void ScriptRuntime::updateWaitTimer(f64 deltaTime) {
   m_waitTimer -= static_cast<f32>(deltaTime);
   if (m_waitTimer <= 0.0f) {
@@ -0,0 +1,243 @@
+#include "NovelMind/vfs/access_trace.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace NovelMind::VFS {
+
+namespace {
+
+constexpr std::string_view kHeader = "NMTRACE 1";
+
+bool representable(std::string_view id) {
+  return id.find_first_of("\t\r\n") == std::string_view::npos;
+}
+
+// Splits off the next tab-separated field; the last field takes the rest
+std::string_view nextField(std::string_view &line, bool last) {
+  if (last) {
+    std::string_view field = line;
+    line = {};
+    return field;
+  }
+  const usize tab = line.find('\t');
+  std::string_view field = line.substr(0, tab);
+  line = tab == std::string_view::npos ? std::string_view{}
+                                       : line.substr(tab + 1);
+  return field;
+}
+
+bool parseU64(std::string_view text, u64 &value) {
+  const char *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  return ec == std::errc{} && ptr == end && !text.empty();
+}
+
+} // namespace
+
+Result<AccessTrace> AccessTrace::parse(std::string_view text) {
+  std::vector<AccessTraceEvent> events;
+  usize lineNumber = 0;
+  bool sawHeader = false;
+
+  while (!text.empty()) {
+    const usize newline = text.find('\n');
+    std::string_view line = text.substr(0, newline);
+    text = newline == std::string_view::npos ? std::string_view{}
+                                             : text.substr(newline + 1);
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (line.empty()) {
+      continue;
+    }
+    if (!sawHeader) {
+      if (line != kHeader) {
+        return Result<AccessTrace>::error("Not an access trace");
+      }
+      sawHeader = true;
+      continue;
+    }
+
+    const auto malformed = [lineNumber]() {
+      return Result<AccessTrace>::error("Malformed access trace line " +
+                                        std::to_string(lineNumber));
+    };
+
+    AccessTraceEvent event;
+    const std::string_view kind = nextField(line, false);
+    if (kind == "R") {
+      event.kind = AccessTraceEvent::Kind::Read;
+    } else if (kind == "S") {
+      event.kind = AccessTraceEvent::Kind::Scene;
+    } else {
+      return malformed();
+    }
+    if (!parseU64(nextField(line, false), event.timeUs)) {
+      return malformed();
+    }
+    if (event.kind == AccessTraceEvent::Kind::Read &&
+        !parseU64(nextField(line, false), event.bytes)) {
+      return malformed();
+    }
+    event.id = std::string(nextField(line, true));
+    if (event.kind == AccessTraceEvent::Kind::Read && event.id.empty()) {
+      return malformed();
+    }
+    events.push_back(std::move(event));
+  }
+
+  if (!sawHeader) {
+    return Result<AccessTrace>::error("Not an access trace");
+  }
+  return Result<AccessTrace>::ok(AccessTrace(std::move(events)));
+}
+
+Result<AccessTrace> AccessTrace::load(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return Result<AccessTrace>::error("Failed to open access trace: " + path);
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  if (file.bad()) {
+    return Result<AccessTrace>::error("Failed to read access trace: " + path);
+  }
+  auto result = parse(content.str());
+  if (result.isError()) {
+    return Result<AccessTrace>::error(result.error() + ": " + path);
+  }
+  return result;
+}
+
+std::string AccessTrace::serialize() const {
+  std::string out(kHeader);
+  out += '\n';
+  for (const auto &event : m_events) {
+    if (event.kind == AccessTraceEvent::Kind::Read) {
+      out += "R\t" + std::to_string(event.timeUs) + '\t' +
+             std::to_string(event.bytes) + '\t';
+    } else {
+      out += "S\t" + std::to_string(event.timeUs) + '\t';
+    }
+    out += event.id;
+    out += '\n';
+  }
+  return out;
+}
+
+Result<void> AccessTrace::save(const std::string &path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result<void>::error("Failed to open file for writing: " + path);
+  }
+  const std::string text = serialize();
+  file.write(text.data(), static_cast<std::streamsize>(text.size()));
+  if (!file) {
+    return Result<void>::error("Failed to write access trace: " + path);
+  }
+  return {};
+}
+
+std::vector<std::string>
+AccessTrace::layoutOrder(std::span<const AccessTrace> traces) {
+  struct Placement {
+    usize sceneRank;
+    usize firstSeen;
+  };
+  std::unordered_map<std::string, usize> sceneRanks;
+  std::unordered_map<std::string, Placement> placements;
+  std::vector<std::string> order;
+
+  for (const auto &trace : traces) {
+    // Reads before the first marker belong to start-up ("" scene)
+    usize scene = sceneRanks.try_emplace("", sceneRanks.size()).first->second;
+    for (const auto &event : trace.events()) {
+      if (event.kind == AccessTraceEvent::Kind::Scene) {
+        scene = sceneRanks.try_emplace(event.id, sceneRanks.size())
+                    .first->second;
+        continue;
+      }
+      if (placements.try_emplace(event.id, Placement{scene, order.size()})
+              .second) {
+        order.push_back(event.id);
+      }
+    }
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&](const std::string &a, const std::string &b) {
+                     const Placement &pa = placements.at(a);
+                     const Placement &pb = placements.at(b);
+                     if (pa.sceneRank != pb.sceneRank) {
+                       return pa.sceneRank < pb.sceneRank;
+                     }
+                     return pa.firstSeen < pb.firstSeen;
+                   });
+  return order;
+}
+
+void AccessTraceRecorder::start() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_recording) {
+    m_recording = true;
+    if (m_events.empty()) {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+void AccessTraceRecorder::stop() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_recording = false;
+}
+
+bool AccessTraceRecorder::isRecording() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_recording;
+}
+
+void AccessTraceRecorder::recordRead(std::string_view resourceId, u64 bytes) {
+  record(AccessTraceEvent::Kind::Read, resourceId, bytes);
+}
+
+void AccessTraceRecorder::markScene(std::string_view sceneId) {
+  record(AccessTraceEvent::Kind::Scene, sceneId, 0);
+}
+
+void AccessTraceRecorder::record(AccessTraceEvent::Kind kind,
+                                 std::string_view id, u64 bytes) {
+  if (!representable(id)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_recording) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  AccessTraceEvent event;
+  event.kind = kind;
+  event.timeUs = static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - m_start)
+          .count());
+  event.bytes = bytes;
+  event.id = std::string(id);
+  m_events.push_back(std::move(event));
+}
+
+AccessTrace AccessTraceRecorder::snapshot() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return AccessTrace(m_events);
+}
+
+void AccessTraceRecorder::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.clear();
+  m_start = std::chrono::steady_clock::now();
+}
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,322 @@
+#include "NovelMind/vfs/async_reader.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace NovelMind::VFS {
+
+namespace detail {
+
+struct AsyncReadRequest {
+  enum class State : u8 { Queued, Running, Done, Cancelled };
+
+  ResourceId id;
+  std::mutex mutex;
+  std::condition_variable finished;
+  State state = State::Queued;
+  u8 priority = 0;
+  // Subscribers that have not cancelled
+  u32 interest = 0;
+  std::optional<Result<SharedBuffer>> result;
+  // Cleared once the request finishes, which breaks the ownership cycle
+  std::vector<std::shared_ptr<AsyncReadSubscriber>> subscribers;
+};
+
+struct AsyncReadSubscriber {
+  std::shared_ptr<AsyncReadRequest> request;
+  AsyncReadCallback callback;
+  std::atomic<bool> cancelled{false};
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::AsyncReadRequest;
+using detail::AsyncReadSubscriber;
+using State = AsyncReadRequest::State;
+
+void attach(const std::shared_ptr<AsyncReadRequest> &request,
+            const std::shared_ptr<AsyncReadSubscriber> &subscriber) {
+  subscriber->request = request;
+  request->subscribers.push_back(subscriber);
+  ++request->interest;
+}
+
+} // namespace
+
+// ============================================================================
+// AsyncReadHandle
+// ============================================================================
+
+AsyncReadHandle::AsyncReadHandle(
+    std::shared_ptr<detail::AsyncReadSubscriber> subscriber)
+    : m_subscriber(std::move(subscriber)) {}
+
+const ResourceId &AsyncReadHandle::id() const {
+  static const ResourceId empty;
+  return m_subscriber ? m_subscriber->request->id : empty;
+}
+
+bool AsyncReadHandle::isReady() const {
+  if (!m_subscriber || m_subscriber->cancelled) {
+    return true;
+  }
+  auto &request = *m_subscriber->request;
+  std::lock_guard<std::mutex> lock(request.mutex);
+  return request.state == State::Done || request.state == State::Cancelled;
+}
+
+bool AsyncReadHandle::isCancelled() const {
+  return m_subscriber && m_subscriber->cancelled;
+}
+
+void AsyncReadHandle::wait() const {
+  if (!m_subscriber) {
+    return;
+  }
+  auto &request = *m_subscriber->request;
+  std::unique_lock<std::mutex> lock(request.mutex);
+  request.finished.wait(lock, [&]() {
+    return request.state == State::Done ||
+           request.state == State::Cancelled || m_subscriber->cancelled;
+  });
+}
+
+Result<SharedBuffer> AsyncReadHandle::result() const {
+  if (!m_subscriber) {
+    return Result<SharedBuffer>::error("Invalid read handle");
+  }
+
+  wait();
+  auto &request = *m_subscriber->request;
+  if (m_subscriber->cancelled) {
+    return Result<SharedBuffer>::error("Read cancelled: " + request.id.id());
+  }
+
+  std::lock_guard<std::mutex> lock(request.mutex);
+  if (request.state != State::Done || !request.result) {
+    return Result<SharedBuffer>::error("Read cancelled: " + request.id.id());
+  }
+  return *request.result;
+}
+
+void AsyncReadHandle::cancel() {
+  if (!m_subscriber || m_subscriber->cancelled.exchange(true)) {
+    return;
+  }
+
+  // The I/O thread that pops a request with no interest left drops it
+  auto &request = *m_subscriber->request;
+  {
+    std::lock_guard<std::mutex> lock(request.mutex);
+    if (request.interest > 0) {
+      --request.interest;
+    }
+  }
+  request.finished.notify_all();
+}
+
+// ============================================================================
+// AsyncReader
+// ============================================================================
+
+AsyncReader::AsyncReader(ReadFunction read, usize threadCount)
+    : m_read(std::move(read)) {
+  threadCount = std::max<usize>(threadCount, 1);
+  m_threads.reserve(threadCount);
+  for (usize i = 0; i < threadCount; ++i) {
+    m_threads.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+AsyncReader::~AsyncReader() {
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_stopping = true;
+  }
+  m_queueCondition.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+
+  // Release waiters on reads that never started
+  for (auto &[id, request] : m_inFlight) {
+    {
+      std::lock_guard<std::mutex> lock(request->mutex);
+      request->state = State::Cancelled;
+      request->subscribers.clear();
+    }
+    request->finished.notify_all();
+  }
+}
+
+AsyncReadHandle AsyncReader::submit(const ResourceId &id,
+                                    ReadPriority priority,
+                                    AsyncReadCallback callback) {
+  auto subscriber = std::make_shared<AsyncReadSubscriber>();
+  subscriber->callback = std::move(callback);
+  const auto level = static_cast<u8>(priority);
+  m_submitted.fetch_add(1, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+
+  auto &slot = m_inFlight[id];
+  if (slot) {
+    std::lock_guard<std::mutex> requestLock(slot->mutex);
+    if (slot->state == State::Queued || slot->state == State::Running) {
+      attach(slot, subscriber);
+      m_deduplicated.fetch_add(1, std::memory_order_relaxed);
+
+      // Queue a second entry at the higher priority; whichever entry a
+      // worker pops first starts the read and the other is skipped
+      if (slot->state == State::Queued && level > slot->priority) {
+        slot->priority = level;
+        m_queue.push({level, m_nextSequence++, slot});
+        m_queueCondition.notify_one();
+      }
+      return AsyncReadHandle(std::move(subscriber));
+    }
+  }
+
+  auto request = std::make_shared<AsyncReadRequest>();
+  request->id = id;
+  request->priority = level;
+  attach(request, subscriber);
+
+  if (m_stopping) {
+    request->state = State::Cancelled;
+    request->subscribers.clear();
+    m_inFlight.erase(id);
+    return AsyncReadHandle(std::move(subscriber));
+  }
+
+  slot = request;
+  m_queue.push({level, m_nextSequence++, std::move(request)});
+  m_queueCondition.notify_one();
+  return AsyncReadHandle(std::move(subscriber));
+}
+
+usize AsyncReader::dispatchCompletions(usize maxCount) {
+  std::deque<Completion> ready;
+  {
+    std::lock_guard<std::mutex> lock(m_completionMutex);
+    if (maxCount >= m_completions.size()) {
+      ready.swap(m_completions);
+    } else {
+      const auto end =
+          m_completions.begin() + static_cast<std::ptrdiff_t>(maxCount);
+      ready.assign(std::make_move_iterator(m_completions.begin()),
+                   std::make_move_iterator(end));
+      m_completions.erase(m_completions.begin(), end);
+    }
+  }
+
+  usize dispatched = 0;
+  for (auto &completion : ready) {
+    auto &subscriber = *completion.subscriber;
+    // Cancelling after the read finished still suppresses the callback
+    if (subscriber.cancelled) {
+      continue;
+    }
+    // The result was stored before the completion was queued
+    subscriber.callback(subscriber.request->id, *subscriber.request->result);
+    ++dispatched;
+  }
+  return dispatched;
+}
+
+AsyncReaderStats AsyncReader::stats() const {
+  AsyncReaderStats result;
+  result.submitted = m_submitted.load(std::memory_order_relaxed);
+  result.deduplicated = m_deduplicated.load(std::memory_order_relaxed);
+  result.completed = m_completed.load(std::memory_order_relaxed);
+  result.cancelled = m_cancelled.load(std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  result.inFlight = m_inFlight.size();
+  return result;
+}
+
+void AsyncReader::workerLoop() {
+  for (;;) {
+    std::shared_ptr<AsyncReadRequest> request;
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      m_queueCondition.wait(
+          lock, [this]() { return m_stopping || !m_queue.empty(); });
+      if (m_stopping) {
+        return;
+      }
+      request = m_queue.top().request;
+      m_queue.pop();
+    }
+
+    bool dropped = false;
+    {
+      std::lock_guard<std::mutex> lock(request->mutex);
+      if (request->state != State::Queued) {
+        // Stale entry left behind by a priority bump
+        continue;
+      }
+      if (request->interest == 0) {
+        request->state = State::Cancelled;
+        request->subscribers.clear();
+        dropped = true;
+      } else {
+        request->state = State::Running;
+      }
+    }
+
+    if (dropped) {
+      request->finished.notify_all();
+      std::lock_guard<std::mutex> lock(m_queueMutex);
+      const auto it = m_inFlight.find(request->id);
+      if (it != m_inFlight.end() && it->second == request) {
+        m_inFlight.erase(it);
+      }
+      m_cancelled.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    complete(request, m_read(request->id));
+  }
+}
+
+void AsyncReader::complete(const std::shared_ptr<AsyncReadRequest> &request,
+                           Result<SharedBuffer> result) {
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    const auto it = m_inFlight.find(request->id);
+    if (it != m_inFlight.end() && it->second == request) {
+      m_inFlight.erase(it);
+    }
+  }
+
+  std::vector<std::shared_ptr<AsyncReadSubscriber>> subscribers;
+  {
+    std::lock_guard<std::mutex> lock(request->mutex);
+    request->result = std::move(result);
+    subscribers.swap(request->subscribers);
+  }
+
+  // Queue callbacks before waking waiters, so a caller that waited can
+  // dispatch them right away
+  {
+    std::lock_guard<std::mutex> lock(m_completionMutex);
+    for (auto &subscriber : subscribers) {
+      if (subscriber->callback && !subscriber->cancelled) {
+        m_completions.push_back({std::move(subscriber)});
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(request->mutex);
+    request->state = State::Done;
+  }
+  request->finished.notify_all();
+  m_completed.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace NovelMind::VFS
@@ -1,12 +1,27 @@
 #include "NovelMind/vfs/cached_file_system.hpp"
 
+#include <limits>
+
 namespace NovelMind::vfs {
 
+namespace {
+// A limit of 0 has always meant "unbounded" for this decorator
+usize effectiveLimit(usize maxBytes) {
+  return maxBytes == 0 ? std::numeric_limits<usize>::max() : maxBytes;
+}
+} // namespace
+
 CachedFileSystem::CachedFileSystem(std::unique_ptr<IVirtualFileSystem> inner,
                                    usize maxBytes)
-    : m_maxBytes(maxBytes), m_inner(std::move(inner)) {}
+    : m_cache(effectiveLimit(maxBytes)), m_inner(std::move(inner)) {}
+
+CachedFileSystem::~CachedFileSystem() {
+  // Join the I/O threads while the inner file system is still alive
+  m_asyncReader.reset();
+}
 
 Result<void> CachedFileSystem::mount(const std::string &packPath) {
+  std::unique_lock<std::shared_mutex> lock(m_innerMutex);
   if (m_inner) {
     return m_inner->mount(packPath);
   }
@@ -14,6 +29,7 @@ Result<void> CachedFileSystem::mount(const std::string &packPath) {
 }
 
 void CachedFileSystem::unmount(const std::string &packPath) {
+  std::unique_lock<std::shared_mutex> lock(m_innerMutex);
   if (m_inner) {
     m_inner->unmount(packPath);
   }
@@ -21,6 +37,7 @@ void CachedFileSystem::unmount(const std::string &packPath) {
 }
 
 void CachedFileSystem::unmountAll() {
+  std::unique_lock<std::shared_mutex> lock(m_innerMutex);
   if (m_inner) {
     m_inner->unmountAll();
   }
@@ -29,35 +46,95 @@ void CachedFileSystem::unmountAll() {
 
 Result<std::vector<u8>>
 CachedFileSystem::readFile(const std::string &resourceId) const {
-  auto it = m_cache.find(resourceId);
-  if (it != m_cache.end()) {
-    touch(resourceId);
-    return Result<std::vector<u8>>::ok(it->second.first.data);
+  auto view = readFileView(resourceId);
+  if (view.isError()) {
+    return Result<std::vector<u8>>::error(view.error());
+  }
+  return Result<std::vector<u8>>::ok(view.value().toVector());
+}
+
+Result<VFS::ResourceView>
+CachedFileSystem::readFileView(const std::string &resourceId) const {
+  const VFS::ResourceId key(resourceId);
+  if (auto cached = m_cache.get(key)) {
+    recordRead(resourceId, cached->size());
+    return Result<VFS::ResourceView>::ok(
+        VFS::ResourceView::fromShared(std::move(cached)));
   }
 
   if (!m_inner) {
-    return Result<std::vector<u8>>::error("CachedFileSystem has no inner FS");
+    return Result<VFS::ResourceView>::error("CachedFileSystem has no inner FS");
   }
 
-  auto result = m_inner->readFile(resourceId);
+  auto result = m_inner->readFileView(resourceId);
   if (result.isError()) {
     return result;
   }
+  recordRead(resourceId, result.value().size());
+  if (result.value().isMapped()) {
+    return result;
+  }
 
-  CacheEntry entry;
-  entry.data = result.value();
-  entry.size = entry.data.size();
+  if (auto buffer = result.value().buffer()) {
+    m_cache.put(key, std::move(buffer));
+  }
+  return result;
+}
 
-  m_lru.push_front(resourceId);
-  m_cache[resourceId] = {entry, m_lru.begin()};
-  m_currentBytes += entry.size;
-  evictIfNeeded();
+Result<std::unique_ptr<VFS::IFileHandle>>
+CachedFileSystem::openStream(const std::string &resourceId) const {
+  // Streams are for resources too large to hold whole; bypass the cache
+  if (!m_inner) {
+    return Result<std::unique_ptr<VFS::IFileHandle>>::error(
+        "CachedFileSystem has no inner FS");
+  }
+  auto stream = m_inner->openStream(resourceId);
+  if (stream.isOk()) {
+    recordRead(resourceId, stream.value()->size());
+  }
+  return stream;
+}
 
-  return Result<std::vector<u8>>::ok(std::move(entry.data));
+Result<VFS::SharedBuffer>
+CachedFileSystem::readShared(const VFS::ResourceId &id) const {
+  std::shared_lock<std::shared_mutex> lock(m_innerMutex);
+  auto view = readFileView(id.id());
+  if (view.isError()) {
+    return Result<VFS::SharedBuffer>::error(view.error());
+  }
+  if (auto buffer = view.value().buffer()) {
+    return Result<VFS::SharedBuffer>::ok(std::move(buffer));
+  }
+  // Mapped views alias the pack; callers may outlive the mapping
+  return Result<VFS::SharedBuffer>::ok(
+      std::make_shared<const std::vector<u8>>(view.value().toVector()));
+}
+
+VFS::AsyncReadHandle
+CachedFileSystem::readAsync(const std::string &resourceId,
+                            VFS::ReadPriority priority,
+                            VFS::AsyncReadCallback callback) const {
+  std::lock_guard<std::mutex> lock(m_asyncMutex);
+  if (!m_asyncReader) {
+    m_asyncReader = std::make_unique<VFS::AsyncReader>(
+        [this](const VFS::ResourceId &id) { return readShared(id); });
+  }
+  return m_asyncReader->submit(VFS::ResourceId(resourceId), priority,
+                               std::move(callback));
+}
+
+usize CachedFileSystem::processCompletions(usize maxCount) {
+  // Callbacks run unlocked so they can issue further reads
+  VFS::AsyncReader *reader = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    reader = m_asyncReader.get();
+  }
+  return reader ? reader->dispatchCompletions(maxCount) : 0;
 }
 
 bool CachedFileSystem::exists(const std::string &resourceId) const {
-  if (m_cache.find(resourceId) != m_cache.end()) {
+  if (m_cache.contains(VFS::ResourceId(resourceId))) {
     return true;
   }
   return m_inner ? m_inner->exists(resourceId) : false;
@@ -79,41 +156,33 @@ CachedFileSystem::listResources(ResourceType type) const {
   return {};
 }
 
-void CachedFileSystem::setMaxBytes(usize maxBytes) {
-  m_maxBytes = maxBytes;
-  evictIfNeeded();
-}
-
-void CachedFileSystem::clearCache() {
-  m_cache.clear();
-  m_lru.clear();
-  m_currentBytes = 0;
+void CachedFileSystem::setTraceRecorder(
+    std::shared_ptr<VFS::AccessTraceRecorder> recorder) {
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  m_traceRecorder = std::move(recorder);
 }
 
-void CachedFileSystem::touch(const std::string &resourceId) const {
-  auto it = m_cache.find(resourceId);
-  if (it == m_cache.end()) {
-    return;
+void CachedFileSystem::recordRead(const std::string &resourceId,
+                                  usize bytes) const {
+  std::shared_ptr<VFS::AccessTraceRecorder> recorder;
+  {
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    recorder = m_traceRecorder;
   }
+  if (recorder) {
+    recorder->recordRead(resourceId, bytes);
+  }
+}
 
-  m_lru.erase(it->second.second);
-  m_lru.push_front(resourceId);
-  it->second.second = m_lru.begin();
+void CachedFileSystem::setMaxBytes(usize maxBytes) {
+  m_cache.setMaxSize(effectiveLimit(maxBytes));
 }
 
-void CachedFileSystem::evictIfNeeded() const {
-  if (m_maxBytes == 0) {
-    return;
-  }
-  while (m_currentBytes > m_maxBytes && !m_lru.empty()) {
-    const std::string &key = m_lru.back();
-    auto it = m_cache.find(key);
-    if (it != m_cache.end()) {
-      m_currentBytes -= it->second.first.size;
-      m_cache.erase(it);
-    }
-    m_lru.pop_back();
-  }
+void CachedFileSystem::setCachePolicy(VFS::ResourceType type,
+                                      const VFS::CacheTypePolicy &policy) {
+  m_cache.setTypePolicy(type, policy);
 }
 
+void CachedFileSystem::clearCache() { m_cache.clear(); }
+
 } // namespace NovelMind::vfs
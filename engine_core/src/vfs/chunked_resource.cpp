@@ -0,0 +1,320 @@
+#include "NovelMind/vfs/chunked_resource.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace NovelMind::VFS {
+
+namespace {
+// Same per-resource ceiling the pack readers enforce
+constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024;
+
+u64 tableSize(u32 frameCount) {
+  return sizeof(ChunkTableHeader) +
+         static_cast<u64>(frameCount) * (sizeof(u64) + sizeof(u32));
+}
+} // namespace
+
+Result<std::vector<u8>>
+ChunkedResource::encode(std::span<const u8> data, PackCompression codec,
+                        i32 level, u32 frameSize, const FrameSealer &seal) {
+  using ResultType = Result<std::vector<u8>>;
+
+  if (frameSize < kMinFrameSize || frameSize > kMaxFrameSize) {
+    return ResultType::error("Invalid chunk frame size");
+  }
+  if (data.size() > MAX_RESOURCE_SIZE) {
+    return ResultType::error("Resource size exceeds limit");
+  }
+
+  const auto frameCount =
+      static_cast<u32>((data.size() + frameSize - 1) / frameSize);
+  const u64 dataStart = tableSize(frameCount);
+
+  std::vector<u64> frameEnds(frameCount);
+  std::vector<u32> frameCrcs(frameCount);
+  std::vector<u8> out(static_cast<usize>(dataStart));
+
+  for (u32 i = 0; i < frameCount; ++i) {
+    const usize begin = static_cast<usize>(i) * frameSize;
+    const auto frame =
+        data.subspan(begin, std::min<usize>(frameSize, data.size() - begin));
+
+    auto encoded = PackCompressor::compress(codec, frame, level);
+    if (encoded.isError()) {
+      return ResultType::error(encoded.error());
+    }
+    std::vector<u8> bytes = std::move(encoded).value();
+    if (seal) {
+      auto sealed = seal(i, std::move(bytes));
+      if (sealed.isError()) {
+        return ResultType::error(sealed.error());
+      }
+      bytes = std::move(sealed).value();
+    }
+
+    out.insert(out.end(), bytes.begin(), bytes.end());
+    frameEnds[i] = out.size() - dataStart;
+    frameCrcs[i] = PackIntegrityChecker::calculateCrc32(frame.data(),
+                                                        frame.size());
+  }
+
+  ChunkTableHeader header{kMagic, frameSize, frameCount, 0};
+  u8 *cursor = out.data();
+  std::memcpy(cursor, &header, sizeof(header));
+  cursor += sizeof(header);
+  if (frameCount > 0) {
+    std::memcpy(cursor, frameEnds.data(), frameEnds.size() * sizeof(u64));
+    cursor += frameEnds.size() * sizeof(u64);
+    std::memcpy(cursor, frameCrcs.data(), frameCrcs.size() * sizeof(u32));
+  }
+
+  return ResultType::ok(std::move(out));
+}
+
+std::array<u8, 12> ChunkedResource::frameIv(const u8 *entryIv,
+                                            u32 frameIndex) {
+  std::array<u8, 12> iv{};
+  std::memcpy(iv.data(), entryIv, 8);
+  for (usize i = 0; i < 4; ++i) {
+    iv[8 + i] = static_cast<u8>((frameIndex >> (i * 8)) & 0xFF);
+  }
+  return iv;
+}
+
+std::vector<u8> ChunkedResource::frameAad(const std::vector<u8> &resourceAad,
+                                          u32 frameIndex) {
+  std::vector<u8> aad;
+  aad.reserve(resourceAad.size() + sizeof(u32));
+  aad.insert(aad.end(), resourceAad.begin(), resourceAad.end());
+  for (usize i = 0; i < 4; ++i) {
+    aad.push_back(static_cast<u8>((frameIndex >> (i * 8)) & 0xFF));
+  }
+  return aad;
+}
+
+ChunkedFileHandle::ChunkedFileHandle(ChunkedResourceSource source)
+    : m_source(std::move(source)) {}
+
+Result<std::unique_ptr<ChunkedFileHandle>>
+ChunkedFileHandle::open(ChunkedResourceSource source) {
+  using ResultType = Result<std::unique_ptr<ChunkedFileHandle>>;
+
+  if (!source.mapping && !source.file) {
+    return ResultType::error("Chunked resource has no backing pack");
+  }
+  if (source.uncompressedSize > MAX_RESOURCE_SIZE) {
+    return ResultType::error("Uncompressed size exceeds limit");
+  }
+
+  std::unique_ptr<ChunkedFileHandle> handle(
+      new ChunkedFileHandle(std::move(source)));
+  auto tableResult = handle->readTable();
+  if (tableResult.isError()) {
+    return ResultType::error(tableResult.error());
+  }
+  return ResultType::ok(std::move(handle));
+}
+
+Result<void> ChunkedFileHandle::readTable() {
+  auto headerBytes = storedBytes(0, sizeof(ChunkTableHeader));
+  if (headerBytes.isError()) {
+    return Result<void>::error(headerBytes.error());
+  }
+
+  ChunkTableHeader header{};
+  std::memcpy(&header, headerBytes.value().data(), sizeof(header));
+  if (header.magic != ChunkedResource::kMagic) {
+    return Result<void>::error("Invalid chunk table magic");
+  }
+  if (header.frameSize < ChunkedResource::kMinFrameSize ||
+      header.frameSize > ChunkedResource::kMaxFrameSize) {
+    return Result<void>::error("Invalid chunk frame size");
+  }
+  const u64 expectedFrames =
+      (m_source.uncompressedSize + header.frameSize - 1) / header.frameSize;
+  if (header.frameCount != expectedFrames) {
+    return Result<void>::error("Chunk frame count mismatch");
+  }
+
+  m_frameSize = header.frameSize;
+  m_dataStart = tableSize(header.frameCount);
+  if (m_dataStart > m_source.storedSize) {
+    return Result<void>::error("Chunk table extends beyond resource");
+  }
+
+  auto tableBytes = storedBytes(sizeof(ChunkTableHeader),
+                                m_dataStart - sizeof(ChunkTableHeader));
+  if (tableBytes.isError()) {
+    return Result<void>::error(tableBytes.error());
+  }
+
+  const u8 *cursor = tableBytes.value().data();
+  m_frameEnds.resize(header.frameCount);
+  m_frameCrcs.resize(header.frameCount);
+  if (header.frameCount > 0) {
+    std::memcpy(m_frameEnds.data(), cursor, m_frameEnds.size() * sizeof(u64));
+    cursor += m_frameEnds.size() * sizeof(u64);
+    std::memcpy(m_frameCrcs.data(), cursor, m_frameCrcs.size() * sizeof(u32));
+  }
+
+  u64 previous = 0;
+  for (u64 end : m_frameEnds) {
+    if (end < previous) {
+      return Result<void>::error("Chunk frame offsets are not ordered");
+    }
+    previous = end;
+  }
+  if (previous != m_source.storedSize - m_dataStart) {
+    return Result<void>::error("Chunk frames do not cover resource data");
+  }
+
+  return Result<void>::ok();
+}
+
+usize ChunkedFileHandle::size() const {
+  return static_cast<usize>(m_source.uncompressedSize);
+}
+
+bool ChunkedFileHandle::isEof() const { return m_position >= size(); }
+
+Result<std::span<const u8>> ChunkedFileHandle::storedBytes(u64 offset,
+                                                           u64 size) {
+  using ResultType = Result<std::span<const u8>>;
+
+  if (offset > m_source.storedSize || size > m_source.storedSize - offset) {
+    return ResultType::error("Chunk read extends beyond resource");
+  }
+
+  if (m_source.verifier) {
+    auto verified =
+        m_source.verifier->verifyRange(m_source.offset + offset, size);
+    if (verified.isError()) {
+      return ResultType::error(verified.error());
+    }
+  }
+
+  if (m_source.mapping) {
+    const auto bytes = m_source.mapping->bytes(m_source.offset + offset, size);
+    if (bytes.size() != size) {
+      return ResultType::error("Resource data extends beyond pack file");
+    }
+    return ResultType::ok(bytes);
+  }
+
+  m_scratch.resize(static_cast<usize>(size));
+  if (size > 0 && m_source.file
+                      ->readAt(m_source.offset + offset, m_scratch.data(),
+                               m_scratch.size())
+                      .isError()) {
+    return ResultType::error("Failed to read resource data");
+  }
+  return ResultType::ok(std::span<const u8>(m_scratch));
+}
+
+Result<void> ChunkedFileHandle::loadFrame(u32 index) {
+  if (m_hasFrame && m_loadedFrame == index) {
+    return Result<void>::ok();
+  }
+
+  const u64 begin = index == 0 ? 0 : m_frameEnds[index - 1];
+  const u64 end = m_frameEnds[index];
+  auto stored = storedBytes(m_dataStart + begin, end - begin);
+  if (stored.isError()) {
+    return Result<void>::error(stored.error());
+  }
+
+  const u64 frameStart = static_cast<u64>(index) * m_frameSize;
+  const u64 decodedSize =
+      std::min<u64>(m_frameSize, m_source.uncompressedSize - frameStart);
+
+  // Frames decrypt into the scratch buffer (in place when they were read
+  // there) and decode into the frame buffer; both keep their capacity
+  std::span<const u8> input = stored.value();
+  if (m_source.decryptor) {
+    const auto iv = ChunkedResource::frameIv(m_source.iv.data(), index);
+    const auto aad = ChunkedResource::frameAad(m_source.aad, index);
+    if (m_scratch.size() < input.size()) {
+      m_scratch.resize(input.size());
+    }
+    auto result = m_source.decryptor->decryptInto(
+        input.data(), input.size(), iv.data(), iv.size(), aad.data(),
+        aad.size(), m_scratch.data());
+    if (result.isError()) {
+      m_hasFrame = false;
+      return Result<void>::error(result.error());
+    }
+    input = std::span<const u8>(m_scratch).first(result.value());
+  }
+
+  m_frame.resize(static_cast<usize>(decodedSize));
+  auto decoded = PackCompressor::decompressInto(m_source.codec, input, m_frame);
+  if (decoded.isError()) {
+    m_hasFrame = false;
+    return Result<void>::error(decoded.error());
+  }
+  ++m_framesDecoded;
+
+  if (PackIntegrityChecker::calculateCrc32(m_frame.data(), m_frame.size()) !=
+      m_frameCrcs[index]) {
+    m_hasFrame = false;
+    return Result<void>::error("Chunk frame checksum mismatch");
+  }
+
+  m_loadedFrame = index;
+  m_hasFrame = true;
+  return Result<void>::ok();
+}
+
+Result<usize> ChunkedFileHandle::read(u8 *buffer, usize count) {
+  if (buffer == nullptr && count > 0) {
+    return Result<usize>::error("Null buffer");
+  }
+
+  usize total = 0;
+  while (total < count && m_position < size()) {
+    const auto index = static_cast<u32>(m_position / m_frameSize);
+    auto loadResult = loadFrame(index);
+    if (loadResult.isError()) {
+      return Result<usize>::error(loadResult.error());
+    }
+
+    const usize offsetInFrame =
+        m_position - static_cast<usize>(index) * m_frameSize;
+    const usize toCopy = std::min(count - total, m_frame.size() - offsetInFrame);
+    std::memcpy(buffer + total, m_frame.data() + offsetInFrame, toCopy);
+    total += toCopy;
+    m_position += toCopy;
+  }
+
+  return Result<usize>::ok(total);
+}
+
+Result<void> ChunkedFileHandle::seek(i64 offset, SeekOrigin origin) {
+  i64 newPosition = 0;
+
+  switch (origin) {
+  case SeekOrigin::Begin:
+    newPosition = offset;
+    break;
+  case SeekOrigin::Current:
+    newPosition = static_cast<i64>(m_position) + offset;
+    break;
+  case SeekOrigin::End:
+    newPosition = static_cast<i64>(size()) + offset;
+    break;
+  }
+
+  if (newPosition < 0) {
+    return Result<void>::error("Seek position before beginning of file");
+  }
+
+  if (static_cast<usize>(newPosition) > size()) {
+    return Result<void>::error("Seek position past end of file");
+  }
+
+  m_position = static_cast<usize>(newPosition);
+  return Result<void>::ok();
+}
+
+} // namespace NovelMind::VFS
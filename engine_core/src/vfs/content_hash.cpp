@@ -0,0 +1,305 @@
+#include "NovelMind/vfs/content_hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define NOVELMIND_CONTENT_HASH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define NOVELMIND_CONTENT_HASH_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace NovelMind::VFS {
+
+namespace {
+
+// Primes from xxHash
+constexpr u64 kPrime32_1 = 0x9E3779B1ULL;
+constexpr u64 kPrime32_2 = 0x85EBCA77ULL;
+constexpr u64 kPrime32_3 = 0xC2B2AE3DULL;
+constexpr u64 kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr u64 kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr u64 kPrime64_3 = 0x165667B19E3779F9ULL;
+constexpr u64 kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr u64 kPrime64_5 = 0x27D4EB2F165667C5ULL;
+
+// Inputs up to this size take the short paths and never touch the lanes
+constexpr usize kShortLimit = 128;
+// Stripes consumed with successive 8-byte secret offsets before scrambling
+constexpr usize kStripesPerBlock =
+    (ContentHasher::kSecretSize - ContentHasher::kStripeSize) / 8;
+
+constexpr std::array<u8, ContentHasher::kSecretSize> makeSecret() {
+  // splitmix64 output; any fixed high-entropy bytes would do
+  std::array<u8, ContentHasher::kSecretSize> secret{};
+  u64 state = 0x4E4D5245534F5552ULL;
+  for (usize i = 0; i < secret.size(); i += 8) {
+    state += 0x9E3779B97F4A7C15ULL;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    for (usize b = 0; b < 8; ++b) {
+      secret[i + b] = static_cast<u8>(z >> (b * 8));
+    }
+  }
+  return secret;
+}
+
+constexpr auto kDefaultSecret = makeSecret();
+
+u64 read64(const u8 *p) {
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+void write64(u8 *p, u64 value) { std::memcpy(p, &value, sizeof(value)); }
+
+// Low and high halves of the 128-bit product, xored together
+u64 mulFold64(u64 a, u64 b) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using u128 = unsigned __int128;
+  const u128 product = static_cast<u128>(a) * b;
+  return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+  u64 high = 0;
+  const u64 low = _umul128(a, b, &high);
+  return low ^ high;
+#else
+  const u64 aLow = a & 0xFFFFFFFFULL;
+  const u64 aHigh = a >> 32;
+  const u64 bLow = b & 0xFFFFFFFFULL;
+  const u64 bHigh = b >> 32;
+  const u64 ll = aLow * bLow;
+  const u64 lh = aLow * bHigh;
+  const u64 hl = aHigh * bLow;
+  const u64 hh = aHigh * bHigh;
+  const u64 cross = (ll >> 32) + (lh & 0xFFFFFFFFULL) + hl;
+  const u64 high = hh + (lh >> 32) + (cross >> 32);
+  const u64 low = (cross << 32) | (ll & 0xFFFFFFFFULL);
+  return low ^ high;
+#endif
+}
+
+u64 avalanche(u64 hash) {
+  hash ^= hash >> 37;
+  hash *= 0x165667919E3779F9ULL;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+u64 mix16(const u8 *input, const u8 *secret, u64 seed) {
+  return mulFold64(read64(input) ^ (read64(secret) + seed),
+                   read64(input + 8) ^ (read64(secret + 8) - seed));
+}
+
+ContentHash hashShort(const u8 *input, usize size, u64 seed) {
+  const u8 *secret = kDefaultSecret.data();
+  ContentHash result;
+
+  if (size == 0) {
+    result.low = avalanche(seed ^ read64(secret + 56) ^ read64(secret + 64));
+    result.high = avalanche(seed ^ read64(secret + 72) ^ read64(secret + 80));
+    return result;
+  }
+
+  if (size <= 16) {
+    u8 padded[16] = {};
+    std::memcpy(padded, input, size);
+    const u64 a = read64(padded);
+    const u64 b = read64(padded + 8);
+    result.low = avalanche(mulFold64(a ^ (read64(secret) + seed),
+                                     b ^ (read64(secret + 8) - seed)) +
+                           size * kPrime64_1);
+    result.high = avalanche(mulFold64(a ^ (read64(secret + 16) - seed),
+                                      b ^ (read64(secret + 24) + seed)) ^
+                            (size * kPrime64_2));
+    return result;
+  }
+
+  // 17..128 bytes: 16-byte pairs from both ends, overlapping in the middle
+  u64 low = size * kPrime64_1;
+  u64 high = size * kPrime64_4;
+  const usize pairs = (size - 1) / 32 + 1;
+  for (usize k = 0; k < pairs; ++k) {
+    const u8 *front = input + 16 * k;
+    const u8 *back = input + size - 16 - 16 * k;
+    low += mix16(front, secret + 32 * k, seed);
+    low += mix16(back, secret + 32 * k + 16, seed);
+    high += mix16(front, secret + 64 + 32 * k + 16, seed);
+    high += mix16(back, secret + 64 + 32 * k, seed);
+  }
+  result.low = avalanche(low);
+  result.high = avalanche(high);
+  return result;
+}
+
+} // namespace
+
+std::string ContentHash::toHex() const {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string result(32, '0');
+  for (usize i = 0; i < 16; ++i) {
+    result[15 - i] = kDigits[(high >> (i * 4)) & 0xF];
+    result[31 - i] = kDigits[(low >> (i * 4)) & 0xF];
+  }
+  return result;
+}
+
+ContentHasher::ContentHasher(u64 seed)
+    : m_lanes{kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+              kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1},
+      m_seed(seed) {
+  // Seeded hashers use their own secret, as in XXH3
+  for (usize i = 0; i < kSecretSize; i += 16) {
+    write64(m_secret.data() + i, read64(kDefaultSecret.data() + i) + seed);
+    write64(m_secret.data() + i + 8,
+            read64(kDefaultSecret.data() + i + 8) - seed);
+  }
+}
+
+void ContentHasher::accumulate(std::array<u64, 8> &lanes, const u8 *stripe,
+                               const u8 *secret) {
+#if defined(NOVELMIND_CONTENT_HASH_SSE2)
+  auto *acc = reinterpret_cast<__m128i *>(lanes.data());
+  for (usize i = 0; i < 4; ++i) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(stripe) + i);
+    const __m128i key = _mm_xor_si128(
+        data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+    // 32x32->64 product of each 64-bit key's halves
+    const __m128i product =
+        _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i lane = _mm_loadu_si128(acc + i);
+    lane = _mm_add_epi64(lane, _mm_add_epi64(product, swapped));
+    _mm_storeu_si128(acc + i, lane);
+  }
+#elif defined(NOVELMIND_CONTENT_HASH_NEON)
+  for (usize i = 0; i < 4; ++i) {
+    const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+    const uint64x2_t key =
+        veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+    const uint32x2_t keyLow = vmovn_u64(key);
+    const uint32x2_t keyHigh = vshrn_n_u64(key, 32);
+    const uint64x2_t swapped = vextq_u64(data, data, 1);
+    uint64x2_t lane = vld1q_u64(lanes.data() + 2 * i);
+    lane = vaddq_u64(lane, swapped);
+    lane = vmlal_u32(lane, keyLow, keyHigh);
+    vst1q_u64(lanes.data() + 2 * i, lane);
+  }
+#else
+  for (usize i = 0; i < 8; ++i) {
+    const u64 data = read64(stripe + 8 * i);
+    const u64 key = data ^ read64(secret + 8 * i);
+    lanes[i ^ 1] += data;
+    lanes[i] += (key & 0xFFFFFFFFULL) * (key >> 32);
+  }
+#endif
+}
+
+void ContentHasher::consumeStripe(const u8 *stripe) {
+  accumulate(m_lanes, stripe, m_secret.data() + m_blockStripe * 8);
+  if (++m_blockStripe == kStripesPerBlock) {
+    // Scramble so lanes never saturate into a fixed pattern
+    const u8 *key = m_secret.data() + kSecretSize - kStripeSize;
+    for (usize i = 0; i < m_lanes.size(); ++i) {
+      u64 lane = m_lanes[i];
+      lane ^= lane >> 47;
+      lane ^= read64(key + 8 * i);
+      m_lanes[i] = lane * kPrime32_1;
+    }
+    m_blockStripe = 0;
+  }
+}
+
+void ContentHasher::update(const void *data, usize size) {
+  if (size == 0) {
+    return;
+  }
+
+  const auto *input = static_cast<const u8 *>(data);
+  m_totalSize += size;
+
+  // The buffer always keeps the newest bytes, so a total of up to
+  // kShortLimit is still whole at finish()
+  if (m_buffered + size <= kBufferSize) {
+    std::memcpy(m_buffer.data() + m_buffered, input, size);
+    m_buffered += size;
+    return;
+  }
+
+  if (m_buffered > 0) {
+    const usize toCopy = kBufferSize - m_buffered;
+    std::memcpy(m_buffer.data() + m_buffered, input, toCopy);
+    input += toCopy;
+    size -= toCopy;
+    for (usize offset = 0; offset < kBufferSize; offset += kStripeSize) {
+      consumeStripe(m_buffer.data() + offset);
+    }
+    m_buffered = 0;
+  }
+
+  while (size > kBufferSize) {
+    consumeStripe(input);
+    input += kStripeSize;
+    size -= kStripeSize;
+  }
+
+  std::memcpy(m_buffer.data(), input, size);
+  m_buffered = size;
+}
+
+ContentHash ContentHasher::finish() const {
+  if (m_totalSize <= kShortLimit) {
+    return hashShort(m_buffer.data(), m_buffered, m_seed);
+  }
+
+  ContentHasher state = *this;
+  usize offset = 0;
+  for (; offset + kStripeSize <= state.m_buffered; offset += kStripeSize) {
+    state.consumeStripe(state.m_buffer.data() + offset);
+  }
+  if (offset < state.m_buffered) {
+    // Zero-padded final stripe; the total size below tells paddings apart
+    std::array<u8, kStripeSize> last{};
+    std::memcpy(last.data(), state.m_buffer.data() + offset,
+                state.m_buffered - offset);
+    accumulate(state.m_lanes, last.data(),
+               state.m_secret.data() + kSecretSize - kStripeSize - 7);
+  }
+
+  auto merge = [&state](const u8 *secret, u64 start) {
+    u64 result = start;
+    for (usize i = 0; i < 4; ++i) {
+      result += mulFold64(state.m_lanes[2 * i] ^ read64(secret + 16 * i),
+                          state.m_lanes[2 * i + 1] ^
+                              read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+  };
+
+  ContentHash result;
+  result.low = merge(state.m_secret.data() + 11, m_totalSize * kPrime64_1);
+  result.high = merge(state.m_secret.data() + kSecretSize - kStripeSize - 11,
+                      ~(m_totalSize * kPrime64_2));
+  return result;
+}
+
+ContentHash ContentHasher::hash(std::span<const u8> data, u64 seed) {
+  if (data.size() <= kShortLimit) {
+    return hashShort(data.data(), data.size(), seed);
+  }
+  ContentHasher hasher(seed);
+  hasher.update(data);
+  return hasher.finish();
+}
+
+} // namespace NovelMind::VFS
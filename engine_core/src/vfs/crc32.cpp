@@ -0,0 +1,321 @@
+#include "NovelMind/vfs/crc32.hpp"
+#include "NovelMind/core/cpu_features.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NOVELMIND_CRC32_PCLMUL 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define NOVELMIND_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#else
+#define NOVELMIND_TARGET_PCLMUL
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define NOVELMIND_CRC32_ARM 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define NOVELMIND_TARGET_ARM_CRC
+#else
+#include <arm_acle.h>
+#if defined(__ARM_FEATURE_CRC32)
+#define NOVELMIND_TARGET_ARM_CRC
+#elif defined(__clang__)
+#define NOVELMIND_TARGET_ARM_CRC __attribute__((target("crc")))
+#else
+#define NOVELMIND_TARGET_ARM_CRC __attribute__((target("+crc")))
+#endif
+#endif
+#endif
+
+namespace NovelMind::VFS {
+
+namespace {
+
+// All engines work on the raw register; update() applies the inversions
+using Crc32Fn = u32 (*)(u32, const u8 *, usize);
+
+constexpr u32 kPolynomial = 0xEDB88320; // Reflected IEEE 802.3
+
+constexpr std::array<std::array<u32, 256>, 16> makeTables() {
+  std::array<std::array<u32, 256>, 16> tables{};
+  for (u32 i = 0; i < 256; ++i) {
+    u32 crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1u) != 0 ? kPolynomial : 0u);
+    }
+    tables[0][i] = crc;
+  }
+  // tables[k][b]: byte b followed by k zero bytes
+  for (u32 i = 0; i < 256; ++i) {
+    for (usize k = 1; k < tables.size(); ++k) {
+      const u32 previous = tables[k - 1][i];
+      tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr auto kTables = makeTables();
+
+u32 read32(const u8 *p) {
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+u32 crcBytewise(u32 crc, const u8 *data, usize size) {
+  for (usize i = 0; i < size; ++i) {
+    crc = kTables[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+// Slicing folds whole little-endian words; big-endian hosts use bytes
+constexpr bool kLittleEndian = std::endian::native == std::endian::little;
+
+u32 crcSlicing8(u32 crc, const u8 *data, usize size) {
+  if constexpr (kLittleEndian) {
+    while (size >= 8) {
+      const u32 one = read32(data) ^ crc;
+      const u32 two = read32(data + 4);
+      crc = kTables[7][one & 0xFF] ^ kTables[6][(one >> 8) & 0xFF] ^
+            kTables[5][(one >> 16) & 0xFF] ^ kTables[4][one >> 24] ^
+            kTables[3][two & 0xFF] ^ kTables[2][(two >> 8) & 0xFF] ^
+            kTables[1][(two >> 16) & 0xFF] ^ kTables[0][two >> 24];
+      data += 8;
+      size -= 8;
+    }
+  }
+  return crcBytewise(crc, data, size);
+}
+
+u32 crcSlicing16(u32 crc, const u8 *data, usize size) {
+  if constexpr (kLittleEndian) {
+    while (size >= 16) {
+      const u32 one = read32(data) ^ crc;
+      const u32 two = read32(data + 4);
+      const u32 three = read32(data + 8);
+      const u32 four = read32(data + 12);
+      crc = kTables[15][one & 0xFF] ^ kTables[14][(one >> 8) & 0xFF] ^
+            kTables[13][(one >> 16) & 0xFF] ^ kTables[12][one >> 24] ^
+            kTables[11][two & 0xFF] ^ kTables[10][(two >> 8) & 0xFF] ^
+            kTables[9][(two >> 16) & 0xFF] ^ kTables[8][two >> 24] ^
+            kTables[7][three & 0xFF] ^ kTables[6][(three >> 8) & 0xFF] ^
+            kTables[5][(three >> 16) & 0xFF] ^ kTables[4][three >> 24] ^
+            kTables[3][four & 0xFF] ^ kTables[2][(four >> 8) & 0xFF] ^
+            kTables[1][(four >> 16) & 0xFF] ^ kTables[0][four >> 24];
+      data += 16;
+      size -= 16;
+    }
+  }
+  return crcSlicing8(crc, data, size);
+}
+
+#ifdef NOVELMIND_CRC32_PCLMUL
+// Folds four 128-bit lanes over 64-byte blocks, then reduces with a Barrett
+// step ("Fast CRC Computation for Generic Polynomials Using PCLMULQDQ",
+// Intel, 2009). Constants are x^n mod P for the reflected polynomial.
+NOVELMIND_TARGET_PCLMUL
+inline __m128i load128(const u8 *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+// acc * x^128 mod P (split across k's two halves), xor next
+NOVELMIND_TARGET_PCLMUL
+inline __m128i fold128(__m128i acc, __m128i next, __m128i k) {
+  const __m128i low = _mm_clmulepi64_si128(acc, k, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(acc, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, next), low);
+}
+
+NOVELMIND_TARGET_PCLMUL
+u32 crcPclmulBlocks(u32 crc, const u8 *data, usize size) {
+  // Requires size >= 64 and a multiple of 16
+  alignas(16) static const u64 kFold4[2] = {0x0154442bd4, 0x01c6e41596};
+  alignas(16) static const u64 kFold1[2] = {0x01751997d0, 0x00ccaa009e};
+  alignas(16) static const u64 kFold64[2] = {0x0163cd6124, 0x0000000000};
+  alignas(16) static const u64 kBarrett[2] = {0x01db710641, 0x01f7011641};
+
+  __m128i x1 = load128(data);
+  __m128i x2 = load128(data + 16);
+  __m128i x3 = load128(data + 32);
+  __m128i x4 = load128(data + 48);
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+  __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold4));
+  data += 64;
+  size -= 64;
+
+  while (size >= 64) {
+    x1 = fold128(x1, load128(data), k);
+    x2 = fold128(x2, load128(data + 16), k);
+    x3 = fold128(x3, load128(data + 32), k);
+    x4 = fold128(x4, load128(data + 48), k);
+    data += 64;
+    size -= 64;
+  }
+
+  // Fold the four lanes into one, then any remaining 16-byte blocks
+  k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold1));
+  x1 = fold128(x1, x2, k);
+  x1 = fold128(x1, x3, k);
+  x1 = fold128(x1, x4, k);
+  while (size >= 16) {
+    x1 = fold128(x1, load128(data), k);
+    data += 16;
+    size -= 16;
+  }
+
+  // 128 -> 64 bits
+  const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+  x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(kFold64));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), x2);
+
+  // Barrett reduction to 32 bits
+  k = _mm_load_si128(reinterpret_cast<const __m128i *>(kBarrett));
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  return static_cast<u32>(_mm_extract_epi32(x1, 1));
+}
+
+u32 crcPclmul(u32 crc, const u8 *data, usize size) {
+  if (size >= 64) {
+    const usize blocks = size & ~static_cast<usize>(15);
+    crc = crcPclmulBlocks(crc, data, blocks);
+    data += blocks;
+    size -= blocks;
+  }
+  return crcSlicing16(crc, data, size);
+}
+#endif
+
+#ifdef NOVELMIND_CRC32_ARM
+NOVELMIND_TARGET_ARM_CRC
+u32 crcArm(u32 crc, const u8 *data, usize size) {
+  while (size > 0 && (reinterpret_cast<std::uintptr_t>(data) & 7) != 0) {
+    crc = __crc32b(crc, *data++);
+    --size;
+  }
+  while (size >= 32) {
+    u64 words[4];
+    std::memcpy(words, data, sizeof(words));
+    crc = __crc32d(crc, words[0]);
+    crc = __crc32d(crc, words[1]);
+    crc = __crc32d(crc, words[2]);
+    crc = __crc32d(crc, words[3]);
+    data += 32;
+    size -= 32;
+  }
+  while (size >= 8) {
+    u64 word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = __crc32d(crc, word);
+    data += 8;
+    size -= 8;
+  }
+  while (size > 0) {
+    crc = __crc32b(crc, *data++);
+    --size;
+  }
+  return crc;
+}
+#endif
+
+Crc32Fn engineFunction(Crc32Engine engine) {
+  switch (engine) {
+  case Crc32Engine::Bytewise:
+    return crcBytewise;
+  case Crc32Engine::Slicing8:
+    return crcSlicing8;
+#ifdef NOVELMIND_CRC32_PCLMUL
+  case Crc32Engine::Pclmul:
+    return Crc32::isSupported(engine) ? crcPclmul : crcSlicing16;
+#endif
+#ifdef NOVELMIND_CRC32_ARM
+  case Crc32Engine::ArmCrc:
+    return Crc32::isSupported(engine) ? crcArm : crcSlicing16;
+#endif
+  default:
+    return crcSlicing16;
+  }
+}
+
+Crc32Fn activeFunction() {
+  static const Crc32Fn function = engineFunction(Crc32::activeEngine());
+  return function;
+}
+
+} // namespace
+
+u32 Crc32::update(u32 crc, const void *data, usize size) {
+  return ~activeFunction()(~crc, static_cast<const u8 *>(data), size);
+}
+
+u32 Crc32::update(Crc32Engine engine, u32 crc, const void *data,
+                  usize size) {
+  return ~engineFunction(engine)(~crc, static_cast<const u8 *>(data), size);
+}
+
+bool Crc32::isSupported(Crc32Engine engine) {
+  const auto &cpu = core::CpuFeatures::get();
+  switch (engine) {
+  case Crc32Engine::Bytewise:
+  case Crc32Engine::Slicing8:
+  case Crc32Engine::Slicing16:
+    return true;
+  case Crc32Engine::Pclmul:
+#ifdef NOVELMIND_CRC32_PCLMUL
+    return cpu.pclmul && cpu.sse41;
+#else
+    return false;
+#endif
+  case Crc32Engine::ArmCrc:
+#ifdef NOVELMIND_CRC32_ARM
+    return cpu.armCrc32;
+#else
+    return false;
+#endif
+  }
+  (void)cpu;
+  return false;
+}
+
+Crc32Engine Crc32::activeEngine() {
+  if (isSupported(Crc32Engine::Pclmul)) {
+    return Crc32Engine::Pclmul;
+  }
+  if (isSupported(Crc32Engine::ArmCrc)) {
+    return Crc32Engine::ArmCrc;
+  }
+  return Crc32Engine::Slicing16;
+}
+
+const char *Crc32::engineName(Crc32Engine engine) {
+  switch (engine) {
+  case Crc32Engine::Bytewise:
+    return "bytewise";
+  case Crc32Engine::Slicing8:
+    return "slicing-by-8";
+  case Crc32Engine::Slicing16:
+    return "slicing-by-16";
+  case Crc32Engine::Pclmul:
+    return "pclmulqdq";
+  case Crc32Engine::ArmCrc:
+    return "armv8-crc32";
+  }
+  return "unknown";
+}
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,493 @@
+#include "NovelMind/vfs/directory_backend.hpp"
+#include "NovelMind/vfs/positional_file.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace NovelMind::VFS {
+
+namespace {
+
+#if defined(__linux__)
+// How often the watcher thread checks whether it should stop
+constexpr int kPollIntervalMs = 100;
+#endif
+
+ResourceInfo makeInfo(std::string id, u64 size) {
+  ResourceInfo info;
+  info.resourceId = ResourceId(std::move(id));
+  info.size = static_cast<usize>(size);
+  info.compressedSize = info.size;
+  return info;
+}
+
+// Root as it prefixes the generic form of every path below it
+std::string rootPrefix(const std::string &rootPath) {
+  std::string prefix = fs::path(rootPath).generic_string();
+  if (!prefix.empty() && prefix.back() != '/') {
+    prefix += '/';
+  }
+  return prefix;
+}
+
+std::string relativeTo(const fs::path &path, const std::string &prefix) {
+  std::string generic = path.generic_string();
+  return generic.size() > prefix.size() ? generic.substr(prefix.size())
+                                        : std::string{};
+}
+
+void scanTree(const fs::path &dir, const std::string &prefix,
+              std::unordered_map<ResourceId, ResourceInfo> &files,
+              std::vector<std::string> *directories) {
+  if (directories) {
+    directories->push_back(relativeTo(dir, prefix));
+  }
+  std::error_code ec;
+  fs::recursive_directory_iterator it(
+      dir, fs::directory_options::skip_permission_denied, ec);
+  for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+    const auto &entry = *it;
+    std::error_code statError;
+    if (entry.is_directory(statError) && !entry.is_symlink(statError)) {
+      if (directories) {
+        directories->push_back(relativeTo(entry.path(), prefix));
+      }
+    } else if (entry.is_regular_file(statError)) {
+      const u64 size = entry.file_size(statError);
+      if (!statError) {
+        auto info = makeInfo(relativeTo(entry.path(), prefix), size);
+        files.emplace(info.resourceId, std::move(info));
+      }
+    }
+  }
+}
+
+} // namespace
+
+struct DirectoryBackend::Watcher {
+  std::thread thread;
+  std::atomic<bool> stop{false};
+#if defined(__linux__)
+  int fd = -1;
+  std::mutex mutex;
+  // Watch descriptor -> directory relative to the root, and back
+  std::unordered_map<int, std::string> directories;
+  std::unordered_map<std::string, int> descriptors;
+
+  void add(const std::string &root, const std::string &relativeDir) {
+    const std::string path =
+        relativeDir.empty() ? root : (fs::path(root) / relativeDir).string();
+    const int wd = inotify_add_watch(
+        fd, path.c_str(),
+        IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_ONLYDIR);
+    if (wd >= 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      directories[wd] = relativeDir;
+      descriptors[relativeDir] = wd;
+    }
+  }
+
+  void removeUnder(const std::string &relativeDir) {
+    const std::string prefix = relativeDir + '/';
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = descriptors.begin(); it != descriptors.end();) {
+      if (it->first == relativeDir || it->first.starts_with(prefix)) {
+        inotify_rm_watch(fd, it->second);
+        directories.erase(it->second);
+        it = descriptors.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  std::optional<std::string> directoryOf(int wd) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = directories.find(wd);
+    if (it == directories.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void forget(int wd) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = directories.find(wd);
+    if (it != directories.end()) {
+      descriptors.erase(it->second);
+      directories.erase(it);
+    }
+  }
+#endif
+};
+
+DirectoryBackend::DirectoryBackend(std::string rootPath, u32 priority)
+    : m_rootPath(std::move(rootPath)), m_priority(priority) {}
+
+DirectoryBackend::~DirectoryBackend() { shutdown(); }
+
+Result<void> DirectoryBackend::initialize() {
+  std::error_code ec;
+  if (!fs::is_directory(m_rootPath, ec)) {
+    return Result<void>::error("Not a directory: " + m_rootPath);
+  }
+  shutdown();
+
+  std::vector<std::string> directories;
+  FileMap files = scan({}, &directories);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files = std::move(files);
+  }
+
+#if defined(__linux__)
+  const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd >= 0) {
+    m_watcher = std::make_unique<Watcher>();
+    m_watcher->fd = fd;
+    for (const auto &dir : directories) {
+      m_watcher->add(m_rootPath, dir);
+    }
+    m_watcher->thread = std::thread([this]() { watchLoop(); });
+  }
+#endif
+  return Result<void>::ok();
+}
+
+void DirectoryBackend::shutdown() {
+  if (m_watcher) {
+    m_watcher->stop.store(true);
+    if (m_watcher->thread.joinable()) {
+      m_watcher->thread.join();
+    }
+#if defined(__linux__)
+    ::close(m_watcher->fd);
+#endif
+    m_watcher.reset();
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_files.clear();
+}
+
+Result<void> DirectoryBackend::refresh() {
+  std::error_code ec;
+  if (!fs::is_directory(m_rootPath, ec)) {
+    return Result<void>::error("Not a directory: " + m_rootPath);
+  }
+  std::vector<std::string> directories;
+  FileMap files = scan({}, &directories);
+#if defined(__linux__)
+  if (m_watcher) {
+    // Re-adding a watched directory keeps its descriptor
+    for (const auto &dir : directories) {
+      m_watcher->add(m_rootPath, dir);
+    }
+  }
+#endif
+  std::vector<ResourceId> changed;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Without modification times any file seen before may have changed
+    changed.reserve(m_files.size());
+    for (const auto &entry : m_files) {
+      changed.push_back(entry.first);
+    }
+    for (const auto &entry : files) {
+      if (m_files.find(entry.first) == m_files.end()) {
+        changed.push_back(entry.first);
+      }
+    }
+    m_files = std::move(files);
+  }
+  m_changeCount.fetch_add(1, std::memory_order_acq_rel);
+  notifyChanged(changed);
+  return Result<void>::ok();
+}
+
+void DirectoryBackend::setChangeCallback(ChangeCallback callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_changeCallback = std::move(callback);
+}
+
+bool DirectoryBackend::isWatching() const { return m_watcher != nullptr; }
+
+std::unique_ptr<IFileHandle> DirectoryBackend::open(const ResourceId &id) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_files.find(id) == m_files.end()) {
+      return nullptr;
+    }
+  }
+  auto file = PositionalFile::open(absolutePath(id.id()));
+  if (file.isError()) {
+    return nullptr;
+  }
+  return std::make_unique<PositionalFileHandle>(std::move(file).value());
+}
+
+bool DirectoryBackend::exists(const ResourceId &id) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_files.find(id) != m_files.end();
+}
+
+std::optional<ResourceInfo>
+DirectoryBackend::getInfo(const ResourceId &id) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_files.find(id);
+  if (it == m_files.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<ResourceId> DirectoryBackend::list(ResourceType type) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<ResourceId> result;
+  result.reserve(m_files.size());
+  for (const auto &[id, info] : m_files) {
+    if (type == ResourceType::Unknown || id.type() == type) {
+      result.push_back(id);
+    }
+  }
+  return result;
+}
+
+DirectoryBackend::FileMap
+DirectoryBackend::scan(const std::string &relativeDir,
+                       std::vector<std::string> *directories) const {
+  const std::string prefix = rootPrefix(m_rootPath);
+  const fs::path base = relativeDir.empty()
+                            ? fs::path(m_rootPath)
+                            : fs::path(m_rootPath) / relativeDir;
+  if (directories) {
+    directories->push_back(relativeDir);
+  }
+
+  FileMap files;
+  std::vector<fs::path> subdirectories;
+  std::error_code ec;
+  for (fs::directory_iterator it(base, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    std::error_code statError;
+    if (it->is_directory(statError) && !it->is_symlink(statError)) {
+      subdirectories.push_back(it->path());
+    } else if (it->is_regular_file(statError)) {
+      const u64 size = it->file_size(statError);
+      if (!statError) {
+        auto info = makeInfo(relativeTo(it->path(), prefix), size);
+        files.emplace(info.resourceId, std::move(info));
+      }
+    }
+  }
+
+  // Subtrees are walked concurrently; the time goes into stat calls, which
+  // overlap well even on one disk
+  const usize workerCount =
+      std::min<usize>(subdirectories.size(),
+                      std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<FileMap> partialFiles(workerCount);
+  std::vector<std::vector<std::string>> partialDirectories(workerCount);
+  std::atomic<usize> next{0};
+  const auto work = [&](usize worker) {
+    for (usize i = next.fetch_add(1); i < subdirectories.size();
+         i = next.fetch_add(1)) {
+      scanTree(subdirectories[i], prefix, partialFiles[worker],
+               directories ? &partialDirectories[worker] : nullptr);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (usize worker = 1; worker < workerCount; ++worker) {
+    threads.emplace_back(work, worker);
+  }
+  if (workerCount > 0) {
+    work(0);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (usize worker = 0; worker < workerCount; ++worker) {
+    files.merge(partialFiles[worker]);
+    if (directories) {
+      directories->insert(directories->end(),
+                          partialDirectories[worker].begin(),
+                          partialDirectories[worker].end());
+    }
+  }
+  return files;
+}
+
+std::optional<ResourceInfo>
+DirectoryBackend::statFile(const std::string &relativePath) const {
+  std::error_code ec;
+  const fs::path path = absolutePath(relativePath);
+  if (!fs::is_regular_file(path, ec)) {
+    return std::nullopt;
+  }
+  const u64 size = fs::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return makeInfo(relativePath, size);
+}
+
+std::string DirectoryBackend::absolutePath(const std::string &id) const {
+  return (fs::path(m_rootPath) / id).string();
+}
+
+std::vector<ResourceId>
+DirectoryBackend::updateFile(const std::string &relativePath) {
+  auto info = statFile(relativePath);
+  if (!info) {
+    return removeFile(relativePath);
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ResourceId id = info->resourceId;
+  m_files.insert_or_assign(id, std::move(*info));
+  return {std::move(id)};
+}
+
+std::vector<ResourceId>
+DirectoryBackend::removeFile(const std::string &relativePath) {
+  ResourceId id(relativePath);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_files.erase(id) == 0) {
+    return {};
+  }
+  return {std::move(id)};
+}
+
+std::vector<ResourceId>
+DirectoryBackend::addDirectory(const std::string &relativeDir) {
+  std::vector<std::string> directories;
+  FileMap files = scan(relativeDir, &directories);
+#if defined(__linux__)
+  if (m_watcher) {
+    for (const auto &dir : directories) {
+      m_watcher->add(m_rootPath, dir);
+    }
+  }
+#endif
+  std::vector<ResourceId> changed;
+  changed.reserve(files.size());
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto &[id, info] : files) {
+    changed.push_back(id);
+    m_files.insert_or_assign(id, std::move(info));
+  }
+  return changed;
+}
+
+std::vector<ResourceId>
+DirectoryBackend::removeDirectory(const std::string &relativeDir) {
+#if defined(__linux__)
+  if (m_watcher) {
+    m_watcher->removeUnder(relativeDir);
+  }
+#endif
+  const std::string prefix = relativeDir + '/';
+  std::vector<ResourceId> changed;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_files.begin(); it != m_files.end();) {
+    if (it->first.id().starts_with(prefix)) {
+      changed.push_back(it->first);
+      it = m_files.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return changed;
+}
+
+void DirectoryBackend::notifyChanged(const std::vector<ResourceId> &ids) {
+  if (ids.empty()) {
+    return;
+  }
+  m_changeCount.fetch_add(ids.size(), std::memory_order_acq_rel);
+  ChangeCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    callback = m_changeCallback;
+  }
+  if (callback) {
+    for (const auto &id : ids) {
+      callback(id);
+    }
+  }
+}
+
+void DirectoryBackend::watchLoop() {
+#if defined(__linux__)
+  alignas(inotify_event) char buffer[16 * 1024];
+  while (!m_watcher->stop.load()) {
+    pollfd request{m_watcher->fd, POLLIN, 0};
+    if (::poll(&request, 1, kPollIntervalMs) <= 0) {
+      continue;
+    }
+    const ssize_t length = ::read(m_watcher->fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      continue;
+    }
+
+    std::vector<ResourceId> changed;
+    bool overflowed = false;
+    for (usize offset = 0; offset < static_cast<usize>(length);) {
+      const auto *event =
+          reinterpret_cast<const inotify_event *>(buffer + offset);
+      offset += sizeof(inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        overflowed = true;
+        continue;
+      }
+      if (event->mask & IN_IGNORED) {
+        m_watcher->forget(event->wd);
+        continue;
+      }
+      const auto dir = m_watcher->directoryOf(event->wd);
+      if (!dir || event->len == 0) {
+        continue;
+      }
+      const std::string name(event->name);
+      const std::string path = dir->empty() ? name : *dir + '/' + name;
+
+      std::vector<ResourceId> ids;
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          ids = addDirectory(path);
+        } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+          ids = removeDirectory(path);
+        }
+      } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+        ids = removeFile(path);
+      } else {
+        ids = updateFile(path);
+      }
+      changed.insert(changed.end(), ids.begin(), ids.end());
+    }
+
+    if (overflowed) {
+      // Events were dropped; only a rescan is trustworthy
+      (void)refresh();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      changed.clear();
+      for (const auto &entry : m_files) {
+        changed.push_back(entry.first);
+      }
+    }
+    notifyChanged(changed);
+  }
+#endif
+}
+
+} // namespace NovelMind::VFS
@@ -61,7 +61,7 @@ Result<usize> MemoryFileHandle::read(u8 *buffer, usize count) {
     return Result<usize>::error("Invalid file handle");
   }
 
-  if (buffer == nullptr) {
+  if (buffer == nullptr && count > 0) {
     return Result<usize>::error("Null buffer");
   }
 
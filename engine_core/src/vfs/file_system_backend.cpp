@@ -1,27 +1,10 @@
 #include "NovelMind/vfs/file_system_backend.hpp"
+#include "NovelMind/vfs/crc32.hpp"
 #include <algorithm>
 #include <numeric>
 
 namespace NovelMind::VFS {
 
-namespace {
-
-u32 crc32(const std::vector<u8> &data) {
-  constexpr u32 CRC32_POLYNOMIAL = 0xEDB88320;
-  u32 crc = 0xFFFFFFFF;
-
-  for (const u8 byte : data) {
-    crc ^= byte;
-    for (int i = 0; i < 8; ++i) {
-      crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
-    }
-  }
-
-  return ~crc;
-}
-
-} // anonymous namespace
-
 std::unique_ptr<IFileHandle> MemoryBackend::open(const ResourceId &id) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
@@ -95,7 +78,7 @@ void MemoryBackend::clear() {
 }
 
 u32 MemoryBackend::calculateChecksum(const std::vector<u8> &data) {
-  return crc32(data);
+  return Crc32::compute(data.data(), data.size());
 }
 
 } // namespace NovelMind::VFS
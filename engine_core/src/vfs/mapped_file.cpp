@@ -0,0 +1,135 @@
+#include "NovelMind/vfs/mapped_file.hpp"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NovelMind::VFS {
+
+MappedFile::~MappedFile() {
+#if defined(_WIN32)
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mappingHandle) {
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+  }
+  if (m_fileHandle) {
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+  }
+#else
+  if (m_data) {
+    munmap(const_cast<u8 *>(m_data), m_size);
+  }
+#endif
+}
+
+Result<std::shared_ptr<const MappedFile>>
+MappedFile::open(const std::string &path) {
+  using ResultType = Result<std::shared_ptr<const MappedFile>>;
+
+  std::shared_ptr<MappedFile> mapped(new MappedFile());
+  mapped->m_path = path;
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return ResultType::error("Failed to open file for mapping: " + path);
+  }
+  mapped->m_fileHandle = file;
+
+  LARGE_INTEGER fileSize{};
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < 0) {
+    return ResultType::error("Failed to determine file size: " + path);
+  }
+  mapped->m_size = static_cast<usize>(fileSize.QuadPart);
+  if (mapped->m_size == 0) {
+    return ResultType::ok(std::move(mapped));
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    return ResultType::error("Failed to create file mapping: " + path);
+  }
+  mapped->m_mappingHandle = mapping;
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    return ResultType::error("Failed to map view of file: " + path);
+  }
+  mapped->m_data = static_cast<const u8 *>(view);
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return ResultType::error("Failed to open file for mapping: " + path);
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size < 0) {
+    ::close(fd);
+    return ResultType::error("Failed to determine file size: " + path);
+  }
+  mapped->m_size = static_cast<usize>(st.st_size);
+  if (mapped->m_size == 0) {
+    ::close(fd);
+    return ResultType::ok(std::move(mapped));
+  }
+
+  void *view = mmap(nullptr, mapped->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the file
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    mapped->m_size = 0;
+    return ResultType::error("Failed to map file: " + path);
+  }
+  mapped->m_data = static_cast<const u8 *>(view);
+#endif
+
+  return ResultType::ok(std::move(mapped));
+}
+
+std::span<const u8> MappedFile::bytes(u64 offset, u64 length) const {
+  if (offset > m_size || length > m_size - offset) {
+    return {};
+  }
+  return {m_data + offset, static_cast<usize>(length)};
+}
+
+void MappedFile::prefetch(u64 offset, u64 length) const {
+  if (!m_data || offset >= m_size) {
+    return;
+  }
+  length = std::min<u64>(length, m_size - offset);
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+  WIN32_MEMORY_RANGE_ENTRY range{};
+  range.VirtualAddress = const_cast<u8 *>(m_data + offset);
+  range.NumberOfBytes = static_cast<SIZE_T>(length);
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  (void)length;
+#endif
+#else
+  // madvise wants a page-aligned start
+  const u64 pageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 aligned = offset - offset % pageSize;
+  madvise(const_cast<u8 *>(m_data + aligned),
+          static_cast<usize>(length + (offset - aligned)), MADV_WILLNEED);
+#endif
+}
+
+} // namespace NovelMind::VFS
@@ -4,12 +4,15 @@
  */
 
 #include "NovelMind/vfs/multi_pack_manager.hpp"
+#include "NovelMind/vfs/pack_delta.hpp"
 #include <algorithm>
+#include <array>
 #include <filesystem>
 #include <cstdlib>
 #include <fstream>
 #include <regex>
 #include <sstream>
+#include <unordered_set>
 #include <utility>
 
 namespace NovelMind::vfs {
@@ -121,8 +124,8 @@ Result<void> MultiPackManager::initialize() {
 
   m_packs.clear();
   m_packIdToIndex.clear();
-  m_resourceIndex.clear();
   m_modLoadOrder.clear();
+  rebuildLookupOrder();
 
   auto envResult = configureKeysFromEnvironment();
   if (envResult.isError()) {
@@ -275,12 +278,7 @@ PackLoadResult MultiPackManager::loadPackInternal(const std::string &path,
   loadedPack->reader = std::move(reader);
   loadedPack->effectivePriority = calculateEffectivePriority(type, priority);
 
-  // Collect provided resources
-  auto resources = loadedPack->reader->listResources();
-  for (const auto &resId : resources) {
-    loadedPack->providedResources.insert(resId);
-  }
-  result.loadedResources = loadedPack->providedResources.size();
+  result.loadedResources = loadedPack->reader->resourceCount();
 
   // Add to packs list
   m_packIdToIndex[loadedPack->info.id] = m_packs.size();
@@ -291,8 +289,7 @@ PackLoadResult MultiPackManager::loadPackInternal(const std::string &path,
     m_modLoadOrder.push_back(result.packId);
   }
 
-  // Rebuild resource index
-  rebuildResourceIndex();
+  rebuildLookupOrder();
 
   result.success = true;
   firePackLoaded(m_packs.back()->info);
@@ -326,7 +323,7 @@ void MultiPackManager::unloadPack(const std::string &packId) {
     m_packIdToIndex[m_packs[i]->info.id] = i;
   }
 
-  rebuildResourceIndex();
+  rebuildLookupOrder();
   firePackUnloaded(packId);
 }
 
@@ -355,8 +352,8 @@ void MultiPackManager::unloadAllPacks() {
 
   m_packs.clear();
   m_packIdToIndex.clear();
-  m_resourceIndex.clear();
   m_modLoadOrder.clear();
+  rebuildLookupOrder();
 }
 
 PackLoadResult MultiPackManager::reloadPack(const std::string &packId) {
@@ -380,7 +377,7 @@ void MultiPackManager::setPackEnabled(const std::string &packId, bool enabled) {
   auto it = m_packIdToIndex.find(packId);
   if (it != m_packIdToIndex.end()) {
     m_packs[it->second]->info.enabled = enabled;
-    rebuildResourceIndex();
+    rebuildLookupOrder();
   }
 }
 
@@ -518,54 +515,125 @@ bool MultiPackManager::isPackEnabled(const std::string &packId) const {
 
 Result<std::vector<u8>>
 MultiPackManager::readResource(const std::string &resourceId) {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it == m_resourceIndex.end()) {
+  auto result = readResolved(resourceId);
+  if (m_traceRecorder && result.isOk()) {
+    m_traceRecorder->recordRead(resourceId, result.value().size());
+  }
+  return result;
+}
+
+void MultiPackManager::prefetch(
+    const std::vector<std::string> &resourceIds) const {
+  // Group by provider so each pack can merge its own ranges
+  std::unordered_map<const SecurePackFileSystem *, std::vector<std::string>>
+      byPack;
+  for (const auto &id : resourceIds) {
+    if (const LoadedPack *pack = findProvider(id)) {
+      byPack[pack->reader.get()].push_back(id);
+    }
+  }
+  for (const auto &[reader, ids] : byPack) {
+    reader->prefetch(ids);
+  }
+}
+
+Result<std::vector<u8>>
+MultiPackManager::readResolved(const std::string &resourceId) {
+  const auto position = findProviderPosition(resourceId, 0);
+  if (!position) {
     return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
   }
 
-  auto &pack = m_packs[it->second];
-  if (!pack->info.enabled) {
-    return Result<std::vector<u8>>::error("Pack is disabled: " + pack->info.id);
+  const auto &pack = m_packs[m_lookupOrder[*position]];
+  if (!pack->reader->isDelta(resourceId)) {
+    return pack->reader->readFile(resourceId);
+  }
+
+  auto cached = m_patchCache.find(resourceId);
+  if (cached != m_patchCache.end()) {
+    m_patchLru.splice(m_patchLru.begin(), m_patchLru,
+                      cached->second.lruPosition);
+    return Result<std::vector<u8>>::ok(cached->second.data);
   }
 
-  return pack->reader->readFile(resourceId);
+  auto result = resolveResource(*position, resourceId);
+  if (result.isError() || result.value().size() > m_patchCacheBudget) {
+    return result;
+  }
+
+  while (!m_patchLru.empty() &&
+         m_patchCacheBytes + result.value().size() > m_patchCacheBudget) {
+    auto evicted = m_patchCache.find(m_patchLru.back());
+    m_patchCacheBytes -= evicted->second.data.size();
+    m_patchCache.erase(evicted);
+    m_patchLru.pop_back();
+  }
+  m_patchLru.push_front(resourceId);
+  m_patchCache[resourceId] = {result.value(), m_patchLru.begin()};
+  m_patchCacheBytes += result.value().size();
+  return result;
+}
+
+void MultiPackManager::setPatchCacheBudget(usize bytes) {
+  m_patchCacheBudget = bytes;
+  clearPatchCache();
 }
 
 bool MultiPackManager::exists(const std::string &resourceId) const {
-  return m_resourceIndex.find(resourceId) != m_resourceIndex.end();
+  return findProvider(resourceId) != nullptr;
 }
 
 std::optional<ResourceInfo>
 MultiPackManager::getResourceInfo(const std::string &resourceId) const {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it == m_resourceIndex.end()) {
+  const LoadedPack *pack = findProvider(resourceId);
+  if (!pack) {
     return std::nullopt;
   }
 
-  return m_packs[it->second]->reader->getInfo(resourceId);
+  auto info = pack->reader->getInfo(resourceId);
+  if (info && pack->reader->isDelta(resourceId)) {
+    // Report the size of the rebuilt resource, not of the delta; only the
+    // delta header is decoded
+    std::array<u8, VFS::PackDelta::kHeaderSize> bytes{};
+    auto read = pack->reader->readFilePrefix(resourceId, bytes);
+    if (read.isError()) {
+      return std::nullopt;
+    }
+    auto header = VFS::PackDelta::readHeader(
+        std::span<const u8>(bytes).first(read.value()));
+    if (header.isError()) {
+      return std::nullopt;
+    }
+    info->size = static_cast<usize>(header.value().targetSize);
+  }
+  return info;
 }
 
 std::string
 MultiPackManager::getResourcePack(const std::string &resourceId) const {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it != m_resourceIndex.end()) {
-    return m_packs[it->second]->info.id;
-  }
-  return "";
+  const LoadedPack *pack = findProvider(resourceId);
+  return pack ? pack->info.id : "";
 }
 
 std::vector<std::string>
 MultiPackManager::listResources(ResourceType type) const {
   std::vector<std::string> result;
-
-  for (const auto &[resourceId, packIndex] : m_resourceIndex) {
-    if (type == ResourceType::Unknown) {
-      result.push_back(resourceId);
-    } else {
-      auto info = m_packs[packIndex]->reader->getInfo(resourceId);
-      if (info && info->type == type) {
-        result.push_back(resourceId);
+  std::unordered_set<std::string> seen;
+
+  // The first pack to list an id provides it; its type decides the filter
+  for (size_t idx : m_lookupOrder) {
+    const auto &reader = *m_packs[idx]->reader;
+    for (auto &resourceId : reader.listResources()) {
+      if (!seen.insert(resourceId).second) {
+        continue;
       }
+      if (type != ResourceType::Unknown) {
+        auto info = reader.getInfo(resourceId);
+        if (!info || info->type != type) {
+          continue;
+        }
+      }
+      result.push_back(std::move(resourceId));
     }
   }
 
@@ -594,7 +662,7 @@ std::vector<ResourceOverride> MultiPackManager::getActiveOverrides() const {
     if (!pack->info.enabled)
       continue;
 
-    for (const auto &resourceId : pack->providedResources) {
+    for (const auto &resourceId : pack->reader->listResources()) {
       auto it = firstOccurrence.find(resourceId);
       if (it == firstOccurrence.end()) {
         firstOccurrence[resourceId] = {pack->info.id, pack->info.type};
@@ -648,7 +716,7 @@ void MultiPackManager::setModLoadOrder(const std::vector<std::string> &order) {
     }
   }
 
-  rebuildResourceIndex();
+  rebuildLookupOrder();
 }
 
 void MultiPackManager::moveModUp(const std::string &packId) {
@@ -760,7 +828,7 @@ Result<void> MultiPackManager::loadModConfig(const std::string &path) {
       }
     }
 
-    rebuildResourceIndex();
+    rebuildLookupOrder();
   }
 
   return {};
@@ -772,13 +840,9 @@ Result<void> MultiPackManager::loadModConfig(const std::string &path) {
 
 size_t MultiPackManager::getPackCount() const { return m_packs.size(); }
 
-size_t MultiPackManager::getResourceCount() const {
-  return m_resourceIndex.size();
-}
+size_t MultiPackManager::getResourceCount() const { return m_resourceCount; }
 
-size_t MultiPackManager::getOverrideCount() const {
-  return getActiveOverrides().size();
-}
+size_t MultiPackManager::getOverrideCount() const { return m_overrideCount; }
 
 // =========================================================================
 // Callbacks
@@ -829,29 +893,96 @@ PackInfo MultiPackManager::readPackManifest(const std::string &path) {
   return info;
 }
 
-void MultiPackManager::rebuildResourceIndex() {
-  m_resourceIndex.clear();
-
-  // Sort packs by effective priority (descending for override)
-  std::vector<std::pair<size_t, i32>> sorted;
+void MultiPackManager::rebuildLookupOrder() {
+  // Rebuilt patches depend on which packs lie below them
+  clearPatchCache();
+  m_lookupOrder.clear();
   for (size_t i = 0; i < m_packs.size(); ++i) {
     if (m_packs[i]->info.enabled) {
-      sorted.emplace_back(i, m_packs[i]->effectivePriority);
+      m_lookupOrder.push_back(i);
     }
   }
 
-  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
-    return a.second > b.second; // Higher priority first
-  });
-
-  // Build index (first occurrence wins due to descending sort)
-  for (const auto &[idx, priority] : sorted) {
-    for (const auto &resourceId : m_packs[idx]->providedResources) {
-      if (m_resourceIndex.find(resourceId) == m_resourceIndex.end()) {
-        m_resourceIndex[resourceId] = idx;
+  // Higher priority first; ties keep load order
+  std::stable_sort(m_lookupOrder.begin(), m_lookupOrder.end(),
+                   [this](size_t a, size_t b) {
+                     return m_packs[a]->effectivePriority >
+                            m_packs[b]->effectivePriority;
+                   });
+
+  // An id held by m packs is one resource and m - 1 overrides, and each of
+  // those overrides is a pack with the id somewhere below it. Only packs
+  // above the lowest one, normally the small mods and patches over the
+  // base game, have their ids listed.
+  usize entries = 0;
+  usize overrides = 0;
+  for (size_t position = 0; position < m_lookupOrder.size(); ++position) {
+    const auto &reader = *m_packs[m_lookupOrder[position]]->reader;
+    entries += reader.resourceCount();
+    if (position + 1 == m_lookupOrder.size()) {
+      break;
+    }
+    for (const auto &resourceId : reader.listResources()) {
+      if (findProviderPosition(resourceId, position + 1).has_value()) {
+        ++overrides;
       }
     }
   }
+  m_resourceCount = entries - overrides;
+  m_overrideCount = overrides;
+}
+
+const MultiPackManager::LoadedPack *
+MultiPackManager::findProvider(const std::string &resourceId) const {
+  const auto position = findProviderPosition(resourceId, 0);
+  return position ? m_packs[m_lookupOrder[*position]].get() : nullptr;
+}
+
+std::optional<size_t>
+MultiPackManager::findProviderPosition(const std::string &resourceId,
+                                       size_t from) const {
+  for (size_t position = from; position < m_lookupOrder.size(); ++position) {
+    if (m_packs[m_lookupOrder[position]]->reader->exists(resourceId)) {
+      return position;
+    }
+  }
+  return std::nullopt;
+}
+
+Result<std::vector<u8>>
+MultiPackManager::resolveResource(size_t position,
+                                  const std::string &resourceId) const {
+  const auto &reader = *m_packs[m_lookupOrder[position]]->reader;
+  auto data = reader.readFile(resourceId);
+  if (data.isError() || !reader.isDelta(resourceId)) {
+    return data;
+  }
+
+  auto header = VFS::PackDelta::readHeader(data.value());
+  if (header.isError()) {
+    return Result<std::vector<u8>>::error(resourceId + ": " + header.error());
+  }
+
+  // The base is the first version below this pack with the content the delta
+  // was made from; packs in between may carry unrelated replacements
+  for (auto below = findProviderPosition(resourceId, position + 1); below;
+       below = findProviderPosition(resourceId, *below + 1)) {
+    auto base = resolveResource(*below, resourceId);
+    if (base.isError() || base.value().size() != header.value().baseSize ||
+        VFS::ContentHasher::hash(base.value()) != header.value().baseHash) {
+      continue;
+    }
+    return VFS::PackDelta::apply(base.value(), data.value());
+  }
+
+  return Result<std::vector<u8>>::error(
+      "No matching base for patched resource: " + resourceId);
+}
+
+void MultiPackManager::clearPatchCache() {
+  m_patchCache.clear();
+  m_patchLru.clear();
+  m_patchCacheBytes = 0;
 }
 
 i32 MultiPackManager::calculateEffectivePriority(PackType type,
@@ -0,0 +1,432 @@
+#include "NovelMind/vfs/pack_compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#ifdef NOVELMIND_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NOVELMIND_HAS_ZSTD
+#include <zstd.h>
+#endif
+#ifdef NOVELMIND_HAS_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+
+namespace NovelMind::VFS {
+
+namespace {
+// Same per-resource ceiling the pack readers enforce
+constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024;
+} // namespace
+
+bool PackCompressor::isAvailable(PackCompression codec) {
+  switch (codec) {
+  case PackCompression::None:
+    return true;
+  case PackCompression::Zlib:
+#ifdef NOVELMIND_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  case PackCompression::Zstd:
+#ifdef NOVELMIND_HAS_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  case PackCompression::Lz4:
+#ifdef NOVELMIND_HAS_LZ4
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+const char *PackCompressor::name(PackCompression codec) {
+  switch (codec) {
+  case PackCompression::None:
+    return "none";
+  case PackCompression::Zlib:
+    return "zlib";
+  case PackCompression::Zstd:
+    return "zstd";
+  case PackCompression::Lz4:
+    return "lz4";
+  }
+  return "unknown";
+}
+
+Result<std::vector<u8>> PackCompressor::compress(PackCompression codec,
+                                                 std::span<const u8> data,
+                                                 i32 level) {
+  using ResultType = Result<std::vector<u8>>;
+
+  if (!isAvailable(codec)) {
+    return ResultType::error(std::string("Compression codec not available: ") +
+                             name(codec));
+  }
+
+  switch (codec) {
+  case PackCompression::None:
+    return ResultType::ok(std::vector<u8>(data.begin(), data.end()));
+
+  case PackCompression::Zlib: {
+#ifdef NOVELMIND_HAS_ZLIB
+    if (data.size() > std::numeric_limits<uLong>::max()) {
+      return ResultType::error("Resource exceeds zlib limits");
+    }
+    uLongf destLen = compressBound(static_cast<uLong>(data.size()));
+    std::vector<u8> out(static_cast<usize>(destLen));
+    const int res =
+        compress2(out.data(), &destLen, data.data(),
+                  static_cast<uLong>(data.size()),
+                  level > 0 ? level : Z_DEFAULT_COMPRESSION);
+    if (res != Z_OK) {
+      return ResultType::error("zlib compression failed");
+    }
+    out.resize(static_cast<usize>(destLen));
+    return ResultType::ok(std::move(out));
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Zstd: {
+#ifdef NOVELMIND_HAS_ZSTD
+    std::vector<u8> out(ZSTD_compressBound(data.size()));
+    const size_t written =
+        ZSTD_compress(out.data(), out.size(), data.data(), data.size(),
+                      level > 0 ? level : ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(written)) {
+      return ResultType::error(std::string("zstd compression failed: ") +
+                               ZSTD_getErrorName(written));
+    }
+    out.resize(written);
+    return ResultType::ok(std::move(out));
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Lz4: {
+#ifdef NOVELMIND_HAS_LZ4
+    if (data.size() > static_cast<usize>(LZ4_MAX_INPUT_SIZE)) {
+      return ResultType::error("Resource exceeds LZ4 limits");
+    }
+    const int srcSize = static_cast<int>(data.size());
+    std::vector<u8> out(static_cast<usize>(LZ4_compressBound(srcSize)));
+    const int written =
+        level >= LZ4HC_CLEVEL_MIN
+            ? LZ4_compress_HC(reinterpret_cast<const char *>(data.data()),
+                              reinterpret_cast<char *>(out.data()), srcSize,
+                              static_cast<int>(out.size()), level)
+            : LZ4_compress_default(
+                  reinterpret_cast<const char *>(data.data()),
+                  reinterpret_cast<char *>(out.data()), srcSize,
+                  static_cast<int>(out.size()));
+    if (written <= 0 && srcSize > 0) {
+      return ResultType::error("LZ4 compression failed");
+    }
+    out.resize(static_cast<usize>(written));
+    return ResultType::ok(std::move(out));
+#else
+    break;
+#endif
+  }
+  }
+
+  return ResultType::error("Unknown compression codec");
+}
+
+Result<std::vector<u8>> PackCompressor::decompress(PackCompression codec,
+                                                   std::span<const u8> data,
+                                                   u64 uncompressedSize) {
+  using ResultType = Result<std::vector<u8>>;
+
+  if (!isAvailable(codec)) {
+    return ResultType::error(
+        std::string("Resource requires unavailable codec: ") + name(codec));
+  }
+
+  if (uncompressedSize > MAX_RESOURCE_SIZE) {
+    return ResultType::error("Uncompressed size exceeds limit");
+  }
+
+  std::vector<u8> out(static_cast<usize>(uncompressedSize));
+  auto result = decompressInto(codec, data, out);
+  if (result.isError()) {
+    return ResultType::error(result.error());
+  }
+  return ResultType::ok(std::move(out));
+}
+
+Result<void> PackCompressor::decompressInto(PackCompression codec,
+                                            std::span<const u8> data,
+                                            std::span<u8> out) {
+  using ResultType = Result<void>;
+
+  if (!isAvailable(codec)) {
+    return ResultType::error(
+        std::string("Resource requires unavailable codec: ") + name(codec));
+  }
+
+  if (out.size() > MAX_RESOURCE_SIZE) {
+    return ResultType::error("Uncompressed size exceeds limit");
+  }
+
+  switch (codec) {
+  case PackCompression::None:
+    if (data.size() != out.size()) {
+      return ResultType::error("Stored size mismatch");
+    }
+    if (!data.empty()) {
+      std::memmove(out.data(), data.data(), data.size());
+    }
+    return ResultType::ok();
+
+  case PackCompression::Zlib: {
+#ifdef NOVELMIND_HAS_ZLIB
+    uLongf destLen = static_cast<uLongf>(out.size());
+    const int res = uncompress(out.data(), &destLen, data.data(),
+                               static_cast<uLong>(data.size()));
+    if (res != Z_OK || destLen != out.size()) {
+      return ResultType::error("zlib decompression failed");
+    }
+    return ResultType::ok();
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Zstd: {
+#ifdef NOVELMIND_HAS_ZSTD
+    const size_t written =
+        ZSTD_decompress(out.data(), out.size(), data.data(), data.size());
+    if (ZSTD_isError(written) || written != out.size()) {
+      return ResultType::error("zstd decompression failed");
+    }
+    return ResultType::ok();
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Lz4: {
+#ifdef NOVELMIND_HAS_LZ4
+    if (data.size() > static_cast<usize>(std::numeric_limits<int>::max())) {
+      return ResultType::error("Resource exceeds LZ4 limits");
+    }
+    const int written = LZ4_decompress_safe(
+        reinterpret_cast<const char *>(data.data()),
+        reinterpret_cast<char *>(out.data()), static_cast<int>(data.size()),
+        static_cast<int>(out.size()));
+    if (written < 0 || static_cast<usize>(written) != out.size()) {
+      return ResultType::error("LZ4 decompression failed");
+    }
+    return ResultType::ok();
+#else
+    break;
+#endif
+  }
+  }
+
+  return ResultType::error("Unknown compression codec");
+}
+
+struct PackDecompressStream::State {
+  PackCompression codec = PackCompression::None;
+  std::span<u8> out;
+  usize produced = 0;
+  bool ended = false;
+#ifdef NOVELMIND_HAS_ZLIB
+  z_stream zlib{};
+  bool zlibActive = false;
+#endif
+#ifdef NOVELMIND_HAS_ZSTD
+  ZSTD_DStream *zstd = nullptr;
+#endif
+
+  State() = default;
+  State(const State &) = delete;
+  State &operator=(const State &) = delete;
+  ~State() {
+#ifdef NOVELMIND_HAS_ZLIB
+    if (zlibActive) {
+      inflateEnd(&zlib);
+    }
+#endif
+#ifdef NOVELMIND_HAS_ZSTD
+    ZSTD_freeDStream(zstd);
+#endif
+  }
+};
+
+bool PackDecompressStream::supportsStreaming(PackCompression codec) {
+  return codec != PackCompression::Lz4 && PackCompressor::isAvailable(codec);
+}
+
+Result<PackDecompressStream>
+PackDecompressStream::create(PackCompression codec, std::span<u8> out) {
+  using ResultType = Result<PackDecompressStream>;
+
+  if (!supportsStreaming(codec)) {
+    return ResultType::error(std::string("Codec cannot be streamed: ") +
+                             PackCompressor::name(codec));
+  }
+  if (out.size() > MAX_RESOURCE_SIZE) {
+    return ResultType::error("Uncompressed size exceeds limit");
+  }
+
+  auto state = std::make_unique<State>();
+  state->codec = codec;
+  state->out = out;
+
+#ifdef NOVELMIND_HAS_ZLIB
+  if (codec == PackCompression::Zlib) {
+    if (inflateInit(&state->zlib) != Z_OK) {
+      return ResultType::error("Failed to initialise zlib stream");
+    }
+    state->zlibActive = true;
+  }
+#endif
+#ifdef NOVELMIND_HAS_ZSTD
+  if (codec == PackCompression::Zstd) {
+    state->zstd = ZSTD_createDStream();
+    if (!state->zstd || ZSTD_isError(ZSTD_initDStream(state->zstd))) {
+      return ResultType::error("Failed to initialise zstd stream");
+    }
+  }
+#endif
+
+  return ResultType::ok(PackDecompressStream(std::move(state)));
+}
+
+PackDecompressStream::PackDecompressStream(std::unique_ptr<State> state)
+    : m_state(std::move(state)) {}
+
+PackDecompressStream::PackDecompressStream(
+    PackDecompressStream &&other) noexcept = default;
+PackDecompressStream &
+PackDecompressStream::operator=(PackDecompressStream &&other) noexcept =
+    default;
+PackDecompressStream::~PackDecompressStream() = default;
+
+Result<void> PackDecompressStream::write(std::span<const u8> input) {
+  using ResultType = Result<void>;
+  State &state = *m_state;
+
+  if (input.empty()) {
+    return ResultType::ok();
+  }
+  if (state.ended) {
+    return ResultType::error("Data after the end of the compressed stream");
+  }
+
+  switch (state.codec) {
+  case PackCompression::None:
+    if (input.size() > state.out.size() - state.produced) {
+      return ResultType::error("Stored size mismatch");
+    }
+    std::memcpy(state.out.data() + state.produced, input.data(),
+                input.size());
+    state.produced += input.size();
+    return ResultType::ok();
+
+  case PackCompression::Zlib: {
+#ifdef NOVELMIND_HAS_ZLIB
+    // Limits of zlib's 32-bit counters; larger inputs loop
+    constexpr usize kMaxStep = std::numeric_limits<uInt>::max();
+    z_stream &zs = state.zlib;
+    // inflate() rejects a null output pointer even with no room
+    u8 empty = 0;
+    while (!input.empty()) {
+      const usize inStep = std::min(input.size(), kMaxStep);
+      const usize outStep =
+          std::min(state.out.size() - state.produced, kMaxStep);
+      zs.next_in = const_cast<Bytef *>(input.data());
+      zs.avail_in = static_cast<uInt>(inStep);
+      zs.next_out =
+          outStep > 0 ? state.out.data() + state.produced : &empty;
+      zs.avail_out = static_cast<uInt>(outStep);
+
+      const int res = inflate(&zs, Z_NO_FLUSH);
+      const usize consumed = inStep - zs.avail_in;
+      state.produced += outStep - zs.avail_out;
+      input = input.subspan(consumed);
+      if (res == Z_STREAM_END) {
+        state.ended = true;
+        if (!input.empty()) {
+          return ResultType::error(
+              "Data after the end of the compressed stream");
+        }
+        break;
+      }
+      if (res != Z_OK) {
+        // Z_BUF_ERROR here means the output is full but input remains
+        return ResultType::error("zlib decompression failed");
+      }
+    }
+    return ResultType::ok();
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Zstd: {
+#ifdef NOVELMIND_HAS_ZSTD
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    while (in.pos < in.size) {
+      ZSTD_outBuffer out{state.out.data(), state.out.size(), state.produced};
+      const usize before = in.pos;
+      const size_t res = ZSTD_decompressStream(state.zstd, &out, &in);
+      if (ZSTD_isError(res)) {
+        return ResultType::error("zstd decompression failed");
+      }
+      const bool progressed = out.pos != state.produced || in.pos != before;
+      state.produced = out.pos;
+      if (res == 0) {
+        state.ended = true;
+        if (in.pos != in.size) {
+          return ResultType::error(
+              "Data after the end of the compressed stream");
+        }
+        break;
+      }
+      if (!progressed) {
+        return ResultType::error("zstd output exceeds the resource size");
+      }
+    }
+    return ResultType::ok();
+#else
+    break;
+#endif
+  }
+
+  case PackCompression::Lz4:
+    break;
+  }
+
+  return ResultType::error("Codec cannot be streamed");
+}
+
+Result<void> PackDecompressStream::finish() {
+  const State &state = *m_state;
+  const bool ended = state.codec == PackCompression::None || state.ended;
+  if (!ended || state.produced != state.out.size()) {
+    return Result<void>::error(
+        std::string(PackCompressor::name(state.codec)) +
+        " decompression failed");
+  }
+  return Result<void>::ok();
+}
+
+usize PackDecompressStream::produced() const { return m_state->produced; }
+
+} // namespace NovelMind::VFS
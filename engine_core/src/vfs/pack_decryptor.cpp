@@ -3,6 +3,7 @@
 #include "pack_security_detail.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
 #ifdef NOVELMIND_HAS_OPENSSL
@@ -18,98 +19,172 @@ void PackDecryptor::setKey(const u8 *key, usize keySize) {
   m_key.assign(key, key + keySize);
 }
 
-Result<std::vector<u8>> PackDecryptor::decrypt(const u8 *data, usize size,
-                                               const u8 *iv, usize ivSize,
-                                               const u8 *aad,
-                                               usize aadSize) {
-  if (m_key.empty()) {
-    return Result<std::vector<u8>>::error("Decryption key not set");
+static_assert(PackDecryptor::kTagSize == detail::kGcmTagSize);
+
+struct PackDecryptor::Stream::State {
+#ifdef NOVELMIND_HAS_OPENSSL
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+
+  State() = default;
+  State(const State &) = delete;
+  State &operator=(const State &) = delete;
+  ~State() { EVP_CIPHER_CTX_free(ctx); }
+#endif
+};
+
+PackDecryptor::Stream::Stream() : m_state(std::make_unique<State>()) {}
+PackDecryptor::Stream::Stream(Stream &&other) noexcept = default;
+PackDecryptor::Stream &
+PackDecryptor::Stream::operator=(Stream &&other) noexcept = default;
+PackDecryptor::Stream::~Stream() = default;
+
+Result<void> PackDecryptor::Stream::update(const u8 *in, u8 *out,
+                                           usize size) {
+#ifdef NOVELMIND_HAS_OPENSSL
+  // EVP takes int lengths
+  constexpr usize kMaxStep = 1u << 30;
+  while (size > 0) {
+    const usize step = std::min(size, kMaxStep);
+    int outLen = 0;
+    if (EVP_DecryptUpdate(m_state->ctx, out, &outLen, in,
+                          static_cast<int>(step)) != 1 ||
+        static_cast<usize>(outLen) != step) {
+      return Result<void>::error("AES-GCM decryption failed");
+    }
+    in += step;
+    out += step;
+    size -= step;
   }
+  return Result<void>::ok();
+#else
+  (void)in;
+  (void)out;
+  (void)size;
+  return Result<void>::error("OpenSSL not available for decryption");
+#endif
+}
 
+Result<void> PackDecryptor::Stream::finish(const u8 *tag) {
 #ifdef NOVELMIND_HAS_OPENSSL
-  if (!data || size == 0) {
-    return Result<std::vector<u8>>::error("No encrypted data provided");
+  if (EVP_CIPHER_CTX_ctrl(m_state->ctx, EVP_CTRL_GCM_SET_TAG,
+                          static_cast<int>(kTagSize),
+                          const_cast<u8 *>(tag)) != 1) {
+    return Result<void>::error("Failed to set AES-GCM tag");
   }
 
-  if (!iv || ivSize == 0) {
-    return Result<std::vector<u8>>::error("Missing IV for AES-GCM decryption");
+  // GCM is a stream mode, so finalising never writes plaintext
+  u8 unused[16];
+  int finalLen = 0;
+  if (EVP_DecryptFinal_ex(m_state->ctx, unused, &finalLen) != 1) {
+    return Result<void>::error("AES-GCM authentication failed (bad tag)");
   }
+  return Result<void>::ok();
+#else
+  (void)tag;
+  return Result<void>::error("OpenSSL not available for decryption");
+#endif
+}
 
-  if (size <= detail::kGcmTagSize) {
-    return Result<std::vector<u8>>::error("Encrypted payload too small");
+Result<PackDecryptor::Stream>
+PackDecryptor::beginStream(const u8 *iv, usize ivSize, const u8 *aad,
+                           usize aadSize) const {
+  using ResultType = Result<Stream>;
+
+  if (m_key.empty()) {
+    return ResultType::error("Decryption key not set");
   }
 
-  const usize cipherSize = size - detail::kGcmTagSize;
-  const u8 *tag = data + cipherSize;
+#ifdef NOVELMIND_HAS_OPENSSL
+  if (!iv || ivSize == 0) {
+    return ResultType::error("Missing IV for AES-GCM decryption");
+  }
 
-  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  Stream stream;
+  EVP_CIPHER_CTX *ctx = stream.m_state->ctx;
   if (!ctx) {
-    return Result<std::vector<u8>>::error("Failed to create cipher context");
+    return ResultType::error("Failed to create cipher context");
   }
 
-  std::vector<u8> key256(32, 0);
-  std::memcpy(key256.data(), m_key.data(), std::min(m_key.size(), size_t(32)));
+  std::array<u8, 32> key256{};
+  std::memcpy(key256.data(), m_key.data(),
+              std::min(m_key.size(), key256.size()));
 
   if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) !=
       1) {
-    EVP_CIPHER_CTX_free(ctx);
-    return Result<std::vector<u8>>::error("Failed to initialize AES-GCM");
+    return ResultType::error("Failed to initialize AES-GCM");
   }
 
   if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN,
                           static_cast<int>(ivSize), nullptr) != 1) {
-    EVP_CIPHER_CTX_free(ctx);
-    return Result<std::vector<u8>>::error("Failed to set IV length");
+    return ResultType::error("Failed to set IV length");
   }
 
   if (EVP_DecryptInit_ex(ctx, nullptr, nullptr, key256.data(), iv) != 1) {
-    EVP_CIPHER_CTX_free(ctx);
-    return Result<std::vector<u8>>::error("Failed to set AES-GCM key/IV");
+    return ResultType::error("Failed to set AES-GCM key/IV");
   }
 
   int outLen = 0;
   if (aad && aadSize > 0) {
     if (EVP_DecryptUpdate(ctx, nullptr, &outLen, aad,
                           static_cast<int>(aadSize)) != 1) {
-      EVP_CIPHER_CTX_free(ctx);
-      return Result<std::vector<u8>>::error("Failed to add AAD");
+      return ResultType::error("Failed to add AAD");
     }
   }
 
-  std::vector<u8> result(cipherSize);
-  if (EVP_DecryptUpdate(ctx, result.data(), &outLen, data,
-                        static_cast<int>(cipherSize)) != 1) {
-    EVP_CIPHER_CTX_free(ctx);
-    return Result<std::vector<u8>>::error("AES-GCM decryption failed");
+  return ResultType::ok(std::move(stream));
+#else
+  (void)iv;
+  (void)ivSize;
+  (void)aad;
+  (void)aadSize;
+  return ResultType::error("OpenSSL not available for decryption");
+#endif
+}
+
+Result<usize> PackDecryptor::decryptInto(const u8 *data, usize size,
+                                         const u8 *iv, usize ivSize,
+                                         const u8 *aad, usize aadSize,
+                                         u8 *out) const {
+  if (!data || size == 0) {
+    return Result<usize>::error("No encrypted data provided");
+  }
+
+  if (size <= kTagSize) {
+    return Result<usize>::error("Encrypted payload too small");
   }
 
-  if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG,
-                          static_cast<int>(detail::kGcmTagSize),
-                          const_cast<u8 *>(tag)) != 1) {
-    EVP_CIPHER_CTX_free(ctx);
-    return Result<std::vector<u8>>::error("Failed to set AES-GCM tag");
+  auto stream = beginStream(iv, ivSize, aad, aadSize);
+  if (stream.isError()) {
+    return Result<usize>::error(stream.error());
   }
 
-  int finalLen = 0;
-  int finalResult = EVP_DecryptFinal_ex(ctx, result.data() + outLen, &finalLen);
-  EVP_CIPHER_CTX_free(ctx);
+  const usize cipherSize = size - kTagSize;
+  auto result = stream.value().update(data, out, cipherSize);
+  if (result.isError()) {
+    return Result<usize>::error(result.error());
+  }
+  result = stream.value().finish(data + cipherSize);
+  if (result.isError()) {
+    return Result<usize>::error(result.error());
+  }
+  return Result<usize>::ok(cipherSize);
+}
 
-  if (finalResult != 1) {
-    return Result<std::vector<u8>>::error(
-        "AES-GCM authentication failed (bad tag)");
+Result<std::vector<u8>> PackDecryptor::decrypt(const u8 *data, usize size,
+                                               const u8 *iv, usize ivSize,
+                                               const u8 *aad,
+                                               usize aadSize) const {
+  if (m_key.empty()) {
+    return Result<std::vector<u8>>::error("Decryption key not set");
   }
 
-  result.resize(static_cast<usize>(outLen + finalLen));
+  std::vector<u8> result(size > kTagSize ? size - kTagSize : 0);
+  auto written =
+      decryptInto(data, size, iv, ivSize, aad, aadSize, result.data());
+  if (written.isError()) {
+    return Result<std::vector<u8>>::error(written.error());
+  }
   return Result<std::vector<u8>>::ok(std::move(result));
-#else
-  (void)data;
-  (void)size;
-  (void)iv;
-  (void)ivSize;
-  (void)aad;
-  (void)aadSize;
-  return Result<std::vector<u8>>::error("OpenSSL not available for decryption");
-#endif
 }
 
 Result<std::vector<u8>> PackDecryptor::deriveKey(const std::string &password,
@@ -163,4 +238,24 @@ Result<std::vector<u8>> PackDecryptor::generateRandomIV(usize size) {
 #endif
 }
 
+std::vector<u8> PackDecryptor::resourceAad(std::string_view resourceId,
+                                           u32 type, u64 uncompressedSize) {
+  // Sized once and filled in place; this runs on every encrypted read
+  std::vector<u8> aad(resourceId.size() + 1 + sizeof(u32) + sizeof(u64));
+  u8 *out = aad.data();
+  if (!resourceId.empty()) {
+    std::memcpy(out, resourceId.data(), resourceId.size());
+  }
+  out += resourceId.size();
+  *out++ = 0;
+
+  for (usize i = 0; i < sizeof(u32); ++i) {
+    *out++ = static_cast<u8>(type >> (i * 8));
+  }
+  for (usize i = 0; i < sizeof(u64); ++i) {
+    *out++ = static_cast<u8>(uncompressedSize >> (i * 8));
+  }
+  return aad;
+}
+
 } // namespace NovelMind::VFS
@@ -0,0 +1,247 @@
+#include "NovelMind/vfs/pack_delta.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace NovelMind::VFS {
+
+namespace {
+
+enum : u8 { kOpCopy = 0, kOpInsert = 1 };
+
+// Bytes hashed to find match candidates, and the shortest copy worth an op
+constexpr usize kKeySize = 8;
+constexpr usize kMinMatch = 16;
+// Bases up to this size index every position; larger ones use a stride
+constexpr usize kDenseIndexLimit = 4 * 1024 * 1024;
+
+u64 read64(const u8 *p) {
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+template <typename T> void appendValue(std::vector<u8> &out, T value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void appendVarint(std::vector<u8> &out, u64 value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<u8>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<u8>(value));
+}
+
+bool readVarint(std::span<const u8> data, usize &pos, u64 &value) {
+  value = 0;
+  for (u32 shift = 0; shift < 64; shift += 7) {
+    if (pos >= data.size()) {
+      return false;
+    }
+    const u8 byte = data[pos++];
+    value |= static_cast<u64>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+u64 zigzag(i64 value) {
+  return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+}
+
+i64 unzigzag(u64 value) {
+  return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1);
+}
+
+void appendHash(std::vector<u8> &out, const ContentHash &hash) {
+  appendValue(out, hash.low);
+  appendValue(out, hash.high);
+}
+
+ContentHash readHash(const u8 *p) {
+  ContentHash hash;
+  std::memcpy(&hash.low, p, sizeof(hash.low));
+  std::memcpy(&hash.high, p + sizeof(hash.low), sizeof(hash.high));
+  return hash;
+}
+
+} // namespace
+
+std::vector<u8> PackDelta::create(std::span<const u8> base,
+                                  std::span<const u8> target) {
+  std::vector<u8> delta;
+  delta.reserve(kHeaderSize + target.size() / 8);
+  appendValue(delta, kMagic);
+  appendValue(delta, kVersion);
+  appendHash(delta, ContentHasher::hash(base));
+  appendHash(delta, ContentHasher::hash(target));
+  appendValue(delta, static_cast<u64>(base.size()));
+  appendValue(delta, static_cast<u64>(target.size()));
+
+  // Hash table of base positions keyed by the bytes that start there
+  const usize stride =
+      std::max<usize>(1, (base.size() + kDenseIndexLimit - 1) /
+                             kDenseIndexLimit);
+  const usize keyCount =
+      base.size() >= kKeySize ? (base.size() - kKeySize) / stride + 1 : 0;
+  const usize tableSize = std::bit_ceil(std::max<usize>(keyCount * 2, 16));
+  const int shift = 64 - std::countr_zero(tableSize);
+  std::vector<u64> table(tableSize, 0); // position + 1, 0 = empty
+  auto slotOf = [shift](const u8 *p) {
+    return static_cast<usize>((read64(p) * 0x9E3779B97F4A7C15ULL) >> shift);
+  };
+  for (usize k = keyCount; k-- > 0;) {
+    // Walk backwards so the earliest position of a repeated key wins
+    table[slotOf(base.data() + k * stride)] = k * stride + 1;
+  }
+
+  u64 lastCopyEnd = 0;
+  usize literalStart = 0;
+  auto flushLiteral = [&](usize end) {
+    if (end > literalStart) {
+      delta.push_back(kOpInsert);
+      appendVarint(delta, end - literalStart);
+      delta.insert(delta.end(),
+                   target.begin() + static_cast<std::ptrdiff_t>(literalStart),
+                   target.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+  };
+
+  usize i = 0;
+  while (keyCount > 0 && i + kKeySize <= target.size()) {
+    const u64 candidate = table[slotOf(target.data() + i)];
+    if (candidate == 0) {
+      ++i;
+      continue;
+    }
+
+    usize from = static_cast<usize>(candidate - 1);
+    usize length = 0;
+    const usize limit = std::min(base.size() - from, target.size() - i);
+    while (length < limit && base[from + length] == target[i + length]) {
+      ++length;
+    }
+    if (length < kMinMatch) {
+      ++i;
+      continue;
+    }
+
+    // Grow the match backwards over bytes not yet emitted
+    usize start = i;
+    while (start > literalStart && from > 0 &&
+           base[from - 1] == target[start - 1]) {
+      --start;
+      --from;
+      ++length;
+    }
+
+    flushLiteral(start);
+    delta.push_back(kOpCopy);
+    appendVarint(delta, zigzag(static_cast<i64>(from) -
+                               static_cast<i64>(lastCopyEnd)));
+    appendVarint(delta, length);
+    lastCopyEnd = from + length;
+    i = start + length;
+    literalStart = i;
+  }
+  flushLiteral(target.size());
+
+  return delta;
+}
+
+Result<PackDeltaHeader> PackDelta::readHeader(std::span<const u8> delta) {
+  if (delta.size() < kHeaderSize) {
+    return Result<PackDeltaHeader>::error("Delta too small");
+  }
+
+  u32 magic = 0;
+  u32 version = 0;
+  std::memcpy(&magic, delta.data(), sizeof(magic));
+  std::memcpy(&version, delta.data() + 4, sizeof(version));
+  if (magic != kMagic) {
+    return Result<PackDeltaHeader>::error("Invalid delta magic");
+  }
+  if (version != kVersion) {
+    return Result<PackDeltaHeader>::error("Unsupported delta version");
+  }
+
+  PackDeltaHeader header;
+  header.baseHash = readHash(delta.data() + 8);
+  header.targetHash = readHash(delta.data() + 24);
+  std::memcpy(&header.baseSize, delta.data() + 40, sizeof(header.baseSize));
+  std::memcpy(&header.targetSize, delta.data() + 48,
+              sizeof(header.targetSize));
+  return Result<PackDeltaHeader>::ok(header);
+}
+
+Result<std::vector<u8>> PackDelta::apply(std::span<const u8> base,
+                                         std::span<const u8> delta) {
+  using ResultType = Result<std::vector<u8>>;
+
+  auto headerResult = readHeader(delta);
+  if (headerResult.isError()) {
+    return ResultType::error(headerResult.error());
+  }
+  const PackDeltaHeader header = headerResult.value();
+
+  if (base.size() != header.baseSize ||
+      ContentHasher::hash(base) != header.baseHash) {
+    return ResultType::error("Delta does not match its base");
+  }
+
+  constexpr u64 kMaxTargetSize = 512ULL * 1024 * 1024;
+  if (header.targetSize > kMaxTargetSize) {
+    return ResultType::error("Delta target exceeds maximum size");
+  }
+
+  std::vector<u8> target;
+  target.reserve(static_cast<usize>(header.targetSize));
+  u64 lastCopyEnd = 0;
+  usize pos = kHeaderSize;
+
+  while (pos < delta.size()) {
+    const u8 op = delta[pos++];
+    if (op == kOpCopy) {
+      u64 encodedOffset = 0;
+      u64 length = 0;
+      if (!readVarint(delta, pos, encodedOffset) ||
+          !readVarint(delta, pos, length)) {
+        return ResultType::error("Truncated delta copy");
+      }
+      const u64 from = lastCopyEnd + static_cast<u64>(unzigzag(encodedOffset));
+      if (from > base.size() || length > base.size() - from ||
+          length > header.targetSize - target.size()) {
+        return ResultType::error("Delta copy out of range");
+      }
+      target.insert(target.end(),
+                    base.begin() + static_cast<std::ptrdiff_t>(from),
+                    base.begin() + static_cast<std::ptrdiff_t>(from + length));
+      lastCopyEnd = from + length;
+    } else if (op == kOpInsert) {
+      u64 length = 0;
+      if (!readVarint(delta, pos, length) || length > delta.size() - pos ||
+          length > header.targetSize - target.size()) {
+        return ResultType::error("Delta insert out of range");
+      }
+      const auto begin = delta.begin() + static_cast<std::ptrdiff_t>(pos);
+      target.insert(target.end(), begin,
+                    begin + static_cast<std::ptrdiff_t>(length));
+      pos += static_cast<usize>(length);
+    } else {
+      return ResultType::error("Invalid delta op");
+    }
+  }
+
+  if (target.size() != header.targetSize ||
+      ContentHasher::hash(target) != header.targetHash) {
+    return ResultType::error("Delta result does not match its target");
+  }
+  return ResultType::ok(std::move(target));
+}
+
+} // namespace NovelMind::VFS
@@ -0,0 +1,286 @@
+#include "NovelMind/vfs/pack_hash_tree.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef NOVELMIND_HAS_OPENSSL
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#endif
+
+namespace NovelMind::VFS {
+
+namespace {
+
+constexpr u8 kNodePrefix = 0x01;
+
+u32 read32(const u8 *p) {
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+u64 read64(const u8 *p) {
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+template <typename T> void appendValue(std::vector<u8> &out, T value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+Sha256Digest hashBytes(std::span<const u8> data) {
+  return PackIntegrityChecker::calculateSha256(data.data(), data.size());
+}
+
+u64 chunksFor(u64 dataSize, u32 chunkSize) {
+  return dataSize / chunkSize + (dataSize % chunkSize != 0 ? 1 : 0);
+}
+
+} // namespace
+
+std::vector<Sha256Digest> PackHashTree::hashChunks(std::span<const u8> data,
+                                                   u32 chunkSize) {
+  std::vector<Sha256Digest> leaves;
+  leaves.reserve(static_cast<usize>(chunksFor(data.size(), chunkSize)));
+  for (usize offset = 0; offset < data.size(); offset += chunkSize) {
+    const usize length = std::min<usize>(chunkSize, data.size() - offset);
+    leaves.push_back(hashBytes(data.subspan(offset, length)));
+  }
+  return leaves;
+}
+
+Sha256Digest PackHashTree::computeRoot(std::span<const Sha256Digest> leaves) {
+  if (leaves.empty()) {
+    return hashBytes({});
+  }
+
+  std::vector<Sha256Digest> level(leaves.begin(), leaves.end());
+  std::array<u8, 1 + 2 * sizeof(Sha256Digest)> node{};
+  node[0] = kNodePrefix;
+  while (level.size() > 1) {
+    usize out = 0;
+    for (usize i = 0; i < level.size(); i += 2) {
+      if (i + 1 == level.size()) {
+        level[out++] = level[i];
+        continue;
+      }
+      std::memcpy(node.data() + 1, level[i].data(), sizeof(Sha256Digest));
+      std::memcpy(node.data() + 1 + sizeof(Sha256Digest), level[i + 1].data(),
+                  sizeof(Sha256Digest));
+      level[out++] = hashBytes(node);
+    }
+    level.resize(out);
+  }
+  return level.front();
+}
+
+std::vector<u8> PackHashTree::buildSection(
+    u64 dataOffset, u64 dataSize, u32 chunkSize,
+    const Sha256Digest &tablesHash, std::span<const Sha256Digest> leaves) {
+  std::vector<u8> section;
+  section.reserve(kHeaderSize + leaves.size() * sizeof(Sha256Digest) + 512);
+  appendValue(section, kMagic);
+  appendValue(section, kVersion);
+  appendValue(section, chunkSize);
+  appendValue(section, u32{0});
+  appendValue(section, dataOffset);
+  appendValue(section, dataSize);
+  section.insert(section.end(), tablesHash.begin(), tablesHash.end());
+  const Sha256Digest root = computeRoot(leaves);
+  section.insert(section.end(), root.begin(), root.end());
+  for (const auto &leaf : leaves) {
+    section.insert(section.end(), leaf.begin(), leaf.end());
+  }
+  return section;
+}
+
+Result<void> PackHashTree::sign(std::vector<u8> &section,
+                                const std::string &privateKeyPem) {
+  if (section.size() < kHeaderSize) {
+    return Result<void>::error("Hash tree section too small to sign");
+  }
+
+#ifdef NOVELMIND_HAS_OPENSSL
+  BIO *bio = BIO_new_mem_buf(privateKeyPem.data(),
+                             static_cast<int>(privateKeyPem.size()));
+  if (!bio) {
+    return Result<void>::error("Failed to allocate BIO for private key");
+  }
+  EVP_PKEY *key = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+  BIO_free(bio);
+  if (!key) {
+    return Result<void>::error("Failed to parse private key PEM");
+  }
+
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  size_t signatureSize = 0;
+  bool ok = ctx && EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr,
+                                      key) == 1 &&
+            EVP_DigestSign(ctx, nullptr, &signatureSize, section.data(),
+                           kHeaderSize) == 1;
+  std::vector<u8> signature(signatureSize);
+  ok = ok && EVP_DigestSign(ctx, signature.data(), &signatureSize,
+                            section.data(), kHeaderSize) == 1;
+  EVP_MD_CTX_free(ctx);
+  EVP_PKEY_free(key);
+  if (!ok) {
+    ERR_clear_error();
+    return Result<void>::error("Failed to sign hash tree");
+  }
+
+  signature.resize(signatureSize);
+  appendValue(section, static_cast<u32>(signature.size()));
+  section.insert(section.end(), signature.begin(), signature.end());
+  return Result<void>::ok();
+#else
+  (void)privateKeyPem;
+  return Result<void>::error("OpenSSL not available for pack signing");
+#endif
+}
+
+Result<PackHashTree> PackHashTree::parse(std::span<const u8> section) {
+  using ResultType = Result<PackHashTree>;
+
+  if (section.size() < kHeaderSize + sizeof(u32)) {
+    return ResultType::error("Hash tree section too small");
+  }
+
+  const u8 *p = section.data();
+  if (read32(p) != kMagic || read32(p + 4) != kVersion) {
+    return ResultType::error("Invalid hash tree header");
+  }
+
+  PackHashTree tree;
+  std::memcpy(tree.m_header.data(), p, kHeaderSize);
+  tree.m_chunkSize = read32(p + 8);
+  tree.m_dataOffset = read64(p + 16);
+  tree.m_dataSize = read64(p + 24);
+  std::memcpy(tree.m_tablesHash.data(), p + 32, sizeof(Sha256Digest));
+  std::memcpy(tree.m_root.data(), p + 64, sizeof(Sha256Digest));
+
+  if (tree.m_chunkSize < kMinChunkSize || tree.m_chunkSize > kMaxChunkSize) {
+    return ResultType::error("Invalid hash tree chunk size");
+  }
+
+  const u64 chunkCount = chunksFor(tree.m_dataSize, tree.m_chunkSize);
+  if (chunkCount > section.size() / sizeof(Sha256Digest)) {
+    return ResultType::error("Hash tree leaves out of bounds");
+  }
+  const u64 leavesSize = chunkCount * sizeof(Sha256Digest);
+  if (leavesSize > section.size() - kHeaderSize - sizeof(u32)) {
+    return ResultType::error("Hash tree leaves out of bounds");
+  }
+
+  const u8 *leaves = p + kHeaderSize;
+  tree.m_leaves.resize(static_cast<usize>(chunkCount));
+  if (chunkCount > 0) {
+    std::memcpy(tree.m_leaves.data(), leaves, static_cast<usize>(leavesSize));
+  }
+  if (computeRoot(tree.m_leaves) != tree.m_root) {
+    return ResultType::error("Hash tree leaves do not match the root");
+  }
+
+  const usize signatureStart =
+      kHeaderSize + static_cast<usize>(leavesSize) + sizeof(u32);
+  const u32 signatureSize = read32(leaves + leavesSize);
+  if (signatureSize == 0 || signatureSize != section.size() - signatureStart) {
+    return ResultType::error("Invalid hash tree signature size");
+  }
+  tree.m_signature.assign(section.begin() +
+                              static_cast<std::ptrdiff_t>(signatureStart),
+                          section.end());
+  return ResultType::ok(std::move(tree));
+}
+
+PackChunkVerifier::PackChunkVerifier(PackHashTree tree,
+                                     std::shared_ptr<const MappedFile> mapping,
+                                     std::shared_ptr<const PositionalFile> file)
+    : m_tree(std::move(tree)), m_mapping(std::move(mapping)),
+      m_file(std::move(file)),
+      m_states(std::make_unique<std::atomic<u8>[]>(m_tree.chunkCount())) {}
+
+Result<void> PackChunkVerifier::verifyRange(u64 offset, u64 size) {
+  if (size == 0) {
+    return Result<void>::ok();
+  }
+
+  const u64 dataStart = m_tree.dataOffset();
+  if (offset < dataStart || offset - dataStart > m_tree.dataSize() ||
+      size > m_tree.dataSize() - (offset - dataStart)) {
+    return Result<void>::error("Read outside the signed data section");
+  }
+
+  const u64 first = (offset - dataStart) / m_tree.chunkSize();
+  const u64 last = (offset - dataStart + size - 1) / m_tree.chunkSize();
+  for (u64 index = first; index <= last; ++index) {
+    auto result = verifyChunk(static_cast<u32>(index));
+    if (result.isError()) {
+      return result;
+    }
+  }
+  return Result<void>::ok();
+}
+
+Result<void> PackChunkVerifier::verifyAll(const std::atomic<bool> *stop) {
+  for (u32 index = 0; index < m_tree.chunkCount(); ++index) {
+    if (stop && stop->load(std::memory_order_relaxed)) {
+      break;
+    }
+    auto result = verifyChunk(index);
+    if (result.isError()) {
+      return result;
+    }
+  }
+  return Result<void>::ok();
+}
+
+Result<void> PackChunkVerifier::verifyChunk(u32 index) {
+  const u8 state = m_states[index].load(std::memory_order_acquire);
+  if (state == kVerified) {
+    return Result<void>::ok();
+  }
+  if (state == kFailed) {
+    return Result<void>::error("Pack chunk " + std::to_string(index) +
+                               " failed verification");
+  }
+
+  const u64 begin = static_cast<u64>(index) * m_tree.chunkSize();
+  const usize length = static_cast<usize>(
+      std::min<u64>(m_tree.chunkSize(), m_tree.dataSize() - begin));
+  const u64 offset = m_tree.dataOffset() + begin;
+
+  Sha256Digest digest{};
+  bool readOk = true;
+  if (m_mapping) {
+    const auto bytes = m_mapping->bytes(offset, length);
+    readOk = bytes.size() == length;
+    digest = hashBytes(bytes);
+  } else {
+    std::vector<u8> buffer(length);
+    readOk = m_file && m_file->readAt(offset, buffer.data(), length).isOk();
+    digest = hashBytes(buffer);
+  }
+
+  if (!readOk || digest != m_tree.leaf(index)) {
+    m_states[index].store(kFailed, std::memory_order_release);
+    m_failed.store(true, std::memory_order_relaxed);
+    return Result<void>::error("Pack chunk " + std::to_string(index) +
+                               " failed verification");
+  }
+
+  u8 expected = kUnverified;
+  if (m_states[index].compare_exchange_strong(expected, kVerified,
+                                              std::memory_order_acq_rel)) {
+    m_verified.fetch_add(1, std::memory_order_relaxed);
+  }
+  return Result<void>::ok();
+}
+
+} // namespace NovelMind::VFS
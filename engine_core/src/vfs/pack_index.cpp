@@ -0,0 +1,237 @@
+#include "NovelMind/vfs/pack_index.hpp"
+#include "NovelMind/vfs/content_hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace NovelMind::VFS {
+
+namespace {
+
+// Average bucket size; smaller buckets are quicker to place but cost more
+// pilot storage (4 bytes per bucket)
+constexpr u32 kKeysPerBucket = 3;
+// Pilots tried per bucket before starting over with another seed
+constexpr u32 kMaxPilot = 1u << 20;
+constexpr u32 kMaxSeedAttempts = 16;
+constexpr u32 kFreeSlot = std::numeric_limits<u32>::max();
+
+u64 mix64(u64 value) {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31;
+  return value;
+}
+
+u64 hashId(std::string_view id, u64 seed) {
+  return ContentHasher::hash(
+             {reinterpret_cast<const u8 *>(id.data()), id.size()}, seed)
+      .low;
+}
+
+u32 read32(const u8 *p) {
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+u64 read64(const u8 *p) {
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+template <typename T> void appendValue(std::vector<u8> &out, T value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+u32 PackHashIndex::bucketFor(u64 hash) const {
+  return static_cast<u32>(((hash >> 32) * m_bucketCount) >> 32);
+}
+
+u32 PackHashIndex::slotFor(u64 hash, u32 pilot) const {
+  const u64 mixed =
+      mix64(hash ^ (m_seed + static_cast<u64>(pilot) * 0x9E3779B97F4A7C15ULL));
+  return static_cast<u32>(((mixed & 0xFFFFFFFFULL) * m_entryCount) >> 32);
+}
+
+Result<std::vector<u8>>
+PackHashIndex::build(std::span<const std::string_view> ids) {
+  using ResultType = Result<std::vector<u8>>;
+
+  if (ids.size() >= std::numeric_limits<u32>::max()) {
+    return ResultType::error("Too many resources for a pack index");
+  }
+
+  std::unordered_set<std::string_view> seen;
+  seen.reserve(ids.size());
+  for (const auto id : ids) {
+    if (!seen.insert(id).second) {
+      return ResultType::error("Duplicate resource id: " + std::string(id));
+    }
+  }
+
+  const auto count = static_cast<u32>(ids.size());
+  std::vector<u64> hashes(count);
+  std::vector<std::pair<u32, u32>> byBucket(count); // (bucket, key)
+  std::vector<u32> slots;
+  std::vector<u32> pilots;
+
+  for (u32 attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+    PackHashIndex index;
+    // Derived from the attempt number so identical inputs give identical packs
+    index.m_seed = mix64(attempt + 1);
+    index.m_entryCount = count;
+    index.m_bucketCount = std::max(1u, (count + kKeysPerBucket - 1) /
+                                           kKeysPerBucket);
+
+    for (u32 i = 0; i < count; ++i) {
+      hashes[i] = hashId(ids[i], index.m_seed);
+      byBucket[i] = {index.bucketFor(hashes[i]), i};
+    }
+    std::sort(byBucket.begin(), byBucket.end());
+
+    // Group keys per bucket, then place the largest buckets first while the
+    // table is still mostly empty
+    std::vector<std::pair<u32, u32>> groups; // (start, size) in byBucket
+    for (u32 start = 0; start < count;) {
+      u32 end = start + 1;
+      while (end < count && byBucket[end].first == byBucket[start].first) {
+        ++end;
+      }
+      groups.emplace_back(start, end - start);
+      start = end;
+    }
+    std::stable_sort(groups.begin(), groups.end(),
+                     [](const auto &a, const auto &b) {
+                       return a.second > b.second;
+                     });
+
+    slots.assign(count, kFreeSlot);
+    pilots.assign(index.m_bucketCount, 0);
+    std::vector<u32> candidate;
+    bool placed = true;
+
+    for (const auto &[start, size] : groups) {
+      bool found = false;
+      for (u32 pilot = 0; pilot < kMaxPilot && !found; ++pilot) {
+        candidate.clear();
+        found = true;
+        for (u32 k = start; k < start + size; ++k) {
+          const u32 slot = index.slotFor(hashes[byBucket[k].second], pilot);
+          if (slots[slot] != kFreeSlot ||
+              std::find(candidate.begin(), candidate.end(), slot) !=
+                  candidate.end()) {
+            found = false;
+            break;
+          }
+          candidate.push_back(slot);
+        }
+        if (found) {
+          for (u32 k = 0; k < size; ++k) {
+            slots[candidate[k]] = byBucket[start + k].second;
+          }
+          pilots[byBucket[start].first] = pilot;
+        }
+      }
+      if (!found) {
+        placed = false;
+        break;
+      }
+    }
+
+    if (!placed) {
+      continue;
+    }
+
+    std::vector<u8> section;
+    section.reserve(kHeaderSize + pilots.size() * sizeof(u32) +
+                    slots.size() * sizeof(u32) + kTrailerSize);
+    appendValue(section, kMagic);
+    appendValue(section, kVersion);
+    appendValue(section, count);
+    appendValue(section, index.m_bucketCount);
+    appendValue(section, index.m_seed);
+    for (u32 pilot : pilots) {
+      appendValue(section, pilot);
+    }
+    for (u32 slot : slots) {
+      appendValue(section, slot);
+    }
+    appendValue(section, static_cast<u32>(section.size() + kTrailerSize));
+    appendValue(section, kMagic);
+    return ResultType::ok(std::move(section));
+  }
+
+  return ResultType::error("Failed to build pack index");
+}
+
+Result<PackHashIndex> PackHashIndex::open(std::span<const u8> tables,
+                                          u32 entryCount) {
+  using ResultType = Result<PackHashIndex>;
+
+  if (tables.size() < kHeaderSize + kTrailerSize) {
+    return ResultType::error("Pack index missing");
+  }
+
+  const u8 *trailer = tables.data() + tables.size() - kTrailerSize;
+  const u32 sectionSize = read32(trailer);
+  if (read32(trailer + sizeof(u32)) != kMagic ||
+      sectionSize < kHeaderSize + kTrailerSize ||
+      sectionSize > tables.size()) {
+    return ResultType::error("Invalid pack index trailer");
+  }
+
+  const u8 *section = tables.data() + tables.size() - sectionSize;
+  PackHashIndex index;
+  index.m_entryCount = read32(section + 8);
+  index.m_bucketCount = read32(section + 12);
+  index.m_seed = read64(section + 16);
+  index.m_sectionSize = sectionSize;
+
+  if (read32(section) != kMagic || read32(section + 4) != kVersion) {
+    return ResultType::error("Invalid pack index header");
+  }
+  if (index.m_entryCount != entryCount ||
+      (entryCount > 0 && index.m_bucketCount == 0)) {
+    return ResultType::error("Pack index does not match resource table");
+  }
+
+  const u64 expectedSize = kHeaderSize +
+                           static_cast<u64>(index.m_bucketCount) * sizeof(u32) +
+                           static_cast<u64>(entryCount) * sizeof(u32) +
+                           kTrailerSize;
+  if (expectedSize != sectionSize) {
+    return ResultType::error("Pack index size mismatch");
+  }
+
+  index.m_pilots = section + kHeaderSize;
+  index.m_slots = index.m_pilots +
+                  static_cast<usize>(index.m_bucketCount) * sizeof(u32);
+  return ResultType::ok(index);
+}
+
+std::optional<u32> PackHashIndex::find(std::string_view id) const {
+  if (m_entryCount == 0) {
+    return std::nullopt;
+  }
+
+  const u64 hash = hashId(id, m_seed);
+  const u32 pilot = read32(m_pilots + bucketFor(hash) * sizeof(u32));
+  const u32 entry = read32(m_slots + slotFor(hash, pilot) * sizeof(u32));
+  if (entry >= m_entryCount) {
+    return std::nullopt;
+  }
+  return entry;
+}
+
+} // namespace NovelMind::VFS
@@ -1,4 +1,5 @@
 #include "NovelMind/vfs/pack_security.hpp"
+#include "NovelMind/vfs/crc32.hpp"
 
 #include "pack_security_detail.hpp"
 
@@ -154,20 +155,70 @@ PackIntegrityChecker::verifyResourceTable(const u8 *data, usize size,
     return Result<PackVerificationReport>::ok(report);
   }
 
+  // Deduplicated packs point several entries at one payload. Such entries
+  // must describe it identically; any other overlap is corruption.
+  struct Span {
+    u64 offset;
+    u64 storedSize;
+    u64 uncompressedSize;
+    u32 flags;
+    u32 checksum;
+    usize entryOffset;
+    u32 index;
+  };
+  std::vector<Span> spans;
+  spans.reserve(resourceCount);
+
   for (u32 i = 0; i < resourceCount; ++i) {
     const usize entryOffset =
         tableOffset + (i * detail::kResourceEntrySize);
 
-    u64 dataOffset;
-    std::memcpy(&dataOffset, data + entryOffset + 8, sizeof(dataOffset));
-
-    if (dataOffset >= size) {
+    Span span{};
+    std::memcpy(&span.offset, data + entryOffset + 8, sizeof(span.offset));
+    std::memcpy(&span.storedSize, data + entryOffset + 16,
+                sizeof(span.storedSize));
+    std::memcpy(&span.uncompressedSize, data + entryOffset + 24,
+                sizeof(span.uncompressedSize));
+    std::memcpy(&span.flags, data + entryOffset + 32, sizeof(span.flags));
+    std::memcpy(&span.checksum, data + entryOffset + 36,
+                sizeof(span.checksum));
+    span.entryOffset = entryOffset;
+    span.index = i;
+
+    if (span.offset >= size) {
       report.result = PackVerificationResult::CorruptedResourceTable;
       report.message =
           "Invalid resource data offset in entry " + std::to_string(i);
       report.errorOffset = static_cast<u32>(entryOffset);
       return Result<PackVerificationReport>::ok(report);
     }
+    spans.push_back(span);
+  }
+
+  std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+    return a.offset < b.offset;
+  });
+  const Span *furthest = nullptr;
+  for (const Span &span : spans) {
+    if (furthest && span.offset < furthest->offset + furthest->storedSize) {
+      const bool shared = span.offset == furthest->offset &&
+                          span.storedSize == furthest->storedSize &&
+                          span.uncompressedSize == furthest->uncompressedSize &&
+                          span.flags == furthest->flags &&
+                          span.checksum == furthest->checksum;
+      if (!shared) {
+        report.result = PackVerificationResult::CorruptedResourceTable;
+        report.message = "Resource data of entry " +
+                         std::to_string(span.index) +
+                         " overlaps entry " + std::to_string(furthest->index);
+        report.errorOffset = static_cast<u32>(span.entryOffset);
+        return Result<PackVerificationReport>::ok(report);
+      }
+    }
+    if (!furthest ||
+        span.offset + span.storedSize > furthest->offset + furthest->storedSize) {
+      furthest = &span;
+    }
   }
 
   report.result = PackVerificationResult::Valid;
@@ -369,8 +420,7 @@ PackIntegrityChecker::verifyPackSignatureStream(std::istream &stream,
 }
 
 u32 PackIntegrityChecker::calculateCrc32(const u8 *data, usize size) {
-  u32 crc = detail::updateCrc32(0xFFFFFFFF, data, size);
-  return ~crc;
+  return Crc32::compute(data, size);
 }
 
 std::array<u8, 32> PackIntegrityChecker::calculateSha256(const u8 *data,
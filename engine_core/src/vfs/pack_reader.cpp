@@ -1,78 +1,185 @@
 #include "NovelMind/vfs/pack_reader.hpp"
 #include "NovelMind/core/logger.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 
 namespace NovelMind::vfs {
 
-PackReader::~PackReader() { unmountAll(); }
+namespace {
+// Security: Limits to prevent excessive allocations from corrupted packs
+constexpr u32 MAX_RESOURCE_COUNT = 1000000;              // 1 million resources max
+constexpr u32 MAX_STRING_COUNT = 10000000;               // 10 million strings max
+constexpr usize MAX_STRING_LENGTH = 1024 * 1024;         // 1 MB per string max
+constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024; // 512 MB max per resource
+} // namespace
 
-Result<void> PackReader::mount(const std::string &packPath) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+PackReader::PackReader(PackAccessMode mode)
+    : m_accessMode(mode), m_packs(std::make_shared<const PackList>()) {}
 
-  if (m_packs.find(packPath) != m_packs.end()) {
-    return Result<void>::error("Pack already mounted: " + packPath);
-  }
-
-  std::ifstream file(packPath, std::ios::binary);
-  if (!file.is_open()) {
-    return Result<void>::error("Failed to open pack file: " + packPath);
-  }
+PackReader::~PackReader() { unmountAll(); }
 
-  MountedPack pack;
-  pack.path = packPath;
+Result<void> PackReader::mount(const std::string &packPath) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
 
-  auto headerResult = readPackHeader(file, pack.header);
-  if (headerResult.isError()) {
-    return headerResult;
+  const auto current = m_packs.load(std::memory_order_acquire);
+  for (const auto &pack : *current) {
+    if (pack->path == packPath) {
+      return Result<void>::error("Pack already mounted: " + packPath);
+    }
   }
 
-  auto tableResult = readResourceTable(file, pack);
-  if (tableResult.isError()) {
-    return tableResult;
+  auto pack = std::make_shared<MountedPack>();
+  pack->path = packPath;
+
+  if (m_accessMode == PackAccessMode::MemoryMapped) {
+    auto mapResult = VFS::MappedFile::open(packPath);
+    if (mapResult.isOk()) {
+      pack->mapping = std::move(mapResult).value();
+      pack->fileSize = pack->mapping->size();
+      auto parseResult = parsePackTables(
+          *pack, {pack->mapping->data(), pack->mapping->size()});
+      if (parseResult.isError()) {
+        return parseResult;
+      }
+    } else {
+      NOVELMIND_LOG_WARN("Memory mapping unavailable, streaming pack: " +
+                         mapResult.error());
+    }
   }
 
-  auto stringResult = readStringTable(file, pack);
-  if (stringResult.isError()) {
-    return stringResult;
+  if (!pack->mapping) {
+    auto openResult = openStreamedPack(*pack);
+    if (openResult.isError()) {
+      return openResult;
+    }
   }
 
-  m_packs[packPath] = std::move(pack);
+  auto next = std::make_shared<PackList>(*current);
+  next->push_back(std::move(pack));
+  m_packs.store(std::move(next), std::memory_order_release);
   NOVELMIND_LOG_INFO("Mounted pack: " + packPath);
 
   return Result<void>::ok();
 }
 
 void PackReader::unmount(const std::string &packPath) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_packs.erase(packPath);
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+
+  const auto current = m_packs.load(std::memory_order_acquire);
+  auto next = std::make_shared<PackList>();
+  next->reserve(current->size());
+  for (const auto &pack : *current) {
+    if (pack->path != packPath) {
+      next->push_back(pack);
+    }
+  }
+
+  m_packs.store(std::move(next), std::memory_order_release);
   NOVELMIND_LOG_INFO("Unmounted pack: " + packPath);
 }
 
 void PackReader::unmountAll() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_packs.clear();
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  m_packs.store(std::make_shared<const PackList>(), std::memory_order_release);
   NOVELMIND_LOG_INFO("Unmounted all packs");
 }
 
 Result<std::vector<u8>>
 PackReader::readFile(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto packs = m_packs.load(std::memory_order_acquire);
 
-  for (const auto &[packPath, pack] : m_packs) {
-    auto it = pack.entries.find(resourceId);
-    if (it != pack.entries.end()) {
-      return readResourceData(packPath, it->second);
+  for (const auto &pack : *packs) {
+    const auto *entry = findEntry(*pack, resourceId);
+    if (!entry) {
+      continue;
     }
+
+    return readEntry(pack, *entry);
   }
 
   return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
 }
 
+Result<VFS::ResourceView>
+PackReader::readFileView(const std::string &resourceId) const {
+  const auto packs = m_packs.load(std::memory_order_acquire);
+
+  for (const auto &pack : *packs) {
+    const auto *entry = findEntry(*pack, resourceId);
+    if (!entry) {
+      continue;
+    }
+
+    if (!pack->mapping || isChunked(*pack, *entry)) {
+      auto dataResult = readEntry(pack, *entry);
+      if (dataResult.isError()) {
+        return Result<VFS::ResourceView>::error(dataResult.error());
+      }
+      return Result<VFS::ResourceView>::ok(
+          VFS::ResourceView::fromBuffer(std::move(dataResult).value()));
+    }
+
+    auto bytesResult = mappedResourceBytes(*pack, *entry);
+    if (bytesResult.isError()) {
+      return Result<VFS::ResourceView>::error(bytesResult.error());
+    }
+
+    if (resourceCodec(*pack, *entry) != VFS::PackCompression::None) {
+      auto decoded = decodeResourceData(*pack, *entry, bytesResult.value());
+      if (decoded.isError()) {
+        return Result<VFS::ResourceView>::error(decoded.error());
+      }
+      return Result<VFS::ResourceView>::ok(
+          VFS::ResourceView::fromBuffer(std::move(decoded).value()));
+    }
+
+    return Result<VFS::ResourceView>::ok(
+        VFS::ResourceView(pack->mapping, bytesResult.value()));
+  }
+
+  return Result<VFS::ResourceView>::error("Resource not found: " + resourceId);
+}
+
+Result<std::unique_ptr<VFS::IFileHandle>>
+PackReader::openStream(const std::string &resourceId) const {
+  using ResultType = Result<std::unique_ptr<VFS::IFileHandle>>;
+  const auto packs = m_packs.load(std::memory_order_acquire);
+
+  for (const auto &pack : *packs) {
+    const auto *entry = findEntry(*pack, resourceId);
+    if (!entry) {
+      continue;
+    }
+
+    if (isChunked(*pack, *entry)) {
+      auto stream = openChunkedStream(pack, *entry);
+      if (stream.isError()) {
+        return ResultType::error(stream.error());
+      }
+      return ResultType::ok(std::move(stream).value());
+    }
+    break;
+  }
+
+  return IVirtualFileSystem::openStream(resourceId);
+}
+
+bool PackReader::isMemoryMapped(const std::string &packPath) const {
+  const auto packs = m_packs.load(std::memory_order_acquire);
+  for (const auto &pack : *packs) {
+    if (pack->path == packPath) {
+      return pack->mapping != nullptr;
+    }
+  }
+  return false;
+}
+
 bool PackReader::exists(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto packs = m_packs.load(std::memory_order_acquire);
 
-  for (const auto &[packPath, pack] : m_packs) {
-    if (pack.entries.find(resourceId) != pack.entries.end()) {
+  for (const auto &pack : *packs) {
+    if (findEntry(*pack, resourceId)) {
       return true;
     }
   }
@@ -82,16 +189,15 @@ bool PackReader::exists(const std::string &resourceId) const {
 
 std::optional<ResourceInfo>
 PackReader::getInfo(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto packs = m_packs.load(std::memory_order_acquire);
 
-  for (const auto &[packPath, pack] : m_packs) {
-    auto it = pack.entries.find(resourceId);
-    if (it != pack.entries.end()) {
+  for (const auto &pack : *packs) {
+    if (const auto *entry = findEntry(*pack, resourceId)) {
       ResourceInfo info;
       info.id = resourceId;
-      info.type = static_cast<ResourceType>(it->second.type);
-      info.size = static_cast<usize>(it->second.uncompressedSize);
-      info.checksum = it->second.checksum;
+      info.type = static_cast<ResourceType>(entry->type);
+      info.size = static_cast<usize>(entry->uncompressedSize);
+      info.checksum = entry->checksum;
       return info;
     }
   }
@@ -100,15 +206,29 @@ PackReader::getInfo(const std::string &resourceId) const {
 }
 
 std::vector<std::string> PackReader::listResources(ResourceType type) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto packs = m_packs.load(std::memory_order_acquire);
 
   std::vector<std::string> result;
 
-  for (const auto &[packPath, pack] : m_packs) {
-    for (const auto &[id, entry] : pack.entries) {
-      if (type == ResourceType::Unknown ||
-          static_cast<ResourceType>(entry.type) == type) {
-        result.push_back(id);
+  auto matches = [type](const PackResourceEntry &entry) {
+    return type == ResourceType::Unknown ||
+           static_cast<ResourceType>(entry.type) == type;
+  };
+
+  for (const auto &pack : *packs) {
+    if (!pack->index) {
+      for (const auto &[id, entry] : pack->entries) {
+        if (matches(*entry)) {
+          result.emplace_back(id);
+        }
+      }
+      continue;
+    }
+
+    for (u32 i = 0; i < pack->header.resourceCount; ++i) {
+      const auto id = entryId(*pack, pack->table[i]);
+      if (id && matches(pack->table[i])) {
+        result.emplace_back(*id);
       }
     }
   }
@@ -116,14 +236,7 @@ std::vector<std::string> PackReader::listResources(ResourceType type) const {
   return result;
 }
 
-Result<void> PackReader::readPackHeader(std::ifstream &file,
-                                        PackHeader &header) {
-  file.read(reinterpret_cast<char *>(&header), sizeof(PackHeader));
-
-  if (!file) {
-    return Result<void>::error("Failed to read pack header");
-  }
-
+Result<void> PackReader::validateHeader(const PackHeader &header) {
   if (header.magic != PACK_MAGIC) {
     return Result<void>::error("Invalid pack magic number");
   }
@@ -132,13 +245,15 @@ Result<void> PackReader::readPackHeader(std::ifstream &file,
     return Result<void>::error("Incompatible pack version");
   }
 
-  if (header.flags != 0) {
+  // Per-resource codecs are decoded here; anything else needs the secure
+  // reader (encryption, signatures, pack-wide compression)
+  constexpr u32 supportedFlags = static_cast<u32>(PackFlags::ResourceCodecs) |
+                                 static_cast<u32>(PackFlags::HashIndex);
+  if ((header.flags & ~supportedFlags) != 0) {
     return Result<void>::error(
         "Secure pack flags set; use SecurePackReader instead of PackReader");
   }
 
-  // Security: Validate resource count to prevent excessive allocations
-  constexpr u32 MAX_RESOURCE_COUNT = 1000000; // 1 million resources max
   if (header.resourceCount > MAX_RESOURCE_COUNT) {
     return Result<void>::error("Resource count exceeds maximum allowed");
   }
@@ -146,147 +261,322 @@ Result<void> PackReader::readPackHeader(std::ifstream &file,
   return Result<void>::ok();
 }
 
-Result<void> PackReader::readResourceTable(std::ifstream &file,
-                                           MountedPack &pack) {
-  file.seekg(static_cast<std::streamoff>(pack.header.resourceTableOffset));
+Result<void> PackReader::openStreamedPack(MountedPack &pack) {
+  auto openResult = VFS::PositionalFile::open(pack.path);
+  if (openResult.isError()) {
+    return Result<void>::error("Failed to open pack file: " + pack.path);
+  }
+  pack.file = std::move(openResult).value();
+  pack.fileSize = pack.file->size();
 
-  if (!file) {
-    return Result<void>::error("Failed to seek to resource table");
+  PackHeader header{};
+  if (pack.file->readAt(0, reinterpret_cast<u8 *>(&header), sizeof(header))
+          .isError()) {
+    return Result<void>::error("Failed to read pack header");
   }
 
-  for (u32 i = 0; i < pack.header.resourceCount; ++i) {
-    PackResourceEntry entry;
-    file.read(reinterpret_cast<char *>(&entry), sizeof(PackResourceEntry));
+  auto headerResult = validateHeader(header);
+  if (headerResult.isError()) {
+    return headerResult;
+  }
 
-    if (!file) {
-      return Result<void>::error("Failed to read resource entry");
-    }
+  // Header and tables precede the data section; load them with one read
+  if (header.dataOffset < sizeof(PackHeader) ||
+      header.dataOffset > pack.fileSize) {
+    return Result<void>::error("Invalid pack data offset");
+  }
 
-    // Entry ID will be resolved after reading string table
-    pack.entries[std::to_string(i)] = entry;
+  pack.tableStorage.resize(static_cast<usize>(header.dataOffset));
+  if (pack.file
+          ->readAt(0, pack.tableStorage.data(), pack.tableStorage.size())
+          .isError()) {
+    return Result<void>::error("Failed to read resource table");
   }
 
-  return Result<void>::ok();
+  return parsePackTables(pack, pack.tableStorage);
 }
 
-Result<void> PackReader::readStringTable(std::ifstream &file,
-                                         MountedPack &pack) {
-  file.seekg(static_cast<std::streamoff>(pack.header.stringTableOffset));
+Result<void> PackReader::parsePackTables(MountedPack &pack,
+                                         std::span<const u8> bytes) {
+  if (bytes.size() < sizeof(PackHeader)) {
+    return Result<void>::error("Failed to read pack header");
+  }
+  std::memcpy(&pack.header, bytes.data(), sizeof(PackHeader));
+
+  auto headerResult = validateHeader(pack.header);
+  if (headerResult.isError()) {
+    return headerResult;
+  }
 
-  if (!file) {
-    return Result<void>::error("Failed to seek to string table");
+  auto subspan = [&bytes](u64 offset, u64 length) -> std::span<const u8> {
+    if (offset > bytes.size() || length > bytes.size() - offset) {
+      return {};
+    }
+    return bytes.subspan(static_cast<usize>(offset),
+                         static_cast<usize>(length));
+  };
+
+  // Resource table: used in place when suitably aligned
+  const u64 tableSize =
+      static_cast<u64>(pack.header.resourceCount) * sizeof(PackResourceEntry);
+  const auto table = subspan(pack.header.resourceTableOffset, tableSize);
+  if (table.size() != tableSize) {
+    return Result<void>::error("Failed to read resource entry");
   }
 
-  u32 stringCount = 0;
-  file.read(reinterpret_cast<char *>(&stringCount), sizeof(u32));
+  const PackResourceEntry *entries = nullptr;
+  if (reinterpret_cast<std::uintptr_t>(table.data()) %
+          alignof(PackResourceEntry) ==
+      0) {
+    entries = reinterpret_cast<const PackResourceEntry *>(table.data());
+  } else {
+    pack.entryStorage.resize(pack.header.resourceCount);
+    if (!table.empty()) {
+      std::memcpy(pack.entryStorage.data(), table.data(), table.size());
+    }
+    entries = pack.entryStorage.data();
+  }
 
-  if (!file) {
+  // String table: count, offsets, then NUL-terminated ids viewed in place
+  u32 stringCount = 0;
+  const auto countBytes = subspan(pack.header.stringTableOffset, sizeof(u32));
+  if (countBytes.size() != sizeof(u32)) {
     return Result<void>::error("Failed to read string count");
   }
+  std::memcpy(&stringCount, countBytes.data(), sizeof(u32));
 
-  // Security: Validate string count to prevent excessive allocations
-  constexpr u32 MAX_STRING_COUNT = 10000000; // 10 million strings max
   if (stringCount > MAX_STRING_COUNT) {
     return Result<void>::error("String count exceeds maximum allowed");
   }
 
-  // Read string offsets
-  std::vector<u32> offsets(stringCount);
-  file.read(reinterpret_cast<char *>(offsets.data()),
-            static_cast<std::streamsize>(stringCount * sizeof(u32)));
-
-  if (!file) {
+  const u64 offsetsStart = pack.header.stringTableOffset + sizeof(u32);
+  const auto offsets =
+      subspan(offsetsStart, static_cast<u64>(stringCount) * sizeof(u32));
+  if (offsets.size() != static_cast<usize>(stringCount) * sizeof(u32)) {
     return Result<void>::error("Failed to read string offsets");
   }
 
-  // Read string data
-  auto stringDataStart = file.tellg();
-  pack.stringTable.reserve(stringCount);
+  const u64 stringDataStart = offsetsStart + offsets.size();
+  pack.table = entries;
+  pack.stringOffsets = offsets;
+  pack.stringData = bytes.subspan(static_cast<usize>(stringDataStart));
+
+  // Indexed packs are looked up in place; ids are checked as they are found
+  if ((pack.header.flags & static_cast<u32>(PackFlags::HashIndex)) != 0) {
+    if (pack.header.dataOffset < stringDataStart ||
+        pack.header.dataOffset > bytes.size()) {
+      return Result<void>::error("Invalid pack data offset");
+    }
+    const auto tables = bytes.first(static_cast<usize>(pack.header.dataOffset));
+    auto indexResult =
+        VFS::PackHashIndex::open(tables, pack.header.resourceCount);
+    if (indexResult.isError()) {
+      return Result<void>::error(indexResult.error());
+    }
+    pack.index = indexResult.value();
+    pack.stringData = tables.subspan(static_cast<usize>(stringDataStart));
+    return Result<void>::ok();
+  }
 
-  // Security: Limit individual string length to prevent excessive allocations
-  constexpr usize MAX_STRING_LENGTH = 1024 * 1024; // 1 MB per string max
+  std::vector<std::string_view> ids;
+  ids.reserve(stringCount);
 
   for (u32 i = 0; i < stringCount; ++i) {
-    file.seekg(stringDataStart + static_cast<std::streamoff>(offsets[i]));
-    std::string str;
-    std::getline(file, str, '\0');
+    u32 offset = 0;
+    std::memcpy(&offset, offsets.data() + i * sizeof(u32), sizeof(u32));
+
+    const u64 start = stringDataStart + offset;
+    if (start >= bytes.size()) {
+      return Result<void>::error("String table offset out of bounds");
+    }
 
-    if (str.size() > MAX_STRING_LENGTH) {
+    const usize available = bytes.size() - static_cast<usize>(start);
+    const auto *str = reinterpret_cast<const char *>(bytes.data() + start);
+    const auto *terminator = static_cast<const char *>(
+        std::memchr(str, '\0', std::min(available, MAX_STRING_LENGTH + 1)));
+    if (!terminator) {
       return Result<void>::error("String length exceeds maximum allowed");
     }
 
-    pack.stringTable.push_back(str);
+    ids.emplace_back(str, static_cast<usize>(terminator - str));
   }
 
-  // Re-map entries with actual string IDs
-  std::unordered_map<std::string, PackResourceEntry> newEntries;
-  u32 index = 0;
-  for (auto &[key, entry] : pack.entries) {
-    if (entry.idStringOffset < pack.stringTable.size()) {
-      const std::string &resourceId = pack.stringTable[entry.idStringOffset];
-      newEntries[resourceId] = entry;
+  pack.entries.reserve(pack.header.resourceCount);
+  for (u32 i = 0; i < pack.header.resourceCount; ++i) {
+    const PackResourceEntry &entry = entries[i];
+    if (entry.idStringOffset < ids.size()) {
+      pack.entries[ids[entry.idStringOffset]] = &entry;
     }
-    ++index;
   }
-  pack.entries = std::move(newEntries);
 
   return Result<void>::ok();
 }
 
+const PackResourceEntry *PackReader::findEntry(const MountedPack &pack,
+                                               std::string_view resourceId) {
+  if (!pack.index) {
+    auto it = pack.entries.find(resourceId);
+    return it != pack.entries.end() ? it->second : nullptr;
+  }
+
+  const auto slot = pack.index->find(resourceId);
+  if (!slot) {
+    return nullptr;
+  }
+  const PackResourceEntry &entry = pack.table[*slot];
+  return entryId(pack, entry) == resourceId ? &entry : nullptr;
+}
+
+std::optional<std::string_view>
+PackReader::entryId(const MountedPack &pack, const PackResourceEntry &entry) {
+  const u64 offsetPosition =
+      static_cast<u64>(entry.idStringOffset) * sizeof(u32);
+  if (offsetPosition >= pack.stringOffsets.size()) {
+    return std::nullopt;
+  }
+
+  u32 offset = 0;
+  std::memcpy(&offset, pack.stringOffsets.data() + offsetPosition,
+              sizeof(u32));
+  if (offset >= pack.stringData.size()) {
+    return std::nullopt;
+  }
+
+  const usize available = pack.stringData.size() - offset;
+  const auto *str =
+      reinterpret_cast<const char *>(pack.stringData.data() + offset);
+  const auto *terminator = static_cast<const char *>(
+      std::memchr(str, '\0', std::min(available, MAX_STRING_LENGTH + 1)));
+  if (!terminator) {
+    return std::nullopt;
+  }
+  return std::string_view(str, static_cast<usize>(terminator - str));
+}
+
 Result<std::vector<u8>>
-PackReader::readResourceData(const std::string &packPath,
-                             const PackResourceEntry &entry) const {
-  // Security: Validate resource size to prevent excessive allocations
-  constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024; // 512 MB max per resource
-  if (entry.compressedSize > MAX_RESOURCE_SIZE) {
-    return Result<std::vector<u8>>::error("Resource size exceeds maximum allowed");
+PackReader::readEntry(const std::shared_ptr<const MountedPack> &pack,
+                      const PackResourceEntry &entry) {
+  if (isChunked(*pack, entry)) {
+    auto stream = openChunkedStream(pack, entry);
+    if (stream.isError()) {
+      return Result<std::vector<u8>>::error(stream.error());
+    }
+    return stream.value()->readAll();
   }
 
-  std::ifstream file(packPath, std::ios::binary);
-  if (!file.is_open()) {
-    return Result<std::vector<u8>>::error("Failed to open pack file");
+  if (!pack->mapping) {
+    return readResourceData(*pack, entry);
   }
 
-  auto it = m_packs.find(packPath);
-  if (it == m_packs.end()) {
-    return Result<std::vector<u8>>::error("Pack not mounted");
+  auto bytesResult = mappedResourceBytes(*pack, entry);
+  if (bytesResult.isError()) {
+    return Result<std::vector<u8>>::error(bytesResult.error());
   }
+  return decodeResourceData(*pack, entry, bytesResult.value());
+}
 
-  // Security: Validate offset doesn't cause overflow
-  u64 absoluteOffset = it->second.header.dataOffset + entry.dataOffset;
-  if (absoluteOffset < it->second.header.dataOffset) {
-    return Result<std::vector<u8>>::error("Invalid resource offset (overflow)");
+Result<std::span<const u8>>
+PackReader::mappedResourceBytes(const MountedPack &pack,
+                                const PackResourceEntry &entry) {
+  if (entry.compressedSize > MAX_RESOURCE_SIZE) {
+    return Result<std::span<const u8>>::error(
+        "Resource size exceeds maximum allowed");
   }
 
-  // Get file size to validate offset + size doesn't exceed file bounds
-  file.seekg(0, std::ios::end);
-  auto fileSize = file.tellg();
-  if (fileSize < 0) {
-    return Result<std::vector<u8>>::error("Failed to get pack file size");
+  const u64 absoluteOffset = pack.header.dataOffset + entry.dataOffset;
+  if (absoluteOffset < pack.header.dataOffset) {
+    return Result<std::span<const u8>>::error(
+        "Invalid resource offset (overflow)");
   }
 
-  if (absoluteOffset + entry.compressedSize > static_cast<u64>(fileSize)) {
-    return Result<std::vector<u8>>::error("Resource data extends beyond pack file");
+  const auto bytes = pack.mapping->bytes(absoluteOffset, entry.compressedSize);
+  if (bytes.size() != entry.compressedSize) {
+    return Result<std::span<const u8>>::error(
+        "Resource data extends beyond pack file");
   }
 
-  file.seekg(static_cast<std::streamoff>(absoluteOffset));
+  return Result<std::span<const u8>>::ok(bytes);
+}
+
+Result<std::vector<u8>>
+PackReader::readResourceData(const MountedPack &pack,
+                             const PackResourceEntry &entry) {
+  if (entry.compressedSize > MAX_RESOURCE_SIZE) {
+    return Result<std::vector<u8>>::error("Resource size exceeds maximum allowed");
+  }
 
-  if (!file) {
-    return Result<std::vector<u8>>::error("Failed to seek to resource data");
+  // Security: Validate offset doesn't cause overflow
+  u64 absoluteOffset = pack.header.dataOffset + entry.dataOffset;
+  if (absoluteOffset < pack.header.dataOffset) {
+    return Result<std::vector<u8>>::error("Invalid resource offset (overflow)");
   }
 
-  std::vector<u8> data(static_cast<usize>(entry.compressedSize));
-  file.read(reinterpret_cast<char *>(data.data()),
-            static_cast<std::streamsize>(entry.compressedSize));
+  if (absoluteOffset + entry.compressedSize > pack.fileSize) {
+    return Result<std::vector<u8>>::error("Resource data extends beyond pack file");
+  }
 
-  if (!file) {
+  std::vector<u8> data(static_cast<usize>(entry.compressedSize));
+  if (!data.empty() &&
+      pack.file->readAt(absoluteOffset, data.data(), data.size()).isError()) {
     return Result<std::vector<u8>>::error("Failed to read resource data");
   }
 
-  // Decryption and decompression are handled by PackSecurity when enabled.
+  // Decryption and pack-wide compression are handled by SecurePackReader.
   // See pack_security.hpp for encryption/compression configuration.
+  if (resourceCodec(pack, entry) != VFS::PackCompression::None) {
+    return decodeResourceData(pack, entry, data);
+  }
 
   return Result<std::vector<u8>>::ok(std::move(data));
 }
 
+VFS::PackCompression PackReader::resourceCodec(const MountedPack &pack,
+                                               const PackResourceEntry &entry) {
+  if ((pack.header.flags & static_cast<u32>(PackFlags::ResourceCodecs)) == 0) {
+    return VFS::PackCompression::None;
+  }
+  return VFS::PackCompressor::entryCodec(entry.flags);
+}
+
+bool PackReader::isChunked(const MountedPack &pack,
+                           const PackResourceEntry &entry) {
+  return (pack.header.flags & static_cast<u32>(PackFlags::ResourceCodecs)) !=
+             0 &&
+         (entry.flags & VFS::ChunkedResource::kEntryFlagChunked) != 0;
+}
+
+Result<std::unique_ptr<VFS::ChunkedFileHandle>>
+PackReader::openChunkedStream(const std::shared_ptr<const MountedPack> &pack,
+                              const PackResourceEntry &entry) {
+  const u64 absoluteOffset = pack->header.dataOffset + entry.dataOffset;
+  if (absoluteOffset < pack->header.dataOffset ||
+      entry.compressedSize > pack->fileSize - std::min(absoluteOffset,
+                                                       pack->fileSize)) {
+    return Result<std::unique_ptr<VFS::ChunkedFileHandle>>::error(
+        "Resource data extends beyond pack file");
+  }
+
+  VFS::ChunkedResourceSource source;
+  source.mapping = pack->mapping;
+  source.file = pack->file;
+  source.offset = absoluteOffset;
+  source.storedSize = entry.compressedSize;
+  source.uncompressedSize = entry.uncompressedSize;
+  source.codec = resourceCodec(*pack, entry);
+  return VFS::ChunkedFileHandle::open(std::move(source));
+}
+
+Result<std::vector<u8>>
+PackReader::decodeResourceData(const MountedPack &pack,
+                               const PackResourceEntry &entry,
+                               std::span<const u8> stored) {
+  const auto codec = resourceCodec(pack, entry);
+  if (codec == VFS::PackCompression::None) {
+    return Result<std::vector<u8>>::ok(
+        std::vector<u8>(stored.begin(), stored.end()));
+  }
+  return VFS::PackCompressor::decompress(codec, stored,
+                                         entry.uncompressedSize);
+}
+
 } // namespace NovelMind::vfs
@@ -1,19 +1,123 @@
 #include "NovelMind/vfs/pack_security.hpp"
+#include "NovelMind/vfs/chunked_resource.hpp"
+#include "NovelMind/vfs/crc32.hpp"
+#include "NovelMind/vfs/pack_delta.hpp"
 
 #include "pack_security_detail.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <limits>
 #include <utility>
 
-#ifdef NOVELMIND_HAS_ZLIB
-#include <zlib.h>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
 namespace NovelMind::VFS {
 
+namespace {
+
+constexpr usize kMaxStringLength = 1024 * 1024;
+// Ciphertext decrypted per step on the way to the decompressor; small
+// enough for the stack and to stay in cache until zlib/zstd consume it
+constexpr usize kDecodeBlockSize = 16 * 1024;
+// Stored data read per step when only a resource's first bytes are wanted
+constexpr usize kPrefixBlockSize = 4 * 1024;
+
+Result<std::array<u8, 32>> hashPackStream(std::ifstream &file, u64 size) {
+  using HashResult = Result<std::array<u8, 32>>;
+
+  file.clear();
+  file.seekg(0, std::ios::beg);
+
+#ifdef NOVELMIND_HAS_OPENSSL
+  EVP_MD_CTX *sha256 = EVP_MD_CTX_new();
+  if (!sha256) {
+    return HashResult::error("Failed to create SHA-256 context");
+  }
+  if (EVP_DigestInit_ex(sha256, EVP_sha256(), nullptr) != 1) {
+    EVP_MD_CTX_free(sha256);
+    return HashResult::error("Failed to initialize SHA-256");
+  }
+#else
+  detail::Sha256Context sha256;
+  detail::sha256Init(sha256);
+#endif
+
+  std::vector<u8> buffer(64 * 1024);
+  u64 remaining = size;
+  while (remaining > 0) {
+    const usize toRead =
+        static_cast<usize>(std::min<u64>(remaining, buffer.size()));
+    file.read(reinterpret_cast<char *>(buffer.data()),
+              static_cast<std::streamsize>(toRead));
+    const std::streamsize readCount = file.gcount();
+    if (readCount <= 0) {
+#ifdef NOVELMIND_HAS_OPENSSL
+      EVP_MD_CTX_free(sha256);
+#endif
+      return HashResult::error("Failed to read pack for hash verification");
+    }
+#ifdef NOVELMIND_HAS_OPENSSL
+    if (EVP_DigestUpdate(sha256, buffer.data(),
+                         static_cast<size_t>(readCount)) != 1) {
+      EVP_MD_CTX_free(sha256);
+      return HashResult::error("Failed to update SHA-256 hash");
+    }
+#else
+    detail::sha256Update(sha256, buffer.data(), static_cast<usize>(readCount));
+#endif
+    remaining -= static_cast<u64>(readCount);
+  }
+
+  std::array<u8, 32> hash{};
+#ifdef NOVELMIND_HAS_OPENSSL
+  unsigned int hashLen = 0;
+  if (EVP_DigestFinal_ex(sha256, hash.data(), &hashLen) != 1 ||
+      hashLen != hash.size()) {
+    EVP_MD_CTX_free(sha256);
+    return HashResult::error("Failed to finalize SHA-256 hash");
+  }
+  EVP_MD_CTX_free(sha256);
+#else
+  detail::sha256Final(sha256, hash.data());
+#endif
+
+  return HashResult::ok(hash);
+}
+
+// Background verification should only use disk and CPU time nothing else
+// wants
+void lowerCurrentThreadPriority() {
+#if defined(_WIN32)
+  SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(__linux__)
+  // No glibc wrapper for ioprio_set; who 0 with IOPRIO_WHO_PROCESS is the
+  // calling thread
+  constexpr int kIoprioWhoProcess = 1;
+  constexpr int kIoprioClassIdle = 3;
+  constexpr int kIoprioClassShift = 13;
+  syscall(SYS_ioprio_set, kIoprioWhoProcess, 0,
+          kIoprioClassIdle << kIoprioClassShift);
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+
+} // namespace
+
+SecurePackReader::~SecurePackReader() { stopBackgroundVerification(); }
+
 void SecurePackReader::setDecryptor(std::unique_ptr<PackDecryptor> decryptor) {
   m_decryptor = std::move(decryptor);
 }
@@ -45,30 +149,46 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     m_integrityChecker = std::make_unique<PackIntegrityChecker>();
   }
 
-  std::ifstream file(path, std::ios::binary);
-  if (!file.is_open()) {
-    m_lastResult = PackVerificationResult::CorruptedHeader;
-    return Result<void>::error("Failed to open pack file: " + path);
+  if (m_useMemoryMapping) {
+    auto mapResult = MappedFile::open(path);
+    if (mapResult.isOk()) {
+      m_mapping = std::move(mapResult).value();
+    }
   }
 
-  file.seekg(0, std::ios::end);
-  const std::streamoff endPos = file.tellg();
-  if (endPos < 0) {
-    m_lastResult = PackVerificationResult::CorruptedHeader;
-    return Result<void>::error("Failed to determine pack file size");
+  std::ifstream file;
+  if (m_mapping) {
+    m_fileSize = m_mapping->size();
+  } else {
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return Result<void>::error("Failed to open pack file: " + path);
+    }
+
+    file.seekg(0, std::ios::end);
+    const std::streamoff endPos = file.tellg();
+    if (endPos < 0) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return Result<void>::error("Failed to determine pack file size");
+    }
+    m_fileSize = static_cast<u64>(endPos);
   }
 
-  m_fileSize = static_cast<u64>(endPos);
   if (m_fileSize < sizeof(PackHeader) + detail::kFooterSize) {
     m_lastResult = PackVerificationResult::CorruptedHeader;
     return Result<void>::error("Pack file too small");
   }
 
-  file.seekg(0, std::ios::beg);
-  file.read(reinterpret_cast<char *>(&m_header), sizeof(m_header));
-  if (!file) {
-    m_lastResult = PackVerificationResult::CorruptedHeader;
-    return Result<void>::error("Failed to read pack header");
+  if (m_mapping) {
+    std::memcpy(&m_header, m_mapping->data(), sizeof(m_header));
+  } else {
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char *>(&m_header), sizeof(m_header));
+    if (!file) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return Result<void>::error("Failed to read pack header");
+    }
   }
 
   if (m_header.magic != detail::kPackMagic) {
@@ -113,25 +233,45 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     return Result<void>::error("Invalid data offset");
   }
 
-  file.seekg(static_cast<std::streamoff>(m_header.resourceTableOffset));
-  std::vector<PackResourceEntry> entries(m_header.resourceCount);
-  if (!entries.empty()) {
-    file.read(reinterpret_cast<char *>(entries.data()),
-              static_cast<std::streamsize>(entries.size() *
-                                           sizeof(PackResourceEntry)));
+  // Header, resource table and string table all precede the data section.
+  // Mapped packs are parsed in place; streamed packs load that prefix once.
+  const u8 *tables = nullptr;
+  if (m_mapping) {
+    tables = m_mapping->data();
+  } else {
+    m_tableStorage.resize(static_cast<usize>(m_header.dataOffset));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char *>(m_tableStorage.data()),
+              static_cast<std::streamsize>(m_tableStorage.size()));
     if (!file) {
       m_lastResult = PackVerificationResult::CorruptedResourceTable;
       return Result<void>::error("Failed to read resource table");
     }
+    tables = m_tableStorage.data();
   }
 
-  file.seekg(static_cast<std::streamoff>(m_header.stringTableOffset));
-  u32 stringCount = 0;
-  file.read(reinterpret_cast<char *>(&stringCount), sizeof(stringCount));
-  if (!file) {
+  const u8 *tableStart = tables + m_header.resourceTableOffset;
+  const PackResourceEntry *entries = nullptr;
+  if (reinterpret_cast<std::uintptr_t>(tableStart) %
+          alignof(PackResourceEntry) ==
+      0) {
+    entries = reinterpret_cast<const PackResourceEntry *>(tableStart);
+  } else {
+    m_entryStorage.resize(m_header.resourceCount);
+    if (!m_entryStorage.empty()) {
+      std::memcpy(m_entryStorage.data(), tableStart,
+                  m_entryStorage.size() * sizeof(PackResourceEntry));
+    }
+    entries = m_entryStorage.data();
+  }
+
+  if (m_header.stringTableOffset + sizeof(u32) > m_header.dataOffset) {
     m_lastResult = PackVerificationResult::CorruptedResourceTable;
     return Result<void>::error("Failed to read string table count");
   }
+  u32 stringCount = 0;
+  std::memcpy(&stringCount, tables + m_header.stringTableOffset,
+              sizeof(stringCount));
 
   constexpr u32 MAX_STRING_COUNT = 10000000;
   if (stringCount > MAX_STRING_COUNT) {
@@ -139,75 +279,86 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     return Result<void>::error("String table count exceeds maximum");
   }
 
-  std::vector<u32> offsets(stringCount);
-  if (!offsets.empty()) {
-    file.read(reinterpret_cast<char *>(offsets.data()),
-              static_cast<std::streamsize>(offsets.size() * sizeof(u32)));
-    if (!file) {
-      m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("Failed to read string table offsets");
-    }
-  }
-
-  const auto stringDataStart = file.tellg();
-  const u64 stringDataStartU64 = stringDataStart >= 0
-                                     ? static_cast<u64>(stringDataStart)
-                                     : 0;
-  if (stringDataStart < 0 || stringDataStartU64 > m_header.dataOffset) {
+  const u64 offsetsStart = m_header.stringTableOffset + sizeof(u32);
+  const u64 stringDataStart =
+      offsetsStart + static_cast<u64>(stringCount) * sizeof(u32);
+  if (stringDataStart > m_header.dataOffset) {
     m_lastResult = PackVerificationResult::CorruptedResourceTable;
     return Result<void>::error("Invalid string table data start");
   }
 
-  const u64 stringDataSize = m_header.dataOffset - stringDataStartU64;
-  m_stringTable.clear();
-  m_stringTable.reserve(stringCount);
-
-  constexpr usize MAX_STRING_LENGTH = 1024 * 1024;
-  for (u32 i = 0; i < stringCount; ++i) {
-    if (offsets[i] >= stringDataSize) {
+  const u64 stringDataSize = m_header.dataOffset - stringDataStart;
+  m_table = entries;
+  m_stringOffsets = tables + offsetsStart;
+  m_stringCount = stringCount;
+  m_stringData = {tables + stringDataStart, static_cast<usize>(stringDataSize)};
+
+  // Indexed packs resolve ids lazily through the index; the rest get every
+  // id checked and mapped up front
+  m_index.reset();
+  if ((m_header.flags & detail::kPackFlagHashIndex) != 0) {
+    auto indexResult = PackHashIndex::open(
+        {tables, static_cast<usize>(m_header.dataOffset)},
+        m_header.resourceCount);
+    if (indexResult.isError()) {
       m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("String table offset out of bounds");
+      return Result<void>::error(indexResult.error());
     }
+    m_index = indexResult.value();
+  }
+  const bool indexed = m_index.has_value();
 
-    file.seekg(stringDataStart + static_cast<std::streamoff>(offsets[i]));
-    std::string str;
-    std::getline(file, str, '\0');
-
-    if (!file) {
-      m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("Failed to read string table entry");
-    }
+  std::vector<std::string_view> stringTable;
+  if (!indexed) {
+    stringTable.reserve(stringCount);
+  }
 
-    if (str.size() > MAX_STRING_LENGTH) {
+  for (u32 i = 0; i < stringCount && !indexed; ++i) {
+    u32 offset = 0;
+    std::memcpy(&offset, tables + offsetsStart + i * sizeof(u32),
+                sizeof(offset));
+    if (offset >= stringDataSize) {
       m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("String table entry too large");
+      return Result<void>::error("String table offset out of bounds");
     }
 
-    const u64 stringEnd =
-        static_cast<u64>(offsets[i]) + static_cast<u64>(str.size());
-    if (stringEnd >= stringDataSize) {
+    const auto *str =
+        reinterpret_cast<const char *>(tables + stringDataStart + offset);
+    const usize available = static_cast<usize>(stringDataSize - offset);
+    const auto *terminator = static_cast<const char *>(
+        std::memchr(str, '\0', std::min(available, kMaxStringLength + 1)));
+    if (!terminator) {
       m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("String table entry out of bounds");
+      return Result<void>::error(available > kMaxStringLength
+                                     ? "String table entry too large"
+                                     : "String table entry out of bounds");
     }
 
-    m_stringTable.push_back(std::move(str));
+    stringTable.emplace_back(str, static_cast<usize>(terminator - str));
   }
 
-  constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024;
+  u64 dataEnd = m_header.dataOffset;
   m_entries.clear();
-  for (const auto &entry : entries) {
-    if (entry.idStringOffset >= m_stringTable.size()) {
-      m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("Resource ID offset out of bounds");
-    }
+  if (!indexed) {
+    m_entries.reserve(m_header.resourceCount);
+  }
+  for (u32 i = 0; i < m_header.resourceCount; ++i) {
+    const PackResourceEntry &entry = entries[i];
+    std::string_view resourceId;
+    if (!indexed) {
+      if (entry.idStringOffset >= stringTable.size()) {
+        m_lastResult = PackVerificationResult::CorruptedResourceTable;
+        return Result<void>::error("Resource ID offset out of bounds");
+      }
 
-    const std::string &resourceId = m_stringTable[entry.idStringOffset];
-    if (resourceId.empty()) {
-      m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("Empty resource ID in string table");
+      resourceId = stringTable[entry.idStringOffset];
+      if (resourceId.empty()) {
+        m_lastResult = PackVerificationResult::CorruptedResourceTable;
+        return Result<void>::error("Empty resource ID in string table");
+      }
     }
 
-    if (entry.compressedSize > MAX_RESOURCE_SIZE) {
+    if (entry.compressedSize > detail::kMaxResourceSize) {
       m_lastResult = PackVerificationResult::CorruptedData;
       return Result<void>::error("Resource size exceeds limit");
     }
@@ -223,19 +374,30 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
       m_lastResult = PackVerificationResult::CorruptedData;
       return Result<void>::error("Resource data extends beyond pack file");
     }
+    dataEnd = std::max(dataEnd, absoluteOffset + entry.compressedSize);
 
-    auto insertResult = m_entries.emplace(resourceId, entry);
+    if (indexed) {
+      continue;
+    }
+    auto insertResult = m_entries.emplace(resourceId, &entry);
     if (!insertResult.second) {
       m_lastResult = PackVerificationResult::CorruptedResourceTable;
-      return Result<void>::error("Duplicate resource ID: " + resourceId);
+      return Result<void>::error("Duplicate resource ID: " +
+                                 std::string(resourceId));
     }
   }
 
-  file.seekg(static_cast<std::streamoff>(m_fileSize - detail::kFooterSize));
-  file.read(reinterpret_cast<char *>(&m_footer), sizeof(m_footer));
-  if (!file) {
-    m_lastResult = PackVerificationResult::CorruptedHeader;
-    return Result<void>::error("Failed to read pack footer");
+  if (m_mapping) {
+    std::memcpy(&m_footer,
+                m_mapping->data() + (m_fileSize - detail::kFooterSize),
+                sizeof(m_footer));
+  } else {
+    file.seekg(static_cast<std::streamoff>(m_fileSize - detail::kFooterSize));
+    file.read(reinterpret_cast<char *>(&m_footer), sizeof(m_footer));
+    if (!file) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return Result<void>::error("Failed to read pack footer");
+    }
   }
 
   if (m_footer.magic != detail::kFooterMagic) {
@@ -243,33 +405,26 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     return Result<void>::error("Invalid pack footer magic");
   }
 
-  file.seekg(0, std::ios::beg);
-  u32 crc = 0xFFFFFFFF;
-  u64 remaining = m_header.dataOffset;
-  std::vector<u8> buffer(64 * 1024);
-  while (remaining > 0) {
-    const usize toRead =
-        static_cast<usize>(std::min<u64>(remaining, buffer.size()));
-    file.read(reinterpret_cast<char *>(buffer.data()),
-              static_cast<std::streamsize>(toRead));
-    const std::streamsize readCount = file.gcount();
-    if (readCount <= 0) {
-      m_lastResult = PackVerificationResult::CorruptedHeader;
-      return Result<void>::error("Failed to read pack for CRC verification");
-    }
-    crc = detail::updateCrc32(crc, buffer.data(),
-                              static_cast<usize>(readCount));
-    remaining -= static_cast<u64>(readCount);
-  }
-  crc = ~crc;
-
+  const u32 crc =
+      Crc32::compute(tables, static_cast<usize>(m_header.dataOffset));
   if (crc != m_footer.tablesCrc32) {
     m_lastResult = PackVerificationResult::ChecksumMismatch;
     return Result<void>::error("Pack table CRC mismatch");
   }
 
+  // MerkleSigned packs are verified chunk by chunk as they are read, in place
+  // of the whole-file signature and content hash checks below
+  std::optional<PackHashTree> hashTree;
+  if ((m_header.flags & detail::kPackFlagMerkleSigned) != 0) {
+    auto treeResult = openHashTree(file, tables, dataEnd);
+    if (treeResult.isError()) {
+      return Result<void>::error(treeResult.error());
+    }
+    hashTree = std::move(treeResult).value();
+  }
+
   const bool requiresSignature =
-      (m_header.flags & detail::kPackFlagSigned) != 0;
+      (m_header.flags & detail::kPackFlagSigned) != 0 && !hashTree;
   if (requiresSignature) {
     std::string signaturePath = path + ".sig";
     std::ifstream sigFile(signaturePath, std::ios::binary);
@@ -288,11 +443,19 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
       return Result<void>::error("Signature file is empty");
     }
 
-    file.clear();
-    file.seekg(0, std::ios::beg);
-    auto sigReport = m_integrityChecker->verifyPackSignatureStream(
-        file, static_cast<usize>(m_fileSize), signature.data(),
-        signature.size());
+    Result<PackVerificationReport> sigReport =
+        Result<PackVerificationReport>::error("Signature not verified");
+    if (m_mapping) {
+      sigReport = m_integrityChecker->verifyPackSignature(
+          m_mapping->data(), m_mapping->size(), signature.data(),
+          signature.size());
+    } else {
+      file.clear();
+      file.seekg(0, std::ios::beg);
+      sigReport = m_integrityChecker->verifyPackSignatureStream(
+          file, static_cast<usize>(m_fileSize), signature.data(),
+          signature.size());
+    }
     if (!sigReport.isOk() ||
         sigReport.value().result != PackVerificationResult::Valid) {
       m_lastResult = sigReport.isOk() ? sigReport.value().result
@@ -302,218 +465,799 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     }
   }
 
-  const bool hasContentHash = std::any_of(
+  const bool hasContentHash = !hashTree && std::any_of(
       std::begin(m_header.contentHash), std::end(m_header.contentHash),
       [](u8 byte) { return byte != 0; });
   if (hasContentHash) {
-    file.clear();
-    file.seekg(0, std::ios::beg);
-
-#ifdef NOVELMIND_HAS_OPENSSL
-    EVP_MD_CTX *sha256 = EVP_MD_CTX_new();
-    if (!sha256) {
-      m_lastResult = PackVerificationResult::ChecksumMismatch;
-      return Result<void>::error("Failed to create SHA-256 context");
-    }
-    if (EVP_DigestInit_ex(sha256, EVP_sha256(), nullptr) != 1) {
-      EVP_MD_CTX_free(sha256);
-      m_lastResult = PackVerificationResult::ChecksumMismatch;
-      return Result<void>::error("Failed to initialize SHA-256");
-    }
-#else
-    detail::Sha256Context sha256;
-    detail::sha256Init(sha256);
-#endif
-
-    remaining = m_fileSize;
-    while (remaining > 0) {
-      const usize toRead =
-          static_cast<usize>(std::min<u64>(remaining, buffer.size()));
-      file.read(reinterpret_cast<char *>(buffer.data()),
-                static_cast<std::streamsize>(toRead));
-      const std::streamsize readCount = file.gcount();
-      if (readCount <= 0) {
-        m_lastResult = PackVerificationResult::ChecksumMismatch;
-        return Result<void>::error("Failed to read pack for hash verification");
-      }
-#ifdef NOVELMIND_HAS_OPENSSL
-      if (EVP_DigestUpdate(sha256, buffer.data(),
-                           static_cast<size_t>(readCount)) != 1) {
-        EVP_MD_CTX_free(sha256);
+    std::array<u8, 32> hash{};
+    if (m_mapping) {
+      hash = PackIntegrityChecker::calculateSha256(m_mapping->data(),
+                                                   m_mapping->size());
+    } else {
+      auto hashResult = hashPackStream(file, m_fileSize);
+      if (hashResult.isError()) {
         m_lastResult = PackVerificationResult::ChecksumMismatch;
-        return Result<void>::error("Failed to update SHA-256 hash");
+        return Result<void>::error(hashResult.error());
       }
-#else
-      detail::sha256Update(sha256, buffer.data(),
-                           static_cast<usize>(readCount));
-#endif
-      remaining -= static_cast<u64>(readCount);
+      hash = hashResult.value();
     }
 
-    std::array<u8, 32> hash{};
-#ifdef NOVELMIND_HAS_OPENSSL
-    unsigned int hashLen = 0;
-    if (EVP_DigestFinal_ex(sha256, hash.data(), &hashLen) != 1 ||
-        hashLen != hash.size()) {
-      EVP_MD_CTX_free(sha256);
-      m_lastResult = PackVerificationResult::ChecksumMismatch;
-      return Result<void>::error("Failed to finalize SHA-256 hash");
-    }
-    EVP_MD_CTX_free(sha256);
-#else
-    detail::sha256Final(sha256, hash.data());
-#endif
-
     if (std::memcmp(m_header.contentHash, hash.data(), 16) != 0) {
       m_lastResult = PackVerificationResult::ChecksumMismatch;
       return Result<void>::error("Pack content hash mismatch");
     }
   }
 
+  if (!m_mapping) {
+    auto fileResult = PositionalFile::open(path);
+    if (fileResult.isError()) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return Result<void>::error(fileResult.error());
+    }
+    m_file = std::move(fileResult).value();
+  }
+
+  if (hashTree) {
+    m_verifier = std::make_shared<PackChunkVerifier>(std::move(*hashTree),
+                                                     m_mapping, m_file);
+  }
+
   m_isOpen = true;
   m_lastResult = PackVerificationResult::Valid;
   return Result<void>::ok();
 }
 
+Result<PackHashTree> SecurePackReader::openHashTree(std::ifstream &file,
+                                                   const u8 *tables,
+                                                   u64 dataEnd) {
+  using ResultType = Result<PackHashTree>;
+
+  u64 sectionOffset = 0;
+  std::memcpy(&sectionOffset,
+              reinterpret_cast<const u8 *>(&m_footer) +
+                  PackHashTree::kFooterOffsetField,
+              sizeof(sectionOffset));
+  const u64 sectionEnd = m_fileSize - detail::kFooterSize;
+  if (sectionOffset < dataEnd || sectionOffset > sectionEnd) {
+    m_lastResult = PackVerificationResult::CorruptedHeader;
+    return ResultType::error("Invalid hash tree offset");
+  }
+
+  std::vector<u8> sectionStorage;
+  std::span<const u8> section;
+  if (m_mapping) {
+    section = m_mapping->bytes(sectionOffset, sectionEnd - sectionOffset);
+  } else {
+    sectionStorage.resize(static_cast<usize>(sectionEnd - sectionOffset));
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(sectionOffset));
+    file.read(reinterpret_cast<char *>(sectionStorage.data()),
+              static_cast<std::streamsize>(sectionStorage.size()));
+    if (!file) {
+      m_lastResult = PackVerificationResult::CorruptedHeader;
+      return ResultType::error("Failed to read hash tree");
+    }
+    section = sectionStorage;
+  }
+
+  auto treeResult = PackHashTree::parse(section);
+  if (treeResult.isError()) {
+    m_lastResult = PackVerificationResult::SignatureInvalid;
+    return treeResult;
+  }
+  PackHashTree tree = std::move(treeResult).value();
+
+  if (tree.dataOffset() != m_header.dataOffset ||
+      tree.dataSize() != sectionOffset - m_header.dataOffset) {
+    m_lastResult = PackVerificationResult::SignatureInvalid;
+    return ResultType::error("Hash tree does not cover the data section");
+  }
+
+  if (PackIntegrityChecker::calculateSha256(
+          tables, static_cast<usize>(m_header.dataOffset)) !=
+      tree.tablesHash()) {
+    m_lastResult = PackVerificationResult::SignatureInvalid;
+    return ResultType::error("Pack tables do not match the hash tree");
+  }
+
+  const auto header = tree.headerBytes();
+  const auto signature = tree.signature();
+  auto sigReport = m_integrityChecker->verifyPackSignature(
+      header.data(), header.size(), signature.data(), signature.size());
+  if (!sigReport.isOk() ||
+      sigReport.value().result != PackVerificationResult::Valid) {
+    m_lastResult = sigReport.isOk() ? sigReport.value().result
+                                    : PackVerificationResult::SignatureInvalid;
+    return ResultType::error(sigReport.isOk() ? sigReport.value().message
+                                              : sigReport.error());
+  }
+
+  return ResultType::ok(std::move(tree));
+}
+
+Result<void> SecurePackReader::startBackgroundVerification() {
+  if (!m_isOpen || !m_verifier) {
+    return Result<void>::error("Pack has no hash tree to verify");
+  }
+  if (m_verifyThread.joinable()) {
+    return Result<void>::ok();
+  }
+
+  m_stopVerification.store(false);
+  m_verifying.store(true);
+  m_verifyThread = std::thread([this, verifier = m_verifier]() {
+    lowerCurrentThreadPriority();
+    // A failure is recorded in the verifier and reported through progress
+    (void)verifier->verifyAll(&m_stopVerification);
+    m_verifying.store(false);
+  });
+  return Result<void>::ok();
+}
+
+SecurePackReader::VerificationProgress
+SecurePackReader::verificationProgress() const {
+  VerificationProgress progress;
+  if (m_verifier) {
+    progress.verifiedChunks = m_verifier->verifiedCount();
+    progress.totalChunks = m_verifier->chunkCount();
+    progress.failed = m_verifier->hasFailed();
+  }
+  progress.running = m_verifying.load();
+  return progress;
+}
+
+void SecurePackReader::stopBackgroundVerification() {
+  if (m_verifyThread.joinable()) {
+    m_stopVerification.store(true);
+    m_verifyThread.join();
+  }
+}
+
 void SecurePackReader::closePack() {
+  stopBackgroundVerification();
+  m_verifier.reset();
   m_isOpen = false;
   m_packPath.clear();
   m_entries.clear();
-  m_stringTable.clear();
+  m_index.reset();
+  m_table = nullptr;
+  m_stringOffsets = nullptr;
+  m_stringCount = 0;
+  m_stringData = {};
+  m_entryStorage.clear();
+  m_tableStorage.clear();
+  m_mapping.reset();
+  m_file.reset();
   m_fileSize = 0;
+  m_lastReadEnd.store(0);
   m_lastResult = PackVerificationResult::Valid;
 }
 
+void SecurePackReader::prefetchRange(u64 offset, u64 length) const {
+  if (m_mapping) {
+    m_mapping->prefetch(offset, length);
+  } else if (m_file) {
+    m_file->prefetch(offset, length);
+  }
+}
+
+void SecurePackReader::noteRead(const PackResourceEntry &entry) const {
+  const u64 start = m_header.dataOffset + entry.dataOffset;
+  const u64 end = start + entry.compressedSize;
+  const u64 previousEnd = m_lastReadEnd.exchange(end);
+  // The OS already reads ahead within a request; what it cannot know is
+  // that the resources after this one are next
+  if (m_readAhead != 0 && previousEnd != 0 && start >= previousEnd &&
+      start - previousEnd <= kPrefetchMergeGap) {
+    prefetchRange(end, m_readAhead);
+  }
+}
+
+void SecurePackReader::prefetch(
+    std::span<const std::string> resourceIds) const {
+  if (!m_isOpen) {
+    return;
+  }
+  std::vector<std::pair<u64, u64>> ranges;
+  ranges.reserve(resourceIds.size());
+  for (const auto &id : resourceIds) {
+    if (const PackResourceEntry *entry = findEntry(id)) {
+      const u64 start = m_header.dataOffset + entry->dataOffset;
+      ranges.emplace_back(start, start + entry->compressedSize);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  usize i = 0;
+  while (i < ranges.size()) {
+    const u64 start = ranges[i].first;
+    u64 end = ranges[i].second;
+    for (++i; i < ranges.size() && ranges[i].first <= end + kPrefetchMergeGap;
+         ++i) {
+      end = std::max(end, ranges[i].second);
+    }
+    prefetchRange(start, end - start);
+  }
+}
+
 Result<std::vector<u8>>
 SecurePackReader::readResource(const std::string &resourceId) {
   if (!m_isOpen) {
     return Result<std::vector<u8>>::error("Pack not open");
   }
 
-  auto it = m_entries.find(resourceId);
-  if (it == m_entries.end()) {
+  const PackResourceEntry *found = findEntry(resourceId);
+  if (!found) {
     return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
   }
 
-  const PackResourceEntry &entry = it->second;
-  std::ifstream file(m_packPath, std::ios::binary);
-  if (!file.is_open()) {
-    return Result<std::vector<u8>>::error("Failed to open pack file");
+  const PackResourceEntry &entry = *found;
+  noteRead(entry);
+  if (isChunked(entry)) {
+    auto stream = openChunkedStream(resourceId, entry);
+    if (stream.isError()) {
+      return Result<std::vector<u8>>::error(stream.error());
+    }
+    auto data = stream.value()->readAll();
+    if (data.isError()) {
+      return data;
+    }
+    auto verifyResult = verifyDecoded(entry, data.value());
+    if (verifyResult.isError()) {
+      return Result<std::vector<u8>>::error(verifyResult.error());
+    }
+    return data;
+  }
+
+  if (entry.uncompressedSize > detail::kMaxResourceSize) {
+    return Result<std::vector<u8>>::error("Resource size exceeds limit");
+  }
+
+  std::vector<u8> data(static_cast<usize>(entry.uncompressedSize));
+  auto decoded = decodeInto(resourceId, entry, data);
+  if (decoded.isError()) {
+    return Result<std::vector<u8>>::error(decoded.error());
+  }
+  return Result<std::vector<u8>>::ok(std::move(data));
+}
+
+Result<usize> SecurePackReader::readResourceInto(const std::string &resourceId,
+                                                 std::span<u8> destination) {
+  if (!m_isOpen) {
+    return Result<usize>::error("Pack not open");
+  }
+
+  const PackResourceEntry *found = findEntry(resourceId);
+  if (!found) {
+    return Result<usize>::error("Resource not found: " + resourceId);
+  }
+
+  const PackResourceEntry &entry = *found;
+  noteRead(entry);
+  if (entry.uncompressedSize > destination.size()) {
+    return Result<usize>::error("Destination too small for " + resourceId);
+  }
+  const auto out =
+      destination.first(static_cast<usize>(entry.uncompressedSize));
+
+  if (isChunked(entry)) {
+    auto stream = openChunkedStream(resourceId, entry);
+    if (stream.isError()) {
+      return Result<usize>::error(stream.error());
+    }
+    auto read = stream.value()->read(out.data(), out.size());
+    if (read.isError()) {
+      return read;
+    }
+    if (read.value() != out.size()) {
+      return Result<usize>::error("Resource size mismatch after decode");
+    }
+    auto verifyResult = verifyDecoded(entry, out);
+    if (verifyResult.isError()) {
+      return Result<usize>::error(verifyResult.error());
+    }
+    return Result<usize>::ok(out.size());
+  }
+
+  auto decoded = decodeInto(resourceId, entry, out);
+  if (decoded.isError()) {
+    return Result<usize>::error(decoded.error());
+  }
+  return Result<usize>::ok(out.size());
+}
+
+Result<usize>
+SecurePackReader::readResourcePrefix(const std::string &resourceId,
+                                     std::span<u8> destination) {
+  if (!m_isOpen) {
+    return Result<usize>::error("Pack not open");
+  }
+
+  const PackResourceEntry *found = findEntry(resourceId);
+  if (!found) {
+    return Result<usize>::error("Resource not found: " + resourceId);
+  }
+
+  const PackResourceEntry &entry = *found;
+  const auto out = destination.first(static_cast<usize>(
+      std::min<u64>(destination.size(), entry.uncompressedSize)));
+  if (out.empty()) {
+    return Result<usize>::ok(0);
+  }
+
+  if (isChunked(entry)) {
+    // Only the frames covering the prefix are decoded, and each frame is
+    // verified and authenticated as it is read
+    auto stream = openChunkedStream(resourceId, entry);
+    if (stream.isError()) {
+      return Result<usize>::error(stream.error());
+    }
+    return stream.value()->read(out.data(), out.size());
+  }
+
+  const bool encrypted = (m_header.flags & detail::kPackFlagEncrypted) != 0;
+  const PackCompression codec = resourceCodec(entry);
+  if (encrypted || !PackDecompressStream::supportsStreaming(codec)) {
+    // The GCM tag covers the whole payload, so no prefix of it can be
+    // trusted on its own; LZ4 blocks decode in one call anyway
+    auto data = readResource(resourceId);
+    if (data.isError()) {
+      return Result<usize>::error(data.error());
+    }
+    std::copy_n(data.value().begin(), out.size(), out.begin());
+    return Result<usize>::ok(out.size());
+  }
+
+  // Signed packs verify every chunk the prefix is read from
+  const u64 offset = m_header.dataOffset + entry.dataOffset;
+  const auto readStored = [&](u64 at, u8 *to, usize size) -> Result<void> {
+    if (m_verifier) {
+      auto verified = m_verifier->verifyRange(at, size);
+      if (verified.isError()) {
+        return verified;
+      }
+    }
+    if (m_mapping) {
+      const auto bytes = m_mapping->bytes(at, size);
+      if (bytes.size() != size) {
+        return Result<void>::error("Resource data extends beyond pack file");
+      }
+      std::copy(bytes.begin(), bytes.end(), to);
+    } else if (!m_file || m_file->readAt(at, to, size).isError()) {
+      return Result<void>::error("Failed to read resource data");
+    }
+    return Result<void>::ok();
+  };
+
+  if (codec == PackCompression::None) {
+    if (out.size() > entry.compressedSize) {
+      return Result<usize>::error("Stored size mismatch");
+    }
+    auto result = readStored(offset, out.data(), out.size());
+    if (result.isError()) {
+      return Result<usize>::error(result.error());
+    }
+    return Result<usize>::ok(out.size());
+  }
+
+  auto decoder = PackDecompressStream::create(codec, out);
+  if (decoder.isError()) {
+    return Result<usize>::error(decoder.error());
+  }
+
+  // The decoder fails once its output is full and input remains, which is
+  // exactly where reading stops
+  const usize storedSize = static_cast<usize>(entry.compressedSize);
+  std::array<u8, kPrefixBlockSize> block;
+  for (usize done = 0;
+       done < storedSize && decoder.value().produced() < out.size();) {
+    const usize size = std::min(block.size(), storedSize - done);
+    auto read = readStored(offset + done, block.data(), size);
+    if (read.isError()) {
+      return Result<usize>::error(read.error());
+    }
+
+    auto result = decoder.value().write({block.data(), size});
+    if (result.isError() && decoder.value().produced() < out.size()) {
+      return Result<usize>::error(result.error());
+    }
+    done += size;
+  }
+
+  if (decoder.value().produced() < out.size()) {
+    return Result<usize>::error("Resource data ended early");
+  }
+  return Result<usize>::ok(out.size());
+}
+
+Result<ResourceView>
+SecurePackReader::readResourceView(const std::string &resourceId) {
+  const bool encrypted = (m_header.flags & detail::kPackFlagEncrypted) != 0;
+  const PackResourceEntry *found = m_isOpen ? findEntry(resourceId) : nullptr;
+  if (m_mapping && !encrypted && found &&
+      resourceCodec(*found) == PackCompression::None && !isChunked(*found)) {
+    const PackResourceEntry &entry = *found;
+    noteRead(entry);
+    auto storedResult = verifyStored(entry);
+    if (storedResult.isError()) {
+      return Result<ResourceView>::error(storedResult.error());
+    }
+    const auto bytes = m_mapping->bytes(m_header.dataOffset + entry.dataOffset,
+                                        entry.compressedSize);
+    auto verifyResult = verifyDecoded(entry, bytes);
+    if (verifyResult.isError()) {
+      return Result<ResourceView>::error(verifyResult.error());
+    }
+    return Result<ResourceView>::ok(ResourceView(m_mapping, bytes));
+  }
+
+  auto result = readResource(resourceId);
+  if (result.isError()) {
+    return Result<ResourceView>::error(result.error());
+  }
+  return Result<ResourceView>::ok(
+      ResourceView::fromBuffer(std::move(result).value()));
+}
+
+Result<std::unique_ptr<IFileHandle>>
+SecurePackReader::openResourceStream(const std::string &resourceId) {
+  using ResultType = Result<std::unique_ptr<IFileHandle>>;
+
+  if (!m_isOpen) {
+    return ResultType::error("Pack not open");
+  }
+
+  const PackResourceEntry *entry = findEntry(resourceId);
+  if (!entry) {
+    return ResultType::error("Resource not found: " + resourceId);
+  }
+
+  if (isChunked(*entry)) {
+    noteRead(*entry);
+    return openChunkedStream(resourceId, *entry);
+  }
+
+  auto data = readResource(resourceId);
+  if (data.isError()) {
+    return ResultType::error(data.error());
+  }
+  return ResultType::ok(
+      std::make_unique<MemoryFileHandle>(std::move(data).value()));
+}
+
+Result<std::unique_ptr<IFileHandle>>
+SecurePackReader::openChunkedStream(const std::string &resourceId,
+                                    const PackResourceEntry &entry) const {
+  using ResultType = Result<std::unique_ptr<IFileHandle>>;
+
+  ChunkedResourceSource source;
+  source.mapping = m_mapping;
+  source.file = m_file;
+  source.offset = m_header.dataOffset + entry.dataOffset;
+  source.storedSize = entry.compressedSize;
+  source.uncompressedSize = entry.uncompressedSize;
+  source.codec = resourceCodec(entry);
+  source.verifier = m_verifier;
+
+  if ((m_header.flags & detail::kPackFlagEncrypted) != 0) {
+    if (!m_decryptor) {
+      return ResultType::error("Decryptor not configured");
+    }
+    source.decryptor = *m_decryptor;
+    std::memcpy(source.iv.data(), entry.iv, sizeof(entry.iv));
+    source.aad = PackDecryptor::resourceAad(resourceId, entry.type,
+                                            entry.uncompressedSize);
+  }
+
+  auto handle = ChunkedFileHandle::open(std::move(source));
+  if (handle.isError()) {
+    return ResultType::error(handle.error());
   }
+  return ResultType::ok(std::move(handle).value());
+}
 
-  const u64 absoluteOffset = m_header.dataOffset + entry.dataOffset;
-  file.seekg(static_cast<std::streamoff>(absoluteOffset));
-  if (!file) {
-    return Result<std::vector<u8>>::error("Failed to seek to resource data");
+Result<std::vector<u8>>
+SecurePackReader::readStoredBytes(const PackResourceEntry &entry) const {
+  if (!m_file) {
+    return Result<std::vector<u8>>::error("Failed to open pack file");
   }
 
   std::vector<u8> data(static_cast<usize>(entry.compressedSize));
   if (!data.empty()) {
-    file.read(reinterpret_cast<char *>(data.data()),
-              static_cast<std::streamsize>(data.size()));
-    if (!file) {
+    const u64 absoluteOffset = m_header.dataOffset + entry.dataOffset;
+    if (m_file->readAt(absoluteOffset, data.data(), data.size()).isError()) {
       return Result<std::vector<u8>>::error("Failed to read resource data");
     }
   }
 
+  return Result<std::vector<u8>>::ok(std::move(data));
+}
+
+Result<void> SecurePackReader::decodeInto(const std::string &resourceId,
+                                          const PackResourceEntry &entry,
+                                          std::span<u8> out) const {
   const bool encrypted = (m_header.flags & detail::kPackFlagEncrypted) != 0;
-  const bool compressed = (m_header.flags & detail::kPackFlagCompressed) != 0;
+  const PackCompression codec = resourceCodec(entry);
+  const u64 offset = m_header.dataOffset + entry.dataOffset;
+  const usize storedSize = static_cast<usize>(entry.compressedSize);
 
-  if (encrypted) {
-    if (!m_decryptor) {
-      return Result<std::vector<u8>>::error("Decryptor not configured");
-    }
-
-    std::vector<u8> aad;
-    aad.reserve(resourceId.size() + 1 + sizeof(u32) + sizeof(u64));
-    aad.insert(aad.end(), resourceId.begin(), resourceId.end());
-    aad.push_back(0);
-
-    auto appendU32 = [&aad](u32 value) {
-      aad.push_back(static_cast<u8>(value & 0xFF));
-      aad.push_back(static_cast<u8>((value >> 8) & 0xFF));
-      aad.push_back(static_cast<u8>((value >> 16) & 0xFF));
-      aad.push_back(static_cast<u8>((value >> 24) & 0xFF));
-    };
-    auto appendU64 = [&aad](u64 value) {
-      for (int i = 0; i < 8; ++i) {
-        aad.push_back(static_cast<u8>((value >> (i * 8)) & 0xFF));
+  auto storedResult = verifyStored(entry);
+  if (storedResult.isError()) {
+    return storedResult;
+  }
+
+  if (!encrypted && codec == PackCompression::None) {
+    // One copy out of the mapping, or one read straight into place
+    if (storedSize != out.size()) {
+      return Result<void>::error("Stored size mismatch");
+    }
+    if (m_mapping) {
+      const auto bytes = m_mapping->bytes(offset, storedSize);
+      if (bytes.size() != storedSize) {
+        return Result<void>::error("Resource data extends beyond pack file");
+      }
+      std::copy(bytes.begin(), bytes.end(), out.begin());
+    } else if (!out.empty()) {
+      if (!m_file || m_file->readAt(offset, out.data(), out.size()).isError()) {
+        return Result<void>::error("Failed to read resource data");
+      }
+    }
+    return verifyDecoded(entry, out);
+  }
+
+  if (encrypted && !m_decryptor) {
+    return Result<void>::error("Decryptor not configured");
+  }
+  const auto aad = encrypted ? PackDecryptor::resourceAad(
+                                   resourceId, entry.type,
+                                   entry.uncompressedSize)
+                             : std::vector<u8>{};
+
+  if (!PackDecompressStream::supportsStreaming(codec)) {
+    // LZ4 blocks decode in one call: gather the ciphertext once and
+    // decrypt it where it lies
+    std::vector<u8> stored;
+    std::span<const u8> input;
+    if (m_mapping && !encrypted) {
+      input = m_mapping->bytes(offset, storedSize);
+    } else if (m_mapping) {
+      const auto bytes = m_mapping->bytes(offset, storedSize);
+      stored.assign(bytes.begin(), bytes.end());
+      input = stored;
+    } else {
+      auto readResult = readStoredBytes(entry);
+      if (readResult.isError()) {
+        return Result<void>::error(readResult.error());
+      }
+      stored = std::move(readResult).value();
+      input = stored;
+    }
+    if (encrypted) {
+      auto plain = m_decryptor->decryptInto(
+          stored.data(), stored.size(), entry.iv, sizeof(entry.iv),
+          aad.data(), aad.size(), stored.data());
+      if (plain.isError()) {
+        return Result<void>::error(plain.error());
       }
-    };
+      input = std::span<const u8>(stored).first(plain.value());
+    }
+    auto result = PackCompressor::decompressInto(codec, input, out);
+    if (result.isError()) {
+      return result;
+    }
+    return verifyDecoded(entry, out);
+  }
 
-    appendU32(entry.type);
-    appendU64(entry.uncompressedSize);
+  auto decoder = PackDecompressStream::create(codec, out);
+  if (decoder.isError()) {
+    return Result<void>::error(decoder.error());
+  }
 
-    auto decrypted = m_decryptor->decrypt(
-        data.data(), data.size(), entry.iv, sizeof(entry.iv),
-        aad.empty() ? nullptr : aad.data(), aad.size());
-    if (!decrypted.isOk()) {
-      return Result<std::vector<u8>>::error(decrypted.error());
+  std::optional<PackDecryptor::Stream> cipher;
+  usize payloadSize = storedSize;
+  if (encrypted) {
+    if (storedSize <= PackDecryptor::kTagSize) {
+      return Result<void>::error("Encrypted payload too small");
+    }
+    auto stream = m_decryptor->beginStream(entry.iv, sizeof(entry.iv),
+                                           aad.data(), aad.size());
+    if (stream.isError()) {
+      return Result<void>::error(stream.error());
     }
-    data = std::move(decrypted.value());
+    cipher.emplace(std::move(stream).value());
+    payloadSize -= PackDecryptor::kTagSize;
   }
 
-  if (compressed) {
-#ifdef NOVELMIND_HAS_ZLIB
-    if (entry.uncompressedSize > std::numeric_limits<uLongf>::max()) {
-      return Result<std::vector<u8>>::error(
-          "Uncompressed size exceeds zlib limits");
+  // Ciphertext is decrypted a block at a time into the stack buffer (in
+  // place when it was read there) and handed straight to the decoder, which
+  // writes into @p out; the checksum follows the decoder's output while it
+  // is still in cache. A mapped plain stream feeds the decoder directly.
+  std::array<u8, kDecodeBlockSize> block;
+  const usize step = m_mapping && !cipher ? payloadSize : block.size();
+  u32 checksum = 0;
+  usize checked = 0;
+  for (usize done = 0; done < payloadSize;) {
+    const usize size = std::min(step, payloadSize - done);
+    const u8 *input = block.data();
+    if (m_mapping) {
+      const auto bytes = m_mapping->bytes(offset + done, size);
+      if (bytes.size() != size) {
+        return Result<void>::error("Resource data extends beyond pack file");
+      }
+      input = bytes.data();
+    } else if (!m_file ||
+               m_file->readAt(offset + done, block.data(), size).isError()) {
+      return Result<void>::error("Failed to read resource data");
     }
 
-    std::vector<u8> decompressed(
-        static_cast<usize>(entry.uncompressedSize));
-    uLongf destLen = static_cast<uLongf>(decompressed.size());
-    int res = uncompress(decompressed.data(), &destLen, data.data(),
-                         static_cast<uLongf>(data.size()));
-    if (res != Z_OK) {
-      return Result<std::vector<u8>>::error("zlib decompression failed");
+    if (cipher) {
+      auto result = cipher->update(input, block.data(), size);
+      if (result.isError()) {
+        return result;
+      }
+      input = block.data();
     }
-    decompressed.resize(static_cast<usize>(destLen));
-    data = std::move(decompressed);
-#else
-    return Result<std::vector<u8>>::error(
-        "Compressed pack requires zlib support");
-#endif
+
+    auto result = decoder.value().write({input, size});
+    if (result.isError()) {
+      return result;
+    }
+    const usize produced = decoder.value().produced();
+    checksum =
+        Crc32::update(checksum, out.data() + checked, produced - checked);
+    checked = produced;
+    done += size;
+  }
+
+  if (cipher) {
+    std::array<u8, PackDecryptor::kTagSize> tag{};
+    const u64 tagOffset = offset + payloadSize;
+    if (m_mapping) {
+      const auto bytes = m_mapping->bytes(tagOffset, tag.size());
+      if (bytes.size() != tag.size()) {
+        return Result<void>::error("Resource data extends beyond pack file");
+      }
+      std::copy(bytes.begin(), bytes.end(), tag.begin());
+    } else if (m_file->readAt(tagOffset, tag.data(), tag.size()).isError()) {
+      return Result<void>::error("Failed to read resource data");
+    }
+    auto result = cipher->finish(tag.data());
+    if (result.isError()) {
+      return result;
+    }
+  }
+
+  auto result = decoder.value().finish();
+  if (result.isError()) {
+    return result;
+  }
+  if (checksum != entry.checksum) {
+    return Result<void>::error("Resource checksum mismatch");
+  }
+  return Result<void>::ok();
+}
+
+PackCompression
+SecurePackReader::resourceCodec(const PackResourceEntry &entry) const {
+  if ((m_header.flags & detail::kPackFlagResourceCodecs) != 0) {
+    return PackCompressor::entryCodec(entry.flags);
   }
+  // Older packs compress every resource with zlib via the pack-wide flag
+  return (m_header.flags & detail::kPackFlagCompressed) != 0
+             ? PackCompression::Zlib
+             : PackCompression::None;
+}
+
+bool SecurePackReader::isChunked(const PackResourceEntry &entry) const {
+  return (m_header.flags & detail::kPackFlagResourceCodecs) != 0 &&
+         (entry.flags & ChunkedResource::kEntryFlagChunked) != 0;
+}
 
+Result<void>
+SecurePackReader::verifyStored(const PackResourceEntry &entry) const {
+  if (!m_verifier) {
+    return Result<void>::ok();
+  }
+  return m_verifier->verifyRange(m_header.dataOffset + entry.dataOffset,
+                                 entry.compressedSize);
+}
+
+Result<void> SecurePackReader::verifyDecoded(const PackResourceEntry &entry,
+                                             std::span<const u8> data) {
   if (!data.empty() && data.size() != entry.uncompressedSize) {
-    return Result<std::vector<u8>>::error(
-        "Resource size mismatch after decode");
+    return Result<void>::error("Resource size mismatch after decode");
   }
 
-  const u32 checksum = PackIntegrityChecker::calculateCrc32(data.data(),
-                                                            data.size());
+  const u32 checksum =
+      PackIntegrityChecker::calculateCrc32(data.data(), data.size());
   if (checksum != entry.checksum) {
-    return Result<std::vector<u8>>::error("Resource checksum mismatch");
+    return Result<void>::error("Resource checksum mismatch");
   }
 
-  return Result<std::vector<u8>>::ok(std::move(data));
+  return Result<void>::ok();
+}
+
+const SecurePackReader::PackResourceEntry *
+SecurePackReader::findEntry(std::string_view resourceId) const {
+  if (!m_index) {
+    auto it = m_entries.find(resourceId);
+    return it != m_entries.end() ? it->second : nullptr;
+  }
+
+  const auto slot = m_index->find(resourceId);
+  if (!slot) {
+    return nullptr;
+  }
+  const PackResourceEntry &entry = m_table[*slot];
+  const auto id = entryId(entry);
+  return id && !id->empty() && *id == resourceId ? &entry : nullptr;
+}
+
+std::optional<std::string_view>
+SecurePackReader::entryId(const PackResourceEntry &entry) const {
+  if (entry.idStringOffset >= m_stringCount) {
+    return std::nullopt;
+  }
+
+  u32 offset = 0;
+  std::memcpy(&offset, m_stringOffsets + entry.idStringOffset * sizeof(u32),
+              sizeof(offset));
+  if (offset >= m_stringData.size()) {
+    return std::nullopt;
+  }
+
+  const auto *str =
+      reinterpret_cast<const char *>(m_stringData.data() + offset);
+  const usize available = m_stringData.size() - offset;
+  const auto *terminator = static_cast<const char *>(
+      std::memchr(str, '\0', std::min(available, kMaxStringLength + 1)));
+  if (!terminator) {
+    return std::nullopt;
+  }
+  return std::string_view(str, static_cast<usize>(terminator - str));
 }
 
 bool SecurePackReader::exists(const std::string &resourceId) const {
-  return m_entries.find(resourceId) != m_entries.end();
+  return findEntry(resourceId) != nullptr;
+}
+
+usize SecurePackReader::resourceCount() const {
+  return m_index ? m_header.resourceCount : m_entries.size();
 }
 
 std::vector<std::string> SecurePackReader::listResources() const {
   std::vector<std::string> result;
-  result.reserve(m_entries.size());
-  for (const auto &pair : m_entries) {
-    result.push_back(pair.first);
+  if (!m_index) {
+    result.reserve(m_entries.size());
+    for (const auto &pair : m_entries) {
+      result.emplace_back(pair.first);
+    }
+    return result;
+  }
+
+  result.reserve(m_header.resourceCount);
+  for (u32 i = 0; i < m_header.resourceCount; ++i) {
+    const auto id = entryId(m_table[i]);
+    if (id && !id->empty()) {
+      result.emplace_back(*id);
+    }
   }
   return result;
 }
 
 std::optional<PackResourceMeta>
 SecurePackReader::getResourceMeta(const std::string &resourceId) const {
-  auto it = m_entries.find(resourceId);
-  if (it == m_entries.end()) {
+  const PackResourceEntry *entry = findEntry(resourceId);
+  if (!entry) {
     return std::nullopt;
   }
 
   PackResourceMeta meta;
-  meta.type = it->second.type;
-  meta.uncompressedSize = it->second.uncompressedSize;
-  meta.checksum = it->second.checksum;
+  meta.type = entry->type;
+  meta.uncompressedSize = entry->uncompressedSize;
+  meta.checksum = entry->checksum;
+  meta.delta = (m_header.flags & detail::kPackFlagResourceCodecs) != 0 &&
+               (entry->flags & PackDelta::kEntryFlagDelta) != 0;
   return meta;
 }
 
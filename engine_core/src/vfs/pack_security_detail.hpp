@@ -13,15 +13,21 @@ inline constexpr u16 kPackVersionMajor = 1;
 inline constexpr usize kResourceEntrySize = 48;
 inline constexpr usize kFooterSize = 32;
 inline constexpr usize kGcmTagSize = 16;
+// Largest resource the readers decode, stored or uncompressed
+inline constexpr u64 kMaxResourceSize = 512ULL * 1024 * 1024;
 inline constexpr u32 kPackFlagEncrypted = 1u << 0;
 inline constexpr u32 kPackFlagCompressed = 1u << 1;
 inline constexpr u32 kPackFlagSigned = 1u << 2;
+// Codec of each resource is stored in PackResourceEntry::flags
+inline constexpr u32 kPackFlagResourceCodecs = 1u << 3;
+// A PackHashIndex section ends the tables
+inline constexpr u32 kPackFlagHashIndex = 1u << 4;
+// A signed PackHashTree section follows the data section
+inline constexpr u32 kPackFlagMerkleSigned = 1u << 5;
 
 bool readFileToString(std::ifstream &file, std::string &out);
 bool readFileToBytes(std::ifstream &file, std::vector<u8> &out);
 
-u32 updateCrc32(u32 crc, const u8 *data, usize size);
-
 #ifndef NOVELMIND_HAS_OPENSSL
 struct Sha256Context {
   u8 data[64];
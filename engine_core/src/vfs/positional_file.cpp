@@ -0,0 +1,171 @@
+#include "NovelMind/vfs/positional_file.hpp"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NovelMind::VFS {
+
+PositionalFile::~PositionalFile() {
+#if defined(_WIN32)
+  if (m_handle) {
+    CloseHandle(static_cast<HANDLE>(m_handle));
+  }
+#else
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+#endif
+}
+
+Result<std::shared_ptr<const PositionalFile>>
+PositionalFile::open(const std::string &path) {
+  using ResultType = Result<std::shared_ptr<const PositionalFile>>;
+
+  std::shared_ptr<PositionalFile> file(new PositionalFile());
+  file->m_path = path;
+
+#if defined(_WIN32)
+  HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return ResultType::error("Failed to open file: " + path);
+  }
+  file->m_handle = handle;
+
+  LARGE_INTEGER fileSize{};
+  if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart < 0) {
+    return ResultType::error("Failed to determine file size: " + path);
+  }
+  file->m_size = static_cast<u64>(fileSize.QuadPart);
+#else
+  file->m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file->m_fd < 0) {
+    return ResultType::error("Failed to open file: " + path);
+  }
+
+  struct stat st {};
+  if (fstat(file->m_fd, &st) != 0 || st.st_size < 0) {
+    return ResultType::error("Failed to determine file size: " + path);
+  }
+  file->m_size = static_cast<u64>(st.st_size);
+#endif
+
+  return ResultType::ok(std::move(file));
+}
+
+Result<void> PositionalFile::readAt(u64 offset, u8 *dest, usize size) const {
+  if (offset > m_size || size > m_size - offset) {
+    return Result<void>::error("Read extends beyond end of file");
+  }
+
+  while (size > 0) {
+#if defined(_WIN32)
+    // Overlapped offsets make ReadFile positional on a synchronous handle
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFu);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    const DWORD chunk =
+        static_cast<DWORD>(std::min<usize>(size, 0x40000000u));
+    DWORD bytesRead = 0;
+    if (!ReadFile(static_cast<HANDLE>(m_handle), dest, chunk, &bytesRead,
+                  &overlapped) ||
+        bytesRead == 0) {
+      return Result<void>::error("Failed to read file: " + m_path);
+    }
+    const usize got = static_cast<usize>(bytesRead);
+#else
+    const usize chunk = std::min<usize>(size, 0x40000000u);
+    const ssize_t bytesRead =
+        ::pread(m_fd, dest, chunk, static_cast<off_t>(offset));
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Result<void>::error("Failed to read file: " + m_path);
+    }
+    if (bytesRead == 0) {
+      return Result<void>::error("Unexpected end of file: " + m_path);
+    }
+    const usize got = static_cast<usize>(bytesRead);
+#endif
+    dest += got;
+    offset += got;
+    size -= got;
+  }
+
+  return Result<void>::ok();
+}
+
+void PositionalFile::prefetch(u64 offset, u64 length) const {
+  if (offset >= m_size) {
+    return;
+  }
+  length = std::min<u64>(length, m_size - offset);
+#if defined(POSIX_FADV_WILLNEED)
+  ::posix_fadvise(m_fd, static_cast<off_t>(offset), static_cast<off_t>(length),
+                  POSIX_FADV_WILLNEED);
+#else
+  (void)length;
+#endif
+}
+
+PositionalFileHandle::PositionalFileHandle(
+    std::shared_ptr<const PositionalFile> file)
+    : m_file(std::move(file)),
+      m_size(m_file ? static_cast<usize>(m_file->size()) : 0) {}
+
+Result<usize> PositionalFileHandle::read(u8 *buffer, usize count) {
+  if (!m_file) {
+    return Result<usize>::error("Invalid file handle");
+  }
+  if (buffer == nullptr && count > 0) {
+    return Result<usize>::error("Null buffer");
+  }
+
+  const usize toRead = std::min(count, m_size - m_position);
+  if (toRead > 0) {
+    auto result = m_file->readAt(m_position, buffer, toRead);
+    if (result.isError()) {
+      return Result<usize>::error(result.error());
+    }
+    m_position += toRead;
+  }
+  return Result<usize>::ok(toRead);
+}
+
+Result<void> PositionalFileHandle::seek(i64 offset, SeekOrigin origin) {
+  if (!m_file) {
+    return Result<void>::error("Invalid file handle");
+  }
+
+  i64 newPosition = offset;
+  if (origin == SeekOrigin::Current) {
+    newPosition += static_cast<i64>(m_position);
+  } else if (origin == SeekOrigin::End) {
+    newPosition += static_cast<i64>(m_size);
+  }
+
+  if (newPosition < 0) {
+    return Result<void>::error("Seek position before beginning of file");
+  }
+  if (static_cast<usize>(newPosition) > m_size) {
+    return Result<void>::error("Seek position past end of file");
+  }
+  m_position = static_cast<usize>(newPosition);
+  return Result<void>::ok();
+}
+
+} // namespace NovelMind::VFS
@@ -1,147 +1,471 @@
 #include "NovelMind/vfs/resource_cache.hpp"
 
+#include <algorithm>
+
 namespace NovelMind::VFS {
 
-ResourceCache::ResourceCache(usize maxSize) : m_maxSize(maxSize) {}
+namespace {
 
-void ResourceCache::setMaxSize(usize maxSize) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_maxSize = maxSize;
-  evictIfNeeded(0);
+usize typeIndex(const ResourceId &id) {
+  return static_cast<usize>(id.type()) % kResourceTypeCount;
 }
 
-std::optional<std::vector<u8>> ResourceCache::get(const ResourceId &id) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+} // namespace
 
-  const auto it = m_cache.find(id);
-  if (it == m_cache.end()) {
-    ++m_stats.missCount;
-    return std::nullopt;
+// ============================================================================
+// CacheFrequencySketch
+// ============================================================================
+
+CacheFrequencySketch::CacheFrequencySketch(usize width) {
+  usize size = 16;
+  while (size < width) {
+    size <<= 1;
   }
+  m_counters.assign(size * kDepth, 0);
+  m_mask = size - 1;
+  m_sampleSize = size * 10;
+}
 
-  ++m_stats.hitCount;
-  it->second.lastAccess = std::chrono::steady_clock::now();
-  ++it->second.accessCount;
-  updateAccessOrder(id);
+usize CacheFrequencySketch::indexOf(u64 hash, usize row) const {
+  static constexpr u64 kSeeds[kDepth] = {
+      0xC3A5C85C97CB3127ULL, 0xB492B66FBE98F273ULL, 0x9AE16A3B2F90404FULL,
+      0xCBF29CE484222325ULL};
+  u64 h = (hash + kSeeds[row]) * 0x9E3779B97F4A7C15ULL;
+  h ^= h >> 32;
+  return row * (m_mask + 1) + static_cast<usize>(h & m_mask);
+}
 
-  return it->second.data;
+void CacheFrequencySketch::increment(u64 hash) {
+  bool added = false;
+  for (usize row = 0; row < kDepth; ++row) {
+    u8 &counter = m_counters[indexOf(hash, row)];
+    if (counter < kMaxCount) {
+      ++counter;
+      added = true;
+    }
+  }
+  if (added && ++m_additions >= m_sampleSize) {
+    age();
+  }
 }
 
-void ResourceCache::put(const ResourceId &id, std::vector<u8> data) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+u32 CacheFrequencySketch::frequency(u64 hash) const {
+  u32 result = kMaxCount;
+  for (usize row = 0; row < kDepth; ++row) {
+    result = std::min<u32>(result, m_counters[indexOf(hash, row)]);
+  }
+  return result;
+}
 
-  const usize dataSize = data.size();
+void CacheFrequencySketch::clear() {
+  std::fill(m_counters.begin(), m_counters.end(), static_cast<u8>(0));
+  m_additions = 0;
+}
 
-  if (dataSize > m_maxSize) {
-    return;
+void CacheFrequencySketch::age() {
+  for (u8 &counter : m_counters) {
+    counter = static_cast<u8>(counter >> 1);
   }
+  m_additions /= 2;
+}
 
-  const auto existingIt = m_cache.find(id);
-  if (existingIt != m_cache.end()) {
-    m_currentSize -= existingIt->second.data.size();
-    m_cache.erase(existingIt);
-    // Decrement entry count when removing existing entry
-    if (m_stats.entryCount > 0) {
-      --m_stats.entryCount;
-    }
+// ============================================================================
+// ResourceCache
+// ============================================================================
 
-    const auto orderIt = m_orderIterators.find(id);
-    if (orderIt != m_orderIterators.end()) {
-      m_accessOrder.erase(orderIt->second);
-      m_orderIterators.erase(orderIt);
-    }
-  }
+ResourceCache::ResourceCache(usize maxSize, usize shardCount)
+    : m_shards(std::make_unique<Shard[]>(std::max<usize>(shardCount, 1))),
+      m_shardCount(std::max<usize>(shardCount, 1)), m_maxSize(maxSize) {}
 
-  evictIfNeeded(dataSize);
+ResourceCache::~ResourceCache() = default;
 
-  CacheEntry entry;
-  entry.data = std::move(data);
-  entry.lastAccess = std::chrono::steady_clock::now();
-  entry.accessCount = 1;
+void ResourceCache::setMaxSize(usize maxSize) {
+  m_maxSize.store(maxSize, std::memory_order_relaxed);
+  maintain(0);
+}
 
-  m_cache[id] = std::move(entry);
-  m_currentSize += dataSize;
+void ResourceCache::setWindowFraction(f32 fraction) {
+  m_windowFraction.store(std::clamp(fraction, 0.0f, 0.5f),
+                         std::memory_order_relaxed);
+  maintain(0);
+}
 
-  m_accessOrder.push_front(id);
-  m_orderIterators[id] = m_accessOrder.begin();
+void ResourceCache::setTypePolicy(ResourceType type,
+                                  const CacheTypePolicy &policy) {
+  std::lock_guard<std::mutex> lock(m_policyMutex);
+  m_policies[static_cast<usize>(type) % kResourceTypeCount] = policy;
+}
 
-  ++m_stats.entryCount;
+CacheTypePolicy ResourceCache::typePolicy(ResourceType type) const {
+  std::lock_guard<std::mutex> lock(m_policyMutex);
+  return m_policies[static_cast<usize>(type) % kResourceTypeCount];
 }
 
-void ResourceCache::remove(const ResourceId &id) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+SharedBuffer ResourceCache::get(const ResourceId &id) {
+  Shard &shard = m_shards[shardIndexFor(id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  const auto it = m_cache.find(id);
-  if (it != m_cache.end()) {
-    m_currentSize -= it->second.data.size();
-    m_cache.erase(it);
+  shard.sketch.increment(id.hash());
+  CacheTypeStats &typeStats = shard.typeStats[typeIndex(id)];
 
-    const auto orderIt = m_orderIterators.find(id);
-    if (orderIt != m_orderIterators.end()) {
-      m_accessOrder.erase(orderIt->second);
-      m_orderIterators.erase(orderIt);
+  const auto it = shard.index.find(id);
+  if (it == shard.index.end()) {
+    ++typeStats.missCount;
+    return nullptr;
+  }
+
+  Slot &slot = shard.slots[it->second];
+  ++typeStats.hitCount;
+  typeStats.hitBytes += slot.data->size();
+  slot.referenced = true;
+  return slot.data;
+}
+
+SharedBuffer ResourceCache::put(const ResourceId &id, std::vector<u8> data) {
+  auto shared = std::make_shared<const std::vector<u8>>(std::move(data));
+  put(id, shared);
+  return shared;
+}
+
+void ResourceCache::put(const ResourceId &id, SharedBuffer data) {
+  if (!data) {
+    return;
+  }
+
+  const CacheTypePolicy policy = typePolicy(id.type());
+  const usize size = data->size();
+  const usize shardIndex = shardIndexFor(id);
+  Shard &shard = m_shards[shardIndex];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.index.find(id);
+    if (it != shard.index.end()) {
+      Slot &slot = shard.slots[it->second];
+      auto &region = slot.inWindow ? m_windowSize : m_mainSize;
+      region.fetch_sub(slot.data->size(), std::memory_order_relaxed);
+      region.fetch_add(size, std::memory_order_relaxed);
+      slot.data = std::move(data);
+      slot.referenced = true;
+    } else {
+      CacheTypeStats &typeStats = shard.typeStats[typeIndex(id)];
+      typeStats.missBytes += size;
+
+      if (!policy.cacheable || size > maxSize() ||
+          (policy.maxEntrySize > 0 && size > policy.maxEntrySize)) {
+        ++typeStats.rejectedCount;
+        return;
+      }
+
+      usize slotIndex = 0;
+      if (!shard.freeSlots.empty()) {
+        slotIndex = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+      } else {
+        slotIndex = shard.slots.size();
+        shard.slots.emplace_back();
+      }
+
+      Slot &slot = shard.slots[slotIndex];
+      slot.id = id;
+      slot.data = std::move(data);
+      slot.referenced = false;
+      slot.inWindow = !policy.bypassAdmission;
+      shard.index.emplace(id, slotIndex);
+      m_entryCount.fetch_add(1, std::memory_order_relaxed);
+
+      if (slot.inWindow) {
+        shard.window.push_back(slotIndex);
+        m_windowSize.fetch_add(size, std::memory_order_relaxed);
+      } else {
+        m_mainSize.fetch_add(size, std::memory_order_relaxed);
+      }
     }
+  }
+
+  maintain(shardIndex);
+}
+
+void ResourceCache::remove(const ResourceId &id) {
+  Shard &shard = m_shards[shardIndexFor(id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-    --m_stats.entryCount;
+  const auto it = shard.index.find(id);
+  if (it != shard.index.end()) {
+    releaseSlot(shard, it->second);
   }
 }
 
 void ResourceCache::clear() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_cache.clear();
-  m_accessOrder.clear();
-  m_orderIterators.clear();
-  m_currentSize = 0;
-  m_stats.entryCount = 0;
+  for (usize i = 0; i < m_shardCount; ++i) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.window.clear();
+    for (usize slot = 0; slot < shard.slots.size(); ++slot) {
+      if (shard.slots[slot].data) {
+        releaseSlot(shard, slot);
+      }
+    }
+    shard.slots.clear();
+    shard.freeSlots.clear();
+    shard.hand = 0;
+    shard.sketch.clear();
+  }
 }
 
 bool ResourceCache::contains(const ResourceId &id) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  return m_cache.find(id) != m_cache.end();
+  const Shard &shard = m_shards[shardIndexFor(id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.index.find(id) != shard.index.end();
 }
 
 CacheStats ResourceCache::stats() const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  CacheStats result;
+  for (usize i = 0; i < m_shardCount; ++i) {
+    const Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result.evictionCount += shard.evictionCount;
+    for (usize type = 0; type < kResourceTypeCount; ++type) {
+      const CacheTypeStats &source = shard.typeStats[type];
+      CacheTypeStats &target = result.byType[type];
+      target.hitCount += source.hitCount;
+      target.missCount += source.missCount;
+      target.hitBytes += source.hitBytes;
+      target.missBytes += source.missBytes;
+      target.rejectedCount += source.rejectedCount;
+    }
+  }
 
-  CacheStats result = m_stats;
-  result.totalSize = m_currentSize;
-  result.entryCount = m_cache.size();
+  for (const CacheTypeStats &typeStats : result.byType) {
+    result.hitCount += typeStats.hitCount;
+    result.missCount += typeStats.missCount;
+    result.hitBytes += typeStats.hitBytes;
+    result.missBytes += typeStats.missBytes;
+    result.rejectedCount += typeStats.rejectedCount;
+  }
+  result.totalSize = currentSize();
+  result.entryCount = entryCount();
   return result;
 }
 
 void ResourceCache::resetStats() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_stats.hitCount = 0;
-  m_stats.missCount = 0;
-  m_stats.evictionCount = 0;
-}
-
-void ResourceCache::evictIfNeeded(usize requiredSpace) {
-  while (m_currentSize + requiredSpace > m_maxSize && !m_accessOrder.empty()) {
-    const ResourceId &lruId = m_accessOrder.back();
-    const auto it = m_cache.find(lruId);
-
-    if (it != m_cache.end()) {
-      m_currentSize -= it->second.data.size();
-      m_cache.erase(it);
-      ++m_stats.evictionCount;
-      // Decrement entry count when evicting
-      if (m_stats.entryCount > 0) {
-        --m_stats.entryCount;
-      }
+  for (usize i = 0; i < m_shardCount; ++i) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.typeStats = {};
+    shard.evictionCount = 0;
+  }
+}
+
+usize ResourceCache::shardIndexFor(const ResourceId &id) const {
+  return static_cast<usize>(id.hash() % m_shardCount);
+}
+
+usize ResourceCache::windowBudget() const {
+  return static_cast<usize>(
+      static_cast<f64>(maxSize()) *
+      static_cast<f64>(m_windowFraction.load(std::memory_order_relaxed)));
+}
+
+f64 ResourceCache::weightedFrequency(const Shard &shard,
+                                     const ResourceId &id) const {
+  return static_cast<f64>(shard.sketch.frequency(id.hash())) *
+         static_cast<f64>(typePolicy(id.type()).frequencyWeight);
+}
+
+void ResourceCache::releaseSlot(Shard &shard, usize slotIndex) {
+  Slot &slot = shard.slots[slotIndex];
+  if (slot.inWindow) {
+    m_windowSize.fetch_sub(slot.data->size(), std::memory_order_relaxed);
+    const auto it =
+        std::find(shard.window.begin(), shard.window.end(), slotIndex);
+    if (it != shard.window.end()) {
+      shard.window.erase(it);
     }
+  } else {
+    m_mainSize.fetch_sub(slot.data->size(), std::memory_order_relaxed);
+  }
+  m_entryCount.fetch_sub(1, std::memory_order_relaxed);
 
-    m_orderIterators.erase(lruId);
-    m_accessOrder.pop_back();
+  shard.index.erase(slot.id);
+  slot.id = ResourceId();
+  slot.data.reset();
+  slot.referenced = false;
+  slot.inWindow = false;
+  shard.freeSlots.push_back(slotIndex);
+}
+
+bool ResourceCache::evictMainOne(Shard &shard) {
+  const usize slotCount = shard.slots.size();
+  // Two sweeps: the first may only clear reference bits
+  for (usize step = 0; step < 2 * slotCount; ++step) {
+    const usize slotIndex = shard.hand;
+    shard.hand = (shard.hand + 1) % slotCount;
+
+    Slot &slot = shard.slots[slotIndex];
+    if (!slot.data || slot.inWindow) {
+      continue;
+    }
+    if (slot.referenced) {
+      slot.referenced = false;
+      continue;
+    }
+
+    releaseSlot(shard, slotIndex);
+    ++shard.evictionCount;
+    return true;
+  }
+  return false;
+}
+
+bool ResourceCache::evictWindowOne(Shard &shard) {
+  if (shard.window.empty()) {
+    return false;
   }
+  releaseSlot(shard, shard.window.front());
+  ++shard.evictionCount;
+  return true;
 }
 
-void ResourceCache::updateAccessOrder(const ResourceId &id) {
-  const auto orderIt = m_orderIterators.find(id);
-  if (orderIt != m_orderIterators.end()) {
-    m_accessOrder.erase(orderIt->second);
-    m_accessOrder.push_front(id);
-    m_orderIterators[id] = m_accessOrder.begin();
+bool ResourceCache::admitFromWindow(Shard &shard) {
+  if (shard.window.empty()) {
+    return false;
+  }
+
+  // Second chance inside the window: entries hit since they arrived go to
+  // the back once before they are judged
+  usize candidate = shard.window.front();
+  for (usize step = 0, count = shard.window.size(); step < count; ++step) {
+    candidate = shard.window.front();
+    if (!shard.slots[candidate].referenced) {
+      break;
+    }
+    shard.slots[candidate].referenced = false;
+    shard.window.pop_front();
+    shard.window.push_back(candidate);
+    candidate = shard.window.front();
+  }
+  shard.window.pop_front();
+
+  Slot &slot = shard.slots[candidate];
+  const usize size = slot.data->size();
+  auto promote = [&]() {
+    slot.inWindow = false;
+    m_windowSize.fetch_sub(size, std::memory_order_relaxed);
+    m_mainSize.fetch_add(size, std::memory_order_relaxed);
+  };
+
+  const usize window = windowBudget();
+  const usize mainBudget = maxSize() > window ? maxSize() - window : 0;
+  const usize mainSize = m_mainSize.load(std::memory_order_relaxed);
+  if (mainSize + size <= mainBudget) {
+    promote();
+    return true;
+  }
+
+  // Collect CLOCK victims covering the overflow, from this shard first and
+  // then from the others; bigger candidates have to beat more of them
+  const usize needed = mainSize + size - mainBudget;
+  std::vector<Victim> victims;
+  std::vector<std::unique_lock<std::mutex>> locks;
+  usize freed = collectVictims(shard, needed, victims);
+  const auto self = static_cast<usize>(&shard - m_shards.get());
+  for (usize offset = 1; offset < m_shardCount && freed < needed; ++offset) {
+    Shard &other = m_shards[(self + offset) % m_shardCount];
+    // Never wait for a second shard, so concurrent admissions cannot
+    // deadlock; a busy shard just offers no victims this time
+    std::unique_lock<std::mutex> lock(other.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      continue;
+    }
+    const usize before = victims.size();
+    freed += collectVictims(other, needed - freed, victims);
+    if (victims.size() > before) {
+      locks.push_back(std::move(lock));
+    }
+  }
+
+  // Nothing enters main without winning against everything it displaces
+  const f64 candidateFrequency = weightedFrequency(shard, slot.id);
+  bool admitted = freed >= needed;
+  for (usize i = 0; i < victims.size() && admitted; ++i) {
+    const Victim &victim = victims[i];
+    admitted = weightedFrequency(*victim.shard,
+                                 victim.shard->slots[victim.slot].id) <
+               candidateFrequency;
+  }
+  if (!admitted) {
+    ++shard.typeStats[typeIndex(slot.id)].rejectedCount;
+    // Re-inserted into the window list so releaseSlot finds a consistent
+    // state; it is removed again right away
+    shard.window.push_front(candidate);
+    releaseSlot(shard, candidate);
+    return true;
+  }
+
+  for (const Victim &victim : victims) {
+    releaseSlot(*victim.shard, victim.slot);
+    ++victim.shard->evictionCount;
+  }
+  promote();
+  return true;
+}
+
+usize ResourceCache::collectVictims(Shard &shard, usize needed,
+                                    std::vector<Victim> &victims) {
+  usize freed = 0;
+  const usize slotCount = shard.slots.size();
+  const usize first = victims.size();
+  for (usize step = 0; step < 2 * slotCount && freed < needed; ++step) {
+    const usize slotIndex = shard.hand;
+    shard.hand = (shard.hand + 1) % slotCount;
+
+    Slot &victim = shard.slots[slotIndex];
+    if (!victim.data || victim.inWindow ||
+        std::any_of(victims.begin() + static_cast<std::ptrdiff_t>(first),
+                    victims.end(), [slotIndex](const Victim &chosen) {
+                      return chosen.slot == slotIndex;
+                    })) {
+      continue;
+    }
+    if (victim.referenced) {
+      victim.referenced = false;
+      continue;
+    }
+    victims.push_back(Victim{&shard, slotIndex});
+    freed += victim.data->size();
+  }
+  return freed;
+}
+
+void ResourceCache::maintain(usize startShard) {
+  // Age entries out of the window through the admission filter
+  usize idleShards = 0;
+  for (usize i = startShard;
+       m_windowSize.load(std::memory_order_relaxed) > windowBudget() &&
+       idleShards < m_shardCount;
+       i = (i + 1) % m_shardCount) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (admitFromWindow(shard)) {
+      idleShards = 0;
+    } else {
+      ++idleShards;
+    }
+  }
+
+  // Then enforce the overall budget, starting with the shard that grew
+  idleShards = 0;
+  for (usize i = startShard; currentSize() > maxSize() &&
+                             idleShards < m_shardCount;
+       i = (i + 1) % m_shardCount) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (evictMainOne(shard) || evictWindowOne(shard)) {
+      idleShards = 0;
+    } else {
+      ++idleShards;
+    }
   }
 }
 
@@ -0,0 +1,36 @@
+#include "NovelMind/vfs/resource_view.hpp"
+
+namespace NovelMind::VFS {
+
+ResourceView::ResourceView(std::shared_ptr<const void> owner,
+                           std::span<const u8> bytes)
+    : m_owner(std::move(owner)), m_bytes(bytes), m_mapped(true) {}
+
+ResourceView ResourceView::fromBuffer(std::vector<u8> buffer) {
+  return fromShared(std::make_shared<const std::vector<u8>>(std::move(buffer)));
+}
+
+ResourceView
+ResourceView::fromShared(std::shared_ptr<const std::vector<u8>> buffer) {
+  ResourceView view;
+  if (buffer) {
+    view.m_bytes = std::span<const u8>(buffer->data(), buffer->size());
+    view.m_owner = std::move(buffer);
+  }
+  view.m_mapped = false;
+  return view;
+}
+
+std::shared_ptr<const std::vector<u8>> ResourceView::buffer() const {
+  if (m_mapped || !m_owner) {
+    return nullptr;
+  }
+  // Unmapped views are always owned by a vector (fromBuffer/fromShared)
+  return std::static_pointer_cast<const std::vector<u8>>(m_owner);
+}
+
+std::vector<u8> ResourceView::toVector() const {
+  return std::vector<u8>(m_bytes.begin(), m_bytes.end());
+}
+
+} // namespace NovelMind::VFS
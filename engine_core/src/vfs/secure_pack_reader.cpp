@@ -90,10 +90,55 @@ SecurePackFileSystem::readFile(const std::string &resourceId) const {
   return m_reader->readResource(resourceId);
 }
 
+Result<NovelMind::VFS::ResourceView>
+SecurePackFileSystem::readFileView(const std::string &resourceId) const {
+  if (!m_reader || !m_reader->isOpen()) {
+    return Result<NovelMind::VFS::ResourceView>::error("Pack not mounted");
+  }
+  return m_reader->readResourceView(resourceId);
+}
+
+Result<usize>
+SecurePackFileSystem::readFilePrefix(const std::string &resourceId,
+                                     std::span<u8> destination) const {
+  if (!m_reader || !m_reader->isOpen()) {
+    return Result<usize>::error("Pack not mounted");
+  }
+  return m_reader->readResourcePrefix(resourceId, destination);
+}
+
+Result<std::unique_ptr<NovelMind::VFS::IFileHandle>>
+SecurePackFileSystem::openStream(const std::string &resourceId) const {
+  if (!m_reader || !m_reader->isOpen()) {
+    return Result<std::unique_ptr<NovelMind::VFS::IFileHandle>>::error(
+        "Pack not mounted");
+  }
+  return m_reader->openResourceStream(resourceId);
+}
+
 bool SecurePackFileSystem::exists(const std::string &resourceId) const {
   return m_reader && m_reader->isOpen() && m_reader->exists(resourceId);
 }
 
+usize SecurePackFileSystem::resourceCount() const {
+  return m_reader && m_reader->isOpen() ? m_reader->resourceCount() : 0;
+}
+
+bool SecurePackFileSystem::isDelta(const std::string &resourceId) const {
+  if (!m_reader || !m_reader->isOpen()) {
+    return false;
+  }
+  auto meta = m_reader->getResourceMeta(resourceId);
+  return meta.has_value() && meta->delta;
+}
+
+void SecurePackFileSystem::prefetch(
+    std::span<const std::string> resourceIds) const {
+  if (m_reader && m_reader->isOpen()) {
+    m_reader->prefetch(resourceIds);
+  }
+}
+
 std::optional<ResourceInfo>
 SecurePackFileSystem::getInfo(const std::string &resourceId) const {
   if (!m_reader || !m_reader->isOpen()) {
@@ -1,4 +1,5 @@
 #include "NovelMind/vfs/virtual_file_system.hpp"
+#include "NovelMind/vfs/directory_backend.hpp"
 #include <algorithm>
 
 namespace NovelMind::VFS {
@@ -40,6 +41,14 @@ Result<void> VirtualFileSystem::initialize() {
 }
 
 void VirtualFileSystem::shutdown() {
+  // Join the I/O threads before taking m_mutex; they take it themselves
+  std::unique_ptr<AsyncReader> asyncReader;
+  {
+    std::lock_guard<std::mutex> asyncLock(m_asyncMutex);
+    asyncReader = std::move(m_asyncReader);
+  }
+  asyncReader.reset();
+
   std::lock_guard<std::mutex> lock(m_mutex);
 
   if (!m_initialized) {
@@ -65,6 +74,12 @@ void VirtualFileSystem::registerBackend(
     return;
   }
 
+  // Edited files must not keep being served from the cache
+  if (auto *directory = dynamic_cast<DirectoryBackend *>(backend.get())) {
+    directory->setChangeCallback(
+        [this](const ResourceId &id) { onResourceChanged(id); });
+  }
+
   m_backends.push_back(std::move(backend));
   sortBackendsByPriority();
 }
@@ -92,39 +107,79 @@ VirtualFileSystem::openStream(const ResourceId &id) {
   if (m_loadCallback) {
     m_loadCallback(id, handle != nullptr);
   }
+  if (m_traceRecorder && handle) {
+    m_traceRecorder->recordRead(id.id(), handle->size());
+  }
 
   return handle;
 }
 
+void VirtualFileSystem::setTraceRecorder(
+    std::shared_ptr<AccessTraceRecorder> recorder) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_traceRecorder = std::move(recorder);
+}
+
 Result<std::vector<u8>> VirtualFileSystem::readAll(const ResourceId &id) {
+  auto shared = readShared(id);
+  if (shared.isError()) {
+    return Result<std::vector<u8>>::error(shared.error());
+  }
+  return Result<std::vector<u8>>::ok(*shared.value());
+}
+
+Result<SharedBuffer> VirtualFileSystem::readShared(const ResourceId &id) {
   if (m_config.enableCaching && m_cache) {
-    auto cached = m_cache->get(id);
-    if (cached.has_value()) {
-      return Result<std::vector<u8>>::ok(std::move(*cached));
+    if (auto cached = m_cache->get(id)) {
+      return Result<SharedBuffer>::ok(std::move(cached));
     }
   }
 
   auto handle = openStream(id);
   if (!handle || !handle->isValid()) {
-    return Result<std::vector<u8>>::error("Resource not found: " + id.id());
+    return Result<SharedBuffer>::error("Resource not found: " + id.id());
   }
 
   auto result = handle->readAll();
   if (!result.isOk()) {
-    return result;
+    return Result<SharedBuffer>::error(result.error());
   }
 
   if (m_config.enableCaching && m_cache) {
-    m_cache->put(id, result.value());
+    return Result<SharedBuffer>::ok(
+        m_cache->put(id, std::move(result).value()));
   }
-
-  return result;
+  return Result<SharedBuffer>::ok(
+      std::make_shared<const std::vector<u8>>(std::move(result).value()));
 }
 
 Result<std::vector<u8>> VirtualFileSystem::readAll(const std::string &id) {
   return readAll(ResourceId(id));
 }
 
+AsyncReadHandle VirtualFileSystem::readAsync(const ResourceId &id,
+                                             ReadPriority priority,
+                                             AsyncReadCallback callback) {
+  std::lock_guard<std::mutex> lock(m_asyncMutex);
+  if (!m_asyncReader) {
+    m_asyncReader = std::make_unique<AsyncReader>(
+        [this](const ResourceId &resource) { return readShared(resource); },
+        m_config.ioThreadCount);
+  }
+  return m_asyncReader->submit(id, priority, std::move(callback));
+}
+
+usize VirtualFileSystem::processCompletions(usize maxCount) {
+  // Called from the main thread, like shutdown(); callbacks run unlocked so
+  // they can issue further reads
+  AsyncReader *reader = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    reader = m_asyncReader.get();
+  }
+  return reader ? reader->dispatchCompletions(maxCount) : 0;
+}
+
 bool VirtualFileSystem::exists(const ResourceId &id) const {
   std::lock_guard<std::mutex> lock(m_mutex);
 
@@ -177,12 +232,42 @@ void VirtualFileSystem::clearCache() {
   }
 }
 
+void VirtualFileSystem::invalidate(const ResourceId &id) {
+  if (m_cache) {
+    m_cache->remove(id);
+  }
+}
+
+void VirtualFileSystem::setChangeCallback(ResourceChangeCallback callback) {
+  std::lock_guard<std::mutex> lock(m_changeMutex);
+  m_changeCallback = std::move(callback);
+}
+
+void VirtualFileSystem::onResourceChanged(const ResourceId &id) {
+  invalidate(id);
+  ResourceChangeCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(m_changeMutex);
+    callback = m_changeCallback;
+  }
+  if (callback) {
+    callback(id);
+  }
+}
+
 void VirtualFileSystem::setCacheMaxSize(usize maxSize) {
   if (m_cache) {
     m_cache->setMaxSize(maxSize);
   }
 }
 
+void VirtualFileSystem::setCachePolicy(ResourceType type,
+                                       const CacheTypePolicy &policy) {
+  if (m_cache) {
+    m_cache->setTypePolicy(type, policy);
+  }
+}
+
 VFSStats VirtualFileSystem::stats() const {
   std::lock_guard<std::mutex> lock(m_mutex);
 
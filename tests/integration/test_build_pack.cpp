@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/editor/build_system.hpp"
+#include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/vfs/secure_pack_reader.hpp"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::editor;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeImage(const fs::path &path, i32 width, i32 height,
+                renderer::Color color) {
+  std::vector<u8> rgba;
+  for (i32 i = 0; i < width * height; ++i) {
+    rgba.insert(rgba.end(), {color.r, color.g, color.b, color.a});
+  }
+  const auto tga =
+      renderer::TextureAtlasBuilder::encodeTga(rgba.data(), width, height);
+  fs::create_directories(path.parent_path());
+  std::ofstream out(path, std::ios::binary);
+  out.write(reinterpret_cast<const char *>(tga.data()),
+            static_cast<std::streamsize>(tga.size()));
+}
+
+} // namespace
+
+// =============================================================================
+// Pack ids
+// =============================================================================
+
+TEST_CASE("BuildUtils - Pack ids are relative to the staged assets",
+          "[build][pack]") {
+  const fs::path root = fs::path("staging") / "assets";
+  CHECK(BuildUtils::packResourceId(
+            (root / "characters" / "hero" / "happy.png").string(),
+            root.string()) == "characters/hero/happy.png");
+  CHECK(BuildUtils::packResourceId((root / "atlas.json").string(),
+                                   root.string()) == "atlas.json");
+  CHECK(BuildUtils::packResourceId("elsewhere/readme.txt", root.string()) ==
+        "readme.txt");
+}
+
+TEST_CASE("BuildUtils - Atlased sprites load from a built pack",
+          "[build][pack][atlas]") {
+  renderer::Texture::setGpuUploadEnabled(false);
+  const fs::path dir = fs::temp_directory_path() / "novelmind_build_pack_test";
+  fs::remove_all(dir);
+  const fs::path sourceAssets = dir / "project" / "assets";
+  const fs::path stagedAssets = dir / "staging" / "assets";
+
+  writeImage(sourceAssets / "characters" / "hero" / "happy.tga", 8, 8,
+             renderer::Color::Red);
+  writeImage(sourceAssets / "characters" / "hero" / "sad.tga", 4, 12,
+             renderer::Color::Green);
+  // Backgrounds are never atlased
+  writeImage(stagedAssets / "bg" / "room.tga", 16, 9, renderer::Color::Blue);
+
+  AssetProcessor processor;
+  auto atlasResult = processor.generateTextureAtlas(
+      {(sourceAssets / "characters" / "hero" / "happy.tga").string(),
+       (sourceAssets / "characters" / "hero" / "sad.tga").string()},
+      stagedAssets.string(), 256, sourceAssets.string());
+  REQUIRE(atlasResult.isOk());
+  REQUIRE(processor.getAtlasIndex().spriteCount() == 2);
+
+  std::vector<std::string> files = {atlasResult.value(),
+                                    (stagedAssets / "bg" / "room.tga").string()};
+  for (const auto &page : processor.getAtlasIndex().pages()) {
+    files.push_back((stagedAssets / page.id).string());
+  }
+
+  const fs::path packPath = dir / "Base.nmres";
+  PackBuilder builder;
+  REQUIRE(builder.beginPack(packPath.string()).isOk());
+  for (const auto &file : files) {
+    REQUIRE(builder
+                .addFile(file, BuildUtils::packResourceId(
+                                   file, stagedAssets.string()))
+                .isOk());
+  }
+  REQUIRE(builder.finalizePack().isOk());
+
+  vfs::SecurePackFileSystem pack;
+  REQUIRE(pack.mount(packPath.string()).isOk());
+  resource::ResourceManager resources(&pack);
+
+  auto happy = resources.loadTexture("characters/hero/happy.tga");
+  REQUIRE(happy.isOk());
+  REQUIRE(happy.value().isValid());
+  CHECK(happy.value().width() == 8.0f);
+  CHECK(happy.value().height() == 8.0f);
+
+  auto sad = resources.loadTexture("assets/characters/hero/sad.tga");
+  REQUIRE(sad.isOk());
+  CHECK(sad.value().texture == happy.value().texture);
+  CHECK(sad.value().height() == 12.0f);
+
+  auto room = resources.loadTexture("bg/room.tga");
+  REQUIRE(room.isOk());
+  CHECK(room.value().sourceRect.x == 0.0f);
+  CHECK(room.value().width() == 16.0f);
+
+  pack.unmountAll();
+  fs::remove_all(dir);
+}
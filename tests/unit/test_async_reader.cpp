@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/async_reader.hpp"
+#include "NovelMind/vfs/virtual_file_system.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::VFS;
+
+namespace {
+
+// Read function that records the order of reads and can hold the I/O thread
+class GatedSource
+{
+public:
+    Result<SharedBuffer> read(const ResourceId& id)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_order.push_back(id.id());
+        ++m_started;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this]() { return m_open; });
+        return Result<SharedBuffer>::ok(std::make_shared<const std::vector<u8>>(
+            std::vector<u8>(id.id().begin(), id.id().end())));
+    }
+
+    void waitStarted(int count)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [&]() { return m_started >= count; });
+    }
+
+    void open()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_changed.notify_all();
+    }
+
+    std::vector<std::string> order()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_order;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<std::string> m_order;
+    int m_started = 0;
+    bool m_open = false;
+};
+
+} // namespace
+
+TEST_CASE("AsyncReader serves higher priorities first", "[vfs][async]")
+{
+    GatedSource source;
+    AsyncReader reader([&](const ResourceId& id) { return source.read(id); }, 1);
+
+    // Occupy the only I/O thread so the rest queue up
+    auto blocker = reader.submit(ResourceId("blocker"), ReadPriority::Normal);
+    source.waitStarted(1);
+
+    auto prefetch = reader.submit(ResourceId("prefetch"), ReadPriority::Prefetch);
+    auto texture = reader.submit(ResourceId("texture"), ReadPriority::Visible);
+    auto music = reader.submit(ResourceId("music"), ReadPriority::Streaming);
+    auto texture2 = reader.submit(ResourceId("texture2"), ReadPriority::Visible);
+
+    source.open();
+    REQUIRE(prefetch.result().isOk());
+    REQUIRE(texture2.result().isOk());
+
+    const std::vector<std::string> expected = {"blocker", "music", "texture", "texture2",
+                                               "prefetch"};
+    REQUIRE(source.order() == expected);
+}
+
+TEST_CASE("AsyncReader shares one read between concurrent requests", "[vfs][async]")
+{
+    GatedSource source;
+    AsyncReader reader([&](const ResourceId& id) { return source.read(id); }, 1);
+
+    auto blocker = reader.submit(ResourceId("blocker"), ReadPriority::Normal);
+    source.waitStarted(1);
+
+    auto first = reader.submit(ResourceId("bg.png"), ReadPriority::Prefetch);
+    auto second = reader.submit(ResourceId("bg.png"), ReadPriority::Visible);
+    auto other = reader.submit(ResourceId("other"), ReadPriority::Normal);
+
+    source.open();
+    REQUIRE(first.result().isOk());
+    REQUIRE(second.result().isOk());
+    REQUIRE(first.result().value().get() == second.result().value().get());
+    REQUIRE(other.result().isOk());
+
+    // The second request raised the shared read above "other"
+    const std::vector<std::string> expected = {"blocker", "bg.png", "other"};
+    REQUIRE(source.order() == expected);
+    REQUIRE(reader.stats().deduplicated == 1);
+}
+
+TEST_CASE("AsyncReader drops reads once every caller cancels", "[vfs][async]")
+{
+    GatedSource source;
+    AsyncReader reader([&](const ResourceId& id) { return source.read(id); }, 1);
+
+    auto blocker = reader.submit(ResourceId("blocker"), ReadPriority::Normal);
+    source.waitStarted(1);
+
+    int callbacks = 0;
+    auto counter = [&](const ResourceId&, const Result<SharedBuffer>&) { ++callbacks; };
+    auto dropped = reader.submit(ResourceId("skipped"), ReadPriority::Normal, counter);
+    auto kept = reader.submit(ResourceId("shared"), ReadPriority::Normal, counter);
+    auto withdrawn = reader.submit(ResourceId("shared"), ReadPriority::Normal, counter);
+
+    dropped.cancel();
+    withdrawn.cancel();
+    REQUIRE(dropped.isReady());
+    REQUIRE(dropped.result().isError());
+
+    source.open();
+    REQUIRE(kept.result().isOk());
+    REQUIRE(withdrawn.result().isError());
+    REQUIRE(blocker.result().isOk());
+
+    const std::vector<std::string> expected = {"blocker", "shared"};
+    REQUIRE(source.order() == expected);
+
+    // Only the caller that kept its interest is called back
+    reader.dispatchCompletions();
+    REQUIRE(callbacks == 1);
+    REQUIRE(reader.stats().cancelled == 1);
+}
+
+TEST_CASE("VirtualFileSystem delivers async completions on the draining thread",
+          "[vfs][async]")
+{
+    VirtualFileSystem vfs;
+    auto backend = std::make_unique<MemoryBackend>();
+    backend->addResource("audio/theme.ogg", {1, 2, 3}, ResourceType::Audio);
+    vfs.registerBackend(std::move(backend));
+    REQUIRE(vfs.initialize().isOk());
+
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<int> delivered{0};
+    bool onMainThread = true;
+    bool missingFailed = false;
+
+    auto found = vfs.readAsync(ResourceId("audio/theme.ogg"), ReadPriority::Streaming,
+                               [&](const ResourceId&, const Result<SharedBuffer>& result) {
+                                   onMainThread = onMainThread &&
+                                                  std::this_thread::get_id() == mainThread;
+                                   REQUIRE(result.isOk());
+                                   REQUIRE(result.value()->size() == 3);
+                                   ++delivered;
+                               });
+    auto missing = vfs.readAsync(ResourceId("audio/none.ogg"), ReadPriority::Normal,
+                                 [&](const ResourceId&, const Result<SharedBuffer>& result) {
+                                     missingFailed = result.isError();
+                                     ++delivered;
+                                 });
+
+    found.wait();
+    missing.wait();
+    REQUIRE(delivered == 0);
+
+    while (delivered < 2) {
+        vfs.processCompletions();
+        std::this_thread::yield();
+    }
+    REQUIRE(onMainThread);
+    REQUIRE(missingFailed);
+
+    vfs.shutdown();
+}
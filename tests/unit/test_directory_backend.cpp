@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/directory_backend.hpp"
+#include "NovelMind/vfs/virtual_file_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::VFS;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+void writeFile(const fs::path& path, const std::string& contents)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+// Waits for the watcher to apply a change; false after two seconds
+bool waitFor(const std::function<bool()>& condition)
+{
+    for (int i = 0; i < 200; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+
+} // namespace
+
+TEST_CASE("DirectoryBackend answers queries from its scanned tree", "[vfs][directory]")
+{
+    const fs::path root = fs::temp_directory_path() / "nm_directory_backend";
+    fs::remove_all(root);
+    writeFile(root / "scripts" / "intro.nms", "say hello");
+    writeFile(root / "textures" / "bg" / "park.png", "png-bytes");
+    writeFile(root / "textures" / "hero.png", "hero");
+    writeFile(root / "config.json", "{}");
+
+    VirtualFileSystem vfs;
+    auto backend = std::make_unique<DirectoryBackend>(root.string());
+    DirectoryBackend* directory = backend.get();
+    vfs.registerBackend(std::move(backend));
+    REQUIRE(vfs.initialize().isOk());
+
+    REQUIRE(vfs.exists("textures/bg/park.png"));
+    REQUIRE_FALSE(vfs.exists("textures/missing.png"));
+    REQUIRE(vfs.getInfo(ResourceId("scripts/intro.nms"))->size == 9);
+    REQUIRE(vfs.listResources().size() == 4);
+    REQUIRE(vfs.listResources(ResourceType::Texture).size() == 2);
+
+    auto handle = vfs.openStream(ResourceId("textures/bg/park.png"));
+    REQUIRE(handle);
+    REQUIRE(handle->size() == 9);
+    REQUIRE(handle->seek(4, SeekOrigin::Begin).isOk());
+    REQUIRE(handle->readBytes(16).value() == std::vector<u8>{'b', 'y', 't', 'e', 's'});
+    REQUIRE(handle->isEof());
+    REQUIRE(handle->seek(-1, SeekOrigin::Begin).isError());
+    const auto all = vfs.readAll("config.json");
+    REQUIRE(all.isOk());
+    REQUIRE(all.value() == std::vector<u8>{'{', '}'});
+
+    // Files written after the scan appear after a rescan, or on their own
+    // where a watcher keeps the tree in sync
+    writeFile(root / "audio" / "theme.ogg", "ogg");
+    if (directory->isWatching()) {
+        REQUIRE(waitFor([&]() { return vfs.exists("audio/theme.ogg"); }));
+
+        writeFile(root / "textures" / "hero.png", "hero-v2");
+        REQUIRE(waitFor([&]() {
+            return vfs.getInfo(ResourceId("textures/hero.png"))->size == 7;
+        }));
+
+        fs::remove(root / "config.json");
+        REQUIRE(waitFor([&]() { return !vfs.exists("config.json"); }));
+
+        fs::remove_all(root / "textures" / "bg");
+        REQUIRE(waitFor([&]() { return !vfs.exists("textures/bg/park.png"); }));
+        REQUIRE(vfs.exists("textures/hero.png"));
+    } else {
+        REQUIRE_FALSE(vfs.exists("audio/theme.ogg"));
+        REQUIRE(directory->refresh().isOk());
+        REQUIRE(vfs.exists("audio/theme.ogg"));
+    }
+
+    // An edited file is read fresh rather than from the cache, even when its
+    // size does not change
+    std::atomic<int> changes{0};
+    vfs.setChangeCallback([&](const ResourceId&) { ++changes; });
+    REQUIRE(vfs.readAll("scripts/intro.nms").value() ==
+            std::vector<u8>{'s', 'a', 'y', ' ', 'h', 'e', 'l', 'l', 'o'});
+    writeFile(root / "scripts" / "intro.nms", "say HELLO");
+    const std::vector<u8> edited{'s', 'a', 'y', ' ', 'H', 'E', 'L', 'L', 'O'};
+    if (!directory->isWatching()) {
+        REQUIRE(directory->refresh().isOk());
+    }
+    REQUIRE(waitFor([&]() {
+        auto contents = vfs.readAll("scripts/intro.nms");
+        return contents.isOk() && contents.value() == edited;
+    }));
+    REQUIRE(changes.load() > 0);
+
+    vfs.shutdown();
+    fs::remove_all(root);
+}
+
+TEST_CASE("DirectoryBackend rejects a missing root", "[vfs][directory]")
+{
+    DirectoryBackend backend((fs::temp_directory_path() / "nm_no_such_dir").string());
+    REQUIRE(backend.initialize().isError());
+    REQUIRE_FALSE(backend.exists(ResourceId("anything.png")));
+}
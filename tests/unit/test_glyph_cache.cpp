@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include "NovelMind/renderer/font.hpp"
+#include "NovelMind/renderer/glyph_cache.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/utf8.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+std::vector<u8> readSystemFont()
+{
+    for (const char* path : {"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                             "/System/Library/Fonts/Supplemental/Arial.ttf",
+                             "C:\\Windows\\Fonts\\segoeui.ttf"}) {
+        std::ifstream in(path, std::ios::binary);
+        if (in) {
+            return std::vector<u8>(std::istreambuf_iterator<char>(in), {});
+        }
+    }
+    return {};
+}
+
+std::vector<char32_t> decodeAll(const std::string& text)
+{
+    std::vector<char32_t> codepoints;
+    usize offset = 0;
+    while (offset < text.size()) {
+        codepoints.push_back(decodeUtf8(text, offset));
+    }
+    return codepoints;
+}
+
+} // namespace
+
+TEST_CASE("decodeUtf8 handles multi-byte and malformed input", "[renderer][text]")
+{
+    REQUIRE(decodeAll("A\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80") ==
+            std::vector<char32_t>{U'A', U'\u00E9', U'\u3042', U'\U0001F600'});
+
+    // Stray continuation, truncated sequence, overlong and surrogate encodings
+    REQUIRE(decodeAll("\x80" "a") == std::vector<char32_t>{kReplacementCharacter, U'a'});
+    REQUIRE(decodeAll("\xE3\x81") ==
+            std::vector<char32_t>{kReplacementCharacter, kReplacementCharacter});
+    REQUIRE(decodeAll("\xC0\xAF")[0] == kReplacementCharacter);
+    REQUIRE(decodeAll("\xED\xA0\x80")[0] == kReplacementCharacter);
+}
+
+TEST_CASE("GlyphCache rasterizes on demand and evicts least recently used shelves",
+          "[renderer][text]")
+{
+    const auto data = readSystemFont();
+    if (data.empty()) {
+        SKIP("No system font available");
+    }
+    Texture::setGpuUploadEnabled(false);
+    Font font;
+    REQUIRE(font.loadFromMemory(data, 24).isOk());
+
+    GlyphCache cache(64, 2, 1);
+    cache.beginFrame();
+    REQUIRE(cache.getPageCount() == 0);
+    REQUIRE(cache.getLineHeight(font) > 0.0f);
+
+    const auto* space = cache.getGlyph(font, U' ');
+    REQUIRE(space);
+    REQUIRE(space->texture == nullptr);
+    REQUIRE(space->advanceX > 0.0f);
+    REQUIRE(cache.getPageCount() == 0);
+
+    const auto* a = cache.getGlyph(font, U'A');
+    REQUIRE(a);
+    REQUIRE(a->texture);
+    REQUIRE(cache.getPageCount() == 1);
+    const Texture* firstPage = a->texture;
+    const Rect aRect = a->sourceRect;
+
+    // Pixels reach the texture only when uploads are flushed
+    const auto pixelAlpha = [](const Texture& texture, const Rect& rect) {
+        u32 sum = 0;
+        for (i32 y = 0; y < static_cast<i32>(rect.height); ++y) {
+            for (i32 x = 0; x < static_cast<i32>(rect.width); ++x) {
+                const auto offset =
+                    (static_cast<usize>(static_cast<i32>(rect.y) + y) *
+                         static_cast<usize>(texture.getWidth()) +
+                     static_cast<usize>(static_cast<i32>(rect.x) + x)) * 4;
+                sum += texture.getPixels()[offset + 3];
+            }
+        }
+        return sum;
+    };
+    REQUIRE(pixelAlpha(*firstPage, aRect) == 0);
+    REQUIRE(cache.flushUploads() > 0);
+    REQUIRE(pixelAlpha(*firstPage, aRect) > 0);
+    REQUIRE(cache.flushUploads() == 0);
+
+    // Hits return the cached glyph; CJK outside the font is still handled
+    REQUIRE(cache.getGlyph(font, U'A')->sourceRect.x == aRect.x);
+    const usize before = cache.getGlyphCount();
+    cache.getGlyph(font, U'\u3042');
+    REQUIRE(cache.getGlyphCount() >= before);
+
+    // Fill both pages over several frames; old shelves get reused
+    const std::u32string letters = U"BCDEFGHIJKLMNOPQRSTUVWXYZbdfhklt0123456789";
+    for (char32_t c : letters) {
+        cache.beginFrame();
+        REQUIRE(cache.getGlyph(font, c));
+    }
+    REQUIRE(cache.getPageCount() == 2);
+    REQUIRE(cache.getEvictedCount() > 0);
+
+    // Glyphs used in the current frame are never evicted
+    cache.beginFrame();
+    const auto* z = cache.getGlyph(font, U'Z');
+    const Rect zRect = z->sourceRect;
+    const Texture* zPage = z->texture;
+    for (char32_t c : U"abcdefg") {
+        cache.getGlyph(font, c);
+    }
+    const auto* zAgain = cache.getGlyph(font, U'Z');
+    REQUIRE(zAgain->texture == zPage);
+    REQUIRE(zAgain->sourceRect.x == zRect.x);
+    REQUIRE(zAgain->sourceRect.y == zRect.y);
+
+    cache.releaseFont(font);
+    REQUIRE(cache.getGlyphCount() == 0);
+
+    // A font reloaded in place is a new font to the cache
+    cache.beginFrame();
+    const f32 largeAdvance = cache.getGlyph(font, U'W')->advanceX;
+    const f32 largeLineHeight = cache.getLineHeight(font);
+    REQUIRE(font.loadFromMemory(data, 12).isOk());
+    REQUIRE(cache.getGlyph(font, U'W')->advanceX < largeAdvance);
+    REQUIRE(cache.getLineHeight(font) < largeLineHeight);
+    font.destroy();
+    REQUIRE(font.getId() == 0);
+}
+
+TEST_CASE("BatchingRenderer draws UTF-8 text from the glyph cache", "[renderer][text]")
+{
+    const auto data = readSystemFont();
+    if (data.empty()) {
+        SKIP("No system font available");
+    }
+    Texture::setGpuUploadEnabled(false);
+    Font font;
+    REQUIRE(font.loadFromMemory(data, 16).isOk());
+
+    RecordingRenderer renderer(320, 240);
+    renderer.beginFrame();
+    renderer.drawText(font, "Caf\xC3\xA9 na\xC3\xAFve", 10.0f, 10.0f);
+    renderer.endFrame();
+
+    // One quad per visible codepoint, not per byte, all on one page
+    const auto& commands = renderer.lastCommands();
+    REQUIRE(commands.size() == 9);
+    REQUIRE(renderer.lastBatches().batches.size() == 1);
+    for (size_t i = 1; i < commands.size(); ++i) {
+        REQUIRE(commands[i].texture == commands[0].texture);
+    }
+    REQUIRE_FALSE(commands[0].texture->getPixels().empty());
+}
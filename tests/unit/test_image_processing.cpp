@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/image_processing.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/save/save_manager.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+std::vector<u8> solidImage(i32 width, i32 height, u8 r, u8 g, u8 b, u8 a)
+{
+    std::vector<u8> pixels;
+    for (i32 i = 0; i < width * height; ++i) {
+        pixels.insert(pixels.end(), {r, g, b, a});
+    }
+    return pixels;
+}
+
+/// Vertical black and white stripes one pixel wide
+std::vector<u8> stripes(i32 width, i32 height)
+{
+    std::vector<u8> pixels;
+    for (i32 y = 0; y < height; ++y) {
+        for (i32 x = 0; x < width; ++x) {
+            const u8 v = (x % 2 == 0) ? 0 : 255;
+            pixels.insert(pixels.end(), {v, v, v, 255});
+        }
+    }
+    return pixels;
+}
+
+int maxDifference(const std::vector<u8>& a, const std::vector<u8>& b)
+{
+    int worst = 0;
+    for (usize i = 0; i < a.size(); ++i) {
+        worst = std::max(worst, std::abs(int(a[i]) - int(b[i])));
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST_CASE("Resampling filters in linear light", "[renderer][image]")
+{
+    auto pixels = stripes(64, 8);
+    for (auto filter : {ResampleFilter::Box, ResampleFilter::Lanczos3}) {
+        ResampleOptions options;
+        options.filter = filter;
+        auto result = resampleImage(pixels.data(), 64, 8, 32, 4, options);
+        REQUIRE(result.isOk());
+        const auto& image = result.value();
+        REQUIRE(image.width == 32);
+        REQUIRE(image.height == 4);
+        REQUIRE(image.pixels.size() == 32u * 4u * 4u);
+        // Half black, half white is 50% linear light, sRGB 188, not 128
+        const u8 mid = image.pixels[(2 * 32 + 16) * 4];
+        REQUIRE(std::abs(int(mid) - 188) <= 1);
+    }
+
+    ResampleOptions naive;
+    naive.srgb = false;
+    auto result = resampleImage(pixels.data(), 64, 8, 32, 4, naive);
+    REQUIRE(result.isOk());
+    REQUIRE(std::abs(int(result.value().pixels[(2 * 32 + 16) * 4]) - 128) <= 1);
+
+    // Every byte survives linearizing and encoding again
+    std::vector<u8> ramp;
+    for (int i = 0; i < 256; ++i) {
+        ramp.insert(ramp.end(), {u8(i), u8(i), u8(i), 255, u8(i), u8(i), u8(i), 255});
+    }
+    auto wide = resampleImage(ramp.data(), 512, 1, 256, 1, ResampleOptions{ResampleFilter::Box});
+    REQUIRE(wide.isOk());
+    for (int i = 0; i < 256; ++i) {
+        REQUIRE(wide.value().pixels[usize(i) * 4] == i);
+    }
+}
+
+TEST_CASE("Resampling keeps transparent colour out of edges", "[renderer][image]")
+{
+    // Opaque red next to transparent green: straight-alpha filtering would
+    // tint the edge green
+    std::vector<u8> pixels;
+    for (i32 x = 0; x < 16; ++x) {
+        if (x < 8) {
+            pixels.insert(pixels.end(), {255, 0, 0, 255});
+        } else {
+            pixels.insert(pixels.end(), {0, 255, 0, 0});
+        }
+    }
+    auto result = resampleImage(pixels.data(), 16, 1, 4, 1);
+    REQUIRE(result.isOk());
+    for (usize x = 0; x < 4; ++x) {
+        const u8* p = result.value().pixels.data() + x * 4;
+        if (p[3] > 0) {
+            REQUIRE(p[1] <= 1);
+        }
+    }
+
+    // Alpha conversions round-trip where alpha keeps enough precision
+    auto alphaPixels = solidImage(7, 1, 200, 100, 50, 128);
+    premultiplyAlpha(alphaPixels.data(), 7);
+    REQUIRE(alphaPixels[0] == 100);
+    REQUIRE(alphaPixels[3] == 128);
+    REQUIRE(alphaPixels[24] == 100);
+    unpremultiplyAlpha(alphaPixels.data(), 7);
+    REQUIRE(std::abs(int(alphaPixels[0]) - 200) <= 1);
+    REQUIRE(std::abs(int(alphaPixels[26]) - 50) <= 1);
+
+    // Premultiplied images stay premultiplied
+    auto premultiplied = solidImage(8, 8, 100, 50, 25, 128);
+    ResampleOptions options;
+    options.premultiplied = true;
+    auto shrunk = resampleImage(premultiplied.data(), 8, 8, 2, 2, options);
+    REQUIRE(shrunk.isOk());
+    REQUIRE(maxDifference(shrunk.value().pixels, solidImage(2, 2, 100, 50, 25, 128)) <= 1);
+}
+
+TEST_CASE("SIMD and threaded resampling match the scalar path", "[renderer][image]")
+{
+    // Large enough to be split across threads
+    const i32 width = 640;
+    const i32 height = 480;
+    std::vector<u8> pixels(usize(width) * usize(height) * 4);
+    u32 state = 12345;
+    for (auto& byte : pixels) {
+        state = state * 1664525u + 1013904223u;
+        byte = u8(state >> 24);
+    }
+
+    for (auto filter : {ResampleFilter::Box, ResampleFilter::Lanczos3}) {
+        ResampleOptions scalar;
+        scalar.filter = filter;
+        scalar.simd = false;
+        scalar.threads = 1;
+        ResampleOptions fast;
+        fast.filter = filter;
+        fast.threads = 4;
+        auto reference = resampleImage(pixels.data(), width, height, 213, 97, scalar);
+        auto result = resampleImage(pixels.data(), width, height, 213, 97, fast);
+        REQUIRE(reference.isOk());
+        REQUIRE(result.isOk());
+        REQUIRE(maxDifference(reference.value().pixels, result.value().pixels) <= 1);
+    }
+    INFO(resampleKernelName());
+}
+
+TEST_CASE("Images shrink to fit and feed save thumbnails", "[renderer][image][save]")
+{
+    auto frame = solidImage(1920, 1080, 10, 120, 240, 255);
+    save::SaveData data{};
+    REQUIRE(save::SaveManager::setThumbnail(data, frame.data(), 1920, 1080).isOk());
+    REQUIRE(data.thumbnailWidth == 320);
+    REQUIRE(data.thumbnailHeight == 180);
+    REQUIRE(data.thumbnailData.size() == 320u * 180u * 4u);
+    REQUIRE(maxDifference(data.thumbnailData, solidImage(320, 180, 10, 120, 240, 255)) <= 1);
+    REQUIRE(save::SaveManager::setThumbnail(data, nullptr, 0, 0).isError());
+
+    // Images that already fit are left alone
+    auto small = stripes(10, 4);
+    auto fitted = resampleToFit(small.data(), 10, 4, 64, 64);
+    REQUIRE(fitted.isOk());
+    REQUIRE(fitted.value().width == 10);
+    REQUIRE(fitted.value().pixels == small);
+
+    // Encoded images decode into the same buffers
+    auto encoded = TextureAtlasBuilder::encodeTga(small.data(), 10, 4);
+    auto decoded = decodeImage(encoded);
+    REQUIRE(decoded.isOk());
+    REQUIRE(decoded.value().height == 4);
+    REQUIRE(decoded.value().pixels == small);
+    REQUIRE(decodeImage({1, 2, 3}).isError());
+}
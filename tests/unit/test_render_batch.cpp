@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include "NovelMind/renderer/texture.hpp"
+
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+void makeTexture(Texture& texture, i32 width, i32 height)
+{
+    std::vector<u8> pixels(static_cast<usize>(width * height * 4), 255);
+    REQUIRE(texture.loadFromRGBA(pixels.data(), width, height).isOk());
+}
+
+Transform2D at(f32 x, f32 y)
+{
+    Transform2D transform;
+    transform.x = x;
+    transform.y = y;
+    return transform;
+}
+
+} // namespace
+
+TEST_CASE("Render batches group disjoint quads by texture and keep overlaps in order",
+          "[renderer][batch]")
+{
+    Texture a;
+    Texture b;
+    makeTexture(a, 16, 16);
+    makeTexture(b, 16, 16);
+
+    RecordingRenderer renderer(640, 480);
+    renderer.beginFrame();
+    // A row of alternating glyph-sized quads that never overlap
+    for (int i = 0; i < 8; ++i) {
+        renderer.drawSprite(i % 2 == 0 ? a : b, at(static_cast<f32>(i) * 20.0f, 0.0f));
+    }
+    renderer.endFrame();
+
+    const auto& disjoint = renderer.lastBatches();
+    REQUIRE(renderer.lastCommands().size() == 8);
+    REQUIRE(disjoint.batches.size() == 2);
+    REQUIRE(disjoint.batches[0].texture == &a);
+    REQUIRE(disjoint.batches[0].indexCount == 24);
+    REQUIRE(disjoint.batches[1].texture == &b);
+    REQUIRE(disjoint.batches[1].firstIndex == 24);
+    REQUIRE(disjoint.vertices.size() == 32);
+    REQUIRE(disjoint.indices.size() == 48);
+    // Quads of a batch stay in recorded order: a at x=0, then a at x=40
+    REQUIRE(disjoint.vertices[disjoint.indices[0]].x == Catch::Approx(0.0f));
+    REQUIRE(disjoint.vertices[disjoint.indices[6]].x == Catch::Approx(40.0f));
+    REQUIRE(disjoint.vertices[disjoint.indices[2]].u == Catch::Approx(1.0f));
+
+    // The same pattern stacked on one spot must be drawn as recorded
+    renderer.beginFrame();
+    for (int i = 0; i < 4; ++i) {
+        renderer.drawSprite(i % 2 == 0 ? a : b, at(static_cast<f32>(i), 0.0f));
+    }
+    renderer.endFrame();
+    const auto& stacked = renderer.lastBatches();
+    REQUIRE(stacked.batches.size() == 4);
+    REQUIRE(stacked.batches[0].texture == &a);
+    REQUIRE(stacked.batches[1].texture == &b);
+    REQUIRE(stacked.batches[2].texture == &a);
+    REQUIRE(stacked.batches[3].texture == &b);
+    REQUIRE(renderer.submitCount() == 2);
+}
+
+TEST_CASE("Render batches order layers and split on blend mode", "[renderer][batch]")
+{
+    Texture texture;
+    makeTexture(texture, 32, 32);
+
+    RecordingRenderer renderer(640, 480);
+    renderer.beginFrame();
+    renderer.setLayer(2);
+    renderer.fillRect(Rect{0, 0, 10, 10}, Color::Red);
+    renderer.setLayer(0);
+    renderer.drawSprite(texture, at(100, 100));
+    renderer.setBlendMode(BlendMode::Additive);
+    renderer.drawSprite(texture, at(200, 100));
+    renderer.setBlendMode(BlendMode::Alpha);
+    renderer.drawSprite(texture, at(300, 100));
+    renderer.endFrame();
+
+    const auto& list = renderer.lastBatches();
+    REQUIRE(list.batches.size() == 3);
+    REQUIRE(list.batches[0].layer == 0);
+    REQUIRE(list.batches[0].blendMode == BlendMode::Alpha);
+    REQUIRE(list.batches[0].indexCount == 12);
+    REQUIRE(list.batches[1].blendMode == BlendMode::Additive);
+    REQUIRE(list.batches[2].layer == 2);
+    REQUIRE(list.batches[2].texture == nullptr);
+    const auto& fill = list.vertices[list.indices[list.batches[2].firstIndex]];
+    REQUIRE(fill.r == 255);
+    REQUIRE(fill.g == 0);
+
+    // Rotation and anchor are applied on the CPU
+    renderer.beginFrame();
+    Transform2D rotated = at(50, 50);
+    rotated.rotation = 90.0f;
+    rotated.anchorX = 16.0f;
+    rotated.anchorY = 16.0f;
+    renderer.drawSprite(texture, rotated);
+    renderer.endFrame();
+    const auto& corners = renderer.lastCommands()[0].corners;
+    REQUIRE(corners[0].x == Catch::Approx(66.0f));
+    REQUIRE(corners[0].y == Catch::Approx(34.0f));
+    REQUIRE(corners[2].x == Catch::Approx(34.0f));
+    REQUIRE(corners[2].y == Catch::Approx(66.0f));
+}
+
+TEST_CASE("RecordingRenderer applies clears, outlines and fades", "[renderer][batch]")
+{
+    Texture texture;
+    makeTexture(texture, 8, 8);
+
+    RecordingRenderer renderer(320, 200);
+    renderer.beginFrame();
+    renderer.drawSprite(texture, at(0, 0));
+    renderer.clear(Color::Blue);
+    renderer.drawRect(Rect{10, 10, 20, 20}, Color::White);
+    renderer.setFade(0.5f);
+    renderer.endFrame();
+
+    REQUIRE(renderer.lastClearColor().has_value());
+    REQUIRE(*renderer.lastClearColor() == Color::Blue);
+    // The sprite was cleared away; the outline is four edges, and the fade
+    // over the whole target shares their untextured batch
+    const auto& commands = renderer.lastCommands();
+    REQUIRE(commands.size() == 5);
+    REQUIRE(commands[4].corners[2].x == Catch::Approx(320.0f));
+    REQUIRE(commands[4].color.a == 128);
+    REQUIRE(renderer.lastBatches().batches.size() == 1);
+
+    // An empty frame submits nothing
+    renderer.beginFrame();
+    renderer.endFrame();
+    REQUIRE(renderer.submitCount() == 1);
+}
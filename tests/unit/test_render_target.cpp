@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/batching_renderer.hpp"
+#include "NovelMind/renderer/render_target.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/scene/transition.hpp"
+#include "NovelMind/scripting/script_runtime.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+Color pixelAt(const SoftwareRenderer& renderer, i32 x, i32 y)
+{
+    const auto pixels = renderer.pixels();
+    const usize offset = (static_cast<usize>(y) * static_cast<usize>(renderer.getWidth()) +
+                          static_cast<usize>(x)) * 4;
+    return Color(pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]);
+}
+
+/// Red on the left half, blue on the right
+std::shared_ptr<RenderTarget> captureOutgoing(SoftwareRenderer& renderer)
+{
+    auto target = std::make_shared<RenderTarget>();
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 32, 32}, Color::Red);
+    renderer.fillRect(Rect{32, 0, 32, 32}, Color::Blue);
+    REQUIRE(renderer.captureFrame(*target));
+    renderer.endFrame();
+    return target;
+}
+
+} // namespace
+
+TEST_CASE("SoftwareRenderer captures frames into render targets", "[renderer][render_target]")
+{
+    Texture::setGpuUploadEnabled(false);
+    SoftwareRenderer renderer(64, 32);
+    auto target = captureOutgoing(renderer);
+    REQUIRE(target->isValid());
+    REQUIRE(target->getWidth() == 64);
+    REQUIRE(target->getHeight() == 32);
+
+    // A region lands where it was captured
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 32}, Color::Green);
+    target->drawRegion(renderer, Rect{32, 0, 32, 32});
+    renderer.endFrame();
+    REQUIRE(pixelAt(renderer, 10, 10) == Color::Green);
+    REQUIRE(pixelAt(renderer, 40, 10) == Color::Blue);
+
+    // The whole capture can be moved like a sprite
+    Transform2D shifted;
+    shifted.x = 32;
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 32}, Color::Green);
+    target->draw(renderer, shifted);
+    renderer.endFrame();
+    REQUIRE(pixelAt(renderer, 10, 10) == Color::Green);
+    REQUIRE(pixelAt(renderer, 40, 10) == Color::Red);
+
+    // Capturing again at the same size reuses the texture
+    const auto* texture = &target->getTexture();
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 32}, Color::White);
+    REQUIRE(renderer.captureFrame(*target));
+    renderer.endFrame();
+    REQUIRE(&target->getTexture() == texture);
+    REQUIRE(target->getTexture().getPixels()[2] == 255);
+
+    target->release();
+    REQUIRE_FALSE(target->isValid());
+}
+
+TEST_CASE("Backends without a readable frame report it", "[renderer][render_target]")
+{
+    RenderTarget target;
+    RecordingRenderer recording(64, 32);
+    recording.beginFrame();
+    REQUIRE_FALSE(recording.captureFrame(target));
+    REQUIRE_FALSE(target.isValid());
+
+    auto null = createRenderer(RendererBackend::Null);
+    null->beginFrame();
+    REQUIRE(null->captureFrame(target));
+    REQUIRE(target.isValid());
+    REQUIRE_FALSE(target.getTexture().isValid());
+}
+
+TEST_CASE("Transitions composite the outgoing snapshot", "[renderer][render_target][scene]")
+{
+    Texture::setGpuUploadEnabled(false);
+    SoftwareRenderer renderer(64, 32);
+    auto outgoing = captureOutgoing(renderer);
+
+    const auto renderWith = [&](Scene::ITransition& transition) {
+        renderer.beginFrame();
+        renderer.fillRect(Rect{0, 0, 64, 32}, Color::Green); // Incoming scene
+        transition.render(renderer);
+        renderer.endFrame();
+    };
+
+    // Halfway through a left-to-right wipe the right half is still old
+    Scene::WipeTransition wipe;
+    wipe.setSnapshot(outgoing);
+    wipe.start(1.0f);
+    wipe.update(0.5);
+    renderWith(wipe);
+    REQUIRE(pixelAt(renderer, 10, 10) == Color::Green);
+    REQUIRE(pixelAt(renderer, 40, 10) == Color::Blue);
+
+    // Without a snapshot the mask colour covers it instead
+    Scene::WipeTransition masked(Color::Black);
+    masked.start(1.0f);
+    masked.update(0.5);
+    renderWith(masked);
+    REQUIRE(pixelAt(renderer, 40, 10) == Color::Black);
+
+    // Dissolve crossfades from the snapshot to the incoming scene
+    Scene::DissolveTransition dissolve;
+    dissolve.setSnapshot(outgoing);
+    dissolve.start(1.0f);
+    dissolve.update(0.5);
+    renderWith(dissolve);
+    const Color mixed = pixelAt(renderer, 10, 10);
+    REQUIRE(std::abs(mixed.r - 128) <= 2);
+    REQUIRE(std::abs(mixed.g - 128) <= 2);
+    dissolve.update(0.5);
+    REQUIRE(dissolve.isComplete());
+    renderWith(dissolve);
+    REQUIRE(pixelAt(renderer, 10, 10) == Color::Green);
+
+    // The zoom opening shows the new scene, its border the old one
+    Scene::ZoomTransition zoom;
+    zoom.setSnapshot(outgoing);
+    zoom.start(1.0f);
+    zoom.update(0.5);
+    renderWith(zoom);
+    REQUIRE(pixelAt(renderer, 32, 16) == Color::Green);
+    REQUIRE(pixelAt(renderer, 1, 1) == Color::Red);
+    REQUIRE(pixelAt(renderer, 62, 30) == Color::Blue);
+}
+
+TEST_CASE("Script transitions start from the frame before the scene changed",
+          "[renderer][render_target][scene]")
+{
+    Texture::setGpuUploadEnabled(false);
+    SoftwareRenderer renderer(64, 32);
+    auto outgoing = captureOutgoing(renderer);
+    auto incoming = std::make_shared<RenderTarget>();
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 32}, Color::Green);
+    REQUIRE(renderer.captureFrame(*incoming));
+    renderer.endFrame();
+
+    const f32 duration = 1.0f;
+    u32 durationBits = 0;
+    std::memcpy(&durationBits, &duration, sizeof(durationBits));
+    scripting::CompiledScript script;
+    script.instructions = {
+        {scripting::OpCode::SHOW_BACKGROUND, 1},
+        {scripting::OpCode::PUSH_INT, durationBits},
+        {scripting::OpCode::TRANSITION, 0},
+        {scripting::OpCode::HALT, 0},
+    };
+    script.stringTable = {"dissolve", "lab.png"};
+    script.sceneEntryPoints["start"] = 0;
+
+    // The host shows the new background in the frame after the command
+    auto screen = outgoing;
+    scripting::ScriptRuntime runtime;
+    REQUIRE(runtime.load(script).isOk());
+    runtime.setFrameCapture([&]() -> std::shared_ptr<const RenderTarget> { return screen; });
+    runtime.setEventCallback([&](const scripting::ScriptEvent& event) {
+        if (event.type == scripting::ScriptEventType::BackgroundChanged) {
+            screen = incoming;
+        }
+    });
+    runtime.start();
+    for (int i = 0; i < 3; ++i) {
+        runtime.update(0.0);
+    }
+    REQUIRE(runtime.getState() == scripting::RuntimeState::WaitingTransition);
+    REQUIRE(screen == incoming);
+
+    // Halfway through, the dissolve mixes the old frame with the new scene
+    runtime.update(0.5);
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 32}, Color::Green);
+    runtime.renderTransition(renderer);
+    renderer.endFrame();
+    const Color mixed = pixelAt(renderer, 10, 10);
+    REQUIRE(std::abs(mixed.r - 128) <= 2);
+    REQUIRE(std::abs(mixed.g - 128) <= 2);
+}
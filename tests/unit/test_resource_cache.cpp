@@ -0,0 +1,301 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/scene/scene_graph.hpp"
+#include "NovelMind/vfs/cached_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+
+TEST_CASE("ResourceCache hits share the cached buffer", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(1024);
+    const VFS::ResourceId id("textures/bg.png");
+
+    REQUIRE(cache.get(id) == nullptr);
+
+    auto stored = cache.put(id, std::vector<u8>(256, 0x7F));
+    auto first = cache.get(id);
+    auto second = cache.get(id);
+    REQUIRE(first != nullptr);
+    REQUIRE(first.get() == stored.get());
+    REQUIRE(second.get() == stored.get());
+    REQUIRE(cache.currentSize() == 256);
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.hitCount == 2);
+    REQUIRE(stats.missCount == 1);
+    REQUIRE(stats.entryCount == 1);
+}
+
+TEST_CASE("ResourceCache evicts unreferenced entries first", "[vfs][cache]")
+{
+    // One shard so the clock order is deterministic; admission is bypassed
+    // to exercise the CLOCK sweep on its own
+    VFS::ResourceCache cache(300, 1);
+    VFS::CacheTypePolicy policy;
+    policy.bypassAdmission = true;
+    cache.setTypePolicy(VFS::ResourceType::Unknown, policy);
+    const VFS::ResourceId hot("hot");
+    const VFS::ResourceId cold("cold");
+    const VFS::ResourceId extra("extra");
+
+    cache.put(hot, std::vector<u8>(100, 1));
+    cache.put(cold, std::vector<u8>(100, 2));
+    cache.put(extra, std::vector<u8>(100, 3));
+
+    // First insertion past the limit clears every reference bit and evicts
+    // the oldest entry; hot is then touched again before the next insertion
+    cache.put(VFS::ResourceId("filler"), std::vector<u8>(100, 4));
+    REQUIRE_FALSE(cache.contains(hot));
+    cache.put(hot, std::vector<u8>(100, 1));
+    REQUIRE(cache.get(hot) != nullptr);
+
+    cache.put(VFS::ResourceId("another"), std::vector<u8>(100, 5));
+    REQUIRE(cache.contains(hot));
+    REQUIRE(cache.currentSize() <= 300);
+    REQUIRE(cache.stats().evictionCount >= 2);
+}
+
+TEST_CASE("ResourceCache keeps evicted buffers alive for holders", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(100);
+    const VFS::ResourceId id("music/theme.ogg");
+
+    auto held = cache.put(id, std::vector<u8>(80, 9));
+    cache.put(VFS::ResourceId("other"), std::vector<u8>(80, 1));
+    cache.remove(id);
+
+    REQUIRE_FALSE(cache.contains(id));
+    REQUIRE(held->size() == 80);
+    REQUIRE((*held)[0] == 9);
+
+    // Too large to cache, but the caller still gets its buffer back
+    auto oversized = cache.put(VFS::ResourceId("huge"), std::vector<u8>(200, 1));
+    REQUIRE(oversized->size() == 200);
+    REQUIRE_FALSE(cache.contains(VFS::ResourceId("huge")));
+}
+
+TEST_CASE("ResourceCache stays within budget under concurrent use", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(64 * 1024);
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                const VFS::ResourceId id("res_" + std::to_string((i * 7 + t) % 300));
+                if (auto hit = cache.get(id)) {
+                    if (hit->size() != 1024 || (*hit)[0] != static_cast<u8>(id.hash())) {
+                        corrupted = true;
+                    }
+                } else {
+                    cache.put(id, std::vector<u8>(1024, static_cast<u8>(id.hash())));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE_FALSE(corrupted);
+    REQUIRE(cache.currentSize() <= 64 * 1024);
+    REQUIRE(cache.currentSize() == cache.entryCount() * 1024);
+}
+
+namespace {
+// get-then-put, the way the file systems use the cache
+void touch(VFS::ResourceCache& cache, const VFS::ResourceId& id, usize size)
+{
+    if (!cache.get(id)) {
+        cache.put(id, std::vector<u8>(size, 1));
+    }
+}
+} // namespace
+
+TEST_CASE("ResourceCache admission resists one-off scans", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(8 * 1024, 1);
+    std::vector<VFS::ResourceId> hot;
+    for (int i = 0; i < 6; ++i) {
+        hot.emplace_back("ui/button_" + std::to_string(i) + ".png");
+    }
+
+    for (int round = 0; round < 4; ++round) {
+        for (const auto& id : hot) {
+            touch(cache, id, 1024);
+        }
+    }
+
+    // A gallery pass touches many large images exactly once
+    for (int i = 0; i < 100; ++i) {
+        touch(cache, VFS::ResourceId("cg/scene_" + std::to_string(i) + ".png"), 1024);
+    }
+
+    for (const auto& id : hot) {
+        REQUIRE(cache.contains(id));
+    }
+    REQUIRE(cache.currentSize() <= 8 * 1024);
+    REQUIRE(cache.stats().rejectedCount > 0);
+}
+
+TEST_CASE("ResourceCache admission compares against victims in other shards", "[vfs][cache]")
+{
+    constexpr usize kShards = 2;
+    VFS::ResourceCache cache(8 * 1024, kShards);
+    const auto shardOf = [](const VFS::ResourceId& id) { return id.hash() % kShards; };
+
+    // The hot set fills the main region from shard 0
+    std::vector<VFS::ResourceId> hot;
+    for (int i = 0; hot.size() < 7; ++i) {
+        VFS::ResourceId id("ui/button_" + std::to_string(i) + ".png");
+        if (shardOf(id) == 0) {
+            hot.push_back(id);
+        }
+    }
+    for (int round = 0; round < 4; ++round) {
+        for (const auto& id : hot) {
+            touch(cache, id, 1024);
+        }
+    }
+
+    // A one-off CG waits in the window of shard 1, which has nothing in main
+    cache.setWindowFraction(0.1f);
+    VFS::ResourceId scanned;
+    for (int i = 0; scanned.isEmpty() || shardOf(scanned) != 1; ++i) {
+        scanned = VFS::ResourceId("cg/scene_" + std::to_string(i) + ".png");
+    }
+    touch(cache, scanned, 800);
+    REQUIRE(cache.contains(scanned));
+
+    // Shrinking the budget ages it out of the window; it has to beat the
+    // hot entries of shard 0 to stay
+    cache.setMaxSize(7900);
+    for (const auto& id : hot) {
+        REQUIRE(cache.contains(id));
+    }
+    REQUIRE_FALSE(cache.contains(scanned));
+    REQUIRE(cache.currentSize() <= 7900);
+    REQUIRE(cache.stats().rejectedCount == 1);
+}
+
+TEST_CASE("ResourceCache applies per-type policies", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(64 * 1024);
+
+    VFS::CacheTypePolicy noAudio;
+    noAudio.cacheable = false;
+    cache.setTypePolicy(VFS::ResourceType::Audio, noAudio);
+
+    VFS::CacheTypePolicy smallTextures;
+    smallTextures.maxEntrySize = 512;
+    cache.setTypePolicy(VFS::ResourceType::Texture, smallTextures);
+
+    const VFS::ResourceId voice("voice/line_001.ogg");
+    const VFS::ResourceId icon("ui/icon.png");
+    const VFS::ResourceId backdrop("bg/forest.png");
+
+    auto held = cache.put(voice, std::vector<u8>(100, 1));
+    cache.put(icon, std::vector<u8>(256, 2));
+    cache.put(backdrop, std::vector<u8>(4096, 3));
+
+    REQUIRE(held->size() == 100);
+    REQUIRE_FALSE(cache.contains(voice));
+    REQUIRE(cache.contains(icon));
+    REQUIRE_FALSE(cache.contains(backdrop));
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.forType(VFS::ResourceType::Audio).rejectedCount == 1);
+    REQUIRE(stats.forType(VFS::ResourceType::Texture).rejectedCount == 1);
+}
+
+TEST_CASE("ResourceCache reports per-type and byte hit rates", "[vfs][cache]")
+{
+    VFS::ResourceCache cache(64 * 1024);
+    const VFS::ResourceId texture("bg/room.png");
+    const VFS::ResourceId script("scripts/ch1.nms");
+
+    touch(cache, texture, 3000);
+    touch(cache, texture, 3000);
+    touch(cache, texture, 3000);
+    touch(cache, script, 1000);
+
+    const auto stats = cache.stats();
+    const auto& textures = stats.forType(VFS::ResourceType::Texture);
+    REQUIRE(textures.hitCount == 2);
+    REQUIRE(textures.missCount == 1);
+    REQUIRE(textures.hitBytes == 6000);
+    REQUIRE(textures.missBytes == 3000);
+
+    const auto& scripts = stats.forType(VFS::ResourceType::Script);
+    REQUIRE(scripts.hitCount == 0);
+    REQUIRE(scripts.missCount == 1);
+
+    REQUIRE(stats.hitCount == 2);
+    REQUIRE(stats.missCount == 2);
+    REQUIRE(stats.byteHitRate() == 6000.0 / 10000.0);
+
+    cache.resetStats();
+    REQUIRE(cache.stats().hitCount == 0);
+}
+
+TEST_CASE("CachedFileSystem serves cached views without copying", "[vfs][cache]")
+{
+    auto inner = std::make_unique<vfs::MemoryFileSystem>();
+    inner->addResource("scripts/intro", {1, 2, 3, 4}, vfs::ResourceType::Script);
+    vfs::CachedFileSystem fs(std::move(inner));
+
+    auto first = fs.readFileView("scripts/intro");
+    auto second = fs.readFileView("scripts/intro");
+    REQUIRE(first.isOk());
+    REQUIRE(second.isOk());
+    REQUIRE(first.value().data() == second.value().data());
+    REQUIRE(fs.cacheStats().hitCount == 1);
+
+    auto copy = fs.readFile("scripts/intro");
+    REQUIRE(copy.isOk());
+    REQUIRE(copy.value() == std::vector<u8>({1, 2, 3, 4}));
+
+    fs.clearCache();
+    REQUIRE(fs.cacheStats().entryCount == 0);
+    REQUIRE(fs.readFile("scripts/intro").isOk());
+}
+
+TEST_CASE("CachedFileSystem reports reads to an access trace", "[vfs][cache]")
+{
+    auto inner = std::make_unique<vfs::MemoryFileSystem>();
+    inner->addResource("bg/park", {1, 2, 3}, vfs::ResourceType::Texture);
+    vfs::CachedFileSystem fs(std::move(inner));
+
+    auto recorder = std::make_shared<VFS::AccessTraceRecorder>();
+    recorder->start();
+    fs.setTraceRecorder(recorder);
+
+    scene::SceneGraph graph;
+    graph.setAccessTraceRecorder(recorder);
+    graph.setSceneId("park");
+    graph.setSceneId("park");
+
+    // Cache hits count too: the trace is about what the game asks for
+    REQUIRE(fs.readFile("bg/park").isOk());
+    REQUIRE(fs.readFileView("bg/park").isOk());
+    REQUIRE(fs.readFile("bg/missing").isError());
+
+    const auto events = recorder->snapshot().events();
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].kind == VFS::AccessTraceEvent::Kind::Scene);
+    REQUIRE(events[0].id == "park");
+    REQUIRE(events[1].id == "bg/park");
+    REQUIRE(events[1].bytes == 3);
+    REQUIRE(events[2].id == "bg/park");
+
+    fs.setTraceRecorder(nullptr);
+    REQUIRE(fs.readFile("bg/park").isOk());
+    REQUIRE(recorder->snapshot().events().size() == 3);
+}
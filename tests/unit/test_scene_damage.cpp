@@ -0,0 +1,228 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/core/application.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/scene/scene_graph.hpp"
+#include "NovelMind/scripting/script_runtime.hpp"
+
+#include <cstring>
+#include <memory>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+using namespace NovelMind::scene;
+
+namespace {
+
+/// A 10x10 square at its position
+class Square : public SceneObjectBase {
+public:
+    explicit Square(const std::string& id, Color color = Color::Red)
+        : SceneObjectBase(id), m_color(color)
+    {
+    }
+
+    void render(IRenderer& renderer) override
+    {
+        renderer.fillRect(Rect{getX(), getY(), 10, 10}, m_color);
+    }
+
+    std::optional<Rect> getBounds() const override { return Rect{getX(), getY(), 10, 10}; }
+
+private:
+    Color m_color;
+};
+
+Color pixelAt(const SoftwareRenderer& renderer, i32 x, i32 y)
+{
+    const auto pixels = renderer.pixels();
+    const usize offset = (static_cast<usize>(y) * static_cast<usize>(renderer.getWidth()) +
+                          static_cast<usize>(x)) * 4;
+    return Color(pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]);
+}
+
+/// Runs a script until it halts, noting frames skipped mid-transition
+class TransitionApp : public core::Application {
+public:
+    explicit TransitionApp(scripting::ScriptRuntime& runtime)
+        : m_runtime(runtime)
+    {
+    }
+
+    u32 transitionFrames = 0;
+    u32 skippedDuringTransition = 0;
+
+protected:
+    void onUpdate(f64) override
+    {
+        const u64 skipped = getFrameStats().skippedFrames;
+        if (m_wasTransitioning && skipped != m_lastSkipped) {
+            ++skippedDuringTransition;
+        }
+        m_lastSkipped = skipped;
+        m_wasTransitioning = m_runtime.isTransitionActive();
+        transitionFrames += m_wasTransitioning ? 1u : 0u;
+
+        if ((m_runtime.isComplete() && ++m_idleFrames > 3) || ++m_frames > 100000) {
+            quit();
+        }
+    }
+
+private:
+    scripting::ScriptRuntime& m_runtime;
+    bool m_wasTransitioning = false;
+    u64 m_lastSkipped = 0;
+    u32 m_idleFrames = 0;
+    u32 m_frames = 0;
+};
+
+} // namespace
+
+TEST_CASE("SceneGraph reports what changed since the last render", "[scene][damage]")
+{
+    SoftwareRenderer renderer(64, 64);
+    SceneGraph graph;
+    REQUIRE(graph.getDamage().full);
+
+    graph.addToLayer(LayerType::Characters, std::make_unique<Square>("a"));
+    auto* square = graph.findObject("a");
+    REQUIRE(square != nullptr);
+    square->setPosition(10, 10);
+    graph.render(renderer);
+    REQUIRE_FALSE(graph.getDamage().changed);
+
+    // Updates that change nothing keep the scene clean
+    graph.update(0.016);
+    REQUIRE_FALSE(graph.getDamage().changed);
+
+    // A move damages both the old and the new position
+    square->setPosition(30, 10);
+    auto damage = graph.getDamage();
+    REQUIRE(damage.isPartial());
+    REQUIRE(damage.rect.x == 10.0f);
+    REQUIRE(damage.rect.y == 10.0f);
+    REQUIRE(damage.rect.width == 30.0f);
+    REQUIRE(damage.rect.height == 10.0f);
+    graph.render(renderer);
+    REQUIRE_FALSE(graph.getDamage().changed);
+
+    // Running tweens keep the object dirty up to their last step
+    square->animateAlpha(0.5f, 0.1f);
+    graph.update(0.05);
+    REQUIRE(graph.getDamage().isPartial());
+    graph.render(renderer);
+    graph.update(0.1);
+    REQUIRE(graph.getDamage().isPartial());
+    graph.render(renderer);
+    graph.update(0.1);
+    REQUIRE_FALSE(graph.getDamage().changed);
+
+    // Hiding damages where it was drawn; hidden changes cost nothing
+    square->setVisible(false);
+    damage = graph.getDamage();
+    REQUIRE(damage.isPartial());
+    REQUIRE(damage.rect.x == 30.0f);
+    graph.render(renderer);
+    square->setPosition(0, 0);
+    REQUIRE_FALSE(graph.getDamage().changed);
+
+    // Objects without bounds and structural changes redraw everything
+    graph.showBackground("bg.png");
+    REQUIRE(graph.getDamage().full);
+    graph.render(renderer);
+    REQUIRE_FALSE(graph.getDamage().changed);
+    graph.getUILayer().setVisible(false);
+    REQUIRE(graph.getDamage().full);
+    graph.render(renderer);
+    graph.markAllDirty();
+    REQUIRE(graph.getDamage().full);
+}
+
+TEST_CASE("Dialogue text changes damage only the text box", "[scene][damage]")
+{
+    SoftwareRenderer renderer(64, 64);
+    SceneGraph graph;
+    auto* dialogue = graph.showDialogue("Alice", "Hello");
+    REQUIRE(dialogue != nullptr);
+    dialogue->setTypewriterSpeed(100.0f);
+    graph.render(renderer);
+
+    // The typewriter keeps the box dirty until the text is revealed
+    dialogue->setText("Hi");
+    auto damage = graph.getDamage();
+    REQUIRE(damage.isPartial());
+    REQUIRE(damage.rect.width == dialogue->getBounds()->width);
+    for (int frame = 0; frame < 10 && !dialogue->isTypewriterComplete(); ++frame) {
+        graph.update(0.016);
+        REQUIRE(graph.getDamage().isPartial());
+        graph.render(renderer);
+    }
+    REQUIRE(dialogue->isTypewriterComplete());
+    graph.update(0.016);
+    REQUIRE_FALSE(graph.getDamage().changed);
+}
+
+TEST_CASE("SoftwareRenderer partial frames redraw only the damaged region",
+          "[renderer][software][damage]")
+{
+    SoftwareRenderer renderer(64, 64);
+    renderer.setThreadCount(2);
+    renderer.beginFrame();
+    renderer.clear(Color::Black);
+    renderer.fillRect(Rect{0, 0, 64, 64}, Color::Blue);
+    renderer.endFrame();
+
+    // Everything is drawn again, but only the region is written
+    REQUIRE(renderer.beginPartialFrame(Rect{8.5f, 40.0f, 10.0f, 10.0f}));
+    renderer.clear(Color::Black);
+    renderer.fillRect(Rect{0, 0, 64, 64}, Color::Green);
+    renderer.endFrame();
+
+    REQUIRE(pixelAt(renderer, 8, 40) == Color::Green);
+    REQUIRE(pixelAt(renderer, 18, 49) == Color::Green);
+    REQUIRE(pixelAt(renderer, 7, 40) == Color::Blue);
+    REQUIRE(pixelAt(renderer, 19, 45) == Color::Blue);
+    REQUIRE(pixelAt(renderer, 10, 39) == Color::Blue);
+    REQUIRE(pixelAt(renderer, 10, 50) == Color::Blue);
+
+    // A full frame afterwards writes everything again
+    renderer.beginFrame();
+    renderer.fillRect(Rect{0, 0, 64, 64}, Color::Green);
+    renderer.endFrame();
+    REQUIRE(pixelAt(renderer, 0, 0) == Color::Green);
+    REQUIRE(pixelAt(renderer, 63, 63) == Color::Green);
+}
+
+TEST_CASE("Idle frame skipping still draws every frame of a script transition",
+          "[scene][damage][application]")
+{
+    const f32 duration = 0.05f;
+    u32 durationBits = 0;
+    std::memcpy(&durationBits, &duration, sizeof(durationBits));
+    scripting::CompiledScript script;
+    script.instructions = {
+        {scripting::OpCode::PUSH_INT, durationBits},
+        {scripting::OpCode::TRANSITION, 0},
+        {scripting::OpCode::HALT, 0},
+    };
+    script.stringTable = {"fade"};
+    script.sceneEntryPoints["start"] = 0;
+
+    scripting::ScriptRuntime runtime;
+    REQUIRE(runtime.load(script).isOk());
+    runtime.start();
+
+    core::EngineConfig config;
+    config.skipIdleFrames = true;
+    config.idleSleepMs = 0;
+    TransitionApp app(runtime);
+    REQUIRE(app.initialize(config).isOk());
+    app.setScriptRuntime(&runtime);
+    app.run();
+    app.setScriptRuntime(nullptr);
+
+    // The scene never changes, so only the idle frames after it are skipped
+    REQUIRE(app.transitionFrames > 0);
+    REQUIRE(app.skippedDuringTransition == 0);
+    REQUIRE(app.getFrameStats().skippedFrames > 0);
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/platform/window.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/renderer/texture.hpp"
+
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+void makeTexture(Texture& texture, i32 width, i32 height, const std::vector<Color>& pixels)
+{
+    std::vector<u8> rgba;
+    for (const auto& pixel : pixels) {
+        rgba.insert(rgba.end(), {pixel.r, pixel.g, pixel.b, pixel.a});
+    }
+    Texture::setGpuUploadEnabled(false);
+    REQUIRE(texture.loadFromRGBA(rgba.data(), width, height).isOk());
+    REQUIRE_FALSE(texture.getPixels().empty());
+}
+
+Color pixelAt(const SoftwareRenderer& renderer, i32 x, i32 y)
+{
+    const auto pixels = renderer.pixels();
+    const usize offset = (static_cast<usize>(y) * static_cast<usize>(renderer.getWidth()) +
+                          static_cast<usize>(x)) * 4;
+    return Color(pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]);
+}
+
+Transform2D at(f32 x, f32 y)
+{
+    Transform2D transform;
+    transform.x = x;
+    transform.y = y;
+    return transform;
+}
+
+class HeadlessWindow : public platform::IWindow
+{
+public:
+    Result<void> create(const platform::WindowConfig&) override { return Result<void>::ok(); }
+    void destroy() override {}
+    void setTitle(const std::string&) override {}
+    void setSize(i32, i32) override {}
+    void setFullscreen(bool) override {}
+    [[nodiscard]] i32 getWidth() const override { return 32; }
+    [[nodiscard]] i32 getHeight() const override { return 16; }
+    [[nodiscard]] bool isFullscreen() const override { return false; }
+    [[nodiscard]] bool shouldClose() const override { return false; }
+    void pollEvents() override {}
+    void swapBuffers() override {}
+    [[nodiscard]] void* getNativeHandle() const override { return nullptr; }
+};
+
+} // namespace
+
+TEST_CASE("SoftwareRenderer rasterizes sprites and rectangles", "[renderer][software]")
+{
+    Texture red;
+    makeTexture(red, 4, 4, std::vector<Color>(16, Color::Red));
+
+    SoftwareRenderer renderer(16, 16);
+    renderer.beginFrame();
+    renderer.clear(Color::Black);
+    renderer.drawSprite(red, at(2, 2));
+    renderer.fillRect(Rect{10, 0, 6, 1}, Color::Green);
+    renderer.endFrame();
+
+    REQUIRE(pixelAt(renderer, 0, 0) == Color::Black);
+    REQUIRE(pixelAt(renderer, 2, 2) == Color::Red);
+    REQUIRE(pixelAt(renderer, 5, 5) == Color::Red);
+    REQUIRE(pixelAt(renderer, 6, 5) == Color::Black);
+    REQUIRE(pixelAt(renderer, 1, 2) == Color::Black);
+    REQUIRE(pixelAt(renderer, 10, 0) == Color::Green);
+    REQUIRE(pixelAt(renderer, 15, 0) == Color::Green);
+    REQUIRE(pixelAt(renderer, 15, 1) == Color::Black);
+
+    // Sprites scaled 2x cover twice the pixels
+    renderer.beginFrame();
+    renderer.clear(Color::Black);
+    Transform2D scaled = at(0, 0);
+    scaled.setScale(2.0f);
+    renderer.drawSprite(red, scaled);
+    renderer.endFrame();
+    REQUIRE(pixelAt(renderer, 7, 7) == Color::Red);
+    REQUIRE(pixelAt(renderer, 8, 8) == Color::Black);
+}
+
+TEST_CASE("SoftwareRenderer blend modes follow the GL equations", "[renderer][software]")
+{
+    SoftwareRenderer renderer(4, 1);
+    renderer.beginFrame();
+    renderer.clear(Color(200, 100, 50, 255));
+    renderer.setBlendMode(BlendMode::Alpha);
+    renderer.fillRect(Rect{0, 0, 1, 1}, Color(0, 0, 255, 128));
+    renderer.setBlendMode(BlendMode::Additive);
+    renderer.fillRect(Rect{1, 0, 1, 1}, Color(100, 200, 10, 255));
+    renderer.setBlendMode(BlendMode::Multiply);
+    renderer.fillRect(Rect{2, 0, 1, 1}, Color(128, 255, 0, 255));
+    renderer.setBlendMode(BlendMode::None);
+    renderer.fillRect(Rect{3, 0, 1, 1}, Color(1, 2, 3, 4));
+    renderer.endFrame();
+
+    // src * a + dst * (1 - a)
+    REQUIRE(pixelAt(renderer, 0, 0) == Color(100, 50, 153, 191));
+    // src * a + dst, saturated
+    REQUIRE(pixelAt(renderer, 1, 0) == Color(255, 255, 60, 255));
+    // src * dst + dst * (1 - a)
+    REQUIRE(pixelAt(renderer, 2, 0) == Color(100, 100, 0, 255));
+    REQUIRE(pixelAt(renderer, 3, 0) == Color(1, 2, 3, 4));
+}
+
+TEST_CASE("SoftwareRenderer filters bilinearly and matches across engines and threads",
+          "[renderer][software]")
+{
+    Texture ramp;
+    makeTexture(ramp, 2, 1, {Color::Black, Color::White});
+
+    Texture checker;
+    std::vector<Color> cells;
+    for (int i = 0; i < 64; ++i) {
+        cells.push_back((i + i / 8) % 2 == 0 ? Color(255, 0, 0, 200) : Color(0, 0, 255, 90));
+    }
+    makeTexture(checker, 8, 8, cells);
+
+    // A 2-texel ramp stretched to 8 pixels: clamped ends, rising middle
+    SoftwareRenderer stretch(8, 1);
+    stretch.beginFrame();
+    Transform2D wide = at(0, 0);
+    wide.setScale(4.0f, 1.0f);
+    stretch.drawSprite(ramp, wide);
+    stretch.endFrame();
+    REQUIRE(pixelAt(stretch, 0, 0) == Color::Black);
+    REQUIRE(pixelAt(stretch, 7, 0) == Color::White);
+    for (i32 x = 1; x < 8; ++x) {
+        REQUIRE(pixelAt(stretch, x, 0).r >= pixelAt(stretch, x - 1, 0).r);
+    }
+    REQUIRE(pixelAt(stretch, 3, 0).r > 0);
+    REQUIRE(pixelAt(stretch, 3, 0).r < 255);
+
+    const auto render = [&](RasterEngine engine, u32 threads) {
+        SoftwareRenderer renderer(200, 130);
+        renderer.setEngine(engine);
+        renderer.setThreadCount(threads);
+        renderer.beginFrame();
+        renderer.clear(Color(30, 60, 90, 255));
+        Transform2D rotated = at(100, 60);
+        rotated.rotation = 33.0f;
+        rotated.setScale(9.5f, 7.25f);
+        rotated.setAnchor(4.0f, 4.0f);
+        renderer.drawSprite(checker, rotated, Color(255, 200, 150, 230));
+        renderer.setBlendMode(BlendMode::Additive);
+        renderer.drawSprite(checker, Rect{1, 1, 5, 5}, at(13.3f, 71.8f), Color::White);
+        renderer.setBlendMode(BlendMode::Multiply);
+        renderer.fillRect(Rect{0, 100, 200, 30}, Color(128, 64, 255, 77));
+        renderer.setBlendMode(BlendMode::Alpha);
+        renderer.setFade(0.25f);
+        renderer.endFrame();
+        return renderer.readPixels();
+    };
+
+    const auto reference = render(RasterEngine::Scalar, 1);
+    for (auto engine : {RasterEngine::Scalar, RasterEngine::Sse2, RasterEngine::Avx2}) {
+        if (!SoftwareRenderer::isEngineSupported(engine)) {
+            continue;
+        }
+        REQUIRE(render(engine, 1) == reference);
+        REQUIRE(render(engine, 4) == reference);
+    }
+}
+
+TEST_CASE("SoftwareRenderer restores GPU upload when it shuts down", "[renderer][software]")
+{
+    Texture::setGpuUploadEnabled(true);
+    const bool before = Texture::isGpuUploadEnabled();
+
+    HeadlessWindow window;
+    {
+        SoftwareRenderer renderer;
+        REQUIRE(renderer.initialize(window).isOk());
+        REQUIRE(renderer.getWidth() == 32);
+        REQUIRE_FALSE(Texture::isGpuUploadEnabled());
+        renderer.shutdown();
+        REQUIRE(Texture::isGpuUploadEnabled() == before);
+
+        // Initializing again, then dropping the renderer, restores it too
+        REQUIRE(renderer.initialize(window).isOk());
+        REQUIRE(renderer.initialize(window).isOk());
+    }
+    REQUIRE(Texture::isGpuUploadEnabled() == before);
+    Texture::setGpuUploadEnabled(false);
+}
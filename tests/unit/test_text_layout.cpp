@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/font.hpp"
+#include "NovelMind/renderer/text_layout.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+// Without a font, CJK characters are one em wide
+TextLayoutEngine makeEngine(f32 maxWidth)
+{
+    TextLayoutEngine engine;
+    TextStyle style;
+    style.size = 10.0f;
+    engine.setDefaultStyle(style);
+    engine.setMaxWidth(maxWidth);
+    return engine;
+}
+
+std::u32string lineText(const TextLayout& layout, size_t line)
+{
+    std::u32string text;
+    const auto& l = layout.lines[line];
+    for (u32 g = l.firstGlyph; g < l.firstGlyph + l.glyphCount; ++g) {
+        text.push_back(layout.glyphs[g].codepoint);
+    }
+    return text;
+}
+
+std::vector<u8> readSystemFont()
+{
+    for (const char* path : {"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                             "/System/Library/Fonts/Supplemental/Arial.ttf",
+                             "C:\\Windows\\Fonts\\segoeui.ttf"}) {
+        std::ifstream in(path, std::ios::binary);
+        if (in) {
+            return std::vector<u8>(std::istreambuf_iterator<char>(in), {});
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+TEST_CASE("TextLayoutEngine breaks CJK text between characters with kinsoku rules",
+          "[renderer][text]")
+{
+    auto engine = makeEngine(35.0f);
+
+    // The full stop may not start a line, so the line before gives up a character
+    auto layout = engine.layout("\xE3\x81\x82\xE3\x81\x84\xE3\x81\x86\xE3\x80\x82"
+                                "\xE3\x81\x88\xE3\x81\x8A");
+    REQUIRE(layout.totalCharacters == 6);
+    REQUIRE(layout.lines.size() == 3);
+    REQUIRE(lineText(layout, 0) == U"あい");
+    REQUIRE(lineText(layout, 1) == U"う。え");
+    REQUIRE(lineText(layout, 2) == U"お");
+    REQUIRE(layout.lines[1].width == 30.0f);
+    REQUIRE(layout.lines[1].segments.size() == 1);
+    REQUIRE(layout.lines[1].segments[0].text == "\xE3\x81\x86\xE3\x80\x82\xE3\x81\x88");
+
+    // An opening bracket stays with what follows it
+    layout = engine.layout("\xE3\x81\x82\xE3\x81\x84\xE3\x80\x8C\xE3\x81\x86\xE3\x81\x88");
+    REQUIRE(layout.lines.size() == 2);
+    REQUIRE(lineText(layout, 0) == U"あい");
+    REQUIRE(lineText(layout, 1) == U"「うえ");
+}
+
+TEST_CASE("TextLayoutEngine wraps words and decodes UTF-8", "[renderer][text]")
+{
+    auto engine = makeEngine(40.0f);
+
+    auto layout = engine.layout("hello world");
+    REQUIRE(layout.lines.size() == 2);
+    REQUIRE(layout.lines[0].segments.size() == 1);
+    REQUIRE(layout.lines[0].segments[0].text == "hello");
+    REQUIRE(layout.lines[1].segments[0].text == "world");
+    REQUIRE(layout.totalCharacters == 10);
+
+    // A word wider than the line breaks where it overflows
+    engine.setMaxWidth(20.0f);
+    layout = engine.layout("aaaaaaaaaa");
+    REQUIRE(layout.lines.size() == 3);
+    REQUIRE(layout.lines[0].glyphCount == 4);
+    REQUIRE(layout.lines[2].glyphCount == 2);
+    engine.setMaxWidth(40.0f);
+
+    // Multi-byte characters count once, explicit newlines always break
+    layout = engine.layout("Caf\xC3\xA9\nna\xC3\xAFve");
+    REQUIRE(layout.totalCharacters == 9);
+    REQUIRE(layout.lines.size() == 2);
+    REQUIRE(layout.lines[0].segments[0].text == "Caf\xC3\xA9");
+    REQUIRE(layout.glyphs[3].codepoint == U'é');
+
+    const auto position = engine.getCharacterPosition(layout, 5);
+    REQUIRE(position.first == layout.glyphs[5].x);
+    REQUIRE(position.second == layout.lines[0].height);
+    REQUIRE(engine.getCharacterAtPosition(layout, position.first + 0.5f,
+                                          position.second + 1.0f) == 5);
+
+    // Commands keep their place in the character stream
+    layout = engine.layout("Hi{w=0.5} there");
+    REQUIRE(layout.commandIndices == std::vector<size_t>{2});
+    REQUIRE(layout.commands.size() == 1);
+    REQUIRE(std::holds_alternative<WaitCommand>(layout.commands[0]));
+}
+
+TEST_CASE("TextLayoutEngine caches layouts by text and settings", "[renderer][text]")
+{
+    auto engine = makeEngine(100.0f);
+    const std::string text = "The same line, laid out every frame";
+
+    const auto first = engine.layoutCached(text);
+    REQUIRE(engine.layoutCached(text) == first);
+    REQUIRE(engine.getLayoutCacheSize() == 1);
+
+    engine.setMaxWidth(50.0f);
+    const auto narrow = engine.layoutCached(text);
+    REQUIRE(narrow != first);
+    REQUIRE(narrow->lines.size() > first->lines.size());
+    engine.setMaxWidth(100.0f);
+    REQUIRE(engine.layoutCached(text) == first);
+
+    engine.setLayoutCacheCapacity(1);
+    REQUIRE(engine.getLayoutCacheSize() == 1);
+    REQUIRE(engine.layoutCached(text) == first);
+    REQUIRE(engine.layoutCached("other") != first);
+    REQUIRE(engine.layoutCached(text) != first);
+
+    engine.clearLayoutCache();
+    REQUIRE(engine.getLayoutCacheSize() == 0);
+}
+
+TEST_CASE("TextLayoutEngine caches by font identity, not address", "[renderer][text]")
+{
+    const auto data = readSystemFont();
+    if (data.empty()) {
+        SKIP("No system font available");
+    }
+    auto engine = makeEngine(1000.0f);
+    auto font = std::make_shared<Font>();
+    REQUIRE(font->loadFromMemory(data, 24).isOk());
+    engine.setFont(font);
+
+    const std::string text = "WWWW";
+    const auto large = engine.layoutCached(text);
+    REQUIRE(engine.layoutCached(text) == large);
+
+    // Same object, same address, different font
+    REQUIRE(font->loadFromMemory(data, 12).isOk());
+    const auto small = engine.layoutCached(text);
+    REQUIRE(small != large);
+    REQUIRE(small->totalWidth < large->totalWidth);
+
+    // Swapping fonts drops everything cached for the old one
+    engine.setFont(std::make_shared<Font>());
+    REQUIRE(engine.getLayoutCacheSize() == 0);
+    engine.setFont(font);
+    REQUIRE(engine.getLayoutCacheSize() == 0);
+    REQUIRE(engine.layoutCached(text)->totalWidth == small->totalWidth);
+}
+
+TEST_CASE("TypewriterAnimator reveals a shared layout and pauses at punctuation",
+          "[renderer][text]")
+{
+    auto engine = makeEngine(0.0f);
+
+    TypewriterAnimator animator;
+    std::vector<InlineCommand> reached;
+    animator.setCommandCallback([&](const InlineCommand& command) { reached.push_back(command); });
+    animator.setLayout(engine.layoutCached("\xE3\x81\x82\xE3\x80\x82{speed=20}\xE3\x81\x84\xE3\x81\x86"));
+    animator.setSpeed(10.0f);
+    animator.start();
+
+    animator.update(0.2);
+    REQUIRE(animator.getVisibleCharCount() == 2);
+    REQUIRE(animator.getState().waitTimer > 0.0f);
+
+    for (int i = 0; i < 100 && !animator.isComplete(); ++i) {
+        animator.update(0.05);
+    }
+    REQUIRE(animator.isComplete());
+    REQUIRE(animator.getVisibleCharCount() == 4);
+    REQUIRE(reached.size() == 1);
+    REQUIRE(std::holds_alternative<SpeedCommand>(reached[0]));
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool overlaps(const AtlasRect& a, const AtlasRect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+           b.y < a.y + a.height;
+}
+
+std::vector<u8> solid(i32 width, i32 height, Color color)
+{
+    std::vector<u8> rgba;
+    for (i32 i = 0; i < width * height; ++i) {
+        rgba.insert(rgba.end(), {color.r, color.g, color.b, color.a});
+    }
+    return rgba;
+}
+
+Color pagePixel(const TextureAtlasBuilder::Page& page, i32 x, i32 y)
+{
+    const usize offset = (static_cast<usize>(y) * static_cast<usize>(page.width) +
+                          static_cast<usize>(x)) * 4;
+    return Color(page.rgba[offset], page.rgba[offset + 1], page.rgba[offset + 2],
+                 page.rgba[offset + 3]);
+}
+
+void writeFile(const fs::path& path, const std::vector<u8>& data)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+} // namespace
+
+TEST_CASE("MaxRectsPacker places rectangles without overlap", "[renderer][atlas]")
+{
+    MaxRectsPacker packer(256, 256);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<i32> size(4, 48);
+
+    std::vector<AtlasRect> placed;
+    for (int i = 0; i < 200; ++i) {
+        auto rect = packer.insert(size(rng), size(rng));
+        if (rect) {
+            placed.push_back(*rect);
+        }
+    }
+
+    REQUIRE(placed.size() > 30);
+    REQUIRE(placed.size() == packer.usedRects().size());
+    for (size_t i = 0; i < placed.size(); ++i) {
+        REQUIRE(placed[i].x >= 0);
+        REQUIRE(placed[i].y >= 0);
+        REQUIRE(placed[i].x + placed[i].width <= 256);
+        REQUIRE(placed[i].y + placed[i].height <= 256);
+        for (size_t j = i + 1; j < placed.size(); ++j) {
+            REQUIRE_FALSE(overlaps(placed[i], placed[j]));
+        }
+    }
+    REQUIRE(packer.occupancy() > 0.7f);
+
+    // Four quarters fill a bin exactly
+    packer.reset(64, 64);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(packer.insert(32, 32).has_value());
+    }
+    REQUIRE(packer.occupancy() == 1.0f);
+    REQUIRE_FALSE(packer.insert(1, 1).has_value());
+}
+
+TEST_CASE("TextureAtlasBuilder packs groups into extruded pages", "[renderer][atlas]")
+{
+    TextureAtlasBuilder builder(256, 2);
+    const auto red = solid(10, 20, Color::Red);
+    const auto green = solid(30, 8, Color::Green);
+    const auto blue = solid(16, 16, Color::Blue);
+    const auto huge = solid(200, 10, Color::White);
+    REQUIRE(builder.addImage("characters/alice", "characters/alice/happy.png", red.data(), 10, 20).isOk());
+    REQUIRE(builder.addImage("characters/alice", "characters/alice/sad.png", green.data(), 30, 8).isOk());
+    REQUIRE(builder.addImage("characters/alice", "characters/alice/wide.png", huge.data(), 200, 10).isOk());
+    REQUIRE(builder.addImage("ui/menu", "ui/menu/button.png", blue.data(), 16, 16).isOk());
+    REQUIRE(builder.addImage("ui/menu", "ui/menu/button.png", blue.data(), 16, 16).isError());
+    REQUIRE(builder.build().isOk());
+
+    // Too large for the page, and alone in its group
+    REQUIRE(builder.rejected() ==
+            std::vector<std::string>{"characters/alice/wide.png", "ui/menu/button.png"});
+    REQUIRE(builder.pages().size() == 1);
+    const auto& page = builder.pages()[0];
+    REQUIRE(page.id == "atlas_characters_alice_0.tga");
+    REQUIRE(page.width == 64);
+    REQUIRE(page.height == 32);
+
+    const auto& index = builder.index();
+    REQUIRE(index.spriteCount() == 2);
+    const auto* happy = index.find("characters/alice/happy.png");
+    const auto* sad = index.find("characters/alice/sad.png");
+    REQUIRE(happy);
+    REQUIRE(sad);
+    REQUIRE(happy->rect.width == 10);
+    REQUIRE(happy->rect.height == 20);
+    REQUIRE(pagePixel(page, happy->rect.x, happy->rect.y) == Color::Red);
+    REQUIRE(pagePixel(page, sad->rect.x + 29, sad->rect.y + 7) == Color::Green);
+    // Edges are extruded into the padding
+    REQUIRE(pagePixel(page, happy->rect.x - 2, happy->rect.y - 2) == Color::Red);
+    REQUIRE(pagePixel(page, sad->rect.x + 31, sad->rect.y + 9) == Color::Green);
+
+    auto parsed = TextureAtlasIndex::parse(index.serialize());
+    REQUIRE(parsed.isOk());
+    REQUIRE(parsed.value().serialize() == index.serialize());
+    REQUIRE(parsed.value().pages()[0].width == 64);
+    REQUIRE(parsed.value().find("characters/alice/sad.png")->rect.x == sad->rect.x);
+    REQUIRE(TextureAtlasIndex::parse("atlas 2\n").isError());
+    REQUIRE(TextureAtlasIndex::parse("atlas 1\nsprite 0 0 0 4 4 a.png\n").isError());
+    REQUIRE(TextureAtlasIndex::parse("atlas 1\npage p.tga 8 8\nsprite 0 6 6 4 4 a.png\n").isError());
+
+    // Pages round-trip through the texture loader
+    Texture::setGpuUploadEnabled(false);
+    const auto tga = TextureAtlasBuilder::encodeTga(page.rgba.data(), page.width, page.height);
+    Texture texture;
+    REQUIRE(texture.loadFromMemory(tga).isOk());
+    REQUIRE(texture.getWidth() == 64);
+    REQUIRE(texture.getPixels() == page.rgba);
+}
+
+TEST_CASE("ResourceManager resolves atlased images to page regions", "[renderer][atlas]")
+{
+    Texture::setGpuUploadEnabled(false);
+    const fs::path dir = fs::temp_directory_path() / "novelmind_atlas_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    TextureAtlasBuilder builder(128, 1);
+    const auto red = solid(8, 8, Color::Red);
+    const auto green = solid(4, 12, Color::Green);
+    REQUIRE(builder.addImage("ui/hud", "ui/hud/heart.png", red.data(), 8, 8).isOk());
+    REQUIRE(builder.addImage("ui/hud", "ui/hud/bar.png", green.data(), 4, 12).isOk());
+    REQUIRE(builder.build().isOk());
+    const auto& page = builder.pages()[0];
+    writeFile(dir / page.id, TextureAtlasBuilder::encodeTga(page.rgba.data(), page.width, page.height));
+    {
+        std::ofstream index(dir / TextureAtlasIndex::kResourceId);
+        index << builder.index().serialize();
+    }
+    writeFile(dir / "loose.tga", TextureAtlasBuilder::encodeTga(green.data(), 4, 12));
+
+    resource::ResourceManager resources;
+    resources.setBasePath(dir.string());
+
+    auto heart = resources.loadTexture("ui/hud/heart.png");
+    REQUIRE(heart.isOk());
+    REQUIRE(heart.value().isValid());
+    const auto* entry = builder.index().find("ui/hud/heart.png");
+    REQUIRE(heart.value().sourceRect.x == static_cast<f32>(entry->rect.x));
+    REQUIRE(heart.value().width() == 8.0f);
+    REQUIRE(heart.value().texture->getWidth() == page.width);
+
+    // Sprites of one atlas share the page texture; ids may carry "assets/"
+    auto bar = resources.loadTexture("assets/ui/hud/bar.png");
+    REQUIRE(bar.isOk());
+    REQUIRE(bar.value().texture == heart.value().texture);
+    REQUIRE(bar.value().height() == 12.0f);
+    REQUIRE(resources.getTextureCount() == 1);
+
+    // Images outside the atlas are whole textures
+    auto loose = resources.loadTexture("loose.tga");
+    REQUIRE(loose.isOk());
+    REQUIRE(loose.value().sourceRect.x == 0.0f);
+    REQUIRE(loose.value().width() == 4.0f);
+    REQUIRE(loose.value().height() == 12.0f);
+    REQUIRE(resources.loadTexture("ui/hud/missing.png").isError());
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "NovelMind/renderer/color.hpp"
+#include "NovelMind/renderer/texture.hpp"
+#include "NovelMind/renderer/texture_atlas.hpp"
+#include "NovelMind/renderer/texture_loader.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/vfs/cached_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<u8> encodedImage(i32 width, i32 height, Color color)
+{
+    std::vector<u8> rgba;
+    for (i32 i = 0; i < width * height; ++i) {
+        rgba.insert(rgba.end(), {color.r, color.g, color.b, color.a});
+    }
+    return TextureAtlasBuilder::encodeTga(rgba.data(), width, height);
+}
+
+} // namespace
+
+TEST_CASE("AsyncTextureLoader decodes off thread and completes on pump", "[renderer][texture]")
+{
+    Texture::setGpuUploadEnabled(false);
+    AsyncTextureLoader loader(2);
+    REQUIRE(loader.getThreadCount() == 2);
+
+    std::vector<std::shared_ptr<Texture>> textures;
+    for (int i = 0; i < 6; ++i) {
+        auto texture = std::make_shared<Texture>();
+        loader.load(texture, encodedImage(16 + i, 8, Color(static_cast<u8>(i * 40), 0, 0, 255)));
+        REQUIRE(texture->isLoading());
+        REQUIRE_FALSE(texture->isValid());
+        textures.push_back(texture);
+    }
+
+    auto broken = std::make_shared<Texture>();
+    loader.load(broken, std::vector<u8>{1, 2, 3, 4});
+
+    // Released before decoding finishes: skipped without touching anything
+    auto dropped = std::make_shared<Texture>();
+    loader.load(dropped, encodedImage(4, 4, Color::White));
+    dropped.reset();
+
+    loader.finish();
+    REQUIRE(loader.getPendingCount() == 0);
+    for (int i = 0; i < 6; ++i) {
+        const auto& texture = *textures[static_cast<size_t>(i)];
+        REQUIRE(texture.getState() == TextureState::Ready);
+        REQUIRE(texture.isValid());
+        REQUIRE(texture.getWidth() == 16 + i);
+        REQUIRE(texture.getHeight() == 8);
+        REQUIRE(texture.getPixels()[0] == static_cast<u8>(i * 40));
+    }
+    REQUIRE(broken->getState() == TextureState::Failed);
+    REQUIRE_FALSE(broken->isValid());
+
+    // A texture loaded synchronously in the meantime keeps its pixels
+    auto replaced = std::make_shared<Texture>();
+    loader.load(replaced, encodedImage(8, 8, Color::Red));
+    const auto green = encodedImage(2, 2, Color::Green);
+    REQUIRE(replaced->loadFromMemory(green).isOk());
+    loader.finish();
+    REQUIRE(replaced->getWidth() == 2);
+}
+
+TEST_CASE("ResourceManager streams textures and keeps serving them while loading",
+          "[renderer][texture]")
+{
+    Texture::setGpuUploadEnabled(false);
+    const fs::path dir = fs::temp_directory_path() / "novelmind_texture_loader_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    for (const auto& [name, size] : {std::pair{"bg.tga", 64}, std::pair{"face.tga", 16}}) {
+        const auto data = encodedImage(size, size / 2, Color::Blue);
+        std::ofstream out(dir / name, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    {
+        std::ofstream out(dir / "corrupt.png", std::ios::binary);
+        out << "not an image";
+    }
+
+    resource::ResourceManager resources;
+    resources.setBasePath(dir.string());
+    resources.setAsyncTextureLoading(true, 1);
+    REQUIRE(resources.isAsyncTextureLoading());
+
+    auto first = resources.loadTexture("bg.tga");
+    REQUIRE(first.isOk());
+    REQUIRE(first.value().isLoading());
+    REQUIRE_FALSE(first.value().isValid());
+    // Asking again while loading returns the same texture, not a new load
+    auto again = resources.loadTexture("bg.tga");
+    REQUIRE(again.value().texture == first.value().texture);
+    REQUIRE(resources.getPendingTextureCount() == 1);
+
+    REQUIRE(resources.loadTexture("corrupt.png").isOk());
+    resources.finishTextureLoads();
+    REQUIRE(resources.getPendingTextureCount() == 0);
+
+    auto ready = resources.loadTexture("bg.tga");
+    REQUIRE(ready.value().isValid());
+    REQUIRE(ready.value().width() == 64.0f);
+    REQUIRE(ready.value().height() == 32.0f);
+    REQUIRE(resources.loadTexture("corrupt.png").isError());
+
+    // update() finishes loads without blocking once decoding is done
+    auto face = resources.loadTexture("face.tga");
+    REQUIRE(face.value().isLoading());
+    for (int frame = 0; frame < 2000 && face.value().texture->isLoading(); ++frame) {
+        resources.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(face.value().texture->isValid());
+
+    // Switching back to synchronous loading decodes immediately
+    resources.setAsyncTextureLoading(false);
+    resources.clearCache();
+    REQUIRE(resources.loadTexture("face.tga").value().isValid());
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ResourceManager reads packed textures on the VFS I/O threads", "[renderer][texture][vfs]")
+{
+    Texture::setGpuUploadEnabled(false);
+    auto inner = std::make_unique<vfs::MemoryFileSystem>();
+    inner->addResource("hero.tga", encodedImage(12, 6, Color::Green), vfs::ResourceType::Texture);
+    inner->addResource("broken.tga", {1, 2, 3}, vfs::ResourceType::Texture);
+    vfs::CachedFileSystem files(std::move(inner));
+
+    resource::ResourceManager resources(&files);
+    resources.setAsyncTextureLoading(true, 1);
+
+    auto hero = resources.loadTexture("hero.tga");
+    REQUIRE(hero.isOk());
+    REQUIRE(hero.value().isLoading());
+    REQUIRE(resources.getPendingTextureCount() == 1);
+    REQUIRE(resources.loadTexture("missing.tga").isError());
+
+    // The bytes reach the decoder only when the VFS owner dispatches reads
+    for (int frame = 0; frame < 2000 && hero.value().texture->isLoading(); ++frame) {
+        files.processCompletions();
+        resources.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(hero.value().texture->isValid());
+    REQUIRE(hero.value().texture->getWidth() == 12);
+    REQUIRE(resources.getPendingTextureCount() == 0);
+    REQUIRE(files.cacheStats().entryCount == 1);
+
+    REQUIRE(resources.loadTexture("broken.tga").value().isLoading());
+    resources.finishTextureLoads();
+    REQUIRE(resources.loadTexture("broken.tga").isError());
+
+    // Unloading while the read is in flight drops its callback
+    REQUIRE(resources.loadTexture("hero.tga").value().isValid());
+    resources.clearCache();
+    auto reloaded = resources.loadTexture("hero.tga");
+    resources.unloadTexture("hero.tga");
+    REQUIRE(resources.getPendingTextureCount() == 0);
+    resources.finishTextureLoads();
+    REQUIRE(reloaded.value().isLoading());
+}